@@ -0,0 +1,79 @@
+/**************************
+ * @file        main.cpp
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#include "../../../library/source/help/binaryLog.h"
+#include <fstream>
+#include <iostream>
+
+/**************************
+ * @brief Decode binary log files written with MSAPI_LOG_BINARY build flag into text format of logger.
+ *
+ * @note Usage: MSAPILogDecoder <file.blog>..., decoded lines are written to standard output.
+ */
+int main(const int argc, char* argv[])
+{
+	if (argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " <file.blog>..." << std::endl;
+		return 1;
+	}
+
+	std::ios_base::sync_with_stdio(false);
+	int result{ 0 };
+	std::string data;
+	std::string lines;
+	for (int index{ 1 }; index < argc; ++index) {
+		std::ifstream file{ argv[index], std::ios::binary };
+		if (!file.is_open()) {
+			std::cerr << "Cannot open file: " << argv[index] << std::endl;
+			result = 1;
+			continue;
+		}
+
+		MSAPI::BinaryLog::Decoder decoder;
+		data.clear();
+		while (true) {
+			//* Incomplete entry of previous chunk stays at the beginning of data
+			const auto size{ data.size() };
+			data.resize(size + 1024 * 1024);
+			file.read(data.data() + size, static_cast<std::streamsize>(data.size() - size));
+			data.resize(size + static_cast<size_t>(file.gcount()));
+
+			size_t offset{ 0 };
+			lines.clear();
+			const bool isCorrect{ decoder.Decode(data, offset, lines) };
+			std::cout << lines;
+			data.erase(0, offset);
+			if (!isCorrect) {
+				std::cerr << "Corrupted entry in file: " << argv[index] << std::endl;
+				result = 1;
+				break;
+			}
+			if (file.gcount() == 0) {
+				if (!data.empty()) {
+					std::cerr << "Incomplete entry at the end of file: " << argv[index] << std::endl;
+					result = 1;
+				}
+				break;
+			}
+		}
+	}
+
+	std::cout.flush();
+	return result;
+}
@@ -97,11 +97,13 @@ Manager::Manager()
 		[this](std::string& out, const MSAPI::Protocol::WebSocket::Events::Stream& stream) {
 			return this->FillAppParameters(out, stream);
 		});
+	// Bursts of streams updates are merged into one frame per connection within 1 millisecond
+	(void)m_streamsDistributor.StartBatching(1000, 64 * 1024);
 }
 
 void Manager::HandleBuffer(MSAPI::RecvBufferInfo* recvBufferInfo)
 {
-	MSAPI_HANDLER_WEBSOCKET_PRESET;
+	MSAPI_HANDLER_WEBSOCKET_BORROWED_PRESET;
 
 	MSAPI::DataHeader header{ *recvBufferInfo->buffer };
 	MSAPI_HANDLER_HTTP_PRESET;
@@ -254,46 +256,56 @@ void Manager::HandleRunRequest()
 			return viewValue;
 		}() };
 
-		MSAPI::Pthread::AtomicRWLock::ExitGuard<MSAPI::Pthread::write> _{ m_hashToInstalledAppDataLock };
 		appId = MSAPI::Helper::StringHash32Uint(*appValue);
-		auto it{ m_hashToInstalledAppData.find(appId) };
-		if (it == m_hashToInstalledAppData.end()) {
-			if (viewValue == nullptr) {
-				LOG_INFO("New app registered: " + *appValue + ", id: " + _S(appId) + ", bin: " + *binValue);
-				m_hashToInstalledAppData.emplace(
-					std::move(appId), std::make_shared<InstalledAppData>(*appValue, *binValue));
-				continue;
-			}
+		(void)m_hashToInstalledAppData.Update([appId, appValue, binValue, viewValue](auto& hashToInstalledAppData) {
+			auto it{ hashToInstalledAppData.find(appId) };
+			if (it == hashToInstalledAppData.end()) {
+				if (viewValue == nullptr) {
+					LOG_INFO("New app registered: " + *appValue + ", id: " + _S(appId) + ", bin: " + *binValue);
+					hashToInstalledAppData.emplace(appId, std::make_shared<InstalledAppData>(*appValue, *binValue));
+					return true;
+				}
 
-			LOG_INFO("New app registered: " + *appValue + ", id: " + _S(appId) + ", bin: " + *binValue
-				+ ", parameter with port for view: " + _S(static_cast<int32_t>(*viewValue)));
-			m_hashToInstalledAppData.emplace(std::move(appId),
-				std::make_shared<InstalledAppData>(*appValue, *binValue, static_cast<int32_t>(*viewValue)));
-			continue;
-		}
+				LOG_INFO("New app registered: " + *appValue + ", id: " + _S(appId) + ", bin: " + *binValue
+					+ ", parameter with port for view: " + _S(static_cast<int32_t>(*viewValue)));
+				hashToInstalledAppData.emplace(appId,
+					std::make_shared<InstalledAppData>(*appValue, *binValue, static_cast<int32_t>(*viewValue)));
+				return true;
+			}
 
-		// Is not supported
-		if (it->second->bin != *binValue) {
-			LOG_INFO("For app: " + *appValue + " bin path changed from " + it->second->bin + " to " + *binValue);
-			it->second->bin = *binValue;
-			continue;
-		}
+			// Data is shared with readers of previous snapshot, so changed data is published as a new object
+			// Is not supported
+			if (it->second->bin != *binValue) {
+				LOG_INFO(
+					"For app: " + *appValue + " bin path changed from " + it->second->bin + " to " + *binValue);
+				auto changed{ std::make_shared<InstalledAppData>(*it->second) };
+				changed->bin = *binValue;
+				it->second = std::move(changed);
+				return true;
+			}
 
-		if (viewValue != nullptr && it->second->viewPortParameter != static_cast<int32_t>(*viewValue)) {
-			LOG_INFO("For app: " + *appValue + " view port changed from " + _S(it->second->viewPortParameter) + " to "
-				+ _S(static_cast<int32_t>(*viewValue)));
-			it->second->viewPortParameter = static_cast<int32_t>(*viewValue);
-		}
+			if (viewValue != nullptr && it->second->viewPortParameter != static_cast<int32_t>(*viewValue)) {
+				LOG_INFO("For app: " + *appValue + " view port changed from " + _S(it->second->viewPortParameter)
+					+ " to " + _S(static_cast<int32_t>(*viewValue)));
+				auto changed{ std::make_shared<InstalledAppData>(*it->second) };
+				changed->viewPortParameter = static_cast<int32_t>(*viewValue);
+				it->second = std::move(changed);
+				return true;
+			}
+			return false;
+		});
 	}
 
-	{
-		MSAPI::Pthread::AtomicRWLock::ExitGuard<MSAPI::Pthread::read> _{ m_hashToInstalledAppDataLock };
-		if (m_hashToInstalledAppData.empty()) {
-			LOG_ERROR("No apps registered, manager is going to end its work");
-			HandlePauseRequest();
-			Server::Stop();
-			return;
-		}
+	const bool isEmpty{ [this]() {
+		const decltype(m_hashToInstalledAppData)::ReadGuard hashToInstalledAppData{ m_hashToInstalledAppData };
+		return hashToInstalledAppData->empty();
+	}() };
+	// Pause request replaces apps, so it is called out of read section
+	if (isEmpty) {
+		LOG_ERROR("No apps registered, manager is going to end its work");
+		HandlePauseRequest();
+		Server::Stop();
+		return;
 	}
 
 	if (!m_authorizationModule.Start()) {
@@ -323,8 +335,8 @@ void Manager::HandlePauseRequest()
 	}
 
 	{
-		MSAPI::Pthread::AtomicRWLock::ExitGuard<MSAPI::Pthread::write> _{ m_hashToInstalledAppDataLock };
-		m_hashToInstalledAppData.clear();
+		// Previous apps are released after grace period
+		(void)m_hashToInstalledAppData.Replace({});
 	}
 
 	{
@@ -335,7 +347,7 @@ void Manager::HandlePauseRequest()
 	m_authorizationModule.Stop();
 }
 
-void Manager::HandleModifyRequest(const std::map<size_t, std::variant<standardTypes>>& parametersUpdate)
+void Manager::HandleModifyRequest(const MSAPI::Protocol::Standard::data_t& parametersUpdate)
 {
 	for (const auto& [id, value] : parametersUpdate) {
 		if (MSAPI::Application::IsRunning()) {
@@ -355,7 +367,7 @@ void Manager::HandleModifyRequest(const std::map<size_t, std::variant<standardTy
 	}
 }
 
-void Manager::HandleParameters(const int connection, const std::map<size_t, std::variant<standardTypes>>& parameters)
+void Manager::HandleParameters(const int connection, const MSAPI::Protocol::Standard::data_t& parameters)
 {
 	const auto portIt{ parameters.find(1000009) };
 	if (portIt == parameters.end()) {
@@ -489,7 +501,8 @@ void Manager::HandleParameters(const int connection, const std::map<size_t, std:
 		return true;
 	} };
 
-	(void)m_streamsDistributor.SendData(
+	// Parameters document is resent on every update, subscribers which already have it receive only changes
+	(void)m_streamsDistributor.SendPatch(
 		{ MSAPI::Helper::StringHash32Uint("parameters"),
 			MSAPI::Protocol::WebSocket::Events::IdentityFilter{ static_cast<uint64_t>(*port) } },
 		serialize);
@@ -692,6 +705,7 @@ void Manager::HandleOutcomeDisconnect([[maybe_unused]] const int32_t id, const i
 	m_authorizationModule.LogoutConnection(connection);
 	m_singlesDistributor.ClearActiveEventsForConnection(connection);
 	m_streamsDistributor.ClearActiveEventsForConnection(connection);
+	ClearConnection(connection);
 }
 
 void Manager::HandleIncomeDisconnect([[maybe_unused]] const int32_t id, const int32_t connection)
@@ -699,15 +713,16 @@ void Manager::HandleIncomeDisconnect([[maybe_unused]] const int32_t id, const in
 	m_authorizationModule.LogoutConnection(connection);
 	m_singlesDistributor.ClearActiveEventsForConnection(connection);
 	m_streamsDistributor.ClearActiveEventsForConnection(connection);
+	ClearConnection(connection);
 }
 
 uint16_t Manager::CreateApp(const uint64_t hash, const MSAPI::Json& parameters, std::string& error)
 {
 	std::shared_ptr<InstalledAppData> installedAppData;
 	{
-		MSAPI::Pthread::AtomicRWLock::ExitGuard<MSAPI::Pthread::read> _{ m_hashToInstalledAppDataLock };
-		auto it{ m_hashToInstalledAppData.find(hash) };
-		if (it == m_hashToInstalledAppData.end()) {
+		const decltype(m_hashToInstalledAppData)::ReadGuard hashToInstalledAppData{ m_hashToInstalledAppData };
+		const auto it{ hashToInstalledAppData->find(hash) };
+		if (it == hashToInstalledAppData->end()) {
 			error = std::format("Unknow app type hash {}", hash);
 			return 0;
 		}
@@ -22,6 +22,7 @@
 
 #include "../../../library/source/help/json.h"
 #include "../../../library/source/help/pthread.hpp"
+#include "../../../library/source/help/rcu.hpp"
 #include "../../../library/source/protocol/http.h"
 #include "../../../library/source/protocol/object.h"
 #include "../../../library/source/protocol/webSocket.inl"
@@ -185,8 +186,8 @@ private:
 
 private:
 	std::string m_webSourcesPath;
-	std::map<size_t, std::shared_ptr<InstalledAppData>> m_hashToInstalledAppData;
-	MSAPI::Pthread::AtomicRWLock m_hashToInstalledAppDataLock;
+	// Read by every frontend request and app creation, changed on parameters applying and pause only
+	MSAPI::Rcu::Cell<std::map<size_t, std::shared_ptr<InstalledAppData>>> m_hashToInstalledAppData;
 	std::map<uint16_t, std::shared_ptr<CreatedAppData>> m_portToCreatedApp;
 	MSAPI::Pthread::AtomicRWLock m_portToCreatedAppLock;
 	std::map<size_t, std::shared_ptr<std::vector<MSAPI::StandardType::Type>>> m_tableIdToColumns;
@@ -211,8 +212,8 @@ public:
 	//* MSAPI::Application
 	void HandleRunRequest() final;
 	void HandlePauseRequest() final;
-	void HandleModifyRequest(const std::map<size_t, std::variant<standardTypes>>& parametersUpdate) final;
-	void HandleParameters(int connection, const std::map<size_t, std::variant<standardTypes>>& parameters) final;
+	void HandleModifyRequest(const MSAPI::Protocol::Standard::data_t& parametersUpdate) final;
+	void HandleParameters(int connection, const MSAPI::Protocol::Standard::data_t& parameters) final;
 	void HandleHello(int connection) final;
 	void HandleMetadata(int connection, std::string_view metadata) final;
 	void HandleOutcomeDisconnect(int id, int32_t connection) final;
@@ -235,10 +236,10 @@ private:
 		auto backIt{ std::back_inserter(out) };
 		std::format_to(backIt, "[");
 		{
-			MSAPI::Pthread::AtomicRWLock::ExitGuard<MSAPI::Pthread::read> _{ m_hashToInstalledAppDataLock };
-			if (!m_hashToInstalledAppData.empty()) {
-				auto it{ m_hashToInstalledAppData.begin() };
-				const auto end{ m_hashToInstalledAppData.end() };
+			const decltype(m_hashToInstalledAppData)::ReadGuard hashToInstalledAppData{ m_hashToInstalledAppData };
+			if (!hashToInstalledAppData->empty()) {
+				auto it{ hashToInstalledAppData->begin() };
+				const auto end{ hashToInstalledAppData->end() };
 
 				std::format_to(backIt, "{{\"type\":\"{}\"", it->second->type);
 				if (it->second->hasView) {
@@ -269,9 +270,9 @@ private:
 			return MSAPI::Protocol::WebSocket::Events::HandleResult::Fail;
 		}
 
-		MSAPI::Pthread::AtomicRWLock::ExitGuard<MSAPI::Pthread::read> _{ m_hashToInstalledAppDataLock };
-		const auto it{ m_hashToInstalledAppData.find(*appType) };
-		if (it == m_hashToInstalledAppData.end()) {
+		const decltype(m_hashToInstalledAppData)::ReadGuard hashToInstalledAppData{ m_hashToInstalledAppData };
+		const auto it{ hashToInstalledAppData->find(*appType) };
+		if (it == hashToInstalledAppData->end()) {
 			out = std::format("Metadata request contains unknown appType: {}", *appType);
 			return MSAPI::Protocol::WebSocket::Events::HandleResult::Fail;
 		}
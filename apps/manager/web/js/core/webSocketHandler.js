@@ -11,7 +11,8 @@
  * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
  *
  * @brief MSAPI Event application layer protocol on top of web socket with json payload format. Supports single and
- * stream event types.
+ * stream event types. Data of events can be received in binary encoding, if it is requested by "encoding" key.
+ * Stream data can be received as structural patch of the last received document.
  */
 
 class WebSocketHandler {
@@ -26,6 +27,38 @@ class WebSocketHandler {
 		Max: 3,
 	});
 
+	static Encoding = Object.freeze({
+		Undefined : 0,
+		Json: 1,
+		Binary: 2,
+		Max: 3,
+	});
+
+	static BinaryFrame = Object.freeze({
+		Undefined : 0,
+		Data: 1,
+		Batch: 2,
+		Max: 3,
+	});
+
+	static m_encoding = WebSocketHandler.Encoding.Json;
+	static m_textDecoder = new TextDecoder();
+
+	/**
+	 * @brief Set encoding of events data requested by all subsequent events.
+	 *
+	 * @param encoding Json or binary encoding.
+	 */
+	static SetEncoding(encoding)
+	{
+		if (encoding != WebSocketHandler.Encoding.Json && encoding != WebSocketHandler.Encoding.Binary) {
+			console.warn("Unknown events encoding", encoding);
+			return;
+		}
+
+		WebSocketHandler.m_encoding = encoding;
+	}
+
 	static AddEvent(event)
 	{
 		if (!(event instanceof WebSocketSingle) && !(event instanceof WebSocketStream)) {
@@ -114,6 +147,7 @@ class WebSocketHandler {
 	static OpenWebSocket(json)
 	{
 		WebSocketHandler.m_serverConnection = new WebSocket(`ws://${window.location.host}`);
+		WebSocketHandler.m_serverConnection.binaryType = "arraybuffer";
 
 		WebSocketHandler.m_serverConnection.addEventListener("open", () => {
 			WebSocketHandler.m_serverConnection.send(json);
@@ -147,157 +181,392 @@ class WebSocketHandler {
 		});
 
 		WebSocketHandler.m_serverConnection.addEventListener("message", (e) => {
+			if (e.data instanceof ArrayBuffer) {
+				WebSocketHandler.HandleBinaryMessage(new DataView(e.data));
+				return;
+			}
+
 			let json = e.data;
 			// console.log("Receive", json);
 			json = Helper.JsonStringToObject(json);
 
-			if (!("uids" in json)) {
-				console.warn("Message does not contain event uids", json);
+			if ("batch" in json) {
+				for (const entry of Array.from(json["batch"])) {
+					WebSocketHandler.HandleMessage(entry);
+				}
 				return;
 			}
 
-			const uids = Array.from(json["uids"]);
-			let type = WebSocketHandler.Type.Undefined;
+			WebSocketHandler.HandleMessage(json);
+		});
+	}
 
-			const getEvent = (uid) => {
-				uid = Number(uid);
-				const event = WebSocketHandler.GetEvent(uid);
-				if (!event) {
-					console.warn("Message for unknown event is reserved", uid);
-					return null;
+	/**
+	 * @brief Decode binary frame and handle every data message inside.
+	 *
+	 * @param view Data view of received frame.
+	 */
+	static HandleBinaryMessage(view)
+	{
+		const reader = { view: view, offset: 0 };
+
+		const readFrame = () => {
+			const kind = view.getUint8(reader.offset);
+			const count = view.getUint32(reader.offset + 1, true);
+			reader.offset += 5;
+
+			if (kind == WebSocketHandler.BinaryFrame.Batch) {
+				for (let index = 0; index < count; ++index) {
+					readFrame();
 				}
+				return;
+			}
 
-				return event;
-			};
+			if (kind != WebSocketHandler.BinaryFrame.Data) {
+				throw new Error(`Unknown binary frame kind ${kind}`);
+			}
 
-			for (const uid of uids) {
-				const event = getEvent(uid);
-				if (!event) {
-					continue;
+			const uids = [];
+			for (let index = 0; index < count; ++index) {
+				uids.push(Number(view.getBigUint64(reader.offset, true)));
+				reader.offset += 8;
+			}
+
+			WebSocketHandler.HandleMessage({ uids: uids, data: WebSocketHandler.ReadBinaryValue(reader) });
+		};
+
+		try {
+			while (reader.offset < view.byteLength) {
+				readFrame();
+			}
+		}
+		catch (error) {
+			console.error("Binary message can not be decoded:", error);
+		}
+	}
+
+	/**
+	 * @brief Read type tagged value, tags are standard types with additional object and array tags.
+	 *
+	 * @param reader Data view and current offset.
+	 *
+	 * @return Decoded value.
+	 */
+	static ReadBinaryValue(reader)
+	{
+		const view = reader.view;
+		const readString = () => {
+			const size = view.getUint32(reader.offset, true);
+			reader.offset += 4;
+			const bytes = new Uint8Array(view.buffer, view.byteOffset + reader.offset, size);
+			reader.offset += size;
+			return WebSocketHandler.m_textDecoder.decode(bytes);
+		};
+		const read = (getter, size) => {
+			const value = getter.call(view, reader.offset, true);
+			reader.offset += size;
+			return value;
+		};
+
+		const tag = view.getUint8(reader.offset++);
+		switch (tag) {
+		case 0:
+			return null;
+		case 1:
+			return read(view.getInt8, 1);
+		case 2:
+			return read(view.getInt16, 2);
+		case 3:
+			return read(view.getInt32, 4);
+		case 4:
+			return Number(read(view.getBigInt64, 8));
+		case 5:
+			return read(view.getUint8, 1);
+		case 6:
+			return read(view.getUint16, 2);
+		case 7:
+			return read(view.getUint32, 4);
+		case 8:
+			return Number(read(view.getBigUint64, 8));
+		case 9:
+			return read(view.getFloat32, 4);
+		case 10:
+			return read(view.getFloat64, 8);
+		case 11:
+			return read(view.getUint8, 1) != 0;
+		case 32:
+			return readString();
+		case 33:
+			return "";
+		case 64: {
+			const count = read(view.getUint32, 4);
+			const object = {};
+			for (let index = 0; index < count; ++index) {
+				const key = readString();
+				object[key] = WebSocketHandler.ReadBinaryValue(reader);
+			}
+			return object;
+		}
+		case 65: {
+			const count = read(view.getUint32, 4);
+			const array = [];
+			for (let index = 0; index < count; ++index) {
+				array.push(WebSocketHandler.ReadBinaryValue(reader));
+			}
+			return array;
+		}
+		default:
+			throw new Error(`Unknown binary value tag ${tag}`);
+		}
+	}
+
+	/**
+	 * @brief Apply add, replace and remove operations of structural patch. Containers on the paths are copied, so
+	 * previous document and objects passed to handlers before are not changed.
+	 *
+	 * @param document Document to be patched.
+	 * @param patch Array of operations with JSON Pointer paths.
+	 *
+	 * @return Patched document, throws on invalid operation.
+	 */
+	static ApplyPatch(document, patch)
+	{
+		if (document === undefined) {
+			throw new Error("Document is not received yet");
+		}
+
+		const copied = new Set();
+		const own = (container) => {
+			if (copied.has(container)) {
+				return container;
+			}
+
+			const copy = Array.isArray(container) ? [...container] : { ...container };
+			copied.add(copy);
+			return copy;
+		};
+
+		document = own(document);
+		for (const operation of patch) {
+			const tokens = operation.path.split("/").slice(1).map(
+				(token) => token.replaceAll("~1", "/").replaceAll("~0", "~"));
+			if (tokens.length == 0) {
+				throw new Error(`Operation on root is not supported: ${operation.op}`);
+			}
+
+			let parent = document;
+			for (let index = 0; index < tokens.length - 1; ++index) {
+				const child = parent[tokens[index]];
+				if (child === null || typeof child !== "object") {
+					throw new Error(`Path is not found: ${operation.path}`);
 				}
 
-				type = event.m_type;
+				parent = parent[tokens[index]] = own(child);
 			}
 
-			if (type == WebSocketHandler.Type.Undefined) {
-				console.warn("Message does cont contain alive events", json);
-				return;
+			const key = tokens[tokens.length - 1];
+			switch (operation.op) {
+			case "add":
+				if (Array.isArray(parent)) {
+					parent.splice(key == "-" ? parent.length : Number(key), 0, operation.value);
+					break;
+				}
+				parent[key] = operation.value;
+				break;
+			case "replace":
+				if (!(key in parent)) {
+					throw new Error(`Path is not found: ${operation.path}`);
+				}
+				parent[key] = operation.value;
+				break;
+			case "remove":
+				if (!(key in parent)) {
+					throw new Error(`Path is not found: ${operation.path}`);
+				}
+				if (Array.isArray(parent)) {
+					parent.splice(Number(key), 1);
+					break;
+				}
+				delete parent[key];
+				break;
+			default:
+				throw new Error(`Unknown patch operation: ${operation.op}`);
 			}
+		}
 
-			if (type == WebSocketHandler.Type.Single) {
-				if ("state" in json) {
-					const state = Number(json["state"]);
-					if (state == WebSocketStream.State.Failed) {
-						if ("error" in json) {
-							Array.from(json["uids"]).forEach((uid) => {
-								const event = getEvent(uid);
-								if (event) {
-									event.m_handleFailed(json["error"]);
-									WebSocketHandler.RemoveEvent(event);
-								}
-							});
-							return;
-						}
+		return document;
+	}
+
+	static HandleMessage(json)
+	{
+		if (!("uids" in json)) {
+			console.warn("Message does not contain event uids", json);
+			return;
+		}
+
+		const uids = Array.from(json["uids"]);
+		let type = WebSocketHandler.Type.Undefined;
+
+		const getEvent = (uid) => {
+			uid = Number(uid);
+			const event = WebSocketHandler.GetEvent(uid);
+			if (!event) {
+				console.warn("Message for unknown event is reserved", uid);
+				return null;
+			}
 
+			return event;
+		};
+
+		for (const uid of uids) {
+			const event = getEvent(uid);
+			if (!event) {
+				continue;
+			}
+
+			type = event.m_type;
+		}
+
+		if (type == WebSocketHandler.Type.Undefined) {
+			console.warn("Message does cont contain alive events", json);
+			return;
+		}
+
+		if (type == WebSocketHandler.Type.Single) {
+			if ("state" in json) {
+				const state = Number(json["state"]);
+				if (state == WebSocketStream.State.Failed) {
+					if ("error" in json) {
 						Array.from(json["uids"]).forEach((uid) => {
 							const event = getEvent(uid);
 							if (event) {
-								event.m_handleFailed();
+								event.m_handleFailed(json["error"]);
 								WebSocketHandler.RemoveEvent(event);
 							}
 						});
 						return;
 					}
-				}
 
-				if (!("data" in json)) {
-					console.warn("Single event does not contain data", json);
+					Array.from(json["uids"]).forEach((uid) => {
+						const event = getEvent(uid);
+						if (event) {
+							event.m_handleFailed();
+							WebSocketHandler.RemoveEvent(event);
+						}
+					});
 					return;
 				}
+			}
 
-				Array.from(json["uids"]).forEach((uid) => {
-					const event = getEvent(uid);
-					if (event) {
-						event.m_handleResponse(json["data"]);
-						WebSocketHandler.RemoveEvent(event);
-					}
-				});
+			if (!("data" in json)) {
+				console.warn("Single event does not contain data", json);
 				return;
 			}
 
-			if (type == WebSocketHandler.Type.Stream) {
-				if ("state" in json) {
-					let state = Number(json["state"]);
-					switch (state) {
-					case WebSocketStream.State.Opened:
-						Array.from(json["uids"]).forEach((uid) => {
-							const event = getEvent(uid);
-							if (event) {
-								event.m_state = state;
-								if (event.m_handleOpened) {
-									event.m_handleOpened();
-								}
-							}
-						});
-						return;
-					case WebSocketStream.State.Done:
-						Array.from(json["uids"]).forEach((uid) => {
-							const event = getEvent(uid);
-							if (event) {
-								event.m_state = state;
-								if (event.m_handleSnapshotDone) {
-									event.m_handleSnapshotDone();
-								}
-							}
-						});
-						return;
-					case WebSocketStream.State.Failed:
-						Array.from(json["uids"]).forEach((uid) => {
-							const event = getEvent(uid);
-							if (!event) {
-								return;
-							}
+			Array.from(json["uids"]).forEach((uid) => {
+				const event = getEvent(uid);
+				if (event) {
+					event.m_handleResponse(json["data"]);
+					WebSocketHandler.RemoveEvent(event);
+				}
+			});
+			return;
+		}
 
+		if (type == WebSocketHandler.Type.Stream) {
+			if ("state" in json) {
+				let state = Number(json["state"]);
+				switch (state) {
+				case WebSocketStream.State.Opened:
+					Array.from(json["uids"]).forEach((uid) => {
+						const event = getEvent(uid);
+						if (event) {
 							event.m_state = state;
-							WebSocketHandler.RemoveEvent(event);
-							if (!event.m_handleFailed) {
-								return;
-							}
-
-							let error = "";
-							if (!("error" in json)) {
-								console.warn("Stream event failed update does not contain error");
-								error = "No description";
+							if (event.m_handleOpened) {
+								event.m_handleOpened();
 							}
-							else {
-								error = json["error"];
-							}
-
-							event.m_handleFailed(`Stream event failed with error: ${error}`);
-						});
-						return;
-					default:
-						console.warn("Unexpected stream event state is reserved", json);
-						return;
-					}
-				}
-
-				if ("data" in json) {
+						}
+					});
+					return;
+				case WebSocketStream.State.Done:
 					Array.from(json["uids"]).forEach((uid) => {
 						const event = getEvent(uid);
 						if (event) {
-							event.m_handleData(json["data"]);
+							event.m_state = state;
+							if (event.m_handleSnapshotDone) {
+								event.m_handleSnapshotDone();
+							}
+						}
+					});
+					return;
+				case WebSocketStream.State.Failed:
+					Array.from(json["uids"]).forEach((uid) => {
+						const event = getEvent(uid);
+						if (!event) {
+							return;
 						}
+
+						event.m_state = state;
+						WebSocketHandler.RemoveEvent(event);
+						if (!event.m_handleFailed) {
+							return;
+						}
+
+						let error = "";
+						if (!("error" in json)) {
+							console.warn("Stream event failed update does not contain error");
+							error = "No description";
+						}
+						else {
+							error = json["error"];
+						}
+
+						event.m_handleFailed(`Stream event failed with error: ${error}`);
 					});
 					return;
+				default:
+					console.warn("Unexpected stream event state is reserved", json);
+					return;
 				}
+			}
 
-				console.warn("Unexpected stream event message is reserved", json);
+			if ("data" in json) {
+				Array.from(json["uids"]).forEach((uid) => {
+					const event = getEvent(uid);
+					if (event) {
+						event.m_document = json["data"];
+						event.m_handleData(json["data"]);
+					}
+				});
 				return;
 			}
 
-			console.warn("Unexpected event type is reserved", type);
-		});
+			if ("patch" in json) {
+				Array.from(json["uids"]).forEach((uid) => {
+					const event = getEvent(uid);
+					if (!event) {
+						return;
+					}
+
+					try {
+						event.m_document = WebSocketHandler.ApplyPatch(event.m_document, json["patch"]);
+					}
+					catch (error) {
+						console.warn("Stream event patch can not be applied, resync is requested:", error);
+						event.Resync();
+						return;
+					}
+
+					event.m_handleData(event.m_document);
+				});
+				return;
+			}
+
+			console.warn("Unexpected stream event message is reserved", json);
+			return;
+		}
+
+		console.warn("Unexpected event type is reserved", type);
 	}
 };
 
@@ -336,6 +605,9 @@ class WebSocketSingle {
 		data.uid = this.m_uid;
 		data.event = this.m_event;
 		data.type = WebSocketHandler.Type.Single;
+		if (WebSocketHandler.m_encoding != WebSocketHandler.Encoding.Json) {
+			data.encoding = WebSocketHandler.m_encoding;
+		}
 
 		WebSocketHandler.AddEvent(this);
 		WebSocketHandler.Send(Helper.ParametersToJson(data));
@@ -390,11 +662,33 @@ class WebSocketStream {
 		data.uid = this.m_uid;
 		data.event = this.m_event;
 		data.type = WebSocketHandler.Type.Stream;
+		if (WebSocketHandler.m_encoding != WebSocketHandler.Encoding.Json) {
+			data.encoding = WebSocketHandler.m_encoding;
+		}
+		this.m_data = data;
 
 		WebSocketHandler.AddEvent(this);
 		WebSocketHandler.Send(Helper.ParametersToJson(data));
 	}
 
+	/**
+	 * @brief Interrupt stream and subscribe again with new uid, whole document is sent to new subscription.
+	 */
+	Resync()
+	{
+		WebSocketHandler.Send(
+			`{"uid":${this.m_uid},"type":${WebSocketHandler.Type.Stream},"event":${this.m_event},"interrupt":true}`);
+		WebSocketHandler.RemoveEvent(this);
+
+		this.m_uid = Helper.GenerateUid();
+		this.m_state = WebSocketStream.State.Pending;
+		this.m_document = undefined;
+		this.m_data.uid = this.m_uid;
+
+		WebSocketHandler.AddEvent(this);
+		WebSocketHandler.Send(Helper.ParametersToJson(this.m_data));
+	}
+
 	Close()
 	{
 		this.m_state = WebSocketStream.State.Closed;
@@ -16,7 +16,7 @@ fi
 bash $(dirname ${BASH_SOURCE})/buildLib.sh
 ExitIfError $?
 
-declare -a apps=("manager")
+declare -a apps=("manager" "logDecoder")
 
 SelectAppsToBuild apps[@] "$@"
 
@@ -17,8 +17,8 @@ bash $(dirname ${BASH_SOURCE})/buildLib.sh
 ExitIfError $?
 
 # Unit tests under tests/unit/
-declare -a unit_tests=("dataHeader" "application" "objectData" "standardData" "html" "json" "table" "helper" "timer" "io" "sha256" 
-	"authorization" "sha1")
+declare -a unit_tests=("dataHeader" "application" "objectData" "objectJournal" "standardData" "html" "json" "table" "helper" "timer" "io" 
+	"sha256" "authorization" "sha1" "deflate" "eventsBinary" "eventsPatch" "eventsDistributor" "rcu" "scalableRWLock" "lockProfiling" "log" "allocator")
 
 for i in "${unit_tests[@]}"; do
     RunCommand "cmake -DCMAKE_BUILD_TYPE=${BUILD_PROFILE} -B ${MSAPI_PATH}/tests/unit/${i}/build ${MSAPI_PATH}/tests/unit/${i}/build \
@@ -0,0 +1,364 @@
+/**************************
+ * @file        binaryLog.cpp
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#include "binaryLog.h"
+#include <atomic>
+#include <charconv>
+#include <deque>
+#include <mutex>
+#include <variant>
+
+namespace MSAPI {
+
+namespace BinaryLog {
+
+namespace {
+
+/**************************
+ * @brief Registered sites, sites are never removed so references to them stay valid.
+ */
+struct Registry {
+	std::mutex mutex;
+	std::deque<Site> sites;
+	std::atomic<uint32_t> size{};
+};
+
+/**************************
+ * @return Registry of sites, created on first use to be available during static initialization.
+ */
+Registry& GetRegistry()
+{
+	static Registry registry;
+	return registry;
+}
+
+using Value = std::variant<bool, char, int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t, float,
+	double, std::string_view>;
+
+/**************************
+ * @brief Read value from the beginning of data and remove it from data.
+ *
+ * @return True if data is large enough, false otherwise.
+ */
+template <typename T> bool Read(std::string_view& data, T& value) noexcept
+{
+	if (data.size() < sizeof(T)) {
+		return false;
+	}
+	std::memcpy(&value, data.data(), sizeof(T));
+	data.remove_prefix(sizeof(T));
+	return true;
+}
+
+/**************************
+ * @brief Read string stored as size and characters from the beginning of data and remove it from data.
+ *
+ * @return True if data is large enough, false otherwise.
+ */
+bool Read(std::string_view& data, std::string_view& value) noexcept
+{
+	uint32_t size;
+	if (!Read(data, size) || data.size() < size) {
+		return false;
+	}
+	value = data.substr(0, size);
+	data.remove_prefix(size);
+	return true;
+}
+
+/**************************
+ * @brief Read value of given type from the beginning of data and remove it from data.
+ *
+ * @return True if type is known and data is large enough, false otherwise.
+ */
+bool Read(std::string_view& data, const Type type, Value& value) noexcept
+{
+	static_assert(U(Type::Max) == 14, "Missed reading of argument for a new type enum");
+
+	const auto read{ [&data, &value]<typename T>() {
+		T typed;
+		if (!Read(data, typed)) {
+			return false;
+		}
+		value = typed;
+		return true;
+	} };
+
+	switch (type) {
+	case Type::Bool:
+		return read.template operator()<bool>();
+	case Type::Char:
+		return read.template operator()<char>();
+	case Type::Int8:
+		return read.template operator()<int8_t>();
+	case Type::Int16:
+		return read.template operator()<int16_t>();
+	case Type::Int32:
+		return read.template operator()<int32_t>();
+	case Type::Int64:
+		return read.template operator()<int64_t>();
+	case Type::Uint8:
+		return read.template operator()<uint8_t>();
+	case Type::Uint16:
+		return read.template operator()<uint16_t>();
+	case Type::Uint32:
+		return read.template operator()<uint32_t>();
+	case Type::Uint64:
+		return read.template operator()<uint64_t>();
+	case Type::Float:
+		return read.template operator()<float>();
+	case Type::Double:
+		return read.template operator()<double>();
+	case Type::String:
+		return read.template operator()<std::string_view>();
+	default:
+		return false;
+	}
+}
+
+} // namespace
+
+const Site& Register(const Log::Level level, const std::string_view pattern, const std::string_view function,
+	const uint32_t line, const bool withThread, std::vector<Type>&& types)
+{
+	auto& registry{ GetRegistry() };
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	auto& site{ registry.sites.emplace_back() };
+	site.id = static_cast<uint32_t>(registry.sites.size());
+	site.level = level;
+	site.withThread = withThread;
+	site.types = std::move(types);
+	site.place = std::format("{}({}): ", function, line);
+	site.pattern = pattern;
+	registry.size.store(site.id, std::memory_order_release);
+	return site;
+}
+
+const Site* GetSite(const uint32_t id) noexcept
+{
+	auto& registry{ GetRegistry() };
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	if (id == 0 || id > registry.sites.size()) {
+		return nullptr;
+	}
+	return &registry.sites[id - 1];
+}
+
+uint32_t GetSitesSize() noexcept { return GetRegistry().size.load(std::memory_order_acquire); }
+
+uint32_t AppendSites(std::string& out, const uint32_t from)
+{
+	auto& registry{ GetRegistry() };
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	std::string payload;
+	for (auto index{ static_cast<size_t>(from) }; index < registry.sites.size(); ++index) {
+		const auto& site{ registry.sites[index] };
+		const auto placeSize{ static_cast<uint32_t>(site.place.size()) };
+		payload.clear();
+		payload += static_cast<char>(site.withThread);
+		payload += static_cast<char>(site.types.size());
+		for (const auto type : site.types) {
+			payload += static_cast<char>(type);
+		}
+		payload.append(reinterpret_cast<const char*>(&placeSize), sizeof(placeSize));
+		payload += site.place;
+		payload += site.pattern;
+		AppendEntry(out, Kind::Site, 0, site.id, site.level, payload);
+	}
+	return static_cast<uint32_t>(registry.sites.size());
+}
+
+void AppendEntry(std::string& out, const Kind kind, const int64_t timestamp, const uint32_t site,
+	const Log::Level level, const std::string_view payload)
+{
+	const auto size{ static_cast<uint32_t>(payload.size()) };
+	const auto offset{ out.size() };
+	out.resize(offset + ENTRY_HEADER_SIZE);
+	char* header{ out.data() + offset };
+	std::memcpy(header, &timestamp, sizeof(timestamp));
+	std::memcpy(header + 8, &size, sizeof(size));
+	std::memcpy(header + 12, &site, sizeof(site));
+	header[16] = static_cast<char>(kind);
+	header[17] = static_cast<char>(level);
+	out += payload;
+}
+
+bool Format(std::string& out, const Site& site, std::string_view arguments)
+{
+	int32_t thread{};
+	if (site.withThread && !Read(arguments, thread)) {
+		return false;
+	}
+
+	std::vector<Value> values(site.types.size());
+	for (size_t index{ 0 }; index < site.types.size(); ++index) {
+		if (!Read(arguments, site.types[index], values[index])) {
+			return false;
+		}
+	}
+	if (!arguments.empty()) {
+		return false;
+	}
+
+	if (site.withThread) {
+		std::format_to(std::back_inserter(out), "{} : ", thread);
+	}
+	out += site.place;
+
+	const std::string_view pattern{ site.pattern };
+	size_t next{ 0 };
+	std::string field{ "{" };
+	for (size_t index{ 0 }; index < pattern.size(); ++index) {
+		if (pattern[index] == '}') {
+			out += '}';
+			index += static_cast<size_t>(index + 1 < pattern.size() && pattern[index + 1] == '}');
+			continue;
+		}
+		if (pattern[index] != '{') {
+			out += pattern[index];
+			continue;
+		}
+		if (index + 1 < pattern.size() && pattern[index + 1] == '{') {
+			out += '{';
+			++index;
+			continue;
+		}
+
+		const auto end{ pattern.find('}', index) };
+		if (end == std::string_view::npos) {
+			return false;
+		}
+		const auto replacement{ pattern.substr(index + 1, end - index - 1) };
+		const auto colon{ replacement.find(':') };
+		const auto id{ replacement.substr(0, colon) };
+		size_t argument{ next++ };
+		if (!id.empty() && std::from_chars(id.data(), id.data() + id.size(), argument).ec != std::errc{}) {
+			return false;
+		}
+		if (argument >= values.size()) {
+			return false;
+		}
+
+		field.resize(1);
+		if (colon != std::string_view::npos) {
+			field += replacement.substr(colon);
+		}
+		field += '}';
+		std::visit(
+			[&out, &field](const auto& value) {
+				try {
+					std::vformat_to(std::back_inserter(out), field, std::make_format_args(value));
+				}
+				catch (const std::format_error&) {
+					std::format_to(std::back_inserter(out), "{}", value);
+				}
+			},
+			values[argument]);
+		index = end;
+	}
+
+	return true;
+}
+
+bool Decoder::Decode(const std::string_view data, size_t& offset, std::string& lines)
+{
+	static_assert(U(Kind::Max) == 5, "Missed decoding of entry for a new kind enum");
+
+	while (data.size() - offset >= ENTRY_HEADER_SIZE) {
+		int64_t timestamp;
+		uint32_t size;
+		uint32_t id;
+		const char* const header{ data.data() + offset };
+		std::memcpy(&timestamp, header, sizeof(timestamp));
+		std::memcpy(&size, header + 8, sizeof(size));
+		std::memcpy(&id, header + 12, sizeof(id));
+		const auto kind{ static_cast<Kind>(header[16]) };
+		const auto level{ static_cast<Log::Level>(header[17]) };
+		//* Preallocated tail of log file segment which was not finished, e.g. after crash
+		if (timestamp == 0 && size == 0 && id == 0 && kind == Kind::Undefined && level == Log::Level::Undefined) {
+			offset = data.size();
+			return true;
+		}
+		if (data.size() - offset - ENTRY_HEADER_SIZE < size) {
+			return true;
+		}
+		if (level <= Log::Level::Undefined || level >= Log::Level::Max) {
+			return false;
+		}
+
+		std::string_view payload{ data.substr(offset + ENTRY_HEADER_SIZE, size) };
+		switch (kind) {
+		case Kind::Begin:
+			m_name = payload;
+			m_sites.clear();
+			break;
+		case Kind::Site: {
+			uint8_t withThread;
+			uint8_t typesSize;
+			if (id == 0 || !Read(payload, withThread) || !Read(payload, typesSize) || payload.size() < typesSize) {
+				return false;
+			}
+
+			Site site{ id, level, withThread != 0, {}, {}, {} };
+			for (uint8_t index{ 0 }; index < typesSize; ++index) {
+				const auto type{ static_cast<Type>(payload[index]) };
+				if (type <= Type::Undefined || type >= Type::Max) {
+					return false;
+				}
+				site.types.push_back(type);
+			}
+			payload.remove_prefix(typesSize);
+
+			std::string_view place;
+			if (!Read(payload, place)) {
+				return false;
+			}
+			site.place = place;
+			site.pattern = payload;
+			if (m_sites.size() < id) {
+				m_sites.resize(id);
+			}
+			m_sites[id - 1] = std::move(site);
+		} break;
+		case Kind::Text:
+			Log::AppendLine(lines, timestamp, level, m_name, payload);
+			break;
+		case Kind::Record: {
+			if (id == 0 || id > m_sites.size() || m_sites[id - 1].id != id) {
+				return false;
+			}
+			std::string text;
+			if (!Format(text, m_sites[id - 1], payload)) {
+				return false;
+			}
+			Log::AppendLine(lines, timestamp, level, m_name, text);
+		} break;
+		default:
+			return false;
+		}
+
+		offset += ENTRY_HEADER_SIZE + size;
+	}
+
+	return true;
+}
+
+}; //* namespace BinaryLog
+
+}; //* namespace MSAPI
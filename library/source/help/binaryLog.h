@@ -0,0 +1,344 @@
+/**************************
+ * @file        binaryLog.h
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef MSAPI_BINARY_LOG_H
+#define MSAPI_BINARY_LOG_H
+
+#include "log.h"
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+namespace MSAPI {
+
+/**************************
+ * @brief Deferred formatting of log messages. Call site registers its pattern and types of arguments once, each call
+ * copies only id of site and raw bytes of arguments, message is formatted by writer of logger or by decoder of binary
+ * log file.
+ *
+ * @note Binary log file is a sequence of entries, each entry is header of ENTRY_HEADER_SIZE bytes followed by
+ * payload:
+ * 8 bytes - timestamp in nanoseconds since epoch;
+ * 4 bytes - size of payload;
+ * 4 bytes - id of site;
+ * 1 byte - kind of entry;
+ * 1 byte - level.
+ *
+ * @note Payload depends on kind of entry:
+ * Begin - name of program, starts session of logger, ids of sites are valid within session;
+ * Site - 1 byte flag of thread id, 1 byte number of arguments, types of arguments by 1 byte, 4 bytes size of place,
+ * place of call and pattern;
+ * Text - text of message;
+ * Record - 4 bytes thread id if flag of site is set and arguments: arithmetic values as is, strings as 4 bytes size
+ * and characters.
+ *
+ * @note All numbers are in byte order of host.
+ * @note Header of zeros ends data, it is not written tail of preallocated log file segment.
+ */
+namespace BinaryLog {
+
+constexpr size_t ENTRY_HEADER_SIZE{ 18 };
+
+enum class Type : int8_t { Undefined, Bool, Char, Int8, Int16, Int32, Int64, Uint8, Uint16, Uint32, Uint64, Float,
+	Double, String, Max };
+
+enum class Kind : int8_t { Undefined, Begin, Site, Text, Record, Max };
+
+/**************************
+ * @brief Registered call site.
+ */
+struct Site {
+	uint32_t id{};
+	Log::Level level{ Log::Level::Undefined };
+	bool withThread{};
+	std::vector<Type> types;
+	std::string place;
+	std::string pattern;
+};
+
+/*---------------------------------------------------------------------------------
+Registry of sites
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Register site, called once for each call site.
+ *
+ * @param level Level of messages.
+ * @param pattern Format pattern.
+ * @param function Name of function of call site.
+ * @param line Line of call site.
+ * @param withThread True if records contain thread id.
+ * @param types Types of arguments.
+ *
+ * @return Registered site, reference is valid until end of program.
+ */
+const Site& Register(Log::Level level, std::string_view pattern, std::string_view function, uint32_t line,
+	bool withThread, std::vector<Type>&& types);
+
+/**************************
+ * @return Registered site, nullptr if site with the id is not registered.
+ */
+const Site* GetSite(uint32_t id) noexcept;
+
+/**************************
+ * @return Number of registered sites, ids of sites are from 1 to this number.
+ */
+uint32_t GetSitesSize() noexcept;
+
+/**************************
+ * @brief Append Site entries of registered sites with ids greater than given one.
+ *
+ * @return Id of the last appended site.
+ */
+uint32_t AppendSites(std::string& out, uint32_t from);
+
+/*---------------------------------------------------------------------------------
+Encoding and decoding
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Append entry to binary log.
+ */
+void AppendEntry(
+	std::string& out, Kind kind, int64_t timestamp, uint32_t site, Log::Level level, std::string_view payload);
+
+/**************************
+ * @brief Append place and formatted message of record.
+ *
+ * @param out String to append to.
+ * @param site Site of record.
+ * @param arguments Arguments of record.
+ *
+ * @return True if arguments match types of site, false otherwise.
+ */
+bool Format(std::string& out, const Site& site, std::string_view arguments);
+
+/**************************
+ * @brief Decoder of binary log files into text format of logger.
+ */
+class Decoder {
+private:
+	std::string m_name;
+	std::vector<Site> m_sites;
+
+public:
+	/**************************
+	 * @brief Decode complete entries of data and append lines of them.
+	 *
+	 * @param data Binary log data, may end with incomplete entry.
+	 * @param offset Offset of the first not decoded entry, is updated.
+	 * @param lines String to append lines to.
+	 *
+	 * @return True if data is correct so far, false if data is corrupted.
+	 */
+	[[nodiscard]] bool Decode(std::string_view data, size_t& offset, std::string& lines);
+};
+
+/*---------------------------------------------------------------------------------
+Writing of records
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @return Argument converted to type it is stored as. Types without binary representation are formatted in place.
+ */
+template <typename T> FORCE_INLINE [[nodiscard]] auto Normalize(const T& value)
+{
+	if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, char> || std::is_same_v<T, float>
+		|| std::is_same_v<T, double>) {
+
+		return value;
+	}
+	else if constexpr (std::is_same_v<T, long double>) {
+		return static_cast<double>(value);
+	}
+	else if constexpr (std::is_integral_v<T>) {
+		if constexpr (std::is_signed_v<T>) {
+			return static_cast<std::conditional_t<sizeof(T) == 1, int8_t,
+				std::conditional_t<sizeof(T) == 2, int16_t, std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>>>(
+				value);
+		}
+		else {
+			return static_cast<std::conditional_t<sizeof(T) == 1, uint8_t,
+				std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>>(
+				value);
+		}
+	}
+	else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+		return std::string_view{ value };
+	}
+	else {
+		return std::format("{}", value);
+	}
+}
+
+/**************************
+ * @return Type of normalized argument.
+ */
+template <typename T> consteval Type GetType()
+{
+	static_assert(U(Type::Max) == 14, "Missed type of argument for a new type enum");
+
+	if constexpr (std::is_same_v<T, bool>) {
+		return Type::Bool;
+	}
+	else if constexpr (std::is_same_v<T, char>) {
+		return Type::Char;
+	}
+	else if constexpr (std::is_same_v<T, int8_t>) {
+		return Type::Int8;
+	}
+	else if constexpr (std::is_same_v<T, int16_t>) {
+		return Type::Int16;
+	}
+	else if constexpr (std::is_same_v<T, int32_t>) {
+		return Type::Int32;
+	}
+	else if constexpr (std::is_same_v<T, int64_t>) {
+		return Type::Int64;
+	}
+	else if constexpr (std::is_same_v<T, uint8_t>) {
+		return Type::Uint8;
+	}
+	else if constexpr (std::is_same_v<T, uint16_t>) {
+		return Type::Uint16;
+	}
+	else if constexpr (std::is_same_v<T, uint32_t>) {
+		return Type::Uint32;
+	}
+	else if constexpr (std::is_same_v<T, uint64_t>) {
+		return Type::Uint64;
+	}
+	else if constexpr (std::is_same_v<T, float>) {
+		return Type::Float;
+	}
+	else if constexpr (std::is_same_v<T, double>) {
+		return Type::Double;
+	}
+	else {
+		static_assert(std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>, "Unexpected type");
+		return Type::String;
+	}
+}
+
+/**************************
+ * @brief Register site with types of given arguments.
+ */
+template <typename... Args>
+const Site& Register(const Log::Level level, const std::string_view pattern, const std::string_view function,
+	const uint32_t line, const bool withThread)
+{
+	return Register(level, pattern, function, line, withThread,
+		std::vector<Type>{ GetType<decltype(Normalize(std::declval<const Args&>()))>()... });
+}
+
+/**************************
+ * @return Size of normalized argument in record.
+ */
+template <typename T> FORCE_INLINE [[nodiscard]] size_t GetSize(const T& value) noexcept
+{
+	if constexpr (std::is_arithmetic_v<T>) {
+		return sizeof(T);
+	}
+	else {
+		return sizeof(uint32_t) + value.size();
+	}
+}
+
+/**************************
+ * @brief Copy normalized argument to record.
+ *
+ * @return Pointer to place after argument.
+ */
+template <typename T> FORCE_INLINE char* Put(char* place, const T& value) noexcept
+{
+	if constexpr (std::is_arithmetic_v<T>) {
+		std::memcpy(place, &value, sizeof(T));
+		return place + sizeof(T);
+	}
+	else {
+		const auto size{ static_cast<uint32_t>(value.size()) };
+		std::memcpy(place, &size, sizeof(size));
+		std::memcpy(place + sizeof(size), value.data(), size);
+		return place + sizeof(size) + size;
+	}
+}
+
+/**************************
+ * @return Id of current thread, cached in thread.
+ */
+FORCE_INLINE [[nodiscard]] int32_t GetThreadId() noexcept
+{
+	thread_local const int32_t id{ static_cast<int32_t>(gettid()) };
+	return id;
+}
+
+/**************************
+ * @brief Copy arguments into record of logger, message is formatted later.
+ */
+template <typename... Args> void Print(const Site& site, const Args&... args)
+{
+	const auto values{ std::make_tuple(Normalize(args)...) };
+	const size_t size{ (site.withThread ? sizeof(int32_t) : 0)
+		+ std::apply([](const auto&... value) { return (size_t{ 0 } + ... + GetSize(value)); }, values) };
+
+	auto* place{ static_cast<char*>(logger.Reserve(site.id, site.level, size)) };
+	if (place == nullptr) {
+		return;
+	}
+
+	if (site.withThread) {
+		place = Put(place, GetThreadId());
+	}
+	std::apply([&place](const auto&... value) { ((place = Put(place, value)), ...); }, values);
+	logger.Publish();
+}
+
+}; //* namespace BinaryLog
+
+}; //* namespace MSAPI
+
+#ifdef NDEBUG
+#define LOG_BINARY_WITH_THREAD false
+#else
+#define LOG_BINARY_WITH_THREAD true
+#endif
+
+/**************************
+ * @brief Print message with deferred formatting if level is enabled. Site is registered on the first call, pattern is
+ * checked at compile time as by std::format.
+ */
+#define LOG_BINARY_IF_ENABLED(level, pattern, ...)                                                                     \
+	do {                                                                                                               \
+		if (MSAPI::logger.IsEnabled(level)) {                                                                          \
+			[]([[maybe_unused]] const char* const function, const auto&... arguments) {                               \
+				[[maybe_unused]] static constexpr std::format_string<decltype(arguments)...> check{ pattern };         \
+				static const MSAPI::BinaryLog::Site& site{                                                             \
+					MSAPI::BinaryLog::Register<std::decay_t<decltype(arguments)>...>(                                  \
+						level, pattern, function, __LINE__, LOG_BINARY_WITH_THREAD)                                    \
+				};                                                                                                     \
+				MSAPI::BinaryLog::Print(site, arguments...);                                                           \
+			}(__func__ __VA_OPT__(, ) __VA_ARGS__);                                                                    \
+		}                                                                                                              \
+	} while (false)
+
+#endif //* MSAPI_BINARY_LOG_H
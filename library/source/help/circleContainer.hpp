@@ -1,5 +1,5 @@
 /**************************
- * @file        circleContainer.h
+ * @file        circleContainer.hpp
  * @version     6.0
  * @date        2025-06-03
  * @author      maks.angels@mail.ru
@@ -20,132 +20,152 @@
 #ifndef MSAPI_CIRCLE_CONTAINER
 #define MSAPI_CIRCLE_CONTAINER
 
-#include <array>
+#include "log.h"
+#include <algorithm>
 #include <atomic>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
-#include <cstdio>
-#include <cstring>
-#include <format>
-#include <iostream>
-#include <stdio.h>
-#include <thread>
-#include <unistd.h>
+#include <memory>
 
 namespace MSAPI {
 
 /**************************
- * @brief Circle buffer container.
+ * @brief Single producer single consumer circle buffer of variable size records. Producer and consumer positions are
+ * placed in their own cache lines and each side caches position of the other one, so shared cache lines are touched
+ * only when cached position is not enough. Record is contiguous, if it does not fit before the end of buffer, rest of
+ * buffer is skipped by padding record.
  *
- * @tparam T Type of buffer holder.
- * @tparam Size Number of buffer holders to be in cycle-chain.
+ * @attention Only one thread may produce and only one thread may consume records.
  */
-template <typename T, int_fast32_t Size> class CircleContainer {
-private:
-	static std::atomic<bool> m_ready;
-
-	struct Node {
-		T value;
-		Node* next;
-	};
-
+class CircleContainer {
 public:
-	class Accessor {
-	private:
-		Node* m_current;
-		std::atomic<bool>& m_ready{ CircleContainer::m_ready };
-
-	public:
-		Accessor(CircleContainer& container)
-			: m_current{ &container.m_nodes[0] }
-		{
-		}
+	/**************************
+	 * @brief Alignment of records.
+	 */
+	static constexpr size_t ALIGNMENT{ 8 };
 
-		T& GetCurrent()
-		{
-			struct ANON {
-				Node** node;
-				std::atomic<bool>& ready;
-
-				~ANON()
-				{
-					*node = (*node)->next;
-					// 	std::cout << "--> store true" << std::endl;
-					ready.store(true);
-					// 	std::cout << "--> notify true" << std::endl;
-					ready.notify_one();
-				}
-			} tmp{ &m_current, m_ready };
-
-			// 			std::cout << "--> wait true" << std::endl;
-			m_ready.wait(false);
-			// 			std::cout << "--> store false" << std::endl;
-			m_ready.store(false);
-			// 			std::cout << "--> notify false" << std::endl;
-			m_ready.notify_one();
-			return m_current->value;
-		};
+private:
+	/**************************
+	 * @brief Header before each record, padding header skips the rest of buffer.
+	 */
+	struct Header {
+		uint32_t size;
+		uint32_t isPadding;
 	};
 
-private:
-	std::array<Node, Size> m_nodes;
+	static_assert(sizeof(Header) == ALIGNMENT, "Header must keep alignment of records");
+
+	const size_t m_capacity;
+	const std::unique_ptr<char[]> m_buffer;
+	alignas(64) std::atomic<size_t> m_head{};
+	size_t m_cachedTail{};
+	size_t m_reservedHead{};
+	alignas(64) std::atomic<size_t> m_tail{};
+	size_t m_cachedHead{};
 
 public:
-	CircleContainer()
+	/**************************
+	 * @brief Construct a new Circle Container object.
+	 *
+	 * @param capacity Size of buffer in bytes, is rounded up to power of two and is not less than 64.
+	 */
+	FORCE_INLINE explicit CircleContainer(const size_t capacity)
+		: m_capacity{ std::bit_ceil(std::max(capacity, size_t{ 64 })) }
+		, m_buffer{ new char[m_capacity] }
 	{
-		const auto end{ Size - 1 };
-		for (int_fast32_t index{ 0 }; index < end; ++index) {
-			m_nodes[index].next = &m_nodes[index + 1];
-		}
-
-		m_nodes[end].next = &m_nodes[0];
 	}
 
-	//* For ability to access m_nodes and m_ready in constructor
-	friend class Accessor;
-};
+	/**************************
+	 * @return Maximum size of record, record of this size always fits into empty container.
+	 */
+	FORCE_INLINE [[nodiscard]] size_t GetMaxRecordSize() const noexcept { return m_capacity / 2 - sizeof(Header); }
+
+	/**************************
+	 * @brief Reserve place for record, called by producer. Record is visible to consumer after Publish().
+	 *
+	 * @param size Size of record, must not be greater than GetMaxRecordSize().
+	 *
+	 * @return Pointer to place of record aligned to ALIGNMENT, nullptr if container has no free space.
+	 */
+	FORCE_INLINE [[nodiscard]] void* Reserve(const size_t size) noexcept
+	{
+		const size_t total{ GetTotalSize(size) };
+		size_t head{ m_head.load(std::memory_order_relaxed) };
+		const size_t contiguous{ m_capacity - (head & (m_capacity - 1)) };
+		const size_t required{ contiguous < total ? contiguous + total : total };
+		if (head + required - m_cachedTail > m_capacity) {
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+			if (head + required - m_cachedTail > m_capacity) {
+				return nullptr;
+			}
+		}
 
-struct Buffers {
-#define BUFFERS_COUNTER 1024
-	static std::atomic<int_fast32_t> writesCounter;
+		if (contiguous < total) {
+			*reinterpret_cast<Header*>(&m_buffer[head & (m_capacity - 1)]) = Header{ 0, 1 };
+			head += contiguous;
+		}
 
-	struct Buffer {
-		void* buffer;
-		int_fast16_t size;
-		static const int_fast16_t pageSize;
+		char* const place{ &m_buffer[head & (m_capacity - 1)] };
+		*reinterpret_cast<Header*>(place) = Header{ static_cast<uint32_t>(size), 0 };
+		m_reservedHead = head + total;
+		return place + sizeof(Header);
+	}
 
-		Buffer()
-		{
-			buffer = aligned_alloc(pageSize, pageSize);
-			if (buffer == nullptr) [[unlikely]] {
-				throw std::bad_alloc{};
+	/**************************
+	 * @brief Make reserved record visible to consumer, called by producer.
+	 */
+	FORCE_INLINE void Publish() noexcept { m_head.store(m_reservedHead, std::memory_order_release); }
+
+	/**************************
+	 * @brief Get the oldest record, called by consumer.
+	 *
+	 * @param size Size of record.
+	 *
+	 * @return Pointer to record, nullptr if container is empty.
+	 */
+	FORCE_INLINE [[nodiscard]] const void* Front(size_t& size) noexcept
+	{
+		size_t tail{ m_tail.load(std::memory_order_relaxed) };
+		while (true) {
+			if (tail == m_cachedHead) {
+				m_cachedHead = m_head.load(std::memory_order_acquire);
+				if (tail == m_cachedHead) {
+					return nullptr;
+				}
 			}
-			// 			std::cout << "allocate at " << buffer << std::endl;
-		}
 
-		~Buffer() { free(buffer); }
-	};
+			const auto* const header{ reinterpret_cast<const Header*>(&m_buffer[tail & (m_capacity - 1)]) };
+			if (header->isPadding == 0) {
+				size = header->size;
+				return header + 1;
+			}
 
-	Buffers() { }
+			tail += m_capacity - (tail & (m_capacity - 1));
+			m_tail.store(tail, std::memory_order_release);
+		}
+	}
 
-	//* 4MB of memory if page size is 4KB
-	CircleContainer<Buffer, BUFFERS_COUNTER> buffers;
-	CircleContainer<Buffer, BUFFERS_COUNTER>::Accessor accessor{ buffers };
+	/**************************
+	 * @brief Release the oldest record returned by Front(), called by consumer.
+	 */
+	FORCE_INLINE void Pop() noexcept
+	{
+		const size_t tail{ m_tail.load(std::memory_order_relaxed) };
+		const auto* const header{ reinterpret_cast<const Header*>(&m_buffer[tail & (m_capacity - 1)]) };
+		m_tail.store(tail + GetTotalSize(header->size), std::memory_order_release);
+	}
 
-	void Write(const void* from, int_fast16_t size)
+private:
+	/**************************
+	 * @return Size of record with header rounded up to alignment.
+	 */
+	FORCE_INLINE [[nodiscard]] static size_t GetTotalSize(const size_t size) noexcept
 	{
-		auto& current{ accessor.GetCurrent() };
-		current.size = std::min(size, Buffer::pageSize);
-		// 		std::cout << "<-- write to " << current.buffer << " " << std::string_view{ static_cast<const
-		// char*>(from), size } << std::endl;
-		memcpy(current.buffer, from, current.size);
-		writesCounter.fetch_add(1, std::memory_order_relaxed);
+		return sizeof(Header) + ((size + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
 	}
 };
 
-template <> std::atomic<bool> CircleContainer<Buffers::Buffer, BUFFERS_COUNTER>::m_ready = true;
-std::atomic<int_fast32_t> Buffers::writesCounter = 0;
-const int_fast16_t Buffers::Buffer::pageSize = 4096; // Only for tests
-
 }; //* namespace MSAPI
 
-#endif //* MSAPI_CIRCLE_CONTAINER
\ No newline at end of file
+#endif //* MSAPI_CIRCLE_CONTAINER
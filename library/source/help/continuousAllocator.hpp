@@ -1,7 +1,7 @@
 /**************************
- * @file        continuousAllocator.h
+ * @file        continuousAllocator.hpp
  * @version     6.0
- * @date        2025-05-30
+ * @date        2026-10-18
  * @author      maks.angels@mail.ru
  * @copyright   © 2021–2026 Maksim Andreevich Leonov
  *
@@ -15,266 +15,750 @@
  * For commercial use, please contact: maks.angels@mail.ru
  *
  * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ *
+ * @brief Allocators over continuous memory of page aligned slabs. Slabs are mapped by 2 MB aligned to huge page, so
+ * they are backed by transparent huge pages, and by explicit huge pages if MSAPI_ALLOCATOR_HUGE_PAGES definition
+ * (CMake option with the same name) is set and pages are reserved in the system. Slabs are cut into 64 KB chunks which
+ * are used by pools and arenas.
+ *
+ * Pools serve objects up to 1024 bytes in size classes of 16 bytes. Each thread has cache of free objects per class,
+ * allocation and deallocation take object from cache or put it there without synchronization. Empty cache takes
+ * batch of objects from central depot of class, overfilled cache returns batch to depot, cache of finished thread is
+ * returned to depot entirely. Memory of pools is never returned to the system.
+ *
+ * Arena allocates by moving pointer inside chunk and frees everything at once, it is intended for data living not
+ * longer than one request.
  */
 
 #ifndef MSAPI_CONTINUOUS_ALLOCATOR
 #define MSAPI_CONTINUOUS_ALLOCATOR
 
 #include "log.h"
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <limits>
-#include <memory>
-#include <stdexcept>
-#include <vector>
+#include <mutex>
+#include <new>
+#include <sys/mman.h>
+#include <type_traits>
 
 namespace MSAPI {
 
-//! This is first-touch implementation and has to be polished
-//! Tests for allocators are required for using in production
+namespace Allocator {
+
+static constexpr size_t PAGE_SIZE{ 4096 };
+static constexpr size_t HUGE_PAGE_SIZE{ 2 * 1024 * 1024 };
+static constexpr size_t SLAB_SIZE{ HUGE_PAGE_SIZE };
+static constexpr size_t CHUNK_SIZE{ 64 * 1024 };
+//* Size classes are multiples of step, step is also alignment of pooled objects
+static constexpr size_t CLASS_STEP{ 16 };
+static constexpr size_t CLASSES{ 64 };
+static constexpr size_t MAX_POOLED_SIZE{ CLASS_STEP * CLASSES };
 
 /**************************
- * @brief Allocator for maximizing CPU code prediction features, due to continuous memory allocations. By default
- * allocates numbers of objects which fits in page size. Can be stored only object which size is less than page size.
- * @brief Data on page stored in next principle: first 20 bytes is information about page next first half is an array of
- * nodes with their meta information and second half contains continuos buffer with objects.
- *
- * @tparam T Type of stored object.
+ * @return Size rounded up to alignment, alignment must be power of two.
  */
-template <typename T> class ContinuousAllocator {
-private:
-	static inline const constexpr int_fast16_t pageSize{ 4096 };
-	static inline const constexpr int_fast16_t freeNodesSize{ 100 };
-	static std::atomic<bool> m_ready;
-
-public:
-	struct FreeNodes {
-		int_fast32_t continuousSize;
-		int_fast32_t offset;
-		void* begin;
-
-		FreeNodes(const int_fast32_t continuousSize, const int_fast32_t offset, void* begin)
-			: continuousSize{ continuousSize }
-			, offset{ offset }
-			, begin{ begin }
-		{
-		}
-
-		~FreeNodes() { }
-
-		FreeNodes(const FreeNodes& other) = delete;
-		FreeNodes(FreeNodes&& other) = delete;
-		FreeNodes& operator=(const FreeNodes& other) = delete;
-		FreeNodes& operator=(FreeNodes&&) = delete;
+FORCE_INLINE [[nodiscard]] constexpr size_t Align(const size_t size, const size_t alignment) noexcept
+{
+	return (size + alignment - 1) & ~(alignment - 1);
+}
 
-		FORCE_INLINE void UpdateBegin(void* bufferBegin) { begin = &static_cast<int8_t*>(bufferBegin)[offset]; }
+/**************************
+ * @brief Source of page aligned memory. Mapped slabs are cut into chunks, released chunks are reused and slabs are
+ * never unmapped.
+ */
+class Slabs {
+private:
+	//* Free chunk, is placed at the beginning of chunk
+	struct FreeChunk {
+		FreeChunk* next;
 	};
 
-	using value_type = T;
-
-private:
-	int_fast64_t m_blockSize;
-	int_fast64_t m_bufferSize{ pageSize };
-	std::vector<FreeNodes> m_freeNodes(freeNodesSize);
-	void* m_buffer;
+	std::mutex m_mutex;
+	char* m_cursor{};
+	char* m_end{};
+	FreeChunk* m_free{};
+	std::atomic<size_t> m_mapped{};
 
 public:
-	explicit ContinuousAllocator(const int_fast64_t m_blockSize = pageSize / sizeof(T))
-		: m_blockSize{ m_blockSize }
+	/**************************
+	 * @return Process wide slabs, they are never destroyed to be available for static and thread local objects.
+	 */
+	FORCE_INLINE static Slabs& Get()
 	{
-		(void)AllocatePage<true>();
+		static Slabs* slabs{ new Slabs };
+		return *slabs;
 	}
 
-	template <typename U> friend class ContinuousAllocator;
+	/**************************
+	 * @return Chunk of CHUNK_SIZE bytes aligned to page, nullptr if memory can not be mapped.
+	 */
+	FORCE_INLINE [[nodiscard]] void* AllocateChunk() noexcept
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+		if (m_free != nullptr) {
+			FreeChunk* chunk{ m_free };
+			m_free = chunk->next;
+			return chunk;
+		}
 
-	template <typename U> struct rebind {
-		using other = PoolAllocator<U>;
-	};
+		if (m_cursor == m_end) [[unlikely]] {
+			m_cursor = static_cast<char*>(Map(SLAB_SIZE, true));
+			if (m_cursor == nullptr) [[unlikely]] {
+				m_end = nullptr;
+				return nullptr;
+			}
+			m_end = m_cursor + SLAB_SIZE;
+		}
 
-	template <typename U>
-	ContinuousAllocator(const ContinuousAllocator<U>& other)
-		: m_blockSize{ other.m_blockSize }
-	{
-		DeallocateAll();
-		m_currentNode = nullptr;
-		m_availableNodes = 0;
+		void* chunk{ m_cursor };
+		m_cursor += CHUNK_SIZE;
+		return chunk;
 	}
 
-	~ContinuousAllocator() { DeallocateAll(); }
+	/**************************
+	 * @brief Return chunk for reuse.
+	 */
+	FORCE_INLINE void DeallocateChunk(void* const chunk) noexcept
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+		m_free = new (chunk) FreeChunk{ m_free };
+	}
 
-	FORCE_INLINE T* allocate(const int_fast64_t toAllocate)
+	/**************************
+	 * @brief Map memory. Huge mapping is aligned to huge page and tries explicit huge pages first if
+	 * MSAPI_ALLOCATOR_HUGE_PAGES is defined, otherwise transparent huge pages are advised.
+	 *
+	 * @param size Size in bytes, rounded up to page or huge page.
+	 * @param isHuge True to align mapping to huge page.
+	 *
+	 * @return Mapped memory, nullptr if memory can not be mapped.
+	 */
+	FORCE_INLINE [[nodiscard]] void* Map(size_t size, const bool isHuge) noexcept
 	{
-#define TMP_MSAPI_CONTINUOUS_ALLOCATOR_BLOCK_OR_WAIT                                                                   \
-	struct ANON {                                                                                                      \
-		std::atomic<bool>& ready;                                                                                      \
-                                                                                                                       \
-		~ANON()                                                                                                        \
-		{                                                                                                              \
-			ready.store(true);                                                                                         \
-			ready.notify_one();                                                                                        \
-		}                                                                                                              \
-	} tmp{ m_ready };                                                                                                  \
-                                                                                                                       \
-	m_ready.wait(false);                                                                                               \
-	m_ready.store(false);                                                                                              \
-	m_ready.notify_one();
-
-		TMP_MSAPI_CONTINUOUS_ALLOCATOR_BLOCK_OR_WAIT;
-
-		for (auto& freeNode : m_freeNodes) {
-			if (freeNode.continuousSize >= toAllocate) {
-				auto* requestedBuffer{ freeNode.begin };
-				freeNode.begin = &static_cast<int8_t*>(requestedBuffer)[toAllocate * sizeof(T)];
-				freeNode.continuousSize -= toAllocate;
-				return requestedBuffer;
+		size = Align(size, isHuge ? HUGE_PAGE_SIZE : PAGE_SIZE);
+		if (!isHuge) {
+			void* memory{ mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+			if (memory == MAP_FAILED) [[unlikely]] {
+				LOG_ERROR("mmap of " + _S(size) + " bytes. Error №" + _S(errno) + ": " + std::strerror(errno));
+				return nullptr;
 			}
+			m_mapped.fetch_add(size, std::memory_order_relaxed);
+			return memory;
+		}
+
+#ifdef MSAPI_ALLOCATOR_HUGE_PAGES
+		if (void* memory{
+				mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0) };
+			memory != MAP_FAILED) {
+
+			m_mapped.fetch_add(size, std::memory_order_relaxed);
+			return memory;
+		}
+		LOG_WARNING_NEW("Huge pages are not available, error №{}: {}", errno, std::strerror(errno));
+#endif
+
+		//* Extra huge page for alignment, unaligned head and tail are unmapped
+		void* memory{ mmap(
+			nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+		if (memory == MAP_FAILED) [[unlikely]] {
+			LOG_ERROR("mmap of " + _S(size + HUGE_PAGE_SIZE) + " bytes. Error №" + _S(errno) + ": "
+				+ std::strerror(errno));
+			return nullptr;
 		}
 
-		if (toAllocate > m_blockSize) [[unlikely]] {
-			return AllocatePages(pageSize / toAllocate / sizeof(T) + 1);
+		auto* const begin{ static_cast<char*>(memory) };
+		auto* const aligned{ reinterpret_cast<char*>(Align(reinterpret_cast<uintptr_t>(begin), HUGE_PAGE_SIZE)) };
+		if (aligned != begin) {
+			(void)munmap(begin, static_cast<size_t>(aligned - begin));
+		}
+		if (const auto tail{ static_cast<size_t>(begin + HUGE_PAGE_SIZE - aligned) }; tail != 0) {
+			(void)munmap(aligned + size, tail);
 		}
+		(void)madvise(aligned, size, MADV_HUGEPAGE);
 
-		return AllocatePage<false>();
+		m_mapped.fetch_add(size, std::memory_order_relaxed);
+		return aligned;
 	}
 
-	FORCE_INLINE void deallocate(T* begin, int_fast64_t toDeallocate)
+	/**************************
+	 * @brief Unmap memory returned by Map().
+	 *
+	 * @param memory Mapped memory.
+	 * @param size Size given to Map().
+	 * @param isHuge The same value as given to Map().
+	 */
+	FORCE_INLINE void Unmap(void* const memory, size_t size, const bool isHuge) noexcept
 	{
-		TMP_MSAPI_CONTINUOUS_ALLOCATOR_BLOCK_OR_WAIT;
+		size = Align(size, isHuge ? HUGE_PAGE_SIZE : PAGE_SIZE);
+		if (munmap(memory, size) != 0) [[unlikely]] {
+			LOG_ERROR("munmap of " + _S(size) + " bytes. Error №" + _S(errno) + ": " + std::strerror(errno));
+			return;
+		}
+		m_mapped.fetch_sub(size, std::memory_order_relaxed);
+	}
+
+	/**************************
+	 * @return Number of currently mapped bytes.
+	 */
+	FORCE_INLINE [[nodiscard]] size_t GetMapped() const noexcept { return m_mapped.load(std::memory_order_relaxed); }
 
+private:
+	Slabs() = default;
+};
+
+/**************************
+ * @brief Pools of fixed size objects with thread local caches and central depots.
+ */
+class Pool {
+private:
+	//* Free object, batches in depot are linked by head objects
+	struct Node {
+		Node* next;
+		Node* batch;
+	};
+
+	static_assert(sizeof(Node) <= CLASS_STEP);
+
+	/**************************
+	 * @brief Central storage of free objects of one class.
+	 */
+	class Depot {
+	private:
+		std::mutex m_mutex;
+		Node* m_batches{};
+		Node* m_loose{};
+		size_t m_looseSize{};
+		char* m_cursor{};
+		char* m_end{};
+		size_t m_size{};
+		size_t m_batchSize{};
+
+	public:
+		/**************************
+		 * @brief Set size of objects and number of objects in batch, batch takes about 8 KB.
+		 */
+		FORCE_INLINE void Initialize(const size_t size) noexcept
 		{
-			Node* emptyFreeNode{ nullptr };
-			size_t index{ 0 };
-			const size_t size{ m_freeNodes.size() };
-			const uintptr_t tail{ begin + toDeallocate };
-
-			for (; index < size; ++index) {
-
-#define TMP_MSAPI_CONTINUOUS_ALLOCATOR_LOOK_FOR_CONTINUOUS                                                             \
-	auto& freeNode{ m_freeNodes[index] };                                                                              \
-                                                                                                                       \
-	/* Look for previous free sequence */                                                                              \
-	if (freeNode.begin + freeNode.continuousSize == begin) {                                                           \
-		freeNode.continuousSize += toDeallocate;                                                                       \
-                                                                                                                       \
-		/* Defragmentation in case if there is free node which is next */                                              \
-		++index;                                                                                                       \
-		for (; index < size; ++index) {                                                                                \
-			auto& freeNode2{ m_freeNodes[index] };                                                                     \
-                                                                                                                       \
-			if (freeNode2.begin == tail) {                                                                             \
-				freeNode.continuousSize += freeNode2.continuousSize;                                                   \
-				freeNode2.continuousSize = 0;                                                                          \
-			}                                                                                                          \
-		}                                                                                                              \
-                                                                                                                       \
-		return;                                                                                                        \
-	}                                                                                                                  \
-                                                                                                                       \
-	/* Look for next free sequence */                                                                                  \
-	if (freeNode.begin == tail) {                                                                                      \
-		freeNode.continuousSize += toDeallocate;                                                                       \
-		freeNode.begin = begin;                                                                                        \
-		freeNode.offset = begin - m_buffer;                                                                            \
-		return;                                                                                                        \
-	}
+			m_size = size;
+			m_batchSize = std::clamp(size_t{ 8192 } / size, size_t{ 4 }, size_t{ 256 });
+		}
 
-				TMP_MSAPI_CONTINUOUS_ALLOCATOR_LOOK_FOR_CONTINUOUS;
+		/**************************
+		 * @return Number of objects in full batch.
+		 */
+		FORCE_INLINE [[nodiscard]] size_t GetBatchSize() const noexcept { return m_batchSize; }
+
+		/**************************
+		 * @brief Take batch of free objects, new objects are cut from chunk if depot is empty.
+		 *
+		 * @param size Number of taken objects.
+		 *
+		 * @return List of objects, nullptr if memory can not be mapped.
+		 */
+		FORCE_INLINE [[nodiscard]] Node* Pop(size_t& size) noexcept
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			if (m_batches != nullptr) {
+				Node* batch{ m_batches };
+				m_batches = batch->batch;
+				size = m_batchSize;
+				return batch;
+			}
 
-				if (freeNode.continuousSize == 0) {
-					emptyFreeNode = &freeNode;
-					++index;
-					break;
+			if (m_loose != nullptr) {
+				Node* head{ m_loose };
+				Node* tail{ head };
+				size = 1;
+				for (; size < m_batchSize && tail->next != nullptr; ++size) {
+					tail = tail->next;
 				}
+				m_loose = tail->next;
+				m_looseSize -= size;
+				tail->next = nullptr;
+				return head;
+			}
+
+			Node* head{};
+			for (size = 0; size < m_batchSize; ++size) {
+				if (static_cast<size_t>(m_end - m_cursor) < m_size) [[unlikely]] {
+					m_cursor = static_cast<char*>(Slabs::Get().AllocateChunk());
+					if (m_cursor == nullptr) [[unlikely]] {
+						m_end = nullptr;
+						break;
+					}
+					m_end = m_cursor + CHUNK_SIZE;
+				}
+				head = new (m_cursor) Node{ head, nullptr };
+				m_cursor += m_size;
+			}
+			return head;
+		}
+
+		/**************************
+		 * @brief Return full batch of objects.
+		 */
+		FORCE_INLINE void Push(Node* const batch) noexcept
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			batch->batch = m_batches;
+			m_batches = batch;
+		}
+
+		/**************************
+		 * @brief Return list of objects of any size.
+		 *
+		 * @param head First object of list.
+		 * @param size Number of objects in list.
+		 */
+		FORCE_INLINE void PushLoose(Node* const head, const size_t size) noexcept
+		{
+			Node* tail{ head };
+			while (tail->next != nullptr) {
+				tail = tail->next;
 			}
 
-			for (; index < size; ++index) {
-				TMP_MSAPI_CONTINUOUS_ALLOCATOR_LOOK_FOR_CONTINUOUS;
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			tail->next = m_loose;
+			m_loose = head;
+			m_looseSize += size;
+		}
+	};
+
+	/**************************
+	 * @brief Free objects of one class owned by one thread.
+	 */
+	struct Cache {
+		Node* head{};
+		size_t size{};
+	};
 
-#undef TMP_MSAPI_CONTINUOUS_ALLOCATOR_LOOK_FOR_CONTINUOUS
+	/**************************
+	 * @brief Caches of all classes of one thread, are returned to depots on thread exit.
+	 */
+	struct Caches {
+		std::array<Cache, CLASSES> caches{};
+		bool& isDestroyed;
+
+		/**************************
+		 * @brief Destroy the Caches object, return all objects to depots.
+		 */
+		FORCE_INLINE ~Caches() noexcept
+		{
+			isDestroyed = true;
+			auto* const depots{ GetDepots() };
+			for (size_t index{ 0 }; index < CLASSES; ++index) {
+				if (caches[index].head != nullptr) {
+					depots[index].PushLoose(caches[index].head, caches[index].size);
+				}
 			}
+		}
+	};
+
+public:
+	/**************************
+	 * @param size Size of object, not greater than MAX_POOLED_SIZE.
+	 *
+	 * @return Object aligned to CLASS_STEP, nullptr if memory can not be mapped.
+	 */
+	FORCE_INLINE [[nodiscard]] static void* Allocate(const size_t size) noexcept
+	{
+		const auto index{ GetClass(size) };
+		auto* const caches{ GetCaches() };
+		if (caches == nullptr) [[unlikely]] {
+			return AllocateFromDepot(index);
+		}
 
-			if (freeNode == nullptr) {
-				m_freeNodes.emplace_back(toDeallocate, begin - m_buffer, begin);
+		auto& cache{ caches->caches[index] };
+		if (cache.head == nullptr) [[unlikely]] {
+			cache.head = GetDepots()[index].Pop(cache.size);
+			if (cache.head == nullptr) [[unlikely]] {
+				return nullptr;
 			}
-			else {
-				freeNode.continuousSize = toDeallocate;
-				freeNode.begin = begin;
-				freeNode.offset = begin - m_buffer;
+		}
+
+		Node* node{ cache.head };
+		cache.head = node->next;
+		--cache.size;
+		return node;
+	}
+
+	/**************************
+	 * @param object Object returned by Allocate().
+	 * @param size Size given to Allocate().
+	 */
+	FORCE_INLINE static void Deallocate(void* const object, const size_t size) noexcept
+	{
+		const auto index{ GetClass(size) };
+		auto* const caches{ GetCaches() };
+		if (caches == nullptr) [[unlikely]] {
+			GetDepots()[index].PushLoose(new (object) Node{ nullptr, nullptr }, 1);
+			return;
+		}
+
+		auto& cache{ caches->caches[index] };
+		cache.head = new (object) Node{ cache.head, nullptr };
+		auto& depot{ GetDepots()[index] };
+		const auto batchSize{ depot.GetBatchSize() };
+		if (++cache.size < batchSize * 2) [[likely]] {
+			return;
+		}
+
+		//* Recently freed batch stays in cache, so alternating calls on the border do not reach depot
+		Node* tail{ cache.head };
+		for (size_t count{ 1 }; count < batchSize; ++count) {
+			tail = tail->next;
+		}
+		Node* const batch{ tail->next };
+		tail->next = nullptr;
+		cache.size -= batchSize;
+		depot.Push(batch);
+	}
+
+	/**************************
+	 * @return Size class of object, size 0 is served by the first class.
+	 */
+	FORCE_INLINE [[nodiscard]] static constexpr size_t GetClass(const size_t size) noexcept
+	{
+		return size == 0 ? 0 : (size - 1) / CLASS_STEP;
+	}
+
+private:
+	/**************************
+	 * @return Depots of all classes, they are never destroyed.
+	 */
+	FORCE_INLINE [[nodiscard]] static Depot* GetDepots()
+	{
+		static Depot* depots{ [] {
+			auto* const created{ new Depot[CLASSES] };
+			for (size_t index{ 0 }; index < CLASSES; ++index) {
+				created[index].Initialize((index + 1) * CLASS_STEP);
 			}
+			return created;
+		}() };
+		return depots;
+	}
+
+	/**************************
+	 * @return Caches of current thread, nullptr if they are already destroyed on thread exit.
+	 */
+	FORCE_INLINE [[nodiscard]] static Caches* GetCaches() noexcept
+	{
+		thread_local constinit bool isDestroyed{};
+		if (isDestroyed) [[unlikely]] {
+			return nullptr;
+		}
+
+		thread_local Caches caches{ {}, isDestroyed };
+		return &caches;
+	}
+
+	/**************************
+	 * @brief Allocate object after caches of current thread are destroyed.
+	 */
+	FORCE_INLINE [[nodiscard]] static void* AllocateFromDepot(const size_t index) noexcept
+	{
+		auto& depot{ GetDepots()[index] };
+		size_t size;
+		Node* node{ depot.Pop(size) };
+		if (node != nullptr && node->next != nullptr) {
+			depot.PushLoose(node->next, size - 1);
 		}
+		return node;
 	}
+};
 
+/**************************
+ * @brief Bump allocator over chunks, memory is freed all at once by Reset() or destruction. Allocations greater than
+ * chunk are mapped separately.
+ *
+ * @attention Is not thread safe.
+ */
+class Arena {
 private:
-	FORCE_INLINE void DeallocateAll()
+	//* Header of block, is placed at the beginning of block
+	struct Block {
+		Block* next;
+		size_t size;
+	};
+
+	static constexpr size_t HEADER_SIZE{ Align(sizeof(Block), CLASS_STEP) };
+
+	Block* m_blocks{};
+	char* m_cursor{};
+	char* m_end{};
+	size_t m_allocated{};
+
+public:
+	/**************************
+	 * @brief Construct a new Arena object, empty constructor. Memory is taken on first allocation.
+	 */
+	Arena() = default;
+
+	/**************************
+	 * @brief Destroy the Arena object, return all blocks.
+	 */
+	FORCE_INLINE ~Arena() noexcept { Release(nullptr); }
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+	/**************************
+	 * @param size Size in bytes.
+	 * @param alignment Alignment, power of two not greater than page size.
+	 *
+	 * @return Memory, nullptr if memory can not be mapped.
+	 */
+	FORCE_INLINE [[nodiscard]] void* Allocate(const size_t size, const size_t alignment = alignof(std::max_align_t))
 	{
-		TMP_MSAPI_CONTINUOUS_ALLOCATOR_BLOCK_OR_WAIT;
+		const auto cursor{ reinterpret_cast<uintptr_t>(m_cursor) };
+		const auto padding{ Align(cursor, alignment) - cursor };
+		if (m_cursor == nullptr || padding + size > static_cast<size_t>(m_end - m_cursor)) [[unlikely]] {
+			return AllocateBlock(size, alignment);
+		}
 
-		m_freeNodes.clear();
-		free(m_buffer);
+		char* const memory{ m_cursor + padding };
+		m_cursor = memory + size;
+		m_allocated += size;
+		return memory;
 	}
 
-	template <bool Initialization> FORCE_INLINE void* AllocatePage()
+	/**************************
+	 * @brief Free all allocations, one chunk is kept for next allocations.
+	 */
+	FORCE_INLINE void Reset() noexcept
 	{
-		if constexpr (Initialization) {
-			m_buffer = aligned_alloc(pageSize, pageSize);
-			if (m_buffer == nullptr) [[unlikely]] {
-				LOG_ERROR("Cannot allocate alligned memory of size: " + _S(pageSize)
-					+ " bytes with alignment: " + _S(pageSize) + " for continuous allocator");
-				throw std::bad_alloc{};
+		Block* kept{};
+		for (Block* block{ m_blocks }; block != nullptr; block = block->next) {
+			if (block->size == CHUNK_SIZE) {
+				kept = block;
+				break;
 			}
+		}
 
-			m_freeNodes.emplace_back(m_blockSize, 0, m_buffer);
+		Release(kept);
+		m_blocks = kept;
+		m_allocated = 0;
+		if (kept == nullptr) {
+			m_cursor = nullptr;
+			m_end = nullptr;
+			return;
+		}
 
+		kept->next = nullptr;
+		m_cursor = reinterpret_cast<char*>(kept) + HEADER_SIZE;
+		m_end = reinterpret_cast<char*>(kept) + CHUNK_SIZE;
+	}
+
+	/**************************
+	 * @return Number of bytes allocated since construction or last reset.
+	 */
+	FORCE_INLINE [[nodiscard]] size_t GetAllocated() const noexcept { return m_allocated; }
+
+private:
+	/**************************
+	 * @brief Allocate from new chunk, or from dedicated block if size does not fit into chunk. Current chunk stays
+	 * current after dedicated block.
+	 *
+	 * @return Memory, nullptr if memory can not be mapped.
+	 */
+	[[nodiscard]] void* AllocateBlock(const size_t size, const size_t alignment) noexcept
+	{
+		const auto blockSize{ Align(HEADER_SIZE + size + alignment, PAGE_SIZE) };
+		const bool isChunk{ blockSize <= CHUNK_SIZE };
+		void* const memory{ isChunk ? Slabs::Get().AllocateChunk() : Slabs::Get().Map(blockSize, false) };
+		if (memory == nullptr) [[unlikely]] {
 			return nullptr;
 		}
-		else {
-
-#define TMP_MSAPI_CONTINUOUS_ALLOCATOR_REALLOCATE_BUFFER(bytesAdditionally)                                            \
-	TMP_MSAPI_CONTINUOUS_ALLOCATOR_BLOCK_OR_WAIT;                                                                      \
-	const auto oldSize{ m_bufferSize };                                                                                \
-	m_bufferSize += bytesAdditionally;                                                                                 \
-	m_buffer = realloc(m_buffer, m_bufferSize);                                                                        \
-	if (m_buffer == nullptr) [[unlikely]] {                                                                            \
-		LOG_ERROR("Cannot reallocate memory of size: " + _S(m_bufferSize) + " bytes for continuous allocator");        \
-		throw std::bad_alloc{};                                                                                        \
-	}                                                                                                                  \
-                                                                                                                       \
-	if (static_cast<std::uintptr_t>(m_buffer) % pageSize != 0) {                                                       \
-		auto* oldBuffer{ m_buffer };                                                                                   \
-		m_buffer = aligned_alloc(pageSize, m_bufferSize);                                                              \
-		memcpy(m_buffer, oldBuffer, oldSize);                                                                          \
-		free(oldBuffer);                                                                                               \
-                                                                                                                       \
-		for (auto& freeNode : m_freeNodes) {                                                                           \
-			freeNode.UpdateBegin(m_buffer);                                                                            \
-		}                                                                                                              \
-	}                                                                                                                  \
-                                                                                                                       \
-	m_freeNodes.emplace_back(m_blockSize, 0, &static_cast<int8_t*>(m_buffer)[oldSize]);                                \
-	return &static_cast<int8_t*>(m_buffer)[oldSize];
-
-			TMP_MSAPI_CONTINUOUS_ALLOCATOR_REALLOCATE_BUFFER(pageSize);
+
+		m_blocks = new (memory) Block{ m_blocks, isChunk ? CHUNK_SIZE : blockSize };
+		auto* const begin{ static_cast<char*>(memory) + HEADER_SIZE };
+		auto* const aligned{ reinterpret_cast<char*>(Align(reinterpret_cast<uintptr_t>(begin), alignment)) };
+		m_allocated += size;
+		if (isChunk) {
+			m_cursor = aligned + size;
+			m_end = static_cast<char*>(memory) + CHUNK_SIZE;
 		}
+		return aligned;
 	}
 
-	FORCE_INLINE void* AllocatePages(const int_fast64_t number)
+	/**************************
+	 * @brief Return all blocks except kept one.
+	 */
+	FORCE_INLINE void Release(const Block* const kept) noexcept
 	{
-		TMP_MSAPI_CONTINUOUS_ALLOCATOR_REALLOCATE_BUFFER(number * pageSize);
+		auto& slabs{ Slabs::Get() };
+		for (Block* block{ m_blocks }; block != nullptr;) {
+			Block* const next{ block->next };
+			if (block != kept) {
+				if (block->size == CHUNK_SIZE) {
+					slabs.DeallocateChunk(block);
+				}
+				else {
+					slabs.Unmap(block, block->size, false);
+				}
+			}
+			block = next;
+		}
 	}
+};
+
+}; //* namespace Allocator
+
+/**************************
+ * @brief Standard allocator which takes objects up to Allocator::MAX_POOLED_SIZE bytes from pools with thread local
+ * caches, greater or overaligned allocations are passed to operator new. Allocators are stateless and equal, memory
+ * can be deallocated on any thread.
+ *
+ * @tparam T Type of allocated objects.
+ *
+ * @test Has unit test.
+ */
+template <typename T> class ContinuousAllocator {
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using propagate_on_container_move_assignment = std::true_type;
+	using is_always_equal = std::true_type;
+
+	/**************************
+	 * @brief Construct a new Continuous Allocator object, empty constructor.
+	 */
+	constexpr ContinuousAllocator() noexcept = default;
+
+	/**************************
+	 * @brief Construct a new Continuous Allocator object, rebind constructor.
+	 */
+	template <typename U> constexpr ContinuousAllocator(const ContinuousAllocator<U>&) noexcept { }
+
+	/**************************
+	 * @param size Number of objects.
+	 *
+	 * @return Memory for objects.
+	 */
+	FORCE_INLINE [[nodiscard]] T* allocate(const size_t size)
+	{
+		if (size > std::numeric_limits<size_t>::max() / sizeof(T)) [[unlikely]] {
+			throw std::bad_array_new_length{};
+		}
 
-#undef TMP_MSAPI_CONTINUOUS_ALLOCATOR_BLOCK_OR_WAIT
-#undef TMP_MSAPI_CONTINUOUS_ALLOCATOR_REALLOCATE_BUFFER
+		if constexpr (alignof(T) <= Allocator::CLASS_STEP) {
+			if (size * sizeof(T) <= Allocator::MAX_POOLED_SIZE) [[likely]] {
+				if (void* memory{ Allocator::Pool::Allocate(size * sizeof(T)) }; memory != nullptr) [[likely]] {
+					return static_cast<T*>(memory);
+				}
+				throw std::bad_alloc{};
+			}
+		}
+
+		return static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t{ alignof(T) }));
+	}
+
+	/**************************
+	 * @param memory Memory returned by allocate().
+	 * @param size Number of objects given to allocate().
+	 */
+	FORCE_INLINE void deallocate(T* const memory, const size_t size) noexcept
+	{
+		if constexpr (alignof(T) <= Allocator::CLASS_STEP) {
+			if (size * sizeof(T) <= Allocator::MAX_POOLED_SIZE) [[likely]] {
+				Allocator::Pool::Deallocate(memory, size * sizeof(T));
+				return;
+			}
+		}
+
+		::operator delete(memory, size * sizeof(T), std::align_val_t{ alignof(T) });
+	}
 };
 
-template <typename T, typename U> bool operator==(const ContinuousAllocator<T>&, const ContinuousAllocator<U>&)
+template <typename T, typename U>
+FORCE_INLINE [[nodiscard]] constexpr bool operator==(
+	const ContinuousAllocator<T>&, const ContinuousAllocator<U>&) noexcept
 {
 	return true;
 }
 
-template <typename T, typename U> bool operator!=(const ContinuousAllocator<T>&, const ContinuousAllocator<U>&)
-{
-	return false;
-}
+/**************************
+ * @brief Standard allocator over arena, deallocation does nothing and memory is freed by the arena. Allocators are
+ * equal if they use the same arena.
+ *
+ * @tparam T Type of allocated objects.
+ *
+ * @test Has unit test.
+ */
+template <typename T> class ArenaAllocator {
+	template <typename U> friend class ArenaAllocator;
+
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using propagate_on_container_copy_assignment = std::true_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+
+private:
+	Allocator::Arena* m_arena;
+
+public:
+	/**************************
+	 * @brief Construct a new Arena Allocator object.
+	 *
+	 * @param arena Arena which outlives all allocations.
+	 */
+	constexpr ArenaAllocator(Allocator::Arena& arena) noexcept
+		: m_arena{ &arena }
+	{
+	}
+
+	/**************************
+	 * @brief Construct a new Arena Allocator object, rebind constructor.
+	 */
+	template <typename U>
+	constexpr ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+		: m_arena{ other.m_arena }
+	{
+	}
+
+	/**************************
+	 * @param size Number of objects.
+	 *
+	 * @return Memory for objects.
+	 */
+	FORCE_INLINE [[nodiscard]] T* allocate(const size_t size)
+	{
+		if (size > std::numeric_limits<size_t>::max() / sizeof(T)) [[unlikely]] {
+			throw std::bad_array_new_length{};
+		}
+
+		if (void* memory{ m_arena->Allocate(size * sizeof(T), alignof(T)) }; memory != nullptr) [[likely]] {
+			return static_cast<T*>(memory);
+		}
+		throw std::bad_alloc{};
+	}
+
+	/**************************
+	 * @brief Do nothing, memory is freed by arena.
+	 */
+	FORCE_INLINE void deallocate(T*, size_t) noexcept { }
+
+	/**************************
+	 * @return Arena of allocator.
+	 */
+	FORCE_INLINE [[nodiscard]] Allocator::Arena& GetArena() const noexcept { return *m_arena; }
+
+	template <typename U>
+	FORCE_INLINE [[nodiscard]] constexpr bool operator==(const ArenaAllocator<U>& other) const noexcept
+	{
+		return m_arena == other.m_arena;
+	}
+};
 
 }; //* namespace MSAPI
 
-#endif //* MSAPI_CONTINUOUS_ALLOCATOR
\ No newline at end of file
+#endif //* MSAPI_CONTINUOUS_ALLOCATOR
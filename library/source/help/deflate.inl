@@ -0,0 +1,811 @@
+/**************************
+ * @file        deflate.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ *
+ * @brief Raw DEFLATE (RFC 1951) stream compressor and inflater, framed by sync flush as required by permessage-deflate
+ * (RFC 7692).
+ */
+
+#ifndef MSAPI_DEFLATE_INL
+#define MSAPI_DEFLATE_INL
+
+#include "log.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace MSAPI {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**
+ * @brief Raw DEFLATE compressor. LZ77 over hash chains, matches and literals are coded by fixed Huffman codes. Each
+ * message is terminated by sync flush without trailing 0x00 0x00 0xFF 0xFF. With context takeover the history of
+ * previous messages is used for back references.
+ */
+class Deflater {
+public:
+	static constexpr inline int8_t MIN_WINDOW_BITS{ 8 };
+	static constexpr inline int8_t MAX_WINDOW_BITS{ 15 };
+
+private:
+	static constexpr inline size_t MIN_MATCH{ 3 };
+	static constexpr inline size_t MAX_MATCH{ 258 };
+	//* Search is stopped on the first match of this size
+	static constexpr inline size_t NICE_MATCH{ 128 };
+	static constexpr inline size_t MAX_CHAIN{ 64 };
+
+	const size_t m_windowSize;
+	const bool m_contextTakeover;
+	const uint32_t m_hashMask;
+	// History of previous messages followed by current message
+	std::vector<uint8_t> m_history;
+	// Last position of each hash in history, -1 if none
+	std::vector<int32_t> m_head;
+	// Previous position with the same hash for each position in history
+	std::vector<int32_t> m_prev;
+	uint64_t m_bits{};
+	uint8_t m_bitsCount{};
+
+public:
+	/**
+	 * @brief Construct a new Deflater object. Memory usage is about 4 * 2^windowBits bytes of hash heads and up to
+	 * 10 * 2^windowBits bytes of history and chains.
+	 *
+	 * @param windowBits Base-2 logarithm of maximum back reference distance, clamped to [8, 15].
+	 * @param contextTakeover True if history of previous messages can be referenced.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE explicit Deflater(int8_t windowBits = MAX_WINDOW_BITS, bool contextTakeover = true);
+
+	/**
+	 * @brief Compress one message and append result to output.
+	 *
+	 * @param input Message to be compressed.
+	 * @param output Destination of compressed data.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void Compress(std::span<const uint8_t> input, std::vector<uint8_t>& output);
+
+	/**
+	 * @brief Forget history of previous messages.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void Reset() noexcept;
+
+	/**
+	 * @return Maximum back reference distance.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] size_t GetWindowSize() const noexcept;
+
+private:
+	/**
+	 * @brief Write bits in LSB-first order, full bytes are flushed to output.
+	 *
+	 * @param value Bits to be written.
+	 * @param count Number of bits, up to 32.
+	 * @param output Destination of compressed data.
+	 */
+	FORCE_INLINE void PutBits(uint32_t value, uint8_t count, std::vector<uint8_t>& output);
+
+	/**
+	 * @brief Write fixed Huffman code of literal/length symbol.
+	 *
+	 * @param symbol Literal/length symbol in [0, 287].
+	 * @param output Destination of compressed data.
+	 */
+	FORCE_INLINE void PutSymbol(uint16_t symbol, std::vector<uint8_t>& output);
+
+	/**
+	 * @brief Write back reference.
+	 *
+	 * @param length Match length in [3, 258].
+	 * @param distance Match distance in [1, 32768].
+	 * @param output Destination of compressed data.
+	 */
+	FORCE_INLINE void PutMatch(size_t length, size_t distance, std::vector<uint8_t>& output);
+
+	/**
+	 * @param position Position in history, at least 3 bytes must be available.
+	 *
+	 * @return Hash of 3 bytes at position.
+	 */
+	FORCE_INLINE [[nodiscard]] uint32_t Hash(size_t position) const noexcept;
+
+	/**
+	 * @brief Drop the oldest history to keep only one window and rebase positions.
+	 */
+	FORCE_INLINE void Slide();
+};
+
+/**
+ * @brief Raw DEFLATE inflater for stored, fixed and dynamic Huffman blocks. Each message is expected to be terminated
+ * by sync flush without trailing 0x00 0x00 0xFF 0xFF, which are appended internally. With context takeover the output
+ * of previous messages is kept for back references.
+ */
+class Inflater {
+private:
+	/**
+	 * @brief Canonical Huffman code, decoded bit by bit.
+	 */
+	struct Huffman {
+		std::array<uint16_t, 16> counts{};
+		std::array<uint16_t, 288> symbols{};
+	};
+
+	/**
+	 * @brief State of reading one message.
+	 */
+	struct Reader {
+		const std::span<const uint8_t> input;
+		size_t position{};
+		uint32_t bits{};
+		uint8_t bitsCount{};
+	};
+
+	static constexpr inline std::array<uint8_t, 4> SYNC_FLUSH_TAIL{ 0x00, 0x00, 0xFF, 0xFF };
+
+	const size_t m_windowSize;
+	const bool m_contextTakeover;
+	// Output of previous messages followed by current message
+	std::vector<uint8_t> m_window;
+
+public:
+	/**
+	 * @brief Construct a new Inflater object.
+	 *
+	 * @param windowBits Base-2 logarithm of maximum back reference distance used by peer, clamped to [8, 15].
+	 * @param contextTakeover True if peer references history of previous messages.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE explicit Inflater(int8_t windowBits = Deflater::MAX_WINDOW_BITS, bool contextTakeover = true);
+
+	/**
+	 * @brief Inflate one message and append result to output.
+	 *
+	 * @param input Compressed message.
+	 * @param output Destination of inflated data.
+	 * @param limit Maximum size of inflated message.
+	 *
+	 * @return True if message is inflated, false if data is corrupted or exceeds limit, state is undefined then.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] bool Inflate(std::span<const uint8_t> input, std::vector<uint8_t>& output, size_t limit);
+
+	/**
+	 * @brief Forget output of previous messages.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void Reset() noexcept;
+
+private:
+	/**
+	 * @return Next byte of input followed by sync flush tail, nullopt at the end.
+	 */
+	FORCE_INLINE [[nodiscard]] static std::optional<uint8_t> NextByte(Reader& reader) noexcept;
+
+	/**
+	 * @param count Number of bits, up to 16.
+	 *
+	 * @return Bits in LSB-first order, nullopt at the end of input.
+	 */
+	FORCE_INLINE [[nodiscard]] static std::optional<uint32_t> GetBits(Reader& reader, uint8_t count) noexcept;
+
+	/**
+	 * @brief Build canonical Huffman code from code lengths.
+	 *
+	 * @return True if code is not over-subscribed.
+	 */
+	FORCE_INLINE [[nodiscard]] static bool Build(Huffman& huffman, std::span<const uint8_t> lengths) noexcept;
+
+	/**
+	 * @return Decoded symbol, -1 if code is invalid or input is over.
+	 */
+	FORCE_INLINE [[nodiscard]] static int32_t Decode(Reader& reader, const Huffman& huffman) noexcept;
+
+	/**
+	 * @brief Inflate stored block.
+	 *
+	 * @return True if block is inflated.
+	 */
+	FORCE_INLINE [[nodiscard]] bool Stored(Reader& reader, size_t limit);
+
+	/**
+	 * @brief Inflate Huffman coded block.
+	 *
+	 * @return True if block is inflated.
+	 */
+	FORCE_INLINE [[nodiscard]] bool Codes(
+		Reader& reader, const Huffman& literals, const Huffman& distances, size_t limit);
+
+	/**
+	 * @brief Read dynamic code lengths and inflate the block.
+	 *
+	 * @return True if block is inflated.
+	 */
+	FORCE_INLINE [[nodiscard]] bool Dynamic(Reader& reader, size_t limit);
+};
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+namespace DeflateTables {
+
+static constexpr inline std::array<uint16_t, 29> LENGTH_BASE{ 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static constexpr inline std::array<uint8_t, 29> LENGTH_EXTRA{ 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3,
+	3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static constexpr inline std::array<uint16_t, 30> DISTANCE_BASE{ 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+	193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static constexpr inline std::array<uint8_t, 30> DISTANCE_EXTRA{ 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7,
+	8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+static constexpr inline std::array<uint8_t, 19> CODE_LENGTHS_ORDER{ 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13,
+	2, 14, 1, 15 };
+
+/**
+ * @return Code reversed for LSB-first output.
+ */
+FORCE_INLINE [[nodiscard]] constexpr uint16_t Reverse(uint16_t code, const uint8_t length) noexcept
+{
+	uint16_t result{};
+	for (uint8_t index{}; index < length; ++index) {
+		result = static_cast<uint16_t>((result << 1) | (code & 1));
+		code >>= 1;
+	}
+	return result;
+}
+
+//* Fixed literal/length codes (RFC 1951, 3.2.6), code in low 16 bits and length in high 16 bits
+static constexpr inline auto FIXED_LITERAL_CODES{ [] {
+	std::array<uint32_t, 288> codes{};
+	for (uint16_t symbol{}; symbol < 288; ++symbol) {
+		uint16_t code;
+		uint8_t length;
+		if (symbol < 144) {
+			code = static_cast<uint16_t>(0x30 + symbol);
+			length = 8;
+		}
+		else if (symbol < 256) {
+			code = static_cast<uint16_t>(0x190 + symbol - 144);
+			length = 9;
+		}
+		else if (symbol < 280) {
+			code = static_cast<uint16_t>(symbol - 256);
+			length = 7;
+		}
+		else {
+			code = static_cast<uint16_t>(0xC0 + symbol - 280);
+			length = 8;
+		}
+		codes[symbol] = Reverse(code, length) | (static_cast<uint32_t>(length) << 16);
+	}
+	return codes;
+}() };
+
+} // namespace DeflateTables
+
+FORCE_INLINE Deflater::Deflater(const int8_t windowBits, const bool contextTakeover)
+	: m_windowSize{ size_t{ 1 } << std::clamp(windowBits, MIN_WINDOW_BITS, MAX_WINDOW_BITS) }
+	, m_contextTakeover{ contextTakeover }
+	, m_hashMask{ static_cast<uint32_t>(m_windowSize - 1) }
+	, m_head(m_windowSize, -1)
+{
+}
+
+FORCE_INLINE void Deflater::Compress(const std::span<const uint8_t> input, std::vector<uint8_t>& output)
+{
+	if (!input.empty()) {
+		const size_t begin{ m_history.size() };
+		m_history.insert(m_history.end(), input.begin(), input.end());
+		m_prev.resize(m_history.size(), -1);
+		const size_t end{ m_history.size() };
+
+		// Not final block with fixed Huffman codes
+		PutBits(0b010, 3, output);
+
+		size_t position{ begin };
+		while (position < end) {
+			size_t bestLength{};
+			size_t bestDistance{};
+			if (end - position >= MIN_MATCH) {
+				const auto hash{ Hash(position) };
+				const size_t maxLength{ std::min(MAX_MATCH, end - position) };
+				auto candidate{ m_head[hash] };
+				for (size_t chain{}; candidate >= 0 && chain < MAX_CHAIN; ++chain) {
+					const auto candidatePosition{ static_cast<size_t>(candidate) };
+					const auto distance{ position - candidatePosition };
+					if (distance > m_windowSize) {
+						break;
+					}
+
+					// Cheap rejection by the byte which would extend the best match
+					if (m_history[candidatePosition + bestLength] == m_history[position + bestLength]) {
+						size_t length{};
+						while (length < maxLength
+							&& m_history[candidatePosition + length] == m_history[position + length]) {
+							++length;
+						}
+						if (length > bestLength) {
+							bestLength = length;
+							bestDistance = distance;
+							if (length >= maxLength || length >= NICE_MATCH) {
+								break;
+							}
+						}
+					}
+					candidate = m_prev[candidatePosition];
+				}
+
+				m_prev[position] = m_head[hash];
+				m_head[hash] = static_cast<int32_t>(position);
+			}
+
+			if (bestLength < MIN_MATCH) {
+				PutSymbol(m_history[position], output);
+				++position;
+				continue;
+			}
+
+			PutMatch(bestLength, bestDistance, output);
+			const size_t matchEnd{ position + bestLength };
+			for (++position; position < matchEnd; ++position) {
+				if (end - position >= MIN_MATCH) {
+					const auto hash{ Hash(position) };
+					m_prev[position] = m_head[hash];
+					m_head[hash] = static_cast<int32_t>(position);
+				}
+			}
+		}
+
+		// End of block
+		PutSymbol(256, output);
+	}
+
+	// Sync flush is an empty stored block, its LEN and NLEN are not sent
+	PutBits(0, 3, output);
+	if (m_bitsCount != 0) {
+		output.emplace_back(static_cast<uint8_t>(m_bits));
+	}
+	m_bits = 0;
+	m_bitsCount = 0;
+
+	if (!m_contextTakeover) {
+		Reset();
+		return;
+	}
+
+	if (m_history.size() >= 2 * m_windowSize) {
+		Slide();
+	}
+}
+
+FORCE_INLINE void Deflater::Reset() noexcept
+{
+	m_history.clear();
+	m_prev.clear();
+	std::fill(m_head.begin(), m_head.end(), -1);
+}
+
+FORCE_INLINE [[nodiscard]] size_t Deflater::GetWindowSize() const noexcept { return m_windowSize; }
+
+FORCE_INLINE void Deflater::PutBits(const uint32_t value, const uint8_t count, std::vector<uint8_t>& output)
+{
+	m_bits |= static_cast<uint64_t>(value) << m_bitsCount;
+	m_bitsCount = static_cast<uint8_t>(m_bitsCount + count);
+	while (m_bitsCount >= 8) {
+		output.emplace_back(static_cast<uint8_t>(m_bits));
+		m_bits >>= 8;
+		m_bitsCount = static_cast<uint8_t>(m_bitsCount - 8);
+	}
+}
+
+FORCE_INLINE void Deflater::PutSymbol(const uint16_t symbol, std::vector<uint8_t>& output)
+{
+	const auto code{ DeflateTables::FIXED_LITERAL_CODES[symbol] };
+	PutBits(code & 0xFFFF, static_cast<uint8_t>(code >> 16), output);
+}
+
+FORCE_INLINE void Deflater::PutMatch(const size_t length, const size_t distance, std::vector<uint8_t>& output)
+{
+	size_t lengthIndex;
+	if (length == MAX_MATCH) {
+		lengthIndex = 28;
+	}
+	else if (const auto value{ length - 3 }; value < 8) {
+		lengthIndex = value;
+	}
+	else {
+		const auto bit{ static_cast<size_t>(std::bit_width(value) - 1) };
+		lengthIndex = 4 * (bit - 1) + ((value >> (bit - 2)) & 3);
+	}
+	PutSymbol(static_cast<uint16_t>(257 + lengthIndex), output);
+	if (const auto extra{ DeflateTables::LENGTH_EXTRA[lengthIndex] }; extra != 0) {
+		PutBits(static_cast<uint32_t>(length - DeflateTables::LENGTH_BASE[lengthIndex]), extra, output);
+	}
+
+	size_t distanceIndex;
+	if (const auto value{ distance - 1 }; value < 4) {
+		distanceIndex = value;
+	}
+	else {
+		const auto bit{ static_cast<size_t>(std::bit_width(value) - 1) };
+		distanceIndex = 2 * bit + ((value >> (bit - 1)) & 1);
+	}
+	// Fixed distance codes are 5 bits of index
+	PutBits(DeflateTables::Reverse(static_cast<uint16_t>(distanceIndex), 5), 5, output);
+	if (const auto extra{ DeflateTables::DISTANCE_EXTRA[distanceIndex] }; extra != 0) {
+		PutBits(static_cast<uint32_t>(distance - DeflateTables::DISTANCE_BASE[distanceIndex]), extra, output);
+	}
+}
+
+FORCE_INLINE [[nodiscard]] uint32_t Deflater::Hash(const size_t position) const noexcept
+{
+	const uint32_t value{ static_cast<uint32_t>(m_history[position])
+		| static_cast<uint32_t>(m_history[position + 1]) << 8 | static_cast<uint32_t>(m_history[position + 2]) << 16 };
+	return (value * 2654435761U >> 16) & m_hashMask;
+}
+
+FORCE_INLINE void Deflater::Slide()
+{
+	const auto cut{ m_history.size() - m_windowSize };
+	m_history.erase(m_history.begin(), m_history.begin() + static_cast<std::ptrdiff_t>(cut));
+	m_prev.erase(m_prev.begin(), m_prev.begin() + static_cast<std::ptrdiff_t>(cut));
+
+	const auto rebase{ [cut = static_cast<int32_t>(cut)](int32_t& position) {
+		position = position >= cut ? position - cut : -1;
+	} };
+	std::for_each(m_head.begin(), m_head.end(), rebase);
+	std::for_each(m_prev.begin(), m_prev.end(), rebase);
+}
+
+FORCE_INLINE Inflater::Inflater(const int8_t windowBits, const bool contextTakeover)
+	: m_windowSize{ size_t{ 1 } << std::clamp(windowBits, Deflater::MIN_WINDOW_BITS, Deflater::MAX_WINDOW_BITS) }
+	, m_contextTakeover{ contextTakeover }
+{
+}
+
+FORCE_INLINE [[nodiscard]] bool Inflater::Inflate(
+	const std::span<const uint8_t> input, std::vector<uint8_t>& output, size_t limit)
+{
+	const size_t begin{ m_window.size() };
+	// Limit is checked against the whole window to avoid subtraction on each write
+	limit += begin;
+
+	Reader reader{ input };
+	while (true) {
+		const auto header{ GetBits(reader, 3) };
+		if (!header.has_value()) {
+			return false;
+		}
+
+		bool result;
+		switch (*header >> 1) {
+		case 0:
+			result = Stored(reader, limit);
+			break;
+		case 1: {
+			static const auto fixed{ [] {
+				std::pair<Huffman, Huffman> codes;
+				std::array<uint8_t, 288> lengths{};
+				std::fill(lengths.begin(), lengths.begin() + 144, 8);
+				std::fill(lengths.begin() + 144, lengths.begin() + 256, 9);
+				std::fill(lengths.begin() + 256, lengths.begin() + 280, 7);
+				std::fill(lengths.begin() + 280, lengths.end(), 8);
+				(void)Build(codes.first, lengths);
+				std::fill(lengths.begin(), lengths.begin() + 30, 5);
+				(void)Build(codes.second, std::span<const uint8_t>{ lengths.data(), 30 });
+				return codes;
+			}() };
+			result = Codes(reader, fixed.first, fixed.second, limit);
+			break;
+		}
+		case 2:
+			result = Dynamic(reader, limit);
+			break;
+		default:
+			return false;
+		}
+
+		if (!result) {
+			return false;
+		}
+
+		// Final block or sync flush tail is consumed
+		if ((*header & 1) != 0 || reader.position == reader.input.size() + SYNC_FLUSH_TAIL.size()) {
+			break;
+		}
+	}
+
+	output.insert(output.end(), m_window.begin() + static_cast<std::ptrdiff_t>(begin), m_window.end());
+
+	if (!m_contextTakeover) {
+		Reset();
+	}
+	else if (m_window.size() > m_windowSize) {
+		m_window.erase(m_window.begin(), m_window.end() - static_cast<std::ptrdiff_t>(m_windowSize));
+	}
+
+	return true;
+}
+
+FORCE_INLINE void Inflater::Reset() noexcept { m_window.clear(); }
+
+FORCE_INLINE [[nodiscard]] std::optional<uint8_t> Inflater::NextByte(Reader& reader) noexcept
+{
+	const auto inputSize{ reader.input.size() };
+	if (reader.position < inputSize) {
+		return reader.input[reader.position++];
+	}
+
+	if (reader.position < inputSize + SYNC_FLUSH_TAIL.size()) {
+		return SYNC_FLUSH_TAIL[reader.position++ - inputSize];
+	}
+
+	return std::nullopt;
+}
+
+FORCE_INLINE [[nodiscard]] std::optional<uint32_t> Inflater::GetBits(Reader& reader, const uint8_t count) noexcept
+{
+	while (reader.bitsCount < count) {
+		const auto byte{ NextByte(reader) };
+		if (!byte.has_value()) {
+			return std::nullopt;
+		}
+		reader.bits |= static_cast<uint32_t>(*byte) << reader.bitsCount;
+		reader.bitsCount = static_cast<uint8_t>(reader.bitsCount + 8);
+	}
+
+	const uint32_t value{ reader.bits & ((uint32_t{ 1 } << count) - 1) };
+	reader.bits >>= count;
+	reader.bitsCount = static_cast<uint8_t>(reader.bitsCount - count);
+	return value;
+}
+
+FORCE_INLINE [[nodiscard]] bool Inflater::Build(Huffman& huffman, const std::span<const uint8_t> lengths) noexcept
+{
+	huffman.counts.fill(0);
+	for (const auto length : lengths) {
+		++huffman.counts[length];
+	}
+
+	int32_t left{ 1 };
+	for (size_t length{ 1 }; length < huffman.counts.size(); ++length) {
+		left <<= 1;
+		left -= huffman.counts[length];
+		if (left < 0) {
+			return false;
+		}
+	}
+
+	std::array<uint16_t, 16> offsets{};
+	for (size_t length{ 1 }; length < offsets.size() - 1; ++length) {
+		offsets[length + 1] = static_cast<uint16_t>(offsets[length] + huffman.counts[length]);
+	}
+
+	for (size_t symbol{}; symbol < lengths.size(); ++symbol) {
+		if (lengths[symbol] != 0) {
+			huffman.symbols[offsets[lengths[symbol]]++] = static_cast<uint16_t>(symbol);
+		}
+	}
+
+	return true;
+}
+
+FORCE_INLINE [[nodiscard]] int32_t Inflater::Decode(Reader& reader, const Huffman& huffman) noexcept
+{
+	int32_t code{};
+	int32_t first{};
+	int32_t index{};
+	for (size_t length{ 1 }; length < huffman.counts.size(); ++length) {
+		const auto bit{ GetBits(reader, 1) };
+		if (!bit.has_value()) {
+			return -1;
+		}
+		code |= static_cast<int32_t>(*bit);
+		const int32_t count{ huffman.counts[length] };
+		if (code - count < first) {
+			return huffman.symbols[static_cast<size_t>(index + code - first)];
+		}
+		index += count;
+		first += count;
+		first <<= 1;
+		code <<= 1;
+	}
+
+	return -1;
+}
+
+FORCE_INLINE [[nodiscard]] bool Inflater::Stored(Reader& reader, const size_t limit)
+{
+	// Stored block starts from byte boundary
+	reader.bits = 0;
+	reader.bitsCount = 0;
+
+	const auto length{ GetBits(reader, 16) };
+	const auto lengthComplement{ GetBits(reader, 16) };
+	if (!length.has_value() || !lengthComplement.has_value() || *length != (~*lengthComplement & 0xFFFF)
+		|| m_window.size() + *length > limit) {
+		return false;
+	}
+
+	for (uint32_t index{}; index < *length; ++index) {
+		const auto byte{ NextByte(reader) };
+		if (!byte.has_value()) {
+			return false;
+		}
+		m_window.emplace_back(*byte);
+	}
+
+	return true;
+}
+
+FORCE_INLINE [[nodiscard]] bool Inflater::Codes(
+	Reader& reader, const Huffman& literals, const Huffman& distances, const size_t limit)
+{
+	while (true) {
+		const auto symbol{ Decode(reader, literals) };
+		if (symbol < 0) {
+			return false;
+		}
+
+		if (symbol < 256) {
+			if (m_window.size() >= limit) {
+				return false;
+			}
+			m_window.emplace_back(static_cast<uint8_t>(symbol));
+			continue;
+		}
+
+		if (symbol == 256) {
+			return true;
+		}
+
+		const auto lengthIndex{ static_cast<size_t>(symbol - 257) };
+		if (lengthIndex >= DeflateTables::LENGTH_BASE.size()) {
+			return false;
+		}
+		const auto lengthExtra{ GetBits(reader, DeflateTables::LENGTH_EXTRA[lengthIndex]) };
+		if (!lengthExtra.has_value()) {
+			return false;
+		}
+		const size_t length{ DeflateTables::LENGTH_BASE[lengthIndex] + *lengthExtra };
+
+		const auto distanceSymbol{ Decode(reader, distances) };
+		if (distanceSymbol < 0 || static_cast<size_t>(distanceSymbol) >= DeflateTables::DISTANCE_BASE.size()) {
+			return false;
+		}
+		const auto distanceIndex{ static_cast<size_t>(distanceSymbol) };
+		const auto distanceExtra{ GetBits(reader, DeflateTables::DISTANCE_EXTRA[distanceIndex]) };
+		if (!distanceExtra.has_value()) {
+			return false;
+		}
+		const size_t distance{ DeflateTables::DISTANCE_BASE[distanceIndex] + *distanceExtra };
+
+		const auto size{ m_window.size() };
+		if (distance > size || distance > m_windowSize || size + length > limit) {
+			return false;
+		}
+
+		// Source and destination can overlap, so copy is done byte by byte
+		m_window.resize(size + length);
+		auto* const destination{ m_window.data() + size };
+		const auto* const source{ destination - distance };
+		for (size_t index{}; index < length; ++index) {
+			destination[index] = source[index];
+		}
+	}
+}
+
+FORCE_INLINE [[nodiscard]] bool Inflater::Dynamic(Reader& reader, const size_t limit)
+{
+	const auto literalsNumber{ GetBits(reader, 5) };
+	const auto distancesNumber{ GetBits(reader, 5) };
+	const auto codeLengthsNumber{ GetBits(reader, 4) };
+	if (!literalsNumber.has_value() || !distancesNumber.has_value() || !codeLengthsNumber.has_value()) {
+		return false;
+	}
+	const size_t literals{ *literalsNumber + 257 };
+	const size_t distances{ *distancesNumber + 1 };
+	if (literals > 286 || distances > 30) {
+		return false;
+	}
+
+	std::array<uint8_t, 19> codeLengths{};
+	for (size_t index{}; index < *codeLengthsNumber + 4; ++index) {
+		const auto length{ GetBits(reader, 3) };
+		if (!length.has_value()) {
+			return false;
+		}
+		codeLengths[DeflateTables::CODE_LENGTHS_ORDER[index]] = static_cast<uint8_t>(*length);
+	}
+
+	Huffman codeLengthsCode;
+	if (!Build(codeLengthsCode, codeLengths)) {
+		return false;
+	}
+
+	std::array<uint8_t, 286 + 30> lengths{};
+	size_t index{};
+	while (index < literals + distances) {
+		const auto symbol{ Decode(reader, codeLengthsCode) };
+		if (symbol < 0) {
+			return false;
+		}
+
+		if (symbol < 16) {
+			lengths[index++] = static_cast<uint8_t>(symbol);
+			continue;
+		}
+
+		uint8_t length{};
+		std::optional<uint32_t> repeat;
+		if (symbol == 16) {
+			if (index == 0) {
+				return false;
+			}
+			length = lengths[index - 1];
+			repeat = GetBits(reader, 2);
+			repeat = repeat.has_value() ? std::optional<uint32_t>{ *repeat + 3 } : std::nullopt;
+		}
+		else if (symbol == 17) {
+			repeat = GetBits(reader, 3);
+			repeat = repeat.has_value() ? std::optional<uint32_t>{ *repeat + 3 } : std::nullopt;
+		}
+		else {
+			repeat = GetBits(reader, 7);
+			repeat = repeat.has_value() ? std::optional<uint32_t>{ *repeat + 11 } : std::nullopt;
+		}
+
+		if (!repeat.has_value() || index + *repeat > literals + distances) {
+			return false;
+		}
+		std::fill_n(lengths.begin() + static_cast<std::ptrdiff_t>(index), *repeat, length);
+		index += *repeat;
+	}
+
+	// End of block code is mandatory
+	if (lengths[256] == 0) {
+		return false;
+	}
+
+	Huffman literalsCode;
+	Huffman distancesCode;
+	if (!Build(literalsCode, std::span<const uint8_t>{ lengths.data(), literals })
+		|| !Build(distancesCode, std::span<const uint8_t>{ lengths.data() + literals, distances })) {
+		return false;
+	}
+
+	return Codes(reader, literalsCode, distancesCode, limit);
+}
+
+} // namespace MSAPI
+
+#endif // MSAPI_DEFLATE_INL
@@ -0,0 +1,456 @@
+/**************************
+ * @file        lockProfiling.hpp
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ *
+ * @brief Contention profiling of MSAPI locks, enabled by MSAPI_LOCK_PROFILING definition (CMake option with the same
+ * name). Each lock is a site identified by name, locks with the same name are aggregated. Acquisitions, contended
+ * acquisitions, wait time and hold time histograms are recorded into counters of the current thread without atomic
+ * read-modify-write operations and are summed by registry on demand. Hold time is recorded for exclusive acquisitions
+ * only, as shared lock can be released by another thread. Without the definition profiling macros are empty and locks
+ * have no additional members.
+ */
+
+#ifndef MSAPI_LOCK_PROFILING_H
+#define MSAPI_LOCK_PROFILING_H
+
+#ifdef MSAPI_LOCK_PROFILING
+
+#include "table.h"
+#include "time.h"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <format>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace MSAPI {
+
+namespace Pthread {
+
+namespace Profiling {
+
+/**************************
+ * @brief Histogram of durations in nanoseconds, bucket i contains durations in range [2^(i-1), 2^i), last bucket
+ * contains all greater durations.
+ */
+static constexpr size_t HISTOGRAM_SIZE{ 32 };
+
+/**************************
+ * @brief Maximum number of different lock names, all following names are aggregated into the last site.
+ */
+static constexpr uint32_t SITES_LIMIT{ 128 };
+
+/**************************
+ * @brief Id of site which is not profiled.
+ */
+static constexpr uint32_t DISABLED_SITE{ UINT32_MAX };
+
+/**************************
+ * @brief Table of statistics: name, acquisitions, contended acquisitions, total wait ns, wait p50 ns, wait p99 ns,
+ * total hold ns, hold p50 ns, hold p99 ns. Percentiles are upper bounds of histogram buckets.
+ */
+using table_t = Table<std::string, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t>;
+
+/**************************
+ * @return Ticks of fast clock, differences are converted to nanoseconds.
+ */
+FORCE_INLINE [[nodiscard]] int64_t Now() noexcept { return FastClock::GetTicks(); }
+
+/**************************
+ * @return Index of histogram bucket for duration.
+ */
+FORCE_INLINE [[nodiscard]] size_t GetBucket(const int64_t nanoseconds) noexcept
+{
+	if (nanoseconds <= 0) {
+		return 0;
+	}
+
+	return std::min(static_cast<size_t>(std::bit_width(static_cast<uint64_t>(nanoseconds))), HISTOGRAM_SIZE - 1);
+}
+
+/**************************
+ * @brief Counters of one site in one thread, written by owning thread only.
+ */
+struct Counters {
+	std::atomic<uint64_t> acquisitions;
+	std::atomic<uint64_t> contended;
+	std::atomic<uint64_t> waitNs;
+	std::atomic<uint64_t> holdNs;
+	std::array<std::atomic<uint64_t>, HISTOGRAM_SIZE> wait;
+	std::array<std::atomic<uint64_t>, HISTOGRAM_SIZE> hold;
+};
+
+/**************************
+ * @brief Aggregated statistics of one site.
+ */
+struct Statistics {
+	std::string name;
+	uint64_t acquisitions{};
+	uint64_t contended{};
+	uint64_t waitNs{};
+	uint64_t holdNs{};
+	std::array<uint64_t, HISTOGRAM_SIZE> wait{};
+	std::array<uint64_t, HISTOGRAM_SIZE> hold{};
+
+	/**************************
+	 * @param histogram Wait or hold histogram.
+	 * @param percentile Percentile in range (0, 1].
+	 *
+	 * @return Upper bound of bucket where percentile is reached, 0 if histogram is empty.
+	 */
+	FORCE_INLINE [[nodiscard]] static uint64_t GetPercentile(
+		const std::array<uint64_t, HISTOGRAM_SIZE>& histogram, const double percentile) noexcept
+	{
+		uint64_t total{};
+		for (const auto count : histogram) {
+			total += count;
+		}
+		if (total == 0) {
+			return 0;
+		}
+
+		const auto threshold{ static_cast<uint64_t>(static_cast<double>(total) * percentile) };
+		uint64_t accumulated{};
+		for (size_t index{ 0 }; index < HISTOGRAM_SIZE; ++index) {
+			accumulated += histogram[index];
+			if (accumulated >= threshold && accumulated != 0) {
+				return uint64_t{ 1 } << index;
+			}
+		}
+		return uint64_t{ 1 } << (HISTOGRAM_SIZE - 1);
+	}
+};
+
+/**************************
+ * @brief Registry of sites and thread counters. Thread counters are taken on first recording, returned on thread exit
+ * and reused by next threads with accumulated values, so they are never released.
+ */
+class Registry {
+private:
+	/**************************
+	 * @brief Counters of all sites of one thread.
+	 */
+	struct Block {
+		std::array<Counters, SITES_LIMIT> counters{};
+		std::atomic<bool> isUsed{};
+		Block* next{};
+	};
+
+	/**************************
+	 * @brief Owner of block of current thread.
+	 */
+	struct ThreadBlock {
+		Block* block{};
+
+		/**************************
+		 * @brief Destroy the Thread Block object, return block to the registry.
+		 */
+		FORCE_INLINE ~ThreadBlock() noexcept
+		{
+			if (block != nullptr) {
+				block->isUsed.store(false, std::memory_order_release);
+			}
+		}
+	};
+
+	std::atomic<Block*> m_blocks{};
+	std::vector<std::string> m_names;
+	std::map<std::string, uint32_t, std::less<>> m_nameToId;
+	std::atomic_flag m_namesLock{};
+
+public:
+	/**************************
+	 * @return Process wide registry.
+	 */
+	FORCE_INLINE static Registry& Get()
+	{
+		static Registry registry;
+		return registry;
+	}
+
+	/**************************
+	 * @brief Register site name, same names share one id.
+	 *
+	 * @param name Name of site.
+	 *
+	 * @return Id of site.
+	 */
+	FORCE_INLINE [[nodiscard]] uint32_t Register(const std::string_view name)
+	{
+		LockNames();
+		uint32_t id;
+		if (const auto it{ m_nameToId.find(name) }; it != m_nameToId.end()) {
+			id = it->second;
+		}
+		else if (m_names.size() < SITES_LIMIT - 1) {
+			id = static_cast<uint32_t>(m_names.size());
+			m_names.emplace_back(name);
+			m_nameToId.emplace(name, id);
+		}
+		else {
+			id = SITES_LIMIT - 1;
+			if (m_names.size() < SITES_LIMIT) {
+				m_names.emplace_back("Other");
+			}
+		}
+		UnlockNames();
+		return id;
+	}
+
+	/**************************
+	 * @return Counters of site for current thread.
+	 */
+	FORCE_INLINE [[nodiscard]] Counters& GetCounters(const uint32_t id)
+	{
+		thread_local ThreadBlock threadBlock;
+		if (threadBlock.block == nullptr) [[unlikely]] {
+			threadBlock.block = AcquireBlock();
+		}
+		return threadBlock.block->counters[id];
+	}
+
+	/**************************
+	 * @return Statistics of all registered sites summed over threads.
+	 */
+	FORCE_INLINE [[nodiscard]] std::vector<Statistics> Collect()
+	{
+		std::vector<Statistics> statistics;
+		LockNames();
+		statistics.resize(m_names.size());
+		for (size_t index{ 0 }; index < m_names.size(); ++index) {
+			statistics[index].name = m_names[index];
+		}
+		UnlockNames();
+
+		for (const Block* block{ m_blocks.load(std::memory_order_acquire) }; block != nullptr; block = block->next) {
+			for (size_t index{ 0 }; index < statistics.size(); ++index) {
+				const auto& counters{ block->counters[index] };
+				auto& site{ statistics[index] };
+				site.acquisitions += counters.acquisitions.load(std::memory_order_relaxed);
+				site.contended += counters.contended.load(std::memory_order_relaxed);
+				site.waitNs += counters.waitNs.load(std::memory_order_relaxed);
+				site.holdNs += counters.holdNs.load(std::memory_order_relaxed);
+				for (size_t bucket{ 0 }; bucket < HISTOGRAM_SIZE; ++bucket) {
+					site.wait[bucket] += counters.wait[bucket].load(std::memory_order_relaxed);
+					site.hold[bucket] += counters.hold[bucket].load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		return statistics;
+	}
+
+	/**************************
+	 * @return Text with statistics and non-empty histogram buckets of all sites, one site per line.
+	 */
+	FORCE_INLINE [[nodiscard]] std::string Dump()
+	{
+		std::string out;
+		const auto appendHistogram{ [&out](const std::string_view name,
+										const std::array<uint64_t, HISTOGRAM_SIZE>& histogram) {
+			std::format_to(std::back_inserter(out), ", {}:", name);
+			for (size_t bucket{ 0 }; bucket < HISTOGRAM_SIZE; ++bucket) {
+				if (histogram[bucket] != 0) {
+					std::format_to(std::back_inserter(out), " <{}ns={}", uint64_t{ 1 } << bucket, histogram[bucket]);
+				}
+			}
+		} };
+
+		for (const auto& site : Collect()) {
+			std::format_to(std::back_inserter(out), "{}: acquisitions {}, contended {}, wait {} ns, hold {} ns",
+				site.name, site.acquisitions, site.contended, site.waitNs, site.holdNs);
+			appendHistogram("wait", site.wait);
+			appendHistogram("hold", site.hold);
+			out += '\n';
+		}
+		return out;
+	}
+
+	/**************************
+	 * @brief Clear table and fill it with statistics of all sites, table can be registered as application parameter.
+	 *
+	 * @param table Table of statistics.
+	 */
+	FORCE_INLINE void FillTable(table_t& table)
+	{
+		table.Clear();
+		for (auto& site : Collect()) {
+			const auto waitP50{ Statistics::GetPercentile(site.wait, 0.5) };
+			const auto waitP99{ Statistics::GetPercentile(site.wait, 0.99) };
+			const auto holdP50{ Statistics::GetPercentile(site.hold, 0.5) };
+			const auto holdP99{ Statistics::GetPercentile(site.hold, 0.99) };
+			table.AddRow(std::move(site.name), site.acquisitions, site.contended, site.waitNs, waitP50, waitP99,
+				site.holdNs, holdP50, holdP99);
+		}
+	}
+
+private:
+	/**************************
+	 * @brief Lock names, is not profiled itself.
+	 */
+	FORCE_INLINE void LockNames() noexcept
+	{
+		while (m_namesLock.test_and_set(std::memory_order_acquire)) {
+			m_namesLock.wait(true, std::memory_order_relaxed);
+		}
+	}
+
+	/**************************
+	 * @brief Unlock names.
+	 */
+	FORCE_INLINE void UnlockNames() noexcept
+	{
+		m_namesLock.clear(std::memory_order_release);
+		m_namesLock.notify_one();
+	}
+
+	/**************************
+	 * @return Free block or newly registered one.
+	 */
+	FORCE_INLINE [[nodiscard]] Block* AcquireBlock()
+	{
+		for (Block* block{ m_blocks.load(std::memory_order_acquire) }; block != nullptr; block = block->next) {
+			bool expected{ false };
+			if (!block->isUsed.load(std::memory_order_relaxed)
+				&& block->isUsed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+
+				return block;
+			}
+		}
+
+		auto* block{ new Block };
+		block->isUsed.store(true, std::memory_order_relaxed);
+		block->next = m_blocks.load(std::memory_order_relaxed);
+		while (
+			!m_blocks.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed)) {
+		}
+		return block;
+	}
+};
+
+/**************************
+ * @brief Profiled site of one lock.
+ */
+class Site {
+private:
+	const uint32_t m_id;
+	int64_t m_acquiredAt{};
+
+public:
+	/**************************
+	 * @brief Construct a new Site object.
+	 *
+	 * @param name Name of site, nullptr to disable profiling of the lock.
+	 */
+	FORCE_INLINE explicit Site(const char* const name)
+		: m_id{ name == nullptr ? DISABLED_SITE : Registry::Get().Register(name) }
+	{
+	}
+
+	/**************************
+	 * @brief Record acquisition.
+	 *
+	 * @param begin Time of acquisition beginning.
+	 * @param isContended True if lock was not free.
+	 * @param isExclusive True if hold time should be recorded on release.
+	 */
+	FORCE_INLINE void Acquired(const int64_t begin, const bool isContended, const bool isExclusive) noexcept
+	{
+		if (m_id == DISABLED_SITE) {
+			return;
+		}
+
+		const auto now{ Now() };
+		auto& counters{ Registry::Get().GetCounters(m_id) };
+		Increment(counters.acquisitions, 1);
+		if (isContended) {
+			Increment(counters.contended, 1);
+		}
+		const auto wait{ FastClock::ToNanoseconds(now - begin) };
+		Increment(counters.waitNs, static_cast<uint64_t>(wait));
+		Increment(counters.wait[GetBucket(wait)], 1);
+		if (isExclusive) {
+			m_acquiredAt = now;
+		}
+	}
+
+	/**************************
+	 * @brief Record failed try of acquisition.
+	 */
+	FORCE_INLINE void Failed() noexcept
+	{
+		if (m_id != DISABLED_SITE) {
+			Increment(Registry::Get().GetCounters(m_id).contended, 1);
+		}
+	}
+
+	/**************************
+	 * @brief Record hold time of exclusive acquisition, does nothing after shared one.
+	 */
+	FORCE_INLINE void Released() noexcept
+	{
+		if (m_id == DISABLED_SITE || m_acquiredAt == 0) {
+			return;
+		}
+
+		const auto hold{ FastClock::ToNanoseconds(Now() - m_acquiredAt) };
+		m_acquiredAt = 0;
+		auto& counters{ Registry::Get().GetCounters(m_id) };
+		Increment(counters.holdNs, static_cast<uint64_t>(hold));
+		Increment(counters.hold[GetBucket(hold)], 1);
+	}
+
+private:
+	/**************************
+	 * @brief Increment counter of current thread without read-modify-write operation.
+	 */
+	FORCE_INLINE static void Increment(std::atomic<uint64_t>& counter, const uint64_t value) noexcept
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+};
+
+}; //* namespace Profiling
+
+}; //* namespace Pthread
+
+}; //* namespace MSAPI
+
+#define MSAPI_LOCK_PROFILING_SITE(name) ::MSAPI::Pthread::Profiling::Site m_site{ name };
+#define MSAPI_LOCK_PROFILING_BEGIN                                                                                     \
+	const int64_t lockProfilingBegin{ ::MSAPI::Pthread::Profiling::Now() };                                           \
+	bool lockProfilingIsContended{ false };
+#define MSAPI_LOCK_PROFILING_CONTENDED lockProfilingIsContended = true;
+#define MSAPI_LOCK_PROFILING_ACQUIRED(site, isExclusive)                                                               \
+	(site).Acquired(lockProfilingBegin, lockProfilingIsContended, isExclusive);
+#define MSAPI_LOCK_PROFILING_FAILED(site) (site).Failed();
+#define MSAPI_LOCK_PROFILING_RELEASED(site) (site).Released();
+
+#else
+
+#define MSAPI_LOCK_PROFILING_SITE(name)
+#define MSAPI_LOCK_PROFILING_BEGIN
+#define MSAPI_LOCK_PROFILING_CONTENDED
+#define MSAPI_LOCK_PROFILING_ACQUIRED(site, isExclusive)
+#define MSAPI_LOCK_PROFILING_FAILED(site)
+#define MSAPI_LOCK_PROFILING_RELEASED(site)
+
+#endif //* MSAPI_LOCK_PROFILING
+
+#endif //* MSAPI_LOCK_PROFILING_H
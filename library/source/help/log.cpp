@@ -18,9 +18,14 @@
  */
 
 #include "log.h"
+#include "binaryLog.h"
+#include "circleContainer.hpp"
 #include "io.inl"
+#include <algorithm>
 #include <cstring>
+#include <functional>
 #include <mutex>
+#include <unistd.h>
 
 std::mutex coutMutex;
 
@@ -28,6 +33,63 @@ namespace MSAPI {
 
 Log logger;
 
+namespace {
+
+/**************************
+ * @brief Header of message in ring, followed by text of message or by arguments of binary message.
+ */
+struct Record {
+	int64_t timestamp;
+	uint32_t size;
+	uint32_t site;
+	Log::Level level;
+};
+
+/**************************
+ * @brief Size of batch after which writer writes it without waiting for rings to be drained.
+ */
+constexpr size_t BATCH_SIZE{ 64 * 1024 };
+
+/**************************
+ * @brief Log file is written in binary format, see binaryLog.h.
+ */
+#ifdef MSAPI_LOG_BINARY
+constexpr bool BINARY{ true };
+#else
+constexpr bool BINARY{ false };
+#endif
+
+/**************************
+ * @brief Binary message reserved by current thread, message is in ring of thread or is written synchronously from
+ * buffer.
+ */
+struct Reservation {
+	bool inRing{};
+	std::string buffer;
+};
+
+thread_local Reservation reservation;
+
+} // namespace
+
+/**************************
+ * @brief Ring of one thread, is kept by writer until thread is finished and ring is drained.
+ */
+struct Log::ThreadRing {
+	CircleContainer container;
+	std::atomic<bool> isAlive{ true };
+
+	/**************************
+	 * @brief Construct a new Thread Ring object.
+	 *
+	 * @param size Size of ring in bytes.
+	 */
+	explicit ThreadRing(const size_t size)
+		: container{ size }
+	{
+	}
+};
+
 Log::Log(const bool toConsole, const bool toFile, const Level levelSave) noexcept
 	: m_toConsole(toConsole)
 	, m_toFile(toFile)
@@ -51,33 +113,396 @@ void Log::SetParentPath(const std::string& path) noexcept
 
 const std::string& Log::GetPath() const noexcept { return m_path; }
 
-//! Print(std::format_to(Log.GetBuffer(), ..., Level::INFO));
 void Log::Print(std::string&& str, const Level level) noexcept
 {
-	if (level > m_levelSave) {
+	if (level > m_levelSave.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	if (m_isAsyncActive.load(std::memory_order_acquire)) {
+		Push(str, level);
 		return;
 	}
+
+	std::string lines;
+	std::string entries;
+	Append(lines, entries, Timer().GetNanoseconds(), level, 0, str);
 	std::lock_guard<std::mutex> lock(coutMutex);
-	const auto time{ Timer().ToString() };
-	if (m_toFile && m_ofstreamLog.is_open()) {
-		m_ofstreamLog << "# " << time << " " << GetStringLevel(level) << " " + m_name + " : " << str << "."
-					  << std::endl;
+	Write(lines, entries);
+}
+
+void* Log::Reserve(const uint32_t site, const Level level, const size_t size) noexcept
+{
+	Record* record;
+	if (m_isAsyncActive.load(std::memory_order_acquire)) {
+		ThreadRing* ring;
+		try {
+			ring = &GetThreadRing();
+		}
+		catch (...) {
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		if (sizeof(Record) + size > ring->container.GetMaxRecordSize()) {
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		record = static_cast<Record*>(Acquire(*ring, sizeof(Record) + size));
+		if (record == nullptr) {
+			return nullptr;
+		}
+		reservation.inRing = true;
+	}
+	else {
+		try {
+			reservation.buffer.resize(sizeof(Record) + size);
+		}
+		catch (...) {
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		record = reinterpret_cast<Record*>(reservation.buffer.data());
+		reservation.inRing = false;
+	}
+
+	record->timestamp = Timer().GetNanoseconds();
+	record->size = static_cast<uint32_t>(size);
+	record->site = site;
+	record->level = level;
+	return record + 1;
+}
+
+void Log::Publish() noexcept
+{
+	if (reservation.inRing) {
+		//* Ring is already created by Reserve(), so it is not thrown
+		Commit(GetThreadRing());
+		return;
+	}
+
+	const auto* const record{ reinterpret_cast<const Record*>(reservation.buffer.data()) };
+	std::string lines;
+	std::string entries;
+	Append(lines, entries, record->timestamp, record->level, record->site,
+		std::string_view{ reinterpret_cast<const char*>(record + 1), record->size });
+	std::lock_guard<std::mutex> lock(coutMutex);
+	Write(lines, entries);
+}
+
+void Log::AppendLine(std::string& out, const int64_t timestamp, const Level level, const std::string_view name,
+	const std::string_view str)
+{
+	out += "# ";
+	Timer::AppendString(out, timestamp);
+	out += ' ';
+	out += GetStringLevel(level);
+	out += ' ';
+	out += name;
+	out += " : ";
+	out += str;
+	out += ".\n";
+}
+
+void Log::Append(std::string& lines, std::string& entries, const int64_t timestamp, const Level level,
+	const uint32_t site, const std::string_view payload) const
+{
+	if (!BINARY || m_toConsole) {
+		if (site == 0) {
+			AppendLine(lines, timestamp, level, m_name, payload);
+		}
+		else {
+			std::string text;
+			const auto* const registered{ BinaryLog::GetSite(site) };
+			if (registered == nullptr || !BinaryLog::Format(text, *registered, payload)) {
+				text = std::format("Corrupted binary message of site {}", site);
+			}
+			AppendLine(lines, timestamp, level, m_name, text);
+		}
+	}
+	if constexpr (BINARY) {
+		BinaryLog::AppendEntry(entries, site == 0 ? BinaryLog::Kind::Text : BinaryLog::Kind::Record, timestamp,
+			site, level, payload);
+	}
+}
+
+void Log::Write(const std::string_view lines, const std::string_view entries) noexcept
+{
+	if (m_toFile && m_file.IsOpen()) {
+		std::string sites;
+		if constexpr (BINARY) {
+			if (m_sitesWritten != BinaryLog::GetSitesSize()) {
+				m_sitesWritten = BinaryLog::AppendSites(sites, m_sitesWritten);
+			}
+			WriteFile(entries, sites);
+		}
+		else {
+			WriteFile(lines, sites);
+		}
 	}
 	if (m_toConsole) {
-		std::cout << "# " << time << " " << GetStringLevel(level) << " " + m_name + " : " << str << "." << std::endl;
+		std::cout.write(lines.data(), static_cast<std::streamsize>(lines.size())).flush();
+	}
+}
+
+void Log::WriteFile(std::string_view data, std::string& sites) noexcept
+{
+	const auto next{ [&data](const size_t offset) -> size_t {
+		if constexpr (BINARY) {
+			uint32_t size;
+			memcpy(&size, data.data() + offset + 8, sizeof(size));
+			return std::min(offset + BinaryLog::ENTRY_HEADER_SIZE + size, data.size());
+		}
+		else {
+			const auto end{ data.find('\n', offset) };
+			return end == std::string_view::npos ? data.size() : end + 1;
+		}
+	} };
+
+	while (!data.empty()) {
+		size_t size{ data.size() };
+		if (const auto free{ m_file.GetFree() }; sites.size() + size > free) {
+			size = 0;
+			for (size_t end; (end = next(size)) + sites.size() <= free; size = end) { }
+			if (size == 0) {
+				size = next(0);
+			}
+		}
+
+		if (m_file.Prepare(sites.size() + size)) {
+			if constexpr (BINARY) {
+				//* Ids of sites are valid within session, so each segment starts a new one to be decoded on its own
+				sites.clear();
+				BinaryLog::AppendEntry(
+					sites, BinaryLog::Kind::Begin, Timer().GetNanoseconds(), 0, Level::INFO, m_name);
+				m_sitesWritten = BinaryLog::AppendSites(sites, 0);
+			}
+		}
+		m_file.Write(sites);
+		sites.clear();
+		m_file.Write(data.substr(0, size));
+		data.remove_prefix(size);
+	}
+}
+
+void Log::Push(const std::string_view str, const Level level) noexcept
+{
+	ThreadRing* ring;
+	try {
+		ring = &GetThreadRing();
+	}
+	catch (...) {
+		m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	const size_t size{ std::min(str.size(), ring->container.GetMaxRecordSize() - sizeof(Record)) };
+	auto* const record{ static_cast<Record*>(Acquire(*ring, sizeof(Record) + size)) };
+	if (record == nullptr) {
+		return;
+	}
+
+	record->timestamp = Timer().GetNanoseconds();
+	record->size = static_cast<uint32_t>(size);
+	record->site = 0;
+	record->level = level;
+	memcpy(record + 1, str.data(), size);
+	Commit(*ring);
+}
+
+void* Log::Acquire(ThreadRing& ring, const size_t size) noexcept
+{
+	void* place;
+	while ((place = ring.container.Reserve(size)) == nullptr) {
+		if (m_overflow.load(std::memory_order_relaxed) != Overflow::Block
+			|| !m_isAsyncActive.load(std::memory_order_relaxed)) {
+
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		Wake();
+		std::this_thread::yield();
+	}
+	return place;
+}
+
+void Log::Commit(ThreadRing& ring) noexcept
+{
+	ring.container.Publish();
+
+	// Publishing of record must be ordered before check of sleeping flag, pairs with fence of RunWriter
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_isWriterSleeping.load(std::memory_order_relaxed)) {
+		Wake();
+	}
+}
+
+Log::ThreadRing& Log::GetThreadRing()
+{
+	struct Owner {
+		const Log* log{};
+		std::shared_ptr<ThreadRing> ring;
+
+		~Owner()
+		{
+			if (ring != nullptr) {
+				ring->isAlive.store(false, std::memory_order_release);
+			}
+		}
+	};
+
+	thread_local Owner owner;
+	if (owner.log != this) [[unlikely]] {
+		if (owner.ring != nullptr) {
+			owner.ring->isAlive.store(false, std::memory_order_release);
+		}
+
+		owner.ring = std::make_shared<ThreadRing>(m_ringSize);
+		owner.log = this;
+		std::lock_guard<std::mutex> lock(m_ringsMutex);
+		m_rings.emplace_back(owner.ring);
+		m_ringsVersion.fetch_add(1, std::memory_order_release);
 	}
+
+	return *owner.ring;
 }
 
-Log::Level Log::GetLevelSave() const noexcept { return m_levelSave; }
+void Log::Wake() noexcept
+{
+	m_wakeups.fetch_add(1, std::memory_order_release);
+	m_wakeups.notify_one();
+}
+
+void Log::RunWriter() noexcept
+{
+	std::vector<std::shared_ptr<ThreadRing>> rings;
+	std::vector<std::pair<int64_t, ThreadRing*>> heap;
+	uint64_t ringsVersion{ UINT64_MAX };
+	uint64_t reportedDropped{ m_dropped.load(std::memory_order_relaxed) };
+	std::string batch;
+	std::string entries;
+
+	while (true) {
+		const auto wakeups{ m_wakeups.load(std::memory_order_acquire) };
+		const bool isRunning{ m_isWriterRunning.load(std::memory_order_acquire) };
+
+		if (const auto version{ m_ringsVersion.load(std::memory_order_acquire) }; version != ringsVersion) {
+			std::lock_guard<std::mutex> lock(m_ringsMutex);
+			rings = m_rings;
+			ringsVersion = version;
+			heap.reserve(rings.size());
+		}
+
+		const auto drained{ Drain(rings, heap, batch, entries) };
+		if (const auto dropped{ m_dropped.load(std::memory_order_relaxed) }; dropped != reportedDropped) {
+			Append(batch, entries, Timer().GetNanoseconds(), Level::WARNING, 0,
+				std::format("Dropped {} messages due to full rings", dropped - reportedDropped));
+			reportedDropped = dropped;
+		}
+		if (!batch.empty() || !entries.empty()) {
+			std::lock_guard<std::mutex> lock(coutMutex);
+			Write(batch, entries);
+			if (m_flush.load(std::memory_order_relaxed) == Flush::Sync && m_toFile) {
+				m_file.Sync();
+			}
+			batch.clear();
+			entries.clear();
+		}
+
+		//* Ring of finished thread is released after its last messages are drained
+		for (const auto& ring : rings) {
+			size_t size;
+			if (!ring->isAlive.load(std::memory_order_acquire) && ring->container.Front(size) == nullptr) {
+				std::lock_guard<std::mutex> lock(m_ringsMutex);
+				std::erase_if(m_rings, [](const auto& registered) {
+					size_t registeredSize;
+					return !registered->isAlive.load(std::memory_order_acquire)
+						&& registered->container.Front(registeredSize) == nullptr;
+				});
+				m_ringsVersion.fetch_add(1, std::memory_order_release);
+				break;
+			}
+		}
+
+		if (!isRunning) {
+			return;
+		}
+
+		if (drained == 0) {
+			m_isWriterSleeping.store(true, std::memory_order_relaxed);
+			// Sleeping flag must be ordered before check of rings, pairs with fence of Push
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			bool isEmpty{ true };
+			for (const auto& ring : rings) {
+				size_t size;
+				if (ring->container.Front(size) != nullptr) {
+					isEmpty = false;
+					break;
+				}
+			}
+			if (isEmpty && m_ringsVersion.load(std::memory_order_acquire) == ringsVersion) {
+				m_wakeups.wait(wakeups, std::memory_order_acquire);
+			}
+			m_isWriterSleeping.store(false, std::memory_order_relaxed);
+		}
+	}
+}
+
+size_t Log::Drain(const std::vector<std::shared_ptr<ThreadRing>>& rings,
+	std::vector<std::pair<int64_t, ThreadRing*>>& heap, std::string& batch, std::string& entries) noexcept
+{
+	heap.clear();
+	for (const auto& ring : rings) {
+		size_t size;
+		if (const auto* record{ static_cast<const Record*>(ring->container.Front(size)) }; record != nullptr) {
+			heap.emplace_back(record->timestamp, ring.get());
+		}
+	}
+	std::ranges::make_heap(heap, std::greater{});
+
+	size_t drained{ 0 };
+	while (!heap.empty()) {
+		std::ranges::pop_heap(heap, std::greater{});
+		ThreadRing* const oldest{ heap.back().second };
+		size_t size;
+		const auto* record{ static_cast<const Record*>(oldest->container.Front(size)) };
+		Append(batch, entries, record->timestamp, record->level, record->site,
+			std::string_view{ reinterpret_cast<const char*>(record + 1), record->size });
+		oldest->container.Pop();
+		++drained;
+
+		//* Ring is ordered by itself, so only its next message replaces drained one in heap
+		if ((record = static_cast<const Record*>(oldest->container.Front(size))) != nullptr) {
+			heap.back().first = record->timestamp;
+			std::ranges::push_heap(heap, std::greater{});
+		}
+		else {
+			heap.pop_back();
+		}
+
+		if (batch.size() + entries.size() >= BATCH_SIZE) {
+			std::lock_guard<std::mutex> lock(coutMutex);
+			Write(batch, entries);
+			batch.clear();
+			entries.clear();
+		}
+	}
+
+	return drained;
+}
+
+Log::Level Log::GetLevelSave() const noexcept { return m_levelSave.load(std::memory_order_relaxed); }
 
 void Log::SetLevelSave(const Level levelSave) noexcept
 {
-	if (m_levelSave == levelSave) {
+	const auto previous{ m_levelSave.load(std::memory_order_relaxed) };
+	if (previous == levelSave) {
 		return;
 	}
-	Print(std::format("Update logging level from {} to {}", EnumToString(m_levelSave), EnumToString(levelSave)),
+	Print(std::format("Update logging level from {} to {}", EnumToString(previous), EnumToString(levelSave)),
 		Level::INFO);
-	m_levelSave = levelSave;
+	m_levelSave.store(levelSave, std::memory_order_relaxed);
 }
 
 bool Log::GetToFile() const noexcept { return m_toFile; }
@@ -153,6 +578,44 @@ std::string_view Log::EnumToString(const Level level) noexcept
 	}
 }
 
+std::string_view Log::EnumToString(const Overflow overflow) noexcept
+{
+	static_assert(U(Overflow::Max) == 3, "Missed description for a new overflow enum");
+
+	switch (overflow) {
+	case Overflow::Undefined:
+		return "Undefined";
+	case Overflow::Drop:
+		return "Drop";
+	case Overflow::Block:
+		return "Block";
+	case Overflow::Max:
+		return "Max";
+	default:
+		LOG_ERROR("Unknown overflow: " + _S(U(overflow)));
+		return "Unknown";
+	}
+}
+
+std::string_view Log::EnumToString(const Flush flush) noexcept
+{
+	static_assert(U(Flush::Max) == 3, "Missed description for a new flush enum");
+
+	switch (flush) {
+	case Flush::Undefined:
+		return "Undefined";
+	case Flush::Write:
+		return "Write";
+	case Flush::Sync:
+		return "Sync";
+	case Flush::Max:
+		return "Max";
+	default:
+		LOG_ERROR("Unknown flush: " + _S(U(flush)));
+		return "Unknown";
+	}
+}
+
 void Log::SetName(const std::string& name) noexcept
 {
 	if (m_active) {
@@ -167,23 +630,122 @@ void Log::SetName(const std::string& name) noexcept
 	}
 }
 
-void Log::SetSeparateDays(const bool separate) noexcept
+void Log::SetAsync(const bool async) noexcept
 {
+	if (m_async == async) {
+		return;
+	}
+	Print(std::format("Update flag of asynchronous logging from {} to {}", _S(m_async), _S(async)), Level::INFO);
+	m_async = async;
 	if (m_active) {
-		Print("Update separate days mode during logging process from " + _S(m_separateDays) + " to: " + _S(separate),
-			Level::INFO);
-		m_separateDays = separate;
-		if (m_separateDays && !m_timerToSeparate.IsRunning()) {
-			m_timerToSeparate.Start(Timer::GetSecondsToTomorrow(), static_cast<time_t>(SECONDS_IN_DAY), false);
-		}
+		Stop();
+		Start();
 	}
-	else {
-		Print("Update separate days mode from " + _S(m_separateDays) + " to: " + _S(separate), Level::INFO);
-		m_separateDays = separate;
+}
+
+bool Log::GetAsync() const noexcept { return m_async; }
+
+void Log::SetOverflow(const Overflow overflow) noexcept
+{
+	const auto previous{ m_overflow.load(std::memory_order_relaxed) };
+	if (previous == overflow) {
+		return;
+	}
+	Print(std::format("Update overflow action from {} to {}", EnumToString(previous), EnumToString(overflow)),
+		Level::INFO);
+	m_overflow.store(overflow, std::memory_order_relaxed);
+}
+
+Log::Overflow Log::GetOverflow() const noexcept { return m_overflow.load(std::memory_order_relaxed); }
+
+void Log::SetFlush(const Flush flush) noexcept
+{
+	const auto previous{ m_flush.load(std::memory_order_relaxed) };
+	if (previous == flush) {
+		return;
+	}
+	Print(std::format("Update flush policy from {} to {}", EnumToString(previous), EnumToString(flush)), Level::INFO);
+	m_flush.store(flush, std::memory_order_relaxed);
+	m_fileSettings.sync = flush == Flush::Sync;
+	m_file.SetSettings(m_fileSettings);
+}
+
+Log::Flush Log::GetFlush() const noexcept { return m_flush.load(std::memory_order_relaxed); }
+
+void Log::SetRingSize(const size_t ringSize) noexcept
+{
+	if (m_ringSize == ringSize) {
+		return;
+	}
+	Print(std::format("Update ring size from {} to {}", m_ringSize, ringSize), Level::INFO);
+	m_ringSize = ringSize;
+}
+
+size_t Log::GetRingSize() const noexcept { return m_ringSize; }
+
+uint64_t Log::GetDropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+void Log::SetSeparateDays(const bool separate) noexcept
+{
+	if (m_fileSettings.separateDays == separate) {
+		return;
+	}
+	Print("Update separate days mode from " + _S(m_fileSettings.separateDays) + " to: " + _S(separate), Level::INFO);
+	m_fileSettings.separateDays = separate;
+	m_file.SetSettings(m_fileSettings);
+}
+
+bool Log::GetSeparateDays() const noexcept { return m_fileSettings.separateDays; }
+
+void Log::SetSegmentSize(const size_t segmentSize) noexcept
+{
+	if (m_fileSettings.segmentSize == segmentSize) {
+		return;
+	}
+	Print(std::format("Update segment size from {} to {}", m_fileSettings.segmentSize, segmentSize), Level::INFO);
+	m_fileSettings.segmentSize = segmentSize;
+	m_file.SetSettings(m_fileSettings);
+}
+
+size_t Log::GetSegmentSize() const noexcept { return m_fileSettings.segmentSize; }
+
+void Log::SetRotationPeriod(const int64_t rotationPeriod) noexcept
+{
+	if (m_fileSettings.rotationPeriod == rotationPeriod) {
+		return;
+	}
+	Print(std::format("Update rotation period from {} to {}", m_fileSettings.rotationPeriod, rotationPeriod),
+		Level::INFO);
+	m_fileSettings.rotationPeriod = rotationPeriod;
+	m_file.SetSettings(m_fileSettings);
+}
+
+int64_t Log::GetRotationPeriod() const noexcept { return m_fileSettings.rotationPeriod; }
+
+void Log::SetRetentionSegments(const size_t retentionSegments) noexcept
+{
+	if (m_fileSettings.retentionSegments == retentionSegments) {
+		return;
+	}
+	Print(std::format("Update retention segments from {} to {}", m_fileSettings.retentionSegments, retentionSegments),
+		Level::INFO);
+	m_fileSettings.retentionSegments = retentionSegments;
+	m_file.SetSettings(m_fileSettings);
+}
+
+size_t Log::GetRetentionSegments() const noexcept { return m_fileSettings.retentionSegments; }
+
+void Log::SetRetentionAge(const int64_t retentionAge) noexcept
+{
+	if (m_fileSettings.retentionAge == retentionAge) {
+		return;
 	}
+	Print(std::format("Update retention age from {} to {}", m_fileSettings.retentionAge, retentionAge), Level::INFO);
+	m_fileSettings.retentionAge = retentionAge;
+	m_file.SetSettings(m_fileSettings);
 }
 
-bool Log::GetSeparateDays() const noexcept { return m_separateDays; }
+int64_t Log::GetRetentionAge() const noexcept { return m_fileSettings.retentionAge; }
 
 bool Log::IsActive() const noexcept { return m_active; }
 
@@ -199,12 +761,10 @@ void Log::Start() noexcept
 		return;
 	}
 
-	const auto sessionId{ Timer().GetMilliseconds() };
-
 	if (m_toFile) {
 		if (!m_path.empty() && !m_name.empty()
 			&& (IO::HasPath((m_path + "logs/").c_str()) || IO::CreateDir((m_path + "logs/").c_str()))) {
-			std::string name{ "logs/" + m_name };
+			std::string name{ m_name };
 			auto pos{ name.find(" ") };
 			while (true) {
 				if (pos == std::string::npos) {
@@ -214,18 +774,21 @@ void Log::Start() noexcept
 				pos = name.find(" ");
 			}
 
-			const std::string path{ m_path + name + "_" + _S(sessionId) + ".log" };
-			std::ofstream file{ path, std::ios::app };
-			if (!file.is_open()) {
+			std::unique_lock<std::mutex> lock(coutMutex);
+			if (!m_file.Open(m_path + "logs/", name, BINARY ? ".blog" : ".log", m_fileSettings)) {
+				lock.unlock();
 				m_toFile = false;
 				if (m_toConsole) {
-					Print("File to writing logs does not open, path: " + path + ". Error №" + _S(errno) + ": "
-							+ std::strerror(errno),
-						Level::ERROR);
+					Print("File to writing logs does not open, path: " + m_path + "logs/" + name, Level::ERROR);
 				}
 			}
-			else {
-				m_ofstreamLog = std::move(file);
+			else if constexpr (BINARY) {
+				//* Ids of sites are valid within session, so definitions are written again into each file
+				std::string begin;
+				BinaryLog::AppendEntry(
+					begin, BinaryLog::Kind::Begin, Timer().GetNanoseconds(), 0, Level::INFO, m_name);
+				m_file.Write(begin);
+				m_sitesWritten = 0;
 			}
 		}
 		else {
@@ -235,8 +798,10 @@ void Log::Start() noexcept
 		}
 	}
 
-	if (m_separateDays && !m_timerToSeparate.IsRunning()) {
-		m_timerToSeparate.Start(Timer::GetSecondsToTomorrow(), static_cast<time_t>(SECONDS_IN_DAY), false);
+	if (m_async) {
+		m_isWriterRunning.store(true, std::memory_order_release);
+		m_writer = std::thread{ [this]() { RunWriter(); } };
+		m_isAsyncActive.store(true, std::memory_order_release);
 	}
 	m_active = true;
 }
@@ -249,13 +814,37 @@ void Log::Stop() noexcept
 		return;
 	}
 
-	if (m_timerToSeparate.IsRunning()) {
-		m_timerToSeparate.Stop();
-	}
+	//* Maintenance of file may log, so it is stopped before writer and without lock
+	m_file.Stop();
 
 	m_active = false;
-	if (m_toFile && m_ofstreamLog.is_open()) {
-		m_ofstreamLog.close();
+	if (m_writer.joinable()) {
+		m_isAsyncActive.store(false, std::memory_order_release);
+		m_isWriterRunning.store(false, std::memory_order_release);
+		Wake();
+		m_writer.join();
+
+		//* Messages committed by threads which saw asynchronous mode before it was disabled are written here
+		std::vector<std::shared_ptr<ThreadRing>> rings;
+		{
+			std::lock_guard<std::mutex> lock(m_ringsMutex);
+			rings = m_rings;
+		}
+		std::vector<std::pair<int64_t, ThreadRing*>> heap;
+		heap.reserve(rings.size());
+		std::string batch;
+		std::string entries;
+		if (Drain(rings, heap, batch, entries) != 0) {
+			std::lock_guard<std::mutex> lock(coutMutex);
+			Write(batch, entries);
+			if (m_flush.load(std::memory_order_relaxed) == Flush::Sync && m_toFile) {
+				m_file.Sync();
+			}
+		}
+	}
+	if (m_file.IsOpen()) {
+		std::lock_guard<std::mutex> lock(coutMutex);
+		m_file.Close();
 	}
 	Print("Log was stopped", Level::DEBUG);
 }
@@ -26,15 +26,19 @@
 #define FORCE_INLINE inline
 #endif
 
-// #include "circleContainer.hpp"
+#include "logFile.h"
 #include "meta.hpp"
 #include "time.h"
+#include <atomic>
 #include <format>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #define STRINGIZE(x) std::string(STRINGIZE2(x))
@@ -80,73 +84,34 @@ template <uint64_t... Size> consteval auto Concatenate(const char (&... strings)
 
 #define BI(str, pattern, ...) std::format_to(std::back_inserter(str), pattern, __VA_ARGS__);
 
+/**************************
+ * @brief Most verbose logging level compiled into the program, values follow Log::Level: 1 - ERROR, 2 - WARNING,
+ * 3 - INFO, 4 - DEBUG, 5 - PROTOCOL. Calls of more verbose levels are removed together with building of their messages.
+ */
+#ifndef MSAPI_LOG_COMPILE_LEVEL
+#define MSAPI_LOG_COMPILE_LEVEL 5
+#endif
+
+/**************************
+ * @brief Maximum number of messages printed by rate limited call site during interval of milliseconds.
+ */
+#ifndef MSAPI_LOG_LIMIT_MESSAGES
+#define MSAPI_LOG_LIMIT_MESSAGES 10
+#endif
+#ifndef MSAPI_LOG_LIMIT_INTERVAL_MS
+#define MSAPI_LOG_LIMIT_INTERVAL_MS 1000
+#endif
+
 #define INT64(v) static_cast<int64_t>(v)
 #define UINT64(v) static_cast<uint64_t>(v)
 
 namespace MSAPI {
-/*
-template <typename T, int_fast32_t Size> class Logger {
-private:
-CircleContainer<T, Size>::Accessor m_accessor;
-bool m_isRunning{ true };
-int_fast64_t m_readsCounter{ 0 };
-std::thread m_thread{ [this]() {
-	std::cout << "logger's thread is running" << std::endl;
-
-	while (m_isRunning) {
-		auto newWrites{ Buffers::writesCounter.load(std::memory_order_acquire) - m_readsCounter };
-		while (newWrites-- > 0) {
-			auto& current{ m_accessor.GetCurrent() };
-
-			// 	std::cout << m_readsCounter << " --> read from " << current.buffer << " : " << std::string_view{
-			// static_cast<char*>(current.buffer), current.size } << std::endl;
-			++m_readsCounter;
-		}
-
-		Buffers::writesCounter.wait(m_readsCounter); //! Can stuck here
-	}
-
-	// Write last portion of logs
-	auto newWrites{ Buffers::writesCounter.load(std::memory_order_acquire) - m_readsCounter };
-	while (newWrites-- > 0) {
-		auto& current{ m_accessor.GetCurrent() };
-		// std::cout << m_readsCounter << " --> read from " << current.buffer << " : " << std::string_view{
-		// static_cast<char*>(current.buffer), current.size } << std::endl;
-		// ++m_readsCounter; //! TMP FOR TESTING
-	}
-} };
-
-public:
-Logger(auto& container)
-	: m_accessor{ container }
-{
-}
-
-~Logger()
-{
-	m_isRunning = false;
-
-	if (m_readsCounter < Buffers::writesCounter.load(std::memory_order_acquire)) {
-		// std::cout << "Notify due to some logs to write" << std::endl;
-		Buffers::writesCounter.notify_one();
-	}
-	else {
-		// std::cout << "Notify with less value" << std::endl;
-		Buffers::writesCounter.fetch_sub(1, std::memory_order_relaxed);
-		Buffers::writesCounter.notify_one();
-	}
-
-	m_thread.join();
-	// std::cout << "logger's thread is realized" << std::endl;
-}
-};
-*/
 
 /**************************
  * @brief For logging. Class is common for all calls inside a builded unit, disable syncronization between C and C++ I/O
  * buffers.
  *
- * @note If logging in file is enabled, logs will be saved in "parent path + logs/file name".
+ * @note If logging in file is enabled, logs will be saved in "parent path + logs/file name" segments, see LogFile.
  * @note INFO - level for logging in production. Main work process information. Goal: Client understand what all are
  * going well and in problem situation a developer understand in which part of program was problem.
  * @note DEBUG - level for logging all useful information about program work process. Goal: Developer understand
@@ -163,16 +128,43 @@ class Log : Timer {
 public:
 	enum class Level : int16_t { Undefined, ERROR, WARNING, INFO, DEBUG, PROTOCOL, Max };
 
+	/**************************
+	 * @brief Action of asynchronous logging when ring of thread is full: drop message and count it or wait for writer.
+	 */
+	enum class Overflow : int8_t { Undefined, Drop, Block, Max };
+
+	/**************************
+	 * @brief Durability of asynchronous logging: batch is copied into mapped log file or is also synced by msync().
+	 */
+	enum class Flush : int8_t { Undefined, Write, Sync, Max };
+
 private:
+	struct ThreadRing;
+
 	bool m_active{ false };
-	bool m_separateDays{ false };
 	bool m_toConsole;
 	bool m_toFile;
-	Level m_levelSave;
-	std::ofstream m_ofstreamLog;
+	bool m_async{ false };
+	std::atomic<Overflow> m_overflow{ Overflow::Drop };
+	std::atomic<Flush> m_flush{ Flush::Write };
+	size_t m_ringSize{ 1 << 20 };
+	std::atomic<Level> m_levelSave;
+	LogFile m_file;
+	LogFile::Settings m_fileSettings;
+	uint32_t m_sitesWritten{};
 	std::string m_name;
 	std::string m_path;
 
+	std::atomic<bool> m_isAsyncActive{ false };
+	std::atomic<bool> m_isWriterRunning{ false };
+	std::atomic<bool> m_isWriterSleeping{ false };
+	std::atomic<uint32_t> m_wakeups{};
+	std::atomic<uint64_t> m_dropped{};
+	std::atomic<uint64_t> m_ringsVersion{};
+	std::mutex m_ringsMutex;
+	std::vector<std::shared_ptr<ThreadRing>> m_rings;
+	std::thread m_writer;
+
 public:
 	/**************************
 	 * @brief Construct a new Log object.
@@ -199,49 +191,52 @@ public:
 	~Log() noexcept;
 
 	/**************************
-	 * @brief Synchrony request to write str by particular level.
+	 * @brief Write str by particular level, synchronously or through ring of current thread in asynchronous mode.
 	 */
 	void Print(std::string&& str, Level level) noexcept;
 
-	// template <typename... Ts>
-	// 	requires(sizeof...(Ts) > 0)
-	// constexpr FORCE_INLINE void Print(const Level level, const std::string logPlace, const std::format_string<Ts...>
-	// pattern, Ts&&... args)
-	// {
-	//! std::format_to(std::back_inserter(s), "Item: {}, Price: {}", item, price);
-	//! Take buffer from circle container and write to it directly by back_inserter
-	//! It will be great to support really huge buffers for tables and so on.
-	// 	if (level > m_levelSave) {
-	// 		return;
-	// 	}
-	// 	std::lock_guard<std::mutex> lock(coutMutex);
-	// 	const auto time{ Timer().ToString() };
-	// 	if (m_toFile && m_ofstreamLog.is_open()) {
-	// 		m_ofstreamLog << std::format("# {} {} {} : {}.", time, GetStringLevel(level), m_name,
-	// 			std::format(pattern, std::forward<Ts>(args)...))
-	// 					  << std::endl;
-	// 	}
-	// 	if (m_toConsole) {
-	// 		std::cout << std::format("# {} {} {} : {}.", time, GetStringLevel(level), m_name,
-	// 			std::format(pattern, std::forward<Ts>(args)...))
-	// 				  << std::endl;
-	// 	}
-	// }
-
-	// constexpr FORCE_INLINE void Print(const Level level, const std::string logPlace, const std::string_view str)
-	// {
-	// 	if (level > m_levelSave) {
-	// 		return;
-	// 	}
-	// 	std::lock_guard<std::mutex> lock(coutMutex);
-	// 	const auto time{ Timer().ToString() };
-	// 	if (m_toFile && m_ofstreamLog.is_open()) {
-	// 		m_ofstreamLog << std::format("# {} {} {} : {}.", time, GetStringLevel(level), m_name, str) << std::endl;
-	// 	}
-	// 	if (m_toConsole) {
-	// 		std::cout << std::format("# {} {} {} : {}.", time, GetStringLevel(level), m_name, str) << std::endl;
-	// 	}
-	// }
+	/**************************
+	 * @brief Reserve place for arguments of binary message of current thread, see binaryLog.h.
+	 *
+	 * @param site Id of registered site.
+	 * @param level Level of message.
+	 * @param size Size of arguments.
+	 *
+	 * @return Pointer to place of arguments, nullptr if message is dropped.
+	 *
+	 * @attention Publish() must be called after arguments are copied if place is returned.
+	 */
+	void* Reserve(uint32_t site, Level level, size_t size) noexcept;
+
+	/**************************
+	 * @brief Write binary message reserved by Reserve(), synchronously or through ring of current thread.
+	 */
+	void Publish() noexcept;
+
+	/**************************
+	 * @brief Append log line to the string.
+	 *
+	 * @param out String to append to.
+	 * @param timestamp Nanoseconds since epoch.
+	 * @param level Level of message.
+	 * @param name Name of program.
+	 * @param str Message.
+	 */
+	static void AppendLine(
+		std::string& out, int64_t timestamp, Level level, std::string_view name, std::string_view str);
+
+	/**************************
+	 * @brief Cheap check to be done before message is built, used by logging macros.
+	 *
+	 * @param level Level of message.
+	 *
+	 * @return True if level is compiled and is not higher than level to save.
+	 */
+	FORCE_INLINE [[nodiscard]] bool IsEnabled(const Level level) const noexcept
+	{
+		return static_cast<int16_t>(level) <= MSAPI_LOG_COMPILE_LEVEL
+			&& level <= m_levelSave.load(std::memory_order_relaxed);
+	}
 
 	/**************************
 	 * @return Current level to save.
@@ -280,11 +275,60 @@ public:
 	 */
 	void SetName(const std::string& name) noexcept;
 
+	/**************************
+	 * @brief Change flag of asynchronous mode, restart logging if it is active. In asynchronous mode each thread
+	 * writes messages into its own single producer single consumer ring without locks and background writer drains
+	 * rings in timestamp order, writes them by batches and applies flush policy.
+	 */
+	void SetAsync(bool async) noexcept;
+
+	/**************************
+	 * @return Current flag of asynchronous mode.
+	 */
+	bool GetAsync() const noexcept;
+
+	/**************************
+	 * @brief Change action on full ring of thread in asynchronous mode.
+	 */
+	void SetOverflow(Overflow overflow) noexcept;
+
+	/**************************
+	 * @return Current action on full ring of thread.
+	 */
+	Overflow GetOverflow() const noexcept;
+
+	/**************************
+	 * @brief Change flush policy of asynchronous mode, with Sync policy tail of log file segment is also synced before
+	 * segment is retired.
+	 */
+	void SetFlush(Flush flush) noexcept;
+
+	/**************************
+	 * @return Current flush policy of asynchronous mode.
+	 */
+	Flush GetFlush() const noexcept;
+
+	/**************************
+	 * @brief Change size of ring in bytes, applied to rings of threads which have not logged yet. Longer messages are
+	 * truncated to half of ring.
+	 */
+	void SetRingSize(size_t ringSize) noexcept;
+
+	/**************************
+	 * @return Current size of ring in bytes.
+	 */
+	size_t GetRingSize() const noexcept;
+
+	/**************************
+	 * @return Number of messages dropped due to full rings.
+	 */
+	uint64_t GetDropped() const noexcept;
+
 	/**************************
 	 * @brief Change flag of separate days mode.
 	 *
-	 * @note In this mode logger will create new log file every day at 00:00:00 UTC+0.
-	 * @attention Logs between close old file and create new on will be lost.
+	 * @note In this mode logger starts new log file segment every day at 00:00:00 UTC+0, no logs are lost during
+	 * rotation.
 	 */
 	void SetSeparateDays(bool separate) noexcept;
 
@@ -293,6 +337,47 @@ public:
 	 */
 	bool GetSeparateDays() const noexcept;
 
+	/**************************
+	 * @brief Change size of log file segment in bytes, applied to segments prepared after change. Segment is rotated
+	 * when it is full.
+	 */
+	void SetSegmentSize(size_t segmentSize) noexcept;
+
+	/**************************
+	 * @return Current size of log file segment in bytes.
+	 */
+	size_t GetSegmentSize() const noexcept;
+
+	/**************************
+	 * @brief Change period of rotation of log file segments in seconds, 0 to disable.
+	 */
+	void SetRotationPeriod(int64_t rotationPeriod) noexcept;
+
+	/**************************
+	 * @return Current period of rotation of log file segments in seconds.
+	 */
+	int64_t GetRotationPeriod() const noexcept;
+
+	/**************************
+	 * @brief Change maximum number of log file segments of program kept in directory, 0 for unlimited.
+	 */
+	void SetRetentionSegments(size_t retentionSegments) noexcept;
+
+	/**************************
+	 * @return Current maximum number of log file segments.
+	 */
+	size_t GetRetentionSegments() const noexcept;
+
+	/**************************
+	 * @brief Change age in seconds after which log file segments of program are removed, 0 for unlimited.
+	 */
+	void SetRetentionAge(int64_t retentionAge) noexcept;
+
+	/**************************
+	 * @return Current age of removing of log file segments in seconds.
+	 */
+	int64_t GetRetentionAge() const noexcept;
+
 	/**************************
 	 * @return Current logging process state.
 	 */
@@ -310,7 +395,6 @@ public:
 	 * @brief Interrupt logging.
 	 *
 	 * @note Close file to save logs if open.
-	 * @note Stop timer to separate. Parameter will not change.
 	 */
 	void Stop() noexcept;
 
@@ -333,43 +417,242 @@ public:
 	 */
 	static std::string_view EnumToString(Level level) noexcept;
 
+	/**************************
+	 * @return String interpretation of Overflow enum.
+	 */
+	static std::string_view EnumToString(Overflow overflow) noexcept;
+
+	/**************************
+	 * @return String interpretation of Flush enum.
+	 */
+	static std::string_view EnumToString(Flush flush) noexcept;
+
 	// TODO: TG
 	// TODO:https://ru.stackoverflow.com/questions/1349680/telegtam-api-%D0%9E%D1%82%D0%BF%D1%80%D0%B0%D0%B2%D0%B8%D1%82%D1%8C-%D1%82%D0%B5%D0%BA%D1%81%D1%82-%D0%9A%D0%B8%D1%80%D0%B8%D0%BB%D0%BB%D0%B8%D1%86%D1%83-%D1%87%D0%B5%D1%80%D0%B5%D0%B7-%D1%81-curl
 	// TODO: https://core.telegram.org/bots/api
 
 private:
-	Timer::Event m_timerToSeparate{ { [](int* parameter) {
-									   reinterpret_cast<Log*>(parameter)->Stop();
-									   reinterpret_cast<Log*>(parameter)->Start();
-								   } },
-		reinterpret_cast<int*>(this) };
-
 	/**************************
 	 * @return String interpretation of Level enum with static width between '<' and '>' symbols.
 	 */
 	static std::string_view GetStringLevel(Level level) noexcept;
+
+	/**************************
+	 * @brief Append message to lines for text outputs and to entries for binary log file if it is enabled.
+	 *
+	 * @param lines Text lines to append to.
+	 * @param entries Binary entries to append to.
+	 * @param timestamp Nanoseconds since epoch.
+	 * @param level Level of message.
+	 * @param site Id of site of binary message, 0 for text message.
+	 * @param payload Text of message or arguments of binary message.
+	 */
+	void Append(std::string& lines, std::string& entries, int64_t timestamp, Level level, uint32_t site,
+		std::string_view payload) const;
+
+	/**************************
+	 * @brief Write lines to console and lines or entries to file, definitions of new sites are written to binary log
+	 * file first. Each segment of binary log file starts with Begin entry and definitions of all sites.
+	 *
+	 * @attention coutMutex must be locked.
+	 */
+	void Write(std::string_view lines, std::string_view entries) noexcept;
+
+	/**************************
+	 * @brief Write lines or entries to file, segment is rotated between them so each segment can be read on its own.
+	 *
+	 * @param data Lines or entries.
+	 * @param sites Definitions of new sites of binary log file, written before data.
+	 *
+	 * @attention coutMutex must be locked.
+	 */
+	void WriteFile(std::string_view data, std::string& sites) noexcept;
+
+	/**************************
+	 * @brief Copy message into ring of current thread and wake writer if it is sleeping.
+	 */
+	void Push(std::string_view str, Level level) noexcept;
+
+	/**************************
+	 * @brief Reserve place in ring according to overflow action.
+	 *
+	 * @return Pointer to place, nullptr if message is dropped.
+	 */
+	void* Acquire(ThreadRing& ring, size_t size) noexcept;
+
+	/**************************
+	 * @brief Publish reserved record of ring and wake writer if it is sleeping.
+	 */
+	void Commit(ThreadRing& ring) noexcept;
+
+	/**************************
+	 * @return Ring of current thread, ring is registered on first call in thread.
+	 */
+	ThreadRing& GetThreadRing();
+
+	/**************************
+	 * @brief Wake writer.
+	 */
+	void Wake() noexcept;
+
+	/**************************
+	 * @brief Body of writer thread, runs until logging is stopped and rings are drained.
+	 */
+	void RunWriter() noexcept;
+
+	/**************************
+	 * @brief Move available messages of rings into batch in timestamp order, write batch when it is large enough.
+	 * Rings are merged by min heap of their oldest messages.
+	 *
+	 * @param heap Storage of heap, capacity must be not less than number of rings.
+	 *
+	 * @return Number of drained messages.
+	 */
+	size_t Drain(const std::vector<std::shared_ptr<ThreadRing>>& rings,
+		std::vector<std::pair<int64_t, ThreadRing*>>& heap, std::string& batch, std::string& entries) noexcept;
 };
 
 extern Log logger;
 
+/**************************
+ * @brief State of rate limited call site. Counters are updated without locks, so number of printed messages may
+ * slightly exceed limit when interval is changed concurrently.
+ */
+class LogLimit {
+private:
+	std::atomic<int64_t> m_intervalBegin{ INT64_MIN / 2 };
+	std::atomic<uint32_t> m_printed{};
+	std::atomic<uint64_t> m_suppressed{};
+
+public:
+	/**************************
+	 * @brief Count message and decide if it is printed.
+	 *
+	 * @param limit Maximum number of messages printed during interval.
+	 * @param interval Interval in milliseconds.
+	 * @param suppressed Number of messages suppressed since previous interval, is set when the first message of new
+	 * interval is printed and is 0 otherwise.
+	 *
+	 * @return True if message is printed, false if it is suppressed.
+	 *
+	 * @test Has unit tests.
+	 */
+	FORCE_INLINE [[nodiscard]] bool Allow(const uint32_t limit, const int64_t interval, uint64_t& suppressed) noexcept
+	{
+		timespec time;
+		(void)clock_gettime(CLOCK_MONOTONIC_COARSE, &time);
+		const auto now{ static_cast<int64_t>(time.tv_sec) * 1000 + time.tv_nsec / 1000000 };
+
+		suppressed = 0;
+		if (auto begin{ m_intervalBegin.load(std::memory_order_relaxed) }; now - begin >= interval
+			&& m_intervalBegin.compare_exchange_strong(begin, now, std::memory_order_relaxed)) {
+
+			m_printed.store(1, std::memory_order_relaxed);
+			suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+			return true;
+		}
+
+		if (m_printed.load(std::memory_order_relaxed) < limit
+			&& m_printed.fetch_add(1, std::memory_order_relaxed) < limit) {
+
+			return true;
+		}
+
+		m_suppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+};
+
 }; //* namespace MSAPI
 
+/**************************
+ * @brief Print message if level is enabled, message is not built otherwise.
+ */
+#define LOG_IF_ENABLED(level, message)                                                                                 \
+	do {                                                                                                               \
+		if (MSAPI::logger.IsEnabled(level)) {                                                                          \
+			MSAPI::logger.Print(message, level);                                                                       \
+		}                                                                                                              \
+	} while (false)
+
+/**************************
+ * @brief MSAPI_LOG_BINARY build flag switches messages with pattern to deferred formatting and log file to binary
+ * format, see binaryLog.h.
+ */
+#ifdef MSAPI_LOG_BINARY
+#define LOG_ERROR_NEW(pattern, ...) LOG_BINARY_IF_ENABLED(MSAPI::Log::Level::ERROR, pattern, __VA_ARGS__)
+#define LOG_WARNING_NEW(pattern, ...) LOG_BINARY_IF_ENABLED(MSAPI::Log::Level::WARNING, pattern, __VA_ARGS__)
+#define LOG_INFO_NEW(pattern, ...) LOG_BINARY_IF_ENABLED(MSAPI::Log::Level::INFO, pattern, __VA_ARGS__)
+#define LOG_DEBUG_NEW(pattern, ...) LOG_BINARY_IF_ENABLED(MSAPI::Log::Level::DEBUG, pattern, __VA_ARGS__)
+#define LOG_PROTOCOL_NEW(pattern, ...) LOG_BINARY_IF_ENABLED(MSAPI::Log::Level::PROTOCOL, pattern, __VA_ARGS__)
+#else
 #define LOG_ERROR_NEW(pattern, ...)                                                                                    \
-	MSAPI::logger.Print(LOG_PLACE + std::format(pattern, __VA_ARGS__), MSAPI::Log::Level::ERROR)
+	LOG_IF_ENABLED(MSAPI::Log::Level::ERROR, LOG_PLACE + std::format(pattern, __VA_ARGS__))
 #define LOG_WARNING_NEW(pattern, ...)                                                                                  \
-	MSAPI::logger.Print(LOG_PLACE + std::format(pattern, __VA_ARGS__), MSAPI::Log::Level::WARNING)
+	LOG_IF_ENABLED(MSAPI::Log::Level::WARNING, LOG_PLACE + std::format(pattern, __VA_ARGS__))
 #define LOG_INFO_NEW(pattern, ...)                                                                                     \
-	MSAPI::logger.Print(LOG_PLACE + std::format(pattern, __VA_ARGS__), MSAPI::Log::Level::INFO)
+	LOG_IF_ENABLED(MSAPI::Log::Level::INFO, LOG_PLACE + std::format(pattern, __VA_ARGS__))
 #define LOG_DEBUG_NEW(pattern, ...)                                                                                    \
-	MSAPI::logger.Print(LOG_PLACE + std::format(pattern, __VA_ARGS__), MSAPI::Log::Level::DEBUG)
+	LOG_IF_ENABLED(MSAPI::Log::Level::DEBUG, LOG_PLACE + std::format(pattern, __VA_ARGS__))
 #define LOG_PROTOCOL_NEW(pattern, ...)                                                                                 \
-	MSAPI::logger.Print(LOG_PLACE + std::format(pattern, __VA_ARGS__), MSAPI::Log::Level::PROTOCOL)
+	LOG_IF_ENABLED(MSAPI::Log::Level::PROTOCOL, LOG_PLACE + std::format(pattern, __VA_ARGS__))
+#endif
 
-#define LOG_ERROR(text) MSAPI::logger.Print(LOG_PLACE + text, MSAPI::Log::Level::ERROR)
-#define LOG_WARNING(text) MSAPI::logger.Print(LOG_PLACE + text, MSAPI::Log::Level::WARNING)
-#define LOG_INFO(text) MSAPI::logger.Print(LOG_PLACE + text, MSAPI::Log::Level::INFO)
-#define LOG_DEBUG(text) MSAPI::logger.Print(LOG_PLACE + text, MSAPI::Log::Level::DEBUG)
-#define LOG_PROTOCOL(text) MSAPI::logger.Print(LOG_PLACE + text, MSAPI::Log::Level::PROTOCOL)
+#define LOG_ERROR(text) LOG_IF_ENABLED(MSAPI::Log::Level::ERROR, LOG_PLACE + text)
+#define LOG_WARNING(text) LOG_IF_ENABLED(MSAPI::Log::Level::WARNING, LOG_PLACE + text)
+#define LOG_INFO(text) LOG_IF_ENABLED(MSAPI::Log::Level::INFO, LOG_PLACE + text)
+#define LOG_DEBUG(text) LOG_IF_ENABLED(MSAPI::Log::Level::DEBUG, LOG_PLACE + text)
+#define LOG_PROTOCOL(text) LOG_IF_ENABLED(MSAPI::Log::Level::PROTOCOL, LOG_PLACE + text)
+
+/**************************
+ * @brief Execute logging statement of call site at most MSAPI_LOG_LIMIT_MESSAGES times per
+ * MSAPI_LOG_LIMIT_INTERVAL_MS, the first message of next interval is preceded by line with number of suppressed ones.
+ */
+#define LOG_LIMITED_IF_ENABLED(level, statement)                                                                       \
+	do {                                                                                                               \
+		if (MSAPI::logger.IsEnabled(level)) {                                                                          \
+			static MSAPI::LogLimit logLimit;                                                                           \
+			uint64_t suppressed;                                                                                       \
+			if (logLimit.Allow(MSAPI_LOG_LIMIT_MESSAGES, MSAPI_LOG_LIMIT_INTERVAL_MS, suppressed)) {                   \
+				if (suppressed != 0) {                                                                                 \
+					MSAPI::logger.Print(LOG_PLACE + std::format("Suppressed {} messages", suppressed), level);         \
+				}                                                                                                      \
+				statement;                                                                                             \
+			}                                                                                                          \
+		}                                                                                                              \
+	} while (false)
+
+/**************************
+ * @brief Execute logging statement of call site for the first and then for every rate-th message.
+ */
+#define LOG_SAMPLED_IF_ENABLED(level, rate, statement)                                                                 \
+	do {                                                                                                               \
+		if (MSAPI::logger.IsEnabled(level)) {                                                                          \
+			static std::atomic<uint64_t> logSample{};                                                                  \
+			if (logSample.fetch_add(1, std::memory_order_relaxed) % (rate) == 0) {                                     \
+				statement;                                                                                             \
+			}                                                                                                          \
+		}                                                                                                              \
+	} while (false)
+
+/**************************
+ * @brief Rate limited logging for call sites which can fire for each message or each read, e.g. on protocol paths.
+ */
+#define LOG_ERROR_LIMITED(text) LOG_LIMITED_IF_ENABLED(MSAPI::Log::Level::ERROR, LOG_ERROR(text))
+#define LOG_WARNING_LIMITED(text) LOG_LIMITED_IF_ENABLED(MSAPI::Log::Level::WARNING, LOG_WARNING(text))
+#define LOG_INFO_LIMITED(text) LOG_LIMITED_IF_ENABLED(MSAPI::Log::Level::INFO, LOG_INFO(text))
+#define LOG_DEBUG_LIMITED(text) LOG_LIMITED_IF_ENABLED(MSAPI::Log::Level::DEBUG, LOG_DEBUG(text))
+#define LOG_PROTOCOL_LIMITED(text) LOG_LIMITED_IF_ENABLED(MSAPI::Log::Level::PROTOCOL, LOG_PROTOCOL(text))
+#define LOG_ERROR_NEW_LIMITED(pattern, ...)                                                                            \
+	LOG_LIMITED_IF_ENABLED(MSAPI::Log::Level::ERROR, LOG_ERROR_NEW(pattern, __VA_ARGS__))
+#define LOG_WARNING_NEW_LIMITED(pattern, ...)                                                                          \
+	LOG_LIMITED_IF_ENABLED(MSAPI::Log::Level::WARNING, LOG_WARNING_NEW(pattern, __VA_ARGS__))
+#define LOG_INFO_NEW_LIMITED(pattern, ...)                                                                             \
+	LOG_LIMITED_IF_ENABLED(MSAPI::Log::Level::INFO, LOG_INFO_NEW(pattern, __VA_ARGS__))
+#define LOG_DEBUG_NEW_LIMITED(pattern, ...)                                                                            \
+	LOG_LIMITED_IF_ENABLED(MSAPI::Log::Level::DEBUG, LOG_DEBUG_NEW(pattern, __VA_ARGS__))
+#define LOG_PROTOCOL_NEW_LIMITED(pattern, ...)                                                                         \
+	LOG_LIMITED_IF_ENABLED(MSAPI::Log::Level::PROTOCOL, LOG_PROTOCOL_NEW(pattern, __VA_ARGS__))
 
 #define U(x) static_cast<std::underlying_type_t<decltype(x)>>(x)
 
@@ -517,4 +800,9 @@ struct std::formatter<T> {
 	template <typename FormatContext> auto format(const T opt, FormatContext& ctx) { return _S(opt); }
 };
 
+//* Binary logging builds on logger, so it is included after logger is declared
+#ifdef MSAPI_LOG_BINARY
+#include "binaryLog.h"
+#endif
+
 #endif //* MSAPI_LOG_H
\ No newline at end of file
@@ -0,0 +1,479 @@
+/**************************
+ * @file        logFile.cpp
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#include "logFile.h"
+#include "io.inl"
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MSAPI {
+
+namespace {
+
+/**************************
+ * @brief Period of applying retention by age when segments are not rotated.
+ */
+constexpr auto MAINTENANCE_PERIOD{ std::chrono::seconds{ 60 } };
+
+/**************************
+ * @brief Period of retrying preparation of next segment after failure.
+ */
+constexpr auto PREPARATION_PERIOD{ std::chrono::seconds{ 1 } };
+
+/**************************
+ * @brief Time for which writer waits for next segment when data does not fit into current one.
+ */
+constexpr auto PREPARATION_TIMEOUT{ std::chrono::seconds{ 1 } };
+
+/**************************
+ * @return Seconds since epoch by coarse clock, precision of clock tick is enough for rotation.
+ */
+int64_t GetSeconds() noexcept
+{
+	timespec time;
+	(void)clock_gettime(CLOCK_REALTIME_COARSE, &time);
+	return static_cast<int64_t>(time.tv_sec);
+}
+
+/**************************
+ * @brief Parse decimal number without sign.
+ *
+ * @param minSize Minimal number of digits, number longer than it must not start with zero.
+ *
+ * @return True if digits are valid number.
+ */
+bool ParseNumber(const std::string_view digits, const size_t minSize, uint64_t& number) noexcept
+{
+	if (digits.size() < minSize || digits.size() > 19 || (digits.size() > minSize && digits.front() == '0')) {
+		return false;
+	}
+
+	number = 0;
+	for (const char digit : digits) {
+		if (digit < '0' || digit > '9') {
+			return false;
+		}
+		number = number * 10 + static_cast<uint64_t>(digit - '0');
+	}
+	return true;
+}
+
+/**************************
+ * @brief Parse name of segment formed by LogFile::Create() as "<prefix>_<session>_<index><extension>".
+ *
+ * @param key Session and index of segment.
+ *
+ * @return True if name is name of segment.
+ */
+bool ParseSegment(const std::string_view name, const std::string_view prefix, const std::string_view extension,
+	std::pair<uint64_t, uint64_t>& key) noexcept
+{
+	if (name.size() <= prefix.size() + extension.size() + 1 || !name.starts_with(prefix) || !name.ends_with(extension)
+		|| name[prefix.size()] != '_') {
+
+		return false;
+	}
+
+	const auto numbers{ name.substr(prefix.size() + 1, name.size() - prefix.size() - 1 - extension.size()) };
+	const auto separator{ numbers.find('_') };
+	return separator != std::string_view::npos && ParseNumber(numbers.substr(0, separator), 1, key.first)
+		&& ParseNumber(numbers.substr(separator + 1), 6, key.second);
+}
+
+} // namespace
+
+LogFile::~LogFile() noexcept
+{
+	Stop();
+	Close();
+}
+
+bool LogFile::Open(const std::string& directory, const std::string& prefix, const std::string& extension,
+	const Settings& settings) noexcept
+{
+	if (m_segment != nullptr) {
+		return true;
+	}
+
+	m_directory = directory;
+	m_prefix = prefix;
+	m_extension = extension;
+	m_session = Timer().GetMilliseconds();
+	m_nextIndex.store(0, std::memory_order_relaxed);
+	m_settings = settings;
+
+	m_segment = Create(m_settings.segmentSize, false);
+	if (m_segment == nullptr) {
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_segment->rotateAt = GetRotationTime();
+		m_activePath = m_segment->path;
+		m_isRunning = true;
+	}
+	m_maintainer = std::thread{ [this]() { Maintain(); } };
+	return true;
+}
+
+bool LogFile::IsOpen() const noexcept { return m_segment != nullptr; }
+
+void LogFile::SetSettings(const Settings& settings) noexcept
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_settings = settings;
+	}
+	m_condition.notify_all();
+}
+
+bool LogFile::Prepare(const size_t size) noexcept
+{
+	if (m_segment == nullptr) [[unlikely]] {
+		return false;
+	}
+
+	const bool isExpired{ m_segment->rotateAt != 0 && GetSeconds() >= m_segment->rotateAt };
+	if (m_segment->offset + size <= m_segment->capacity && !isExpired) [[likely]] {
+		return false;
+	}
+
+	//* Empty segment is not rotated, data larger than segment is continued in next one
+	if (m_segment->offset == 0) {
+		if (isExpired) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_segment->rotateAt = GetRotationTime();
+		}
+		return false;
+	}
+
+	//* Expired segment which still has place is rotated later if next segment is not ready yet
+	return Rotate(m_segment->offset + size > m_segment->capacity);
+}
+
+size_t LogFile::GetFree() const noexcept
+{
+	return m_segment == nullptr ? 0 : m_segment->capacity - m_segment->offset;
+}
+
+void LogFile::Write(std::string_view data) noexcept
+{
+	if (m_segment == nullptr) [[unlikely]] {
+		return;
+	}
+
+	while (!data.empty()) {
+		if (m_segment->offset == m_segment->capacity && !Rotate(true)) [[unlikely]] {
+			std::cerr << "Log segment " << m_segment->path << " is full, " << data.size() << " bytes are lost"
+					  << std::endl;
+			return;
+		}
+
+		const auto size{ std::min(data.size(), m_segment->capacity - m_segment->offset) };
+		memcpy(m_segment->data + m_segment->offset, data.data(), size);
+		m_segment->offset += size;
+		data.remove_prefix(size);
+	}
+}
+
+void LogFile::Sync() noexcept
+{
+	if (m_segment == nullptr || m_segment->synced == m_segment->offset) {
+		return;
+	}
+
+	static const auto pageSize{ static_cast<size_t>(sysconf(_SC_PAGESIZE)) };
+	const auto begin{ m_segment->synced / pageSize * pageSize };
+	if (msync(m_segment->data + begin, m_segment->offset - begin, MS_SYNC) != 0) [[unlikely]] {
+		std::cerr << "Log segment " << m_segment->path << " is not synced. Error №" << errno << ": "
+				  << std::strerror(errno) << std::endl;
+		return;
+	}
+	m_segment->synced = m_segment->offset;
+}
+
+void LogFile::Stop() noexcept
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_isRunning) {
+			return;
+		}
+		m_isRunning = false;
+	}
+	m_condition.notify_all();
+	m_maintainer.join();
+
+	Settings settings;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		settings = m_settings;
+	}
+	Retain(settings);
+}
+
+void LogFile::Close() noexcept
+{
+	std::vector<Segment*> retired;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		retired.swap(m_retired);
+		m_activePath.clear();
+	}
+	for (auto* const segment : retired) {
+		Finish(segment, false);
+	}
+
+	if (m_segment != nullptr) {
+		Finish(m_segment, false);
+		m_segment = nullptr;
+	}
+	if (auto* const spare{ m_spare.exchange(nullptr, std::memory_order_acq_rel) }; spare != nullptr) {
+		Finish(spare, true);
+	}
+}
+
+std::string_view LogFile::GetPath() const noexcept
+{
+	return m_segment == nullptr ? std::string_view{} : std::string_view{ m_segment->path };
+}
+
+bool LogFile::Rotate(const bool wait) noexcept
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	auto* next{ m_spare.exchange(nullptr, std::memory_order_acq_rel) };
+	if (next == nullptr) [[unlikely]] {
+		//* Segment is never created by writer, background thread is woken to prepare it
+		m_isRotated = true;
+		m_condition.notify_all();
+		if (!wait) {
+			return false;
+		}
+
+		const auto isReady{ [this]() { return !m_isRunning || m_spare.load(std::memory_order_acquire) != nullptr; } };
+		if (!m_condition.wait_for(lock, PREPARATION_TIMEOUT, isReady)
+			|| (next = m_spare.exchange(nullptr, std::memory_order_acq_rel)) == nullptr) {
+
+			return false;
+		}
+	}
+	const bool sync{ m_settings.sync };
+	lock.unlock();
+
+	//* Retired segment is finished by background thread, so its tail is synchronized while it is still current
+	if (sync) {
+		Sync();
+	}
+
+	lock.lock();
+	next->rotateAt = GetRotationTime();
+	m_retired.push_back(m_segment);
+	m_segment = next;
+	m_activePath = next->path;
+	m_isRotated = true;
+	m_condition.notify_all();
+	return true;
+}
+
+LogFile::Segment* LogFile::Create(size_t size, const bool populate) noexcept
+{
+	static const auto pageSize{ static_cast<size_t>(sysconf(_SC_PAGESIZE)) };
+	size = std::max((size + pageSize - 1) / pageSize * pageSize, pageSize);
+
+	auto* const segment{ new (std::nothrow) Segment };
+	if (segment == nullptr) [[unlikely]] {
+		return nullptr;
+	}
+
+	segment->path = std::format("{}{}_{}_{:06}{}", m_directory, m_prefix, m_session,
+		m_nextIndex.fetch_add(1, std::memory_order_relaxed), m_extension);
+	segment->file = open(segment->path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (segment->file == -1) [[unlikely]] {
+		std::cerr << "Log segment " << segment->path << " is not opened. Error №" << errno << ": "
+				  << std::strerror(errno) << std::endl;
+		delete segment;
+		return nullptr;
+	}
+
+	//* Blocks are allocated in advance, so writing into mapping does not fail on full storage
+	if (fallocate(segment->file, 0, 0, static_cast<off_t>(size)) != 0
+		&& (errno != EOPNOTSUPP || ftruncate(segment->file, static_cast<off_t>(size)) != 0)) [[unlikely]] {
+
+		std::cerr << "Log segment " << segment->path << " is not allocated. Error №" << errno << ": "
+				  << std::strerror(errno) << std::endl;
+		Finish(segment, true);
+		return nullptr;
+	}
+
+	void* const data{ mmap(
+		nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | (populate ? MAP_POPULATE : 0), segment->file, 0) };
+	if (data == MAP_FAILED) [[unlikely]] {
+		std::cerr << "Log segment " << segment->path << " is not mapped. Error №" << errno << ": "
+				  << std::strerror(errno) << std::endl;
+		Finish(segment, true);
+		return nullptr;
+	}
+
+	segment->data = static_cast<char*>(data);
+	segment->capacity = size;
+	return segment;
+}
+
+void LogFile::Finish(Segment* const segment, const bool remove) noexcept
+{
+	if (segment->data != nullptr && munmap(segment->data, segment->capacity) != 0) [[unlikely]] {
+		std::cerr << "Log segment " << segment->path << " is not unmapped. Error №" << errno << ": "
+				  << std::strerror(errno) << std::endl;
+	}
+
+	if (remove || segment->offset == 0) {
+		if (unlink(segment->path.c_str()) != 0) [[unlikely]] {
+			std::cerr << "Log segment " << segment->path << " is not removed. Error №" << errno << ": "
+					  << std::strerror(errno) << std::endl;
+		}
+	}
+	else if (ftruncate(segment->file, static_cast<off_t>(segment->offset)) != 0) [[unlikely]] {
+		std::cerr << "Log segment " << segment->path << " is not truncated. Error №" << errno << ": "
+				  << std::strerror(errno) << std::endl;
+	}
+
+	close(segment->file);
+	delete segment;
+}
+
+void LogFile::Retain(const Settings& settings)
+{
+	if (settings.retentionSegments == 0 && settings.retentionAge == 0) {
+		return;
+	}
+
+	std::vector<std::string> names;
+	if (!IO::List<IO::FileType::Regular>(names, m_directory.c_str())) {
+		return;
+	}
+
+	//* Current segment and segments started after it are newer by session and index, so they are never removed
+	std::string activePath;
+	std::string sparePath;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		activePath = m_activePath;
+		if (const auto* const spare{ m_spare.load(std::memory_order_acquire) }; spare != nullptr) {
+			sparePath = spare->path;
+		}
+	}
+	std::pair<uint64_t, uint64_t> active;
+	if (activePath.size() <= m_directory.size()
+		|| !ParseSegment(std::string_view{ activePath }.substr(m_directory.size()), m_prefix, m_extension, active)) {
+
+		return;
+	}
+
+	std::vector<std::pair<std::pair<uint64_t, uint64_t>, std::string>> segments;
+	for (const auto& name : names) {
+		std::pair<uint64_t, uint64_t> key;
+		if (ParseSegment(name, m_prefix, m_extension, key) && m_directory + name != sparePath) {
+			segments.emplace_back(key, m_directory + name);
+		}
+	}
+	std::sort(segments.begin(), segments.end());
+
+	size_t excess{ settings.retentionSegments == 0 || segments.size() <= settings.retentionSegments
+			? 0
+			: segments.size() - settings.retentionSegments };
+	const auto now{ GetSeconds() };
+	for (const auto& [key, path] : segments) {
+		if (key >= active) {
+			break;
+		}
+
+		bool isExpired{ excess > 0 };
+		if (!isExpired && settings.retentionAge != 0) {
+			struct stat st { };
+			isExpired = stat(path.c_str(), &st) == 0 && now - static_cast<int64_t>(st.st_mtime) > settings.retentionAge;
+		}
+		if (!isExpired) {
+			continue;
+		}
+
+		if (IO::Remove(path)) {
+			LOG_DEBUG_NEW("Log segment {} is removed by retention", path);
+		}
+		if (excess > 0) {
+			--excess;
+		}
+	}
+}
+
+void LogFile::Maintain() noexcept
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (m_isRunning) {
+		std::vector<Segment*> retired;
+		retired.swap(m_retired);
+		m_isRotated = false;
+		const auto settings{ m_settings };
+		lock.unlock();
+
+		//* Next segment is prepared first, writer may wait for it
+		bool isPrepared{ m_spare.load(std::memory_order_acquire) != nullptr };
+		if (!isPrepared) {
+			if (auto* const segment{ Create(settings.segmentSize, true) }; segment != nullptr) {
+				{
+					std::lock_guard<std::mutex> spareLock(m_mutex);
+					m_spare.store(segment, std::memory_order_release);
+				}
+				m_condition.notify_all();
+				isPrepared = true;
+			}
+		}
+		for (auto* const segment : retired) {
+			Finish(segment, false);
+		}
+		Retain(settings);
+
+		lock.lock();
+		if (m_isRunning && !m_isRotated) {
+			m_condition.wait_for(lock, isPrepared ? MAINTENANCE_PERIOD : PREPARATION_PERIOD);
+		}
+	}
+}
+
+int64_t LogFile::GetRotationTime() const noexcept
+{
+	const auto now{ GetSeconds() };
+	int64_t rotateAt{ 0 };
+	if (m_settings.rotationPeriod > 0) {
+		rotateAt = now + m_settings.rotationPeriod;
+	}
+	if (m_settings.separateDays) {
+		const auto tomorrow{ (now / SECONDS_IN_DAY + 1) * SECONDS_IN_DAY };
+		rotateAt = rotateAt == 0 ? tomorrow : std::min(rotateAt, tomorrow);
+	}
+	return rotateAt;
+}
+
+}; //* namespace MSAPI
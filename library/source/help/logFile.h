@@ -0,0 +1,216 @@
+/**************************
+ * @file        logFile.h
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef MSAPI_LOG_FILE_H
+#define MSAPI_LOG_FILE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace MSAPI {
+
+/**************************
+ * @brief Log file written into memory mapped segments. Segment is preallocated by fallocate(), so writing is copying
+ * into memory without system calls. Next segment is prepared in background, rotation by size or time swaps current
+ * segment with prepared one. Background thread also truncates finished segments to written size, unmaps them and
+ * removes old segments according to retention.
+ *
+ * @note Segments are named "<prefix>_<session>_<index><extension>", where session is milliseconds of opening and
+ * index has at least six digits. Retention takes only names of this pattern and orders them by session and index.
+ * @note Not written tail of segment is zeroed until segment is finished.
+ *
+ * @attention Open(), Prepare(), Write(), Sync() and Close() must not be called concurrently.
+ */
+class LogFile {
+public:
+	/**************************
+	 * @brief Settings of segments, rotation and retention.
+	 *
+	 * @param segmentSize Size of segment in bytes.
+	 * @param rotationPeriod Seconds after which segment is rotated, 0 to disable.
+	 * @param separateDays Rotate segment at 00:00:00 UTC+0.
+	 * @param retentionSegments Maximum number of segments of the prefix in directory, 0 for unlimited.
+	 * @param retentionAge Seconds after last modification when segment is removed, 0 for unlimited.
+	 * @param sync Synchronize not synchronized tail of segment with storage before it is retired.
+	 */
+	struct Settings {
+		size_t segmentSize{ 64 * 1024 * 1024 };
+		int64_t rotationPeriod{};
+		bool separateDays{};
+		size_t retentionSegments{};
+		int64_t retentionAge{};
+		bool sync{};
+	};
+
+private:
+	struct Segment {
+		int file{ -1 };
+		char* data{};
+		size_t capacity{};
+		size_t offset{};
+		size_t synced{};
+		int64_t rotateAt{};
+		std::string path;
+	};
+
+	std::string m_directory;
+	std::string m_prefix;
+	std::string m_extension;
+	int64_t m_session{};
+	Settings m_settings;
+	Segment* m_segment{};
+	std::atomic<uint32_t> m_nextIndex{};
+	std::atomic<Segment*> m_spare{};
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::vector<Segment*> m_retired;
+	std::string m_activePath;
+	bool m_isRunning{};
+	bool m_isRotated{};
+	std::thread m_maintainer;
+
+public:
+	/**************************
+	 * @brief Destroy the Log File object, call Stop() and Close() inside.
+	 */
+	~LogFile() noexcept;
+
+	/**************************
+	 * @brief Create the first segment and start background thread.
+	 *
+	 * @param directory Directory of segments ending with slash.
+	 * @param prefix Prefix of names of segments.
+	 * @param extension Extension of segments with dot.
+	 * @param settings Settings of segments.
+	 *
+	 * @return True if the first segment is created, false otherwise.
+	 */
+	[[nodiscard]] bool Open(const std::string& directory, const std::string& prefix, const std::string& extension,
+		const Settings& settings) noexcept;
+
+	/**************************
+	 * @return True if segment is open.
+	 */
+	[[nodiscard]] bool IsOpen() const noexcept;
+
+	/**************************
+	 * @brief Change settings, size is applied to next prepared segment and rotation time to next started segment.
+	 */
+	void SetSettings(const Settings& settings) noexcept;
+
+	/**************************
+	 * @brief Rotate segment if data does not fit into it or its rotation time has come.
+	 *
+	 * @param size Size of data to be written.
+	 *
+	 * @return True if new segment is started, false otherwise.
+	 */
+	bool Prepare(size_t size) noexcept;
+
+	/**************************
+	 * @return Free size of current segment, 0 if file is not open.
+	 */
+	[[nodiscard]] size_t GetFree() const noexcept;
+
+	/**************************
+	 * @brief Copy data to segment, data which does not fit is continued in next segment.
+	 */
+	void Write(std::string_view data) noexcept;
+
+	/**************************
+	 * @brief Synchronize written and not synchronized part of segment with storage.
+	 */
+	void Sync() noexcept;
+
+	/**************************
+	 * @brief Stop background thread and apply retention last time, pending segments are finished by Close().
+	 *
+	 * @attention Must not be called while logging can not proceed, removing of segments may log.
+	 */
+	void Stop() noexcept;
+
+	/**************************
+	 * @brief Finish all segments and remove not used prepared segment.
+	 */
+	void Close() noexcept;
+
+	/**************************
+	 * @return Path of current segment, empty if file is not open.
+	 */
+	[[nodiscard]] std::string_view GetPath() const noexcept;
+
+private:
+	/**************************
+	 * @brief Swap current segment with prepared one. Segment is never created in place, background thread is woken
+	 * to prepare it if it is not ready yet.
+	 *
+	 * @param wait True to wait for prepared segment for limited time.
+	 *
+	 * @return True if new segment is started, false otherwise.
+	 */
+	bool Rotate(bool wait) noexcept;
+
+	/**************************
+	 * @brief Create file of segment with next index, preallocate and map it.
+	 *
+	 * @param size Size of segment, rounded up to size of page.
+	 * @param populate True to prefault pages of segment.
+	 *
+	 * @return Created segment, nullptr if creation failed.
+	 */
+	Segment* Create(size_t size, bool populate) noexcept;
+
+	/**************************
+	 * @brief Truncate file of segment to written size, unmap and close it.
+	 *
+	 * @param remove True to remove file of segment.
+	 */
+	static void Finish(Segment* segment, bool remove) noexcept;
+
+	/**************************
+	 * @brief Remove segments named by pattern of the prefix which exceed retention, current and prepared segments are
+	 * kept and prepared segment is not counted.
+	 *
+	 * @param settings Settings with retention.
+	 */
+	void Retain(const Settings& settings);
+
+	/**************************
+	 * @brief Body of background thread.
+	 */
+	void Maintain() noexcept;
+
+	/**************************
+	 * @return Time of rotation in seconds since epoch of segment started now, 0 if rotation by time is disabled.
+	 *
+	 * @attention m_mutex must be locked.
+	 */
+	[[nodiscard]] int64_t GetRotationTime() const noexcept;
+};
+
+}; //* namespace MSAPI
+
+#endif //* MSAPI_LOG_FILE_H
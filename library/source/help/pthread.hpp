@@ -20,8 +20,11 @@
 #ifndef MSAPI_PTHREAD_H
 #define MSAPI_PTHREAD_H
 
+#include "lockProfiling.hpp"
 #include "log.h"
+#include <atomic>
 #include <sys/socket.h>
+#include <thread>
 
 namespace MSAPI {
 
@@ -37,6 +40,9 @@ template <typename T>
 struct NamedMutex {
 	T mutex;
 	const std::string name;
+#ifdef MSAPI_LOCK_PROFILING
+	Profiling::Site site;
+#endif
 
 	/**************************
 	 * @brief Construct a new Named Mutex object.
@@ -45,6 +51,9 @@ struct NamedMutex {
 	 */
 	FORCE_INLINE NamedMutex(std::string&& name) noexcept
 		: name{ std::move(name) }
+#ifdef MSAPI_LOCK_PROFILING
+		, site{ this->name.c_str() }
+#endif
 	{
 	}
 };
@@ -166,6 +175,15 @@ template <typename T> FORCE_INLINE bool PthreadMutexDestroy(NamedMutex<T>& named
  */
 FORCE_INLINE bool PthreadMutexLock(NamedMutex<pthread_mutex_t>& namedMutex) noexcept
 {
+	MSAPI_LOCK_PROFILING_BEGIN
+#ifdef MSAPI_LOCK_PROFILING
+	if (pthread_mutex_trylock(&namedMutex.mutex) == 0) {
+		MSAPI_LOCK_PROFILING_ACQUIRED(namedMutex.site, true)
+		return true;
+	}
+	MSAPI_LOCK_PROFILING_CONTENDED
+#endif
+
 	if (const auto ret{ pthread_mutex_lock(&namedMutex.mutex) }; ret != 0) {
 		switch (ret) {
 		case EINVAL:
@@ -188,6 +206,7 @@ FORCE_INLINE bool PthreadMutexLock(NamedMutex<pthread_mutex_t>& namedMutex) noex
 		}
 	}
 
+	MSAPI_LOCK_PROFILING_ACQUIRED(namedMutex.site, true)
 	return true;
 }
 
@@ -216,6 +235,7 @@ static_assert(!doLock, "Pthread doLock must be false");
 template <bool Wr, bool Try> FORCE_INLINE bool PthreadMutexRWLock(NamedMutex<pthread_rwlock_t>& namedMutex) noexcept
 {
 	int ret{ -1 };
+	MSAPI_LOCK_PROFILING_BEGIN
 
 	if constexpr (Try) {
 		if constexpr (Wr) {
@@ -226,17 +246,34 @@ template <bool Wr, bool Try> FORCE_INLINE bool PthreadMutexRWLock(NamedMutex<pth
 		}
 	}
 	else {
+#ifdef MSAPI_LOCK_PROFILING
 		if constexpr (Wr) {
-			ret = pthread_rwlock_wrlock(&namedMutex.mutex);
+			ret = pthread_rwlock_trywrlock(&namedMutex.mutex);
 		}
 		else {
-			ret = pthread_rwlock_rdlock(&namedMutex.mutex);
+			ret = pthread_rwlock_tryrdlock(&namedMutex.mutex);
+		}
+		if (ret == EBUSY) {
+			MSAPI_LOCK_PROFILING_CONTENDED
+			ret = -1;
+		}
+		if (ret == -1) {
+#endif
+			if constexpr (Wr) {
+				ret = pthread_rwlock_wrlock(&namedMutex.mutex);
+			}
+			else {
+				ret = pthread_rwlock_rdlock(&namedMutex.mutex);
+			}
+#ifdef MSAPI_LOCK_PROFILING
 		}
+#endif
 	}
 
 	if (ret != 0) {
 		switch (ret) {
 		case EBUSY: //* trywrlock and tryrdlock
+			MSAPI_LOCK_PROFILING_FAILED(namedMutex.site)
 			LOG_DEBUG("Pthread rwlock name \"" + namedMutex.name
 				+ "\": The read lock could not be acquired because a writer holds the lock, error EBUSY");
 			return false;
@@ -259,6 +296,7 @@ template <bool Wr, bool Try> FORCE_INLINE bool PthreadMutexRWLock(NamedMutex<pth
 		}
 	}
 
+	MSAPI_LOCK_PROFILING_ACQUIRED(namedMutex.site, Wr)
 	return true;
 }
 
@@ -273,6 +311,7 @@ template <bool Wr, bool Try> FORCE_INLINE bool PthreadMutexRWLock(NamedMutex<pth
  */
 template <typename T> FORCE_INLINE bool PthreadMutexUnlock(NamedMutex<T>& namedMutex) noexcept
 {
+	MSAPI_LOCK_PROFILING_RELEASED(namedMutex.site)
 	int ret{ -1 };
 	if constexpr (std::is_same_v<T, pthread_mutex_t>) {
 		ret = pthread_mutex_unlock(&namedMutex.mutex);
@@ -395,16 +434,37 @@ public:
 
 private:
 	std::atomic_flag m_lock{};
+	MSAPI_LOCK_PROFILING_SITE("AtomicLock")
 
 public:
+	/**************************
+	 * @brief Construct a new Atomic Lock object, profiled under common name if profiling is enabled.
+	 */
+	AtomicLock() noexcept = default;
+
+	/**************************
+	 * @brief Construct a new Atomic Lock object.
+	 *
+	 * @param name Name for profiling, nullptr to exclude lock from profiling. Is not used if profiling is disabled.
+	 */
+	FORCE_INLINE explicit AtomicLock([[maybe_unused]] const char* const name) noexcept
+#ifdef MSAPI_LOCK_PROFILING
+		: m_site{ name }
+#endif
+	{
+	}
+
 	/**************************
 	 * @brief Wait for lock is false and set it to true.
 	 */
 	FORCE_INLINE void Lock() noexcept
 	{
+		MSAPI_LOCK_PROFILING_BEGIN
 		while (m_lock.test_and_set(std::memory_order_acquire)) {
+			MSAPI_LOCK_PROFILING_CONTENDED
 			m_lock.wait(true, std::memory_order_relaxed);
 		}
+		MSAPI_LOCK_PROFILING_ACQUIRED(m_site, true)
 	}
 
 	/**************************
@@ -412,13 +472,24 @@ public:
 	 *
 	 * @return True if lock was false and now is true, false if lock was true.
 	 */
-	FORCE_INLINE bool TryLock() noexcept { return !m_lock.test_and_set(std::memory_order_acquire); }
+	FORCE_INLINE bool TryLock() noexcept
+	{
+		MSAPI_LOCK_PROFILING_BEGIN
+		if (m_lock.test_and_set(std::memory_order_acquire)) {
+			MSAPI_LOCK_PROFILING_FAILED(m_site)
+			return false;
+		}
+
+		MSAPI_LOCK_PROFILING_ACQUIRED(m_site, true)
+		return true;
+	}
 
 	/**************************
 	 * @brief Set lock to false and notify one thread.
 	 */
 	FORCE_INLINE void Unlock() noexcept
 	{
+		MSAPI_LOCK_PROFILING_RELEASED(m_site)
 		m_lock.clear(std::memory_order_release);
 		m_lock.notify_one();
 	}
@@ -476,19 +547,39 @@ public:
 
 private:
 	std::atomic<int> m_lock{};
-	AtomicLock m_writeLock;
+	AtomicLock m_writeLock{ nullptr };
+	MSAPI_LOCK_PROFILING_SITE("AtomicRWLock")
 
 public:
+	/**************************
+	 * @brief Construct a new Atomic RW Lock object, profiled under common name if profiling is enabled.
+	 */
+	AtomicRWLock() noexcept = default;
+
+	/**************************
+	 * @brief Construct a new Atomic RW Lock object.
+	 *
+	 * @param name Name for profiling, nullptr to exclude lock from profiling. Is not used if profiling is disabled.
+	 */
+	FORCE_INLINE explicit AtomicRWLock([[maybe_unused]] const char* const name) noexcept
+#ifdef MSAPI_LOCK_PROFILING
+		: m_site{ name }
+#endif
+	{
+	}
+
 	/**************************
 	 * @brief Lock for read, wait if write lock is not set.
 	 */
 	FORCE_INLINE void ReadLock() noexcept
 	{
+		MSAPI_LOCK_PROFILING_BEGIN
 		if (!m_writeLock.m_lock.test()) {
 			m_writeLock.m_lock.wait(true, std::memory_order_relaxed);
 		}
 
 		m_lock.fetch_add(1, std::memory_order_acquire);
+		MSAPI_LOCK_PROFILING_ACQUIRED(m_site, false)
 	}
 
 	/**************************
@@ -505,10 +596,16 @@ public:
 	 */
 	FORCE_INLINE void WriteLock() noexcept
 	{
-		m_writeLock.Lock();
+		MSAPI_LOCK_PROFILING_BEGIN
+		if (!m_writeLock.TryLock()) {
+			MSAPI_LOCK_PROFILING_CONTENDED
+			m_writeLock.Lock();
+		}
 		while (m_lock.load(std::memory_order_acquire) != 0) {
+			MSAPI_LOCK_PROFILING_CONTENDED
 			m_lock.wait(1, std::memory_order_relaxed);
 		}
+		MSAPI_LOCK_PROFILING_ACQUIRED(m_site, true)
 	}
 
 	/**************************
@@ -516,11 +613,166 @@ public:
 	 */
 	FORCE_INLINE void WriteUnlock() noexcept
 	{
+		MSAPI_LOCK_PROFILING_RELEASED(m_site)
 		m_writeLock.Unlock();
 		m_lock.notify_all();
 	}
 };
 
+/**************************
+ * @brief Scalable read/write lock with writer preference. Readers increment counter in one of cache line padded slots
+ * chosen by thread, so readers of different threads do not contend on one cache line. Writer sets writing flag, which
+ * turns new readers away, and waits for all slots to drain.
+ *
+ * @attention Read lock is not recursive, nested read lock of the same thread deadlocks when writer is waiting.
+ */
+class ScalableRWLock {
+public:
+	static constexpr size_t SLOTS_COUNT{ 16 };
+
+	/**************************
+	 * @brief Resource acquisition is initialization (RAII) Guard for locking and unlocking scalable read/write lock.
+	 *
+	 * @tparam Wr True for write lock, false for read lock.
+	 */
+	template <bool Wr> class ExitGuard {
+	private:
+		ScalableRWLock& m_scalableRWLock;
+
+	public:
+		/**************************
+		 * @brief Construct a new Exit Guard object, lock scalable read/write lock.
+		 *
+		 * @param scalableRWLock Scalable read/write lock.
+		 */
+		FORCE_INLINE ExitGuard(ScalableRWLock& scalableRWLock) noexcept
+			: m_scalableRWLock{ scalableRWLock }
+		{
+			if constexpr (Wr) {
+				m_scalableRWLock.WriteLock();
+			}
+			else {
+				m_scalableRWLock.ReadLock();
+			}
+		}
+
+		/**************************
+		 * @brief Destroy the Exit Guard object, unlock scalable read/write lock.
+		 */
+		FORCE_INLINE ~ExitGuard() noexcept
+		{
+			if constexpr (Wr) {
+				m_scalableRWLock.WriteUnlock();
+			}
+			else {
+				m_scalableRWLock.ReadUnlock();
+			}
+		}
+	};
+
+private:
+	/**************************
+	 * @brief Counter of readers of threads mapped to the slot.
+	 */
+	struct alignas(64) Slot {
+		std::atomic<uint32_t> readers{};
+	};
+
+	Slot m_slots[SLOTS_COUNT];
+	alignas(64) std::atomic<bool> m_isWriting{};
+	AtomicLock m_writeLock{ nullptr };
+	MSAPI_LOCK_PROFILING_SITE("ScalableRWLock")
+
+public:
+	/**************************
+	 * @brief Construct a new Scalable RW Lock object, profiled under common name if profiling is enabled.
+	 */
+	ScalableRWLock() noexcept = default;
+
+	/**************************
+	 * @brief Construct a new Scalable RW Lock object.
+	 *
+	 * @param name Name for profiling, nullptr to exclude lock from profiling. Is not used if profiling is disabled.
+	 */
+	FORCE_INLINE explicit ScalableRWLock([[maybe_unused]] const char* const name) noexcept
+#ifdef MSAPI_LOCK_PROFILING
+		: m_site{ name }
+#endif
+	{
+	}
+
+	/**************************
+	 * @brief Lock for read, back off and wait while writer holds or waits for the lock.
+	 */
+	FORCE_INLINE void ReadLock() noexcept
+	{
+		MSAPI_LOCK_PROFILING_BEGIN
+		auto& readers{ m_slots[GetSlotIndex()].readers };
+		while (true) {
+			// Increment must be visible before flag check, pairs with flag setting and slots checking of writer
+			readers.fetch_add(1, std::memory_order_seq_cst);
+			if (!m_isWriting.load(std::memory_order_seq_cst)) [[likely]] {
+				MSAPI_LOCK_PROFILING_ACQUIRED(m_site, false)
+				return;
+			}
+
+			MSAPI_LOCK_PROFILING_CONTENDED
+			readers.fetch_sub(1, std::memory_order_release);
+			m_isWriting.wait(true, std::memory_order_acquire);
+		}
+	}
+
+	/**************************
+	 * @brief Unlock for read.
+	 */
+	FORCE_INLINE void ReadUnlock() noexcept
+	{
+		m_slots[GetSlotIndex()].readers.fetch_sub(1, std::memory_order_release);
+	}
+
+	/**************************
+	 * @brief Lock for write, wait for other writer, turn new readers away and wait for all read locks to be released.
+	 */
+	FORCE_INLINE void WriteLock() noexcept
+	{
+		MSAPI_LOCK_PROFILING_BEGIN
+		if (!m_writeLock.TryLock()) {
+			MSAPI_LOCK_PROFILING_CONTENDED
+			m_writeLock.Lock();
+		}
+		m_isWriting.store(true, std::memory_order_seq_cst);
+		for (auto& slot : m_slots) {
+			while (slot.readers.load(std::memory_order_acquire) != 0) {
+				MSAPI_LOCK_PROFILING_CONTENDED
+				std::this_thread::yield();
+			}
+		}
+		MSAPI_LOCK_PROFILING_ACQUIRED(m_site, true)
+	}
+
+	/**************************
+	 * @brief Unlock for write, wake waiting readers.
+	 */
+	FORCE_INLINE void WriteUnlock() noexcept
+	{
+		MSAPI_LOCK_PROFILING_RELEASED(m_site)
+		m_isWriting.store(false, std::memory_order_release);
+		m_isWriting.notify_all();
+		m_writeLock.Unlock();
+	}
+
+private:
+	/**************************
+	 * @return Index of slot of current thread, threads are distributed over slots in order of first locking.
+	 */
+	FORCE_INLINE static size_t GetSlotIndex() noexcept
+	{
+		static std::atomic<size_t> next{};
+		thread_local const size_t index{ next.fetch_add(1, std::memory_order_relaxed) % SLOTS_COUNT };
+		return index;
+	}
+};
+
 }; //* namespace Pthread
 
 }; //* namespace MSAPI
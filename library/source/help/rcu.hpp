@@ -0,0 +1,333 @@
+/**************************
+ * @file        rcu.hpp
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ *
+ * @brief Read-copy-update with epoch based reclamation for read-mostly structures. Readers publish current epoch into
+ * their own cache line and never write shared state, writers copy value, publish new immutable snapshot and wait for
+ * grace period before previous snapshot is destroyed.
+ */
+
+#ifndef MSAPI_RCU_H
+#define MSAPI_RCU_H
+
+#include "pthread.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace MSAPI {
+
+namespace Rcu {
+
+/**************************
+ * @brief Global epoch and registry of reader slots. Slot is taken by thread on first read section and is returned on
+ * thread exit, slots are reused and never released, so their number is bounded by the peak number of reader threads.
+ */
+class Domain {
+private:
+	/**************************
+	 * @brief Reader slot, epoch is 0 outside of read section and epoch observed on entry inside.
+	 */
+	struct alignas(64) Slot {
+		std::atomic<uint64_t> epoch{};
+		std::atomic<bool> isUsed{};
+		Slot* next{};
+	};
+
+	/**************************
+	 * @brief Read section state of the thread.
+	 */
+	struct ThreadState {
+		Slot* slot{};
+		uint32_t nesting{};
+
+		/**************************
+		 * @brief Destroy the thread state object, return slot to the domain.
+		 */
+		FORCE_INLINE ~ThreadState() noexcept
+		{
+			if (slot != nullptr) {
+				slot->epoch.store(0, std::memory_order_release);
+				slot->isUsed.store(false, std::memory_order_release);
+			}
+		}
+	};
+
+	alignas(64) std::atomic<uint64_t> m_epoch{ 1 };
+	alignas(64) std::atomic<Slot*> m_slots{};
+
+public:
+	/**************************
+	 * @return Process wide domain.
+	 */
+	FORCE_INLINE static Domain& Get() noexcept
+	{
+		static Domain domain;
+		return domain;
+	}
+
+	/**************************
+	 * @brief Enter read section, nested sections are allowed.
+	 */
+	FORCE_INLINE static void ReadLock() noexcept
+	{
+		ThreadState& state{ GetThreadState() };
+		if (state.nesting++ != 0) {
+			return;
+		}
+
+		if (state.slot == nullptr) [[unlikely]] {
+			state.slot = Get().AcquireSlot();
+		}
+
+		state.slot->epoch.store(Get().m_epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+		// Publishing of epoch must be ordered before reading of protected pointers, pairs with fence of Synchronize
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+
+	/**************************
+	 * @brief Leave read section.
+	 */
+	FORCE_INLINE static void ReadUnlock() noexcept
+	{
+		ThreadState& state{ GetThreadState() };
+		if (--state.nesting == 0) {
+			state.slot->epoch.store(0, std::memory_order_release);
+		}
+	}
+
+	/**************************
+	 * @return True if current thread is inside read section.
+	 */
+	FORCE_INLINE [[nodiscard]] static bool IsReading() noexcept { return GetThreadState().nesting != 0; }
+
+	/**************************
+	 * @brief Wait for grace period, all read sections entered before the call are left on return.
+	 *
+	 * @attention Must not be called inside read section, it never ends otherwise.
+	 */
+	FORCE_INLINE void Synchronize() noexcept
+	{
+		const uint64_t target{ m_epoch.fetch_add(1, std::memory_order_acq_rel) + 1 };
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		for (const Slot* slot{ m_slots.load(std::memory_order_acquire) }; slot != nullptr; slot = slot->next) {
+			uint64_t epoch;
+			while ((epoch = slot->epoch.load(std::memory_order_acquire)) != 0 && epoch < target) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+private:
+	/**************************
+	 * @return Read section state of current thread.
+	 */
+	FORCE_INLINE static ThreadState& GetThreadState() noexcept
+	{
+		thread_local ThreadState state;
+		return state;
+	}
+
+	/**************************
+	 * @return Free slot or newly registered one.
+	 */
+	FORCE_INLINE [[nodiscard]] Slot* AcquireSlot()
+	{
+		for (Slot* slot{ m_slots.load(std::memory_order_acquire) }; slot != nullptr; slot = slot->next) {
+			bool expected{ false };
+			if (!slot->isUsed.load(std::memory_order_relaxed)
+				&& slot->isUsed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+
+				return slot;
+			}
+		}
+
+		auto* slot{ new Slot };
+		slot->isUsed.store(true, std::memory_order_relaxed);
+		slot->next = m_slots.load(std::memory_order_relaxed);
+		while (!m_slots.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed)) {
+		}
+		return slot;
+	}
+};
+
+/**************************
+ * @brief Value protected by read-copy-update. Readers access immutable snapshot without locking, writers are
+ * serialized, apply changes to the copy and publish it. Previous snapshot is destroyed after grace period.
+ *
+ * @attention Read guards must be short living, writers of any cell wait for them. Value must not be updated inside
+ * read section.
+ *
+ * @tparam T Type of value, must be copy constructible.
+ */
+template <typename T>
+	requires std::is_copy_constructible_v<T>
+class Cell {
+public:
+	/**************************
+	 * @brief Resource acquisition is initialization (RAII) Guard for read section, provides snapshot of the value.
+	 */
+	class ReadGuard {
+	private:
+		const T* m_value;
+
+	public:
+		/**************************
+		 * @brief Construct a new Read Guard object, enter read section and take current snapshot.
+		 *
+		 * @param cell Protected value.
+		 */
+		FORCE_INLINE explicit ReadGuard(const Cell& cell) noexcept
+		{
+			Domain::ReadLock();
+			m_value = cell.m_value.load(std::memory_order_acquire);
+		}
+
+		/**************************
+		 * @brief Destroy the Read Guard object, leave read section.
+		 */
+		FORCE_INLINE ~ReadGuard() noexcept { Domain::ReadUnlock(); }
+
+		ReadGuard(const ReadGuard& other) = delete;
+		ReadGuard(ReadGuard&& other) = delete;
+		ReadGuard& operator=(const ReadGuard& other) = delete;
+		ReadGuard& operator=(ReadGuard&& other) = delete;
+
+		/**************************
+		 * @return Snapshot of the value.
+		 */
+		FORCE_INLINE [[nodiscard]] const T& operator*() const noexcept { return *m_value; }
+
+		/**************************
+		 * @return Pointer to snapshot of the value.
+		 */
+		FORCE_INLINE [[nodiscard]] const T* operator->() const noexcept { return m_value; }
+	};
+
+private:
+	std::atomic<const T*> m_value;
+	Pthread::AtomicLock m_writeLock;
+
+public:
+	/**************************
+	 * @brief Construct a new Cell object.
+	 *
+	 * @param args Arguments of value constructor.
+	 */
+	template <typename... Args>
+	FORCE_INLINE explicit Cell(Args&&... args)
+		: m_value{ new T(std::forward<Args>(args)...) }
+	{
+	}
+
+	/**************************
+	 * @brief Destroy the Cell object, there must be no readers.
+	 */
+	FORCE_INLINE ~Cell() { delete m_value.load(std::memory_order_relaxed); }
+
+	Cell(const Cell& other) = delete;
+	Cell(Cell&& other) = delete;
+	Cell& operator=(const Cell& other) = delete;
+	Cell& operator=(Cell&& other) = delete;
+
+	/**************************
+	 * @brief Apply changes to the copy of value and publish it, wait for grace period and destroy previous snapshot.
+	 *
+	 * @attention Locks writers of the cell until publishing, grace period is waited without lock.
+	 *
+	 * @tparam Updater Callable with writable value argument, returns void or false if value is not changed and copy
+	 * should be dropped.
+	 *
+	 * @param updater Function to change the copy.
+	 *
+	 * @return True if new snapshot is published, false otherwise.
+	 */
+	template <typename Updater>
+		requires std::is_invocable_v<Updater, T&>
+	FORCE_INLINE bool Update(Updater&& updater)
+	{
+		const T* previous;
+		{
+			const Pthread::AtomicLock::ExitGuard _{ m_writeLock };
+			auto copy{ std::make_unique<T>(*m_value.load(std::memory_order_relaxed)) };
+			if constexpr (std::is_same_v<std::invoke_result_t<Updater, T&>, bool>) {
+				if (!updater(*copy)) {
+					return false;
+				}
+			}
+			else {
+				updater(*copy);
+			}
+
+			previous = m_value.exchange(copy.release(), std::memory_order_acq_rel);
+		}
+
+		Retire(previous);
+		return true;
+	}
+
+	/**************************
+	 * @brief Publish new value, wait for grace period and return previous one.
+	 *
+	 * @attention Locks writers of the cell until publishing, grace period is waited without lock.
+	 *
+	 * @param value New value.
+	 *
+	 * @return Previous value.
+	 */
+	FORCE_INLINE [[nodiscard]] T Replace(T&& value)
+	{
+		auto next{ std::make_unique<T>(std::move(value)) };
+		std::unique_ptr<const T> previous;
+		{
+			const Pthread::AtomicLock::ExitGuard _{ m_writeLock };
+			previous.reset(m_value.exchange(next.release(), std::memory_order_acq_rel));
+		}
+
+		if (Domain::IsReading()) [[unlikely]] {
+			LOG_ERROR("RCU value is replaced inside read section, previous value is copied");
+			return *previous.release();
+		}
+
+		Domain::Get().Synchronize();
+		return std::move(const_cast<T&>(*previous));
+	}
+
+private:
+	/**************************
+	 * @brief Wait for grace period and destroy previous snapshot.
+	 *
+	 * @param previous Previous snapshot.
+	 */
+	FORCE_INLINE static void Retire(const T* const previous)
+	{
+		if (Domain::IsReading()) [[unlikely]] {
+			LOG_ERROR("RCU value is updated inside read section, previous snapshot is leaked");
+			return;
+		}
+
+		Domain::Get().Synchronize();
+		delete previous;
+	}
+};
+
+}; //* namespace Rcu
+
+}; //* namespace MSAPI
+
+#endif //* MSAPI_RCU_H
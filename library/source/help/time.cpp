@@ -18,15 +18,220 @@
  */
 
 #include "log.h"
+#include <algorithm>
 #include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
 
 namespace MSAPI {
 
 #define HOW_MUCH_DAYS_PER_MONTH(_month, isLeap) dayPerMonth[_month] + static_cast<uint8_t>((_month) == 1 ? isLeap : 0)
 
+namespace {
+
+/**************************
+ * @brief Civil date, month and day start from 1.
+ */
+struct Civil {
+	int64_t year;
+	uint32_t month;
+	uint32_t day;
+};
+
+/**************************
+ * @brief Days from 1968-03-01 to 1970-01-01. Calculations are done in four years cycles starting from March 1 of leap
+ * year, so leap day is the last day of cycle.
+ */
+constexpr int64_t CYCLE_EPOCH_OFFSET{ 671 };
+constexpr int64_t DAYS_IN_CYCLE{ 1461 };
+
+/**************************
+ * @brief Branch-free conversion of days since epoch to civil date, every fourth year is leap as in the rest of Timer.
+ */
+constexpr Civil CivilFromDays(const int64_t days) noexcept
+{
+	const int64_t shifted{ days + CYCLE_EPOCH_OFFSET };
+	const int64_t cycle{ (shifted >= 0 ? shifted : shifted - DAYS_IN_CYCLE + 1) / DAYS_IN_CYCLE };
+	const int64_t dayOfCycle{ shifted - cycle * DAYS_IN_CYCLE };
+	const int64_t yearOfCycle{ (dayOfCycle - dayOfCycle / (DAYS_IN_CYCLE - 1)) / 365 };
+	const int64_t dayOfYear{ dayOfCycle - 365 * yearOfCycle };
+	//* Month from 0 for March to 11 for February
+	const int64_t shiftedMonth{ (5 * dayOfYear + 2) / 153 };
+	const auto day{ static_cast<uint32_t>(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1) };
+	const auto month{ static_cast<uint32_t>(shiftedMonth + 3 - 12 * static_cast<int64_t>(shiftedMonth >= 10)) };
+	return { 1968 + cycle * 4 + yearOfCycle + static_cast<int64_t>(month <= 2), month, day };
+}
+
+/**************************
+ * @brief Branch-free conversion of civil date to days since epoch, inverse of CivilFromDays().
+ */
+constexpr int64_t DaysFromCivil(const int64_t year, const uint32_t month, const uint32_t day) noexcept
+{
+	const int64_t shiftedYear{ year - 1968 - static_cast<int64_t>(month <= 2) };
+	const int64_t cycle{ (shiftedYear >= 0 ? shiftedYear : shiftedYear - 3) / 4 };
+	const int64_t shiftedMonth{ static_cast<int64_t>(month) + 9 - 12 * static_cast<int64_t>(month > 2) };
+	const int64_t dayOfYear{ (153 * shiftedMonth + 2) / 5 + static_cast<int64_t>(day) - 1 };
+	return cycle * DAYS_IN_CYCLE + (shiftedYear - cycle * 4) * 365 + dayOfYear - CYCLE_EPOCH_OFFSET;
+}
+
+static_assert(DaysFromCivil(1970, 1, 1) == 0);
+static_assert(DaysFromCivil(2024, 2, 29) == 19782);
+static_assert(CivilFromDays(19782).year == 2024 && CivilFromDays(19782).month == 2 && CivilFromDays(19782).day == 29);
+static_assert(CivilFromDays(-1).year == 1969 && CivilFromDays(-1).month == 12 && CivilFromDays(-1).day == 31);
+
+/**************************
+ * @brief Write number as fixed count of decimal digits.
+ */
+template <size_t Digits> FORCE_INLINE void WriteDigits(char* place, uint64_t value) noexcept
+{
+	for (size_t index{ Digits }; index > 0; --index) {
+		place[index - 1] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	}
+}
+
+/**************************
+ * @brief Formatted "YYYY-MM-DD HH:MM:SS." prefix of the last second formatted in thread.
+ */
+struct Prefix {
+	int64_t second{ INT64_MIN };
+	char data[20];
+};
+
+thread_local Prefix prefix;
+
+/**************************
+ * @brief Duration of first calibration of fast clock and period of its correction in nanoseconds.
+ */
+constexpr int64_t FAST_CLOCK_CALIBRATION{ 1000000 };
+constexpr int64_t FAST_CLOCK_CORRECTION_PERIOD{ 1000000000 };
+
+/**************************
+ * @brief Calibration of fast clock, written by one thread and read by seqlock. Nanoseconds per tick are measured
+ * from the first sample, so precision grows with uptime, and wall clock point is taken from the last sample.
+ */
+class Calibration {
+private:
+	struct Sample {
+		int64_t ticks;
+		int64_t monotonic;
+		int64_t realtime;
+	};
+
+	std::atomic<uint32_t> m_sequence{};
+	std::atomic<int64_t> m_ticks{};
+	std::atomic<int64_t> m_realtime{};
+	//* Nanoseconds per tick multiplied by 2^32
+	std::atomic<uint64_t> m_multiplier{ uint64_t{ 1 } << 32 };
+	Sample m_first{ Take() };
+	TimerWheel::Entry m_correction{ [this]() { Correct(); } };
+
+public:
+	/**************************
+	 * @brief Construct a new Calibration object, measure counter during first calibration and schedule corrections.
+	 */
+	Calibration()
+	{
+		if (FastClock::IsCounter()) {
+			while (GetMonotonic() - m_first.monotonic < FAST_CLOCK_CALIBRATION) {
+			}
+		}
+		Correct();
+		TimerWheel::Get().Schedule(m_correction, FAST_CLOCK_CORRECTION_PERIOD, FAST_CLOCK_CORRECTION_PERIOD);
+	}
+
+	/**************************
+	 * @return Process wide calibration, it is never destroyed as its correction stays scheduled.
+	 */
+	static Calibration& Get()
+	{
+		static Calibration* calibration{ new Calibration };
+		return *calibration;
+	}
+
+	/**************************
+	 * @return Nanoseconds of interval in ticks.
+	 */
+	FORCE_INLINE [[nodiscard]] int64_t ToNanoseconds(const int64_t ticks) const noexcept
+	{
+		const auto multiplier{ m_multiplier.load(std::memory_order_relaxed) };
+		return static_cast<int64_t>((static_cast<__int128>(ticks) * multiplier) >> 32);
+	}
+
+	/**************************
+	 * @return Nanoseconds since epoch of ticks.
+	 */
+	[[nodiscard]] int64_t ToRealtime(const int64_t ticks) const noexcept
+	{
+		uint32_t sequence;
+		int64_t base;
+		int64_t realtime;
+		uint64_t multiplier;
+		do {
+			sequence = m_sequence.load(std::memory_order_acquire);
+			base = m_ticks.load(std::memory_order_relaxed);
+			realtime = m_realtime.load(std::memory_order_relaxed);
+			multiplier = m_multiplier.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+		} while ((sequence & 1) != 0 || m_sequence.load(std::memory_order_relaxed) != sequence);
+
+		return realtime + static_cast<int64_t>((static_cast<__int128>(ticks - base) * multiplier) >> 32);
+	}
+
+private:
+	/**************************
+	 * @return Nanoseconds of CLOCK_MONOTONIC_RAW.
+	 */
+	static int64_t GetMonotonic() noexcept
+	{
+		timespec time;
+		(void)clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+		return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+	}
+
+	/**************************
+	 * @return Ticks and clocks read at the same moment, ticks are taken in the middle of reading clocks.
+	 */
+	static Sample Take() noexcept
+	{
+		const auto before{ FastClock::GetTicksOrdered() };
+		const auto monotonic{ GetMonotonic() };
+		timespec time;
+		(void)clock_gettime(CLOCK_REALTIME, &time);
+		const auto after{ FastClock::GetTicksOrdered() };
+		return { before + (after - before) / 2, monotonic,
+			static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec };
+	}
+
+	/**************************
+	 * @brief Measure nanoseconds per tick since the first sample and take point of wall clock.
+	 */
+	void Correct() noexcept
+	{
+		const auto sample{ Take() };
+		auto multiplier{ m_multiplier.load(std::memory_order_relaxed) };
+		if (FastClock::IsCounter() && sample.ticks > m_first.ticks) {
+			multiplier = static_cast<uint64_t>(
+				(static_cast<unsigned __int128>(sample.monotonic - m_first.monotonic) << 32)
+				/ static_cast<uint64_t>(sample.ticks - m_first.ticks));
+		}
+
+		const auto sequence{ m_sequence.load(std::memory_order_relaxed) };
+		m_sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_ticks.store(sample.ticks, std::memory_order_relaxed);
+		m_realtime.store(sample.realtime, std::memory_order_relaxed);
+		m_multiplier.store(multiplier, std::memory_order_relaxed);
+		m_sequence.store(sequence + 2, std::memory_order_release);
+	}
+};
+
+} // namespace
+
 /*---------------------------------------------------------------------------------
 Event
 ---------------------------------------------------------------------------------*/
@@ -39,24 +244,7 @@ Timer::Event::Event(std::function<void(int*)> callback, int* data)
 	}
 
 	m_callback = std::move(callback);
-	std::get<2>(m_data) = data;
-
-	m_sev.sigev_notify = SIGEV_THREAD;
-	m_sev.sigev_notify_function = [](sigval_t v) {
-		(*static_cast<std::function<void(int*)>*>(std::get<0>(*static_cast<std::tuple<void*, int*, int*>*>(
-			v.sival_ptr))))(std::get<2>(*((static_cast<std::tuple<void*, int*, int*>*>(v.sival_ptr)))));
-
-		Timer::Event* event{ reinterpret_cast<Timer::Event*>(
-			std::get<1>(*((static_cast<std::tuple<void*, int*, int*>*>(v.sival_ptr))))) };
-		if (!event->IsRepeat()) {
-			event->Stop();
-		}
-	};
-
-	std::get<0>(m_data) = &m_callback;
-	std::get<1>(m_data) = reinterpret_cast<int*>(this);
-
-	m_sev.sigev_value.sival_ptr = static_cast<void*>(&m_data);
+	m_data = data;
 }
 
 Timer::Event::Event(Timer::Event::IHandler* handler)
@@ -64,19 +252,7 @@ Timer::Event::Event(Timer::Event::IHandler* handler)
 {
 	if (m_handler == nullptr) {
 		LOG_ERROR("Interrupted timer event creation due to handler is nullptr, id: " + _S(m_uid));
-		return;
 	}
-
-	m_sev.sigev_notify = SIGEV_THREAD;
-	m_sev.sigev_notify_function = [](sigval_t v) {
-		Timer::Event* event{ reinterpret_cast<Timer::Event*>(v.sival_ptr) };
-		event->m_handler->HandleEvent(*event);
-		if (!event->IsRepeat()) {
-			event->Stop();
-		}
-	};
-
-	m_sev.sigev_value.sival_ptr = this;
 }
 
 Timer::Event::~Event()
@@ -88,81 +264,41 @@ Timer::Event::~Event()
 
 int64_t Timer::Event::GetId() const { return m_uid; }
 
-#define TMP_MSAPI_TIMER_EVENT_STOP(ret)                                                                                \
-	LOG_DEBUG("Stop timer event, id: " + _S(m_uid));                                                                   \
-                                                                                                                       \
-	if (timer_delete(m_id) != 0) {                                                                                     \
-		LOG_ERROR("timer_delete, id " + _S(m_uid) + ". Error №" + _S(errno) + ": " + std::strerror(errno));            \
-		return ret;                                                                                                    \
-	}                                                                                                                  \
-	m_running = false;
-
 bool Timer::Event::Start(const time_t timeToCall, const time_t timeToRepeatCall, const bool instantCall)
 {
-	if (std::get<2>(m_data) != nullptr) {
-
-#define TMP_MSAPI_TIMER_EVENT_START_BEGIN                                                                              \
-	if (m_running) {                                                                                                   \
-		TMP_MSAPI_TIMER_EVENT_STOP(false);                                                                             \
-	}                                                                                                                  \
-                                                                                                                       \
-	m_timeToCall = timeToCall;                                                                                         \
-	m_timeToRepeatCall = timeToRepeatCall;                                                                             \
-	m_instantCall = instantCall;                                                                                       \
-                                                                                                                       \
-	/* First call */                                                                                                   \
-	timespec t1;                                                                                                       \
-	t1.tv_sec = m_timeToCall;                                                                                          \
-	t1.tv_nsec = 0;                                                                                                    \
-	m_its.it_value = t1;                                                                                               \
-                                                                                                                       \
-	/* Repeat calls */                                                                                                 \
-	timespec t2;                                                                                                       \
-	t2.tv_sec = m_timeToRepeatCall;                                                                                    \
-	t2.tv_nsec = 0;                                                                                                    \
-	m_its.it_interval = t2;
-
-		TMP_MSAPI_TIMER_EVENT_START_BEGIN;
-
-		if (m_instantCall) {
-			m_callback(std::get<2>(m_data));
-		}
-
-#define TMP_MSAPI_TIMER_EVENT_START_END                                                                                \
-	int res{ timer_create(CLOCK_REALTIME, &m_sev, &m_id) };                                                            \
-	if (res != 0) {                                                                                                    \
-		LOG_ERROR("timer_create, id: " + _S(m_uid) + ". Error №" + _S(errno) + ": " + std::strerror(errno));           \
-		return false;                                                                                                  \
-	}                                                                                                                  \
-                                                                                                                       \
-	res = timer_settime(m_id, 0, &m_its, nullptr);                                                                     \
-	if (res != 0) {                                                                                                    \
-		LOG_ERROR("timer_settime, id: " + _S(m_uid) + ". Error №" + _S(errno) + ": " + std::strerror(errno));          \
-		return false;                                                                                                  \
-	}                                                                                                                  \
-                                                                                                                       \
-	LOG_DEBUG("Start timer event, id: " + _S(m_uid) + ", time to call: " + _S(UINT64(m_timeToCall))                    \
-		+ ", repeat: " + _S(m_timeToRepeatCall != 0) + ", time to repeat call: " + _S(UINT64(m_timeToRepeatCall))      \
-		+ ", instant call: " + _S(m_instantCall));                                                                     \
-                                                                                                                       \
-	m_running = true;                                                                                                  \
-	return true;
+	return Start(Duration::CreateSeconds(timeToCall), Duration::CreateSeconds(timeToRepeatCall), instantCall);
+}
 
-		TMP_MSAPI_TIMER_EVENT_START_END;
+bool Timer::Event::Start(const Duration timeToCall, const Duration timeToRepeatCall, const bool instantCall)
+{
+	if (m_data == nullptr && m_handler == nullptr) {
+		LOG_ERROR("Timer event starting is interrupted as it is created with error, id: " + _S(m_uid));
+		return false;
 	}
 
-	if (m_handler != nullptr) {
-		TMP_MSAPI_TIMER_EVENT_START_BEGIN;
+	Stop();
+
+	m_timeToCall = timeToCall.GetNanoseconds();
+	m_timeToRepeatCall = std::max(timeToRepeatCall.GetNanoseconds(), int64_t{ 0 });
+	m_instantCall = instantCall;
 
-		if (m_instantCall) {
+	if (m_instantCall) {
+		if (m_handler != nullptr) {
 			m_handler->HandleEvent(*this);
 		}
-
-		TMP_MSAPI_TIMER_EVENT_START_END;
+		else {
+			m_callback(m_data);
+		}
 	}
 
-	LOG_ERROR("Timer event starting is interrupted as it is created with error, id: " + _S(m_uid));
-	return false;
+	m_running = true;
+	TimerWheel::Get().Schedule(m_entry, m_timeToCall, m_timeToRepeatCall);
+
+	LOG_DEBUG("Start timer event, id: " + _S(m_uid) + ", time to call: " + timeToCall.ToString()
+		+ ", repeat: " + _S(m_timeToRepeatCall != 0) + ", time to repeat call: " + timeToRepeatCall.ToString()
+		+ ", instant call: " + _S(m_instantCall));
+
+	return true;
 }
 
 void Timer::Event::Stop()
@@ -171,17 +307,31 @@ void Timer::Event::Stop()
 		return;
 	}
 
-	TMP_MSAPI_TIMER_EVENT_STOP();
+	LOG_DEBUG("Stop timer event, id: " + _S(m_uid));
+	(void)TimerWheel::Get().Cancel(m_entry);
+	m_running = false;
 }
 
-#undef TMP_MSAPI_TIMER_EVENT_STOP
-
 bool Timer::Event::IsRunning() const { return m_running; }
 
 bool Timer::Event::IsRepeat() const { return m_timeToRepeatCall != 0; }
 
 bool Timer::Event::IsInstantCall() const { return m_instantCall; }
 
+void Timer::Event::Call()
+{
+	if (m_handler != nullptr) {
+		m_handler->HandleEvent(*this);
+	}
+	else {
+		m_callback(m_data);
+	}
+
+	if (!IsRepeat() && !TimerWheel::Get().IsScheduled(m_entry)) {
+		m_running = false;
+	}
+}
+
 /*---------------------------------------------------------------------------------
 Duration
 ---------------------------------------------------------------------------------*/
@@ -231,17 +381,17 @@ std::string Timer::Duration::ToString(const Timer::Duration::Type type) const
 	case Timer::Duration::Type::Nanoseconds:
 		return std::to_string(m_nanoseconds) + " nanoseconds";
 	case Timer::Duration::Type::Microseconds:
-		return std::format("{} microseconds", _S(static_cast<double>(m_nanoseconds) / 1000));
+		return _S(static_cast<double>(m_nanoseconds) / 1000) + " microseconds";
 	case Timer::Duration::Type::Milliseconds:
-		return std::format("{} milliseconds", _S(static_cast<double>(m_nanoseconds) / 1000000));
+		return _S(static_cast<double>(m_nanoseconds) / 1000000) + " milliseconds";
 	case Timer::Duration::Type::Seconds:
-		return std::format("{} seconds", _S(static_cast<double>(m_nanoseconds) / 1000000000));
+		return _S(static_cast<double>(m_nanoseconds) / 1000000000) + " seconds";
 	case Timer::Duration::Type::Minutes:
-		return std::format("{} minutes", _S(static_cast<double>(m_nanoseconds) / 60000000000));
+		return _S(static_cast<double>(m_nanoseconds) / 60000000000) + " minutes";
 	case Timer::Duration::Type::Hours:
-		return std::format("{} hours", _S(static_cast<double>(m_nanoseconds) / 3600000000000));
+		return _S(static_cast<double>(m_nanoseconds) / 3600000000000) + " hours";
 	case Timer::Duration::Type::Days:
-		return std::format("{} days", _S(static_cast<double>(m_nanoseconds) / 86400000000000));
+		return _S(static_cast<double>(m_nanoseconds) / 86400000000000) + " days";
 	case Timer::Duration::Type::Max:
 		LOG_ERROR("Max duration type, return nanoseconds");
 		return std::to_string(m_nanoseconds) + " nanoseconds";
@@ -354,7 +504,14 @@ Timer::Date::Date(const uint16_t year, const uint8_t month, const uint8_t day)
 {
 }
 
-std::string Timer::Date::ToString() const { return std::format("{:04}-{:02}-{:02}", year, month, day); }
+std::string Timer::Date::ToString() const
+{
+	std::string result(10, '-');
+	WriteDigits<4>(result.data(), year);
+	WriteDigits<2>(result.data() + 5, month);
+	WriteDigits<2>(result.data() + 8, day);
+	return result;
+}
 
 Timer::Date::operator std::string() { return ToString(); }
 
@@ -421,43 +578,42 @@ std::chrono::time_point<std::chrono::high_resolution_clock> Timer::GetPoint() co
 
 std::string Timer::ToString() const
 {
-	int64_t timestamp{ std::chrono::time_point_cast<std::chrono::seconds>(m_point).time_since_epoch().count() };
-	auto year{ static_cast<uint16_t>(timestamp / SECONDS_IN_YEAR) };
-	timestamp -= INT64(year) * SECONDS_IN_YEAR;
-	auto day{ static_cast<uint16_t>(timestamp / SECONDS_IN_DAY) };
-	timestamp -= INT64(day) * SECONDS_IN_DAY;
-
-	bool isLeap{ (1970 + year) % 4 == 0 };
-	auto extraDays{ static_cast<uint16_t>(isLeap ? (year + 2) / 4 - 1 : (year + 2) / 4) };
-	if (extraDays > day) {
-		--year;
-		isLeap = (1970 + year) % 4 == 0;
-		day = static_cast<uint16_t>(day + 365 + static_cast<int32_t>(isLeap) - extraDays);
-	}
-	else {
-		day -= extraDays;
-	}
-
-	auto hour{ static_cast<uint8_t>(timestamp / SECONDS_IN_HOUR) };
-	timestamp -= SECONDS_IN_HOUR * hour;
-	auto minute{ static_cast<uint8_t>(timestamp / SECONDS_IN_MINUTE) };
-	auto second{ static_cast<uint8_t>(timestamp - static_cast<uint16_t>(minute) * SECONDS_IN_MINUTE) };
+	std::string result;
+	AppendString(result, GetNanoseconds());
+	return result;
+}
 
-	uint8_t month{ 0 };
-	for (uint8_t index{ 0 }; index < 12; ++index) {
-		if (const auto daysPerMonth{ static_cast<uint16_t>(HOW_MUCH_DAYS_PER_MONTH(index, isLeap)) };
-			day >= daysPerMonth) {
+void Timer::AppendString(std::string& out, const int64_t nanoseconds)
+{
+	int64_t second{ nanoseconds / 1000000000 };
+	int64_t nanosecond{ nanoseconds % 1000000000 };
+	if (nanosecond < 0) {
+		nanosecond += 1000000000;
+		--second;
+	}
 
-			++month;
-			day -= daysPerMonth;
-		}
-		else {
-			break;
+	if (prefix.second != second) [[unlikely]] {
+		int64_t day{ second / SECONDS_IN_DAY };
+		int64_t secondOfDay{ second % SECONDS_IN_DAY };
+		if (secondOfDay < 0) {
+			secondOfDay += SECONDS_IN_DAY;
+			--day;
 		}
+		const auto civil{ CivilFromDays(day) };
+		std::memcpy(prefix.data, "0000-00-00 00:00:00.", sizeof(prefix.data));
+		WriteDigits<4>(prefix.data, static_cast<uint64_t>(civil.year));
+		WriteDigits<2>(prefix.data + 5, civil.month);
+		WriteDigits<2>(prefix.data + 8, civil.day);
+		WriteDigits<2>(prefix.data + 11, static_cast<uint64_t>(secondOfDay / SECONDS_IN_HOUR));
+		WriteDigits<2>(prefix.data + 14, static_cast<uint64_t>(secondOfDay % SECONDS_IN_HOUR / SECONDS_IN_MINUTE));
+		WriteDigits<2>(prefix.data + 17, static_cast<uint64_t>(secondOfDay % SECONDS_IN_MINUTE));
+		prefix.second = second;
 	}
 
-	return std::format("{:04}-{:02}-{:02} {:02}:{:02}:{:02}.{:09}", year + 1970, ++month, ++day, hour, minute, second,
-		std::chrono::time_point_cast<std::chrono::nanoseconds>(m_point).time_since_epoch().count() % 1000000000);
+	const auto offset{ out.size() };
+	out.resize(offset + sizeof(prefix.data) + 9);
+	std::memcpy(out.data() + offset, prefix.data, sizeof(prefix.data));
+	WriteDigits<9>(out.data() + offset + sizeof(prefix.data), static_cast<uint64_t>(nanosecond));
 }
 
 int64_t Timer::GetSeconds() const
@@ -512,36 +668,9 @@ Timer operator-(const Timer timer, const Timer::Duration duration)
 
 Timer::Date Timer::ToDate() const
 {
-	int64_t timestamp{ std::chrono::time_point_cast<std::chrono::seconds>(m_point).time_since_epoch().count() };
-	auto year{ static_cast<uint16_t>(timestamp / SECONDS_IN_YEAR) };
-	timestamp -= INT64(year) * SECONDS_IN_YEAR;
-	auto day{ static_cast<uint16_t>(timestamp / SECONDS_IN_DAY) };
-
-	bool isLeap{ (1970 + year) % 4 == 0 };
-	auto extraDays{ static_cast<uint16_t>(isLeap ? (year + 2) / 4 - 1 : (year + 2) / 4) };
-	if (extraDays > day) {
-		--year;
-		isLeap = (1970 + year) % 4 == 0;
-		day = static_cast<uint16_t>(day + 365 + static_cast<int32_t>(isLeap) - extraDays);
-	}
-	else {
-		day -= extraDays;
-	}
-
-	uint8_t month{ 0 };
-	for (uint8_t index{ 0 }; index < 12; ++index) {
-		if (const auto daysPerMonth{ static_cast<uint16_t>(HOW_MUCH_DAYS_PER_MONTH(index, isLeap)) };
-			day >= daysPerMonth) {
-
-			++month;
-			day -= daysPerMonth;
-		}
-		else {
-			break;
-		}
-	}
-
-	return { static_cast<uint16_t>(year + 1970), ++month, static_cast<uint8_t>(++day) };
+	const int64_t second{ GetSeconds() };
+	const auto civil{ CivilFromDays(second / SECONDS_IN_DAY - static_cast<int64_t>(second % SECONDS_IN_DAY < 0)) };
+	return { static_cast<uint16_t>(civil.year), static_cast<uint8_t>(civil.month), static_cast<uint8_t>(civil.day) };
 }
 
 uint8_t Timer::HowMuchDaysInMonth(const uint8_t month, const bool isLeap)
@@ -567,8 +696,8 @@ uint16_t Timer::HowMuchDaysFromStartOfYearTillMonth(const uint8_t month, const b
 	return sum;
 }
 
-Timer Timer::Create(uint16_t year, const uint8_t month, const uint8_t day, const uint8_t hour, const uint8_t minute,
-	const uint8_t second, const uint32_t nanosecond)
+Timer Timer::Create(const uint16_t year, const uint8_t month, const uint8_t day, const uint8_t hour,
+	const uint8_t minute, const uint8_t second, const uint32_t nanosecond)
 {
 	if (year < 1970 || month == 0 || month > 12 || day == 0 || day > HowMuchDaysInMonth(month, year) || hour > 23
 		|| minute > 60 || second > 59 || nanosecond > 999999999) {
@@ -578,14 +707,8 @@ Timer Timer::Create(uint16_t year, const uint8_t month, const uint8_t day, const
 		return Timer{ 0 };
 	}
 
-	year -= 1970;
-	const bool isLeap{ (year + 2) % 4 == 0 };
-	return { INT64(year) * SECONDS_IN_YEAR
-			+ INT64((day - 1 /* first day is 0 days left from start of new month */
-				  + HowMuchDaysFromStartOfYearTillMonth(month, isLeap)
-				  + (isLeap ? (year + 2) / 4 - 1 : (year + 2) / 4)))
-				* SECONDS_IN_DAY
-			+ INT64(hour) * SECONDS_IN_HOUR + INT64(minute) * SECONDS_IN_MINUTE + INT64(second),
+	return { DaysFromCivil(year, month, day) * SECONDS_IN_DAY + INT64(hour) * SECONDS_IN_HOUR
+			+ INT64(minute) * SECONDS_IN_MINUTE + INT64(second),
 		nanosecond };
 }
 
@@ -653,6 +776,42 @@ uint64_t Timer::GetNanosecondsToTomorrow()
 	return NANOSECONDS_IN_DAY + UINT64(Timer::GetToday().GetNanoseconds()) - UINT64(Timer{}.GetNanoseconds());
 }
 
+/*---------------------------------------------------------------------------------
+FastClock
+---------------------------------------------------------------------------------*/
+
+int64_t FastClock::ToNanoseconds(const int64_t ticks) noexcept { return Calibration::Get().ToNanoseconds(ticks); }
+
+Timer::Duration FastClock::ToDuration(const int64_t ticks) noexcept
+{
+	return Timer::Duration{ Calibration::Get().ToNanoseconds(ticks) };
+}
+
+Timer FastClock::ToTimer(const int64_t ticks) noexcept
+{
+	const auto nanoseconds{ Calibration::Get().ToRealtime(ticks) };
+	return Timer{ nanoseconds / 1000000000, nanoseconds % 1000000000 };
+}
+
+int64_t FastClock::GetElapsed(const int64_t ticks) noexcept
+{
+	return Calibration::Get().ToNanoseconds(GetTicksOrdered() - ticks);
+}
+
+bool FastClock::IsCounterInvariant() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+	uint32_t eax;
+	uint32_t ebx;
+	uint32_t ecx;
+	uint32_t edx;
+	//* Leaf of advanced power management, bit 8 of EDX is invariant time stamp counter
+	return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) != 0 && (edx & (1 << 8)) != 0;
+#else
+	return false;
+#endif
+}
+
 #undef HOW_MUCH_DAYS_PER_MONTH
 
 }; //* namespace MSAPI
\ No newline at end of file
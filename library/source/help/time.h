@@ -26,13 +26,16 @@
 #define FORCE_INLINE inline
 #endif
 
+#include "timerWheel.h"
 #include <atomic>
 #include <chrono>
 #include <ctime>
 #include <functional>
-#include <signal.h>
 #include <string>
 #include <sys/time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 namespace MSAPI {
 
@@ -59,9 +62,11 @@ constexpr uint8_t SECONDS_IN_MINUTE = 60;
  */
 class Timer {
 public:
+	class Duration;
+
 	/**************************
 	 * @brief Class for planning a function call in future by timer. Callback and data or only handler can be provided
-	 * in constructor.
+	 * in constructor. Events are called on thread of process wide timer wheel by monotonic clock.
 	 *
 	 * @test Has unit test.
 	 */
@@ -76,17 +81,13 @@ public:
 
 	private:
 		std::function<void(int*)> m_callback;
-		IHandler* m_handler;
-		timer_t m_id{};
-		//* Callback, this, parameter
-		std::tuple<void*, int*, int*> m_data;
-		bool m_running{};
-		time_t m_timeToCall{};
-		time_t m_timeToRepeatCall{};
-		bool m_repeat{};
+		IHandler* m_handler{};
+		int* m_data{};
+		std::atomic<bool> m_running{};
+		int64_t m_timeToCall{};
+		int64_t m_timeToRepeatCall{};
 		bool m_instantCall{};
-		sigevent m_sev{ 0, 0, 0, 0 };
-		itimerspec m_its;
+		TimerWheel::Entry m_entry{ [this]() { Call(); } };
 		int64_t m_uid{ m_eventsCounter.fetch_add(1, std::memory_order_relaxed) };
 
 		static inline std::atomic<int64_t> m_eventsCounter{};
@@ -118,10 +119,10 @@ public:
 		int64_t GetId() const;
 
 		/**************************
-		 * @brief Start event.
+		 * @brief Start event, call Start() with durations inside.
 		 *
-		 * @param timeToCall Time to call function in UTC+0.
-		 * @param timeToRepeatCall Time to repeat call function.
+		 * @param timeToCall Seconds to first call.
+		 * @param timeToRepeatCall Seconds between repeated calls, 0 for single call.
 		 * @param instantCall Call function immediately after start.
 		 *
 		 * @return True if event started, false if event was not started or data is nullptr.
@@ -129,9 +130,20 @@ public:
 		bool Start(time_t timeToCall, time_t timeToRepeatCall = 0, bool instantCall = false);
 
 		/**************************
-		 * @brief Stop event if it's running.
+		 * @brief Start event, running event is restarted.
+		 *
+		 * @param timeToCall Time to first call.
+		 * @param timeToRepeatCall Time between repeated calls, empty for single call.
+		 * @param instantCall Call function immediately after start on current thread.
+		 *
+		 * @return True if event started, false if event was not started or data is nullptr.
 		 *
-		 * @note Save event state as active if delete event function was failed.
+		 * @test Has unit test.
+		 */
+		bool Start(Duration timeToCall, Duration timeToRepeatCall = Duration{}, bool instantCall = false);
+
+		/**************************
+		 * @brief Stop event if it's running, wait for finish of call on other thread.
 		 */
 		void Stop();
 
@@ -149,6 +161,12 @@ public:
 		 * @return Event instant call state.
 		 */
 		bool IsInstantCall() const;
+
+	private:
+		/**************************
+		 * @brief Call callback or handler, single call event is stopped after call if it is not restarted.
+		 */
+		void Call();
 	};
 
 	/**************************
@@ -581,6 +599,17 @@ public:
 	 */
 	std::string ToString() const;
 
+	/**************************
+	 * @brief Append timestamp in ToString() format. Formatted date and time of the last second are cached in thread, so
+	 * only nanoseconds are formatted for timestamps within the same second.
+	 *
+	 * @param out String to append to.
+	 * @param nanoseconds Nanoseconds since epoch.
+	 *
+	 * @test Has unit test.
+	 */
+	static void AppendString(std::string& out, int64_t nanoseconds);
+
 	/**************************
 	 * @brief Call ToString() inside.
 	 */
@@ -804,6 +833,97 @@ public:
 	static std::chrono::microseconds TimevalToDuration(timeval tv);
 };
 
+/**************************
+ * @brief Clock by time stamp counter of processor for measuring intervals in few nanoseconds. Ticks are converted to
+ * nanoseconds, Timer::Duration and Timer only on demand. Counter is calibrated against CLOCK_MONOTONIC_RAW during one
+ * millisecond on first conversion, after that calibration and point of wall clock are corrected each second on thread
+ * of timer wheel. If processor is not x86 or its counter is not invariant, ticks are nanoseconds of CLOCK_MONOTONIC_RAW.
+ *
+ * @note Ticks are comparable within one process only.
+ *
+ * @test Has unit test.
+ */
+class FastClock {
+public:
+	/**************************
+	 * @return Current ticks.
+	 */
+	FORCE_INLINE [[nodiscard]] static int64_t GetTicks() noexcept
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		if (IsCounter()) [[likely]] {
+			return static_cast<int64_t>(__rdtsc());
+		}
+#endif
+		return GetRawNanoseconds();
+	}
+
+	/**************************
+	 * @return Current ticks read after all previous instructions are executed, for end of measured interval.
+	 */
+	FORCE_INLINE [[nodiscard]] static int64_t GetTicksOrdered() noexcept
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		if (IsCounter()) [[likely]] {
+			uint32_t processor;
+			return static_cast<int64_t>(__rdtscp(&processor));
+		}
+#endif
+		return GetRawNanoseconds();
+	}
+
+	/**************************
+	 * @return True if ticks are invariant time stamp counter, false if they are nanoseconds of CLOCK_MONOTONIC_RAW.
+	 */
+	FORCE_INLINE [[nodiscard]] static bool IsCounter() noexcept
+	{
+		static const bool isCounter{ IsCounterInvariant() };
+		return isCounter;
+	}
+
+	/**************************
+	 * @return Nanoseconds of interval in ticks.
+	 *
+	 * @test Has unit test.
+	 */
+	[[nodiscard]] static int64_t ToNanoseconds(int64_t ticks) noexcept;
+
+	/**************************
+	 * @return Duration of interval in ticks.
+	 *
+	 * @test Has unit test.
+	 */
+	[[nodiscard]] static Timer::Duration ToDuration(int64_t ticks) noexcept;
+
+	/**************************
+	 * @return Wall clock time of ticks.
+	 *
+	 * @test Has unit test.
+	 */
+	[[nodiscard]] static Timer ToTimer(int64_t ticks) noexcept;
+
+	/**************************
+	 * @return Nanoseconds elapsed since ticks.
+	 */
+	[[nodiscard]] static int64_t GetElapsed(int64_t ticks) noexcept;
+
+private:
+	/**************************
+	 * @return Nanoseconds of CLOCK_MONOTONIC_RAW.
+	 */
+	FORCE_INLINE [[nodiscard]] static int64_t GetRawNanoseconds() noexcept
+	{
+		timespec time;
+		(void)clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+		return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+	}
+
+	/**************************
+	 * @return True if processor has invariant time stamp counter.
+	 */
+	[[nodiscard]] static bool IsCounterInvariant() noexcept;
+};
+
 } //* namespace MSAPI
 
 namespace std {
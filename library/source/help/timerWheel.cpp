@@ -0,0 +1,304 @@
+/**************************
+ * @file        timerWheel.cpp
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#include "timerWheel.h"
+#include "log.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <ctime>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace MSAPI {
+
+/*---------------------------------------------------------------------------------
+Entry
+---------------------------------------------------------------------------------*/
+
+TimerWheel::Entry::Entry(std::function<void()> callback)
+	: m_callback{ std::move(callback) }
+{
+}
+
+/*---------------------------------------------------------------------------------
+TimerWheel
+---------------------------------------------------------------------------------*/
+
+TimerWheel::TimerWheel()
+	: m_tick{ static_cast<uint64_t>(Now()) >> TICK_BITS }
+{
+	m_file = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+	if (m_file == -1) {
+		LOG_ERROR("timerfd_create. Error №" + _S(errno) + ": " + std::strerror(errno));
+		m_isRunning = false;
+		return;
+	}
+
+	m_thread = std::thread{ &TimerWheel::Run, this };
+}
+
+TimerWheel::~TimerWheel()
+{
+	if (m_thread.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			m_isRunning = false;
+			//* Absolute time in the past expires immediately
+			const itimerspec its{ {}, { 0, 1 } };
+			(void)timerfd_settime(m_file, TFD_TIMER_ABSTIME, &its, nullptr);
+		}
+		m_thread.join();
+	}
+
+	if (m_file != -1) {
+		(void)close(m_file);
+	}
+}
+
+TimerWheel& TimerWheel::Get()
+{
+	static TimerWheel* wheel{ new TimerWheel };
+	return *wheel;
+}
+
+void TimerWheel::Schedule(Entry& entry, const int64_t delay, const int64_t period)
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+	if (entry.m_link != nullptr) {
+		Unlink(entry);
+	}
+	else {
+		++m_size;
+	}
+
+	const auto now{ Now() };
+	constexpr auto maxDeadline{ INT64_MAX - TICK_NANOSECONDS };
+	entry.m_deadline = now + std::clamp(delay, int64_t{ 0 }, maxDeadline - now);
+	entry.m_period = std::max(period, int64_t{ 0 });
+
+	const auto tick{ Link(entry) };
+	if (tick < m_armed) {
+		Arm(tick);
+	}
+}
+
+bool TimerWheel::Cancel(Entry& entry)
+{
+	std::unique_lock<std::mutex> lock{ m_mutex };
+	const bool isScheduled{ entry.m_link != nullptr };
+	if (isScheduled) {
+		Unlink(entry);
+		--m_size;
+	}
+
+	if (std::this_thread::get_id() != m_thread.get_id()) {
+		m_condition.wait(lock, [this, &entry]() { return m_firing != &entry; });
+	}
+
+	return isScheduled;
+}
+
+bool TimerWheel::IsScheduled(const Entry& entry)
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+	return entry.m_link != nullptr;
+}
+
+size_t TimerWheel::GetSize()
+{
+	std::lock_guard<std::mutex> lock{ m_mutex };
+	return m_size;
+}
+
+int64_t TimerWheel::Now() noexcept
+{
+	timespec time;
+	(void)clock_gettime(CLOCK_MONOTONIC, &time);
+	return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+}
+
+uint64_t TimerWheel::Link(Entry& entry) noexcept
+{
+	const auto push{ [&entry](Entry*& head) {
+		entry.m_next = head;
+		if (head != nullptr) {
+			head->m_link = &entry.m_next;
+		}
+		head = &entry;
+		entry.m_link = &head;
+	} };
+
+	//* Rounded up, so entry is never called before its deadline
+	entry.m_tick = (static_cast<uint64_t>(entry.m_deadline) + TICK_NANOSECONDS - 1) >> TICK_BITS;
+	if (entry.m_tick <= m_tick) {
+		entry.m_level = DUE_LEVEL;
+		push(m_due);
+		return m_tick;
+	}
+
+	//* The highest level where tick of entry differs from current tick
+	const auto level{ static_cast<uint32_t>(std::bit_width(entry.m_tick ^ m_tick) - 1) / SLOT_BITS };
+	const auto shift{ level * SLOT_BITS };
+	const auto slot{ (entry.m_tick >> shift) & (SLOTS - 1) };
+	entry.m_level = level;
+	push(m_slots[level][slot]);
+	m_occupied[level] |= uint64_t{ 1 } << slot;
+	return entry.m_tick >> shift << shift;
+}
+
+void TimerWheel::Unlink(Entry& entry) noexcept
+{
+	*entry.m_link = entry.m_next;
+	if (entry.m_next != nullptr) {
+		entry.m_next->m_link = entry.m_link;
+	}
+
+	if (entry.m_level != DUE_LEVEL) {
+		const auto slot{ (entry.m_tick >> (entry.m_level * SLOT_BITS)) & (SLOTS - 1) };
+		if (m_slots[entry.m_level][slot] == nullptr) {
+			m_occupied[entry.m_level] &= ~(uint64_t{ 1 } << slot);
+		}
+	}
+
+	entry.m_next = nullptr;
+	entry.m_link = nullptr;
+}
+
+uint64_t TimerWheel::GetNextTick() const noexcept
+{
+	if (m_due != nullptr) {
+		return m_tick;
+	}
+
+	//* Slots of lower level are always reached before slots of upper levels
+	for (uint32_t level{ 0 }; level < LEVELS; ++level) {
+		const auto shift{ level * SLOT_BITS };
+		const auto index{ (m_tick >> shift) & (SLOTS - 1) };
+		const auto later{ index + 1 == SLOTS ? 0 : m_occupied[level] & (UINT64_MAX << (index + 1)) };
+		if (later != 0) {
+			const auto upperShift{ shift + SLOT_BITS };
+			return (m_tick >> upperShift << upperShift) | (static_cast<uint64_t>(std::countr_zero(later)) << shift);
+		}
+	}
+
+	return UINT64_MAX;
+}
+
+void TimerWheel::Advance(const uint64_t tick) noexcept
+{
+	m_tick = tick;
+	for (auto level{ LEVELS }; level-- > 0;) {
+		const auto shift{ level * SLOT_BITS };
+		if ((tick & ((uint64_t{ 1 } << shift) - 1)) != 0) {
+			continue;
+		}
+
+		const auto slot{ (tick >> shift) & (SLOTS - 1) };
+		Entry* entry{ m_slots[level][slot] };
+		if (entry == nullptr) {
+			continue;
+		}
+
+		m_slots[level][slot] = nullptr;
+		m_occupied[level] &= ~(uint64_t{ 1 } << slot);
+		while (entry != nullptr) {
+			Entry* const next{ entry->m_next };
+			(void)Link(*entry);
+			entry = next;
+		}
+	}
+}
+
+void TimerWheel::Fire(std::unique_lock<std::mutex>& lock, const int64_t now)
+{
+	while (m_due != nullptr) {
+		Entry& entry{ *m_due };
+		Unlink(entry);
+		if (entry.m_period > 0) {
+			entry.m_deadline += entry.m_period;
+			//* Missed periods are skipped
+			if (entry.m_deadline <= now) {
+				entry.m_deadline = now + entry.m_period;
+			}
+			(void)Link(entry);
+		}
+		else {
+			--m_size;
+		}
+
+		m_firing = &entry;
+		lock.unlock();
+		entry.m_callback();
+		lock.lock();
+		m_firing = nullptr;
+		m_condition.notify_all();
+	}
+}
+
+void TimerWheel::Arm(const uint64_t tick) noexcept
+{
+	m_armed = tick;
+	itimerspec its{};
+	if (tick != UINT64_MAX) {
+		const auto nanoseconds{ static_cast<int64_t>(tick << TICK_BITS) };
+		its.it_value.tv_sec = static_cast<time_t>(nanoseconds / 1000000000);
+		//* Zero value disarms timer
+		its.it_value.tv_nsec = std::max(nanoseconds % 1000000000, int64_t{ nanoseconds == 0 });
+	}
+
+	if (timerfd_settime(m_file, TFD_TIMER_ABSTIME, &its, nullptr) != 0) {
+		LOG_ERROR("timerfd_settime. Error №" + _S(errno) + ": " + std::strerror(errno));
+	}
+}
+
+void TimerWheel::Run()
+{
+	std::unique_lock<std::mutex> lock{ m_mutex };
+	while (m_isRunning) {
+		lock.unlock();
+		uint64_t expirations;
+		if (read(m_file, &expirations, sizeof(expirations)) == -1 && errno != EINTR) {
+			LOG_ERROR("Read timerfd. Error №" + _S(errno) + ": " + std::strerror(errno));
+		}
+		lock.lock();
+		if (!m_isRunning) {
+			break;
+		}
+
+		const auto now{ Now() };
+		const auto nowTick{ static_cast<uint64_t>(now) >> TICK_BITS };
+		//* Timer is armed in the end, schedules during calls do not need to arm it
+		m_armed = 0;
+		while (true) {
+			Fire(lock, now);
+			const auto next{ GetNextTick() };
+			if (next > nowTick) {
+				break;
+			}
+			Advance(next);
+		}
+
+		//* Nothing is reached until next tick, so slots stay valid for current tick
+		m_tick = std::max(m_tick, nowTick);
+		Arm(GetNextTick());
+	}
+}
+
+}; //* namespace MSAPI
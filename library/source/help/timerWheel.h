@@ -0,0 +1,192 @@
+/**************************
+ * @file        timerWheel.h
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef MSAPI_TIMER_WHEEL_H
+#define MSAPI_TIMER_WHEEL_H
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace MSAPI {
+
+/**************************
+ * @brief Hierarchical timing wheel which calls entries on one thread. Thread sleeps on timerfd armed by
+ * CLOCK_MONOTONIC to the nearest slot, so there are no threads per expiration and changes of system time do not affect
+ * entries. Each level has 64 slots, slot of level covers 64 slots of previous level, entries of upper levels are moved
+ * down when their slot is reached. Entries are intrusive lists, schedule and cancel take O(1).
+ *
+ * @note Entry is called not earlier than its deadline and not later than one tick after it, plus wake up latency.
+ * @note Entries are called without internal lock, they can schedule and cancel any entries including themselves.
+ *
+ * @test Has unit test.
+ */
+class TimerWheel {
+public:
+	//* Tick of the lowest level, 65.536 microseconds
+	static constexpr uint32_t TICK_BITS{ 16 };
+	static constexpr int64_t TICK_NANOSECONDS{ int64_t{ 1 } << TICK_BITS };
+	static constexpr uint32_t SLOT_BITS{ 6 };
+	static constexpr uint32_t SLOTS{ 1 << SLOT_BITS };
+	//* 48 bits of ticks cover all positive nanoseconds of monotonic clock
+	static constexpr uint32_t LEVELS{ 8 };
+
+	/**************************
+	 * @brief Scheduled function, must not be moved and must be canceled before destruction.
+	 */
+	class Entry {
+		friend TimerWheel;
+
+	private:
+		Entry* m_next{};
+		Entry** m_link{};
+		uint64_t m_tick{};
+		int64_t m_deadline{};
+		int64_t m_period{};
+		uint32_t m_level{};
+		std::function<void()> m_callback;
+
+	public:
+		/**************************
+		 * @brief Construct a new Entry object, empty constructor.
+		 *
+		 * @param callback Function called on thread of wheel.
+		 */
+		Entry(std::function<void()> callback);
+
+		Entry(const Entry&) = delete;
+		Entry& operator=(const Entry&) = delete;
+	};
+
+private:
+	//* Level of entries which are due on current tick
+	static constexpr uint32_t DUE_LEVEL{ LEVELS };
+
+	std::array<std::array<Entry*, SLOTS>, LEVELS> m_slots{};
+	std::array<uint64_t, LEVELS> m_occupied{};
+	Entry* m_due{};
+	uint64_t m_tick{};
+	uint64_t m_armed{ UINT64_MAX };
+	size_t m_size{};
+	const Entry* m_firing{};
+	bool m_isRunning{ true };
+	int m_file{ -1 };
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::thread m_thread;
+
+public:
+	/**************************
+	 * @brief Construct a new Timer Wheel object, create timerfd and start thread.
+	 */
+	TimerWheel();
+
+	/**************************
+	 * @brief Stop thread and close timerfd, scheduled entries are not called anymore.
+	 */
+	~TimerWheel();
+
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel& operator=(const TimerWheel&) = delete;
+
+	/**************************
+	 * @return Process wide wheel, it is never destroyed to be available for static objects.
+	 */
+	static TimerWheel& Get();
+
+	/**************************
+	 * @brief Schedule entry, previous schedule of entry is canceled.
+	 *
+	 * @param entry Entry to schedule.
+	 * @param delay Nanoseconds to first call, negative is the same as 0.
+	 * @param period Nanoseconds between next calls, 0 or negative for single call.
+	 */
+	void Schedule(Entry& entry, int64_t delay, int64_t period = 0);
+
+	/**************************
+	 * @brief Cancel entry, wait for finish of its call if it is being called on other thread.
+	 *
+	 * @return True if entry was scheduled, false otherwise.
+	 */
+	bool Cancel(Entry& entry);
+
+	/**************************
+	 * @return True if entry is scheduled.
+	 */
+	[[nodiscard]] bool IsScheduled(const Entry& entry);
+
+	/**************************
+	 * @return Number of scheduled entries.
+	 */
+	[[nodiscard]] size_t GetSize();
+
+	/**************************
+	 * @return Nanoseconds of CLOCK_MONOTONIC.
+	 */
+	[[nodiscard]] static int64_t Now() noexcept;
+
+private:
+	/**************************
+	 * @brief Put entry into slot by its deadline relative to current tick, or into due list if tick is reached.
+	 *
+	 * @return Tick on which entry has to be processed.
+	 */
+	uint64_t Link(Entry& entry) noexcept;
+
+	/**************************
+	 * @brief Remove entry from its slot or due list.
+	 */
+	void Unlink(Entry& entry) noexcept;
+
+	/**************************
+	 * @return Nearest tick on which any slot has to be processed, UINT64_MAX if there are no entries.
+	 */
+	[[nodiscard]] uint64_t GetNextTick() const noexcept;
+
+	/**************************
+	 * @brief Move to tick, entries of reached slots are moved to lower levels or due list.
+	 */
+	void Advance(uint64_t tick) noexcept;
+
+	/**************************
+	 * @brief Call due entries, periodic entries are scheduled again before call.
+	 *
+	 * @param lock Locked m_mutex, it is unlocked during calls.
+	 * @param now Current time in nanoseconds.
+	 */
+	void Fire(std::unique_lock<std::mutex>& lock, int64_t now);
+
+	/**************************
+	 * @brief Arm timerfd to tick, disarm if tick is UINT64_MAX.
+	 */
+	void Arm(uint64_t tick) noexcept;
+
+	/**************************
+	 * @brief Body of thread.
+	 */
+	void Run();
+};
+
+}; //* namespace MSAPI
+
+#endif //* MSAPI_TIMER_WHEEL_H
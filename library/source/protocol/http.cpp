@@ -631,18 +631,19 @@ void Data::Send404(const int connection, const std::string& body, const std::str
 	return false;
 }
 
-bool Data::SendWebSocketUpgradeResponse(const int connection) const
+bool Data::SendWebSocketUpgradeResponse(const int connection, const std::string_view extensions) const
 {
 	const auto* webSocketKey{ GetValue("Sec-WebSocket-Key") };
 	if (webSocketKey == nullptr) [[unlikely]] {
-		LOG_WARNING_NEW("Sec-WebSocket-Key header is missing in WebSocket upgrade request, connection: {}", connection);
+		LOG_WARNING_NEW_LIMITED(
+			"Sec-WebSocket-Key header is missing in WebSocket upgrade request, connection: {}", connection);
 		Send404(connection);
 		return false;
 	}
 
 	if (const auto* webSocketVersion{ GetValue("Sec-WebSocket-Version") };
 		webSocketVersion == nullptr || *webSocketVersion != "13") {
-		LOG_WARNING_NEW(
+		LOG_WARNING_NEW_LIMITED(
 			"Unsupported Sec-WebSocket-Version header in WebSocket upgrade request, connection: {}", connection);
 		Send404(connection);
 		return false;
@@ -651,7 +652,7 @@ bool Data::SendWebSocketUpgradeResponse(const int connection) const
 	const auto webSocketKeySize{ webSocketKey->size() };
 	const auto acceptKeySize{ webSocketKeySize + m_webSocketGUID.size() };
 	if (acceptKeySize > 128) [[unlikely]] {
-		LOG_WARNING_NEW("Sec-WebSocket-Key header value is too long, connection: {}", connection);
+		LOG_WARNING_NEW_LIMITED("Sec-WebSocket-Key header value is too long, connection: {}", connection);
 		Send404(connection);
 		return false;
 	}
@@ -668,9 +669,13 @@ bool Data::SendWebSocketUpgradeResponse(const int connection) const
 	const auto acceptKeyHash{ MSAPI::Helper::Base64Encode(
 		std::span<const int8_t>{ reinterpret_cast<const int8_t*>(hash.data()), hash.size() }, bufferEncode) };
 
-	const std::string response{ std::format("{}/{} 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: "
-											"Upgrade\r\nSec-WebSocket-Accept: {}\r\nSec-WebSocket-Version: 13\r\n\r\n",
+	std::string response{ std::format("{}/{} 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: "
+									  "Upgrade\r\nSec-WebSocket-Accept: {}\r\nSec-WebSocket-Version: 13\r\n",
 		m_HTTPtype, m_version, acceptKeyHash) };
+	if (!extensions.empty()) {
+		std::format_to(std::back_inserter(response), "Sec-WebSocket-Extensions: {}\r\n", extensions);
+	}
+	response += "\r\n";
 
 	const auto result{ send(connection, response.c_str(), response.length(), MSG_CONFIRM) };
 	if (result == -1) {
@@ -190,12 +190,13 @@ public:
 	 * @brief Check validity of request and send response.
 	 *
 	 * @param connection Connection of request.
+	 * @param extensions Accepted extensions for Sec-WebSocket-Extensions header, header is omitted if empty.
 	 *
 	 * @return True if response sended successfully, false otherwise.
 	 *
 	 * @test Has unit test.
 	 */
-	[[nodiscard]] bool SendWebSocketUpgradeResponse(int connection) const;
+	[[nodiscard]] bool SendWebSocketUpgradeResponse(int connection, std::string_view extensions = {}) const;
 
 	/**************************
 	 * @example HTTP message:
@@ -315,12 +316,23 @@ void SendRequest(int connection, const std::string& HTTP);
 		return;                                                                                                        \
 	}
 
+// Same as MSAPI_HANDLER_WEBSOCKET_PRESET, but frame is parsed in place of recv buffer and valid only in handler
+#define MSAPI_HANDLER_WEBSOCKET_BORROWED_PRESET                                                                        \
+	if (recvBufferInfo->GetReadDataSize() == 2) {                                                                      \
+		MSAPI::Protocol::WebSocket::IHandler::Collect(recvBufferInfo->connection,                                      \
+			MSAPI::Protocol::WebSocket::Data{ recvBufferInfo, MSAPI::Protocol::WebSocket::Data::Borrowed{} });         \
+		return;                                                                                                        \
+	}
+
 #define MSAPI_HANDLER_HTTP_PRESET_INTERNAL_PART                                                                        \
 	if constexpr (std::is_base_of_v<MSAPI::Protocol::WebSocket::IHandler, std::remove_cvref_t<decltype(*this)>>) {     \
 		if (http.IsWebSocketUpgradeRequest()) {                                                                        \
 			if (MSAPI::Application::IsRunning()) {                                                                     \
 				LOG_PROTOCOL(http.ToString());                                                                         \
-				if (!http.SendWebSocketUpgradeResponse(recvBufferInfo->connection)) {                                  \
+				if (!http.SendWebSocketUpgradeResponse(recvBufferInfo->connection,                                     \
+						MSAPI::Protocol::WebSocket::PerMessageDeflate::Accept(                                         \
+							recvBufferInfo->connection, http.GetValue("Sec-WebSocket-Extensions")))) {                 \
+					MSAPI::Protocol::WebSocket::PerMessageDeflate::Close(recvBufferInfo->connection);                  \
 					return;                                                                                            \
 				}                                                                                                      \
 				recvBufferInfo->SetReadDataSize(2);                                                                    \
@@ -40,8 +40,10 @@ std::string StreamData::ToString() const
 					   "\n\topen               : {}"
 					   "\n\tfilter object hash : {}"
 					   "\n\tfilter size        : {}"
+					   "\n\tlast sequence      : {}"
+					   "\n\tepoch              : {}"
 					   "\n}}",
-		connection, EnumToString(type), open, objectHash, filterSize);
+		connection, EnumToString(type), open, objectHash, filterSize, lastSequence, epoch);
 }
 
 /*---------------------------------------------------------------------------------
@@ -57,31 +59,39 @@ std::string Data::ToString() const
 					   "\n\tbuffer size : {}"
 					   "\n\thash        : {}"
 					   "\n\tstream id   : {}"
+					   "\n\tsequence    : {}"
 					   "\n}}",
-		m_cipher, m_bufferSize, m_hash, m_streamId);
+		m_cipher, m_bufferSize, m_hash, m_streamId, m_sequence);
 }
 
 int Data::GetStreamId() const { return m_streamId; }
 
+uint64_t Data::GetSequence() const noexcept { return m_sequence; }
+
 void* Data::PackData(const void* data) const
 {
 	void* buffer{ malloc(m_bufferSize) };
+	PackData(buffer, data);
+	return buffer;
+}
+
+void Data::PackData(void* buffer, const void* data) const
+{
 	memcpy(buffer, &m_cipher, sizeof(size_t));
 	memcpy(&static_cast<char*>(buffer)[sizeof(size_t)], &m_bufferSize, sizeof(size_t));
 	memcpy(&static_cast<char*>(buffer)[sizeof(size_t) * 2], &m_streamId, sizeof(int));
 	memcpy(&static_cast<char*>(buffer)[sizeof(size_t) * 2 + sizeof(int)], &m_hash, sizeof(size_t));
-	memcpy(&static_cast<char*>(buffer)[sizeof(size_t) * 3 + sizeof(int)], data,
-		m_bufferSize - sizeof(size_t) * 3 - sizeof(int));
+	memcpy(&static_cast<char*>(buffer)[sizeof(size_t) * 3 + sizeof(int)], &m_sequence, sizeof(uint64_t));
+	memcpy(&static_cast<char*>(buffer)[HEADER_SIZE], data, m_bufferSize - HEADER_SIZE);
 	// Diagnostic::PrintBinaryDescriptor(buffer, m_bufferSize, "Packed memory");
-	return buffer;
 }
 
 void Data::UnpackData(void** ptr, void* buffer)
 {
-	*ptr = &(static_cast<char*>(buffer)[sizeof(size_t) * 3 + sizeof(int)]);
+	*ptr = &(static_cast<char*>(buffer)[HEADER_SIZE]);
 }
 
-bool Data::IsValid() const { return m_cipher == 2666999999 && m_bufferSize >= sizeof(size_t) * 3 + sizeof(int); }
+bool Data::IsValid() const { return m_cipher == 2666999999 && m_bufferSize >= HEADER_SIZE; }
 
 /*---------------------------------------------------------------------------------
 IHandlerBase
@@ -98,11 +108,16 @@ void IHandlerBase::SetStream(const int streamId, StreamBase* stream)
 
 void IHandlerBase::RemoveStream(const int streamId) { m_streamToId.erase(streamId); }
 
+void IHandlerBase::SetLastSequence(StreamBase* stream, const uint64_t sequence) noexcept
+{
+	stream->SetLastSequence(sequence);
+}
+
 void IHandlerBase::CollectStreamState(const int streamId, const StreamStateResponse* state)
 {
 	const auto it = m_streamToId.find(streamId);
 	if (it == m_streamToId.end()) {
-		LOG_WARNING_NEW("Got state for unknown stream id: {}, state: {}", streamId, EnumToString(state->state));
+		LOG_WARNING_NEW_LIMITED("Got state for unknown stream id: {}, state: {}", streamId, EnumToString(state->state));
 		return;
 	}
 
@@ -110,6 +125,7 @@ void IHandlerBase::CollectStreamState(const int streamId, const StreamStateRespo
 	it->second->SetState(state->state);
 	switch (state->state) {
 	case State::Opened:
+		it->second->SetEpoch(state->epoch);
 		HandleStreamOpened(streamId);
 		return;
 	case State::Done:
@@ -149,6 +165,14 @@ size_t FilterBase::GetStreamObjectHash() const { return m_streamObjectHash; }
 
 void FilterBase::SetStreamObjectHash(const size_t streamObjectHash) { m_streamObjectHash = streamObjectHash; }
 
+void FilterBase::SetLastSequence(const uint64_t lastSequence) noexcept { m_lastSequence = lastSequence; }
+
+uint64_t FilterBase::GetLastSequence() const noexcept { return m_lastSequence; }
+
+void FilterBase::SetEpoch(const uint64_t epoch) noexcept { m_epoch = epoch; }
+
+uint64_t FilterBase::GetEpoch() const noexcept { return m_epoch; }
+
 size_t FilterBase::GetFilterObjectHash() const
 {
 	LOG_ERROR("Call unexpected method by FilterBase class");
@@ -161,8 +185,10 @@ std::string FilterBase::ToString() const
 					   "\n\ttype               : {}"
 					   "\n\tstream object hash : {}"
 					   "\n\tfilter size        : {}"
+					   "\n\tlast sequence      : {}"
+					   "\n\tepoch              : {}"
 					   "\n}}",
-		EnumToString(m_type), m_streamObjectHash, m_filterSize);
+		EnumToString(m_type), m_streamObjectHash, m_filterSize, m_lastSequence, m_epoch);
 }
 
 /*---------------------------------------------------------------------------------
@@ -194,6 +220,14 @@ void StreamBase::SetState(const State state)
 
 bool StreamBase::IsSnapshotDone() const { return m_snapshotDone; }
 
+uint64_t StreamBase::GetLastSequence() const noexcept { return m_lastSequence; }
+
+void StreamBase::SetLastSequence(const uint64_t sequence) noexcept { m_lastSequence = sequence; }
+
+uint64_t StreamBase::GetEpoch() const noexcept { return m_epoch; }
+
+void StreamBase::SetEpoch(const uint64_t epoch) noexcept { m_epoch = epoch; }
+
 void StreamBase::SetConnection(const int connection) { m_connection = connection; }
 
 /*---------------------------------------------------------------------------------
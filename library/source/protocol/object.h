@@ -45,25 +45,48 @@
  * @brief Identifier of stream is unique for single application which created that stream. Distributor uses key pair {
  * stream id, connection } to identify stream.
  *
+ * @brief Every object of type with enabled replay is published with sequence number, which is incremented per object
+ * type on distributor side. Client stream remembers the last received sequence and sends it in filter when stream is
+ * reopened with the same filter. If distributor replay ring still contains all objects after that sequence, only missed
+ * objects are sent instead of full snapshot. Sequences restart in each distributor instance, so distributor sends its
+ * epoch with Opened state and client returns it in filter together with the last sequence. Full snapshot is sent if
+ * epoch differs.
+ *
+ * @brief Every transferred type is identified by TypeId<T>::value, which is a compile-time FNV-1a hash of the type
+ * name mixed with its size and alignment. Identifier does not depend on compiler runtime type information. Type name
+ * can be declared explicitly by static constexpr std::string_view objectTypeName member, otherwise it is extracted from
+ * the compiler function signature. Declared name is required for communication between applications built by
+ * different compilers.
+ *
  * @todo Filters can be || and &&
  * @todo Stream can has different filters
- * @todo typeid.hash_code() should be replaced with custom hash function
  */
 
 #ifndef MSAPI_PROTOCOL_OBJECT_H
 #define MSAPI_PROTOCOL_OBJECT_H
 
+#include "../help/continuousAllocator.hpp"
 #include "../help/diagnostic.h"
 #include "../help/log.h"
 #include "dataHeader.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <concepts>
 #include <cstring>
 #include <deque>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <optional>
 #include <set>
+#include <string_view>
 #include <sys/socket.h>
+#include <unistd.h>
 
 namespace MSAPI {
 
@@ -109,14 +132,191 @@ std::string_view EnumToString(Protocol::Object::State value);
  */
 std::string_view EnumToString(Protocol::Object::Issue value);
 
+/**************************
+ * @brief Concept for types which declare stable name for object protocol type identifier.
+ */
+template <typename T>
+concept NamedObject = requires {
+	{ T::objectTypeName } -> std::convertible_to<std::string_view>;
+};
+
+/**************************
+ * @brief FNV-1a 64-bit hash of string.
+ *
+ * @param str String to hash.
+ * @param hash Initial hash value, offset basis by default.
+ *
+ * @return Hash of string.
+ *
+ * @test Has unit test.
+ */
+constexpr uint64_t Fnv1a(const std::string_view str, uint64_t hash = 14695981039346656037ull) noexcept
+{
+	for (const char symbol : str) {
+		hash ^= static_cast<uint8_t>(symbol);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+/**************************
+ * @brief FNV-1a 64-bit hash of integer value in little-endian byte order.
+ *
+ * @param value Value to hash.
+ * @param hash Initial hash value.
+ *
+ * @return Hash of value.
+ *
+ * @test Has unit test.
+ */
+constexpr uint64_t Fnv1a(const uint64_t value, uint64_t hash) noexcept
+{
+	for (size_t index{}; index < sizeof(uint64_t); ++index) {
+		hash ^= static_cast<uint8_t>(value >> (index * 8));
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+/**************************
+ * @return Stable name of type. Declared objectTypeName if type has it, otherwise name extracted from compiler
+ * function signature, which is stable between binaries built by the same compiler.
+ *
+ * @tparam T Type to get name.
+ *
+ * @test Has unit test.
+ */
+template <typename T> constexpr std::string_view TypeName() noexcept
+{
+	if constexpr (NamedObject<T>) {
+		return std::string_view{ T::objectTypeName };
+	}
+	else {
+		const std::string_view function{ __PRETTY_FUNCTION__ };
+		const auto begin{ function.find("T = ") + 4 };
+		const auto end{ function.find_first_of(";]", begin) };
+		return function.substr(begin, end - begin);
+	}
+}
+
+/**************************
+ * @brief Stable compile-time identifier of type transferred by object protocol. Hash of type name, size and
+ * alignment.
+ *
+ * @tparam T Type to identify.
+ *
+ * @test Has unit test.
+ */
+template <typename T> struct TypeId {
+	static constexpr size_t value{ Fnv1a(alignof(T), Fnv1a(sizeof(T), Fnv1a(TypeName<T>()))) };
+};
+
+template <typename T> inline constexpr size_t typeId_v = TypeId<std::remove_cvref_t<T>>::value;
+
+/**************************
+ * @brief Compile-time perfect hash table of type identifiers to handlers, provides lookup by direct index without
+ * comparisons chain or search. Index of slot is the highest bits of hash multiplied by odd multiplier, multiplier is
+ * selected during construction so that every entry gets its own slot. Table has at least four slots per entry, suitable
+ * multiplier is found after a few attempts for any realistic count of handled types.
+ *
+ * @tparam F Type of handler.
+ * @tparam N Number of entries.
+ *
+ * @test Has unit test.
+ */
+template <typename F, size_t N> class DispatchTable {
+public:
+	struct Entry {
+		size_t hash;
+		F handler;
+	};
+
+private:
+	static constexpr size_t SLOTS_SIZE{ std::bit_ceil(N) * 4 };
+	static constexpr size_t SHIFT{ 64 - static_cast<size_t>(std::countr_zero(SLOTS_SIZE)) };
+	static constexpr size_t ATTEMPTS{ 1 << 14 };
+
+	std::array<Entry, SLOTS_SIZE> m_slots{};
+	uint64_t m_multiplier{};
+	bool m_perfect{};
+
+public:
+	/**************************
+	 * @brief Construct a new Dispatch Table object, select multiplier without collisions and place entries to slots.
+	 *
+	 * @param entries Entries of table.
+	 */
+	constexpr DispatchTable(const std::array<Entry, N>& entries)
+	{
+		uint64_t seed{ 0x9E3779B97F4A7C15ull };
+		for (size_t attempt{}; attempt < ATTEMPTS; ++attempt) {
+			seed += 0x9E3779B97F4A7C15ull;
+			uint64_t multiplier{ seed };
+			multiplier = (multiplier ^ (multiplier >> 30)) * 0xBF58476D1CE4E5B9ull;
+			multiplier = (multiplier ^ (multiplier >> 27)) * 0x94D049BB133111EBull;
+			multiplier = (multiplier ^ (multiplier >> 31)) | 1;
+
+			std::array<bool, SLOTS_SIZE> used{};
+			bool collision{};
+			for (const auto& entry : entries) {
+				const auto index{ Index(entry.hash, multiplier) };
+				if (used[index]) {
+					collision = true;
+					break;
+				}
+				used[index] = true;
+			}
+			if (collision) {
+				continue;
+			}
+
+			m_multiplier = multiplier;
+			for (const auto& entry : entries) {
+				m_slots[Index(entry.hash, multiplier)] = entry;
+			}
+			m_perfect = true;
+			return;
+		}
+	}
+
+	/**************************
+	 * @return True if all hashes in table are unique and each of them has its own slot.
+	 */
+	[[nodiscard]] constexpr bool IsUnique() const noexcept { return m_perfect; }
+
+	/**************************
+	 * @param hash Hash to find.
+	 *
+	 * @return Handler for hash, value initialized handler (nullptr for pointers) if hash is unknown.
+	 */
+	[[nodiscard]] constexpr F Find(const size_t hash) const noexcept
+	{
+		const auto& slot{ m_slots[Index(hash, m_multiplier)] };
+		if (slot.hash != hash) {
+			return F{};
+		}
+		return slot.handler;
+	}
+
+private:
+	[[nodiscard]] static constexpr size_t Index(const size_t hash, const uint64_t multiplier) noexcept
+	{
+		return static_cast<size_t>((static_cast<uint64_t>(hash) * multiplier) >> SHIFT);
+	}
+};
+
 /**************************
  * @brief Structure for provide stream state.
  *
  * @todo Probably can be removed and State enum can be used instead.
  */
 struct StreamStateResponse {
+	static constexpr std::string_view objectTypeName{ "MSAPI::Protocol::Object::StreamStateResponse" };
+
 	State state{ State::Undefined };
 	Issue issue{ Issue::Empty };
+	//* Epoch of distributor, sent with Opened state
+	uint64_t epoch{ 0 };
 };
 
 /**************************
@@ -128,6 +328,8 @@ struct StreamData {
 	bool open{ false };
 	size_t objectHash{ 0 };
 	size_t filterSize{ 0 };
+	uint64_t lastSequence{ 0 };
+	uint64_t epoch{ 0 };
 
 	/**************************
 	 * @example Stream data:
@@ -137,6 +339,8 @@ struct StreamData {
 	 * 			open	   			: true
 	 * 			filter object hash  : 123456789
 	 * 			filter size         : 3
+	 * 			last sequence       : 0
+	 * 			epoch               : 0
 	 * }
 	 */
 	std::string ToString() const;
@@ -149,8 +353,11 @@ class Data : public DataHeader {
 private:
 	int m_streamId;
 	size_t m_hash;
+	uint64_t m_sequence;
 
 public:
+	static constexpr size_t HEADER_SIZE{ sizeof(size_t) * 3 + sizeof(int) + sizeof(uint64_t) };
+
 	/**************************
 	 * @brief Create object for transfer data in stream, update buffer size.
 	 *
@@ -158,23 +365,25 @@ public:
 	 * involve streams.
 	 * @param hash Hash of object.
 	 * @param size Size of object.
+	 * @param sequence Sequence number of object, 0 if object is not sequenced.
 	 *
 	 * @test Has unit test.
 	 *
 	 * @todo Move stream_id in separated StreamData object
 	 */
-	Data(const int streamId, const size_t hash, const size_t size)
+	Data(const int streamId, const size_t hash, const size_t size, const uint64_t sequence = 0)
 		: DataHeader{ 2666999999 }
 		, m_streamId{ streamId }
 		, m_hash{ hash }
+		, m_sequence{ sequence }
 	{
-		m_bufferSize += sizeof(size_t) + sizeof(int) + size;
+		m_bufferSize += sizeof(size_t) + sizeof(int) + sizeof(uint64_t) + size;
 	}
 
 	/**************************
-	 * @brief Construct a new Data object from buffer, copy stream id and hash from it.
+	 * @brief Construct a new Data object from buffer, copy stream id, hash and sequence from it.
 	 *
-	 * @attention Buffer must be at least 28 bytes long, otherwise undefined behaviour.
+	 * @attention Buffer must be at least HEADER_SIZE bytes long, otherwise undefined behaviour.
 	 *
 	 * @tparam T DataHeader.
 	 *
@@ -190,6 +399,7 @@ public:
 	{
 		memcpy(&m_streamId, static_cast<const int8_t*>(buffer) + sizeof(size_t) * 2, sizeof(int));
 		memcpy(&m_hash, static_cast<const int8_t*>(buffer) + sizeof(size_t) * 2 + sizeof(int), sizeof(size_t));
+		memcpy(&m_sequence, static_cast<const int8_t*>(buffer) + sizeof(size_t) * 3 + sizeof(int), sizeof(uint64_t));
 	}
 
 	/**************************
@@ -213,6 +423,13 @@ public:
 	 */
 	int GetStreamId() const;
 
+	/**************************
+	 * @return Sequence number of object, 0 if object is not sequenced.
+	 *
+	 * @test Has unit test.
+	 */
+	uint64_t GetSequence() const noexcept;
+
 	/**************************
 	 * @brief Pack data before sending in stream.
 	 *
@@ -228,6 +445,18 @@ public:
 	 */
 	void* PackData(const void* data) const;
 
+	/**************************
+	 * @brief Pack data into provided buffer without allocation.
+	 *
+	 * @attention Buffer must be at least buffer size bytes long.
+	 *
+	 * @param buffer Writable buffer for packed data.
+	 * @param data Data for packing.
+	 *
+	 * @test Has unit test.
+	 */
+	void PackData(void* buffer, const void* data) const;
+
 	/**************************
 	 * @brief Unpack data after receiving from stream.
 	 *
@@ -255,6 +484,7 @@ public:
 	 * 			buffer size	: 123
 	 * 			hash	    : 123456789
 	 * 			stream id   : 123
+	 * 			sequence    : 0
 	 * }
 	 *
 	 * @test Has unit test.
@@ -271,6 +501,26 @@ public:
  */
 void Send(int connection, const Data& data, const void* object);
 
+/**************************
+ * @brief Interface for receiver of all objects published by distributor regardless of active streams, for example
+ * journal.
+ */
+class ISink {
+public:
+	/**************************
+	 * @brief Default virtual destructor.
+	 */
+	virtual ~ISink() = default;
+
+	/**************************
+	 * @brief Collect published object, called on publishing thread.
+	 *
+	 * @param data Data of object, stream id is 0.
+	 * @param object Object to collect.
+	 */
+	virtual void Collect(const Data& data, const void* object) = 0;
+};
+
 class IHandlerBase;
 
 /**************************
@@ -286,6 +536,8 @@ protected:
 	int m_connection{ 0 };
 	State m_state{ State::Undefined };
 	bool m_snapshotDone{ false };
+	uint64_t m_lastSequence{ 0 };
+	uint64_t m_epoch{ 0 };
 
 public:
 	/**************************
@@ -318,6 +570,16 @@ public:
 	 */
 	int GetConnection() const;
 
+	/**************************
+	 * @return Sequence number of the last received object, 0 if stream did not receive sequenced objects.
+	 */
+	uint64_t GetLastSequence() const noexcept;
+
+	/**************************
+	 * @return Epoch of distributor which opened stream the last time, 0 if stream was not opened.
+	 */
+	uint64_t GetEpoch() const noexcept;
+
 	/**************************
 	 * @return True if stream connection is not set.
 	 */
@@ -338,6 +600,20 @@ protected:
 	 */
 	void SetState(State state);
 
+	/**************************
+	 * @brief Set sequence number of the last received object.
+	 *
+	 * @param sequence Sequence to set.
+	 */
+	void SetLastSequence(uint64_t sequence) noexcept;
+
+	/**************************
+	 * @brief Set epoch of distributor which opened stream.
+	 *
+	 * @param epoch Epoch to set.
+	 */
+	void SetEpoch(uint64_t epoch) noexcept;
+
 	//* To encapsulate protected function
 	friend class IHandlerBase;
 };
@@ -427,6 +703,15 @@ public:
 	 * @param state Stream state to collect.
 	 */
 	void CollectStreamState(int streamId, const StreamStateResponse* state);
+
+protected:
+	/**************************
+	 * @brief Remember sequence of received object for stream to request only missed objects on reopening.
+	 *
+	 * @param stream Stream which received object.
+	 * @param sequence Sequence of received object.
+	 */
+	static void SetLastSequence(StreamBase* stream, uint64_t sequence) noexcept;
 };
 
 /**************************
@@ -464,17 +749,19 @@ public:
 
 			const auto streamId{ data.GetStreamId() };
 			const auto& streamToId = GetStreamsContainer();
-			if (const auto it = streamToId.find(streamId); it == streamToId.end()) {
-				LOG_WARNING("Unknown stream id: " + _S(streamId));
+			const auto it = streamToId.find(streamId);
+			if (it == streamToId.end()) {
+				LOG_WARNING_LIMITED("Unknown stream id: " + _S(streamId));
 				return;
 			}
 			const auto hash{ data.GetHash() };
-			if (hash == typeid(T).hash_code()) {
+			if (hash == typeId_v<T>) {
+				SetLastSequence(it->second, data.GetSequence());
 				HandleObject(streamId, *reinterpret_cast<const T*>(object));
 				return;
 			}
 
-			LOG_ERROR("Unknown hash: " + _S(hash));
+			LOG_ERROR_LIMITED("Unknown hash: " + _S(hash));
 			return;
 		}
 
@@ -482,6 +769,44 @@ public:
 	}
 };
 
+/**************************
+ * @brief Collect data object by handler of related object type found in compile-time dispatch table. Stream state
+ * response is passed to CollectStreamState function.
+ *
+ * @tparam Ts Types of objects which handler can handle.
+ * @tparam H Type of handler, must be publicly derived from IHandler of each object type.
+ *
+ * @param handler Handler for collect.
+ * @param data Data object for collect.
+ * @param object Object for collect.
+ *
+ * @return True if hash of data is known by handler, false otherwise.
+ */
+template <typename... Ts, typename H>
+	requires(std::is_base_of_v<IHandler<Ts>, H> && ...)
+bool Collect(H* handler, const Data& data, const void* object)
+{
+	using Table = DispatchTable<void (*)(H*, const Data&, const void*), sizeof...(Ts) + 1>;
+
+	static constexpr Table table{ std::array<typename Table::Entry, sizeof...(Ts) + 1>{
+		typename Table::Entry{ typeId_v<StreamStateResponse>,
+			[](H* handler, const Data& data, const void* object) {
+				handler->CollectStreamState(data.GetStreamId(), static_cast<const StreamStateResponse*>(object));
+			} },
+		typename Table::Entry{ typeId_v<Ts>,
+			[](H* handler, const Data& data, const void* object) { handler->IHandler<Ts>::Collect(data, object); } }...,
+	} };
+	static_assert(table.IsUnique(), "Type identifiers of handler objects are not unique");
+
+	const auto collect{ table.Find(data.GetHash()) };
+	if (collect == nullptr) [[unlikely]] {
+		return false;
+	}
+
+	collect(handler, data, object);
+	return true;
+}
+
 /**************************
  * @brief Base class for all filters, contain general filter information.
  *
@@ -495,6 +820,8 @@ private:
 	Type m_type{ Type::Undefined };
 	size_t m_filterSize{ 0 };
 	size_t m_streamObjectHash{ 0 };
+	uint64_t m_lastSequence{ 0 };
+	uint64_t m_epoch{ 0 };
 
 public:
 	/**************************
@@ -559,6 +886,31 @@ public:
 	 */
 	size_t GetStreamObjectHash() const;
 
+	/**************************
+	 * @brief Set sequence of the last object received by client, distributor sends only newer objects if possible.
+	 *
+	 * @param lastSequence Sequence to set, 0 means full snapshot is required.
+	 */
+	void SetLastSequence(uint64_t lastSequence) noexcept;
+
+	/**************************
+	 * @return Sequence of the last object received by client.
+	 */
+	uint64_t GetLastSequence() const noexcept;
+
+	/**************************
+	 * @brief Set epoch of distributor which assigned the last sequence, distributor with different epoch ignores
+	 * the last sequence and sends full snapshot.
+	 *
+	 * @param epoch Epoch to set, 0 if stream was not opened.
+	 */
+	void SetEpoch(uint64_t epoch) noexcept;
+
+	/**************************
+	 * @return Epoch of distributor which assigned the last sequence.
+	 */
+	uint64_t GetEpoch() const noexcept;
+
 	/**************************
 	 * @return Hash of filter object.
 	 */
@@ -570,6 +922,8 @@ public:
 	 * 			type	   : Snapshot
 	 * 			obj. hash  : 123456789
 	 * 			filt. size : 3
+	 * 			last seq.  : 0
+	 * 			epoch      : 0
 	 * }
 	 */
 	std::string ToString() const;
@@ -594,8 +948,8 @@ template <typename T>
 	requires std::is_class_v<T>
 class Filter : public FilterBase {
 private:
-	size_t m_hash{ typeid(T).hash_code() };
-	std::vector<T> m_objects;
+	size_t m_hash{ typeId_v<T> };
+	std::vector<T, ContinuousAllocator<T>> m_objects;
 
 public:
 	/**************************
@@ -639,7 +993,7 @@ public:
 	/**************************
 	 * @return Readable link for container with filter objects.
 	 */
-	const std::vector<T>& GetObjects() const { return m_objects; }
+	const std::vector<T, ContinuousAllocator<T>>& GetObjects() const { return m_objects; }
 
 	/**************************
 	 * @return Hash of filter object.
@@ -697,6 +1051,17 @@ private:
 	friend class Distributor;
 };
 
+/**************************
+ * @brief Stable type identifier of filter, does not depend on layout of filter class, only on filter object type.
+ *
+ * @tparam T Type of filter object.
+ */
+template <typename T>
+	requires std::is_class_v<T>
+struct TypeId<Filter<T>> {
+	static constexpr size_t value{ Fnv1a("MSAPI::Protocol::Object::Filter", TypeId<T>::value) };
+};
+
 /**************************
  * @brief Main class for all distributors, contains general information about streams and their filters. Distributor
  * uses key pair { stream id, connection } for identify stream.
@@ -712,6 +1077,99 @@ private:
 template <typename... Ts>
 	requires(std::is_class_v<Ts> && ...)
 class Distributor : virtual protected ApplicationStateChecker {
+private:
+	/**************************
+	 * @brief Base class for bounded ring with the last published objects of one type, contains sequence of the last
+	 * published object.
+	 */
+	class ReplayRingBase {
+	protected:
+		uint64_t m_sequence{ 0 };
+		uint64_t m_size{ 0 };
+
+	public:
+		/**************************
+		 * @brief Default virtual destructor.
+		 */
+		virtual ~ReplayRingBase() = default;
+
+		/**************************
+		 * @return Sequence of the last published object.
+		 */
+		uint64_t GetSequence() const noexcept { return m_sequence; }
+
+		/**************************
+		 * @param lastSequence Sequence of the last object received by client.
+		 *
+		 * @return True if ring contains all objects published after sequence.
+		 */
+		bool Covers(const uint64_t lastSequence) const noexcept
+		{
+			return lastSequence <= m_sequence && m_sequence - lastSequence <= m_size;
+		}
+
+		/**************************
+		 * @brief Send all objects published after the last sequence of stream which pass stream filter.
+		 *
+		 * @param id Stream id for which objects are sent.
+		 * @param streamData Stream data with the last sequence received by client.
+		 */
+		virtual void Replay(int id, const StreamData& streamData) const = 0;
+	};
+
+	/**************************
+	 * @brief Bounded ring with the last published objects of specific type.
+	 *
+	 * @tparam T Type of object.
+	 */
+	template <typename T> class ReplayRing final : public ReplayRingBase {
+	private:
+		const Distributor* m_distributor;
+		std::vector<std::optional<T>> m_objects;
+		const std::function<bool(const FilterBase* filter, const T& object)> m_filterPredicate;
+
+	public:
+		/**************************
+		 * @brief Construct a new Replay Ring object, reserve slots for objects.
+		 *
+		 * @param distributor Readable pointer to distributor which sends replayed objects.
+		 * @param capacity Number of slots, must be greater than 0.
+		 * @param filterPredicate Predicate for filter applied during replay.
+		 */
+		ReplayRing(const Distributor* distributor, const size_t capacity,
+			const std::function<bool(const FilterBase* filter, const T& object)>& filterPredicate)
+			: m_distributor{ distributor }
+			, m_objects(capacity)
+			, m_filterPredicate{ filterPredicate }
+		{
+		}
+
+		/**************************
+		 * @brief Store copy of object in place of the oldest one.
+		 *
+		 * @param object Object to store.
+		 *
+		 * @return Sequence assigned to object.
+		 */
+		uint64_t Push(const T& object)
+		{
+			++this->m_sequence;
+			m_objects[this->m_sequence % m_objects.size()].emplace(object);
+			if (this->m_size < m_objects.size()) {
+				++this->m_size;
+			}
+			return this->m_sequence;
+		}
+
+		void Replay(const int id, const StreamData& streamData) const final
+		{
+			for (uint64_t sequence{ streamData.lastSequence + 1 }; sequence <= this->m_sequence; ++sequence) {
+				m_distributor->Send(
+					id, *m_objects[sequence % m_objects.size()], streamData, m_filterPredicate, sequence);
+			}
+		}
+	};
+
 protected:
 	//* { { stream id client, connection }, stream data } }
 	std::map<std::pair<int, int>, StreamData> m_streamDataToIdAndConnection;
@@ -719,6 +1177,11 @@ protected:
 	std::multimap<std::pair<int, int>, std::variant<Filter<Ts>...>> m_filtersToStreamIdAndConnection;
 	//* { object hash, { stream id, connection } } only for snapshot and live streams
 	std::multimap<size_t, std::pair<int, int>> m_activeStreamsToObjectHash;
+	//* { object hash, replay ring } only for objects with enabled replay
+	std::map<size_t, std::unique_ptr<ReplayRingBase>> m_replayRingsToObjectHash;
+	ISink* m_sink{ nullptr };
+	//* Sequences are valid only within the same epoch, new distributor instance starts new epoch
+	const uint64_t m_epoch{ MakeEpoch() };
 
 public:
 	/**************************
@@ -726,6 +1189,11 @@ public:
 	 */
 	virtual ~Distributor() { Stop(); }
 
+	/**************************
+	 * @return Epoch of distributor, sent to client with Opened state and returned back with the last sequence.
+	 */
+	uint64_t GetEpoch() const noexcept { return m_epoch; }
+
 	/**************************
 	 * @brief Send Failed state for all opened streams and remove all information about them.
 	 */
@@ -742,14 +1210,29 @@ public:
 				//* Will removed anyway
 				//* streamData.open = false;
 				Protocol::Object::Send(streamData.connection,
-					{ idAndConnection.first, typeid(StreamStateResponse).hash_code(), sizeof(StreamStateResponse) },
-					&state);
+					{ idAndConnection.first, typeId_v<StreamStateResponse>, sizeof(StreamStateResponse) }, &state);
 				// Diagnostic::PrintBinaryDescriptor(data, sizeof(Protocol::Object::Data), "Right after send");
 				RemoveInformationAboutStream(idAndConnection);
 			}
 		}
 	}
 
+	/**************************
+	 * @brief Remove information about all streams of closed connection, so objects are not sent to another connection
+	 * which reuses the same socket.
+	 *
+	 * @param connection Closed connection.
+	 */
+	void RemoveConnection(const int connection)
+	{
+		for (auto it{ m_streamDataToIdAndConnection.begin() }; it != m_streamDataToIdAndConnection.end();) {
+			const auto idAndConnection{ (it++)->first };
+			if (idAndConnection.second == connection) {
+				RemoveInformationAboutStream(idAndConnection);
+			}
+		}
+	}
+
 	/**************************
 	 * @brief Apply client side action for particular stream.
 	 *
@@ -779,6 +1262,36 @@ public:
 		}
 	}
 
+	/**************************
+	 * @brief Collect any income data which distributor can handle. Stream state response is applied as client side
+	 * action, filter and filter object are passed to specific Collect function found in compile-time dispatch table.
+	 *
+	 * @param connection Connection for which data is collected.
+	 * @param data Data for collect.
+	 * @param object Object for collect.
+	 *
+	 * @return True if hash of data is known by distributor, false otherwise.
+	 */
+	bool Collect(const int connection, const Data& data, const void* object)
+	{
+		const auto hash{ data.GetHash() };
+		if (hash == typeId_v<StreamStateResponse>) {
+			StreamExternalAction({ data.GetStreamId(), connection }, static_cast<const StreamStateResponse*>(object));
+			return true;
+		}
+
+		static constexpr CollectTable table{ MakeCollectTable() };
+		static_assert(table.IsUnique(), "Type identifiers of distributor filters are not unique");
+
+		const auto handler{ table.Find(hash) };
+		if (handler == nullptr) [[unlikely]] {
+			return false;
+		}
+
+		(this->*handler)(connection, data, object);
+		return true;
+	}
+
 	/**************************
 	 * @brief Specific distributor collect function manage two types of income data: Filter and filter object. 1)
 	 * When reserved Filter, distributor extract necessary data and wait for filter objects. 2) When filter object
@@ -802,7 +1315,7 @@ public:
 			const auto hash{ data.GetHash() };
 			const int streamId{ data.GetStreamId() };
 			std::pair<int, int> idAndConnection{ streamId, connection };
-			if (typeid(Filter<T>).hash_code() == hash) {
+			if (typeId_v<Filter<T>> == hash) {
 				if (m_filtersToStreamIdAndConnection.find(idAndConnection) != m_filtersToStreamIdAndConnection.end()) {
 					LOG_ERROR(
 						"Got not unique filter for stream id: " + _S(streamId) + ", connection: " + _S(connection));
@@ -812,12 +1325,13 @@ public:
 
 				const FilterBase* filter = reinterpret_cast<const FilterBase*>(object);
 				const auto streamObjectHash{ filter->GetStreamObjectHash() };
-				const auto filterObjectHash{ typeid(T).hash_code() };
+				const auto filterObjectHash{ typeId_v<T> };
 
 				const auto& streamData = m_streamDataToIdAndConnection
 											 .emplace(idAndConnection,
 												 StreamData{ connection, filter->GetType(), filter->Empty(),
-													 streamObjectHash, filter->GetFilterSize() })
+													 streamObjectHash, filter->GetFilterSize(),
+													 filter->GetLastSequence(), filter->GetEpoch() })
 											 .first->second;
 				m_filtersToStreamIdAndConnection.emplace(
 					idAndConnection, std::variant<Filter<Ts>...>(Filter<T>(*filter)));
@@ -836,7 +1350,7 @@ public:
 				return;
 			}
 
-			if (typeid(T).hash_code() == hash) {
+			if (typeId_v<T> == hash) {
 				auto [currentFilter, filtersEnd] = m_filtersToStreamIdAndConnection.equal_range(idAndConnection);
 				if (currentFilter == filtersEnd) {
 					LOG_ERROR("Reserved filter object without filter for stream id: " + _S(streamId)
@@ -904,6 +1418,48 @@ public:
 			"Application state is Paused, collect data: " + data.ToString() + ", connection: " + _S(connection));
 	}
 
+	/**************************
+	 * @brief Set sink which collects every new object, nullptr to disable.
+	 *
+	 * @param sink Writable pointer to sink, must outlive distributor or be reset.
+	 */
+	void SetSink(ISink* sink) noexcept { m_sink = sink; }
+
+	/**************************
+	 * @brief Enable sequencing and bounded replay ring for objects of specific type. Live stream reopened by client
+	 * with the last received sequence gets only missed objects if ring still contains all of them, otherwise
+	 * HandleNewStreamOpened is called for full snapshot.
+	 *
+	 * @attention Should be called before the first object of that type is sent.
+	 *
+	 * @param capacity Number of the last objects to keep, must be greater than 0.
+	 * @param filterPredicate Predicate for filter applied during replay.
+	 *
+	 * @tparam T Type of object.
+	 *
+	 * @return True if replay is enabled, false otherwise.
+	 */
+	template <typename T>
+		requires std::is_class_v<T>
+	bool EnableReplay(
+		const size_t capacity, const std::function<bool(const FilterBase* filter, const T& object)>& filterPredicate)
+	{
+		if (capacity == 0) {
+			LOG_ERROR("Replay ring capacity cannot be 0, hash: " + _S(typeId_v<T>));
+			return false;
+		}
+
+		if (!m_replayRingsToObjectHash
+				 .emplace(typeId_v<T>, std::make_unique<ReplayRing<T>>(this, capacity, filterPredicate))
+				 .second) {
+			LOG_WARNING("Replay is already enabled for hash: " + _S(typeId_v<T>));
+			return false;
+		}
+
+		LOG_PROTOCOL("Replay is enabled for hash: " + _S(typeId_v<T>) + ", capacity: " + _S(capacity));
+		return true;
+	}
+
 	/**************************
 	 * @brief Send old objects for particular stream.
 	 *
@@ -923,8 +1479,9 @@ public:
 	{
 		LOG_PROTOCOL("Try to send old objects for stream id: " + _S(streamId)
 			+ ", connection: " + _S(streamData.connection) + ", objects number: " + _S(objects.size()));
+		const auto sequence{ GetSequence(streamData.objectHash) };
 		for (const auto& object : objects) {
-			Send(streamId, object, streamData, filterPredicate);
+			Send(streamId, object, streamData, filterPredicate, sequence);
 		}
 	}
 
@@ -946,11 +1503,12 @@ public:
 	{
 		LOG_PROTOCOL(
 			"Try to send old object for stream id: " + _S(streamId) + ", connection: " + _S(streamData.connection));
-		Send(streamId, object, streamData, filterPredicate);
+		Send(streamId, object, streamData, filterPredicate, GetSequence(streamData.objectHash));
 	}
 
 	/**************************
-	 * @brief Send new object for all active streams.
+	 * @brief Send new object for all active streams, store it in replay ring if replay is enabled for object type and
+	 * pass it to sink if it is set.
 	 *
 	 * @param object Object for sending.
 	 * @param filterPredicate Predicate for filter.
@@ -962,13 +1520,47 @@ public:
 	template <typename T>
 		requires std::is_class_v<T>
 	void SendNewObject(
-		const T& object, const std::function<bool(const FilterBase* filter, const T& object)> filterPredicate) const
+		const T& object, const std::function<bool(const FilterBase* filter, const T& object)> filterPredicate)
 	{
-		LOG_PROTOCOL("Searching subscribers for hash: " + _S(typeid(T).hash_code()));
+		PublishNewObject(object, filterPredicate, [&object](const int connection, const Data& data) {
+			Protocol::Object::Send(connection, data, &object);
+		});
+	}
+
+	/**************************
+	 * @brief Store new object in replay ring if replay is enabled for object type, pass it to sink if it is set and
+	 * call sender for each active stream which filter passes object. Sender can keep connections and data to send
+	 * object later, for example after lock of caller is released.
+	 *
+	 * @param object Object for publishing.
+	 * @param filterPredicate Predicate for filter.
+	 * @param sender Sender of object, invocable with stream connection and data.
+	 *
+	 * @tparam T Type of object to publish.
+	 * @tparam S Type of sender.
+	 *
+	 * @todo Need to add support for multiple filters for one stream.
+	 */
+	template <typename T, typename S>
+		requires std::is_class_v<T> && std::invocable<S, int, const Data&>
+	void PublishNewObject(
+		const T& object, const std::function<bool(const FilterBase* filter, const T& object)>& filterPredicate,
+		S&& sender)
+	{
+		uint64_t sequence{ 0 };
+		if (const auto it{ m_replayRingsToObjectHash.find(typeId_v<T>) }; it != m_replayRingsToObjectHash.end()) {
+			sequence = static_cast<ReplayRing<T>*>(it->second.get())->Push(object);
+		}
+
+		if (m_sink != nullptr) {
+			m_sink->Collect({ 0, typeId_v<T>, sizeof(T), sequence }, &object);
+		}
+
+		LOG_PROTOCOL("Searching subscribers for hash: " + _S(typeId_v<T>));
 		auto [currentActiveStreamIt, endActiveStreamIt]
-			= m_activeStreamsToObjectHash.equal_range(typeid(T).hash_code());
+			= m_activeStreamsToObjectHash.equal_range(typeId_v<T>);
 		if (currentActiveStreamIt == endActiveStreamIt) {
-			LOG_PROTOCOL("Have not any active stream for hash: " + _S(typeid(T).hash_code()));
+			LOG_PROTOCOL("Have not any active stream for hash: " + _S(typeId_v<T>));
 			return;
 		}
 		bool send{ false };
@@ -993,7 +1585,7 @@ public:
 				}
 			}
 			else {
-				LOG_WARNING("Not fount any filter for stream id: " + _S(currentActiveStreamIt->second.first)
+				LOG_WARNING_LIMITED("Not fount any filter for stream id: " + _S(currentActiveStreamIt->second.first)
 					+ ", connection: " + _S(currentActiveStreamIt->second.second));
 			}
 
@@ -1001,8 +1593,8 @@ public:
 				if (const auto it = m_streamDataToIdAndConnection.find(currentActiveStreamIt->second);
 					it != m_streamDataToIdAndConnection.end()) {
 
-					Protocol::Object::Send(it->second.connection,
-						{ currentActiveStreamIt->second.first, it->second.objectHash, sizeof(T) }, &object);
+					sender(it->second.connection,
+						Data{ currentActiveStreamIt->second.first, it->second.objectHash, sizeof(T), sequence });
 				}
 				else {
 					LOG_ERROR("Didn't find data for stream id: " + _S(currentActiveStreamIt->second.first)
@@ -1016,6 +1608,19 @@ public:
 	}
 
 private:
+	using CollectHandler = void (Distributor::*)(int, const Data&, const void*);
+	using CollectTable = DispatchTable<CollectHandler, sizeof...(Ts) * 2>;
+
+	/**************************
+	 * @return Dispatch table from filter and filter object type identifiers to specific Collect function.
+	 */
+	static consteval CollectTable MakeCollectTable()
+	{
+		return CollectTable{ std::array<typename CollectTable::Entry, sizeof...(Ts) * 2>{
+			typename CollectTable::Entry{ typeId_v<Filter<Ts>>, &Distributor::template Collect<Ts> }...,
+			typename CollectTable::Entry{ typeId_v<Ts>, &Distributor::template Collect<Ts> }... } };
+	}
+
 	/**************************
 	 * @brief Callback about new stream opened action.
 	 *
@@ -1025,7 +1630,8 @@ private:
 	virtual void HandleNewStreamOpened(const int id, const StreamData& streamData) = 0;
 
 	/**************************
-	 * @brief Open stream for particular stream id.
+	 * @brief Open stream for particular stream id. Send missed objects from replay ring if client provided the last
+	 * received sequence and ring contains all objects after it, otherwise call HandleNewStreamOpened.
 	 *
 	 * @param id Stream id for which stream is opened.
 	 */
@@ -1049,10 +1655,12 @@ private:
 			m_activeStreamsToObjectHash.emplace(it->second.objectHash, idAndConnection);
 		}
 
-		StreamStateResponse state{ State::Opened };
-		const Data data{ idAndConnection.first, typeid(StreamStateResponse).hash_code(), sizeof(StreamStateResponse) };
+		StreamStateResponse state{ State::Opened, Issue::Empty, m_epoch };
+		const Data data{ idAndConnection.first, typeId_v<StreamStateResponse>, sizeof(StreamStateResponse) };
 		Protocol::Object::Send(it->second.connection, data, &state);
-		HandleNewStreamOpened(idAndConnection.first, it->second);
+		if (!Replay(idAndConnection.first, it->second)) {
+			HandleNewStreamOpened(idAndConnection.first, it->second);
+		}
 		state.state = State::Done;
 		Protocol::Object::Send(it->second.connection, data, &state);
 		if (onlySnapshot) {
@@ -1073,7 +1681,7 @@ private:
 
 		StreamStateResponse state{ State::Failed, issue };
 		Protocol::Object::Send(it->second.connection,
-			{ idAndConnection.first, typeid(StreamStateResponse).hash_code(), sizeof(StreamStateResponse) }, &state);
+			{ idAndConnection.first, typeId_v<StreamStateResponse>, sizeof(StreamStateResponse) }, &state);
 		RemoveInformationAboutStream(idAndConnection);
 	}
 
@@ -1083,6 +1691,7 @@ private:
 	 * @param id Stream id for which object is sent.
 	 * @param object Object for sending.
 	 * @param filterPredicate Predicate for filter.
+	 * @param sequence Sequence of object.
 	 *
 	 * @tparam T Type of object to send.
 	 *
@@ -1091,7 +1700,8 @@ private:
 	template <typename T>
 		requires std::is_class_v<T>
 	void Send(const int id, const T& object, const StreamData& streamData,
-		const std::function<bool(const FilterBase* filter, const T& object)>& filterPredicate) const
+		const std::function<bool(const FilterBase* filter, const T& object)>& filterPredicate,
+		const uint64_t sequence) const
 	{
 		bool send{ false };
 		if (auto [currentFilter, filterEnd]
@@ -1114,12 +1724,76 @@ private:
 			} while (currentFilter != filterEnd);
 		}
 		else {
-			LOG_WARNING("Not fount any filter for stream id: " + _S(id) + ", connection: " + _S(streamData.connection));
+			LOG_WARNING_LIMITED(
+				"Not fount any filter for stream id: " + _S(id) + ", connection: " + _S(streamData.connection));
 		}
 
 		if (send) {
-			Protocol::Object::Send(streamData.connection, { id, streamData.objectHash, sizeof(T) }, &object);
+			Protocol::Object::Send(streamData.connection, { id, streamData.objectHash, sizeof(T), sequence }, &object);
+		}
+	}
+
+	/**************************
+	 * @param objectHash Hash of object.
+	 *
+	 * @return Sequence of the last published object of type, 0 if replay is not enabled for it.
+	 */
+	uint64_t GetSequence(const size_t objectHash) const
+	{
+		const auto it{ m_replayRingsToObjectHash.find(objectHash) };
+		return it == m_replayRingsToObjectHash.end() ? 0 : it->second->GetSequence();
+	}
+
+	/**************************
+	 * @brief Send objects missed by client after the last received sequence.
+	 *
+	 * @param id Stream id for which objects are sent.
+	 * @param streamData Stream data with the last sequence received by client.
+	 *
+	 * @return True if missed objects are sent, false if full snapshot is required.
+	 */
+	bool Replay(const int id, const StreamData& streamData) const
+	{
+		if (streamData.lastSequence == 0 || streamData.type != Type::SnapshotAndLive) {
+			return false;
 		}
+
+		if (streamData.epoch != m_epoch) {
+			LOG_PROTOCOL_NEW("Stream epoch {} differs from distributor epoch {}, full snapshot is required for stream "
+							 "id: {}, connection: {}",
+				streamData.epoch, m_epoch, id, streamData.connection);
+			return false;
+		}
+
+		const auto it{ m_replayRingsToObjectHash.find(streamData.objectHash) };
+		if (it == m_replayRingsToObjectHash.end()) {
+			return false;
+		}
+
+		if (!it->second->Covers(streamData.lastSequence)) {
+			LOG_PROTOCOL_NEW("Replay ring does not contain objects after sequence {}, current sequence: {}, full "
+							 "snapshot is required for stream id: {}, connection: {}",
+				streamData.lastSequence, it->second->GetSequence(), id, streamData.connection);
+			return false;
+		}
+
+		LOG_PROTOCOL_NEW("Replay objects after sequence {} up to {} for stream id: {}, connection: {}",
+			streamData.lastSequence, it->second->GetSequence(), id, streamData.connection);
+		it->second->Replay(id, streamData);
+		return true;
+	}
+
+	/**************************
+	 * @return Epoch for new distributor instance, unique across processes and instances with high probability, never
+	 * 0.
+	 */
+	static uint64_t MakeEpoch() noexcept
+	{
+		static std::atomic<uint64_t> counter{};
+		const auto epoch{ Fnv1a(counter.fetch_add(1, std::memory_order_relaxed),
+			Fnv1a(static_cast<uint64_t>(getpid()),
+				static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count()))) };
+		return epoch == 0 ? 1 : epoch;
 	}
 
 	/**************************
@@ -1192,19 +1866,21 @@ public:
 		}
 		m_handler->RemoveStream(m_id);
 		StreamStateResponse state{ State::Removed };
-		Send(m_connection, { m_id, typeid(StreamStateResponse).hash_code(), sizeof(StreamStateResponse) }, &state);
+		Send(m_connection, { m_id, typeId_v<StreamStateResponse>, sizeof(StreamStateResponse) }, &state);
 	}
 
 	/**************************
-	 * @brief Set the Filter object, clear snapshot done flag and call Close() function if stream is opened.
+	 * @brief Set the Filter object, clear snapshot done flag and last sequence, call Close() function if stream is
+	 * opened.
 	 *
 	 * @param filter Filter to set.
 	 */
 	void SetFilter(const Filter<F>& filter)
 	{
 		m_snapshotDone = false;
+		m_lastSequence = 0;
 		m_filter = filter;
-		m_filter.SetStreamObjectHash(typeid(T).hash_code());
+		m_filter.SetStreamObjectHash(typeId_v<T>);
 		m_haveFilter = true;
 		LOG_PROTOCOL("Client sets filter for stream, id: " + _S(m_id) + ", filter: " + m_filter.ToString());
 		//* Close stream if we update filter for working stream
@@ -1214,7 +1890,8 @@ public:
 	}
 
 	/**************************
-	 * @brief Open stream if it is closed: failed or undefined stare. Required to set distributor connection.
+	 * @brief Open stream if it is closed: failed or undefined stare. Required to set distributor connection. Live
+	 * stream which already received objects requests only missed ones.
 	 *
 	 * @return True if stream is opened, false if stream empty, if does not filter or any issue happen.
 	 */
@@ -1233,12 +1910,15 @@ public:
 			return false;
 		}
 		m_state = State::Pending;
+		//* Only live stream can be resumed from the last received object
+		m_filter.SetLastSequence(m_filter.GetType() == Type::SnapshotAndLive ? m_lastSequence : 0);
+		m_filter.SetEpoch(m_epoch);
 		LOG_PROTOCOL("Client opens stream, id: " + _S(m_id) + ", filter: " + m_filter.ToString());
 
 		//* First we send base filter options
-		Send(m_connection, { m_id, typeid(Filter<F>).hash_code(), sizeof(FilterBase) }, m_filter.GetBase());
+		Send(m_connection, { m_id, typeId_v<Filter<F>>, sizeof(FilterBase) }, m_filter.GetBase());
 		//* Next we send all filter objects
-		const auto filterObjectHash{ typeid(F).hash_code() };
+		const auto filterObjectHash{ typeId_v<F> };
 		for (const auto& item : m_filter.GetObjects()) {
 			Send(m_connection, { m_id, filterObjectHash, sizeof(F) }, &item);
 		}
@@ -1257,7 +1937,8 @@ public:
 		LOG_PROTOCOL("Client closes stream, id: " + _S(m_id));
 		m_snapshotDone = false;
 		m_state = State::Closed;
-		Send(m_connection, { m_id, typeid(StreamStateResponse).hash_code(), sizeof(StreamStateResponse) }, &m_state);
+		StreamStateResponse state{ State::Closed, Issue::Empty, 0 };
+		Send(m_connection, { m_id, typeId_v<StreamStateResponse>, sizeof(StreamStateResponse) }, &state);
 	}
 };
 
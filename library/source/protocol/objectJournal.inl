@@ -0,0 +1,961 @@
+/**************************
+ * @file        objectJournal.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ *
+ * @brief Append-only memory-mapped journal of objects published by object protocol distributor and reader which
+ * replays journal into handlers.
+ *
+ * @brief Journal consists of segments with fixed size, each segment is a pair of files: "<name>_<number>.journal" with
+ * records and "<name>_<number>.index" with sparse index. Numbers are zero-padded to 10 digits, so lexical order of
+ * files is the order of segments.
+ *
+ * @brief Segment file starts with 64 bytes header, records follow it. Record is timestamp in nanoseconds (8 bytes),
+ * frame size (4 bytes), reserved (4 bytes) and packed object protocol Data frame, padded to 8 bytes. Zero frame size
+ * marks the end of records.
+ *
+ * @brief Index file is an array of { timestamp, sequence, offset } entries, one per index interval of bytes in
+ * segment. Index is used to skip segments and records before requested time, missed index leads to full scan of
+ * segment.
+ */
+
+#ifndef MSAPI_PROTOCOL_OBJECT_JOURNAL_INL
+#define MSAPI_PROTOCOL_OBJECT_JOURNAL_INL
+
+#include "../help/io.inl"
+#include "object.h"
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <thread>
+
+namespace MSAPI {
+
+namespace Protocol {
+
+namespace Object {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Sink for distributor which appends every published object to memory-mapped segments. Publishing thread only
+ * copies frame into mapped memory and publishes written offset with atomic store. Dedicated flusher pthread sleeps
+ * on condition variable until the first record after previous flush, then syncs written ranges by msync in batches,
+ * builds sparse index, closes filled segments and prepares the next segment in advance, so rotation on publishing
+ * thread is an atomic pointer exchange.
+ *
+ * @attention Append must be called from one thread at time and must not be called concurrently with Start and Stop.
+ *
+ * @brief If next segment is not prepared yet when current one is filled, Append wakes flusher and waits for the
+ * segment. Frame is dropped and counted only if flusher could not prepare it.
+ */
+class Journal final : public ISink {
+public:
+	static constexpr uint64_t MAGIC{ 0x4E524A495041534D }; //* "MSAPIJRN"
+	static constexpr uint32_t VERSION{ 1 };
+	static constexpr size_t FILE_HEADER_SIZE{ 64 };
+	static constexpr size_t RECORD_HEADER_SIZE{ 16 };
+
+	/**************************
+	 * @brief Header of segment file.
+	 */
+	struct FileHeader {
+		uint64_t magic;
+		uint32_t version;
+		uint32_t reserved;
+		uint64_t segmentNumber;
+		int64_t created;
+		uint8_t padding[32];
+	};
+
+	static_assert(sizeof(FileHeader) == FILE_HEADER_SIZE, "Journal file header size is changed");
+
+	/**************************
+	 * @brief Entry of sparse index of segment.
+	 */
+	struct IndexEntry {
+		int64_t timestamp;
+		uint64_t sequence;
+		uint64_t offset;
+	};
+
+private:
+	/**************************
+	 * @brief Mapped segment with its files. Written offset is updated by publishing thread, other fields are used only
+	 * by flusher.
+	 */
+	struct Segment {
+		uint64_t number{ 0 };
+		IO::FileDescriptor::ExitGuard file;
+		IO::FileDescriptor::ExitGuard indexFile;
+		uint8_t* memory{ nullptr };
+		size_t size{ 0 };
+		std::atomic<size_t> written{ FILE_HEADER_SIZE };
+		size_t synced{ 0 };
+		size_t indexed{ FILE_HEADER_SIZE };
+		size_t lastIndexOffset{ 0 };
+		bool hasIndex{ false };
+
+		/**************************
+		 * @brief Unmap memory of segment, files are closed by guards.
+		 */
+		FORCE_INLINE ~Segment();
+	};
+
+	const std::string m_dir;
+	const std::string m_name;
+	const size_t m_segmentSize;
+	const size_t m_indexInterval;
+	const uint32_t m_flushIntervalMs;
+	const size_t m_pageSize{ static_cast<size_t>(sysconf(_SC_PAGESIZE)) };
+	std::atomic<Segment*> m_current{ nullptr };
+	std::atomic<Segment*> m_next{ nullptr };
+	std::atomic<Segment*> m_sealed{ nullptr };
+	std::atomic<bool> m_running{ false };
+	std::atomic<uint64_t> m_droppedFrames{ 0 };
+	std::atomic<bool> m_flushPending{ false };
+	uint64_t m_segmentNumber{ 0 };
+	pthread_t m_flusher{};
+	std::mutex m_flushMutex;
+	std::condition_variable m_flushCondition;
+	std::condition_variable m_segmentCondition;
+	bool m_segmentRequested{ false };
+	uint64_t m_flushIterations{ 0 };
+
+public:
+	/**************************
+	 * @brief Construct a new Journal object, empty constructor.
+	 *
+	 * @param dir Directory of journal, must end with '/'. Will be created on start if it does not exist.
+	 * @param name Name of journal, prefix of segment files.
+	 * @param segmentSize Size of each segment file in bytes, default is 64 megabytes.
+	 * @param indexInterval Number of bytes between sparse index entries, default is 64 kilobytes.
+	 * @param flushIntervalMs Milliseconds which flusher waits after the first record to sync records in one batch,
+	 * default is 10.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE Journal(std::string_view dir, std::string_view name, size_t segmentSize = 64 * 1024 * 1024,
+		size_t indexInterval = 64 * 1024, uint32_t flushIntervalMs = 10);
+
+	const Journal& operator=(const Journal&) = delete;
+	Journal(const Journal&) = delete;
+
+	/**************************
+	 * @brief Call Stop on destruction.
+	 */
+	FORCE_INLINE ~Journal();
+
+	/**************************
+	 * @brief Create directory if it does not exist, map the first and the next segments after existing ones and start
+	 * flusher pthread.
+	 *
+	 * @return True if journal is started, false otherwise.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] bool Start();
+
+	/**************************
+	 * @brief Stop flusher pthread, sync and close all segments. Prepared but unused segment is removed.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void Stop();
+
+	/**************************
+	 * @return True if journal is started.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] bool IsRunning() const noexcept;
+
+	/**************************
+	 * @brief Append frame to current segment, switch to prepared segment if current one does not have enough space.
+	 * Wait for flusher if the next segment is not prepared yet.
+	 *
+	 * @param data Data of object.
+	 * @param object Object to append.
+	 *
+	 * @return True if frame is appended, false if journal is not started, frame is bigger than segment or flusher
+	 * could not prepare the next segment.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE bool Append(const Data& data, const void* object) noexcept;
+
+	//* ISink
+	FORCE_INLINE void Collect(const Data& data, const void* object) final;
+
+	/**************************
+	 * @return Number of frames which were not appended.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] uint64_t GetDroppedFrames() const noexcept;
+
+	/**************************
+	 * @param frameSize Size of packed frame.
+	 *
+	 * @return Size of record with header and padding.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static constexpr size_t GetRecordSize(size_t frameSize) noexcept;
+
+	/**************************
+	 * @param dir Directory of journal.
+	 * @param name Name of journal.
+	 * @param number Number of segment.
+	 * @param index True for index file, false for records file.
+	 *
+	 * @return Full path to segment file.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static std::string GetSegmentPath(
+		std::string_view dir, std::string_view name, uint64_t number, bool index);
+
+	/**************************
+	 * @param name Name of journal.
+	 * @param file Name of file.
+	 *
+	 * @return Number of segment if file is a records file of journal, empty otherwise.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static std::optional<uint64_t> ParseSegmentNumber(
+		std::string_view name, std::string_view file) noexcept;
+
+private:
+	/**************************
+	 * @brief Create, allocate and map segment file, write file header and open index file.
+	 *
+	 * @param number Number of segment.
+	 *
+	 * @return Writable pointer to segment, nullptr if something went wrong.
+	 */
+	FORCE_INLINE [[nodiscard]] Segment* CreateSegment(uint64_t number) const;
+
+	/**************************
+	 * @brief Sync written range of segment and add sparse index entries for new records.
+	 *
+	 * @param segment Segment to flush.
+	 */
+	FORCE_INLINE void Flush(Segment* segment) const;
+
+	/**************************
+	 * @brief Close sealed segment, flush current one and prepare the next one if it was taken.
+	 */
+	FORCE_INLINE void FlushIteration();
+
+	/**************************
+	 * @brief Wake flusher and wait until it prepares the next segment or completes full iteration without it.
+	 *
+	 * @return Writable pointer to the next segment, nullptr if it is not prepared or journal is stopped.
+	 */
+	FORCE_INLINE [[nodiscard]] Segment* WaitNextSegment();
+
+	/**************************
+	 * @brief Handling function for flusher pthread.
+	 *
+	 * @param journal Writable pointer to journal.
+	 *
+	 * @return Always nullptr.
+	 */
+	FORCE_INLINE static void* FlusherRunner(void* journal);
+};
+
+/**************************
+ * @brief Reader of journal segments, replays records of time range into callback or object protocol handler.
+ */
+class JournalReader {
+public:
+	enum class Pace : int8_t { Undefined, MaxSpeed, RealTime, Max };
+
+private:
+	const std::string m_dir;
+	const std::string m_name;
+	std::vector<std::string> m_segments;
+
+public:
+	/**************************
+	 * @brief Construct a new Journal Reader object, empty constructor.
+	 *
+	 * @param dir Directory of journal, must end with '/'.
+	 * @param name Name of journal.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE JournalReader(std::string_view dir, std::string_view name);
+
+	/**************************
+	 * @brief Find all segments of journal in directory.
+	 *
+	 * @return True if directory is listed, false otherwise.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] bool Open();
+
+	/**************************
+	 * @return Full paths of found segment files in order.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] const std::vector<std::string>& GetSegments() const noexcept;
+
+	/**************************
+	 * @brief Replay records with timestamp in range [from, to] into callback. Records are expected to be ordered by
+	 * time.
+	 *
+	 * @tparam F Type of callback, invocable with timestamp, Data and object pointer.
+	 *
+	 * @param from Begin of time range in nanoseconds since epoch.
+	 * @param to End of time range in nanoseconds since epoch.
+	 * @param pace Max speed or real-time pace which keeps intervals between records.
+	 * @param collect Callback for each record.
+	 *
+	 * @return Number of replayed records.
+	 *
+	 * @test Has unit test.
+	 */
+	template <typename F>
+		requires std::is_invocable_v<F, int64_t, const Data&, const void*>
+	FORCE_INLINE size_t Replay(int64_t from, int64_t to, Pace pace, F&& collect) const;
+
+	/**************************
+	 * @brief Replay records with timestamp in range [from, to] into handler of stream. Stream id of records is
+	 * replaced by id of stream, so stream must be known by handler.
+	 *
+	 * @tparam Ts Types of objects which handler can handle.
+	 * @tparam H Type of handler.
+	 *
+	 * @param handler Handler for collect.
+	 * @param streamId Id of stream which handler knows.
+	 * @param from Begin of time range in nanoseconds since epoch.
+	 * @param to End of time range in nanoseconds since epoch.
+	 * @param pace Max speed or real-time pace which keeps intervals between records.
+	 *
+	 * @return Number of replayed records.
+	 */
+	template <typename... Ts, typename H>
+		requires(std::is_base_of_v<IHandler<Ts>, H> && ...)
+	FORCE_INLINE size_t Replay(H* handler, int streamId, int64_t from, int64_t to, Pace pace) const;
+
+	/**************************
+	 * @return String interpretation of pace enum.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static constexpr std::string_view EnumToString(Pace pace);
+
+	/**************************
+	 * @param path Full path to segment records file.
+	 *
+	 * @return Sparse index entries of segment, empty if index file is missed.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static std::vector<Journal::IndexEntry> ReadIndex(std::string_view path);
+};
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+FORCE_INLINE Journal::Segment::~Segment()
+{
+	if (memory != nullptr && munmap(memory, size) == -1) [[unlikely]] {
+		LOG_ERROR_NEW("Journal segment {} unmap fail. Error №{}: {}", number, errno, std::strerror(errno));
+	}
+}
+
+FORCE_INLINE Journal::Journal(const std::string_view dir, const std::string_view name, const size_t segmentSize,
+	const size_t indexInterval, const uint32_t flushIntervalMs)
+	: m_dir{ dir }
+	, m_name{ name }
+	, m_segmentSize{ segmentSize }
+	, m_indexInterval{ indexInterval }
+	, m_flushIntervalMs{ flushIntervalMs }
+{
+}
+
+FORCE_INLINE Journal::~Journal() { Stop(); }
+
+FORCE_INLINE [[nodiscard]] bool Journal::Start()
+{
+	if (m_running.load(std::memory_order_acquire)) {
+		LOG_WARNING("Journal is already running: " + m_dir + m_name);
+		return false;
+	}
+
+	if (m_segmentSize < FILE_HEADER_SIZE + RECORD_HEADER_SIZE + Data::HEADER_SIZE) [[unlikely]] {
+		LOG_ERROR_NEW("Journal segment size {} is too small", m_segmentSize);
+		return false;
+	}
+
+	if (!IO::HasPath(m_dir.c_str()) && !IO::CreateDir(m_dir.c_str())) [[unlikely]] {
+		LOG_ERROR("Cannot create journal directory: " + m_dir);
+		return false;
+	}
+
+	//* Journal is append-only, new segments follow existing ones
+	std::vector<std::string> files;
+	if (!IO::List<IO::FileType::Regular>(files, m_dir.c_str())) [[unlikely]] {
+		return false;
+	}
+	m_segmentNumber = 0;
+	for (const auto& file : files) {
+		if (const auto number{ ParseSegmentNumber(m_name, file) }; number.has_value() && *number > m_segmentNumber) {
+			m_segmentNumber = *number;
+		}
+	}
+
+	std::unique_ptr<Segment> current{ CreateSegment(++m_segmentNumber) };
+	if (current == nullptr) [[unlikely]] {
+		return false;
+	}
+	std::unique_ptr<Segment> next{ CreateSegment(++m_segmentNumber) };
+	if (next == nullptr) [[unlikely]] {
+		return false;
+	}
+
+	m_current.store(current.release(), std::memory_order_release);
+	m_next.store(next.release(), std::memory_order_release);
+	m_flushPending.store(false, std::memory_order_relaxed);
+	m_segmentRequested = false;
+	m_flushIterations = 0;
+	m_running.store(true, std::memory_order_release);
+
+	if (const auto result{ pthread_create(&m_flusher, nullptr, FlusherRunner, static_cast<void*>(this)) };
+		result != 0) [[unlikely]] {
+
+		LOG_ERROR_NEW("Pthread for journal flusher is not created. Error №{}: {}", result, std::strerror(result));
+		m_running.store(false, std::memory_order_release);
+		delete m_current.exchange(nullptr, std::memory_order_acq_rel);
+		delete m_next.exchange(nullptr, std::memory_order_acq_rel);
+		return false;
+	}
+
+	LOG_INFO_NEW("Journal {}{} is started from segment {}", m_dir, m_name, m_segmentNumber - 1);
+	return true;
+}
+
+FORCE_INLINE void Journal::Stop()
+{
+	{
+		//* Flag is changed under mutex, so sleeping flusher and appender can't miss it
+		const std::lock_guard<std::mutex> _{ m_flushMutex };
+		if (!m_running.exchange(false, std::memory_order_acq_rel)) {
+			return;
+		}
+	}
+	m_flushCondition.notify_all();
+	m_segmentCondition.notify_all();
+
+	if (const auto result{ pthread_join(m_flusher, nullptr) }; result != 0) [[unlikely]] {
+		LOG_ERROR_NEW("Pthread for journal flusher is not joined. Error №{}: {}", result, std::strerror(result));
+	}
+
+	if (Segment* sealed{ m_sealed.exchange(nullptr, std::memory_order_acq_rel) }; sealed != nullptr) {
+		Flush(sealed);
+		delete sealed;
+	}
+
+	if (Segment* current{ m_current.exchange(nullptr, std::memory_order_acq_rel) }; current != nullptr) {
+		Flush(current);
+		delete current;
+	}
+
+	//* Unused segment must not be left as a gap with empty records
+	if (Segment* next{ m_next.exchange(nullptr, std::memory_order_acq_rel) }; next != nullptr) {
+		const auto number{ next->number };
+		delete next;
+		(void)IO::Remove(GetSegmentPath(m_dir, m_name, number, false));
+		(void)IO::Remove(GetSegmentPath(m_dir, m_name, number, true));
+	}
+
+	LOG_INFO_NEW("Journal {}{} is stopped, dropped frames: {}", m_dir, m_name,
+		m_droppedFrames.load(std::memory_order_relaxed));
+}
+
+FORCE_INLINE [[nodiscard]] bool Journal::IsRunning() const noexcept
+{
+	return m_running.load(std::memory_order_acquire);
+}
+
+FORCE_INLINE bool Journal::Append(const Data& data, const void* object) noexcept
+{
+	Segment* segment{ m_current.load(std::memory_order_relaxed) };
+	if (segment == nullptr) [[unlikely]] {
+		m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	const size_t frameSize{ data.GetBufferSize() };
+	const size_t recordSize{ GetRecordSize(frameSize) };
+	size_t offset{ segment->written.load(std::memory_order_relaxed) };
+	if (offset + recordSize > segment->size) [[unlikely]] {
+		if (FILE_HEADER_SIZE + recordSize > m_segmentSize) [[unlikely]] {
+			m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+			LOG_WARNING_NEW_LIMITED("Journal frame of {} bytes is bigger than segment", frameSize);
+			return false;
+		}
+
+		Segment* next{ m_next.exchange(nullptr, std::memory_order_acq_rel) };
+		if (next == nullptr && (next = WaitNextSegment()) == nullptr) [[unlikely]] {
+			m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+			LOG_WARNING_LIMITED("Journal frame is dropped, the next segment is not prepared");
+			return false;
+		}
+
+		m_sealed.store(segment, std::memory_order_release);
+		m_current.store(next, std::memory_order_release);
+		segment = next;
+		offset = FILE_HEADER_SIZE;
+	}
+
+	uint8_t* const record{ segment->memory + offset };
+	const int64_t timestamp{ Timer{}.GetNanoseconds() };
+	memcpy(record, &timestamp, sizeof(int64_t));
+	data.PackData(record + RECORD_HEADER_SIZE, object);
+	//* Frame size is written last, non-zero value means record is complete
+	std::atomic_ref<uint32_t>{ *reinterpret_cast<uint32_t*>(record + sizeof(int64_t)) }.store(
+		static_cast<uint32_t>(frameSize), std::memory_order_release);
+	segment->written.store(offset + recordSize, std::memory_order_release);
+
+	//* Only the first record after flush wakes up flusher, next records of the same interval are added silently
+	if (!m_flushPending.exchange(true, std::memory_order_acq_rel)) {
+		{
+			const std::lock_guard<std::mutex> _{ m_flushMutex };
+		}
+		m_flushCondition.notify_one();
+	}
+	return true;
+}
+
+FORCE_INLINE void Journal::Collect(const Data& data, const void* object) { (void)Append(data, object); }
+
+FORCE_INLINE [[nodiscard]] uint64_t Journal::GetDroppedFrames() const noexcept
+{
+	return m_droppedFrames.load(std::memory_order_relaxed);
+}
+
+FORCE_INLINE [[nodiscard]] constexpr size_t Journal::GetRecordSize(const size_t frameSize) noexcept
+{
+	return (RECORD_HEADER_SIZE + frameSize + 7) & ~size_t{ 7 };
+}
+
+FORCE_INLINE [[nodiscard]] std::string Journal::GetSegmentPath(
+	const std::string_view dir, const std::string_view name, const uint64_t number, const bool index)
+{
+	return std::format("{}{}_{:010}.{}", dir, name, number, index ? "index" : "journal");
+}
+
+FORCE_INLINE [[nodiscard]] std::optional<uint64_t> Journal::ParseSegmentNumber(
+	const std::string_view name, const std::string_view file) noexcept
+{
+	static constexpr std::string_view extension{ ".journal" };
+	if (file.size() != name.size() + 1 + 10 + extension.size() || !file.starts_with(name)
+		|| file[name.size()] != '_' || !file.ends_with(extension)) {
+
+		return {};
+	}
+
+	uint64_t number;
+	const char* const begin{ file.data() + name.size() + 1 };
+	const auto [ptr, error]{ std::from_chars(begin, begin + 10, number) };
+	if (error != std::errc{} || ptr != begin + 10) [[unlikely]] {
+		return {};
+	}
+
+	return number;
+}
+
+FORCE_INLINE [[nodiscard]] Journal::Segment* Journal::CreateSegment(const uint64_t number) const
+{
+	auto segment{ std::make_unique<Segment>() };
+	segment->number = number;
+	segment->size = m_segmentSize;
+
+	const auto path{ GetSegmentPath(m_dir, m_name, number, false) };
+	segment->file = IO::FileDescriptor::ExitGuard{ path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644 };
+	if (segment->file.value == -1) [[unlikely]] {
+		LOG_ERROR_NEW("Journal segment {} is not opened. Error №{}: {}", path, errno, std::strerror(errno));
+		return nullptr;
+	}
+
+	if (const auto result{ posix_fallocate(segment->file.value, 0, static_cast<off_t>(m_segmentSize)) }; result != 0)
+		[[unlikely]] {
+
+		LOG_ERROR_NEW("Journal segment {} is not allocated. Error №{}: {}", path, result, std::strerror(result));
+		segment.reset();
+		(void)IO::Remove(path);
+		return nullptr;
+	}
+
+	void* const memory{ mmap(nullptr, m_segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, segment->file.value, 0) };
+	if (memory == MAP_FAILED) [[unlikely]] {
+		LOG_ERROR_NEW("Journal segment {} is not mapped. Error №{}: {}", path, errno, std::strerror(errno));
+		segment.reset();
+		(void)IO::Remove(path);
+		return nullptr;
+	}
+	segment->memory = static_cast<uint8_t*>(memory);
+
+	const FileHeader header{ MAGIC, VERSION, 0, number, Timer{}.GetNanoseconds(), {} };
+	memcpy(segment->memory, &header, sizeof(FileHeader));
+
+	const auto indexPath{ GetSegmentPath(m_dir, m_name, number, true) };
+	segment->indexFile = IO::FileDescriptor::ExitGuard{ indexPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 };
+	if (segment->indexFile.value == -1) [[unlikely]] {
+		//* Segment is still readable without index
+		LOG_WARNING_NEW("Journal index {} is not opened. Error №{}: {}", indexPath, errno, std::strerror(errno));
+	}
+
+	LOG_DEBUG_NEW("Journal segment {} is created", path);
+	return segment.release();
+}
+
+FORCE_INLINE void Journal::Flush(Segment* const segment) const
+{
+	const size_t written{ segment->written.load(std::memory_order_acquire) };
+	if (written <= segment->synced) {
+		return;
+	}
+
+	const size_t begin{ segment->synced & ~(m_pageSize - 1) };
+	if (msync(segment->memory + begin, written - begin, MS_SYNC) == -1) [[unlikely]] {
+		LOG_ERROR_NEW("Journal segment {} sync fail. Error №{}: {}", segment->number, errno, std::strerror(errno));
+	}
+	segment->synced = written;
+
+	while (segment->indexed < written) {
+		const uint8_t* const record{ segment->memory + segment->indexed };
+		uint32_t frameSize;
+		memcpy(&frameSize, record + sizeof(int64_t), sizeof(uint32_t));
+
+		if (!segment->hasIndex || segment->indexed - segment->lastIndexOffset >= m_indexInterval) {
+			IndexEntry entry{ 0, 0, segment->indexed };
+			memcpy(&entry.timestamp, record, sizeof(int64_t));
+			memcpy(&entry.sequence, record + RECORD_HEADER_SIZE + Data::HEADER_SIZE - sizeof(uint64_t),
+				sizeof(uint64_t));
+			if (segment->indexFile.value != -1 && write(segment->indexFile.value, &entry, sizeof(IndexEntry)) == -1)
+				[[unlikely]] {
+
+				LOG_ERROR_NEW(
+					"Journal index {} write fail. Error №{}: {}", segment->number, errno, std::strerror(errno));
+			}
+			segment->lastIndexOffset = segment->indexed;
+			segment->hasIndex = true;
+		}
+
+		segment->indexed += GetRecordSize(frameSize);
+	}
+}
+
+FORCE_INLINE void Journal::FlushIteration()
+{
+	//* Sealed segment is taken first, current segment can be sealed only after it and is closed on next iteration
+	if (Segment* sealed{ m_sealed.exchange(nullptr, std::memory_order_acq_rel) }; sealed != nullptr) {
+		Flush(sealed);
+		LOG_DEBUG_NEW("Journal segment {} is closed", sealed->number);
+		delete sealed;
+	}
+
+	Flush(m_current.load(std::memory_order_acquire));
+
+	//* The next segment is prepared only when sealed slot is free, so one rotation can't overwrite another
+	if (m_next.load(std::memory_order_acquire) == nullptr && m_sealed.load(std::memory_order_acquire) == nullptr) {
+		if (Segment* next{ CreateSegment(++m_segmentNumber) }; next != nullptr) {
+			m_next.store(next, std::memory_order_release);
+		}
+	}
+}
+
+FORCE_INLINE [[nodiscard]] Journal::Segment* Journal::WaitNextSegment()
+{
+	std::unique_lock<std::mutex> lock{ m_flushMutex };
+	m_segmentRequested = true;
+	m_flushCondition.notify_one();
+
+	//* Iteration in progress could miss the rotation, the second one starts after request
+	const uint64_t iterations{ m_flushIterations + 2 };
+	m_segmentCondition.wait(lock, [this, iterations]() {
+		return m_next.load(std::memory_order_acquire) != nullptr || m_flushIterations >= iterations
+			|| !m_running.load(std::memory_order_acquire);
+	});
+	return m_next.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+FORCE_INLINE void* Journal::FlusherRunner(void* const journal)
+{
+	auto* const self{ static_cast<Journal*>(journal) };
+	LOG_DEBUG_NEW("Journal flusher is started, PID: {}", gettid());
+	const auto isStopped{ [self]() { return !self->m_running.load(std::memory_order_acquire); } };
+	const auto isInterrupted{ [self, &isStopped]() { return self->m_segmentRequested || isStopped(); } };
+	std::unique_lock<std::mutex> lock{ self->m_flushMutex };
+	while (true) {
+		self->m_flushCondition.wait(lock, [self, &isInterrupted]() {
+			return self->m_flushPending.load(std::memory_order_acquire) || isInterrupted();
+		});
+		if (isStopped()) {
+			break;
+		}
+
+		//* Records of the interval are synced together, waiting appender does not wait for the interval
+		(void)self->m_flushCondition.wait_for(
+			lock, std::chrono::milliseconds(self->m_flushIntervalMs), isInterrupted);
+		//* Records appended after this point announce themselves again and are flushed by the next round
+		self->m_flushPending.store(false, std::memory_order_release);
+		self->m_segmentRequested = false;
+		lock.unlock();
+		self->FlushIteration();
+		lock.lock();
+		++self->m_flushIterations;
+		self->m_segmentCondition.notify_all();
+	}
+
+	LOG_DEBUG_NEW("Journal flusher is finished, PID: {}", gettid());
+	return nullptr;
+}
+
+FORCE_INLINE JournalReader::JournalReader(const std::string_view dir, const std::string_view name)
+	: m_dir{ dir }
+	, m_name{ name }
+{
+}
+
+FORCE_INLINE [[nodiscard]] bool JournalReader::Open()
+{
+	std::vector<std::string> files;
+	if (!IO::List<IO::FileType::Regular>(files, m_dir.c_str())) [[unlikely]] {
+		return false;
+	}
+
+	m_segments.clear();
+	for (const auto& file : files) {
+		if (Journal::ParseSegmentNumber(m_name, file).has_value()) {
+			m_segments.emplace_back(m_dir + file);
+		}
+	}
+	std::sort(m_segments.begin(), m_segments.end());
+
+	LOG_DEBUG_NEW("Journal {}{} has {} segments", m_dir, m_name, m_segments.size());
+	return true;
+}
+
+FORCE_INLINE [[nodiscard]] const std::vector<std::string>& JournalReader::GetSegments() const noexcept
+{
+	return m_segments;
+}
+
+template <typename F>
+	requires std::is_invocable_v<F, int64_t, const Data&, const void*>
+FORCE_INLINE size_t JournalReader::Replay(const int64_t from, const int64_t to, const Pace pace, F&& collect) const
+{
+	struct MappedSegment {
+		IO::FileDescriptor::ExitGuard file;
+		const uint8_t* memory{ nullptr };
+		size_t size{ 0 };
+
+		FORCE_INLINE ~MappedSegment()
+		{
+			if (memory != nullptr) {
+				munmap(const_cast<uint8_t*>(memory), size);
+			}
+		}
+	};
+
+	std::vector<std::vector<Journal::IndexEntry>> indexes;
+	indexes.reserve(m_segments.size());
+	for (const auto& segment : m_segments) {
+		indexes.emplace_back(ReadIndex(segment));
+	}
+
+	size_t collected{ 0 };
+	bool paced{ false };
+	int64_t firstTimestamp{ 0 };
+	std::chrono::steady_clock::time_point begin;
+
+	for (size_t index{ 0 }; index < m_segments.size(); ++index) {
+		//* Segment can be skipped if the next one starts not later than range
+		if (index + 1 < m_segments.size() && !indexes[index + 1].empty()
+			&& indexes[index + 1].front().timestamp <= from) {
+
+			continue;
+		}
+
+		MappedSegment segment{ IO::FileDescriptor::ExitGuard{ m_segments[index].c_str(), O_RDONLY, 0 } };
+		if (segment.file.value == -1) [[unlikely]] {
+			LOG_ERROR_NEW("Journal segment {} is not opened. Error №{}: {}", m_segments[index], errno,
+				std::strerror(errno));
+			continue;
+		}
+
+		struct stat status;
+		if (fstat(segment.file.value, &status) == -1 || UINT64(status.st_size) < Journal::FILE_HEADER_SIZE)
+			[[unlikely]] {
+
+			LOG_ERROR("Journal segment has invalid size: " + m_segments[index]);
+			continue;
+		}
+
+		segment.size = UINT64(status.st_size);
+		void* const memory{ mmap(nullptr, segment.size, PROT_READ, MAP_SHARED, segment.file.value, 0) };
+		if (memory == MAP_FAILED) [[unlikely]] {
+			LOG_ERROR_NEW("Journal segment {} is not mapped. Error №{}: {}", m_segments[index], errno,
+				std::strerror(errno));
+			continue;
+		}
+		segment.memory = static_cast<const uint8_t*>(memory);
+
+		Journal::FileHeader header;
+		memcpy(&header, segment.memory, sizeof(Journal::FileHeader));
+		if (header.magic != Journal::MAGIC || header.version != Journal::VERSION) [[unlikely]] {
+			LOG_ERROR("Journal segment has invalid header: " + m_segments[index]);
+			continue;
+		}
+
+		size_t offset{ Journal::FILE_HEADER_SIZE };
+		for (const auto& entry : indexes[index]) {
+			if (entry.timestamp > from) {
+				break;
+			}
+			offset = entry.offset;
+		}
+
+		while (offset + Journal::RECORD_HEADER_SIZE <= segment.size) {
+			const uint8_t* const record{ segment.memory + offset };
+			uint32_t frameSize;
+			memcpy(&frameSize, record + sizeof(int64_t), sizeof(uint32_t));
+			if (frameSize == 0) {
+				break;
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (offset + Journal::RECORD_HEADER_SIZE + frameSize > segment.size || frameSize < Data::HEADER_SIZE)
+				[[unlikely]] {
+
+				LOG_ERROR_NEW("Journal segment {} has corrupted record on offset {}", m_segments[index], offset);
+				break;
+			}
+
+			int64_t timestamp;
+			memcpy(&timestamp, record, sizeof(int64_t));
+			if (timestamp > to) {
+				return collected;
+			}
+
+			if (timestamp >= from) {
+				if (pace == Pace::RealTime) {
+					if (!paced) {
+						paced = true;
+						firstTimestamp = timestamp;
+						begin = std::chrono::steady_clock::now();
+					}
+					else {
+						std::this_thread::sleep_until(begin + std::chrono::nanoseconds(timestamp - firstTimestamp));
+					}
+				}
+
+				void* const frame{ const_cast<uint8_t*>(record + Journal::RECORD_HEADER_SIZE) };
+				const Data data{ DataHeader{ frame }, frame };
+				void* object;
+				Data::UnpackData(&object, frame);
+				collect(timestamp, data, static_cast<const void*>(object));
+				++collected;
+			}
+
+			offset += Journal::GetRecordSize(frameSize);
+		}
+	}
+
+	return collected;
+}
+
+template <typename... Ts, typename H>
+	requires(std::is_base_of_v<IHandler<Ts>, H> && ...)
+FORCE_INLINE size_t JournalReader::Replay(
+	H* const handler, const int streamId, const int64_t from, const int64_t to, const Pace pace) const
+{
+	return Replay(from, to, pace, [handler, streamId](int64_t, const Data& data, const void* object) {
+		const Data streamData{ streamId, data.GetHash(), data.GetBufferSize() - Data::HEADER_SIZE, data.GetSequence() };
+		if (!Collect<Ts...>(handler, streamData, object)) [[unlikely]] {
+			LOG_WARNING_LIMITED("Journal record with unknown hash: " + _S(data.GetHash()));
+		}
+	});
+}
+
+FORCE_INLINE [[nodiscard]] constexpr std::string_view JournalReader::EnumToString(const Pace pace)
+{
+	static_assert(U(Pace::Max) == 3, "Missed description for a new journal pace enum");
+
+	switch (pace) {
+	case Pace::Undefined:
+		return "Undefined";
+	case Pace::MaxSpeed:
+		return "Max speed";
+	case Pace::RealTime:
+		return "Real time";
+	case Pace::Max:
+		return "Max";
+	default:
+		LOG_ERROR("Unknown journal pace: " + _S(U(pace)));
+		return "Unknown";
+	}
+}
+
+FORCE_INLINE [[nodiscard]] std::vector<Journal::IndexEntry> JournalReader::ReadIndex(const std::string_view path)
+{
+	std::vector<Journal::IndexEntry> entries;
+	if (!path.ends_with(".journal")) [[unlikely]] {
+		return entries;
+	}
+
+	const std::string indexPath{ std::string{ path.substr(0, path.size() - 7) } + "index" };
+	IO::FileDescriptor::ExitGuard file{ indexPath.c_str(), O_RDONLY, 0 };
+	if (file.value == -1) {
+		return entries;
+	}
+
+	struct stat status;
+	if (fstat(file.value, &status) == -1) [[unlikely]] {
+		return entries;
+	}
+
+	entries.resize(UINT64(status.st_size) / sizeof(Journal::IndexEntry));
+	const auto size{ entries.size() * sizeof(Journal::IndexEntry) };
+	if (size != 0 && read(file.value, entries.data(), size) != static_cast<ssize_t>(size)) [[unlikely]] {
+		LOG_WARNING("Journal index is not read: " + indexPath);
+		entries.clear();
+	}
+
+	return entries;
+}
+
+} // namespace Object
+
+} // namespace Protocol
+
+} // namespace MSAPI
+
+#endif // MSAPI_PROTOCOL_OBJECT_JOURNAL_INL
@@ -0,0 +1,552 @@
+/**************************
+ * @file        objectRelay.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ *
+ * @brief Relay tier of object protocol. Relay subscribes once to upstream distributor, keeps snapshot and live objects
+ * locally and serves any number of downstream subscribers with their own filters. Relays can be chained, which gives
+ * tree topology where reads are scaled horizontally.
+ */
+
+#ifndef MSAPI_PROTOCOL_OBJECT_RELAY_INL
+#define MSAPI_PROTOCOL_OBJECT_RELAY_INL
+
+#include "../help/pthread.hpp"
+#include "../server/server.h"
+#include "object.h"
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace MSAPI {
+
+namespace Protocol {
+
+namespace Object {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Concept for types which can be relayed, object id identifies versions of the same object.
+ */
+template <typename T>
+concept RelayObject = std::is_class_v<T> && requires(const T& object) {
+	{ object.GetObjectId() } -> std::convertible_to<uint64_t>;
+};
+
+/**************************
+ * @brief Upstream stream and local cache of one object type of relay. Cache keeps the latest version of each object
+ * by its id.
+ *
+ * @tparam R Type of relay.
+ * @tparam T Type of object.
+ * @tparam F Type of filter object.
+ */
+template <typename R, typename T, typename F>
+	requires RelayObject<T> && std::is_class_v<F>
+class RelayChannel : public IHandler<T> {
+private:
+	Stream<T, F> m_upstream{ this };
+	//* The latest version of each snapshot and live object received from upstream
+	std::unordered_map<uint64_t, T> m_objects;
+	const std::function<bool(const FilterBase* filter, const T& object)> m_filterPredicate;
+	//* Downstream streams of the last object received from upstream, filled under relay lock and sent after it
+	std::vector<std::pair<int, Data>> m_targets;
+	const T* m_pending{};
+
+public:
+	/**************************
+	 * @brief Construct a new Relay Channel object, empty constructor.
+	 *
+	 * @param filterPredicate Predicate for downstream filters.
+	 */
+	FORCE_INLINE RelayChannel(const std::function<bool(const FilterBase* filter, const T& object)>& filterPredicate);
+
+	//* IHandler
+	FORCE_INLINE void HandleObject(int streamId, const T& object) final;
+
+private:
+	/**************************
+	 * @brief Send cached objects which pass filter of new downstream stream.
+	 *
+	 * @param streamId Downstream stream id.
+	 * @param streamData Downstream stream data.
+	 */
+	FORCE_INLINE void SendSnapshot(int streamId, const StreamData& streamData) const;
+
+	/**************************
+	 * @brief Send the last object received from upstream to its downstream streams, if any.
+	 */
+	FORCE_INLINE void SendPending();
+
+	friend R;
+};
+
+/**************************
+ * @brief Server which subscribes to upstream distributor with live stream and empty filter for each object type and
+ * re-serves received objects to downstream streams. New downstream stream gets cached objects which pass its filter,
+ * live downstream stream gets every new object from upstream which passes its filter.
+ *
+ * @attention Relay is a distributor for downstream side, so Stop() must be called before stopping server, and it is
+ * required to provide pointer to application for ApplicationStateChecker in the most derived class constructor.
+ * @attention Downstream stream opened before upstream snapshot is done gets only objects received so far, the rest
+ * comes as live objects. IsReady can be used to wait for upstream snapshot.
+ *
+ * @attention Snapshot of new downstream stream is sent under relay lock, so live objects do not overtake it. Live
+ * objects are sent to downstream streams after relay lock is released, so a slow downstream connection does not block
+ * new downstream streams.
+ *
+ * @brief If upstream stream fails, local cache of its object type is cleared and upstream stream is reopened for full
+ * snapshot. Snapshot objects are passed to live downstream streams of that object type as new objects, so they are
+ * resnapshotted without reopening. Downstream streams of other object types are not affected.
+ *
+ * @brief If upstream connection is lost, upstream streams are failed and cache keeps serving downstream streams. Relay
+ * reconnects with exponential backoff from RECONNECT_DELAY_MIN to RECONNECT_DELAY_MAX, then clears cache and reopens
+ * all upstream streams, as after stream failure.
+ *
+ * @tparam F Type of filter object, the same for upstream and downstream.
+ * @tparam Ts Types of relayed objects.
+ */
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+class Relay : public Server, public Distributor<F>, public RelayChannel<Relay<F, Ts...>, Ts, F>... {
+public:
+	static constexpr inline std::chrono::milliseconds RECONNECT_DELAY_MIN{ 100 };
+	static constexpr inline std::chrono::milliseconds RECONNECT_DELAY_MAX{ 30000 };
+
+private:
+	std::atomic<int> m_upstreamConnection{ -1 };
+	std::atomic<int> m_upstreamId{ -1 };
+	in_addr_t m_upstreamIp{};
+	in_port_t m_upstreamPort{};
+	//* Upstream and downstream connections are served by different pthreads
+	Pthread::AtomicLock m_lock{ "ObjectRelay" };
+
+	std::mutex m_reconnectMutex;
+	std::condition_variable m_reconnectCondition;
+	bool m_upstreamLost{};
+	bool m_stopping{};
+	std::thread m_reconnector;
+
+public:
+	/**************************
+	 * @brief Construct a new Relay object, empty constructor.
+	 *
+	 * @param filterPredicates Predicates for downstream filters, one per object type.
+	 */
+	FORCE_INLINE Relay(const std::function<bool(const FilterBase* filter, const Ts& object)>&... filterPredicates);
+
+	/**************************
+	 * @brief Destroy the Relay object, stop reconnecting to upstream.
+	 */
+	FORCE_INLINE ~Relay() override;
+
+	/**************************
+	 * @brief Open connection to upstream distributor and open live stream with empty filter for each object type.
+	 * Connection is reopened and streams are resubscribed if connection is lost.
+	 *
+	 * @param id Connection id.
+	 * @param ip Upstream ip.
+	 * @param port Upstream port.
+	 *
+	 * @return True if connection and all streams are opened, false otherwise.
+	 */
+	FORCE_INLINE [[nodiscard]] bool Subscribe(int id, in_addr_t ip, in_port_t port);
+
+	/**************************
+	 * @return True if all upstream streams are opened and their snapshots are done.
+	 */
+	FORCE_INLINE [[nodiscard]] bool IsReady();
+
+	/**************************
+	 * @tparam T Type of object.
+	 *
+	 * @return Number of cached objects of type.
+	 */
+	template <typename T>
+		requires is_included_in<T, Ts...>
+	FORCE_INLINE [[nodiscard]] size_t GetObjectsNumber();
+
+	//* Server
+	FORCE_INLINE void HandleBuffer(RecvBufferInfo* recvBufferInfo) override;
+	//* Application
+	FORCE_INLINE void HandleOutcomeDisconnect(int32_t id, int32_t connection) override;
+	FORCE_INLINE void HandleIncomeDisconnect(int32_t id, int32_t connection) override;
+	//* IHandler
+	FORCE_INLINE void HandleStreamOpened(int streamId) override;
+	FORCE_INLINE void HandleStreamSnapshotDone(int streamId) override;
+	FORCE_INLINE void HandleStreamFailed(int streamId) override;
+
+private:
+	//* Distributor
+	FORCE_INLINE void HandleNewStreamOpened(int streamId, const StreamData& streamData) final;
+
+	/**************************
+	 * @brief Set empty live filter and open upstream stream of object type.
+	 *
+	 * @tparam T Type of object.
+	 *
+	 * @param connection Upstream connection.
+	 *
+	 * @return True if stream is opened, false otherwise.
+	 */
+	template <typename T> FORCE_INLINE bool OpenUpstream(int connection);
+
+	/**************************
+	 * @brief Wait for loss of upstream connection and reconnect with exponential backoff till relay is destroyed.
+	 */
+	FORCE_INLINE void Reconnect();
+
+	/**************************
+	 * @brief Make one attempt to reopen upstream connection, then clear cache and reopen upstream streams.
+	 *
+	 * @return True if connection and all streams are opened, false otherwise.
+	 */
+	FORCE_INLINE [[nodiscard]] bool Resubscribe();
+};
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+template <typename R, typename T, typename F>
+	requires RelayObject<T> && std::is_class_v<F>
+FORCE_INLINE RelayChannel<R, T, F>::RelayChannel(
+	const std::function<bool(const FilterBase* filter, const T& object)>& filterPredicate)
+	: m_filterPredicate{ filterPredicate }
+{
+}
+
+template <typename R, typename T, typename F>
+	requires RelayObject<T> && std::is_class_v<F>
+FORCE_INLINE void RelayChannel<R, T, F>::HandleObject([[maybe_unused]] const int streamId, const T& object)
+{
+	const auto id{ static_cast<uint64_t>(object.GetObjectId()) };
+	m_objects.erase(id);
+	m_objects.emplace(id, object);
+
+	m_pending = &object;
+	static_cast<R*>(this)->PublishNewObject(object, m_filterPredicate,
+		[this](const int connection, const Data& data) { m_targets.emplace_back(connection, data); });
+}
+
+template <typename R, typename T, typename F>
+	requires RelayObject<T> && std::is_class_v<F>
+FORCE_INLINE void RelayChannel<R, T, F>::SendSnapshot(const int streamId, const StreamData& streamData) const
+{
+	LOG_PROTOCOL_NEW("Try to send cached objects for stream id: {}, connection: {}, objects number: {}", streamId,
+		streamData.connection, m_objects.size());
+	for (const auto& [id, object] : m_objects) {
+		static_cast<const R*>(this)->SendOldObject(streamId, streamData, object, m_filterPredicate);
+	}
+}
+
+template <typename R, typename T, typename F>
+	requires RelayObject<T> && std::is_class_v<F>
+FORCE_INLINE void RelayChannel<R, T, F>::SendPending()
+{
+	for (const auto& [connection, data] : m_targets) {
+		Protocol::Object::Send(connection, data, m_pending);
+	}
+	m_targets.clear();
+	m_pending = nullptr;
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+FORCE_INLINE Relay<F, Ts...>::Relay(
+	const std::function<bool(const FilterBase* filter, const Ts& object)>&... filterPredicates)
+	: ApplicationStateChecker(this)
+	, RelayChannel<Relay<F, Ts...>, Ts, F>(filterPredicates)...
+{
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+FORCE_INLINE Relay<F, Ts...>::~Relay()
+{
+	if (m_reconnector.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock{ m_reconnectMutex };
+			m_stopping = true;
+		}
+		m_reconnectCondition.notify_one();
+		m_reconnector.join();
+	}
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+FORCE_INLINE [[nodiscard]] bool Relay<F, Ts...>::Subscribe(const int id, const in_addr_t ip, const in_port_t port)
+{
+	if (!Server::OpenConnect(id, ip, port, false)) {
+		LOG_ERROR_NEW("Relay cannot connect to upstream, id: {}, port: {}", id, port);
+		return false;
+	}
+
+	const auto connection{ Server::GetConnect(id) };
+	if (!connection.has_value()) [[unlikely]] {
+		LOG_ERROR_NEW("Relay didn't find upstream connection for id: {}", id);
+		return false;
+	}
+
+	m_upstreamIp = ip;
+	m_upstreamPort = port;
+	m_upstreamId.store(id, std::memory_order_release);
+	if (!m_reconnector.joinable()) {
+		m_reconnector = std::thread{ [this]() { Reconnect(); } };
+	}
+
+	Pthread::AtomicLock::ExitGuard guard{ m_lock };
+	m_upstreamConnection.store(*connection, std::memory_order_release);
+	return (OpenUpstream<Ts>(*connection) && ...);
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+FORCE_INLINE [[nodiscard]] bool Relay<F, Ts...>::IsReady()
+{
+	Pthread::AtomicLock::ExitGuard guard{ m_lock };
+	return ((RelayChannel<Relay, Ts, F>::m_upstream.GetState() == Protocol::Object::State::Opened
+				&& RelayChannel<Relay, Ts, F>::m_upstream.IsSnapshotDone())
+		&& ...);
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+template <typename T>
+	requires is_included_in<T, Ts...>
+FORCE_INLINE [[nodiscard]] size_t Relay<F, Ts...>::GetObjectsNumber()
+{
+	Pthread::AtomicLock::ExitGuard guard{ m_lock };
+	return RelayChannel<Relay, T, F>::m_objects.size();
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+FORCE_INLINE void Relay<F, Ts...>::HandleBuffer(RecvBufferInfo* recvBufferInfo)
+{
+	DataHeader header{ *recvBufferInfo->buffer };
+	if (header.GetCipher() != 2666999999) [[unlikely]] {
+		LOG_ERROR("Unknown protocol: " + header.ToString());
+		return;
+	}
+
+	if (!Server::ReadAdditionalData(recvBufferInfo, header.GetBufferSize())) {
+		return;
+	}
+
+	const Data data{ std::move(header), *recvBufferInfo->buffer };
+	void* object;
+	Data::UnpackData(&object, *recvBufferInfo->buffer);
+
+	if (recvBufferInfo->connection == m_upstreamConnection.load(std::memory_order_acquire)) {
+		{
+			Pthread::AtomicLock::ExitGuard guard{ m_lock };
+			if (!Protocol::Object::Collect<Ts...>(this, data, object)) [[unlikely]] {
+				LOG_ERROR("Unknown upstream object protocol data: " + data.ToString());
+			}
+		}
+
+		//* Upstream connection is served by one pthread, so pending object is not changed till it is sent
+		(RelayChannel<Relay, Ts, F>::SendPending(), ...);
+		return;
+	}
+
+	Pthread::AtomicLock::ExitGuard guard{ m_lock };
+	if (!Distributor<F>::Collect(recvBufferInfo->connection, data, object)) [[unlikely]] {
+		LOG_ERROR("Unknown downstream object protocol data: " + data.ToString());
+	}
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+FORCE_INLINE void Relay<F, Ts...>::HandleOutcomeDisconnect(const int32_t id, const int32_t connection)
+{
+	if (id != m_upstreamId.load(std::memory_order_acquire)) {
+		Server::HandleOutcomeDisconnect(id, connection);
+		return;
+	}
+
+	if (Server::GetState() == Server::State::Stopped) {
+		return;
+	}
+
+	LOG_WARNING_NEW("Relay upstream connection is lost, id: {}, connection: {}", id, connection);
+	{
+		Pthread::AtomicLock::ExitGuard guard{ m_lock };
+		m_upstreamConnection.store(-1, std::memory_order_release);
+		//* Upstream streams are failed, cache is kept for downstream streams till resubscription
+		const StreamStateResponse state{ Protocol::Object::State::Failed };
+		(this->CollectStreamState(RelayChannel<Relay, Ts, F>::m_upstream.GetId(), &state), ...);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{ m_reconnectMutex };
+		m_upstreamLost = true;
+	}
+	m_reconnectCondition.notify_one();
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+FORCE_INLINE void Relay<F, Ts...>::HandleIncomeDisconnect(const int32_t id, const int32_t connection)
+{
+	{
+		Pthread::AtomicLock::ExitGuard guard{ m_lock };
+		Distributor<F>::RemoveConnection(connection);
+	}
+	Server::HandleIncomeDisconnect(id, connection);
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+FORCE_INLINE void Relay<F, Ts...>::HandleStreamOpened(const int streamId)
+{
+	LOG_DEBUG_NEW("Relay upstream stream is opened, id: {}", streamId);
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+FORCE_INLINE void Relay<F, Ts...>::HandleStreamSnapshotDone(const int streamId)
+{
+	LOG_DEBUG_NEW("Relay upstream stream snapshot is done, id: {}", streamId);
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+FORCE_INLINE void Relay<F, Ts...>::HandleStreamFailed(const int streamId)
+{
+	LOG_WARNING_NEW("Relay upstream stream is failed, id: {}", streamId);
+
+	//* Streams of lost upstream connection are reopened after reconnection
+	const int connection{ m_upstreamConnection.load(std::memory_order_acquire) };
+	if (connection == -1) {
+		return;
+	}
+
+	//* Live downstream streams of failed object type get full upstream snapshot as new objects after reopening
+	(void)((RelayChannel<Relay, Ts, F>::m_upstream.GetId() == streamId
+			   && (RelayChannel<Relay, Ts, F>::m_objects.clear(), OpenUpstream<Ts>(connection), true))
+		|| ...);
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+FORCE_INLINE void Relay<F, Ts...>::HandleNewStreamOpened(const int streamId, const StreamData& streamData)
+{
+	const bool known{ ((streamData.objectHash == typeId_v<Ts>
+							&& (RelayChannel<Relay, Ts, F>::SendSnapshot(streamId, streamData), true))
+		|| ...) };
+
+	if (!known) [[unlikely]] {
+		LOG_ERROR("Unknown hash for opening relay stream: " + streamData.ToString());
+	}
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+template <typename T>
+FORCE_INLINE bool Relay<F, Ts...>::OpenUpstream(const int connection)
+{
+	auto& upstream{ RelayChannel<Relay, T, F>::m_upstream };
+	upstream.SetConnection(connection);
+	upstream.SetFilter(Filter<F>{ Type::SnapshotAndLive });
+	if (!upstream.Open()) [[unlikely]] {
+		LOG_ERROR_NEW("Relay cannot open upstream stream, id: {}", upstream.GetId());
+		return false;
+	}
+
+	return true;
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+FORCE_INLINE void Relay<F, Ts...>::Reconnect()
+{
+	std::unique_lock<std::mutex> lock{ m_reconnectMutex };
+	while (true) {
+		m_reconnectCondition.wait(lock, [this]() { return m_upstreamLost || m_stopping; });
+		auto delay{ RECONNECT_DELAY_MIN };
+		while (!m_stopping) {
+			if (m_reconnectCondition.wait_for(lock, delay, [this]() { return m_stopping; })) {
+				break;
+			}
+
+			lock.unlock();
+			const bool resubscribed{ Resubscribe() };
+			lock.lock();
+			if (resubscribed) {
+				m_upstreamLost = false;
+				break;
+			}
+
+			delay = std::min(delay * 2, RECONNECT_DELAY_MAX);
+			LOG_WARNING_NEW("Relay cannot resubscribe to upstream, next attempt in {} ms", delay.count());
+		}
+
+		if (m_stopping) {
+			return;
+		}
+	}
+}
+
+template <typename F, typename... Ts>
+	requires std::is_class_v<F> && (std::is_class_v<Ts> && ...)
+FORCE_INLINE [[nodiscard]] bool Relay<F, Ts...>::Resubscribe()
+{
+	const int id{ m_upstreamId.load(std::memory_order_acquire) };
+	//* Lost connection is closed by its pthread after disconnect is handled
+	if (Server::ConnectIsOpen(id)) {
+		return false;
+	}
+
+	if (!Server::OpenConnect(id, m_upstreamIp, m_upstreamPort, false, 1)) {
+		return false;
+	}
+
+	const auto connection{ Server::GetConnect(id) };
+	if (!connection.has_value()) [[unlikely]] {
+		LOG_ERROR_NEW("Relay didn't find upstream connection for id: {}", id);
+		return false;
+	}
+
+	Pthread::AtomicLock::ExitGuard guard{ m_lock };
+	m_upstreamConnection.store(*connection, std::memory_order_release);
+	(RelayChannel<Relay, Ts, F>::m_objects.clear(), ...);
+	if (!(OpenUpstream<Ts>(*connection) && ...)) {
+		m_upstreamConnection.store(-1, std::memory_order_release);
+		Server::CloseConnect(id);
+		return false;
+	}
+
+	LOG_INFO_NEW("Relay is resubscribed to upstream, id: {}, connection: {}", id, *connection);
+	return true;
+}
+
+} // namespace Object
+
+} // namespace Protocol
+
+} // namespace MSAPI
+
+#endif // MSAPI_PROTOCOL_OBJECT_RELAY_INL
@@ -301,9 +301,9 @@ std::string Data::ToString() const
 	return result;
 }
 
-const std::map<size_t, std::variant<standardTypes>>& Data::GetData() const noexcept { return m_data; }
+const data_t& Data::GetData() const noexcept { return m_data; }
 
-const std::map<size_t, StandardType::Type>& Data::GetDataTypes() const noexcept { return m_dataTypes; }
+const types_t& Data::GetDataTypes() const noexcept { return m_dataTypes; }
 
 /*---------------------------------------------------------------------------------
 Another
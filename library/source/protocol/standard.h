@@ -27,6 +27,7 @@
 #ifndef MSAPI_PROTOCOL_STANDARD_H
 #define MSAPI_PROTOCOL_STANDARD_H
 
+#include "../help/continuousAllocator.hpp"
 #include "../help/log.h"
 #include "../help/standardType.hpp"
 #include "../help/table.h"
@@ -48,13 +49,21 @@ constexpr size_t cipherActionRun{ 934875936 };
 constexpr size_t cipherActionDelete{ 934875937 };
 constexpr size_t cipherActionModify{ 934875938 };
 
+/**************************
+ * @brief Values and types of standard data by property identifier, nodes are taken from pools of continuous allocator.
+ */
+using data_t = std::map<size_t, std::variant<standardTypes>, std::less<size_t>,
+	ContinuousAllocator<std::pair<const size_t, std::variant<standardTypes>>>>;
+using types_t = std::map<size_t, StandardType::Type, std::less<size_t>,
+	ContinuousAllocator<std::pair<const size_t, StandardType::Type>>>;
+
 /**************************
  * @brief Object for containing data of standard message.
  */
 class Data : public DataHeader {
 private:
-	std::map<size_t, std::variant<standardTypes>> m_data;
-	std::map<size_t, StandardType::Type> m_dataTypes;
+	data_t m_data;
+	types_t m_dataTypes;
 
 public:
 	/**************************
@@ -287,12 +296,12 @@ public:
 	/**************************
 	 * @return Readable reference to data.
 	 */
-	const std::map<size_t, std::variant<standardTypes>>& GetData() const noexcept;
+	const data_t& GetData() const noexcept;
 
 	/**************************
 	 * @return Readable reference to data types.
 	 */
-	const std::map<size_t, StandardType::Type>& GetDataTypes() const noexcept;
+	const types_t& GetDataTypes() const noexcept;
 };
 
 /**************************
@@ -24,7 +24,11 @@
 #define MSAPI_PROTOCOL_WEBSOCKET_INL
 
 #include "../server/server.h"
+#include "webSocketDeflate.inl"
 #include <unordered_set>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 namespace MSAPI {
 
@@ -55,7 +59,8 @@ Declarations
 class IHandler;
 
 /**************************
- * @brief Object for containing data of WebSocket message.
+ * @brief Object for containing data of WebSocket message. Owns its memory, except borrowed frames parsed in place of
+ * recv buffer, which are valid only till the next read from connection.
  *
  * @todo Create custom allocator, which will allow to define a number of elements to be allocated on stack and point on
  * that memory by default. In case of vector, the initial capacity should be equal to that static number. Current
@@ -73,7 +78,7 @@ public:
 		Reserved = 1004, // Reserved
 		NoStatusReceived = 1005, // No status code present. When no payload is sent with close frame. Must not be used.
 		AbnormalClosure = 1006, // Connection closed without Close frame. Must not be used.
-		InvalidFramePayloadData = 1007, // Non-UTF-8 data in text frame. Must not be used.
+		InvalidFramePayloadData = 1007, // Data inconsistent with message type, non-UTF-8 text or corrupted compression
 		PolicyViolation = 1008, // Application-level policy failure
 		MessageTooBig = 1009, // Payload exceeds allowed size
 		MandatoryExtension = 1010, // The client expected the server to negotiate one or more WebSocket extensions
@@ -85,6 +90,12 @@ public:
 		TLSHandshakeFailure = 1015, // TLS failure during handshake. Must not be used.
 	};
 
+	//* Implementation of payload masking, widest supported by CPU is selected at runtime
+	enum class MaskingPath : int8_t { Undefined, Scalar, Sse2, Avx2, Avx512, Max };
+
+	//* Tag to parse frame in place of recv buffer without copying
+	struct Borrowed { };
+
 	static constexpr inline int8_t REQUIRED_HEADER_SIZE{ 2 };
 	static constexpr inline double MB{ 1024. * 1024. };
 	static constexpr inline double MAXIMUM_HEADER_MB{ 10. / MB };
@@ -106,6 +117,8 @@ private:
 	*/
 	std::vector<uint8_t> m_buffer = std::vector<uint8_t>(REQUIRED_HEADER_SIZE, 0);
 	int8_t m_headerSize{ REQUIRED_HEADER_SIZE };
+	// Frame in recv buffer if data is borrowed, empty otherwise
+	std::span<uint8_t> m_view;
 
 public:
 	/**************************
@@ -149,6 +162,19 @@ public:
 	 */
 	FORCE_INLINE Data(RecvBufferInfo* recvBufferInfo);
 
+	/**************************
+	 * @brief Construct a new borrowed Data object, parse header and payload in place of recv buffer. Saves allocation
+	 * and copy of frame, but data is valid only till the next read from connection, Detach must be called to keep it
+	 * longer.
+	 *
+	 * @attention Payload will be unmasked in recv buffer.
+	 *
+	 * @param recvBufferInfo Pointer to recv buffer info object with allocated memory. Must not be nullptr.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE Data(RecvBufferInfo* recvBufferInfo, Borrowed);
+
 	/**
 	 * @return String interpretation of WebSocket data message.
 	 *
@@ -261,10 +287,25 @@ public:
 	 */
 	FORCE_INLINE [[nodiscard]] std::span<const uint8_t> GetBuffer() const noexcept;
 
+	/**
+	 * @return True if data points to recv buffer and does not own memory.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] bool IsBorrowed() const noexcept;
+
+	/**
+	 * @brief Copy borrowed frame into own memory. Does nothing if data already owns its memory.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void Detach();
+
 	/**
 	 * @brief Append payload from other data and update own header accordingly.
 	 *
 	 * @attention Payload must be already unmasked.
+	 * @attention Data must own its memory, other can be borrowed.
 	 * @attention Additional overhead on memory move, up to copy, in case of header size change.
 	 *
 	 * @param other Source of new payload.
@@ -309,7 +350,31 @@ public:
 	FORCE_INLINE [[nodiscard]] static uint32_t GenerateMaskingKey();
 
 	/**
-	 * @brief Apply mask. Works for masking and unmasking: "x XOR y XOR y = x".
+	 * @return String interpretation of MaskingPath enum.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static std::string_view EnumToString(MaskingPath value);
+
+	/**
+	 * @param path Masking path.
+	 *
+	 * @return True if CPU supports masking path.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static bool IsMaskingPathSupported(MaskingPath path) noexcept;
+
+	/**
+	 * @return The widest masking path supported by CPU, detected once.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static MaskingPath GetMaskingPath() noexcept;
+
+	/**
+	 * @brief Apply mask with the widest masking path supported by CPU. Works for masking and unmasking: "x XOR y XOR y
+	 * = x".
 	 *
 	 * @param payload Begin of payload to be masked. Must not be a nullptr.
 	 * @param size Size of payload to be masked.
@@ -319,6 +384,18 @@ public:
 	 */
 	FORCE_INLINE static void ApplyMask(uint8_t* payload, size_t size, uint32_t mask) noexcept;
 
+	/**
+	 * @brief Apply mask with specific masking path. Unsupported path falls back to scalar one.
+	 *
+	 * @param payload Begin of payload to be masked. Must not be a nullptr.
+	 * @param size Size of payload to be masked.
+	 * @param mask Mask to be applied.
+	 * @param path Masking path.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE static void ApplyMask(uint8_t* payload, size_t size, uint32_t mask, MaskingPath path) noexcept;
+
 	/**
 	 * @brief Create close WebSocket message with specific status code and reason if provided. Reason will be added only
 	 * for status code not equal to -1. Masking, if set, will be in message anyway.
@@ -410,19 +487,71 @@ private:
 	 */
 	FORCE_INLINE void ReverseMaskingInDataWithSmallPayload() noexcept;
 
+	/**
+	 * @brief Apply mask by 8 bytes per step with widened 64-bit mask, the rest byte by byte.
+	 *
+	 * @param payload Begin of payload to be masked.
+	 * @param size Size of payload to be masked.
+	 * @param mask Mask to be applied.
+	 */
+	FORCE_INLINE static void ApplyMaskScalar(uint8_t* payload, size_t size, uint32_t mask) noexcept;
+
+#if defined(__x86_64__) || defined(__i386__)
+	/**
+	 * @brief Apply mask by 16 bytes per step, the rest by scalar path. Is not inlined into callers compiled for
+	 * narrower instruction set.
+	 *
+	 * @param payload Begin of payload to be masked.
+	 * @param size Size of payload to be masked.
+	 * @param mask Mask to be applied.
+	 */
+	__attribute__((target("sse2"))) static void ApplyMaskSse2(uint8_t* payload, size_t size, uint32_t mask) noexcept;
+
+	/**
+	 * @brief Apply mask by 32 bytes per step, the rest by SSE2 path.
+	 *
+	 * @param payload Begin of payload to be masked.
+	 * @param size Size of payload to be masked.
+	 * @param mask Mask to be applied.
+	 */
+	__attribute__((target("avx2"))) static void ApplyMaskAvx2(uint8_t* payload, size_t size, uint32_t mask) noexcept;
+
+	/**
+	 * @brief Apply mask by 64 bytes per step, the rest by masked store of the last partial vector.
+	 *
+	 * @param payload Begin of payload to be masked.
+	 * @param size Size of payload to be masked.
+	 * @param mask Mask to be applied.
+	 */
+	__attribute__((target("avx512f"))) static void ApplyMaskAvx512(
+		uint8_t* payload, size_t size, uint32_t mask) noexcept;
+#endif
+
 	// Direct access to buffer
 	friend class IHandler;
 	friend class MSAPI::Tests::Protocol::WebSocket::Observer;
 };
 
 /**************************
- * @brief Send data to connection.
+ * @brief Send data to connection. Final text and binary messages are compressed if permessage-deflate is negotiated
+ * for connection and payload is not less than threshold.
  *
  * @param connection Socket to send.
  * @param data Data to send.
+ *
+ * @test Has unit test.
  */
 FORCE_INLINE void Send(int connection, const Data& data);
 
+/**************************
+ * @brief Send close message with status code to connection.
+ *
+ * @param connection Socket to send.
+ * @param statusCode Status code of closure.
+ * @param reason Reason of closure, truncated to fit close message payload.
+ */
+FORCE_INLINE void SendClose(int connection, Data::CloseStatusCode statusCode, std::string_view reason = {});
+
 /**************************
  * @brief Functional data abstraction for pthread safe reserving WebSocket messages. Has dynamic limit for storing
  * fragmented data with ability to disable fragmented messages handling at all. Provide several handler functions:
@@ -434,43 +563,74 @@ FORCE_INLINE void Send(int connection, const Data& data);
  * - Close messages are answered back with same data, RSV3 flag set and opposite masking policy. If RSV3 flag is set,
  * close message will not be answered back.
  * - Ping messages are answered back with same data and opposite masking policy.
+ * Messages compressed by permessage-deflate (RSV1 is set on the first fragment) are inflated before handling.
  *
- * Use MSAPI_HANDLER_WEBSOCKET_PRESET macro to reserve and collect WebSocket message.
+ * Use MSAPI_HANDLER_WEBSOCKET_PRESET macro to reserve and collect WebSocket message, or
+ * MSAPI_HANDLER_WEBSOCKET_BORROWED_PRESET to parse it in place of recv buffer. Borrowed messages are detached before
+ * storing as fragments or answering back, handlers must detach them to keep data after return.
  */
 class IHandler {
 public:
 	/**
-	 * @brief Data structure to accumulate fragments.
+	 * @brief Reassembly slot of one connection. Payload of fragments is appended after reserved headroom, so completed
+	 * message gets its header without copying fragments one by one. Slot is owned by connection under its own lock and
+	 * is linked into FIFO queue of handler while it stores a message.
 	 */
 	struct FragmentedData {
-		Data data;
-		const int connection;
-		Timer timestamp{};
+		// Space before payload for the biggest header of completed message
+		static constexpr inline size_t HEADROOM{ 14 };
+
+		std::vector<uint8_t> buffer;
+		FragmentedData* previous{};
+		FragmentedData* next{};
+		// Ticks of fast clock when the last fragment is stored, 0 if slot is empty
+		int64_t timestamp{};
+		// Bytes of shared budget occupied by stored message
+		size_t reserved{};
+		uint32_t mask{};
+		int connection{ -1 };
+		uint8_t firstByte{};
+		bool masked{};
+		bool stored{};
+		Pthread::AtomicLock lock{ "WebSocket::fragmentedData" };
 
 		/**
-		 * @brief Create fragmented data object with creation timestamp.
+		 * @brief Start new message from initial fragment.
 		 *
-		 * @param data WebSocket data.
-		 * @param connection Socket connection from which reserved message.
+		 * @param data Initial fragment.
 		 *
 		 * @test Has unit test.
 		 */
-		FORCE_INLINE FragmentedData(Data&& data, int connection) noexcept;
+		FORCE_INLINE void Start(const Data& data);
 
-		FragmentedData(FragmentedData&& other) = default;
-		FragmentedData(const FragmentedData& other) = delete;
-
-		FragmentedData& operator=(const FragmentedData& other) = delete;
-		FragmentedData& operator=(FragmentedData&& other) = delete;
+		/**
+		 * @brief Append payload of fragment, capacity grows geometrically.
+		 *
+		 * @param payload Payload of fragment.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE void Append(std::span<const uint8_t> payload);
 	};
 
+	// Connection slots are allocated by pages on first fragmented message of connection
+	static constexpr inline size_t FRAGMENTED_DATA_PAGE_SIZE{ 256 };
+	static constexpr inline size_t FRAGMENTED_DATA_PAGES{ 4096 };
+	// Stored message occupies its payload size and the biggest header size
+	static constexpr inline size_t FRAGMENTED_DATA_OVERHEAD{ 10 };
+
 private:
 	const MSAPI::Application* const m_application;
-	double m_storedFragmentedDataSizeMb{};
+	std::atomic<size_t> m_storedFragmentedDataSize{};
+	std::atomic<size_t> m_storedFragmentedDataLimit{ static_cast<size_t>(10. * Data::MB) };
 	double m_storedFragmentedDataLimitMb{ 10. };
-	std::unordered_map<int, FragmentedData> m_fragmentedDataToConnection;
-	std::map<Timer, FragmentedData*> m_fragmentedDataTimerToConnection;
-	Pthread::AtomicLock m_fragmentedDataLock;
+	const std::unique_ptr<std::atomic<FragmentedData*>[]> m_fragmentedDataPages{
+		std::make_unique<std::atomic<FragmentedData*>[]>(FRAGMENTED_DATA_PAGES)
+	};
+	FragmentedData* m_fragmentedDataHead{};
+	FragmentedData* m_fragmentedDataTail{};
+	size_t m_fragmentedDataQueueSize{};
+	Pthread::AtomicLock m_fragmentedDataQueueLock{ "WebSocket::fragmentedDataQueue" };
 
 public:
 	/**************************
@@ -483,13 +643,18 @@ public:
 	FORCE_INLINE IHandler(const MSAPI::Application* application) noexcept;
 
 	/**************************
-	 * @brief Default destructor.
+	 * @brief Destroy the IHandler object, free connection slots.
 	 */
-	virtual ~IHandler() = default;
+	virtual ~IHandler();
+
+	IHandler(const IHandler& other) = delete;
+	IHandler& operator=(const IHandler& other) = delete;
 
 	/**************************
 	 * @brief Handler function for text and binary messages.
 	 *
+	 * @attention Data can be borrowed, call Detach to keep it after return.
+	 *
 	 * @param connection Socket connection from which reserved message.
 	 * @param data Reserved WebSocket message.
 	 *
@@ -500,6 +665,8 @@ public:
 	/**
 	 * @brief Handler function for WebSocket pong message. Default implementation is empty.
 	 *
+	 * @attention Data can be borrowed, call Detach to keep it after return.
+	 *
 	 * @param connection Socket connection from which reserved message.
 	 * @param data Reserved WebSocket message.
 	 *
@@ -512,8 +679,10 @@ public:
 	 * completed and Application is running.
 	 *
 	 * @attention Continuation messages are stored till their completion or purging due to reaching the storage limit.
+	 * Each connection reassembles its message in own slot, connections share only atomic memory budget.
 	 * - Storage fragmentation limit is a dynamic limit which guarantee that storage container will not contain more
 	 * data then allowed;
+	 * - Stored messages are purged in order of their initial fragments;
 	 * - If income fragment can be stored, it temporary cannot be purged as there is possibility of message complete;
 	 * - If income continuation fragment come without initial fragment, it will be dropped away;
 	 * - If income fragment is initial but some fragmented data is already stored, stored data will be purged;
@@ -554,14 +723,14 @@ public:
 	FORCE_INLINE [[nodiscard]] bool SetFragmentedDataLimit(double limitMb);
 
 	/**
-	 * @brief Clear stored fragmented data storage and counters.
+	 * @brief Clear stored fragmented data storage and counters. Messages which are being collected right now are kept.
 	 *
 	 * @test Has unit test.
 	 */
 	FORCE_INLINE void Clear() noexcept;
 
 	/**
-	 * @brief Clear stored fragmented data for connection.
+	 * @brief Clear stored fragmented data and permessage-deflate context for connection.
 	 *
 	 * @param connection Connection to be cleared.
 	 *
@@ -574,32 +743,88 @@ private:
 	static inline constexpr bool CHECK_USUAL{ false };
 
 	/**
-	 * @brief Purge stored fragmented data for connections in FIFO order.
+	 * @param connection Socket connection.
+	 * @param create True if slot should be created if it does not exist.
+	 *
+	 * @return Slot of connection, nullptr if it does not exist or connection is out of supported range.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] FragmentedData* GetFragmentedData(int connection, bool create);
+
+	/**
+	 * @brief Purge stored fragmented data for connections in FIFO order. Slots which are locked by their connections
+	 * are skipped.
 	 *
 	 * @tparam T If should be limit checked before first iteration or after.
 	 *
 	 * @return True if there is enough space, false otherwise.
 	 *
-	 * @todo Unit test.
+	 * @test Has unit test.
 	 */
 	template <bool T> FORCE_INLINE [[nodiscard]] bool PurgeStoredData();
 
+	/**
+	 * @brief Occupy memory budget, purge stored fragmented data of other connections if it is required.
+	 *
+	 * @param size Size in bytes.
+	 *
+	 * @return True if budget is occupied, false otherwise.
+	 */
+	FORCE_INLINE [[nodiscard]] bool Reserve(size_t size);
+
+	/**
+	 * @brief Link slot to the end of FIFO queue.
+	 *
+	 * @attention This function assumes to be called under lock of slot.
+	 *
+	 * @param fragmentedDataPtr Slot with started message.
+	 */
+	FORCE_INLINE void Enqueue(FragmentedData* fragmentedDataPtr) noexcept;
+
+	/**
+	 * @brief Unlink slot from FIFO queue, free stored message and return its memory budget.
+	 *
+	 * @attention This function assumes to be called under lock of slot, and under m_fragmentedDataQueueLock lock if
+	 * T is true.
+	 *
+	 * @tparam T True if m_fragmentedDataQueueLock is already locked.
+	 *
+	 * @param fragmentedDataPtr Slot with stored message.
+	 */
+	template <bool T> FORCE_INLINE void Dequeue(FragmentedData* fragmentedDataPtr) noexcept;
+
+	/**
+	 * @brief Build completed message from slot and unlink slot from FIFO queue, memory budget is kept.
+	 *
+	 * @attention This function assumes to be called under lock of slot.
+	 *
+	 * @param fragmentedDataPtr Slot with stored message.
+	 *
+	 * @return Completed message with unmasked payload and masking key of initial fragment.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] Data Complete(FragmentedData* fragmentedDataPtr);
+
 	/**
 	 * @brief Check if additional fragmented data can be stored accordingly to the limits.
 	 * - If income fragment and its already stored part is greater than limit, it all will be dropped away;
 	 * - If income fragment cannot be stored because of limit, already stored fragments will be dropped away in FIFO
 	 * order until there is enough space. No guarantee there will be;
 	 *
-	 * @attention This function assumes to be called under m_fragmentedDataLock lock.
+	 * @attention This function assumes to be called under lock of slot.
 	 *
-	 * @param additionalSizeMb Size of new fragmented data in bytes.
-	 * @param fragmentedDataPtr Pointer to already stored fragmented data.
+	 * @param additionalSize Size of new fragmented data in bytes.
+	 * @param fragmentedDataPtr Slot with stored message.
 	 * @param connection Connection of income fragment.
 	 *
+	 * @return True if fragment can be processed, false otherwise.
+	 *
 	 * @test Has unit test.
 	 */
 	FORCE_INLINE [[nodiscard]] bool CheckLimitsForStored(
-		double additionalSizeMb, FragmentedData* fragmentedDataPtr, int connection);
+		size_t additionalSize, FragmentedData* fragmentedDataPtr, int connection);
 
 	/**
 	 * @brief Check if new fragmented data can be stored accordingly to the limits.
@@ -607,16 +832,36 @@ private:
 	 * - If income fragment cannot be stored because of limit, already stored fragments will be dropped away in FIFO
 	 * order until there is enough space. No guarantee there will be;
 	 *
-	 * @attention This function assumes to be called under m_fragmentedDataLock lock.
-	 *
-	 * @param additionalSizeMb Size of new fragmented data in bytes.
+	 * @param additionalSize Size of new fragmented data in bytes.
 	 * @param connection Connection of income fragment.
 	 *
 	 * @return True if fragment can be processed, false otherwise.
 	 *
 	 * @test Has unit test.
 	 */
-	FORCE_INLINE [[nodiscard]] bool CheckLimitForNew(double additionalSizeMb, int connection);
+	FORCE_INLINE [[nodiscard]] bool CheckLimitForNew(size_t additionalSize, int connection);
+
+	/**
+	 * @brief RSV1 means compressed message only when permessage-deflate is negotiated for connection, otherwise its
+	 * meaning is not defined by any extension and message is handled as is.
+	 *
+	 * @param connection Socket connection from which reserved message.
+	 * @param data Received message.
+	 *
+	 * @return True if message is compressed.
+	 */
+	FORCE_INLINE [[nodiscard]] static bool IsCompressed(int connection, const Data& data);
+
+	/**
+	 * @brief Replace compressed message by inflated one. If message cannot be inflated, compression context is closed
+	 * and close message with status code 1007 is sent.
+	 *
+	 * @param connection Socket connection from which reserved message.
+	 * @param data Compressed message, RSV1 is set.
+	 *
+	 * @return True if message is inflated, false if it must be dropped.
+	 */
+	FORCE_INLINE [[nodiscard]] static bool Inflate(int connection, Data& data);
 
 	friend class MSAPI::Tests::Protocol::WebSocket::Observer;
 };
@@ -804,6 +1049,53 @@ FORCE_INLINE Data::Data(RecvBufferInfo* const recvBufferInfo)
 		static_cast<const char*>(*recvBufferInfo->buffer) + REQUIRED_HEADER_SIZE, payloadHeaderSize + sizeof(uint64_t));
 }
 
+FORCE_INLINE Data::Data(RecvBufferInfo* const recvBufferInfo, Borrowed)
+	: m_buffer{}
+	, m_view{ static_cast<uint8_t*>(*recvBufferInfo->buffer), REQUIRED_HEADER_SIZE }
+{
+	// Below code assumes that MSAPI minimum buffer size is 2 bytes
+	if (IsMasked()) {
+		m_headerSize += int8_t{ sizeof(uint32_t) };
+	}
+
+	auto payloadSize{ static_cast<uint64_t>(m_view[1] & 0x7F) };
+	size_t offset{};
+	if (payloadSize > 125) {
+		const auto lengthSize{ payloadSize == 126 ? sizeof(uint16_t) : sizeof(uint64_t) };
+		m_headerSize += static_cast<int8_t>(lengthSize);
+		if (!Server::ReadAdditionalData(recvBufferInfo, static_cast<size_t>(m_headerSize))) {
+			m_view = { static_cast<uint8_t*>(*recvBufferInfo->buffer), REQUIRED_HEADER_SIZE };
+			return;
+		}
+
+		const auto* const length{ static_cast<const uint8_t*>(*recvBufferInfo->buffer) + REQUIRED_HEADER_SIZE };
+		if (lengthSize == sizeof(uint16_t)) {
+			uint16_t value;
+			memcpy(&value, length, sizeof(uint16_t));
+			payloadSize = be16toh(value);
+		}
+		else {
+			memcpy(&payloadSize, length, sizeof(uint64_t));
+			payloadSize = be64toh(payloadSize);
+		}
+		offset = static_cast<size_t>(m_headerSize);
+	}
+
+	const auto totalSize{ static_cast<size_t>(m_headerSize) + payloadSize };
+	if (totalSize > REQUIRED_HEADER_SIZE && !Server::ReadAdditionalData(recvBufferInfo, totalSize, offset)) {
+		m_view = { static_cast<uint8_t*>(*recvBufferInfo->buffer), REQUIRED_HEADER_SIZE };
+		return;
+	}
+
+	// Recv buffer can be reallocated during reading
+	m_view = { static_cast<uint8_t*>(*recvBufferInfo->buffer), totalSize };
+	if (IsMasked() && payloadSize != 0) {
+		uint32_t mask;
+		memcpy(&mask, m_view.data() + m_headerSize - sizeof(uint32_t), sizeof(uint32_t));
+		ApplyMask(m_view.data() + m_headerSize, payloadSize, mask);
+	}
+}
+
 FORCE_INLINE [[nodiscard]] std::string Data::ToString() const
 {
 	return std::format("WebSocket data:\n{{"
@@ -816,30 +1108,30 @@ FORCE_INLINE [[nodiscard]] std::string Data::ToString() const
 					   "\n\tHeader size  : {} | {:08b} {:08b}"
 					   "\n\tPayload size : {}"
 					   "\n\tIs valid     : {}\n}}",
-		IsFinal(), IsRsv1(), IsRsv2(), IsRsv3(), EnumToString(GetOpcode()), GetMaskingKey(), m_headerSize, m_buffer[0],
-		m_buffer[1], GetPayloadSize(), IsValid());
+		IsFinal(), IsRsv1(), IsRsv2(), IsRsv3(), EnumToString(GetOpcode()), GetMaskingKey(), m_headerSize,
+		GetBuffer()[0], GetBuffer()[1], GetPayloadSize(), IsValid());
 }
 
-FORCE_INLINE [[nodiscard]] bool Data::IsFinal() const noexcept { return (m_buffer[0] & 0x80) >> 7; }
+FORCE_INLINE [[nodiscard]] bool Data::IsFinal() const noexcept { return (GetBuffer()[0] & 0x80) >> 7; }
 
-FORCE_INLINE [[nodiscard]] bool Data::IsRsv1() const noexcept { return (m_buffer[0] & 0x40) >> 6; }
+FORCE_INLINE [[nodiscard]] bool Data::IsRsv1() const noexcept { return (GetBuffer()[0] & 0x40) >> 6; }
 
-FORCE_INLINE [[nodiscard]] bool Data::IsRsv2() const noexcept { return (m_buffer[0] & 0x20) >> 5; }
+FORCE_INLINE [[nodiscard]] bool Data::IsRsv2() const noexcept { return (GetBuffer()[0] & 0x20) >> 5; }
 
-FORCE_INLINE [[nodiscard]] bool Data::IsRsv3() const noexcept { return (m_buffer[0] & 0x10) >> 4; }
+FORCE_INLINE [[nodiscard]] bool Data::IsRsv3() const noexcept { return (GetBuffer()[0] & 0x10) >> 4; }
 
 FORCE_INLINE [[nodiscard]] Data::Opcode Data::GetOpcode() const noexcept
 {
-	return static_cast<Opcode>(m_buffer[0] & 0x0F);
+	return static_cast<Opcode>(GetBuffer()[0] & 0x0F);
 }
 
-FORCE_INLINE [[nodiscard]] bool Data::IsMasked() const noexcept { return (m_buffer[1] & 0x80) >> 7; }
+FORCE_INLINE [[nodiscard]] bool Data::IsMasked() const noexcept { return (GetBuffer()[1] & 0x80) >> 7; }
 
 FORCE_INLINE [[nodiscard]] uint32_t Data::GetMaskingKey() const noexcept
 {
 	// Data producers guarantee that if message contains masked flag, the buffer has capacity for its key.
 	if (IsMasked()) {
-		return *reinterpret_cast<const uint32_t*>(m_buffer.data() + m_headerSize - 4);
+		return *reinterpret_cast<const uint32_t*>(GetBuffer().data() + m_headerSize - 4);
 	}
 
 	return 0;
@@ -849,25 +1141,45 @@ FORCE_INLINE [[nodiscard]] int8_t Data::GetHeaderSize() const noexcept { return
 
 FORCE_INLINE [[nodiscard]] std::span<const uint8_t> Data::GetHeader() const noexcept
 {
-	return std::span<const uint8_t>(m_buffer.data(), static_cast<size_t>(m_headerSize));
+	return GetBuffer().first(static_cast<size_t>(m_headerSize));
 }
 
 FORCE_INLINE [[nodiscard]] size_t Data::GetPayloadSize() const noexcept
 {
-	return m_buffer.size() - static_cast<size_t>(m_headerSize);
+	return GetBufferSize() - static_cast<size_t>(m_headerSize);
 }
 
 FORCE_INLINE [[nodiscard]] std::span<const uint8_t> Data::GetPayload() const noexcept
 {
+	const auto buffer{ GetBuffer() };
 	return std::span<const uint8_t>(
-		m_buffer.data() + static_cast<size_t>(m_headerSize), m_buffer.size() - static_cast<size_t>(m_headerSize));
+		buffer.data() + static_cast<size_t>(m_headerSize), buffer.size() - static_cast<size_t>(m_headerSize));
 }
 
-FORCE_INLINE [[nodiscard]] size_t Data::GetBufferSize() const noexcept { return m_buffer.size(); }
+FORCE_INLINE [[nodiscard]] size_t Data::GetBufferSize() const noexcept
+{
+	return m_view.empty() ? m_buffer.size() : m_view.size();
+}
 
 FORCE_INLINE [[nodiscard]] std::span<const uint8_t> Data::GetBuffer() const noexcept
 {
-	return std::span<const uint8_t>(m_buffer.data(), m_buffer.size());
+	if (m_view.empty()) {
+		return std::span<const uint8_t>(m_buffer.data(), m_buffer.size());
+	}
+
+	return m_view;
+}
+
+FORCE_INLINE [[nodiscard]] bool Data::IsBorrowed() const noexcept { return !m_view.empty(); }
+
+FORCE_INLINE void Data::Detach()
+{
+	if (m_view.empty()) {
+		return;
+	}
+
+	m_buffer.assign(m_view.begin(), m_view.end());
+	m_view = {};
 }
 
 FORCE_INLINE void Data::MergePayload(const Data& other) noexcept
@@ -973,7 +1285,7 @@ FORCE_INLINE [[nodiscard]] bool Data::IsValid() const noexcept
 	}
 
 	const auto payloadSize{ GetPayloadSize() };
-	if (static_cast<size_t>(m_headerSize) > m_buffer.size()) {
+	if (static_cast<size_t>(m_headerSize) > GetBufferSize()) {
 		return false;
 	}
 
@@ -982,7 +1294,10 @@ FORCE_INLINE [[nodiscard]] bool Data::IsValid() const noexcept
 
 FORCE_INLINE [[nodiscard]] bool Data::operator==(const Data& other) const noexcept
 {
-	return m_buffer == other.m_buffer && m_headerSize == other.m_headerSize;
+	const auto buffer{ GetBuffer() };
+	const auto otherBuffer{ other.GetBuffer() };
+	return m_headerSize == other.m_headerSize && buffer.size() == otherBuffer.size()
+		&& memcmp(buffer.data(), otherBuffer.data(), buffer.size()) == 0;
 }
 
 FORCE_INLINE [[nodiscard]] std::string_view Data::EnumToString(const Opcode value)
@@ -1049,27 +1364,182 @@ FORCE_INLINE [[nodiscard]] std::string_view Data::EnumToString(const CloseStatus
 
 FORCE_INLINE [[nodiscard]] uint32_t Data::GenerateMaskingKey()
 {
-	Timer now;
-	const auto nanoseconds{ static_cast<uint32_t>(now.GetNanoseconds()) };
-	const auto seconds{ static_cast<uint32_t>(now.GetSeconds() & 0x00000000FFFFFFFF) };
-	uint64_t doubleKey{ nanoseconds + seconds };
-	doubleKey *= nanoseconds;
-	doubleKey *= seconds;
+	const auto ticks{ static_cast<uint64_t>(FastClock::GetTicks()) };
+	const auto low{ static_cast<uint32_t>(ticks) };
+	const auto high{ static_cast<uint32_t>(ticks >> 32) };
+	uint64_t doubleKey{ low + high };
+	doubleKey *= low;
+	doubleKey *= high;
 	doubleKey *= doubleKey;
 	doubleKey += 1;
 
 	return static_cast<uint32_t>(doubleKey >> 32) + static_cast<uint32_t>(doubleKey);
 }
 
+FORCE_INLINE [[nodiscard]] std::string_view Data::EnumToString(const MaskingPath value)
+{
+	static_assert(U(MaskingPath::Max) == 5, "Missed description for a new masking path enum");
+
+	switch (value) {
+	case MaskingPath::Undefined:
+		return "Undefined";
+	case MaskingPath::Scalar:
+		return "Scalar";
+	case MaskingPath::Sse2:
+		return "SSE2";
+	case MaskingPath::Avx2:
+		return "AVX2";
+	case MaskingPath::Avx512:
+		return "AVX-512";
+	case MaskingPath::Max:
+		return "Max";
+	default:
+		LOG_WARNING_NEW("Unknown WebSocket masking path {}", U(value));
+		return "Unknown";
+	}
+}
+
+FORCE_INLINE [[nodiscard]] bool Data::IsMaskingPathSupported(const MaskingPath path) noexcept
+{
+	switch (path) {
+	case MaskingPath::Scalar:
+		return true;
+#if defined(__x86_64__) || defined(__i386__)
+	case MaskingPath::Sse2:
+		return __builtin_cpu_supports("sse2");
+	case MaskingPath::Avx2:
+		return __builtin_cpu_supports("avx2");
+	case MaskingPath::Avx512:
+		return __builtin_cpu_supports("avx512f");
+#endif
+	default:
+		return false;
+	}
+}
+
+FORCE_INLINE [[nodiscard]] Data::MaskingPath Data::GetMaskingPath() noexcept
+{
+	static const MaskingPath path{ [] {
+		for (const auto candidate : { MaskingPath::Avx512, MaskingPath::Avx2, MaskingPath::Sse2 }) {
+			if (IsMaskingPathSupported(candidate)) {
+				return candidate;
+			}
+		}
+		return MaskingPath::Scalar;
+	}() };
+
+	return path;
+}
+
 FORCE_INLINE void Data::ApplyMask(uint8_t* const payload, const size_t size, const uint32_t mask) noexcept
 {
+	ApplyMask(payload, size, mask, GetMaskingPath());
+}
+
+FORCE_INLINE void Data::ApplyMask(
+	uint8_t* const payload, const size_t size, const uint32_t mask, const MaskingPath path) noexcept
+{
+	//* Vector paths are not worth their setup for control frames and small events
+	if (size < 16 || !IsMaskingPathSupported(path)) {
+		ApplyMaskScalar(payload, size, mask);
+		return;
+	}
+
+#if defined(__x86_64__) || defined(__i386__)
+	switch (path) {
+	case MaskingPath::Sse2:
+		ApplyMaskSse2(payload, size, mask);
+		return;
+	case MaskingPath::Avx2:
+		ApplyMaskAvx2(payload, size, mask);
+		return;
+	case MaskingPath::Avx512:
+		ApplyMaskAvx512(payload, size, mask);
+		return;
+	default:
+		break;
+	}
+#endif
+
+	ApplyMaskScalar(payload, size, mask);
+}
+
+FORCE_INLINE void Data::ApplyMaskScalar(uint8_t* const payload, const size_t size, const uint32_t mask) noexcept
+{
+	//* Byte order of widened mask is the same as of payload, so step of 8 bytes keeps phase of 4 bytes mask
+	uint8_t maskBytes[sizeof(uint64_t)];
+	for (size_t index{}; index < sizeof(uint64_t); ++index) {
+		maskBytes[index] = static_cast<uint8_t>(mask >> (8 * (index & 3)));
+	}
+	uint64_t wideMask;
+	memcpy(&wideMask, maskBytes, sizeof(uint64_t));
+
 	size_t index{};
+	for (; index + sizeof(uint64_t) <= size; index += sizeof(uint64_t)) {
+		uint64_t chunk;
+		memcpy(&chunk, payload + index, sizeof(uint64_t));
+		chunk ^= wideMask;
+		memcpy(payload + index, &chunk, sizeof(uint64_t));
+	}
+
 	while (index < size) {
 		payload[index] ^= static_cast<uint8_t>(mask >> (8 * (index & 3)));
 		index++;
 	}
 }
 
+#if defined(__x86_64__) || defined(__i386__)
+
+__attribute__((target("sse2"))) inline void Data::ApplyMaskSse2(
+	uint8_t* const payload, const size_t size, const uint32_t mask) noexcept
+{
+	const __m128i wideMask{ _mm_set1_epi32(static_cast<int>(mask)) };
+	size_t index{};
+	for (; index + sizeof(__m128i) <= size; index += sizeof(__m128i)) {
+		auto* const chunk{ reinterpret_cast<__m128i*>(payload + index) };
+		_mm_storeu_si128(chunk, _mm_xor_si128(_mm_loadu_si128(chunk), wideMask));
+	}
+
+	ApplyMaskScalar(payload + index, size - index, mask);
+}
+
+__attribute__((target("avx2"))) inline void Data::ApplyMaskAvx2(
+	uint8_t* const payload, const size_t size, const uint32_t mask) noexcept
+{
+	const __m256i wideMask{ _mm256_set1_epi32(static_cast<int>(mask)) };
+	size_t index{};
+	for (; index + sizeof(__m256i) <= size; index += sizeof(__m256i)) {
+		auto* const chunk{ reinterpret_cast<__m256i*>(payload + index) };
+		_mm256_storeu_si256(chunk, _mm256_xor_si256(_mm256_loadu_si256(chunk), wideMask));
+	}
+
+	ApplyMaskSse2(payload + index, size - index, mask);
+}
+
+__attribute__((target("avx512f"))) inline void Data::ApplyMaskAvx512(
+	uint8_t* const payload, const size_t size, const uint32_t mask) noexcept
+{
+	const __m512i wideMask{ _mm512_set1_epi32(static_cast<int>(mask)) };
+	size_t index{};
+	for (; index + sizeof(__m512i) <= size; index += sizeof(__m512i)) {
+		auto* const chunk{ payload + index };
+		_mm512_storeu_si512(chunk, _mm512_xor_si512(_mm512_loadu_si512(chunk), wideMask));
+	}
+
+	//* Tail is a whole number of 4 bytes lanes and the rest bytes, lanes are processed by one masked store
+	if (const auto lanes{ (size - index) / sizeof(uint32_t) }; lanes != 0) {
+		auto* const chunk{ payload + index };
+		const auto lanesMask{ static_cast<__mmask16>((1U << lanes) - 1) };
+		_mm512_mask_storeu_epi32(
+			chunk, lanesMask, _mm512_xor_si512(_mm512_maskz_loadu_epi32(lanesMask, chunk), wideMask));
+		index += lanes * sizeof(uint32_t);
+	}
+
+	ApplyMaskScalar(payload + index, size - index, mask);
+}
+
+#endif
+
 template <typename T, typename S>
 	requires((std::is_same_v<T, int16_t> || std::is_same_v<T, Data::CloseStatusCode>) && sizeof(S) == 1)
 FORCE_INLINE [[nodiscard]] Data Data::CreateClose(const T statusCode, const std::span<S> reason, const uint32_t mask)
@@ -1393,6 +1863,16 @@ FORCE_INLINE void Data::ReverseMaskingInDataWithSmallPayload() noexcept
 
 FORCE_INLINE void Send(const int connection, const Data& data)
 {
+	const auto opcode{ data.GetOpcode() };
+	if ((opcode == Data::Opcode::Text || opcode == Data::Opcode::Binary) && data.IsFinal() && !data.IsRsv1()) {
+		if (std::vector<uint8_t> payload; PerMessageDeflate::Compress(connection, data.GetPayload(), payload,
+				[connection, opcode, mask = data.GetMaskingKey()](const std::vector<uint8_t>& compressed) {
+					Send(connection, Data{ compressed, opcode, mask, true, true });
+				})) {
+			return;
+		}
+	}
+
 	LOG_PROTOCOL_NEW("Send {} to connection: {}", data.ToString(), connection);
 
 	const std::span<const uint8_t> buffer{ data.GetBuffer() };
@@ -1406,10 +1886,35 @@ FORCE_INLINE void Send(const int connection, const Data& data)
 	}
 }
 
-FORCE_INLINE IHandler::FragmentedData::FragmentedData(Data&& data, const int connection) noexcept
-	: data{ std::move(data) }
-	, connection{ connection }
+FORCE_INLINE void SendClose(const int connection, const Data::CloseStatusCode statusCode, const std::string_view reason)
 {
+	// Control message payload is limited by 125 bytes, 2 of them are status code
+	std::array<uint8_t, 125> payload;
+	const auto code{ htobe16(static_cast<uint16_t>(statusCode)) };
+	memcpy(payload.data(), &code, sizeof(code));
+	const auto reasonSize{ std::min(reason.size(), payload.size() - sizeof(code)) };
+	memcpy(payload.data() + sizeof(code), reason.data(), reasonSize);
+	Send(connection,
+		Data{ std::span<const uint8_t>{ payload.data(), sizeof(code) + reasonSize }, Data::Opcode::Close });
+}
+
+FORCE_INLINE void IHandler::FragmentedData::Start(const Data& data)
+{
+	firstByte = data.GetBuffer()[0];
+	masked = data.IsMasked();
+	mask = masked ? data.GetMaskingKey() : 0;
+	buffer.assign(HEADROOM, 0);
+	Append(data.GetPayload());
+	timestamp = FastClock::GetTicks();
+	stored = true;
+}
+
+FORCE_INLINE void IHandler::FragmentedData::Append(const std::span<const uint8_t> payload)
+{
+	if (buffer.capacity() - buffer.size() < payload.size()) {
+		buffer.reserve(std::max(buffer.capacity() * 2, buffer.size() + payload.size()));
+	}
+	buffer.insert(buffer.end(), payload.begin(), payload.end());
 }
 
 FORCE_INLINE IHandler::IHandler(const MSAPI::Application* const application) noexcept
@@ -1417,6 +1922,13 @@ FORCE_INLINE IHandler::IHandler(const MSAPI::Application* const application) noe
 {
 }
 
+FORCE_INLINE IHandler::~IHandler()
+{
+	for (size_t index{ 0 }; index < FRAGMENTED_DATA_PAGES; ++index) {
+		delete[] m_fragmentedDataPages[index].load(std::memory_order_acquire);
+	}
+}
+
 FORCE_INLINE void IHandler::HandleWebSocketPong([[maybe_unused]] const int connection, [[maybe_unused]] Data&& data) { }
 
 FORCE_INLINE void IHandler::Collect(const int connection, Data&& data)
@@ -1428,79 +1940,88 @@ FORCE_INLINE void IHandler::Collect(const int connection, Data&& data)
 			return;
 		}
 
+		// Per RFC 7692 RSV1 is set only on the first frame of compressed message
+		if (data.GetOpcode() != Data::Opcode::Text && data.GetOpcode() != Data::Opcode::Binary
+			&& IsCompressed(connection, data)) [[unlikely]] {
+			LOG_WARNING_NEW_LIMITED("Received {} frame with RSV1 bit, message will be ignored, connection: {}",
+				Data::EnumToString(data.GetOpcode()), connection);
+			return;
+		}
+
 		switch (data.GetOpcode()) {
 		case Data::Opcode::Continuation: {
-			FragmentedData* fragmentedDataPtr{ nullptr };
+			auto* const fragmentedDataPtr{ GetFragmentedData(connection, false) };
+			if (fragmentedDataPtr == nullptr) {
+				LOG_WARNING_NEW_LIMITED(
+					"Received continuation frame without initial fragment, message will be ignored, connection: {}",
+					connection);
+				return;
+			}
+
+			Data completed;
+			size_t completedSize{};
 			{
-				Pthread::AtomicLock::ExitGuard guard{ m_fragmentedDataLock };
-				const auto it{ m_fragmentedDataToConnection.find(connection) };
-				if (it == m_fragmentedDataToConnection.end()) {
-					LOG_WARNING_NEW("Received continuation frame without initial fragment, message will be "
-									"ignored, connection: {}",
+				Pthread::AtomicLock::ExitGuard guard{ fragmentedDataPtr->lock };
+				if (!fragmentedDataPtr->stored) {
+					LOG_WARNING_NEW_LIMITED(
+						"Received continuation frame without initial fragment, message will be ignored, connection: {}",
 						connection);
 					return;
 				}
 
-				fragmentedDataPtr = &it->second;
+				// Slot is locked, so message cannot be purged while fragment is being merged
+				const auto payload{ data.GetPayload() };
+				if (!CheckLimitsForStored(payload.size(), fragmentedDataPtr, connection)) {
+					return;
+				}
+				fragmentedDataPtr->Append(payload);
+				fragmentedDataPtr->timestamp = FastClock::GetTicks();
 
-				const auto incomeFragmentSize{ static_cast<double>(data.GetPayloadSize()) / Data::MB };
-				// Potentially the message is final, so it is removed from map and its potential purging is not
-				// possible, but the occupied memory size is not reduced yet
-				m_fragmentedDataTimerToConnection.erase(fragmentedDataPtr->timestamp);
-				if (!CheckLimitsForStored(incomeFragmentSize, fragmentedDataPtr, connection)) {
+				if (!data.IsFinal()) {
 					return;
 				}
-				fragmentedDataPtr->timestamp = Timer{};
-			}
 
-			auto& dataRef{ fragmentedDataPtr->data };
-			dataRef.MergePayload(data);
-			if (data.IsFinal()) {
-				dataRef.m_buffer[0] |= 0b10000000;
-
-				LOG_PROTOCOL_NEW("Final {}, connection: {}", dataRef.ToString(), connection);
-				const auto dataSizeMb{ static_cast<double>(dataRef.GetPayloadSize()) / Data::MB
-					+ Data::MAXIMUM_HEADER_MB };
-				HandleWebSocket(connection, std::move(fragmentedDataPtr->data));
-				Pthread::AtomicLock::ExitGuard guard{ m_fragmentedDataLock };
-				m_fragmentedDataToConnection.erase(connection);
-				m_storedFragmentedDataSizeMb -= dataSizeMb;
-				return;
+				completedSize = fragmentedDataPtr->reserved;
+				completed = Complete(fragmentedDataPtr);
 			}
 
-			// Runtime overhead in favor of FIFO memory cleaning
-			// The design of protocol itself does not allow to have robust memory storing model without trade offs
-			Pthread::AtomicLock::ExitGuard guard{ m_fragmentedDataLock };
-			m_fragmentedDataTimerToConnection.emplace(fragmentedDataPtr->timestamp, fragmentedDataPtr);
+			LOG_PROTOCOL_NEW("Final {}, connection: {}", completed.ToString(), connection);
+			if (!IsCompressed(connection, completed) || Inflate(connection, completed)) {
+				HandleWebSocket(connection, std::move(completed));
+			}
+			m_storedFragmentedDataSize.fetch_sub(completedSize, std::memory_order_acq_rel);
 			return;
 		}
 		case Data::Opcode::Text:
 		case Data::Opcode::Binary:
 			if (!data.IsFinal()) {
-				Pthread::AtomicLock::ExitGuard guard{ m_fragmentedDataLock };
-				if (!CheckLimitForNew(static_cast<double>(data.GetPayloadSize()) / Data::MB + Data::MAXIMUM_HEADER_MB,
-						connection)) [[unlikely]] {
+				auto* const fragmentedDataPtr{ GetFragmentedData(connection, true) };
+				if (fragmentedDataPtr == nullptr) [[unlikely]] {
+					LOG_WARNING_NEW_LIMITED(
+						"Connection is out of range for fragmented messages, message will be ignored, connection: {}",
+						connection);
 					return;
 				}
 
-				if (auto it{ m_fragmentedDataToConnection.find(connection) }; it != m_fragmentedDataToConnection.end())
-					[[unlikely]] {
-					LOG_WARNING_NEW("Received new fragmented message while previous fragmented message is not "
-									"completed, message will be overwritten, connection: {}",
+				Pthread::AtomicLock::ExitGuard guard{ fragmentedDataPtr->lock };
+				if (fragmentedDataPtr->stored) [[unlikely]] {
+					LOG_WARNING_NEW_LIMITED("Received new fragmented message while previous fragmented message is not "
+											"completed, message will be overwritten, connection: {}",
 						connection);
-					m_storedFragmentedDataSizeMb
-						-= static_cast<double>(it->second.data.GetPayloadSize()) / Data::MB + Data::MAXIMUM_HEADER_MB;
-					it->second.data = std::move(data);
-					m_fragmentedDataTimerToConnection.erase(it->second.timestamp);
-					it->second.timestamp = Timer{};
-					m_fragmentedDataTimerToConnection.emplace(it->second.timestamp, &it->second);
+					Dequeue<false>(fragmentedDataPtr);
+				}
+
+				const auto size{ data.GetPayloadSize() + FRAGMENTED_DATA_OVERHEAD };
+				if (!CheckLimitForNew(size, connection)) [[unlikely]] {
 					return;
 				}
 
-				const auto it{ m_fragmentedDataToConnection
-								   .emplace(connection, FragmentedData{ std::move(data), connection })
-								   .first };
-				m_fragmentedDataTimerToConnection.emplace(it->second.timestamp, &it->second);
+				fragmentedDataPtr->Start(data);
+				fragmentedDataPtr->reserved = size;
+				Enqueue(fragmentedDataPtr);
+				return;
+			}
+			if (IsCompressed(connection, data) && !Inflate(connection, data)) {
 				return;
 			}
 			HandleWebSocket(connection, std::move(data));
@@ -1530,6 +2051,7 @@ FORCE_INLINE void IHandler::Collect(const int connection, Data&& data)
 				LOG_PROTOCOL_NEW("Close frame received without status code, connection: {}", connection);
 			}
 
+			data.Detach();
 			data.m_buffer[0] |= 0b00010000; // Set RSV3 to signal that it is a response to close message
 			data.ReverseMaskingInDataWithSmallPayload();
 			Send(connection, data);
@@ -1537,6 +2059,7 @@ FORCE_INLINE void IHandler::Collect(const int connection, Data&& data)
 			return;
 		}
 		case Data::Opcode::Ping: {
+			data.Detach();
 			data.m_buffer[0] ^= static_cast<uint8_t>(Data::Opcode::Ping);
 			data.m_buffer[0] |= static_cast<uint8_t>(Data::Opcode::Pong);
 			data.ReverseMaskingInDataWithSmallPayload();
@@ -1547,7 +2070,7 @@ FORCE_INLINE void IHandler::Collect(const int connection, Data&& data)
 			HandleWebSocketPong(connection, std::move(data));
 			return;
 		default:
-			LOG_WARNING_NEW("Unknown WebSocket opcode {}, connection: {}", U(data.GetOpcode()), connection);
+			LOG_WARNING_NEW_LIMITED("Unknown WebSocket opcode {}, connection: {}", U(data.GetOpcode()), connection);
 			return;
 		}
 
@@ -1572,10 +2095,10 @@ FORCE_INLINE [[nodiscard]] bool IHandler::SetFragmentedDataLimit(const double li
 		return false;
 	}
 
-	Pthread::AtomicLock::ExitGuard guard{ m_fragmentedDataLock };
 	LOG_PROTOCOL_NEW("WebSocket fragmented data limit changed from {:.17f} MB to {:.17f} MB",
 		m_storedFragmentedDataLimitMb, limitMb);
 	m_storedFragmentedDataLimitMb = limitMb;
+	m_storedFragmentedDataLimit.store(static_cast<size_t>(limitMb * Data::MB), std::memory_order_release);
 	if (ratio < 0) {
 		(void)PurgeStoredData<CHECK_BEFORE>();
 	}
@@ -1585,90 +2108,266 @@ FORCE_INLINE [[nodiscard]] bool IHandler::SetFragmentedDataLimit(const double li
 
 FORCE_INLINE void IHandler::Clear() noexcept
 {
-	Pthread::AtomicLock::ExitGuard guard{ m_fragmentedDataLock };
-	m_fragmentedDataToConnection.clear();
-	m_fragmentedDataTimerToConnection.clear();
-	m_storedFragmentedDataSizeMb = 0.;
+	Pthread::AtomicLock::ExitGuard guard{ m_fragmentedDataQueueLock };
+	auto* fragmentedDataPtr{ m_fragmentedDataHead };
+	while (fragmentedDataPtr != nullptr) {
+		auto* const next{ fragmentedDataPtr->next };
+		if (fragmentedDataPtr->lock.TryLock()) {
+			Dequeue<true>(fragmentedDataPtr);
+			fragmentedDataPtr->lock.Unlock();
+		}
+		fragmentedDataPtr = next;
+	}
 }
 
 FORCE_INLINE void IHandler::ClearConnection(const int connection) noexcept
 {
-	Pthread::AtomicLock::ExitGuard guard{ m_fragmentedDataLock };
-	const auto it{ m_fragmentedDataToConnection.find(connection) };
-	if (it != m_fragmentedDataToConnection.end()) {
-		m_storedFragmentedDataSizeMb
-			-= static_cast<double>(it->second.data.GetPayloadSize()) / Data::MB + Data::MAXIMUM_HEADER_MB;
-		m_fragmentedDataTimerToConnection.erase(it->second.timestamp);
-		m_fragmentedDataToConnection.erase(it);
+	PerMessageDeflate::Close(connection);
+
+	auto* const fragmentedDataPtr{ GetFragmentedData(connection, false) };
+	if (fragmentedDataPtr == nullptr) {
+		return;
+	}
+
+	Pthread::AtomicLock::ExitGuard guard{ fragmentedDataPtr->lock };
+	if (fragmentedDataPtr->stored) {
+		Dequeue<false>(fragmentedDataPtr);
+	}
+}
+
+FORCE_INLINE [[nodiscard]] bool IHandler::IsCompressed(const int connection, const Data& data)
+{
+	// Context lookup is skipped for usual messages
+	return data.IsRsv1() && PerMessageDeflate::IsOpened(connection);
+}
+
+FORCE_INLINE [[nodiscard]] bool IHandler::Inflate(const int connection, Data& data)
+{
+	std::vector<uint8_t> payload;
+	if (!PerMessageDeflate::Inflate(connection, data.GetPayload(), payload)) {
+		LOG_WARNING_NEW_LIMITED("Cannot inflate compressed WebSocket message, connection will be closed with status "
+								"code 1007, payload size: {}, connection: {}",
+			data.GetPayloadSize(), connection);
+		// Inflater history is broken, so no further message of connection can be inflated
+		PerMessageDeflate::Close(connection);
+		SendClose(connection, Data::CloseStatusCode::InvalidFramePayloadData, "Cannot inflate message");
+		return false;
 	}
+
+	data = Data{ payload, data.GetOpcode() };
+	return true;
+}
+
+FORCE_INLINE [[nodiscard]] IHandler::FragmentedData* IHandler::GetFragmentedData(
+	const int connection, const bool create)
+{
+	if (connection < 0 || static_cast<size_t>(connection) >= FRAGMENTED_DATA_PAGE_SIZE * FRAGMENTED_DATA_PAGES)
+		[[unlikely]] {
+		return nullptr;
+	}
+
+	auto& pageRef{ m_fragmentedDataPages[static_cast<size_t>(connection) / FRAGMENTED_DATA_PAGE_SIZE] };
+	auto* page{ pageRef.load(std::memory_order_acquire) };
+	if (page == nullptr) {
+		if (!create) {
+			return nullptr;
+		}
+
+		auto* const newPage{ new FragmentedData[FRAGMENTED_DATA_PAGE_SIZE] };
+		const auto first{ static_cast<int>(
+			static_cast<size_t>(connection) / FRAGMENTED_DATA_PAGE_SIZE * FRAGMENTED_DATA_PAGE_SIZE) };
+		for (size_t index{ 0 }; index < FRAGMENTED_DATA_PAGE_SIZE; ++index) {
+			newPage[index].connection = first + static_cast<int>(index);
+		}
+
+		if (pageRef.compare_exchange_strong(page, newPage, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			page = newPage;
+		}
+		else {
+			delete[] newPage;
+		}
+	}
+
+	return &page[static_cast<size_t>(connection) % FRAGMENTED_DATA_PAGE_SIZE];
 }
 
 template <bool T> FORCE_INLINE [[nodiscard]] bool IHandler::PurgeStoredData()
 {
 	if constexpr (T == CHECK_BEFORE) {
-		if (!Helper::FloatGreater(m_storedFragmentedDataSizeMb, m_storedFragmentedDataLimitMb)) {
+		if (m_storedFragmentedDataSize.load(std::memory_order_acquire)
+			<= m_storedFragmentedDataLimit.load(std::memory_order_acquire)) {
 			return true;
 		}
 	}
 
-	auto it{ m_fragmentedDataTimerToConnection.begin() };
-	while (it != m_fragmentedDataTimerToConnection.end()) {
-		m_storedFragmentedDataSizeMb
-			-= static_cast<double>(it->second->data.GetPayloadSize()) / Data::MB + Data::MAXIMUM_HEADER_MB;
-		LOG_WARNING_NEW(
-			"WebSocket fragmented data purged for connection {} due to limit exceed", it->second->connection);
-		m_fragmentedDataToConnection.erase(it->second->connection);
-		it = m_fragmentedDataTimerToConnection.erase(it);
-
-		if (!Helper::FloatGreater(m_storedFragmentedDataSizeMb, m_storedFragmentedDataLimitMb)) {
-			return true;
+	Pthread::AtomicLock::ExitGuard guard{ m_fragmentedDataQueueLock };
+	auto* fragmentedDataPtr{ m_fragmentedDataHead };
+	while (fragmentedDataPtr != nullptr) {
+		auto* const next{ fragmentedDataPtr->next };
+		// Locked slot is collecting its message right now
+		if (fragmentedDataPtr->lock.TryLock()) {
+			LOG_WARNING_NEW_LIMITED("WebSocket fragmented data purged for connection {} due to limit exceed",
+				fragmentedDataPtr->connection);
+			Dequeue<true>(fragmentedDataPtr);
+			fragmentedDataPtr->lock.Unlock();
+
+			if (m_storedFragmentedDataSize.load(std::memory_order_acquire)
+				<= m_storedFragmentedDataLimit.load(std::memory_order_acquire)) {
+				return true;
+			}
 		}
+		fragmentedDataPtr = next;
+	}
+
+	return false;
+}
+
+FORCE_INLINE [[nodiscard]] bool IHandler::Reserve(const size_t size)
+{
+	if (m_storedFragmentedDataSize.fetch_add(size, std::memory_order_acq_rel) + size
+			<= m_storedFragmentedDataLimit.load(std::memory_order_acquire)
+		|| PurgeStoredData<CHECK_USUAL>()) {
+		return true;
 	}
 
+	m_storedFragmentedDataSize.fetch_sub(size, std::memory_order_acq_rel);
 	return false;
 }
 
+FORCE_INLINE void IHandler::Enqueue(FragmentedData* const fragmentedDataPtr) noexcept
+{
+	Pthread::AtomicLock::ExitGuard guard{ m_fragmentedDataQueueLock };
+	fragmentedDataPtr->previous = m_fragmentedDataTail;
+	fragmentedDataPtr->next = nullptr;
+	if (m_fragmentedDataTail != nullptr) {
+		m_fragmentedDataTail->next = fragmentedDataPtr;
+	}
+	else {
+		m_fragmentedDataHead = fragmentedDataPtr;
+	}
+	m_fragmentedDataTail = fragmentedDataPtr;
+	++m_fragmentedDataQueueSize;
+}
+
+template <bool T> FORCE_INLINE void IHandler::Dequeue(FragmentedData* const fragmentedDataPtr) noexcept
+{
+	{
+		if constexpr (!T) {
+			m_fragmentedDataQueueLock.Lock();
+		}
+
+		if (fragmentedDataPtr->previous != nullptr) {
+			fragmentedDataPtr->previous->next = fragmentedDataPtr->next;
+		}
+		else {
+			m_fragmentedDataHead = fragmentedDataPtr->next;
+		}
+		if (fragmentedDataPtr->next != nullptr) {
+			fragmentedDataPtr->next->previous = fragmentedDataPtr->previous;
+		}
+		else {
+			m_fragmentedDataTail = fragmentedDataPtr->previous;
+		}
+		--m_fragmentedDataQueueSize;
+
+		if constexpr (!T) {
+			m_fragmentedDataQueueLock.Unlock();
+		}
+	}
+
+	fragmentedDataPtr->previous = nullptr;
+	fragmentedDataPtr->next = nullptr;
+	fragmentedDataPtr->stored = false;
+	fragmentedDataPtr->timestamp = 0;
+	std::vector<uint8_t>{}.swap(fragmentedDataPtr->buffer);
+	m_storedFragmentedDataSize.fetch_sub(fragmentedDataPtr->reserved, std::memory_order_acq_rel);
+	fragmentedDataPtr->reserved = 0;
+}
+
+FORCE_INLINE [[nodiscard]] Data IHandler::Complete(FragmentedData* const fragmentedDataPtr)
+{
+	auto& buffer{ fragmentedDataPtr->buffer };
+	const auto payloadSize{ buffer.size() - FragmentedData::HEADROOM };
+	const bool isMasked{ fragmentedDataPtr->masked };
+
+	size_t headerSize{ Data::REQUIRED_HEADER_SIZE };
+	uint8_t sizeByte{ static_cast<uint8_t>(payloadSize) };
+	if (payloadSize > 65535) {
+		headerSize += sizeof(uint64_t);
+		sizeByte = 127;
+	}
+	else if (payloadSize > 125) {
+		headerSize += sizeof(uint16_t);
+		sizeByte = 126;
+	}
+	if (isMasked) {
+		headerSize += sizeof(uint32_t);
+	}
+
+	// Header is written right before payload, only headroom remainder is moved away
+	const auto offset{ FragmentedData::HEADROOM - headerSize };
+	auto* const header{ buffer.data() + offset };
+	header[0] = static_cast<uint8_t>(fragmentedDataPtr->firstByte | 0b10000000);
+	header[1] = static_cast<uint8_t>(sizeByte | static_cast<uint8_t>(isMasked) << 7);
+	if (sizeByte == 126) {
+		const auto size{ htobe16(static_cast<uint16_t>(payloadSize)) };
+		memcpy(header + Data::REQUIRED_HEADER_SIZE, &size, sizeof(uint16_t));
+	}
+	else if (sizeByte == 127) {
+		const auto size{ htobe64(static_cast<uint64_t>(payloadSize)) };
+		memcpy(header + Data::REQUIRED_HEADER_SIZE, &size, sizeof(uint64_t));
+	}
+	if (isMasked) {
+		memcpy(header + headerSize - sizeof(uint32_t), &fragmentedDataPtr->mask, sizeof(uint32_t));
+	}
+	if (offset != 0) {
+		buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+	}
+
+	Data data;
+	data.m_buffer = std::move(buffer);
+	data.m_headerSize = static_cast<int8_t>(headerSize);
+
+	// Budget is returned by caller after message is handled
+	fragmentedDataPtr->reserved = 0;
+	Dequeue<false>(fragmentedDataPtr);
+	return data;
+}
+
 FORCE_INLINE [[nodiscard]] bool IHandler::CheckLimitsForStored(
-	const double additionalSizeMb, FragmentedData* const fragmentedDataPtr, const int connection)
+	const size_t additionalSize, FragmentedData* const fragmentedDataPtr, const int connection)
 {
-	const auto storedFragmentSize{ static_cast<double>(fragmentedDataPtr->data.GetPayloadSize()) / Data::MB
-		+ Data::MAXIMUM_HEADER_MB };
 	// If fragment cannot be stored for sure, do not purge anything
-	if (Helper::FloatGreater(additionalSizeMb + storedFragmentSize, m_storedFragmentedDataLimitMb)) {
-		LOG_WARNING_NEW(
+	if (additionalSize + fragmentedDataPtr->reserved > m_storedFragmentedDataLimit.load(std::memory_order_acquire)) {
+		LOG_WARNING_NEW_LIMITED(
 			"WebSocket income data is dropped and stored data is purged for connection {} due to limit exceed",
 			connection);
-		m_fragmentedDataToConnection.erase(connection);
-		m_storedFragmentedDataSizeMb -= storedFragmentSize;
+		Dequeue<false>(fragmentedDataPtr);
 		return false;
 	}
 
-	m_storedFragmentedDataSizeMb += additionalSizeMb;
-	if (Helper::FloatGreater(m_storedFragmentedDataSizeMb, m_storedFragmentedDataLimitMb)) {
-		if (!PurgeStoredData<CHECK_USUAL>()) {
-			m_fragmentedDataToConnection.erase(connection);
-			m_storedFragmentedDataSizeMb -= storedFragmentSize + additionalSizeMb;
-			return false;
-		}
+	if (!Reserve(additionalSize)) {
+		LOG_WARNING_NEW_LIMITED(
+			"WebSocket income data is dropped and stored data is purged for connection {} due to limit exceed",
+			connection);
+		Dequeue<false>(fragmentedDataPtr);
+		return false;
 	}
 
+	fragmentedDataPtr->reserved += additionalSize;
 	return true;
 }
 
-FORCE_INLINE [[nodiscard]] bool IHandler::CheckLimitForNew(const double additionalSizeMb, const int connection)
+FORCE_INLINE [[nodiscard]] bool IHandler::CheckLimitForNew(const size_t additionalSize, const int connection)
 {
-	if (Helper::FloatGreater(additionalSizeMb, m_storedFragmentedDataLimitMb)) [[unlikely]] {
-		LOG_WARNING_NEW("WebSocket fragment from connection {} is skipped due to limit exceed", connection);
+	if (additionalSize > m_storedFragmentedDataLimit.load(std::memory_order_acquire)) [[unlikely]] {
+		LOG_WARNING_NEW_LIMITED("WebSocket fragment from connection {} is skipped due to limit exceed", connection);
 		return false;
 	}
 
-	m_storedFragmentedDataSizeMb += additionalSizeMb;
-	if (Helper::FloatGreater(m_storedFragmentedDataSizeMb, m_storedFragmentedDataLimitMb)) {
-		if (!PurgeStoredData<CHECK_USUAL>()) {
-			m_fragmentedDataToConnection.erase(connection);
-			m_storedFragmentedDataSizeMb -= additionalSizeMb;
-			return false;
-		}
+	if (!Reserve(additionalSize)) {
+		LOG_WARNING_NEW_LIMITED("WebSocket fragment from connection {} is skipped due to limit exceed", connection);
+		return false;
 	}
 
 	return true;
@@ -0,0 +1,728 @@
+/**************************
+ * @file        webSocketDeflate.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ *
+ * @brief WebSocket permessage-deflate extension (RFC 7692).
+ */
+
+#ifndef MSAPI_WEBSOCKET_DEFLATE_INL
+#define MSAPI_WEBSOCKET_DEFLATE_INL
+
+#include "../help/deflate.inl"
+#include "../help/pthread.hpp"
+#include "../help/time.h"
+#include <charconv>
+#include <concepts>
+#include <memory>
+
+namespace MSAPI {
+
+namespace Protocol {
+
+namespace WebSocket {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Negotiation and per connection compression contexts of permessage-deflate extension. Context is kept in
+ * slot of its connection, slots are indexed by connection and allocated by pages, so send and receive of compressed
+ * message reach context without shared lock. Sender of connection without negotiated extension reads only flag of its
+ * slot.
+ *
+ * @attention Extension is disabled by default. Each context takes about 15 * 2^windowBits bytes, 480 KB for maximum
+ * window, so it should be enabled by SetOptions only if number of connections is bounded, otherwise window bits and
+ * context takeover should be limited.
+ */
+class PerMessageDeflate {
+public:
+	/**
+	 * @brief Server side settings of extension.
+	 */
+	struct Options {
+		// Extension is accepted only if enabled
+		bool enabled{};
+		// Messages with smaller payload are sent uncompressed
+		size_t threshold{ 256 };
+		int8_t serverMaxWindowBits{ Deflater::MAX_WINDOW_BITS };
+		int8_t clientMaxWindowBits{ Deflater::MAX_WINDOW_BITS };
+		bool serverNoContextTakeover{};
+		bool clientNoContextTakeover{};
+		// Maximum size of inflated message, protects from decompression bombs
+		size_t maxMessageSize{ 16 * 1024 * 1024 };
+	};
+
+	/**
+	 * @brief Negotiated parameters of extension.
+	 */
+	struct Parameters {
+		int8_t serverMaxWindowBits{ Deflater::MAX_WINDOW_BITS };
+		int8_t clientMaxWindowBits{ Deflater::MAX_WINDOW_BITS };
+		bool serverNoContextTakeover{};
+		bool clientNoContextTakeover{};
+		// Server must answer with server_max_window_bits if client has requested it
+		bool serverMaxWindowBitsRequested{};
+		// Server can answer with client_max_window_bits only if client has offered it
+		bool clientMaxWindowBitsOffered{};
+	};
+
+	/**
+	 * @brief Snapshot of compression metrics of all connections.
+	 */
+	struct Metrics {
+		uint64_t compressedMessages{};
+		uint64_t skippedMessages{};
+		uint64_t compressInputBytes{};
+		uint64_t compressOutputBytes{};
+		uint64_t compressNanoseconds{};
+		uint64_t inflatedMessages{};
+		uint64_t failedMessages{};
+		uint64_t inflateInputBytes{};
+		uint64_t inflateOutputBytes{};
+		uint64_t inflateNanoseconds{};
+
+		/**
+		 * @return Compressed size to original size of sent messages, 1 if nothing is compressed.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE [[nodiscard]] double GetRatio() const noexcept;
+
+		/**
+		 * @return String interpretation of metrics.
+		 *
+		 * @example Permessage-deflate metrics:
+		 * {
+		 * 	Compressed messages : 12
+		 * 	Skipped messages    : 3
+		 * 	Compress bytes      : 480133 -> 41210
+		 * 	Compress ratio      : 0.08583
+		 * 	Compress time       : 2.41200 ms
+		 * 	Inflated messages   : 4
+		 * 	Failed messages     : 0
+		 * 	Inflate bytes       : 118 -> 260
+		 * 	Inflate time        : 0.01800 ms
+		 * }
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE [[nodiscard]] std::string ToString() const;
+	};
+
+	static constexpr inline std::string_view NAME{ "permessage-deflate" };
+	// Connection slots are allocated by pages on first negotiation of connection
+	static constexpr inline size_t CONNECTION_PAGE_SIZE{ 256 };
+	static constexpr inline size_t CONNECTION_PAGES{ 4096 };
+
+private:
+	/**
+	 * @brief Compression state of connection.
+	 */
+	struct Context {
+		Deflater deflater;
+		// Held while message is compressed and sent, as peer must receive messages in order of deflater history
+		Pthread::AtomicLock deflaterLock{ "WebSocketDeflate::deflater" };
+		Inflater inflater;
+		Pthread::AtomicLock inflaterLock{ "WebSocketDeflate::inflater" };
+		const size_t threshold;
+		const size_t maxMessageSize;
+
+		/**
+		 * @brief Construct a new Context object.
+		 *
+		 * @param parameters Negotiated parameters.
+		 * @param options Server side settings.
+		 */
+		FORCE_INLINE Context(const Parameters& parameters, const Options& options);
+	};
+
+	/**
+	 * @brief Extension state of one connection.
+	 */
+	struct Connection {
+		// Set while context is opened, so senders of connection without extension do not load context
+		std::atomic<bool> opened{};
+		std::atomic<std::shared_ptr<Context>> context;
+	};
+
+	/**
+	 * @brief Pages of connection slots, pages live till the end of process.
+	 */
+	struct Connections {
+		std::atomic<Connection*> pages[CONNECTION_PAGES]{};
+
+		/**
+		 * @brief Destroy the Connections object, free allocated pages.
+		 */
+		FORCE_INLINE ~Connections();
+	};
+
+	// Defined after class, as default member initializers of nested classes are not available inside enclosing class
+	static Connections m_connections;
+	static Options m_options;
+	static inline Pthread::AtomicRWLock m_optionsLock{ "WebSocketDeflate::options" };
+
+	static inline std::atomic<uint64_t> m_compressedMessages{};
+	static inline std::atomic<uint64_t> m_skippedMessages{};
+	static inline std::atomic<uint64_t> m_compressInputBytes{};
+	static inline std::atomic<uint64_t> m_compressOutputBytes{};
+	static inline std::atomic<uint64_t> m_compressNanoseconds{};
+	static inline std::atomic<uint64_t> m_inflatedMessages{};
+	static inline std::atomic<uint64_t> m_failedMessages{};
+	static inline std::atomic<uint64_t> m_inflateInputBytes{};
+	static inline std::atomic<uint64_t> m_inflateOutputBytes{};
+	static inline std::atomic<uint64_t> m_inflateNanoseconds{};
+
+public:
+	/**
+	 * @return Settings applied to new connections.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static Options GetOptions();
+
+	/**
+	 * @brief Set settings for new connections, already negotiated connections are not affected.
+	 *
+	 * @param options New settings.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE static void SetOptions(const Options& options);
+
+	/**
+	 * @brief Negotiate extension for connection upgrade with current settings and open compression context. Context of
+	 * previous connection with the same socket is closed.
+	 *
+	 * @param connection Socket connection of upgrade request.
+	 * @param offers Value of Sec-WebSocket-Extensions header, can be nullptr.
+	 *
+	 * @return Value of Sec-WebSocket-Extensions header for response, empty if extension is not accepted.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static std::string Accept(int connection, const std::string* offers);
+
+	/**
+	 * @brief Choose the first acceptable permessage-deflate offer from Sec-WebSocket-Extensions header.
+	 *
+	 * @param offers Value of Sec-WebSocket-Extensions header.
+	 * @param options Server side settings.
+	 *
+	 * @return Negotiated parameters, nullopt if extension is disabled or no offer is acceptable.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static std::optional<Parameters> Negotiate(
+		std::string_view offers, const Options& options);
+
+	/**
+	 * @param parameters Negotiated parameters.
+	 *
+	 * @return Value of Sec-WebSocket-Extensions header for response.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static std::string GetResponse(const Parameters& parameters);
+
+	/**
+	 * @brief Create compression context for connection, replacing existing one.
+	 *
+	 * @param connection Socket connection.
+	 * @param parameters Negotiated parameters.
+	 * @param options Server side settings.
+	 *
+	 * @return True if context is opened, false if connection is out of range of slots.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static bool Open(int connection, const Parameters& parameters, const Options& options);
+
+	/**
+	 * @brief Remove compression context of connection if exists.
+	 *
+	 * @param connection Socket connection.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE static void Close(int connection);
+
+	/**
+	 * @param connection Socket connection.
+	 *
+	 * @return True if connection has compression context.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static bool IsOpened(int connection);
+
+	/**
+	 * @brief Compress message payload if connection has compression context and payload is not less than threshold,
+	 * and send it. Compression context of connection is locked till sender returns, so compressed messages of
+	 * concurrent senders are sent in the same order as they are compressed.
+	 *
+	 * @tparam S Type of sender, invocable with const std::vector<uint8_t>&.
+	 *
+	 * @param connection Socket connection.
+	 * @param payload Message payload.
+	 * @param output Destination of compressed payload.
+	 * @param sender Sender of compressed payload.
+	 *
+	 * @return True if payload is compressed and sent, false if it should be sent as is.
+	 *
+	 * @test Has unit test.
+	 */
+	template <typename S>
+		requires std::invocable<S, const std::vector<uint8_t>&>
+	FORCE_INLINE [[nodiscard]] static bool Compress(
+		int connection, std::span<const uint8_t> payload, std::vector<uint8_t>& output, S&& sender);
+
+	/**
+	 * @brief Inflate message payload with compression context of connection.
+	 *
+	 * @param connection Socket connection.
+	 * @param payload Compressed message payload.
+	 * @param output Destination of inflated payload.
+	 *
+	 * @return True if payload is inflated, false if there is no context, data is corrupted or exceeds message limit.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static bool Inflate(
+		int connection, std::span<const uint8_t> payload, std::vector<uint8_t>& output);
+
+	/**
+	 * @return Snapshot of compression metrics of all connections.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] static Metrics GetMetrics() noexcept;
+
+private:
+	/**
+	 * @param connection Socket connection.
+	 * @param create If true, page of slot is allocated when it does not exist.
+	 *
+	 * @return Slot of connection, nullptr if connection is out of range or page does not exist and is not created.
+	 */
+	FORCE_INLINE [[nodiscard]] static Connection* GetConnection(int connection, bool create);
+
+	/**
+	 * @param connection Socket connection.
+	 *
+	 * @return Compression context of connection, nullptr if extension is not negotiated for connection.
+	 */
+	FORCE_INLINE [[nodiscard]] static std::shared_ptr<Context> Find(int connection);
+
+	/**
+	 * @brief Parse one permessage-deflate offer parameters.
+	 *
+	 * @param offer Parameters of offer after extension name.
+	 * @param options Server side settings.
+	 *
+	 * @return Negotiated parameters, nullopt if offer is malformed or not acceptable.
+	 */
+	FORCE_INLINE [[nodiscard]] static std::optional<Parameters> ParseOffer(
+		std::string_view offer, const Options& options);
+
+	/**
+	 * @return View without leading and trailing spaces and tabs.
+	 */
+	FORCE_INLINE [[nodiscard]] static std::string_view Trim(std::string_view value) noexcept;
+
+	/**
+	 * @return Window bits in [8, 15] from optionally quoted value, nullopt if value is invalid.
+	 */
+	FORCE_INLINE [[nodiscard]] static std::optional<int8_t> ParseWindowBits(std::string_view value) noexcept;
+};
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+inline PerMessageDeflate::Connections PerMessageDeflate::m_connections;
+inline PerMessageDeflate::Options PerMessageDeflate::m_options;
+
+FORCE_INLINE [[nodiscard]] double PerMessageDeflate::Metrics::GetRatio() const noexcept
+{
+	if (compressInputBytes == 0) {
+		return 1.;
+	}
+
+	return static_cast<double>(compressOutputBytes) / static_cast<double>(compressInputBytes);
+}
+
+FORCE_INLINE [[nodiscard]] std::string PerMessageDeflate::Metrics::ToString() const
+{
+	return std::format("Permessage-deflate metrics:\n{{"
+					   "\n\tCompressed messages : {}"
+					   "\n\tSkipped messages    : {}"
+					   "\n\tCompress bytes      : {} -> {}"
+					   "\n\tCompress ratio      : {:.5f}"
+					   "\n\tCompress time       : {:.5f} ms"
+					   "\n\tInflated messages   : {}"
+					   "\n\tFailed messages     : {}"
+					   "\n\tInflate bytes       : {} -> {}"
+					   "\n\tInflate time        : {:.5f} ms\n}}",
+		compressedMessages, skippedMessages, compressInputBytes, compressOutputBytes, GetRatio(),
+		static_cast<double>(compressNanoseconds) / 1000000., inflatedMessages, failedMessages, inflateInputBytes,
+		inflateOutputBytes, static_cast<double>(inflateNanoseconds) / 1000000.);
+}
+
+FORCE_INLINE PerMessageDeflate::Context::Context(const Parameters& parameters, const Options& options)
+	: deflater{ parameters.serverMaxWindowBits, !parameters.serverNoContextTakeover }
+	, inflater{ parameters.clientMaxWindowBits, !parameters.clientNoContextTakeover }
+	, threshold{ options.threshold }
+	, maxMessageSize{ options.maxMessageSize }
+{
+}
+
+FORCE_INLINE PerMessageDeflate::Connections::~Connections()
+{
+	for (auto& page : pages) {
+		delete[] page.load(std::memory_order_acquire);
+	}
+}
+
+FORCE_INLINE [[nodiscard]] PerMessageDeflate::Options PerMessageDeflate::GetOptions()
+{
+	Pthread::AtomicRWLock::ExitGuard<Pthread::read> guard{ m_optionsLock };
+	return m_options;
+}
+
+FORCE_INLINE void PerMessageDeflate::SetOptions(const Options& options)
+{
+	Pthread::AtomicRWLock::ExitGuard<Pthread::write> guard{ m_optionsLock };
+	m_options = options;
+}
+
+FORCE_INLINE [[nodiscard]] std::string PerMessageDeflate::Accept(const int connection, const std::string* const offers)
+{
+	Close(connection);
+	if (offers == nullptr) {
+		return {};
+	}
+
+	const auto options{ GetOptions() };
+	const auto parameters{ Negotiate(*offers, options) };
+	if (!parameters.has_value()) {
+		LOG_PROTOCOL_NEW("Permessage-deflate is not accepted, offers: {}, connection: {}", *offers, connection);
+		return {};
+	}
+
+	if (!Open(connection, *parameters, options)) {
+		LOG_WARNING_NEW("Permessage-deflate is not accepted, connection is out of range: {}", connection);
+		return {};
+	}
+
+	auto response{ GetResponse(*parameters) };
+	LOG_PROTOCOL_NEW("Permessage-deflate is accepted: {}, connection: {}", response, connection);
+	return response;
+}
+
+FORCE_INLINE [[nodiscard]] std::optional<PerMessageDeflate::Parameters> PerMessageDeflate::Negotiate(
+	std::string_view offers, const Options& options)
+{
+	if (!options.enabled) {
+		return std::nullopt;
+	}
+
+	while (!offers.empty()) {
+		const auto end{ offers.find(',') };
+		const auto offer{ Trim(offers.substr(0, end)) };
+		offers = end == std::string_view::npos ? std::string_view{} : offers.substr(end + 1);
+
+		const auto nameEnd{ offer.find(';') };
+		if (Trim(offer.substr(0, nameEnd)) != NAME) {
+			continue;
+		}
+
+		if (auto parameters{ ParseOffer(
+				nameEnd == std::string_view::npos ? std::string_view{} : offer.substr(nameEnd + 1), options) };
+			parameters.has_value()) {
+			return parameters;
+		}
+	}
+
+	return std::nullopt;
+}
+
+FORCE_INLINE [[nodiscard]] std::string PerMessageDeflate::GetResponse(const Parameters& parameters)
+{
+	std::string response{ NAME };
+	if (parameters.serverNoContextTakeover) {
+		response += "; server_no_context_takeover";
+	}
+	if (parameters.clientNoContextTakeover) {
+		response += "; client_no_context_takeover";
+	}
+	if (parameters.serverMaxWindowBitsRequested || parameters.serverMaxWindowBits < Deflater::MAX_WINDOW_BITS) {
+		std::format_to(std::back_inserter(response), "; server_max_window_bits={}",
+			static_cast<int32_t>(parameters.serverMaxWindowBits));
+	}
+	if (parameters.clientMaxWindowBitsOffered && parameters.clientMaxWindowBits < Deflater::MAX_WINDOW_BITS) {
+		std::format_to(std::back_inserter(response), "; client_max_window_bits={}",
+			static_cast<int32_t>(parameters.clientMaxWindowBits));
+	}
+
+	return response;
+}
+
+FORCE_INLINE [[nodiscard]] bool PerMessageDeflate::Open(
+	const int connection, const Parameters& parameters, const Options& options)
+{
+	auto* const connectionPtr{ GetConnection(connection, true) };
+	if (connectionPtr == nullptr) [[unlikely]] {
+		return false;
+	}
+
+	connectionPtr->context.store(std::make_shared<Context>(parameters, options), std::memory_order_release);
+	connectionPtr->opened.store(true, std::memory_order_release);
+	return true;
+}
+
+FORCE_INLINE void PerMessageDeflate::Close(const int connection)
+{
+	auto* const connectionPtr{ GetConnection(connection, false) };
+	if (connectionPtr == nullptr || !connectionPtr->opened.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	connectionPtr->opened.store(false, std::memory_order_release);
+	connectionPtr->context.store(nullptr, std::memory_order_release);
+}
+
+FORCE_INLINE [[nodiscard]] bool PerMessageDeflate::IsOpened(const int connection)
+{
+	return Find(connection) != nullptr;
+}
+
+template <typename S>
+	requires std::invocable<S, const std::vector<uint8_t>&>
+FORCE_INLINE [[nodiscard]] bool PerMessageDeflate::Compress(
+	const int connection, const std::span<const uint8_t> payload, std::vector<uint8_t>& output, S&& sender)
+{
+	const auto context{ Find(connection) };
+	if (context == nullptr) {
+		return false;
+	}
+
+	if (payload.size() < context->threshold) {
+		m_skippedMessages.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	Pthread::AtomicLock::ExitGuard guard{ context->deflaterLock };
+	const Timer start;
+	context->deflater.Compress(payload, output);
+	const auto elapsed{ (Timer{} - start).GetNanoseconds() };
+	sender(output);
+
+	m_compressNanoseconds.fetch_add(UINT64(elapsed), std::memory_order_relaxed);
+	m_compressedMessages.fetch_add(1, std::memory_order_relaxed);
+	m_compressInputBytes.fetch_add(payload.size(), std::memory_order_relaxed);
+	m_compressOutputBytes.fetch_add(output.size(), std::memory_order_relaxed);
+	return true;
+}
+
+FORCE_INLINE [[nodiscard]] bool PerMessageDeflate::Inflate(
+	const int connection, const std::span<const uint8_t> payload, std::vector<uint8_t>& output)
+{
+	const auto context{ Find(connection) };
+	if (context == nullptr) {
+		m_failedMessages.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	const Timer start;
+	bool result;
+	{
+		Pthread::AtomicLock::ExitGuard guard{ context->inflaterLock };
+		result = context->inflater.Inflate(payload, output, context->maxMessageSize);
+	}
+
+	if (!result) {
+		m_failedMessages.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	m_inflateNanoseconds.fetch_add(UINT64((Timer{} - start).GetNanoseconds()), std::memory_order_relaxed);
+	m_inflatedMessages.fetch_add(1, std::memory_order_relaxed);
+	m_inflateInputBytes.fetch_add(payload.size(), std::memory_order_relaxed);
+	m_inflateOutputBytes.fetch_add(output.size(), std::memory_order_relaxed);
+	return true;
+}
+
+FORCE_INLINE [[nodiscard]] PerMessageDeflate::Metrics PerMessageDeflate::GetMetrics() noexcept
+{
+	return { m_compressedMessages.load(std::memory_order_relaxed), m_skippedMessages.load(std::memory_order_relaxed),
+		m_compressInputBytes.load(std::memory_order_relaxed), m_compressOutputBytes.load(std::memory_order_relaxed),
+		m_compressNanoseconds.load(std::memory_order_relaxed), m_inflatedMessages.load(std::memory_order_relaxed),
+		m_failedMessages.load(std::memory_order_relaxed), m_inflateInputBytes.load(std::memory_order_relaxed),
+		m_inflateOutputBytes.load(std::memory_order_relaxed), m_inflateNanoseconds.load(std::memory_order_relaxed) };
+}
+
+FORCE_INLINE [[nodiscard]] PerMessageDeflate::Connection* PerMessageDeflate::GetConnection(
+	const int connection, const bool create)
+{
+	if (connection < 0 || static_cast<size_t>(connection) >= CONNECTION_PAGE_SIZE * CONNECTION_PAGES) [[unlikely]] {
+		return nullptr;
+	}
+
+	auto& pageRef{ m_connections.pages[static_cast<size_t>(connection) / CONNECTION_PAGE_SIZE] };
+	auto* page{ pageRef.load(std::memory_order_acquire) };
+	if (page == nullptr) {
+		if (!create) {
+			return nullptr;
+		}
+
+		auto* const newPage{ new Connection[CONNECTION_PAGE_SIZE] };
+		if (pageRef.compare_exchange_strong(page, newPage, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			page = newPage;
+		}
+		else {
+			delete[] newPage;
+		}
+	}
+
+	return &page[static_cast<size_t>(connection) % CONNECTION_PAGE_SIZE];
+}
+
+FORCE_INLINE [[nodiscard]] std::shared_ptr<PerMessageDeflate::Context> PerMessageDeflate::Find(const int connection)
+{
+	auto* const connectionPtr{ GetConnection(connection, false) };
+	if (connectionPtr == nullptr || !connectionPtr->opened.load(std::memory_order_acquire)) {
+		return nullptr;
+	}
+
+	return connectionPtr->context.load(std::memory_order_acquire);
+}
+
+FORCE_INLINE [[nodiscard]] std::optional<PerMessageDeflate::Parameters> PerMessageDeflate::ParseOffer(
+	std::string_view offer, const Options& options)
+{
+	Parameters parameters;
+	bool serverNoContextTakeover{};
+	bool clientNoContextTakeover{};
+	std::optional<int8_t> serverMaxWindowBits;
+	std::optional<int8_t> clientMaxWindowBits;
+
+	while (!offer.empty()) {
+		const auto end{ offer.find(';') };
+		const auto parameter{ Trim(offer.substr(0, end)) };
+		offer = end == std::string_view::npos ? std::string_view{} : offer.substr(end + 1);
+
+		const auto separator{ parameter.find('=') };
+		const auto name{ Trim(parameter.substr(0, separator)) };
+		const auto value{ separator == std::string_view::npos ? std::string_view{}
+															  : Trim(parameter.substr(separator + 1)) };
+
+		// Each parameter can be presented only once
+		if (name == "server_no_context_takeover") {
+			if (serverNoContextTakeover || separator != std::string_view::npos) {
+				return std::nullopt;
+			}
+			serverNoContextTakeover = true;
+		}
+		else if (name == "client_no_context_takeover") {
+			if (clientNoContextTakeover || separator != std::string_view::npos) {
+				return std::nullopt;
+			}
+			clientNoContextTakeover = true;
+		}
+		else if (name == "server_max_window_bits") {
+			if (parameters.serverMaxWindowBitsRequested) {
+				return std::nullopt;
+			}
+			serverMaxWindowBits = ParseWindowBits(value);
+			if (!serverMaxWindowBits.has_value()) {
+				return std::nullopt;
+			}
+			parameters.serverMaxWindowBitsRequested = true;
+		}
+		else if (name == "client_max_window_bits") {
+			if (parameters.clientMaxWindowBitsOffered) {
+				return std::nullopt;
+			}
+			if (separator != std::string_view::npos) {
+				clientMaxWindowBits = ParseWindowBits(value);
+				if (!clientMaxWindowBits.has_value()) {
+					return std::nullopt;
+				}
+			}
+			parameters.clientMaxWindowBitsOffered = true;
+		}
+		else if (!name.empty()) {
+			LOG_DEBUG_NEW("Unknown permessage-deflate parameter: {}", name);
+			return std::nullopt;
+		}
+	}
+
+	const auto serverWindowBits{ std::clamp(options.serverMaxWindowBits, Deflater::MIN_WINDOW_BITS,
+		Deflater::MAX_WINDOW_BITS) };
+	parameters.serverMaxWindowBits
+		= std::min(serverMaxWindowBits.value_or(Deflater::MAX_WINDOW_BITS), serverWindowBits);
+	parameters.serverNoContextTakeover = serverNoContextTakeover || options.serverNoContextTakeover;
+	parameters.clientNoContextTakeover = clientNoContextTakeover || options.clientNoContextTakeover;
+
+	// Client window can be limited only if client supports the parameter
+	if (parameters.clientMaxWindowBitsOffered) {
+		const auto clientWindowBits{ std::clamp(options.clientMaxWindowBits, Deflater::MIN_WINDOW_BITS,
+			Deflater::MAX_WINDOW_BITS) };
+		parameters.clientMaxWindowBits
+			= std::min(clientMaxWindowBits.value_or(Deflater::MAX_WINDOW_BITS), clientWindowBits);
+	}
+
+	return parameters;
+}
+
+FORCE_INLINE [[nodiscard]] std::string_view PerMessageDeflate::Trim(std::string_view value) noexcept
+{
+	while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+		value.remove_prefix(1);
+	}
+	while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+		value.remove_suffix(1);
+	}
+
+	return value;
+}
+
+FORCE_INLINE [[nodiscard]] std::optional<int8_t> PerMessageDeflate::ParseWindowBits(std::string_view value) noexcept
+{
+	if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+		value = value.substr(1, value.size() - 2);
+	}
+
+	int8_t bits{};
+	if (const auto [ptr, error]{ std::from_chars(value.data(), value.data() + value.size(), bits) };
+		error != std::errc{} || ptr != value.data() + value.size() || bits < Deflater::MIN_WINDOW_BITS
+		|| bits > Deflater::MAX_WINDOW_BITS) {
+		return std::nullopt;
+	}
+
+	return bits;
+}
+
+} // namespace WebSocket
+
+} // namespace Protocol
+
+} // namespace MSAPI
+
+#endif // MSAPI_WEBSOCKET_DEFLATE_INL
@@ -23,9 +23,19 @@
 #ifndef MSAPI_PROTOCOL_WEBSOCKET_EVENTS_INL
 #define MSAPI_PROTOCOL_WEBSOCKET_EVENTS_INL
 
+#include "../help/continuousAllocator.hpp"
 #include "../help/json.h"
+#include "../help/rcu.hpp"
 #include "../server/authorization.inl"
 #include "webSocket.inl"
+#include "webSocketEventsBinary.inl"
+#include "webSocketEventsPatch.inl"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <pthread.h>
+#include <set>
 
 namespace MSAPI {
 
@@ -396,14 +406,22 @@ public:
 	 *
 	 * @todo Add unit test.
 	 */
-	FORCE_INLINE void SendState(const State state) const
+	FORCE_INLINE void SendState(const State state) const { SendState(GetUid(), GetConnection(), state); }
+
+	/**
+	 * @brief Send new stream state, is used when stream event is already owned by distributor.
+	 *
+	 * @param uid Event uid.
+	 * @param connection Request connection.
+	 * @param state New state.
+	 */
+	FORCE_INLINE static void SendState(const uint64_t uid, const int32_t connection, const State state)
 	{
-		LOG_PROTOCOL_NEW(
-			"Send stream event {} state, uid {} connection {}", EnumToString(state), GetUid(), GetConnection());
-		std::string payload{ std::format("{{\"uids\":[{}],\"state\":{}}}", GetUid(), U(state)) };
+		LOG_PROTOCOL_NEW("Send stream event {} state, uid {} connection {}", EnumToString(state), uid, connection);
+		std::string payload{ std::format("{{\"uids\":[{}],\"state\":{}}}", uid, U(state)) };
 		Data data{ std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(payload.data()), payload.size()),
 			Data::Opcode::Text };
-		Send(GetConnection(), data);
+		Send(connection, data);
 	}
 
 	/**
@@ -465,10 +483,10 @@ FORCE_INLINE static void SendFailed(const uint64_t uid, const int32_t connection
  * limits stored events for each connection separately.
  *
  * Contains events in three: connection -> filters -> events.
- * Events storing is limited by the total number of events. If the number of events is exceed the limit, due to the
- * difficulty of data structures and parallelism efficiency access algorithms they are purged in bunch at once. Purging
- * coefficient is controls the bunch size. Puring order is FIFO. Limits can be controlled dynamically. Event though
- * purging process is costly, it affects only the connection which overflow the limit.
+ * Events storing is limited by the total number of events. If the number of events is exceed the limit, they are purged
+ * in bunch at once. Purging coefficient is controls the bunch size. Puring order is FIFO, events of the connection are
+ * linked into one time-ordered queue, so purging costs only the number of purged events. Limits can be controlled
+ * dynamically, purging affects only the connection which overflow the limit.
  *
  * Real filter is a pair of event type hash and filter.
  *
@@ -479,27 +497,61 @@ FORCE_INLINE static void SendFailed(const uint64_t uid, const int32_t connection
  */
 template <typename Module, typename EventType, typename Filter, typename Impl> class Distributor {
 public:
+	class Events;
 	class EventsData;
 
 	using filter_t = std::pair<uint64_t, Filter>;
 
 	/**
-	 * @brief Events under same filter.
+	 * @brief Subscribed events in filter index, keeps related events data alive while snapshot is in use.
+	 */
+	struct Holder {
+		std::shared_ptr<EventsData> data;
+		std::shared_ptr<Events> events;
+	};
+
+	using holders_t = std::vector<Holder>;
+	using index_t = std::map<filter_t, std::shared_ptr<const holders_t>>;
+
+	/**
+	 * @brief Pooled node of stored event. Is linked into time-ordered queue of the connection and into list of events
+	 * under the same filter, so purging in FIFO order and erasing by filter do not require searching or sorting.
+	 */
+	struct EventNode {
+		std::optional<EventType> event;
+		Timer timestamp{ 0 };
+		Events* owner{ nullptr };
+		EventNode* previous{ nullptr };
+		EventNode* next{ nullptr };
+		EventNode* ownerPrevious{ nullptr };
+		EventNode* ownerNext{ nullptr };
+	};
+
+	/**
+	 * @brief Events under same filter. Non-empty events are registered in filter index of the distributor.
+	 *
+	 * @attention Events are guarded by the events lock of related events data.
 	 */
-	class Events {
+	class Events : public std::enable_shared_from_this<Events> {
 	private:
-		std::map<Timer, std::shared_ptr<EventType>> m_events;
-		Pthread::AtomicRWLock m_eventsLock;
+		EventNode* m_head{ nullptr };
+		EventNode* m_tail{ nullptr };
+		size_t m_size{};
 		EventsData& m_data;
+		const filter_t m_filter;
 
 	public:
 		/**
 		 * @brief Construct new events object.
 		 *
+		 * @param data Events data of the related connection.
+		 * @param filter Filter of the events.
+		 *
 		 * @todo Add unit test.
 		 */
-		FORCE_INLINE Events(EventsData& data) noexcept
+		FORCE_INLINE Events(EventsData& data, const filter_t& filter) noexcept
 			: m_data{ data }
+			, m_filter{ filter }
 		{
 		}
 
@@ -509,39 +561,25 @@ public:
 		Events& operator=(Events&& other) = delete;
 
 		/**
-		 * @brief Add new event with current timestamp, increase stored events size and purge events in case of limit
-		 * exceeding.
-		 *
-		 * @attention Write locks the structure. Does not change limit usage in case of emplace failure.
+		 * @brief Add new event with current timestamp to the end of connection queue, increase stored events size and
+		 * purge events in case of limit exceeding.
 		 *
-		 * @tparam Universal R or L-reference of the event type.
+		 * @attention Write locks events of the connection.
 		 *
 		 * @param event Event to be added.
 		 *
-		 * @todo Add unit test.
+		 * @test Has unit test.
 		 */
-		template <typename Universal>
-			requires std::is_same_v<std::decay_t<Universal>, std::shared_ptr<EventType>>
-		FORCE_INLINE void AddEvent(Universal&& event) noexcept
+		FORCE_INLINE void AddEvent(EventType&& event)
 		{
-			const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ m_eventsLock };
-			const Timer timestamp{};
-			const auto result{ m_events.emplace(timestamp, std::forward<Universal>(event)) };
-			if (!result.second) [[unlikely]] {
-				LOG_WARNING_NEW(
-					"Events with uid {} is not emplaced, connection ", event->GetUid(), m_data.GetConnection());
-				return;
-			}
-
-			LOG_PROTOCOL_NEW("Event uid {} is added at {}, connection {}", result.first->second->GetUid(),
-				timestamp.ToString(), m_data.GetConnection());
-			m_data.IncreaseEventsSize(1);
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ m_data.GetLock() };
+			m_data.Push(*this, std::move(event));
 		}
 
 		/**
 		 * @brief Fail contained events and erase them.
 		 *
-		 * @attention Write locks structure.
+		 * @attention Write locks events of the connection.
 		 *
 		 * @param error Description of the failure.
 		 *
@@ -550,139 +588,139 @@ public:
 		 */
 		FORCE_INLINE void FailEvents(const std::string_view error)
 		{
-			const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ m_eventsLock };
-			const auto size{ m_events.size() };
-			if (size == 0) {
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ m_data.GetLock() };
+			if (m_head == nullptr) {
 				return;
 			}
 
-			for (const auto& event : m_events) {
-				SendFailed(event.second->GetUid(), event.second->GetConnection(), error);
+			// Batched data must reach the connection before the failure of the same events
+			m_data.FlushBatch();
+			while (m_head != nullptr) {
+				SendFailed(m_head->event->GetUid(), m_head->event->GetConnection(), error);
+				m_data.Pop(m_head);
 			}
-
-			m_events.clear();
-			m_data.DecreaseEventsSize(static_cast<int32_t>(size));
 		}
 
 		/**
 		 * @brief Erase contained events.
 		 *
-		 * @attention Write locks structure.
+		 * @attention Write locks events of the connection.
 		 *
-		 * @todo Add unit test.
+		 * @test Has unit test.
 		 */
 		FORCE_INLINE void EraseEvents()
 		{
-			const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ m_eventsLock };
-			const auto size{ m_events.size() };
-			if (size == 0) {
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ m_data.GetLock() };
+			if (m_head == nullptr) {
 				return;
 			}
 
-			LOG_PROTOCOL_NEW("{} Events are removed, connection {}", size, m_data.GetConnection());
-
-			m_events.clear();
-			m_data.DecreaseEventsSize(static_cast<int32_t>(size));
+			LOG_PROTOCOL_NEW("{} Events are removed, connection {}", m_size, m_data.GetConnection());
+			while (m_head != nullptr) {
+				m_data.Pop(m_head);
+			}
 		}
 
 		/**
-		 * @brief Erase event by its timestamp and decrease stored events size.
-		 *
-		 * @attention Write locks the structure. Does not change limit usage in case of erase failure.
-		 *
-		 * @param timestamp Timestamp when event was added.
+		 * @return Read-write lock of events of the connection.
 		 *
 		 * @todo Add unit test.
 		 */
-		FORCE_INLINE void EraseEvent(const Timer timestamp) noexcept
-		{
-			const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ m_eventsLock };
-			if (m_events.erase(timestamp) == 0) [[unlikely]] {
-				LOG_WARNING_NEW("Events with timestamp {} is not erased, connection {}", timestamp.ToString(),
-					m_data.GetConnection());
-				return;
-			}
-
-			LOG_PROTOCOL_NEW(
-				"Event is removed, timestamp {} connection {}", timestamp.ToString(), m_data.GetConnection());
-			m_data.DecreaseEventsSize(1);
-		}
+		FORCE_INLINE [[nodiscard]] Pthread::ScalableRWLock& GetLock() noexcept { return m_data.GetLock(); }
 
 		/**
-		 * @brief Erase bunch of events by their timestamps and decrease stored events size.
+		 * @attention Is assumed to be used under events locking.
 		 *
-		 * @attention Write locks the structure. Change limit usage only on number of successfully erased events.
+		 * @return Oldest contained event node, next ones are reachable by owner next pointer, nullptr if empty.
 		 *
-		 * @tparam Container Forward container with Timer types.
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE [[nodiscard]] const EventNode* GetHead() const noexcept { return m_head; }
+
+		/**
+		 * @attention Is assumed to be used under events locking.
 		 *
-		 * @param timestamps Container with event timestamps to be erased.
+		 * @return Number of contained events.
 		 *
 		 * @todo Add unit test.
 		 */
-		template <template <typename> typename Container>
-		FORCE_INLINE void EraseEventsByTimestamps(const Container<Timer>& timestamps)
-		{
-			int32_t erased{};
-			const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ m_eventsLock };
-			for (const auto timestamp : timestamps) {
-				if (m_events.erase(timestamp) == 0) [[unlikely]] {
-					LOG_WARNING_NEW("Events with timestamp {} is not erased, connection {}", timestamp.ToString(),
-						m_data.GetConnection());
-					continue;
-				}
-
-				LOG_PROTOCOL_NEW(
-					"Event is removed, timestamp {} connection {}", timestamp.ToString(), m_data.GetConnection());
-				++erased;
-			}
-
-			m_data.DecreaseEventsSize(erased);
-		}
+		FORCE_INLINE [[nodiscard]] size_t GetSize() const noexcept { return m_size; }
 
 		/**
-		 * @return Read-write structure lock.
+		 * @return Events data of the related connection.
 		 *
-		 * @todo Add unit test.
+		 * @test Has unit test.
 		 */
-		FORCE_INLINE [[nodiscard]] Pthread::AtomicRWLock& GetLock() noexcept { return m_eventsLock; }
+		FORCE_INLINE [[nodiscard]] EventsData& GetData() noexcept { return m_data; }
 
 		/**
-		 * @attention Is assumed to be used under structure locking.
-		 *
-		 * @return Readable reference to stored events.
+		 * @return Filter of the events.
 		 *
-		 * @todo Add unit test.
+		 * @test Has unit test.
 		 */
-		FORCE_INLINE [[nodiscard]] const std::map<Timer, std::shared_ptr<EventType>>& Get() const noexcept
-		{
-			return m_events;
-		}
+		FORCE_INLINE [[nodiscard]] const filter_t& GetFilter() const noexcept { return m_filter; }
+
+		// Access to nodes list
+		friend EventsData;
 	};
 
 	/**
 	 * @brief Collection of events by their filter under same connection, controls events limit Default events size
-	 * limit is 1024 and purging coefficient is 30%.
+	 * limit is 1024 and purging coefficient is 30%. Holds pending batch of data entries when batching is enabled.
+	 *
+	 * Events of all filters are linked into one queue in order of adding, so purging removes the oldest events one by
+	 * one from the queue head. Nodes are taken from pools of continuous allocator and returned there on erasing, so
+	 * nodes of finished connections are reused by other connections.
 	 */
-	class EventsData {
+	class EventsData : public std::enable_shared_from_this<EventsData> {
+	public:
+		static constexpr std::string_view BATCH_PREFIX{ "{\"batch\":[" };
+		static constexpr std::string_view BATCH_SUFFIX{ "]}" };
+
 	private:
 		std::map<filter_t, std::shared_ptr<Events>> m_filterToEvents;
-		Pthread::AtomicRWLock m_filterToEventsLock;
+		Pthread::ScalableRWLock m_filterToEventsLock{ "Events::filterToEvents" };
+		Pthread::ScalableRWLock m_eventsLock{ "Events::events" };
+		EventNode* m_head{ nullptr };
+		EventNode* m_tail{ nullptr };
 		std::atomic<int32_t> m_limit{ 1024 };
 		std::atomic<float> m_purgingCoefficient{ 0.3f };
 		std::atomic<int32_t> m_eventsSize{};
+		std::atomic<Encoding> m_encoding{ Encoding::Json };
+		Distributor& m_distributor;
 		const int32_t m_connection;
+		std::string m_batch;
+		size_t m_batchEntries{};
+		Encoding m_batchEncoding{ Encoding::Json };
+		Pthread::AtomicLock m_batchLock{ "Events::batch" };
+		// Guarded by events lock, closed data is not in distributor anymore and must not be indexed again
+		bool m_closed{ false };
 
 	public:
 		/**
 		 * @brief Construct new events data object.
 		 *
+		 * @param distributor Owning distributor.
 		 * @param connection Related connection.
 		 *
 		 * @todo Add unit test.
 		 */
-		FORCE_INLINE EventsData(const int32_t connection) noexcept
-			: m_connection{ connection }
+		FORCE_INLINE EventsData(Distributor& distributor, const int32_t connection) noexcept
+			: m_distributor{ distributor }
+			, m_connection{ connection }
+		{
+		}
+
+		/**
+		 * @brief Destroy events data object, destroy stored events and return their nodes to the pool.
+		 */
+		FORCE_INLINE ~EventsData() noexcept
 		{
+			for (EventNode* node{ m_head }; node != nullptr;) {
+				EventNode* const next{ node->next };
+				DeallocateNode(node);
+				node = next;
+			}
 		}
 
 		EventsData(const EventsData& other) = delete;
@@ -697,6 +735,69 @@ public:
 		 */
 		FORCE_INLINE [[nodiscard]] int32_t GetConnection() const noexcept { return m_connection; }
 
+		/**
+		 * @return Owning distributor.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE [[nodiscard]] Distributor& GetDistributor() noexcept { return m_distributor; }
+
+		/**
+		 * @return Negotiated encoding of data sent to the connection.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE [[nodiscard]] Encoding GetEncoding() const noexcept
+		{
+			return m_encoding.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Set encoding of data sent to the connection.
+		 *
+		 * @param encoding Json or binary encoding.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE void SetEncoding(const Encoding encoding) noexcept
+		{
+			if (m_encoding.exchange(encoding, std::memory_order_relaxed) != encoding) {
+				LOG_PROTOCOL_NEW(
+					"Events encoding is changed to {}, connection {}", EnumToString(encoding), m_connection);
+			}
+		}
+
+		/**
+		 * @return Read-write lock of stored events of all filters.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE [[nodiscard]] Pthread::ScalableRWLock& GetLock() noexcept { return m_eventsLock; }
+
+		/**
+		 * @brief Mark events data as closed, new events are not added after that. Is called after removing from
+		 * distributor and before unregistering from filter index, so adding which has already taken the events data
+		 * either completes before and is unregistered, or is rejected.
+		 *
+		 * @attention Write locks events.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE void Close()
+		{
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ m_eventsLock };
+			m_closed = true;
+		}
+
+		/**
+		 * @attention Is assumed to be used under events locking.
+		 *
+		 * @return True if events data is closed, false otherwise.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE [[nodiscard]] bool IsClosed() const noexcept { return m_closed; }
+
 		/**
 		 * @todo Add static asserts in future test.
 		 */
@@ -719,7 +820,7 @@ public:
 		FORCE_INLINE [[nodiscard]] std::shared_ptr<Events> GetEvents(const filter_t& filter) noexcept
 		{
 			{
-				const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ m_filterToEventsLock };
+				const Pthread::ScalableRWLock::ExitGuard<Pthread::read> _{ m_filterToEventsLock };
 				auto it{ m_filterToEvents.find(filter) };
 				if (it != m_filterToEvents.end()) {
 					return it->second;
@@ -727,8 +828,8 @@ public:
 			}
 
 			if constexpr (!Lookup) {
-				const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ m_filterToEventsLock };
-				return m_filterToEvents.emplace(filter, std::make_shared<Events>(*this)).first->second;
+				const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ m_filterToEventsLock };
+				return m_filterToEvents.emplace(filter, std::make_shared<Events>(*this, filter)).first->second;
 			}
 			else {
 				return {};
@@ -738,7 +839,7 @@ public:
 		/**
 		 * @brief Fail events by filter.
 		 *
-		 * @attention Read lock structure to find events and write locks events structure to perform the action.
+		 * @attention Read lock structure to find events and write locks events to perform the action.
 		 *
 		 * @param filter Events related filter.
 		 * @param error Description of the failure.
@@ -747,71 +848,46 @@ public:
 		 */
 		FORCE_INLINE void FailEventsByFilter(const filter_t& filter, const std::string_view error)
 		{
-			std::shared_ptr<Events> events;
-			{
-				const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ m_filterToEventsLock };
-				auto it{ m_filterToEvents.find(filter) };
-				if (it == m_filterToEvents.end()) {
-					return;
-				}
-				events = it->second;
+			if (const auto events{ GetEvents<lookup>(filter) }; events != nullptr) {
+				events->FailEvents(error);
 			}
-
-			events->FailEvents(error);
 		}
 
 		/**
 		 * @brief Erase events by filter.
 		 *
-		 * @attention Read lock structure to find events and write locks events structure to perform the action.
+		 * @attention Read lock structure to find events and write locks events to perform the action.
 		 *
 		 * @param filter Events related filter.
 		 *
-		 * @todo Add unit test.
+		 * @test Has unit test.
 		 */
 		FORCE_INLINE void EraseEventsByFilter(const filter_t& filter)
 		{
-			std::shared_ptr<Events> events;
-			{
-				const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ m_filterToEventsLock };
-				auto it{ m_filterToEvents.find(filter) };
-				if (it == m_filterToEvents.end()) {
-					return;
-				}
-				events = it->second;
+			if (const auto events{ GetEvents<lookup>(filter) }; events != nullptr) {
+				events->EraseEvents();
 			}
-
-			events->EraseEvents();
 		}
 
 		/**
-		 * @brief Erase event by its uid. Expensive operation as requires O(n) searching.
+		 * @brief Erase event by its uid. Requires O(n) searching through the queue of the connection.
 		 *
-		 * @attention Read locks structure. Read locks events structures one by one during searching and write lock
-		 * during erasing.
+		 * @attention Write locks events.
 		 *
 		 * @param uid Event uid to be erased.
 		 *
-		 * @todo Add unit test.
+		 * @return True if event is found and erased, false otherwise.
+		 *
+		 * @test Has unit test.
 		 */
-		FORCE_INLINE [[nodiscard]] bool EraseEvent(const uint64_t uid) noexcept
+		FORCE_INLINE [[nodiscard]] bool EraseEvent(const uint64_t uid)
 		{
-			Timer targetTimestamp{ 0 };
-			const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ m_filterToEventsLock };
-			for (auto& [filter, events] : m_filterToEvents) {
-				{
-					const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ events->GetLock() };
-					const auto& items{ events->Get() };
-					for (const auto& [timestamp, event] : items) {
-						if (event->GetUid() == uid) {
-							targetTimestamp = timestamp;
-							break;
-						}
-					}
-				}
-
-				if (!targetTimestamp.Empty()) {
-					events->EraseEvent(targetTimestamp);
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ m_eventsLock };
+			for (EventNode* node{ m_head }; node != nullptr; node = node->next) {
+				if (node->event->GetUid() == uid) {
+					LOG_PROTOCOL_NEW("Event is removed, timestamp {} connection {}", node->timestamp.ToString(),
+						m_connection);
+					Pop(node);
 					return true;
 				}
 			}
@@ -820,9 +896,9 @@ public:
 		}
 
 		/**
-		 * @brief Fail all stored events with error message and decrease stored events size.
+		 * @brief Fail all stored events with error message and erase events of all filters.
 		 *
-		 * @attention Write locks structure and events structures one by one during failing.
+		 * @attention Write locks structure and events.
 		 *
 		 * @param error Description of the failure.
 		 *
@@ -831,48 +907,30 @@ public:
 		 */
 		FORCE_INLINE void FailActiveEvents(const std::string_view error)
 		{
-			const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ m_filterToEventsLock };
-			auto eventsBegin{ m_filterToEvents.begin() };
-			auto eventsEnd{ m_filterToEvents.end() };
-
-			for (; eventsBegin != eventsEnd;) {
-				const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ eventsBegin->second->GetLock() };
-				const auto& events{ eventsBegin->second->Get() };
-				for (const auto& [timestamp, event] : events) {
-					SendFailed(event->GetUid(), event->GetConnection(), error);
+			FlushBatch();
+			{
+				const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ m_eventsLock };
+				while (m_head != nullptr) {
+					SendFailed(m_head->event->GetUid(), m_head->event->GetConnection(), error);
+					Pop(m_head);
 				}
-
-				DecreaseEventsSize(static_cast<int32_t>(events.size()));
-				eventsBegin = m_filterToEvents.erase(eventsBegin);
 			}
-		}
 
-		/**
-		 * @brief Decrease events size.
-		 *
-		 * @param value Value to subtract.
-		 *
-		 * @todo Add unit test.
-		 */
-		FORCE_INLINE void DecreaseEventsSize(const int32_t value) noexcept { m_eventsSize.fetch_sub(value); }
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ m_filterToEventsLock };
+			m_filterToEvents.clear();
+		}
 
 		/**
-		 * @brief Increase events size.
+		 * @return Number of stored events.
 		 *
-		 * @param value Value to add.
-		 *
-		 * @todo Add unit test.
+		 * @test Has unit test.
 		 */
-		FORCE_INLINE void IncreaseEventsSize(const int32_t value)
-		{
-			m_eventsSize.fetch_add(value);
-			CheckLimitAndPurge();
-		}
+		FORCE_INLINE [[nodiscard]] int32_t GetEventsSize() const noexcept { return m_eventsSize.load(); }
 
 		/**
 		 * @return Events size limit.
 		 *
-		 * @todo Add unit test.
+		 * @test Has unit test.
 		 */
 		FORCE_INLINE [[nodiscard]] int32_t GetLimit() const noexcept { return m_limit.load(); }
 
@@ -883,7 +941,7 @@ public:
 		 *
 		 * @return True if limit is updated, false otherwise.
 		 *
-		 * @todo Add unit test.
+		 * @test Has unit test.
 		 */
 		FORCE_INLINE [[nodiscard]] bool SetLimit(const int32_t value)
 		{
@@ -902,6 +960,7 @@ public:
 			LOG_PROTOCOL_NEW("Events purging limit is changed from {} to {}, connection {}", old, value, m_connection);
 			m_limit.store(value);
 			if (ratio > 0) {
+				const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ m_eventsLock };
 				CheckLimitAndPurge();
 			}
 			return true;
@@ -910,7 +969,7 @@ public:
 		/**
 		 * @return Events purging coefficient.
 		 *
-		 * @todo Add unit test.
+		 * @test Has unit test.
 		 */
 		FORCE_INLINE [[nodiscard]] float GetPurgingCoefficient() const noexcept { return m_purgingCoefficient.load(); }
 
@@ -921,7 +980,7 @@ public:
 		 *
 		 * @return True if coefficient is updated, false otherwise.
 		 *
-		 * @todo Add unit test.
+		 * @test Has unit test.
 		 */
 		FORCE_INLINE [[nodiscard]] bool SetPurgingCoefficient(const float value)
 		{
@@ -950,12 +1009,178 @@ public:
 		}
 
 		/**
-		 * @brief Check if limit is exceeded and perform purging.
+		 * @brief Append data entry to pending batch, batch is sent at once when its size reaches the limit. Pending
+		 * batch of other encoding is sent before.
 		 *
-		 * @attention Read locks structure and events structures on events sorting and write locks structure and events
-		 * structures on erasing.
+		 * @attention Locks batch.
 		 *
-		 * @todo Add unit test.
+		 * @param entry Json object of data entry in format {"uids":[...],"data":...} or {"uids":[...],"patch":[...]},
+		 * or binary data frame.
+		 * @param encoding Encoding of the entry.
+		 * @param maxBytes Limit of batch frame size in bytes.
+		 *
+		 * @return True if entry opens new batch which is left pending, false otherwise.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE [[nodiscard]] bool AddToBatch(
+			const std::string_view entry, const Encoding encoding, const size_t maxBytes)
+		{
+			const Pthread::AtomicLock::ExitGuard _{ m_batchLock };
+			if (m_batchEntries != 0 && m_batchEncoding != encoding) [[unlikely]] {
+				FlushBatchLocked();
+			}
+
+			const bool isOpened{ m_batchEntries == 0 };
+			if (isOpened) {
+				m_batchEncoding = encoding;
+				if (encoding == Encoding::Binary) {
+					m_batch.assign(Binary::FRAME_HEADER_SIZE, '\0');
+					m_batch[0] = static_cast<char>(Binary::Frame::Batch);
+				}
+				else {
+					m_batch.assign(BATCH_PREFIX);
+				}
+			}
+			else if (encoding != Encoding::Binary) {
+				m_batch += ',';
+			}
+
+			m_batch += entry;
+			++m_batchEntries;
+			if (m_batch.size() + BATCH_SUFFIX.size() >= maxBytes) {
+				FlushBatchLocked();
+				return false;
+			}
+
+			return isOpened;
+		}
+
+		/**
+		 * @brief Send pending batch if it is not empty. Batch with single entry is sent as plain data entry.
+		 *
+		 * @attention Locks batch.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE void FlushBatch()
+		{
+			const Pthread::AtomicLock::ExitGuard _{ m_batchLock };
+			FlushBatchLocked();
+		}
+
+	private:
+		/**
+		 * @brief Take node from the pool.
+		 *
+		 * @return Free node without event.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE [[nodiscard]] static EventNode* AllocateNode()
+		{
+			return new (ContinuousAllocator<EventNode>{}.allocate(1)) EventNode{};
+		}
+
+		/**
+		 * @brief Destroy event of node and return node to the pool.
+		 *
+		 * @param node Node taken by AllocateNode().
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE static void DeallocateNode(EventNode* const node) noexcept
+		{
+			std::destroy_at(node);
+			ContinuousAllocator<EventNode>{}.deallocate(node, 1);
+		}
+
+		/**
+		 * @brief Link new event to the end of connection queue and to the end of owner events, register owner in filter
+		 * index if it was empty. Check limit and purge the oldest events if it is exceeded. Event is dropped if events
+		 * data is closed.
+		 *
+		 * @attention Is assumed to be used under events write locking.
+		 *
+		 * @param owner Events under the filter of new event.
+		 * @param event Event to be added.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE void Push(Events& owner, EventType&& event)
+		{
+			if (m_closed) [[unlikely]] {
+				LOG_PROTOCOL_NEW("Event uid {} is not added to closed events data, connection {}", event.GetUid(),
+					m_connection);
+				return;
+			}
+
+			EventNode* node{ AllocateNode() };
+			node->event.emplace(std::move(event));
+			node->timestamp = Timer{};
+			node->owner = &owner;
+			node->previous = m_tail;
+			node->next = nullptr;
+			node->ownerPrevious = owner.m_tail;
+			node->ownerNext = nullptr;
+
+			if (m_tail == nullptr) {
+				m_head = node;
+			}
+			else {
+				m_tail->next = node;
+			}
+			m_tail = node;
+
+			if (owner.m_tail == nullptr) {
+				owner.m_head = node;
+				m_distributor.IndexEvents({ this->shared_from_this(), owner.shared_from_this() });
+			}
+			else {
+				owner.m_tail->ownerNext = node;
+			}
+			owner.m_tail = node;
+			++owner.m_size;
+
+			LOG_PROTOCOL_NEW("Event uid {} is added at {}, connection {}", node->event->GetUid(),
+				node->timestamp.ToString(), m_connection);
+			m_eventsSize.fetch_add(1);
+			CheckLimitAndPurge();
+		}
+
+		/**
+		 * @brief Unlink event from connection queue and from owner events, unregister owner from filter index if it
+		 * becomes empty. Destroy event and return node to the pool.
+		 *
+		 * @attention Is assumed to be used under events write locking.
+		 *
+		 * @param node Node of stored event.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE void Pop(EventNode* const node)
+		{
+			(node->previous == nullptr ? m_head : node->previous->next) = node->next;
+			(node->next == nullptr ? m_tail : node->next->previous) = node->previous;
+
+			Events& owner{ *node->owner };
+			(node->ownerPrevious == nullptr ? owner.m_head : node->ownerPrevious->ownerNext) = node->ownerNext;
+			(node->ownerNext == nullptr ? owner.m_tail : node->ownerNext->ownerPrevious) = node->ownerPrevious;
+			if (--owner.m_size == 0) {
+				m_distributor.UnindexEvents(owner);
+			}
+
+			DeallocateNode(node);
+			m_eventsSize.fetch_sub(1);
+		}
+
+		/**
+		 * @brief Check if limit is exceeded and purge the oldest events from the head of connection queue. Purging
+		 * costs O(k) of purged events.
+		 *
+		 * @attention Is assumed to be used under events write locking.
+		 *
+		 * @test Has unit test.
 		 */
 		FORCE_INLINE void CheckLimitAndPurge()
 		{
@@ -965,56 +1190,95 @@ public:
 				return;
 			}
 
-			// Due to the difficulty of data structures and parallelism efficiency access algorithms it make sense to
-			// purge bunch of events at once
+			// Purging bunch of events at once keeps the limit checking away from every next adding
 			const auto purgingCoefficient{ m_purgingCoefficient.load() };
 			toBePurged += static_cast<int32_t>(static_cast<float>(limit) * purgingCoefficient);
 
-			std::map<Timer, std::shared_ptr<Events>> sortedEvents;
-			{
-				const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ m_filterToEventsLock };
-				for (auto& [filter, events] : m_filterToEvents) {
-					const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ events->GetLock() };
-					for (auto& [timestamp, event] : events->Get()) {
-						sortedEvents.emplace(timestamp, events);
-					}
-				}
+			LOG_PROTOCOL_NEW("Events limit {} is exceeded and {} events are going to be purged, connection {}", limit,
+				toBePurged, m_connection);
+			for (; toBePurged > 0 && m_head != nullptr; --toBePurged) {
+				Pop(m_head);
 			}
+		}
 
-			if (const auto size{ sortedEvents.size() }; size < static_cast<size_t>(toBePurged)) [[unlikely]] {
-				LOG_WARNING_NEW("Unexpectedly size of sorted events {} is less that should be purged {}, purging "
-								"coefficient {:.9f}, connection {}. Purging all.",
-					size, toBePurged, purgingCoefficient, m_connection);
-				FailActiveEvents("All events are purged due to unexpected processing");
+		/**
+		 * @brief Send pending batch if it is not empty.
+		 *
+		 * @attention Is assumed to be used under batch locking.
+		 *
+		 * @test Has unit test.
+		 */
+		FORCE_INLINE void FlushBatchLocked()
+		{
+			if (m_batchEntries == 0) {
 				return;
 			}
 
-			LOG_PROTOCOL_NEW("Events limit {} is exceeded and {} events are going to be purged, connection {}", limit,
-				toBePurged, m_connection);
-			std::map<std::shared_ptr<Events>, std::vector<Timer>> sortedTimestamps;
-			for (auto begin{ sortedEvents.begin() }, end{ sortedEvents.end() }; toBePurged > 0;) {
-				sortedTimestamps[begin->second].emplace_back(begin->first);
-				++begin;
-				--toBePurged;
+			const bool binary{ m_batchEncoding == Encoding::Binary };
+			std::string_view frame{ m_batch };
+			if (m_batchEntries == 1) {
+				frame.remove_prefix(binary ? Binary::FRAME_HEADER_SIZE : BATCH_PREFIX.size());
 			}
-
-			const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ m_filterToEventsLock };
-			for (auto& [events, timestamps] : sortedTimestamps) {
-				events->EraseEventsByTimestamps(timestamps);
+			else if (binary) {
+				const auto count{ static_cast<uint32_t>(m_batchEntries) };
+				std::memcpy(m_batch.data() + 1, &count, sizeof(count));
+			}
+			else {
+				m_batch += BATCH_SUFFIX;
+				frame = m_batch;
 			}
+
+			LOG_PROTOCOL_NEW(
+				"Send batch of {} data entries, size {}, connection {}", m_batchEntries, frame.size(), m_connection);
+			Send(m_connection,
+				{ std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(frame.data()), frame.size()),
+					binary ? Data::Opcode::Binary : Data::Opcode::Text });
+			m_batch.clear();
+			m_batchEntries = 0;
 		}
+
+		// Access to Push and Pop
+		friend Events;
 	};
 
 private:
+	/**
+	 * @brief Last sent document by filter for patch sending and events which have received it. Uids are unique per
+	 * connection only, so events are identified by connection and uid.
+	 */
+	struct PatchState {
+		Json document;
+		bool hasDocument{ false };
+		std::set<std::pair<int32_t, uint64_t>> synchronized;
+		// Ticket of the next built patch, changed under lock
+		uint64_t issued{};
+		// Ticket of patch which is allowed to be sent, patches are sent outside of lock in order of building
+		std::atomic<uint64_t> served{};
+		Pthread::AtomicLock lock{ "Events::patchState" };
+	};
+
 	Module& m_authorization;
-	std::map<uint64_t, std::shared_ptr<typename EventType::base_t::handlerData_t>> m_hashToHandlerData;
-	Pthread::AtomicRWLock m_hashToHandlerDataLock;
-	std::map<int32_t, std::shared_ptr<EventsData>> m_connectionToEventsData;
-	Pthread::AtomicRWLock m_connectionToEventsDataLock;
+	// Read on every incoming request and changed on handler registration only
+	Rcu::Cell<std::map<uint64_t, std::shared_ptr<typename EventType::base_t::handlerData_t>>> m_hashToHandlerData;
+	// Read on every request and send, changed on connection appearance and disappearance only
+	Rcu::Cell<std::map<int32_t, std::shared_ptr<EventsData>>> m_connectionToEventsData;
+	// Copy-on-write snapshot, readers never lock and writers publish new version under lock
+	std::atomic<std::shared_ptr<const index_t>> m_filterToEventsIndex{ std::make_shared<const index_t>() };
+	Pthread::AtomicLock m_filterToEventsIndexLock{ "Events::filterToEventsIndex" };
+	std::atomic<bool> m_batching{ false };
+	std::atomic<uint32_t> m_batchWindowUs{};
+	std::atomic<size_t> m_batchMaxBytes{};
+	pthread_t m_batchFlusher{};
+	// Flusher is parked while there are no opened batches, so idle distributor does not wake up every window
+	bool m_batchPending{ false };
+	std::mutex m_batchMutex;
+	std::condition_variable m_batchCondition;
+	std::map<filter_t, std::shared_ptr<PatchState>> m_filterToPatchState;
+	Pthread::ScalableRWLock m_filterToPatchStateLock{ "Events::filterToPatchState" };
 
 public:
 	/**
-	 * @brief Construct new distributor object.
+	 * @brief Construct new distributor object, batching is disabled by default.
 	 *
 	 * @param authorization Authorization module to access checking.
 	 *
@@ -1025,14 +1289,22 @@ public:
 	{
 	}
 
+	/**
+	 * @brief Destroy distributor object, stop batching and send pending batches.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE ~Distributor() { StopBatching(); }
+
 	Distributor(const Distributor& other) = delete;
 	Distributor(Distributor&& other) = delete;
 	Distributor& operator=(const Distributor& other) = delete;
 	Distributor& operator=(Distributor&& other) = delete;
 
 	/**
-	 * @brief Collect newly received event, check if it an interruption, look for specific handler and verify access
-	 * right to the data and call handler on success. Erase on interruption.
+	 * @brief Collect newly received event, apply requested encoding of the connection, check if it an interruption,
+	 * look for specific handler and verify access right to the data and call handler on success. Erase on
+	 * interruption.
 	 *
 	 * @param uid Event uid.
 	 * @param hash Event type hash.
@@ -1043,6 +1315,16 @@ public:
 	 */
 	FORCE_INLINE void Collect(const uint64_t uid, const uint64_t hash, const int32_t connection, Json&& json)
 	{
+		if (const auto* encoding{ json.GetValueType<uint64_t>("encoding") }; encoding != nullptr) {
+			if (*encoding == static_cast<uint64_t>(Encoding::Json)
+				|| *encoding == static_cast<uint64_t>(Encoding::Binary)) {
+				GetEventsData(connection)->SetEncoding(static_cast<Encoding>(*encoding));
+			}
+			else {
+				LOG_WARNING_NEW_LIMITED("Unknown events encoding {}, connection {}", *encoding, connection);
+			}
+		}
+
 		if (json.GetValueType<bool>("interrupt") != nullptr) {
 			std::shared_ptr<EventsData> eventsData{ GetEventsData(connection) };
 			if (eventsData->EraseEvent(uid)) {
@@ -1056,9 +1338,9 @@ public:
 
 		std::shared_ptr<typename EventType::base_t::handlerData_t> handlerData;
 		{
-			const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ m_hashToHandlerDataLock };
-			const auto it{ m_hashToHandlerData.find(hash) };
-			if (it == m_hashToHandlerData.end()) {
+			const typename decltype(m_hashToHandlerData)::ReadGuard hashToHandlerData{ m_hashToHandlerData };
+			const auto it{ hashToHandlerData->find(hash) };
+			if (it == hashToHandlerData->end()) {
 				SendFailed(uid, connection, "Unknown hash of the event");
 				return;
 			}
@@ -1086,7 +1368,7 @@ public:
 	/**
 	 * @brief Set handler with permission requirements to specific event type hash.
 	 *
-	 * @attention Write locks handler data structure.
+	 * @attention Locks handler data writers and waits for readers of previous version.
 	 *
 	 * @tparam Handler Type of the event handler function.
 	 *
@@ -1105,16 +1387,16 @@ public:
 			std::is_integral_v<int16_t> && std::is_integral_v<std::underlying_type_t<typename Module::grade_t>>,
 			"Grade type category is expected");
 
-		const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ m_hashToHandlerDataLock };
-		m_hashToHandlerData.emplace(hash,
-			std::make_shared<typename EventType::base_t::handlerData_t>(
-				std::move(handler), static_cast<int16_t>(grade)));
+		auto handlerData{ std::make_shared<typename EventType::base_t::handlerData_t>(
+			std::move(handler), static_cast<int16_t>(grade)) };
+		(void)m_hashToHandlerData.Update(
+			[hash, &handlerData](auto& hashToHandlerData) { hashToHandlerData.emplace(hash, std::move(handlerData)); });
 	}
 
 	/**
 	 * @brief Set handler without permission requirements to specific event type hash.
 	 *
-	 * @attention Write locks handler data structure.
+	 * @attention Locks handler data writers and waits for readers of previous version.
 	 *
 	 * @tparam Handler Type of the event handler function.
 	 *
@@ -1127,15 +1409,16 @@ public:
 		requires std::is_convertible_v<Handler, typename EventType::base_t::handler_t>
 	FORCE_INLINE void SetHandlerWithoutPermissions(const uint64_t hash, Handler&& handler)
 	{
-		const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ m_hashToHandlerDataLock };
-		m_hashToHandlerData.emplace(
-			hash, std::make_shared<typename EventType::base_t::handlerData_t>(std::move(handler)));
+		auto handlerData{ std::make_shared<typename EventType::base_t::handlerData_t>(std::move(handler)) };
+		(void)m_hashToHandlerData.Update(
+			[hash, &handlerData](auto& hashToHandlerData) { hashToHandlerData.emplace(hash, std::move(handlerData)); });
 	}
 
 	/**
-	 * @brief Fail all stored events with error message.
+	 * @brief Fail all stored events with error message. Removed events data are closed.
 	 *
-	 * @attention Write locks structure, data events structures and events structures one by one during failing.
+	 * @attention Locks structure writers and waits for its readers, locks data events structures and events structures
+	 * one by one during failing.
 	 *
 	 * @param error Description of the failure.
 	 *
@@ -1143,79 +1426,221 @@ public:
 	 */
 	FORCE_INLINE void FailActiveEvents(const std::string_view error)
 	{
-		const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ m_connectionToEventsDataLock };
-		auto eventsDataBegin{ m_connectionToEventsData.begin() };
-		auto eventsDataEnd{ m_connectionToEventsData.end() };
-
-		for (; eventsDataBegin != eventsDataEnd;) {
-			eventsDataBegin->second->FailActiveEvents(error);
-			eventsDataBegin = m_connectionToEventsData.erase(eventsDataBegin);
+		for (const auto& [connection, eventsData] : m_connectionToEventsData.Replace({})) {
+			eventsData->Close();
+			eventsData->FailActiveEvents(error);
 		}
 	}
 
 	/**
-	 * @brief Clear all stored events for specific connection.
+	 * @brief Clear all stored events for specific connection. Removed events data is closed and unregistered from
+	 * filter index.
 	 *
-	 * @attention Write locks structure.
+	 * @attention Locks structure writers and waits for its readers, write locks events and locks index writers.
 	 *
 	 * @param connection Related connection.
 	 *
-	 * @todo Add unit test.
+	 * @test Has unit test.
 	 */
 	FORCE_INLINE void ClearActiveEventsForConnection(const int32_t connection)
 	{
-		const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ m_connectionToEventsDataLock };
-		m_connectionToEventsData.erase(connection);
+		std::shared_ptr<EventsData> eventsData;
+		(void)m_connectionToEventsData.Update([connection, &eventsData](auto& connectionToEventsData) {
+			const auto it{ connectionToEventsData.find(connection) };
+			if (it == connectionToEventsData.end()) {
+				return false;
+			}
+
+			eventsData = std::move(it->second);
+			connectionToEventsData.erase(it);
+			return true;
+		});
+
+		if (eventsData != nullptr) {
+			// Closing under events lock orders it with adding, which could take events data before removing
+			eventsData->Close();
+			UnindexEventsData(*eventsData);
+		}
 	}
 
 	/**
-	 * @brief Send data to bunch of events by filter for each connection.
-	 *
-	 * @tparam T Type of data, string view or callable to fill provided string.
+	 * @brief Start batching of data sent by SendData and SendPatch. Data entries for the same connection are merged
+	 * into one frame {"batch":[{"uids":[...],"data":...},{"uids":[...],"patch":[...]},...]} which is sent when batch
+	 * size reaches the limit or by flusher pthread at the end of window started by the first entry of the batch.
+	 * Flusher sleeps while there are no pending batches.
 	 *
-	 * @param filter Related hash filter to events.
-	 * @param getData Data to be sent or lazy invoked function, should fill string argument with valid json key on true
-	 * return and fill with error description otherwise.
+	 * @param windowUs Batching window in microseconds, cannot be 0.
+	 * @param maxBytes Limit of batch frame size in bytes, cannot be less than 1024.
 	 *
-	 * @return Send result enum.
+	 * @return True if batching is started, false otherwise.
 	 *
-	 * @todo Add unit test.
+	 * @test Has unit test.
 	 */
-	template <typename T>
-		requires(std::is_same_v<std::string_view, T> || std::is_convertible_v<T, std::function<bool(std::string&)>>)
-	FORCE_INLINE [[nodiscard]] SendResult SendData(const filter_t& filter, const T getData)
+	FORCE_INLINE [[nodiscard]] bool StartBatching(const uint32_t windowUs, const size_t maxBytes)
 	{
-		std::vector<std::shared_ptr<Events>> eventsArray{ GetEventsArray(filter) };
-		if (eventsArray.empty()) {
-			return SendResult::Nothing;
+		if (windowUs == 0) [[unlikely]] {
+			LOG_WARNING("Events batching window cannot be 0");
+			return false;
+		}
+
+		if (maxBytes < 1024) [[unlikely]] {
+			LOG_WARNING_NEW("Events batch size limit cannot be less than 1024, provided {}", maxBytes);
+			return false;
+		}
+
+		// Only one of concurrent calls starts flusher, otherwise handle of the first one would be overwritten
+		if (bool expected{ false }; !m_batching.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+			LOG_WARNING("Events batching is already started");
+			return false;
+		}
+
+		m_batchWindowUs.store(windowUs, std::memory_order_relaxed);
+		m_batchMaxBytes.store(maxBytes, std::memory_order_relaxed);
+
+		if (const auto result{ pthread_create(&m_batchFlusher, nullptr, BatchFlusherRunner, static_cast<void*>(this)) };
+			result != 0) [[unlikely]] {
+
+			LOG_ERROR_NEW("Pthread for events batch flusher is not created. Error №{}: {}", result,
+				std::strerror(result));
+			m_batching.store(false, std::memory_order_release);
+			return false;
+		}
+
+		LOG_PROTOCOL_NEW("Events batching is started, window {} us, size limit {}", windowUs, maxBytes);
+		return true;
+	}
+
+	/**
+	 * @brief Stop batching, wake up and join flusher pthread and send pending batches.
+	 *
+	 * @attention Enters read section of structure.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void StopBatching()
+	{
+		if (!m_batching.exchange(false, std::memory_order_acq_rel)) {
+			return;
+		}
+
+		{
+			// Flusher checks the flag under mutex, so notification cannot be lost between its check and waiting
+			const std::lock_guard<std::mutex> _{ m_batchMutex };
+		}
+		m_batchCondition.notify_one();
+
+		if (const auto result{ pthread_join(m_batchFlusher, nullptr) }; result != 0) [[unlikely]] {
+			LOG_ERROR_NEW(
+				"Pthread for events batch flusher is not joined. Error №{}: {}", result, std::strerror(result));
+		}
+
+		FlushBatches();
+		LOG_PROTOCOL("Events batching is stopped");
+	}
+
+	/**
+	 * @return True if batching is started, false otherwise.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] bool IsBatching() const noexcept { return m_batching.load(std::memory_order_acquire); }
+
+	/**
+	 * @brief Send pending batches of all connections.
+	 *
+	 * @attention Enters read section of structure and locks batches one by one.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void FlushBatches()
+	{
+		std::vector<std::shared_ptr<EventsData>> eventsDatas;
+		{
+			const typename decltype(m_connectionToEventsData)::ReadGuard connectionToEventsData{
+				m_connectionToEventsData
+			};
+			eventsDatas.reserve(connectionToEventsData->size());
+			for (const auto& [connection, eventsData] : *connectionToEventsData) {
+				eventsDatas.emplace_back(eventsData);
+			}
+		}
+
+		// Sending is out of read section, so writers do not wait for sockets
+		for (const auto& eventsData : eventsDatas) {
+			eventsData->FlushBatch();
+		}
+	}
+
+	/**
+	 * @brief Send data to bunch of events by filter for each connection. Json data is parsed once to be encoded for
+	 * binary destinations, producer writes value directly into payloads of both encodings and is preferred for
+	 * frequently sent data.
+	 *
+	 * @tparam T Type of data, string view, callable to fill provided string or binary producer.
+	 *
+	 * @param filter Related hash filter to events.
+	 * @param getData Data to be sent or lazy invoked function, should fill string argument with valid json key on true
+	 * return and fill with error description otherwise, or producer which is invoked once per required encoding.
+	 *
+	 * @return Send result enum.
+	 *
+	 * @test Has unit test.
+	 */
+	template <typename T>
+		requires(Binary::Producer<T> || std::is_same_v<std::string_view, T>
+			|| std::is_convertible_v<T, std::function<bool(std::string&)>>)
+	FORCE_INLINE [[nodiscard]] SendResult SendData(const filter_t& filter, const T getData)
+	{
+		const std::shared_ptr<const holders_t> eventsArray{ GetEventsArray(filter) };
+		if (eventsArray == nullptr) {
+			return SendResult::Nothing;
 		}
 
 		// Trade of from locking while sending to once locking but string allocating
 		struct Destination {
 			const int32_t connection;
+			EventsData& data;
+			const Encoding encoding;
 			std::string uids;
+			std::vector<uint64_t> uidValues;
 
-			FORCE_INLINE Destination(const int32_t connection) noexcept
+			FORCE_INLINE Destination(const int32_t connection, EventsData& data) noexcept
 				: connection{ connection }
+				, data{ data }
+				, encoding{ data.GetEncoding() }
 			{
 			}
 		};
 
 		size_t maxUidsSize{};
+		size_t maxUidsCount{};
+		bool hasJson{};
+		bool hasBinary{};
 		std::vector<Destination> destinations;
-		for (auto& events : eventsArray) {
-			const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ events->GetLock() };
-			const auto& items{ events->Get() };
-			auto begin{ items.begin() };
-			const auto end{ items.end() };
-
-			if (begin != end) {
-				Destination destination{ begin->second->GetConnection() };
+		destinations.reserve(eventsArray->size());
+		for (const auto& holder : *eventsArray) {
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::read> _{ holder.events->GetLock() };
+			const EventNode* node{ holder.events->GetHead() };
+
+			if (node != nullptr) {
+				Destination destination{ node->event->GetConnection(), *holder.data };
+				if (destination.encoding == Encoding::Binary) {
+					destination.uidValues.reserve(holder.events->GetSize());
+					for (; node != nullptr; node = node->ownerNext) {
+						destination.uidValues.emplace_back(node->event->GetUid());
+					}
+
+					maxUidsCount = std::max(maxUidsCount, destination.uidValues.size());
+					hasBinary = true;
+					destinations.emplace_back(std::move(destination));
+					continue;
+				}
+
 				auto backIt{ std::back_inserter(destination.uids) };
-				std::format_to(backIt, "{}", begin->second->GetUid());
+				std::format_to(backIt, "{}", node->event->GetUid());
 
-				while (++begin != end) {
-					std::format_to(backIt, ",{}", begin->second->GetUid());
+				while ((node = node->ownerNext) != nullptr) {
+					std::format_to(backIt, ",{}", node->event->GetUid());
 				}
 
 				const auto size{ destination.uids.size() };
@@ -1223,6 +1648,7 @@ public:
 					maxUidsSize = size;
 				}
 
+				hasJson = true;
 				destinations.emplace_back(std::move(destination));
 			}
 		}
@@ -1237,89 +1663,332 @@ public:
 			return SendResult::Fail;
 		}
 
-		std::string payload(maxUidsSize, ' ');
+		std::string data;
+		std::string_view dataView;
+		if constexpr (std::is_same_v<std::string_view, T>) {
+			dataView = getData;
+		}
+		else if constexpr (!Binary::Producer<T>) {
+			if (!getData(data)) {
+				FailEventsOnConnectionsByFilter(filter, data);
+				return SendResult::Fail;
+			}
+			dataView = data;
+		}
+
+		std::string payload;
+		if (hasJson) {
+			payload.assign(maxUidsSize, ' ');
+			if constexpr (Binary::Producer<T>) {
+				payload += "],\"data\":";
+				Binary::JsonEncoder encoder{ payload };
+				getData(encoder);
+				payload += '}';
+			}
+			else {
+				std::format_to(std::back_inserter(payload), "],\"data\":{}}}", dataView);
+			}
+		}
+
+		// Binary value is encoded once and shared by all binary destinations same as json payload
+		const auto maxBinaryHeaderSize{ Binary::FRAME_HEADER_SIZE + maxUidsCount * sizeof(uint64_t) };
+		std::string binaryPayload;
+		if (hasBinary) {
+			binaryPayload.assign(maxBinaryHeaderSize, '\0');
+			Binary::Encoder encoder{ binaryPayload };
+			if constexpr (Binary::Producer<T>) {
+				getData(encoder);
+			}
+			else if (!encoder.AddJson(dataView)) [[unlikely]] {
+				FailEventsOnConnectionsByFilter(filter, "Data cannot be encoded");
+				return SendResult::Fail;
+			}
+		}
+
+		const auto batchMaxBytes{ m_batchMaxBytes.load(std::memory_order_relaxed) };
+		for (const auto& destination : destinations) {
+			std::string_view frame;
+			if (destination.encoding == Encoding::Binary) {
+				LOG_PROTOCOL_NEW("Send binary data to {} events, connection {}", destination.uidValues.size(),
+					destination.connection);
+				const auto headerShift{ maxBinaryHeaderSize - Binary::FRAME_HEADER_SIZE
+					- destination.uidValues.size() * sizeof(uint64_t) };
+				(void)Binary::WriteHeader(
+					binaryPayload.data() + headerShift, Binary::Frame::Data, destination.uidValues);
+				frame = std::string_view{ binaryPayload.data() + headerShift, binaryPayload.size() - headerShift };
+			}
+			else {
+				LOG_PROTOCOL_NEW(
+					"Send data to events, uids [{}] connection {}", destination.uids, destination.connection);
+				const auto headerSize{ destination.uids.size() + 9 };
+				const auto headerShift{ maxUidsSize - headerSize };
+				std::format_to_n(payload.data() + headerShift, static_cast<int64_t>(headerSize), "{{\"uids\":[{}",
+					destination.uids);
+				frame = std::string_view{ payload.data() + headerShift, payload.size() - headerShift };
+			}
+
+			Deliver(destination.data, destination.connection, frame, destination.encoding, batchMaxBytes);
+		}
+
+		return SendResult::Success;
+	}
+
+	/**
+	 * @brief Send data to bunch of events by filter as structural patch of the last sent document. Document is sent
+	 * fully to events which have not received it yet, to binary encoded connections and when patch is not shorter than
+	 * document. Json connections receive {"uids":[...],"data":...} or {"uids":[...],"patch":[...]} entries, patch
+	 * operations are add, replace and remove with JSON Pointer paths. Entries are batched same as data of SendData.
+	 *
+	 * @attention Patches for the same filter are built under lock and sent without it in order of building, other
+	 * filters are not affected.
+	 *
+	 * @tparam T Type of data, string view or callable to fill provided string.
+	 *
+	 * @param filter Related hash filter to events.
+	 * @param getData Json object of the whole document or lazy invoked function, should fill string argument with
+	 * valid json object on true return and fill with error description otherwise.
+	 *
+	 * @return Send result enum.
+	 *
+	 * @test Has unit test.
+	 */
+	template <typename T>
+		requires(std::is_same_v<std::string_view, T> || std::is_convertible_v<T, std::function<bool(std::string&)>>)
+	FORCE_INLINE [[nodiscard]] SendResult SendPatch(const filter_t& filter, const T getData)
+	{
+		const std::shared_ptr<const holders_t> eventsArray{ GetEventsArray(filter) };
+		if (eventsArray == nullptr) {
+			ErasePatchState(filter);
+			return SendResult::Nothing;
+		}
+
+		std::string data;
+		std::string_view dataView;
 		if constexpr (std::is_same_v<std::string_view, T>) {
-			std::format_to(std::back_inserter(payload), "],\"data\":{}}}", getData);
+			dataView = getData;
 		}
 		else {
-			std::string data;
 			if (!getData(data)) {
 				FailEventsOnConnectionsByFilter(filter, data);
 				return SendResult::Fail;
 			}
-			std::format_to(std::back_inserter(payload), "],\"data\":{}}}", data);
+			dataView = data;
+		}
+
+		Json document{ dataView };
+		if (!document.Valid()) [[unlikely]] {
+			FailEventsOnConnectionsByFilter(filter, "Patched data is not valid json object");
+			return SendResult::Fail;
+		}
+
+		struct Destination {
+			const int32_t connection;
+			EventsData& data;
+			const Encoding encoding;
+			std::string dataUids;
+			std::string patchUids;
+			std::vector<uint64_t> uidValues;
+
+			FORCE_INLINE Destination(const int32_t connection, EventsData& data) noexcept
+				: connection{ connection }
+				, data{ data }
+				, encoding{ data.GetEncoding() }
+			{
+			}
+		};
+
+		/**
+		 * @brief Turn of sending, waits for sending of previously built patches and passes turn to the next one.
+		 */
+		struct Turn {
+			PatchState& state;
+			const uint64_t ticket;
+
+			FORCE_INLINE Turn(PatchState& state, const uint64_t ticket) noexcept
+				: state{ state }
+				, ticket{ ticket }
+			{
+				for (uint64_t served; (served = state.served.load(std::memory_order_acquire)) != ticket;) {
+					state.served.wait(served, std::memory_order_acquire);
+				}
+			}
+
+			FORCE_INLINE ~Turn() noexcept
+			{
+				state.served.store(ticket + 1, std::memory_order_release);
+				state.served.notify_all();
+			}
+
+			Turn(const Turn& other) = delete;
+			Turn(Turn&& other) = delete;
+			Turn& operator=(const Turn& other) = delete;
+			Turn& operator=(Turn&& other) = delete;
+		};
+
+		const std::shared_ptr<PatchState> state{ GetPatchState(filter) };
+		std::string patch;
+		size_t operations;
+		std::vector<Destination> destinations;
+		uint64_t ticket;
+		{
+			const Pthread::AtomicLock::ExitGuard _{ state->lock };
+
+			operations = state->hasDocument ? Patch::Make(patch, state->document, document) : 0;
+			const bool isPatchable{ state->hasDocument && patch.size() < dataView.size() };
+
+			std::set<std::pair<int32_t, uint64_t>> synchronized;
+			destinations.reserve(eventsArray->size());
+			for (const auto& holder : *eventsArray) {
+				const Pthread::ScalableRWLock::ExitGuard<Pthread::read> _{ holder.events->GetLock() };
+				const EventNode* node{ holder.events->GetHead() };
+				if (node == nullptr) {
+					continue;
+				}
+
+				Destination destination{ node->event->GetConnection(), *holder.data };
+				for (; node != nullptr; node = node->ownerNext) {
+					const auto uid{ node->event->GetUid() };
+					if (destination.encoding == Encoding::Binary) {
+						destination.uidValues.emplace_back(uid);
+						continue;
+					}
+
+					const std::pair<int32_t, uint64_t> key{ destination.connection, uid };
+					const bool isSynchronized{ isPatchable && state->synchronized.contains(key) };
+					auto& uids{ isSynchronized ? destination.patchUids : destination.dataUids };
+					std::format_to(std::back_inserter(uids), "{}{}", uids.empty() ? "" : ",", uid);
+					synchronized.emplace(key);
+				}
+				destinations.emplace_back(std::move(destination));
+			}
+
+			if (destinations.empty()) {
+				ErasePatchState(filter);
+				return SendResult::Nothing;
+			}
+
+			state->document = std::move(document);
+			state->hasDocument = true;
+			state->synchronized = std::move(synchronized);
+			ticket = state->issued++;
 		}
 
-		const auto payloadTotalSize{ payload.size() };
+		// Entries differ per destination, so they are formed separately instead of sharing one payload
+		struct Entry {
+			const int32_t connection;
+			EventsData& data;
+			const Encoding encoding;
+			std::string payload;
+		};
+
+		std::vector<Entry> entries;
+		entries.reserve(destinations.size());
+		std::string binaryValue;
 		for (const auto& destination : destinations) {
-			LOG_PROTOCOL_NEW("Send data to events, uids [{}] connection {}", destination.uids, destination.connection);
-			const auto headerSize{ destination.uids.size() + 9 };
-			const auto headerShift{ maxUidsSize - headerSize };
-			std::format_to_n(
-				payload.data() + headerShift, static_cast<int64_t>(headerSize), "{{\"uids\":[{}", destination.uids);
-			Send(destination.connection,
-				{ std::span<const uint8_t>(
-					  reinterpret_cast<const uint8_t*>(payload.data() + headerShift), payloadTotalSize - headerShift),
-					Data::Opcode::Text });
+			if (destination.encoding == Encoding::Binary) {
+				if (binaryValue.empty()) {
+					Binary::Encoder encoder{ binaryValue };
+					if (!encoder.AddJson(dataView)) [[unlikely]] {
+						const Turn turn{ *state, ticket };
+						FailEventsOnConnectionsByFilter(filter, "Data cannot be encoded");
+						return SendResult::Fail;
+					}
+				}
+
+				LOG_PROTOCOL_NEW("Send binary data to {} events, connection {}", destination.uidValues.size(),
+					destination.connection);
+				auto& entry{ entries.emplace_back(destination.connection, destination.data, Encoding::Binary,
+					std::string(Binary::FRAME_HEADER_SIZE + destination.uidValues.size() * sizeof(uint64_t), '\0')) };
+				(void)Binary::WriteHeader(entry.payload.data(), Binary::Frame::Data, destination.uidValues);
+				entry.payload += binaryValue;
+				continue;
+			}
+
+			if (!destination.dataUids.empty()) {
+				LOG_PROTOCOL_NEW("Send document to events, uids [{}] connection {}", destination.dataUids,
+					destination.connection);
+				entries.emplace_back(destination.connection, destination.data, Encoding::Json,
+					std::format("{{\"uids\":[{}],\"data\":{}}}", destination.dataUids, dataView));
+			}
+
+			if (!destination.patchUids.empty() && operations != 0) {
+				LOG_PROTOCOL_NEW("Send patch of {} operations to events, uids [{}] connection {}", operations,
+					destination.patchUids, destination.connection);
+				entries.emplace_back(destination.connection, destination.data, Encoding::Json,
+					std::format("{{\"uids\":[{}],\"patch\":{}}}", destination.patchUids, patch));
+			}
+		}
+
+		const Turn turn{ *state, ticket };
+		const auto batchMaxBytes{ m_batchMaxBytes.load(std::memory_order_relaxed) };
+		for (const auto& entry : entries) {
+			Deliver(entry.data, entry.connection, entry.payload, entry.encoding, batchMaxBytes);
 		}
 
 		return SendResult::Success;
 	}
 
 	/**
-	 * @attention Read locks structure. Write locks structure and create new events data structure for filter if does
-	 * not exist.
+	 * @attention Enters read section of structure. Locks structure writers, waits for its readers and creates new
+	 * events data structure for connection if does not exist, throws std::bad_alloc if it cannot be allocated.
 	 *
 	 * @param connection Related connection.
 	 *
 	 * @return Events data by connection.
 	 *
-	 * @todo Add unit test.
+	 * @test Has unit test.
 	 */
-	FORCE_INLINE [[nodiscard]] std::shared_ptr<EventsData> GetEventsData(const int32_t connection) noexcept
+	FORCE_INLINE [[nodiscard]] std::shared_ptr<EventsData> GetEventsData(const int32_t connection)
 	{
 		{
-			const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ m_connectionToEventsDataLock };
-			auto it{ m_connectionToEventsData.find(connection) };
-			if (it != m_connectionToEventsData.end()) {
+			const typename decltype(m_connectionToEventsData)::ReadGuard connectionToEventsData{
+				m_connectionToEventsData
+			};
+			const auto it{ connectionToEventsData->find(connection) };
+			if (it != connectionToEventsData->end()) {
 				return it->second;
 			}
 		}
 
-		const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ m_connectionToEventsDataLock };
-		return m_connectionToEventsData.emplace(connection, std::make_shared<EventsData>(connection)).first->second;
+		std::shared_ptr<EventsData> eventsData;
+		(void)m_connectionToEventsData.Update([this, connection, &eventsData](auto& connectionToEventsData) {
+			// Other writer could create events data after lookup
+			const auto [it, inserted]{ connectionToEventsData.try_emplace(connection) };
+			if (inserted) {
+				it->second = std::make_shared<EventsData>(*this, connection);
+			}
+			eventsData = it->second;
+			return inserted;
+		});
+		return eventsData;
 	}
 
 	/**
-	 * @attention Read locks structure.
+	 * @brief Lookup in filter index snapshot, does not lock.
 	 *
 	 * @param filter Filter to find related events.
 	 *
-	 * @return Array of existed events data from all stored connections.
+	 * @return Snapshot of non-empty events from subscribed connections, nullptr if there are no such events.
 	 *
 	 * @todo Add unit test.
 	 */
-	FORCE_INLINE [[nodiscard]] std::vector<std::shared_ptr<Events>> GetEventsArray(const filter_t& filter) noexcept
+	FORCE_INLINE [[nodiscard]] std::shared_ptr<const holders_t> GetEventsArray(const filter_t& filter) const noexcept
 	{
-		std::shared_ptr<Events> events;
-		std::vector<std::shared_ptr<Events>> eventsArray;
-		const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ m_connectionToEventsDataLock };
-		for (const auto& [connection, eventsData] : m_connectionToEventsData) {
-			events = eventsData->template GetEvents<EventsData::lookup>(filter);
-			if (events.get()) {
-				// Interraction with events is required locking, same as for checking on empty
-				// That is worth to lock once at the usage cycle
-				eventsArray.emplace_back(std::move(events));
-			}
+		const std::shared_ptr<const index_t> index{ m_filterToEventsIndex.load(std::memory_order_acquire) };
+		const auto it{ index->find(filter) };
+		if (it == index->end()) {
+			return {};
 		}
 
-		return eventsArray;
+		// Interraction with events is required locking, same as for checking on empty
+		// That is worth to lock once at the usage cycle
+		return it->second;
 	}
 
 	/**
-	 * @brief Fail events by filter on each connection.
+	 * @brief Fail events by filter on each subscribed connection.
 	 *
-	 * @attention Read locks structure, read lock events data structures and write locks events structures.
+	 * @attention Write locks events structures.
 	 *
 	 * @param filter Filter to find related events.
 	 * @param error Description of the failure.
@@ -1328,16 +1997,17 @@ public:
 	 */
 	FORCE_INLINE void FailEventsOnConnectionsByFilter(const filter_t& filter, std::string_view error)
 	{
-		const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ m_connectionToEventsDataLock };
-		for (const auto& [connection, eventsData] : m_connectionToEventsData) {
-			eventsData->FailEventsByFilter(filter, error);
+		if (const auto eventsArray{ GetEventsArray(filter) }; eventsArray != nullptr) {
+			for (const auto& holder : *eventsArray) {
+				holder.events->FailEvents(error);
+			}
 		}
 	}
 
 	/**
-	 * @brief Erase events by filter on each connection.
+	 * @brief Erase events by filter on each subscribed connection.
 	 *
-	 * @attention Read locks structure, read lock events data structures and write locks events structures.
+	 * @attention Write locks events structures.
 	 *
 	 * @param filter Filter to find related events.
 	 *
@@ -1345,10 +2015,237 @@ public:
 	 */
 	FORCE_INLINE void EraseEventsOnConnectionsByFilter(const filter_t& filter)
 	{
-		const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ m_connectionToEventsDataLock };
-		for (const auto& [connection, eventsData] : m_connectionToEventsData) {
-			eventsData->EraseEventsByFilter(filter);
+		if (const auto eventsArray{ GetEventsArray(filter) }; eventsArray != nullptr) {
+			for (const auto& holder : *eventsArray) {
+				holder.events->EraseEvents();
+			}
+		}
+	}
+
+private:
+	/**
+	 * @brief Register events in filter index. Copies index with unchanged holders shared and publishes new snapshot.
+	 * Events of closed events data are not registered.
+	 *
+	 * @attention Is assumed to be called on events becoming non-empty under events write locking. Locks index
+	 * writers.
+	 *
+	 * @param holder Events to be registered with their events data.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void IndexEvents(Holder&& holder)
+	{
+		if (holder.data->IsClosed()) [[unlikely]] {
+			LOG_WARNING_NEW(
+				"Events of closed events data are not indexed, connection {}", holder.data->GetConnection());
+			return;
+		}
+
+		const Pthread::AtomicLock::ExitGuard _{ m_filterToEventsIndexLock };
+		const std::shared_ptr<const index_t> current{ m_filterToEventsIndex.load(std::memory_order_acquire) };
+		const filter_t& filter{ holder.events->GetFilter() };
+		const auto it{ current->find(filter) };
+		auto holders{ std::make_shared<holders_t>() };
+		if (it != current->end()) {
+			if (std::ranges::find(*it->second, holder.events, &Holder::events) != it->second->end()) [[unlikely]] {
+				return;
+			}
+
+			holders->reserve(it->second->size() + 1);
+			*holders = *it->second;
+		}
+
+		auto index{ std::make_shared<index_t>(*current) };
+		auto& target{ (*index)[filter] };
+		holders->emplace_back(std::move(holder));
+		target = std::move(holders);
+		m_filterToEventsIndex.store(std::move(index), std::memory_order_release);
+	}
+
+	/**
+	 * @brief Unregister events from filter index and publish new snapshot.
+	 *
+	 * @attention Is assumed to be called on events becoming empty. Locks index writers.
+	 *
+	 * @param events Events to be unregistered.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void UnindexEvents(const Events& events)
+	{
+		const Pthread::AtomicLock::ExitGuard _{ m_filterToEventsIndexLock };
+		const std::shared_ptr<const index_t> current{ m_filterToEventsIndex.load(std::memory_order_acquire) };
+		const auto it{ current->find(events.GetFilter()) };
+		if (it == current->end()) {
+			return;
+		}
+
+		auto holders{ std::make_shared<holders_t>() };
+		holders->reserve(it->second->size());
+		for (const auto& holder : *it->second) {
+			if (holder.events.get() != &events) {
+				holders->emplace_back(holder);
+			}
+		}
+
+		if (holders->size() == it->second->size()) {
+			return;
+		}
+
+		auto index{ std::make_shared<index_t>(*current) };
+		if (holders->empty()) {
+			index->erase(events.GetFilter());
+		}
+		else {
+			(*index)[events.GetFilter()] = std::move(holders);
+		}
+		m_filterToEventsIndex.store(std::move(index), std::memory_order_release);
+	}
+
+	/**
+	 * @brief Unregister all events of the connection from filter index and publish new snapshot.
+	 *
+	 * @attention Locks index writers.
+	 *
+	 * @param data Events data of the connection.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void UnindexEventsData(const EventsData& data)
+	{
+		const Pthread::AtomicLock::ExitGuard _{ m_filterToEventsIndexLock };
+		const std::shared_ptr<const index_t> current{ m_filterToEventsIndex.load(std::memory_order_acquire) };
+		auto index{ std::make_shared<index_t>() };
+		bool changed{ false };
+		for (const auto& [filter, holders] : *current) {
+			if (std::ranges::none_of(*holders, [&data](const Holder& holder) { return holder.data.get() == &data; })) {
+				index->emplace_hint(index->end(), filter, holders);
+				continue;
+			}
+
+			changed = true;
+			auto filtered{ std::make_shared<holders_t>() };
+			for (const auto& holder : *holders) {
+				if (holder.data.get() != &data) {
+					filtered->emplace_back(holder);
+				}
+			}
+
+			if (!filtered->empty()) {
+				index->emplace_hint(index->end(), filter, std::move(filtered));
+			}
+		}
+
+		if (changed) {
+			m_filterToEventsIndex.store(std::move(index), std::memory_order_release);
+		}
+	}
+
+	/**
+	 * @brief Add data entry to batch of the connection if batching is enabled, send it immediately otherwise.
+	 *
+	 * @param data Events data of the connection.
+	 * @param connection Related connection.
+	 * @param entry Data entry.
+	 * @param encoding Encoding of the entry.
+	 * @param batchMaxBytes Size of batch to be sent at.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void Deliver(EventsData& data, const int32_t connection, const std::string_view entry,
+		const Encoding encoding, const size_t batchMaxBytes)
+	{
+		if (m_batching.load(std::memory_order_acquire)) {
+			if (data.AddToBatch(entry, encoding, batchMaxBytes)) {
+				// Only opening of batch wakes up flusher, next entries of the same window are added silently
+				{
+					const std::lock_guard<std::mutex> _{ m_batchMutex };
+					m_batchPending = true;
+				}
+				m_batchCondition.notify_one();
+			}
+			// Batching can be stopped after final flush, entry must not be left pending
+			if (!m_batching.load(std::memory_order_acquire)) [[unlikely]] {
+				data.FlushBatch();
+			}
+			return;
+		}
+
+		Send(connection,
+			{ std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(entry.data()), entry.size()),
+				encoding == Encoding::Binary ? Data::Opcode::Binary : Data::Opcode::Text });
+	}
+
+	/**
+	 * @attention Read locks patch states structure. Write locks it and creates new state if does not exist.
+	 *
+	 * @param filter Filter of patched document.
+	 *
+	 * @return State of patched document by filter.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] std::shared_ptr<PatchState> GetPatchState(const filter_t& filter)
+	{
+		{
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::read> _{ m_filterToPatchStateLock };
+			const auto it{ m_filterToPatchState.find(filter) };
+			if (it != m_filterToPatchState.end()) {
+				return it->second;
+			}
+		}
+
+		const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ m_filterToPatchStateLock };
+		return m_filterToPatchState.emplace(filter, std::make_shared<PatchState>()).first->second;
+	}
+
+	/**
+	 * @brief Forget last sent document by filter when there are no subscribed events.
+	 *
+	 * @attention Write locks patch states structure.
+	 *
+	 * @param filter Filter of patched document.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void ErasePatchState(const filter_t& filter)
+	{
+		const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ m_filterToPatchStateLock };
+		m_filterToPatchState.erase(filter);
+	}
+
+	/**
+	 * @brief Handling function for batch flusher pthread. Sleeps until any batch is opened, waits for batching window
+	 * and sends pending batches.
+	 *
+	 * @param distributor Writable pointer to distributor.
+	 *
+	 * @return Always nullptr.
+	 */
+	FORCE_INLINE static void* BatchFlusherRunner(void* const distributor)
+	{
+		auto* const self{ static_cast<Distributor*>(distributor) };
+		LOG_DEBUG_NEW("Events batch flusher is started, PID: {}", gettid());
+		const auto isStopped{ [self]() { return !self->m_batching.load(std::memory_order_acquire); } };
+		std::unique_lock<std::mutex> lock{ self->m_batchMutex };
+		while (true) {
+			self->m_batchCondition.wait(lock, [self, &isStopped]() { return self->m_batchPending || isStopped(); });
+			if (isStopped()) {
+				break;
+			}
+
+			(void)self->m_batchCondition.wait_for(
+				lock, std::chrono::microseconds(self->m_batchWindowUs.load(std::memory_order_relaxed)), isStopped);
+			// Batches opened after this point announce themselves again and are sent by the next round
+			self->m_batchPending = false;
+			lock.unlock();
+			self->FlushBatches();
+			lock.lock();
 		}
+
+		LOG_DEBUG_NEW("Events batch flusher is finished, PID: {}", gettid());
+		return nullptr;
 	}
 };
 
@@ -1377,16 +2274,17 @@ public:
 	/**
 	 * @brief Send data to related events and erase them on success.
 	 *
-	 * @tparam T Type of data, string view or callable to fill provided string.
+	 * @tparam T Type of data, string view, callable to fill provided string or binary producer.
 	 *
 	 * @param filter Related hash filter to events.
 	 * @param getData Data to be sent or lazy invoked function, should fill string argument with valid json key on true
-	 * return and fill with error description otherwise.
+	 * return and fill with error description otherwise, or producer which is invoked once per required encoding.
 	 *
 	 * @todo Add unit test.
 	 */
 	template <typename T>
-		requires(std::is_same_v<std::string_view, T> || std::is_convertible_v<T, std::function<bool(std::string&)>>)
+		requires(Binary::Producer<T> || std::is_same_v<std::string_view, T>
+			|| std::is_convertible_v<T, std::function<bool(std::string&)>>)
 	FORCE_INLINE void CheckDelayed(const base_t::filter_t& filter, const T getData)
 	{
 		if (this->SendData(filter, getData) == SendResult::Success) {
@@ -1433,11 +2331,11 @@ private:
 				typename base_t::filter_t{ hash, std::move(filter) }) };
 
 			LOG_PROTOCOL_NEW("New single event is delayed, uid {} connection {}", uid, connection);
-			events->AddEvent(std::make_shared<Single>(std::move(single)));
+			events->AddEvent(std::move(single));
 			return;
 		}
 		default:
-			LOG_WARNING_NEW("Unexpected result of single event handling: {}", EnumToString(result));
+			LOG_WARNING_NEW_LIMITED("Unexpected result of single event handling: {}", EnumToString(result));
 			return;
 		}
 	}
@@ -1487,30 +2385,30 @@ private:
 		LOG_PROTOCOL_NEW("New stream event, uid {} event type hash {} connection {}", uid, hash, connection);
 
 		std::string payload{ std::format("{{\"uids\":[{}],\"data\":", uid) };
-		auto stream{ std::make_shared<Stream>(uid, std::move(handlerData), std::move(json), connection) };
+		Stream stream{ uid, std::move(handlerData), std::move(json), connection };
 
-		const auto result{ stream->Handle(payload) };
+		const auto result{ stream.Handle(payload) };
 		switch (result) {
 		case HandleResult::Success: {
-			stream->SendState(Stream::State::Opened);
+			stream.SendState(Stream::State::Opened);
 			std::shared_ptr<typename base_t::EventsData> eventsData{ this->GetEventsData(connection) };
 			std::shared_ptr<typename base_t::Events> events{ eventsData->template GetEvents<base_t::EventsData::create>(
 				typename base_t::filter_t{ hash, std::move(filter) }) };
-			events->AddEvent(stream);
+			events->AddEvent(std::move(stream));
 
 			payload += '}';
 			LOG_PROTOCOL_NEW("Send stream event success response, uid {} connection {}", uid, connection);
 			Send(connection,
 				{ std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(payload.data()), payload.size()),
 					Data::Opcode::Text });
-			stream->SendState(Stream::State::Done);
+			Stream::SendState(uid, connection, Stream::State::Done);
 			return;
 		}
 		case HandleResult::Fail:
 			SendFailed(uid, connection, payload);
 			return;
 		default:
-			LOG_WARNING_NEW("Unexpected result of single event handling: {}", EnumToString(result));
+			LOG_WARNING_NEW_LIMITED("Unexpected result of single event handling: {}", EnumToString(result));
 			return;
 		}
 	}
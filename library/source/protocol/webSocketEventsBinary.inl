@@ -0,0 +1,1048 @@
+/**************************
+ * @file        webSocketEventsBinary.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ *
+ * @brief Binary encoding of events protocol frames. Values are type tagged by StandardType::Type where possible.
+ *
+ * All numbers are little endian. Frame: kind (uint8), uids count (uint32), uids (uint64 each) and value for data kind.
+ * Batch frame: kind (uint8), frames count (uint32) and frames one after another. Value: tag (uint8) and payload:
+ * - Undefined: null, no payload;
+ * - Int8..Uint64, Float, Double: number of related size;
+ * - Bool: uint8 0 or 1;
+ * - String: size (uint32) and UTF-8 bytes, StringEmpty: no payload;
+ * - Object: count of pairs (uint32), each pair is key (size uint32 and bytes) and value;
+ * - Array: count of values (uint32) and values.
+ */
+
+#ifndef MSAPI_PROTOCOL_WEBSOCKET_EVENTS_BINARY_INL
+#define MSAPI_PROTOCOL_WEBSOCKET_EVENTS_BINARY_INL
+
+#include "../help/json.h"
+#include "../help/standardType.hpp"
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace MSAPI {
+
+namespace Protocol {
+
+namespace WebSocket {
+
+namespace Events {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**
+ * @brief Encoding of events data for the connection. Json is default, binary is negotiated by client request with
+ * "encoding" key.
+ */
+enum class Encoding : int8_t { Undefined, Json, Binary, Max };
+
+/**
+ * @return String interpretation of encoding enum.
+ *
+ * @test Has unit test.
+ */
+FORCE_INLINE [[nodiscard]] std::string_view EnumToString(Encoding encoding);
+
+namespace Binary {
+
+static_assert(std::endian::native == std::endian::little, "Binary encoding relies on little endian memory layout");
+
+/**
+ * @brief Kind of binary frame.
+ */
+enum class Frame : uint8_t { Undefined, Data, Batch, Max };
+
+// Tags beyond standard types for json containers
+static constexpr inline uint8_t OBJECT_TAG{ 64 };
+static constexpr inline uint8_t ARRAY_TAG{ 65 };
+static constexpr inline size_t FRAME_HEADER_SIZE{ sizeof(uint8_t) + sizeof(uint32_t) };
+
+/**
+ * @brief Write frame header.
+ *
+ * @param buffer Destination, must have at least FRAME_HEADER_SIZE + 8 * uids count bytes.
+ * @param frame Kind of frame.
+ * @param uids Uids of events.
+ *
+ * @return Number of written bytes.
+ *
+ * @test Has unit test.
+ */
+FORCE_INLINE size_t WriteHeader(char* buffer, Frame frame, std::span<const uint64_t> uids) noexcept;
+
+/**
+ * @brief Append string as escaped json string with quotes.
+ *
+ * @param json Destination of json text.
+ * @param value UTF-8 string without escape sequences.
+ *
+ * @test Has unit test.
+ */
+FORCE_INLINE void AppendEscaped(std::string& json, std::string_view value);
+
+/**
+ * @brief Writer of type tagged values into string buffer. Containers are counted automatically and their counts are
+ * written on closing.
+ */
+class Encoder {
+private:
+	std::string& m_buffer;
+	// Offset of count and current count of opened containers
+	std::vector<std::pair<size_t, uint32_t>> m_containers;
+
+public:
+	/**
+	 * @brief Construct a new encoder object, values are appended to the buffer.
+	 *
+	 * @param buffer Destination buffer.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE explicit Encoder(std::string& buffer) noexcept;
+
+	/**
+	 * @brief Append number or bool with exact type tag.
+	 *
+	 * @tparam T Arithmetic type.
+	 *
+	 * @param value Value to be appended.
+	 *
+	 * @test Has unit test.
+	 */
+	template <typename T>
+		requires std::is_arithmetic_v<T>
+	FORCE_INLINE void Add(T value);
+
+	/**
+	 * @brief Append string.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void Add(std::string_view value);
+
+	/**
+	 * @brief Append null.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void AddNull();
+
+	/**
+	 * @brief Open object, pairs are added by Key and any value appending.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void BeginObject();
+
+	/**
+	 * @brief Append key of the next object pair.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void Key(std::string_view key);
+
+	/**
+	 * @brief Close last opened object.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void EndObject();
+
+	/**
+	 * @brief Open array.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void BeginArray();
+
+	/**
+	 * @brief Close last opened array.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void EndArray();
+
+	/**
+	 * @brief Append parsed json node. Integers are written with the smallest type which keeps the value.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void AddNode(const JsonNode& node);
+
+	/**
+	 * @brief Parse json value and append it.
+	 *
+	 * @param json Any json value.
+	 *
+	 * @return True if json is valid, false otherwise and buffer is not changed.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] bool AddJson(std::string_view json);
+
+private:
+	/**
+	 * @brief Count new value in the last opened container and write its tag.
+	 */
+	FORCE_INLINE void Tag(uint8_t tag);
+
+	/**
+	 * @brief Write raw little endian bytes of value.
+	 */
+	template <typename T> FORCE_INLINE void Write(T value);
+
+	/**
+	 * @brief Write size and bytes of string.
+	 */
+	FORCE_INLINE void WriteString(std::string_view value);
+
+	/**
+	 * @brief Write size and bytes of string which is escaped as json parser stores it. Escape sequences are decoded,
+	 * \\u sequences are written in UTF-8.
+	 */
+	FORCE_INLINE void WriteEscapedString(std::string_view value);
+
+	/**
+	 * @brief Write count of last opened container and close it.
+	 */
+	FORCE_INLINE void Close();
+};
+
+/**
+ * @brief Writer of values as json text with interface of Encoder, so one producer fills data of both encodings without
+ * parsing of json text. Non-finite numbers are written as null, same as binary values are decoded.
+ */
+class JsonEncoder {
+private:
+	std::string& m_buffer;
+	// Separator is required before the next value or key of the opened container
+	bool m_isSeparated{ false };
+
+public:
+	/**
+	 * @brief Construct a new json encoder object, values are appended to the buffer.
+	 *
+	 * @param buffer Destination buffer.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE explicit JsonEncoder(std::string& buffer) noexcept;
+
+	/**
+	 * @brief Append number or bool.
+	 *
+	 * @tparam T Arithmetic type.
+	 *
+	 * @param value Value to be appended.
+	 *
+	 * @test Has unit test.
+	 */
+	template <typename T>
+		requires std::is_arithmetic_v<T>
+	FORCE_INLINE void Add(T value);
+
+	/**
+	 * @brief Append escaped string.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void Add(std::string_view value);
+
+	/**
+	 * @brief Append null.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void AddNull();
+
+	/**
+	 * @brief Open object, pairs are added by Key and any value appending.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void BeginObject();
+
+	/**
+	 * @brief Append key of the next object pair.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void Key(std::string_view key);
+
+	/**
+	 * @brief Close last opened object.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void EndObject();
+
+	/**
+	 * @brief Open array.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void BeginArray();
+
+	/**
+	 * @brief Close last opened array.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE void EndArray();
+
+private:
+	/**
+	 * @brief Write separator if the value is not the first one in the opened container.
+	 */
+	FORCE_INLINE void Separate();
+};
+
+/**
+ * @brief Producer of events data, is invoked with Encoder for binary destinations and with JsonEncoder for json ones,
+ * usually generic lambda. Producer writes exactly one value.
+ */
+template <typename T>
+concept Producer = std::invocable<const T&, Encoder&> && std::invocable<const T&, JsonEncoder&>;
+
+/**
+ * @brief Reader of binary frames with conversion of values to json text.
+ */
+class Decoder {
+private:
+	static constexpr inline size_t MAX_DEPTH{ 64 };
+
+	const std::span<const uint8_t> m_buffer;
+	size_t m_offset{};
+
+public:
+	/**
+	 * @brief Construct a new decoder object.
+	 *
+	 * @param buffer Encoded bytes.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE explicit Decoder(std::span<const uint8_t> buffer) noexcept;
+
+	/**
+	 * @brief Read frame header.
+	 *
+	 * @param frame Kind of frame.
+	 * @param uids Uids of events or number of frames for batch in the first element, previous content is cleared.
+	 *
+	 * @return True if header is read, false otherwise.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] bool ReadHeader(Frame& frame, std::vector<uint64_t>& uids);
+
+	/**
+	 * @brief Read value and append it as json text.
+	 *
+	 * @param json Destination of json text.
+	 *
+	 * @return True if value is read, false on malformed or truncated value.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] bool ReadJson(std::string& json);
+
+	/**
+	 * @return True if all bytes are read.
+	 *
+	 * @test Has unit test.
+	 */
+	FORCE_INLINE [[nodiscard]] bool IsEnd() const noexcept;
+
+private:
+	/**
+	 * @brief Read raw little endian value.
+	 */
+	template <typename T> FORCE_INLINE [[nodiscard]] bool Read(T& value) noexcept;
+
+	/**
+	 * @brief Read string and append it as escaped json string.
+	 */
+	FORCE_INLINE [[nodiscard]] bool ReadString(std::string& json);
+
+	/**
+	 * @brief Read value with depth protection.
+	 */
+	FORCE_INLINE [[nodiscard]] bool ReadJson(std::string& json, size_t depth);
+};
+
+} // namespace Binary
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+FORCE_INLINE [[nodiscard]] std::string_view EnumToString(const Encoding encoding)
+{
+	// Must generate a jump table when the case labels are not dense, but short, and fill empty with default case.
+	switch (encoding) {
+	case Encoding::Undefined:
+		return "Undefined";
+	case Encoding::Json:
+		return "Json";
+	case Encoding::Binary:
+		return "Binary";
+	case Encoding::Max:
+		return "Max";
+	default:
+		LOG_ERROR_NEW("Unknown encoding: {}", U(encoding));
+		return "Unknown";
+	}
+}
+
+namespace Binary {
+
+FORCE_INLINE size_t WriteHeader(char* const buffer, const Frame frame, const std::span<const uint64_t> uids) noexcept
+{
+	buffer[0] = static_cast<char>(frame);
+	const auto count{ static_cast<uint32_t>(uids.size()) };
+	std::memcpy(buffer + 1, &count, sizeof(count));
+	std::memcpy(buffer + FRAME_HEADER_SIZE, uids.data(), uids.size_bytes());
+	return FRAME_HEADER_SIZE + uids.size_bytes();
+}
+
+FORCE_INLINE void AppendEscaped(std::string& json, const std::string_view value)
+{
+	json += '"';
+	for (const char symbol : value) {
+		switch (symbol) {
+		case '"':
+			json += "\\\"";
+			break;
+		case '\\':
+			json += "\\\\";
+			break;
+		case '\n':
+			json += "\\n";
+			break;
+		case '\r':
+			json += "\\r";
+			break;
+		case '\t':
+			json += "\\t";
+			break;
+		default:
+			if (static_cast<uint8_t>(symbol) < 0x20) {
+				std::format_to(std::back_inserter(json), "\\u{:04x}", static_cast<uint32_t>(symbol));
+				break;
+			}
+			json += symbol;
+		}
+	}
+	json += '"';
+}
+
+FORCE_INLINE Encoder::Encoder(std::string& buffer) noexcept
+	: m_buffer{ buffer }
+{
+}
+
+template <typename T>
+	requires std::is_arithmetic_v<T>
+FORCE_INLINE void Encoder::Add(const T value)
+{
+	using Type = StandardType::Type;
+	if constexpr (std::is_same_v<T, bool>) {
+		Tag(static_cast<uint8_t>(Type::Bool));
+		Write(static_cast<uint8_t>(value));
+	}
+	else {
+		if constexpr (std::is_same_v<T, int8_t>) {
+			Tag(static_cast<uint8_t>(Type::Int8));
+		}
+		else if constexpr (std::is_same_v<T, int16_t>) {
+			Tag(static_cast<uint8_t>(Type::Int16));
+		}
+		else if constexpr (std::is_same_v<T, int32_t>) {
+			Tag(static_cast<uint8_t>(Type::Int32));
+		}
+		else if constexpr (std::is_same_v<T, int64_t>) {
+			Tag(static_cast<uint8_t>(Type::Int64));
+		}
+		else if constexpr (std::is_same_v<T, uint8_t>) {
+			Tag(static_cast<uint8_t>(Type::Uint8));
+		}
+		else if constexpr (std::is_same_v<T, uint16_t>) {
+			Tag(static_cast<uint8_t>(Type::Uint16));
+		}
+		else if constexpr (std::is_same_v<T, uint32_t>) {
+			Tag(static_cast<uint8_t>(Type::Uint32));
+		}
+		else if constexpr (std::is_same_v<T, uint64_t>) {
+			Tag(static_cast<uint8_t>(Type::Uint64));
+		}
+		else if constexpr (std::is_same_v<T, float>) {
+			Tag(static_cast<uint8_t>(Type::Float));
+		}
+		else if constexpr (std::is_same_v<T, double>) {
+			Tag(static_cast<uint8_t>(Type::Double));
+		}
+		else {
+			static_assert(sizeof(T) == 0, "Unsupported arithmetic type");
+		}
+		Write(value);
+	}
+}
+
+FORCE_INLINE void Encoder::Add(const std::string_view value)
+{
+	if (value.empty()) {
+		Tag(static_cast<uint8_t>(StandardType::Type::StringEmpty));
+		return;
+	}
+
+	Tag(static_cast<uint8_t>(StandardType::Type::String));
+	WriteString(value);
+}
+
+FORCE_INLINE void Encoder::AddNull() { Tag(static_cast<uint8_t>(StandardType::Type::Undefined)); }
+
+FORCE_INLINE void Encoder::BeginObject()
+{
+	Tag(OBJECT_TAG);
+	m_containers.emplace_back(m_buffer.size(), 0);
+	Write(uint32_t{});
+}
+
+FORCE_INLINE void Encoder::Key(const std::string_view key) { WriteString(key); }
+
+FORCE_INLINE void Encoder::EndObject() { Close(); }
+
+FORCE_INLINE void Encoder::BeginArray()
+{
+	Tag(ARRAY_TAG);
+	m_containers.emplace_back(m_buffer.size(), 0);
+	Write(uint32_t{});
+}
+
+FORCE_INLINE void Encoder::EndArray() { Close(); }
+
+FORCE_INLINE void Encoder::AddNode(const JsonNode& node)
+{
+	std::visit(
+		[this](const auto& value) {
+			using T = std::decay_t<decltype(value)>;
+			if constexpr (std::is_same_v<T, Json>) {
+				BeginObject();
+				for (const auto& [key, child] : value.GetKeysAndValues()) {
+					WriteEscapedString(key);
+					AddNode(child);
+				}
+				EndObject();
+			}
+			else if constexpr (std::is_same_v<T, std::list<JsonNode>>) {
+				BeginArray();
+				for (const auto& child : value) {
+					AddNode(child);
+				}
+				EndArray();
+			}
+			else if constexpr (std::is_same_v<T, std::string>) {
+				if (value.empty()) {
+					Tag(static_cast<uint8_t>(StandardType::Type::StringEmpty));
+					return;
+				}
+
+				Tag(static_cast<uint8_t>(StandardType::Type::String));
+				WriteEscapedString(value);
+			}
+			else if constexpr (std::is_same_v<T, double> || std::is_same_v<T, bool>) {
+				Add(value);
+			}
+			else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+				AddNull();
+			}
+			else {
+				// Integers are written with the smallest width, negative ones as signed
+				const auto addUnsigned{ [this](const uint64_t unsignedValue) {
+					if (unsignedValue <= std::numeric_limits<uint8_t>::max()) {
+						Add(static_cast<uint8_t>(unsignedValue));
+					}
+					else if (unsignedValue <= std::numeric_limits<uint16_t>::max()) {
+						Add(static_cast<uint16_t>(unsignedValue));
+					}
+					else if (unsignedValue <= std::numeric_limits<uint32_t>::max()) {
+						Add(static_cast<uint32_t>(unsignedValue));
+					}
+					else {
+						Add(unsignedValue);
+					}
+				} };
+
+				if constexpr (std::is_unsigned_v<T>) {
+					addUnsigned(value);
+					return;
+				}
+				else if (value >= 0) {
+					addUnsigned(static_cast<uint64_t>(value));
+					return;
+				}
+
+				const auto signedValue{ static_cast<int64_t>(value) };
+				if (signedValue >= std::numeric_limits<int8_t>::min()) {
+					Add(static_cast<int8_t>(signedValue));
+				}
+				else if (signedValue >= std::numeric_limits<int16_t>::min()) {
+					Add(static_cast<int16_t>(signedValue));
+				}
+				else if (signedValue >= std::numeric_limits<int32_t>::min()) {
+					Add(static_cast<int32_t>(signedValue));
+				}
+				else {
+					Add(signedValue);
+				}
+			}
+		},
+		node.GetValue());
+}
+
+FORCE_INLINE [[nodiscard]] bool Encoder::AddJson(const std::string_view json)
+{
+	// Root of any type is parsed as value of object
+	std::string wrapped;
+	wrapped.reserve(json.size() + 6);
+	wrapped += "{\"v\":";
+	wrapped += json;
+	wrapped += '}';
+
+	const Json parsed{ wrapped };
+	const auto* node{ parsed.GetValue("v") };
+	if (!parsed.Valid() || node == nullptr || !node->Valid()) [[unlikely]] {
+		LOG_WARNING_NEW_LIMITED("Json value cannot be encoded: {}", json);
+		return false;
+	}
+
+	AddNode(*node);
+	return true;
+}
+
+FORCE_INLINE void Encoder::Tag(const uint8_t tag)
+{
+	if (!m_containers.empty()) {
+		++m_containers.back().second;
+	}
+	m_buffer += static_cast<char>(tag);
+}
+
+template <typename T> FORCE_INLINE void Encoder::Write(const T value)
+{
+	const auto offset{ m_buffer.size() };
+	m_buffer.resize(offset + sizeof(T));
+	std::memcpy(m_buffer.data() + offset, &value, sizeof(T));
+}
+
+FORCE_INLINE void Encoder::WriteString(const std::string_view value)
+{
+	Write(static_cast<uint32_t>(value.size()));
+	m_buffer += value;
+}
+
+FORCE_INLINE void Encoder::WriteEscapedString(const std::string_view value)
+{
+	const auto offset{ m_buffer.size() };
+	Write(uint32_t{});
+
+	const auto hex{ [&value](const size_t index, uint32_t& code) {
+		if (index + 4 > value.size()) {
+			return false;
+		}
+
+		code = 0;
+		for (size_t position{ index }; position < index + 4; ++position) {
+			const char symbol{ value[position] };
+			code <<= 4;
+			if (symbol >= '0' && symbol <= '9') {
+				code |= static_cast<uint32_t>(symbol - '0');
+			}
+			else if (symbol >= 'a' && symbol <= 'f') {
+				code |= static_cast<uint32_t>(symbol - 'a' + 10);
+			}
+			else if (symbol >= 'A' && symbol <= 'F') {
+				code |= static_cast<uint32_t>(symbol - 'A' + 10);
+			}
+			else {
+				return false;
+			}
+		}
+		return true;
+	} };
+
+	for (size_t index{}; index < value.size(); ++index) {
+		if (value[index] != '\\' || index + 1 == value.size()) {
+			m_buffer += value[index];
+			continue;
+		}
+
+		switch (const char symbol{ value[++index] }) {
+		case 'b':
+			m_buffer += '\b';
+			break;
+		case 'f':
+			m_buffer += '\f';
+			break;
+		case 'n':
+			m_buffer += '\n';
+			break;
+		case 'r':
+			m_buffer += '\r';
+			break;
+		case 't':
+			m_buffer += '\t';
+			break;
+		case 'u': {
+			uint32_t code;
+			if (!hex(index + 1, code)) [[unlikely]] {
+				m_buffer += "\\u";
+				break;
+			}
+			index += 4;
+
+			uint32_t low;
+			if (code >= 0xD800 && code <= 0xDBFF && index + 2 < value.size() && value[index + 1] == '\\'
+				&& value[index + 2] == 'u' && hex(index + 3, low) && low >= 0xDC00 && low <= 0xDFFF) {
+
+				code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+				index += 6;
+			}
+
+			if (code < 0x80) {
+				m_buffer += static_cast<char>(code);
+			}
+			else if (code < 0x800) {
+				m_buffer += static_cast<char>(0xC0 | (code >> 6));
+				m_buffer += static_cast<char>(0x80 | (code & 0x3F));
+			}
+			else if (code < 0x10000) {
+				m_buffer += static_cast<char>(0xE0 | (code >> 12));
+				m_buffer += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+				m_buffer += static_cast<char>(0x80 | (code & 0x3F));
+			}
+			else {
+				m_buffer += static_cast<char>(0xF0 | (code >> 18));
+				m_buffer += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+				m_buffer += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+				m_buffer += static_cast<char>(0x80 | (code & 0x3F));
+			}
+			break;
+		}
+		default:
+			// Quote, reverse solidus and solidus are written as is
+			m_buffer += symbol;
+		}
+	}
+
+	const auto size{ static_cast<uint32_t>(m_buffer.size() - offset - sizeof(uint32_t)) };
+	std::memcpy(m_buffer.data() + offset, &size, sizeof(size));
+}
+
+FORCE_INLINE void Encoder::Close()
+{
+	if (m_containers.empty()) [[unlikely]] {
+		LOG_ERROR("Binary encoder has no opened container to close");
+		return;
+	}
+
+	const auto [offset, count] { m_containers.back() };
+	m_containers.pop_back();
+	std::memcpy(m_buffer.data() + offset, &count, sizeof(count));
+}
+
+FORCE_INLINE JsonEncoder::JsonEncoder(std::string& buffer) noexcept
+	: m_buffer{ buffer }
+{
+}
+
+template <typename T>
+	requires std::is_arithmetic_v<T>
+FORCE_INLINE void JsonEncoder::Add(const T value)
+{
+	Separate();
+	if constexpr (std::is_same_v<T, bool>) {
+		m_buffer += value ? "true" : "false";
+	}
+	else if constexpr (std::is_floating_point_v<T>) {
+		if (!std::isfinite(value)) [[unlikely]] {
+			m_buffer += "null";
+			return;
+		}
+		std::format_to(std::back_inserter(m_buffer), "{}", value);
+	}
+	else if constexpr (sizeof(T) == 1) {
+		std::format_to(std::back_inserter(m_buffer), "{}", static_cast<int32_t>(value));
+	}
+	else {
+		std::format_to(std::back_inserter(m_buffer), "{}", value);
+	}
+}
+
+FORCE_INLINE void JsonEncoder::Add(const std::string_view value)
+{
+	Separate();
+	AppendEscaped(m_buffer, value);
+}
+
+FORCE_INLINE void JsonEncoder::AddNull()
+{
+	Separate();
+	m_buffer += "null";
+}
+
+FORCE_INLINE void JsonEncoder::BeginObject()
+{
+	Separate();
+	m_buffer += '{';
+	m_isSeparated = false;
+}
+
+FORCE_INLINE void JsonEncoder::Key(const std::string_view key)
+{
+	Separate();
+	AppendEscaped(m_buffer, key);
+	m_buffer += ':';
+	m_isSeparated = false;
+}
+
+FORCE_INLINE void JsonEncoder::EndObject()
+{
+	m_buffer += '}';
+	m_isSeparated = true;
+}
+
+FORCE_INLINE void JsonEncoder::BeginArray()
+{
+	Separate();
+	m_buffer += '[';
+	m_isSeparated = false;
+}
+
+FORCE_INLINE void JsonEncoder::EndArray()
+{
+	m_buffer += ']';
+	m_isSeparated = true;
+}
+
+FORCE_INLINE void JsonEncoder::Separate()
+{
+	if (m_isSeparated) {
+		m_buffer += ',';
+	}
+	m_isSeparated = true;
+}
+
+FORCE_INLINE Decoder::Decoder(const std::span<const uint8_t> buffer) noexcept
+	: m_buffer{ buffer }
+{
+}
+
+FORCE_INLINE [[nodiscard]] bool Decoder::ReadHeader(Frame& frame, std::vector<uint64_t>& uids)
+{
+	uids.clear();
+	uint8_t kind;
+	uint32_t count;
+	if (!Read(kind) || !Read(count)) [[unlikely]] {
+		return false;
+	}
+
+	if (kind == 0 || kind >= static_cast<uint8_t>(Frame::Max)) [[unlikely]] {
+		LOG_WARNING_NEW_LIMITED("Unknown binary frame kind {}", static_cast<uint32_t>(kind));
+		return false;
+	}
+
+	frame = static_cast<Frame>(kind);
+	if (frame == Frame::Batch) {
+		uids.emplace_back(count);
+		return true;
+	}
+
+	if (static_cast<size_t>(count) * sizeof(uint64_t) > m_buffer.size() - m_offset) [[unlikely]] {
+		return false;
+	}
+
+	uids.resize(count);
+	std::memcpy(uids.data(), m_buffer.data() + m_offset, count * sizeof(uint64_t));
+	m_offset += count * sizeof(uint64_t);
+	return true;
+}
+
+FORCE_INLINE [[nodiscard]] bool Decoder::ReadJson(std::string& json) { return ReadJson(json, 0); }
+
+FORCE_INLINE [[nodiscard]] bool Decoder::IsEnd() const noexcept { return m_offset == m_buffer.size(); }
+
+template <typename T> FORCE_INLINE [[nodiscard]] bool Decoder::Read(T& value) noexcept
+{
+	if (m_buffer.size() - m_offset < sizeof(T)) [[unlikely]] {
+		return false;
+	}
+
+	std::memcpy(&value, m_buffer.data() + m_offset, sizeof(T));
+	m_offset += sizeof(T);
+	return true;
+}
+
+FORCE_INLINE [[nodiscard]] bool Decoder::ReadString(std::string& json)
+{
+	uint32_t size;
+	if (!Read(size) || m_buffer.size() - m_offset < size) [[unlikely]] {
+		return false;
+	}
+
+	AppendEscaped(json, { reinterpret_cast<const char*>(m_buffer.data() + m_offset), size });
+	m_offset += size;
+	return true;
+}
+
+FORCE_INLINE [[nodiscard]] bool Decoder::ReadJson(std::string& json, const size_t depth)
+{
+	if (depth > MAX_DEPTH) [[unlikely]] {
+		LOG_WARNING_NEW_LIMITED("Binary value is nested deeper than {}", MAX_DEPTH);
+		return false;
+	}
+
+	uint8_t tag;
+	if (!Read(tag)) [[unlikely]] {
+		return false;
+	}
+
+	const auto number{ [this, &json]<typename T>(T value) {
+		if (!Read(value)) [[unlikely]] {
+			return false;
+		}
+
+		if constexpr (std::is_floating_point_v<T>) {
+			if (!std::isfinite(value)) [[unlikely]] {
+				json += "null";
+				return true;
+			}
+		}
+
+		if constexpr (std::is_same_v<T, int8_t> || std::is_same_v<T, uint8_t>) {
+			std::format_to(std::back_inserter(json), "{}", static_cast<int32_t>(value));
+		}
+		else {
+			std::format_to(std::back_inserter(json), "{}", value);
+		}
+		return true;
+	} };
+
+	using Type = StandardType::Type;
+	switch (tag) {
+	case U(Type::Undefined):
+		json += "null";
+		return true;
+	case U(Type::Int8):
+		return number(int8_t{});
+	case U(Type::Int16):
+		return number(int16_t{});
+	case U(Type::Int32):
+		return number(int32_t{});
+	case U(Type::Int64):
+		return number(int64_t{});
+	case U(Type::Uint8):
+		return number(uint8_t{});
+	case U(Type::Uint16):
+		return number(uint16_t{});
+	case U(Type::Uint32):
+		return number(uint32_t{});
+	case U(Type::Uint64):
+		return number(uint64_t{});
+	case U(Type::Float):
+		return number(float{});
+	case U(Type::Double):
+		return number(double{});
+	case U(Type::Bool): {
+		uint8_t value;
+		if (!Read(value)) [[unlikely]] {
+			return false;
+		}
+		json += value != 0 ? "true" : "false";
+		return true;
+	}
+	case U(Type::String):
+		return ReadString(json);
+	case U(Type::StringEmpty):
+		json += "\"\"";
+		return true;
+	case OBJECT_TAG: {
+		uint32_t count;
+		if (!Read(count)) [[unlikely]] {
+			return false;
+		}
+
+		json += '{';
+		for (uint32_t index{}; index < count; ++index) {
+			if (index != 0) {
+				json += ',';
+			}
+			if (!ReadString(json)) [[unlikely]] {
+				return false;
+			}
+			json += ':';
+			if (!ReadJson(json, depth + 1)) [[unlikely]] {
+				return false;
+			}
+		}
+		json += '}';
+		return true;
+	}
+	case ARRAY_TAG: {
+		uint32_t count;
+		if (!Read(count)) [[unlikely]] {
+			return false;
+		}
+
+		json += '[';
+		for (uint32_t index{}; index < count; ++index) {
+			if (index != 0) {
+				json += ',';
+			}
+			if (!ReadJson(json, depth + 1)) [[unlikely]] {
+				return false;
+			}
+		}
+		json += ']';
+		return true;
+	}
+	default:
+		LOG_WARNING_NEW_LIMITED("Unknown binary value tag {}", static_cast<uint32_t>(tag));
+		return false;
+	}
+}
+
+} // namespace Binary
+
+} // namespace Events
+
+} // namespace WebSocket
+
+} // namespace Protocol
+
+} // namespace MSAPI
+
+#endif // MSAPI_PROTOCOL_WEBSOCKET_EVENTS_BINARY_INL
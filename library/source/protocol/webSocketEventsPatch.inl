@@ -0,0 +1,367 @@
+/**************************
+ * @file        webSocketEventsPatch.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ *
+ * @brief Structural difference of json documents in format of JSON Patch (RFC 6902) subset with add, replace and
+ * remove operations. Paths are JSON Pointers (RFC 6901). Objects are compared by keys, arrays are compared by indexes,
+ * so insertion into the middle of array is represented by replacing of tail elements.
+ */
+
+#ifndef MSAPI_PROTOCOL_WEBSOCKET_EVENTS_PATCH_INL
+#define MSAPI_PROTOCOL_WEBSOCKET_EVENTS_PATCH_INL
+
+#include "../help/json.h"
+#include <bit>
+#include <format>
+
+namespace MSAPI {
+
+namespace Protocol {
+
+namespace WebSocket {
+
+namespace Events {
+
+namespace Patch {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**
+ * @return True if json nodes have same types and values, doubles are compared bitwise.
+ *
+ * @test Has unit test.
+ */
+FORCE_INLINE [[nodiscard]] bool Equal(const JsonNode& first, const JsonNode& second);
+
+/**
+ * @return True if json objects have same keys with equal values.
+ *
+ * @test Has unit test.
+ */
+FORCE_INLINE [[nodiscard]] bool Equal(const Json& first, const Json& second);
+
+/**
+ * @brief Append json text of the node. Strings are kept in escaped form as they are stored by json parser.
+ *
+ * @param out Destination.
+ * @param node Json node.
+ *
+ * @test Has unit test.
+ */
+FORCE_INLINE void AppendJson(std::string& out, const JsonNode& node);
+
+/**
+ * @brief Append json text of the object.
+ *
+ * @param out Destination.
+ * @param json Json object.
+ *
+ * @test Has unit test.
+ */
+FORCE_INLINE void AppendJson(std::string& out, const Json& json);
+
+/**
+ * @brief Make patch which transforms one json object into another.
+ *
+ * @param patch Destination of json array with operations, is left empty if documents are equal.
+ * @param from Previous document.
+ * @param to Current document.
+ *
+ * @return Number of operations.
+ *
+ * @test Has unit test.
+ */
+FORCE_INLINE size_t Make(std::string& patch, const Json& from, const Json& to);
+
+/**
+ * @brief Append difference of json objects as patch operations under the path.
+ *
+ * @param patch Destination of comma separated operations.
+ * @param path JSON Pointer of compared objects, is restored on return.
+ * @param from Previous object.
+ * @param to Current object.
+ * @param count Number of appended operations.
+ *
+ * @attention Is recursive with diff of nodes, so it is not forced to be inlined.
+ */
+inline void AppendDiff(std::string& patch, std::string& path, const Json& from, const Json& to, size_t& count);
+
+/**
+ * @brief Append difference of json nodes as patch operations under the path.
+ *
+ * @param patch Destination of comma separated operations.
+ * @param path JSON Pointer of compared nodes, is restored on return.
+ * @param from Previous node.
+ * @param to Current node.
+ * @param count Number of appended operations.
+ */
+inline void AppendDiff(
+	std::string& patch, std::string& path, const JsonNode& from, const JsonNode& to, size_t& count);
+
+/**
+ * @brief Append one operation.
+ *
+ * @param patch Destination of comma separated operations.
+ * @param operation Name of operation.
+ * @param path JSON Pointer of target.
+ * @param value Value for add and replace operations, nullptr for remove operation.
+ * @param count Number of appended operations.
+ */
+FORCE_INLINE void AppendOperation(std::string& patch, std::string_view operation, std::string_view path,
+	const JsonNode* value, size_t& count);
+
+/**
+ * @brief Append key as JSON Pointer reference token, '~' and '/' are escaped.
+ *
+ * @param path JSON Pointer.
+ * @param key Key of object.
+ */
+FORCE_INLINE void AppendToken(std::string& path, std::string_view key);
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+FORCE_INLINE [[nodiscard]] bool Equal(const JsonNode& first, const JsonNode& second)
+{
+	const auto& firstValue{ first.GetValue() };
+	const auto& secondValue{ second.GetValue() };
+	if (firstValue.index() != secondValue.index()) {
+		return false;
+	}
+
+	return std::visit(
+		[&secondValue](const auto& value) {
+			using T = std::decay_t<decltype(value)>;
+			const auto& other{ *std::get_if<T>(&secondValue) };
+			if constexpr (std::is_same_v<T, Json>) {
+				return Equal(value, other);
+			}
+			else if constexpr (std::is_same_v<T, std::list<JsonNode>>) {
+				return std::ranges::equal(
+					value, other, [](const JsonNode& a, const JsonNode& b) { return Equal(a, b); });
+			}
+			else if constexpr (std::is_same_v<T, double>) {
+				return std::bit_cast<uint64_t>(value) == std::bit_cast<uint64_t>(other);
+			}
+			else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+				return true;
+			}
+			else {
+				return value == other;
+			}
+		},
+		firstValue);
+}
+
+FORCE_INLINE [[nodiscard]] bool Equal(const Json& first, const Json& second)
+{
+	return std::ranges::equal(first.GetKeysAndValues(), second.GetKeysAndValues(),
+		[](const auto& a, const auto& b) { return a.first == b.first && Equal(a.second, b.second); });
+}
+
+FORCE_INLINE void AppendJson(std::string& out, const JsonNode& node)
+{
+	std::visit(
+		[&out](const auto& value) {
+			using T = std::decay_t<decltype(value)>;
+			if constexpr (std::is_same_v<T, Json>) {
+				AppendJson(out, value);
+			}
+			else if constexpr (std::is_same_v<T, std::list<JsonNode>>) {
+				out += '[';
+				for (const auto& item : value) {
+					AppendJson(out, item);
+					out += ',';
+				}
+				if (out.back() == ',') {
+					out.back() = ']';
+				}
+				else {
+					out += ']';
+				}
+			}
+			else if constexpr (std::is_same_v<T, std::string>) {
+				out += '"';
+				out += value;
+				out += '"';
+			}
+			else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+				out += "null";
+			}
+			else {
+				std::format_to(std::back_inserter(out), "{}", value);
+			}
+		},
+		node.GetValue());
+}
+
+FORCE_INLINE void AppendJson(std::string& out, const Json& json)
+{
+	out += '{';
+	for (const auto& [key, value] : json.GetKeysAndValues()) {
+		out += '"';
+		out += key;
+		out += "\":";
+		AppendJson(out, value);
+		out += ',';
+	}
+	if (out.back() == ',') {
+		out.back() = '}';
+	}
+	else {
+		out += '}';
+	}
+}
+
+FORCE_INLINE size_t Make(std::string& patch, const Json& from, const Json& to)
+{
+	size_t count{};
+	std::string path;
+	patch += '[';
+	AppendDiff(patch, path, from, to, count);
+	if (count == 0) {
+		patch.pop_back();
+		return 0;
+	}
+
+	patch += ']';
+	return count;
+}
+
+inline void AppendDiff(std::string& patch, std::string& path, const Json& from, const Json& to, size_t& count)
+{
+	const auto& previous{ from.GetKeysAndValues() };
+	const auto& current{ to.GetKeysAndValues() };
+	const auto pathSize{ path.size() };
+
+	// Both maps are ordered by key, so they are merged in one pass
+	auto previousIt{ previous.begin() };
+	auto currentIt{ current.begin() };
+	while (previousIt != previous.end() || currentIt != current.end()) {
+		if (currentIt == current.end() || (previousIt != previous.end() && previousIt->first < currentIt->first)) {
+			AppendToken(path, previousIt->first);
+			AppendOperation(patch, "remove", path, nullptr, count);
+			++previousIt;
+		}
+		else if (previousIt == previous.end() || currentIt->first < previousIt->first) {
+			AppendToken(path, currentIt->first);
+			AppendOperation(patch, "add", path, &currentIt->second, count);
+			++currentIt;
+		}
+		else {
+			AppendToken(path, currentIt->first);
+			AppendDiff(patch, path, previousIt->second, currentIt->second, count);
+			++previousIt;
+			++currentIt;
+		}
+		path.resize(pathSize);
+	}
+}
+
+inline void AppendDiff(
+	std::string& patch, std::string& path, const JsonNode& from, const JsonNode& to, size_t& count)
+{
+	const auto& previous{ from.GetValue() };
+	const auto& current{ to.GetValue() };
+
+	if (const auto* previousObject{ std::get_if<Json>(&previous) }; previousObject != nullptr) {
+		if (const auto* currentObject{ std::get_if<Json>(&current) }; currentObject != nullptr) {
+			AppendDiff(patch, path, *previousObject, *currentObject, count);
+			return;
+		}
+	}
+	else if (const auto* previousArray{ std::get_if<std::list<JsonNode>>(&previous) }; previousArray != nullptr) {
+		if (const auto* currentArray{ std::get_if<std::list<JsonNode>>(&current) }; currentArray != nullptr) {
+			const auto pathSize{ path.size() };
+			size_t index{};
+			auto previousIt{ previousArray->begin() };
+			auto currentIt{ currentArray->begin() };
+			for (; previousIt != previousArray->end() && currentIt != currentArray->end();
+				++previousIt, ++currentIt, ++index) {
+
+				std::format_to(std::back_inserter(path), "/{}", index);
+				AppendDiff(patch, path, *previousIt, *currentIt, count);
+				path.resize(pathSize);
+			}
+
+			for (; currentIt != currentArray->end(); ++currentIt, ++index) {
+				std::format_to(std::back_inserter(path), "/{}", index);
+				AppendOperation(patch, "add", path, &*currentIt, count);
+				path.resize(pathSize);
+			}
+
+			// Tail is removed from the end, so indexes of following operations stay valid
+			for (auto removed{ previousArray->size() }; removed > index; --removed) {
+				std::format_to(std::back_inserter(path), "/{}", removed - 1);
+				AppendOperation(patch, "remove", path, nullptr, count);
+				path.resize(pathSize);
+			}
+			return;
+		}
+	}
+
+	if (!Equal(from, to)) {
+		AppendOperation(patch, "replace", path, &to, count);
+	}
+}
+
+FORCE_INLINE void AppendOperation(std::string& patch, const std::string_view operation, const std::string_view path,
+	const JsonNode* const value, size_t& count)
+{
+	if (count != 0) {
+		patch += ',';
+	}
+	++count;
+
+	std::format_to(std::back_inserter(patch), "{{\"op\":\"{}\",\"path\":\"{}\"", operation, path);
+	if (value != nullptr) {
+		patch += ",\"value\":";
+		AppendJson(patch, *value);
+	}
+	patch += '}';
+}
+
+FORCE_INLINE void AppendToken(std::string& path, const std::string_view key)
+{
+	path += '/';
+	for (const char symbol : key) {
+		if (symbol == '~') {
+			path += "~0";
+		}
+		else if (symbol == '/') {
+			path += "~1";
+		}
+		else {
+			path += symbol;
+		}
+	}
+}
+
+} // namespace Patch
+
+} // namespace Events
+
+} // namespace WebSocket
+
+} // namespace Protocol
+
+} // namespace MSAPI
+
+#endif // MSAPI_PROTOCOL_WEBSOCKET_EVENTS_PATCH_INL
@@ -1017,7 +1017,7 @@ void Application::HandleRunRequest() { LOG_PROTOCOL("Action is skipped"); }
 
 void Application::HandlePauseRequest() { LOG_PROTOCOL("Action is skipped"); }
 
-void Application::HandleModifyRequest(const std::map<size_t, std::variant<standardTypes>>& parametersUpdate)
+void Application::HandleModifyRequest(const Protocol::Standard::data_t& parametersUpdate)
 {
 	LOG_PROTOCOL("Default merge parameters action");
 	MergeParameters(parametersUpdate);
@@ -1034,7 +1034,7 @@ void Application::HandleMetadata(
 }
 
 void Application::HandleParameters([[maybe_unused]] const int connection,
-	[[maybe_unused]] const std::map<size_t, std::variant<standardTypes>>& parameters)
+	[[maybe_unused]] const Protocol::Standard::data_t& parameters)
 {
 	LOG_PROTOCOL("Action is skipped");
 }
@@ -1133,7 +1133,7 @@ void Application::RegisterConstParameter(const size_t id, ConstParameter&& param
 	LOG_WARNING("Const parameter " + parameter.m_name + "(" + _S(id) + ") already exists, registration is skipped");
 }
 
-void Application::MergeParameters(const std::map<size_t, std::variant<standardTypes>>& parametersUpdate)
+void Application::MergeParameters(const Protocol::Standard::data_t& parametersUpdate)
 {
 	for (const auto& [id, value] : parametersUpdate) {
 		MergeParameter(id, value);
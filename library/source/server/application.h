@@ -494,7 +494,7 @@ public:
 	 *
 	 * @test Has unit tests.
 	 */
-	virtual void HandleModifyRequest(const std::map<size_t, std::variant<standardTypes>>& parametersUpdate);
+	virtual void HandleModifyRequest(const Protocol::Standard::data_t& parametersUpdate);
 
 	/**************************
 	 * @brief Handle delete request from External application. Already defined in Server class, but can be
@@ -534,7 +534,7 @@ public:
 	 *
 	 * @test Has unit tests.
 	 */
-	virtual void HandleParameters(int connection, const std::map<size_t, std::variant<standardTypes>>& parameters);
+	virtual void HandleParameters(int connection, const Protocol::Standard::data_t& parameters);
 
 	/**************************
 	 * @brief Not network signal about previously opened connection by id was closed no by server. Already defined
@@ -712,7 +712,7 @@ protected:
 	 *
 	 * @test Has unit tests for all types.
 	 */
-	void MergeParameters(const std::map<size_t, std::variant<standardTypes>>& parametersUpdate);
+	void MergeParameters(const Protocol::Standard::data_t& parametersUpdate);
 
 	/**************************
 	 * @brief Merge parameter to application, manage container of parameters with error. Print warning log if
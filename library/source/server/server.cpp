@@ -61,7 +61,7 @@ void Server::HandleRunRequest() { MSAPI_HANDLE_RUN_REQUEST_PRESET; }
 
 void Server::HandlePauseRequest() { MSAPI_HANDLE_PAUSE_REQUEST_PRESET; }
 
-void Server::HandleModifyRequest(const std::map<size_t, std::variant<standardTypes>>& parametersUpdate)
+void Server::HandleModifyRequest(const Protocol::Standard::data_t& parametersUpdate)
 {
 	MSAPI_HANDLE_MODIFY_REQUEST_PRESET
 }
@@ -467,7 +467,8 @@ bool Server::IsConnectionAllowed(const int id, const std::string& ip)
 	return true;
 }
 
-bool Server::OpenConnect(const int id, const in_addr_t ip, const in_port_t port, const bool needReconnection)
+bool Server::OpenConnect(
+	const int id, const in_addr_t ip, const in_port_t port, const bool needReconnection, const size_t attempts)
 {
 	if (m_state == State::Stopped) [[unlikely]] {
 		LOG_INFO("Connecting process is interrupted, because of server is stopped, id: " + _S(id)
@@ -490,17 +491,20 @@ bool Server::OpenConnect(const int id, const in_addr_t ip, const in_port_t port,
 		return false;
 	}
 
+	const size_t limitConnectAttempts{ attempts == 0 ? m_limitConnectAttempts : attempts };
 	size_t attempt{ 1 };
 	while (!Connect(newConnection, &addr)) {
-		std::this_thread::sleep_for(std::chrono::seconds(m_secondsBetweenTryToConnect));
-		if (attempt++ >= m_limitConnectAttempts) {
-			LOG_WARNING("Limit of connect attempts (" + _S(m_limitConnectAttempts) + ") is reached, id: " + _S(id)
+		if (attempt++ >= limitConnectAttempts) {
+			LOG_WARNING("Limit of connect attempts (" + _S(limitConnectAttempts) + ") is reached, id: " + _S(id)
 				+ ", port: " + _S(static_cast<uint>(port)));
+			(void)close(newConnection);
 			return false;
 		}
+		std::this_thread::sleep_for(std::chrono::seconds(m_secondsBetweenTryToConnect));
 		if (m_state == State::Stopped) {
 			LOG_INFO("Connecting process is interrupted, because of server is stopped, id: " + _S(id)
 				+ ", port: " + _S(static_cast<uint>(port)));
+			(void)close(newConnection);
 			return false;
 		}
 	}
@@ -601,7 +605,7 @@ void Server::CloseConnect(ConnectionInfo& info)
                                                                                                                        \
 	if (result == -1) [[unlikely]] {                                                                                   \
 		if (errno == EAGAIN || errno == EWOULDBLOCK) {                                                                 \
-			LOG_PROTOCOL(                                                                                              \
+			LOG_PROTOCOL_LIMITED(                                                                                      \
 				"Non-blocking operation returned EAGAIN or EWOULDBLOC, connection id: " + _S(recvBufferInfo->id));     \
 			return false;                                                                                              \
 		}                                                                                                              \
@@ -671,7 +675,7 @@ bool Server::ReadAdditionalData(RecvBufferInfo* recvBufferInfo, const size_t buf
 		}
 
 		if (bytesAvailable == 0) [[likely]] {
-			LOG_WARNING("No data available, id: " + _S(recvBufferInfo->id));
+			LOG_WARNING_LIMITED("No data available, id: " + _S(recvBufferInfo->id));
 			return false;
 		}
 
@@ -714,7 +718,7 @@ bool Server::LookForAdditionalData(RecvBufferInfo* recvBufferInfo, size_t& buffe
 		}
 
 		if (bytesAvailable == 0) [[likely]] {
-			LOG_WARNING("No data available, id: " + _S(recvBufferInfo->id));
+			LOG_WARNING_LIMITED("No data available, id: " + _S(recvBufferInfo->id));
 			return false;
 		}
 
@@ -207,9 +207,9 @@ private:
 	enum class RecvProcessingType : short { Outcome, Income, Manager };
 
 private:
-	Pthread::AtomicLock m_closingConnectionLocks;
-	Pthread::AtomicLock m_serverAcceptingLoop;
-	Pthread::AtomicRWLock m_alivePthreadsRWLock;
+	Pthread::AtomicLock m_closingConnectionLocks{ "Server::closingConnection" };
+	Pthread::AtomicLock m_serverAcceptingLoop{ "Server::acceptingLoop" };
+	Pthread::AtomicRWLock m_alivePthreadsRWLock{ "Server::alivePthreads" };
 	State m_state{ State::Initialization };
 	sockaddr_in m_addr{ 0, 0, 0, 0 };
 	in_port_t m_listeningPort{};
@@ -247,7 +247,7 @@ public:
 	//* Application
 	void HandleRunRequest() override;
 	void HandlePauseRequest() override;
-	void HandleModifyRequest(const std::map<size_t, std::variant<standardTypes>>& parametersUpdate) override;
+	void HandleModifyRequest(const Protocol::Standard::data_t& parametersUpdate) override;
 	void HandleDeleteRequest() override;
 
 	/**************************
@@ -307,10 +307,11 @@ public:
 	 * @param ip IP address to connect.
 	 * @param port Port to connect.
 	 * @param needReconnection If true, server will try to reconnect if connection was closed.
+	 * @param attempts Limit of connect attempts, 0 to use parameter "Limit of attempts to connection".
 	 *
 	 * @return True if connection was opened, false otherwise.
 	 */
-	bool OpenConnect(int id, in_addr_t ip, in_port_t port, bool needReconnection = true);
+	bool OpenConnect(int id, in_addr_t ip, in_port_t port, bool needReconnection = true, size_t attempts = 0);
 
 	/**************************
 	 * @brief Check if connection by id is open.
@@ -387,7 +388,7 @@ public:
 
 			if (requestSize == -1) [[unlikely]] {
 				if (errno == EAGAIN || errno == EWOULDBLOCK) {
-					LOG_PROTOCOL("Non-blocking operation returned EAGAIN or EWOULDBLOC, "
+					LOG_PROTOCOL_LIMITED("Non-blocking operation returned EAGAIN or EWOULDBLOC, "
 						+ RecvProcessingTypeToString_v<Type> + " connection id: " + _S(id));
 					continue;
 				}
@@ -24,7 +24,7 @@ namespace MSAPI {
 Test::~Test()
 {
 	if (m_counter > 0) {
-		const auto nanoseconds{ Timer::Duration{ Timer{} - m_totalTimer }.GetNanoseconds() };
+		const auto nanoseconds{ FastClock::GetElapsed(m_totalBegin) };
 		if (m_passedCounter == m_counter) {
 			LOG_INFO_NEW("All assertions counter: {}, passed: {}. {}Passed{}, elapsed wall time: {} ns", m_counter,
 				m_passedCounter, GREEN_BEGIN, COLOR_END, nanoseconds);
@@ -65,8 +65,9 @@ class Test {
 private:
 	int32_t m_counter{};
 	int32_t m_passedCounter{};
-	Timer m_timer;
-	Timer m_totalTimer;
+	//* Ticks of fast clock at the end of previous assertion and at creation
+	int64_t m_begin{ FastClock::GetTicks() };
+	int64_t m_totalBegin{ m_begin };
 
 	static constexpr std::string_view m_patternPassed{ "\033[0;32mPASSED: \033[0m{}. {} ns" };
 	static constexpr std::string_view m_patternFailed{ "\033[0;31mFAILED: \033[0m{}. Actual: {}. Expected: {}. {} ns" };
@@ -125,15 +126,14 @@ public:
 			if (static_cast<G>(actual) == static_cast<G>(expected)) [[likely]] {
 
 #define TMP_MSAPI_TEST_ASSERT_SUCCESS                                                                                  \
-	LOG_INFO_NEW(m_patternPassed, name, Timer::Duration{ Timer{} - m_timer }.GetNanoseconds());                        \
-	m_timer.Reset();                                                                                                   \
+	LOG_INFO_NEW(m_patternPassed, name, FastClock::GetElapsed(m_begin));                                               \
+	m_begin = FastClock::GetTicks();                                                                                   \
 	++m_passedCounter;                                                                                                 \
 	return true;
 
 				TMP_MSAPI_TEST_ASSERT_SUCCESS;
 			}
-			LOG_INFO_NEW(
-				m_patternFailed, name, _S(actual), _S(expected), Timer::Duration{ Timer{} - m_timer }.GetNanoseconds());
+			LOG_INFO_NEW(m_patternFailed, name, _S(actual), _S(expected), FastClock::GetElapsed(m_begin));
 		}
 		else if constexpr (is_integer_type_optional<N>) {
 			if (const bool valuesPresented{ actual.has_value() && expected.has_value() };
@@ -141,15 +141,13 @@ public:
 
 				TMP_MSAPI_TEST_ASSERT_SUCCESS;
 			}
-			LOG_INFO_NEW(
-				m_patternFailed, name, _S(actual), _S(expected), Timer::Duration{ Timer{} - m_timer }.GetNanoseconds());
+			LOG_INFO_NEW(m_patternFailed, name, _S(actual), _S(expected), FastClock::GetElapsed(m_begin));
 		}
 		else if constexpr (is_float_type<N>) {
 			if (MSAPI::Helper::FloatEqual(static_cast<G>(actual), static_cast<G>(expected))) [[likely]] {
 				TMP_MSAPI_TEST_ASSERT_SUCCESS;
 			}
-			LOG_INFO_NEW(
-				m_patternFailed, name, _S(actual), _S(expected), Timer::Duration{ Timer{} - m_timer }.GetNanoseconds());
+			LOG_INFO_NEW(m_patternFailed, name, _S(actual), _S(expected), FastClock::GetElapsed(m_begin));
 		}
 		else if constexpr (is_float_type_optional<N>) {
 			if (const bool valuesPresented{ actual.has_value() && expected.has_value() }; !valuesPresented
@@ -158,15 +156,13 @@ public:
 
 				TMP_MSAPI_TEST_ASSERT_SUCCESS;
 			}
-			LOG_INFO_NEW(
-				m_patternFailed, name, _S(actual), _S(expected), Timer::Duration{ Timer{} - m_timer }.GetNanoseconds());
+			LOG_INFO_NEW(m_patternFailed, name, _S(actual), _S(expected), FastClock::GetElapsed(m_begin));
 		}
 		else if constexpr (std::is_same_v<N, std::string> || std::is_same_v<N, std::string_view>) {
 			if (actual == expected) [[likely]] {
 				TMP_MSAPI_TEST_ASSERT_SUCCESS;
 			}
-			LOG_INFO_NEW(
-				m_patternFailed, name, actual, expected, Timer::Duration{ Timer{} - m_timer }.GetNanoseconds());
+			LOG_INFO_NEW(m_patternFailed, name, actual, expected, FastClock::GetElapsed(m_begin));
 		}
 		else if constexpr (std::is_same_v<N, std::wstring> || std::is_same_v<N, std::wstring_view>) {
 			if (actual == expected) [[likely]] {
@@ -187,33 +183,29 @@ public:
 			else {
 				expectedString = Helper::WstringToString(std::wstring{ expected }.c_str());
 			}
-			LOG_INFO_NEW(m_patternFailed, name, actualString, expectedString,
-				Timer::Duration{ Timer{} - m_timer }.GetNanoseconds());
+			LOG_INFO_NEW(m_patternFailed, name, actualString, expectedString, FastClock::GetElapsed(m_begin));
 		}
 		else if constexpr (std::is_same_v<N, MSAPI::Timer> || std::is_same_v<N, MSAPI::Timer::Duration>) {
 			if (actual == expected) [[likely]] {
 				TMP_MSAPI_TEST_ASSERT_SUCCESS;
 			}
-			LOG_INFO_NEW(m_patternFailed, name, actual.ToString(), expected.ToString(),
-				Timer::Duration{ Timer{} - m_timer }.GetNanoseconds());
+			LOG_INFO_NEW(m_patternFailed, name, actual.ToString(), expected.ToString(), FastClock::GetElapsed(m_begin));
 		}
 		else if constexpr (has_to_string<T> && has_to_string<S>) {
 			if (actual == expected) [[likely]] {
 				TMP_MSAPI_TEST_ASSERT_SUCCESS;
 			}
-			LOG_INFO_NEW(m_patternFailed, name, actual.ToString(), expected.ToString(),
-				Timer::Duration{ Timer{} - m_timer }.GetNanoseconds());
+			LOG_INFO_NEW(m_patternFailed, name, actual.ToString(), expected.ToString(), FastClock::GetElapsed(m_begin));
 		}
 		else {
 			if (actual == expected) [[likely]] {
 				TMP_MSAPI_TEST_ASSERT_SUCCESS;
 #undef TMP_MSAPI_TEST_ASSERT_SUCCESS
 			}
-			LOG_INFO_NEW(m_patternFailed, name, "<unprintable>", "<unprintable>",
-				Timer::Duration{ Timer{} - m_timer }.GetNanoseconds());
+			LOG_INFO_NEW(m_patternFailed, name, "<unprintable>", "<unprintable>", FastClock::GetElapsed(m_begin));
 		}
 
-		m_timer.Reset();
+		m_begin = FastClock::GetTicks();
 		return false;
 	}
 
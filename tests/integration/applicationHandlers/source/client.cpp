@@ -110,7 +110,7 @@ void Client::HandlePauseRequest()
 	MSAPI::ActionsCounter::IncrementActionsNumber();
 }
 
-void Client::HandleModifyRequest(const std::map<size_t, std::variant<standardTypes>>& parametersUpdate)
+void Client::HandleModifyRequest(const MSAPI::Protocol::Standard::data_t& parametersUpdate)
 {
 	MSAPI::Application::MergeParameters(parametersUpdate);
 	if (!MSAPI::Application::AreParametersValid()) {
@@ -132,7 +132,7 @@ void Client::HandleMetadata(const int connection, [[maybe_unused]] const std::st
 }
 
 void Client::HandleParameters(
-	const int connection, [[maybe_unused]] const std::map<size_t, std::variant<standardTypes>>& parameters)
+	const int connection, [[maybe_unused]] const MSAPI::Protocol::Standard::data_t& parameters)
 {
 	LOG_ERROR("Unexpected parameters received from connection: " + _S(connection));
 	MSAPI::ActionsCounter::IncrementActionsNumber();
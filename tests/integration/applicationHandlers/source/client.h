@@ -90,10 +90,10 @@ public:
 	//* MSAPI::Application
 	void HandleRunRequest() final;
 	void HandlePauseRequest() final;
-	void HandleModifyRequest(const std::map<size_t, std::variant<standardTypes>>& parametersUpdate) final;
+	void HandleModifyRequest(const MSAPI::Protocol::Standard::data_t& parametersUpdate) final;
 	void HandleHello(int connection) final;
 	void HandleMetadata(int connection, std::string_view metadata) final;
-	void HandleParameters(int connection, const std::map<size_t, std::variant<standardTypes>>& parameters) final;
+	void HandleParameters(int connection, const MSAPI::Protocol::Standard::data_t& parameters) final;
 	void HandleIncomeDisconnect(int32_t id, int32_t connection) final;
 
 	int8_t GetParameter1() const noexcept;
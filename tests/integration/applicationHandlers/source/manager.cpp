@@ -45,8 +45,7 @@ void Manager::HandleRunRequest()
 
 void Manager::HandlePauseRequest() { MSAPI::ActionsCounter::IncrementActionsNumber(); }
 
-void Manager::HandleModifyRequest(
-	[[maybe_unused]] const std::map<size_t, std::variant<standardTypes>>& parametersUpdate)
+void Manager::HandleModifyRequest([[maybe_unused]] const MSAPI::Protocol::Standard::data_t& parametersUpdate)
 {
 	LOG_ERROR("Unexpected modify request received");
 	MSAPI::ActionsCounter::IncrementActionsNumber();
@@ -77,7 +76,7 @@ void Manager::HandleMetadata(const int connection, const std::string_view metada
 	MSAPI::ActionsCounter::IncrementActionsNumber();
 }
 
-void Manager::HandleParameters(const int connection, const std::map<size_t, std::variant<standardTypes>>& parameters)
+void Manager::HandleParameters(const int connection, const MSAPI::Protocol::Standard::data_t& parameters)
 {
 	if (connection != m_clientConnection) {
 		LOG_ERROR("Parameters response from unknown connection: " + _S(connection));
@@ -201,7 +200,7 @@ std::string Manager::GetParameters() const
 
 const std::string& Manager::GetMetadata() const noexcept { return m_metadata; }
 
-const std::map<size_t, std::variant<standardTypes>>& Manager::GetParametersResponse() const noexcept
+const MSAPI::Protocol::Standard::data_t& Manager::GetParametersResponse() const noexcept
 {
 	return m_parametersResponse;
 }
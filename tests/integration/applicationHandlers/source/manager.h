@@ -32,7 +32,7 @@ private:
 	int m_outcomeConnection{ -1 };
 	int m_activeConnection{ -1 };
 	std::string m_metadata;
-	std::map<size_t, std::variant<standardTypes>> m_parametersResponse;
+	MSAPI::Protocol::Standard::data_t m_parametersResponse;
 	MSAPI::ActionsCounter m_unhandledActions;
 
 	static constexpr size_t helloForHelloCipher{ 59837493028 };
@@ -43,10 +43,10 @@ public:
 	//* MSAPI::Application
 	void HandleRunRequest() final;
 	void HandlePauseRequest() final;
-	void HandleModifyRequest(const std::map<size_t, std::variant<standardTypes>>& parametersUpdate) final;
+	void HandleModifyRequest(const MSAPI::Protocol::Standard::data_t& parametersUpdate) final;
 	void HandleHello(int connection) final;
 	void HandleMetadata(int connection, std::string_view metadata) final;
-	void HandleParameters(int connection, const std::map<size_t, std::variant<standardTypes>>& parameters) final;
+	void HandleParameters(int connection, const MSAPI::Protocol::Standard::data_t& parameters) final;
 	void HandleIncomeDisconnect(int32_t id, int32_t connection) final;
 
 	void UseOutcomeConnection();
@@ -62,7 +62,7 @@ public:
 	void SendParametersResponse();
 	std::string GetParameters() const;
 	const std::string& GetMetadata() const noexcept;
-	const std::map<size_t, std::variant<standardTypes>>& GetParametersResponse() const noexcept;
+	const MSAPI::Protocol::Standard::data_t& GetParametersResponse() const noexcept;
 	void Stop();
 	const size_t& GetUnhandledActions() const noexcept;
 	void WaitUnhandledActions(const MSAPI::Test& test, size_t delay, size_t expected);
@@ -35,7 +35,7 @@ void HTTPServer::HandleBuffer(MSAPI::RecvBufferInfo* recvBufferInfo)
 	LOG_ERROR("Unknown protocol: " + header.ToString());
 }
 
-void HTTPServer::HandleModifyRequest(const std::map<size_t, std::variant<standardTypes>>& parametersUpdate)
+void HTTPServer::HandleModifyRequest(const MSAPI::Protocol::Standard::data_t& parametersUpdate)
 {
 	MSAPI::Application::MergeParameters(parametersUpdate);
 
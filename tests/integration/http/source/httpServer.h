@@ -38,7 +38,7 @@ public:
 	//* MSAPI::Server
 	void HandleBuffer(MSAPI::RecvBufferInfo* recvBufferInfo) final;
 	//* MSAPI::Application
-	void HandleModifyRequest(const std::map<size_t, std::variant<standardTypes>>& parametersUpdate) final;
+	void HandleModifyRequest(const MSAPI::Protocol::Standard::data_t& parametersUpdate) final;
 	//* MSAPI::Protocol::HTTP::IHandler
 	void HandleHttp(int connection, const MSAPI::Protocol::HTTP::Data& data) final;
 
@@ -25,10 +25,14 @@
 #include "../../../../library/source/help/log.h"
 
 struct FilterStructure {
+	static constexpr std::string_view objectTypeName{ "FilterStructure" };
+
 	size_t figi;
 };
 
 struct InstrumentStructure {
+	static constexpr std::string_view objectTypeName{ "InstrumentStructure" };
+
 	enum class InstrumentStructureType : short { Undefined, First, Second, Third, Fourth, Max };
 
 	struct Nominal {
@@ -115,10 +119,14 @@ struct InstrumentStructure {
 			limitOrderAvailable, marketOrderAvailable);
 	}
 
+	uint64_t GetObjectId() const noexcept { return figi; }
+
 	friend bool operator<(const InstrumentStructure& f, const InstrumentStructure& s) { return f.figi < s.figi; }
 };
 
 struct OrderStructure {
+	static constexpr std::string_view objectTypeName{ "OrderStructure" };
+
 	size_t figi;
 	double price;
 	uint32_t quantity;
@@ -137,6 +145,8 @@ struct OrderStructure {
 		return stream.str();
 	}
 
+	uint64_t GetObjectId() const noexcept { return figi; }
+
 	friend bool operator<(const OrderStructure& f, const OrderStructure& s) { return f.figi < s.figi; }
 };
 
@@ -22,6 +22,7 @@
 #include "../../../../library/source/test/test.h"
 #include "objectClient.h"
 #include "objectDistributor.h"
+#include "objectRelay.h"
 #include <memory>
 #include <sys/mman.h>
 #include <sys/resource.h>
@@ -473,6 +474,157 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 	//* Check actions number
 	test.Assert(actions, size_t{ 10 }, "Client's actions number is still 10");
 
+	//* Setup for replay steps
+	client->Clear();
+	test.Assert(distributor->EnableOrderReplay(2), true, "Order replay is enabled");
+	test.Assert(distributor->EnableOrderReplay(2), false, "Order replay cannot be enabled twice");
+	client->GetOrderStream().SetFilter(filter6);
+	test.Assert(client->GetOrderStream().GetLastSequence(), uint64_t{ 0 }, "Order stream last sequence is reset");
+	client->GetOrderStream().Open();
+
+	//* Waiting for HandleStreamSnapshotDone
+	client->WaitActionsNumber(test, 5000, 5 /* opened + 3 orders + done */);
+	test.Assert(actions, size_t{ 5 }, "Client's actions number is 5");
+	test.Assert(client->GetOrders().size(), size_t{ 3 }, "Client got three orders");
+	test.Assert(distributor->GetDistributorEpoch() != 0, true, "Distributor epoch is set");
+	test.Assert(client->GetOrderStream().GetEpoch(), distributor->GetDistributorEpoch(),
+		"Order stream got distributor epoch on opening");
+
+	//* Live order is sequenced
+	distributor->SetOrder(order2);
+	client->WaitActionsNumber(test, 5000, 6);
+	test.Assert(actions, size_t{ 6 }, "Client's actions number is 6");
+	test.Assert(client->GetOrderStream().GetLastSequence(), uint64_t{ 1 }, "Order stream last sequence is 1");
+
+	//* Close stream and miss two orders
+	client->GetOrderStream().Close();
+	client->WaitActionsNumber(test, 5000);
+	test.Assert(static_cast<short>(client->GetOrderStream().GetState()),
+		static_cast<short>(MSAPI::Protocol::Object::State::Closed), "Order stream state is closed");
+	distributor->SetOrder(order3);
+	distributor->SetOrder(order4);
+
+	//* Reopen stream, only missed orders are replayed
+	client->Clear();
+	client->GetOrderStream().Open();
+	client->WaitActionsNumber(test, 5000, 4 /* opened + 2 missed orders + done */);
+	test.Assert(actions, size_t{ 4 }, "Client's actions number is 4");
+	test.Assert(client->GetOrders().size(), size_t{ 2 }, "Client got two missed orders");
+	test.Assert(client->HasOrder(order3), true, "Client got missed order №3");
+	test.Assert(client->HasOrder(order4), true, "Client got missed order №4");
+	test.Assert(client->HasOrder(order2), false, "Client did not get order №2 again");
+	test.Assert(client->GetOrderStream().GetLastSequence(), uint64_t{ 3 }, "Order stream last sequence is 3");
+	test.Assert(client->GetOrderStream().IsSnapshotDone(), true, "Order stream snapshot is done");
+
+	//* Close stream and miss more orders than replay ring can keep
+	client->GetOrderStream().Close();
+	client->WaitActionsNumber(test, 5000);
+	distributor->SetOrder(order2);
+	distributor->SetOrder(order3);
+	distributor->SetOrder(order4);
+
+	//* Reopen stream, full snapshot is sent
+	client->Clear();
+	client->GetOrderStream().Open();
+	client->WaitActionsNumber(test, 5000, 5 /* opened + 3 orders + done */);
+	test.Assert(actions, size_t{ 5 }, "Client's actions number is 5");
+	test.Assert(client->GetOrders().size(), size_t{ 3 }, "Client got three orders from snapshot");
+	test.Assert(client->GetOrderStream().GetLastSequence(), uint64_t{ 6 }, "Order stream last sequence is 6");
+
+	client->GetOrderStream().Close();
+	client->WaitActionsNumber(test, 5000);
+	test.Assert(static_cast<short>(client->GetOrderStream().GetState()),
+		static_cast<short>(MSAPI::Protocol::Object::State::Closed), "Order stream state is closed");
+
+	//* Relay tree: distributor -> relay №1 -> relay №2 -> client №2
+	auto relay1Ptr{ MSAPI::Daemon<ObjectRelay>::Create("Relay1") };
+	if (relay1Ptr == nullptr) {
+		return 1;
+	}
+	auto relay1{ static_cast<ObjectRelay*>(relay1Ptr->GetApp()) };
+	test.Assert(relay1->Subscribe(distributorId, INADDR_LOOPBACK, distributorPtr->GetPort()), true,
+		"Relay №1 is subscribed to distributor");
+	test.Assert(relay1->WaitReady(5000), true, "Relay №1 is ready");
+	test.Assert(relay1->GetObjectsNumber<InstrumentStructure>(), size_t{ 5 }, "Relay №1 got five instruments");
+	test.Assert(relay1->GetObjectsNumber<OrderStructure>(), size_t{ 5 }, "Relay №1 got five orders");
+
+	const int relay1Id{ 2 };
+	auto relay2Ptr{ MSAPI::Daemon<ObjectRelay>::Create("Relay2") };
+	if (relay2Ptr == nullptr) {
+		return 1;
+	}
+	auto relay2{ static_cast<ObjectRelay*>(relay2Ptr->GetApp()) };
+	test.Assert(relay2->Subscribe(relay1Id, INADDR_LOOPBACK, relay1Ptr->GetPort()), true,
+		"Relay №2 is subscribed to relay №1");
+	test.Assert(relay2->WaitReady(5000), true, "Relay №2 is ready");
+	test.Assert(relay2->GetObjectsNumber<InstrumentStructure>(), size_t{ 5 }, "Relay №2 got five instruments");
+	test.Assert(relay2->GetObjectsNumber<OrderStructure>(), size_t{ 5 }, "Relay №2 got five orders");
+
+	const int relay2Id{ 3 };
+	auto client2Ptr{ MSAPI::Daemon<ObjectClient>::Create("Client2") };
+	if (client2Ptr == nullptr) {
+		return 1;
+	}
+	auto client2{ static_cast<ObjectClient*>(client2Ptr->GetApp()) };
+	if (!client2->OpenConnect(relay2Id, INADDR_LOOPBACK, relay2Ptr->GetPort(), false)) {
+		return 1;
+	}
+	client2->SetConnectionForStreams(relay2Id);
+	const auto& relayActions{ client2->GetActionsNumber() };
+
+	//* Snapshot with own filter is served by relay №2
+	client2->GetOrderStream().SetFilter(filter6);
+	client2->GetOrderStream().Open();
+	client2->WaitActionsNumber(test, 5000, 5 /* opened + 3 orders + done */);
+	test.Assert(relayActions, size_t{ 5 }, "Client №2 actions number is 5");
+	test.Assert(client2->GetOrders().size(), size_t{ 3 }, "Client №2 got three orders from relay");
+	test.Assert(client2->HasOrder(order2), true, "Client №2 got order №2");
+	test.Assert(client2->HasOrder(order3), true, "Client №2 got order №3");
+	test.Assert(client2->HasOrder(order4), true, "Client №2 got order №4");
+	test.Assert(client2->GetOrderStream().IsSnapshotDone(), true, "Client №2 order stream snapshot is done");
+
+	//* Live order goes through both relays, order which does not match filter is cached only, relays keep the latest
+	//* version of each order
+	distributor->SetOrder(order5);
+	distributor->SetOrder(order3);
+	client2->WaitActionsNumber(test, 5000, 6);
+	test.Assert(relayActions, size_t{ 6 }, "Client №2 actions number is 6");
+	test.Assert(relay1->GetObjectsNumber<OrderStructure>(), size_t{ 5 }, "Relay №1 replaced cached live orders");
+	test.Assert(relay2->GetObjectsNumber<OrderStructure>(), size_t{ 5 }, "Relay №2 replaced cached live orders");
+
+	//* Upstream streams of relay №1 are failed, downstream streams stay opened and get new snapshot as live objects
+	distributor->StopStreams();
+	client2->WaitActionsNumber(test, 5000, 9 /* 3 orders from new snapshot */);
+	test.Assert(relayActions, size_t{ 9 }, "Client №2 actions number is 9");
+	test.Assert(static_cast<short>(client2->GetOrderStream().GetState()),
+		static_cast<short>(MSAPI::Protocol::Object::State::Opened), "Client №2 order stream state is still opened");
+	test.Assert(relay1->WaitReady(5000), true, "Relay №1 is ready again");
+	test.Assert(relay1->GetObjectsNumber<OrderStructure>(), size_t{ 5 }, "Relay №1 got five orders again");
+	test.Assert(relay2->GetObjectsNumber<OrderStructure>(), size_t{ 5 }, "Relay №2 still has five orders");
+
+	//* Upstream connection of relay №1 is lost, relay №1 reconnects and resubscribes, downstream streams stay opened
+	//* and get new snapshot as live objects
+	test.Assert(relay1->DropUpstream(distributorId), true, "Upstream connection of relay №1 is dropped");
+	test.Assert(relay1->WaitReady(5000), true, "Relay №1 is resubscribed");
+	test.Assert(relay1->GetObjectsNumber<OrderStructure>(), size_t{ 5 }, "Relay №1 got five orders after reconnection");
+	client2->WaitActionsNumber(test, 5000, 12 /* 3 orders from new snapshot */);
+	test.Assert(relayActions, size_t{ 12 }, "Client №2 actions number is 12");
+	test.Assert(static_cast<short>(client2->GetOrderStream().GetState()),
+		static_cast<short>(MSAPI::Protocol::Object::State::Opened), "Client №2 order stream state is still opened");
+
+	//* Live order goes through resubscribed relay №1
+	distributor->SetOrder(order4);
+	client2->WaitActionsNumber(test, 5000, 13);
+	test.Assert(relayActions, size_t{ 13 }, "Client №2 actions number is 13");
+
+	client2->GetOrderStream().Close();
+	client2->WaitActionsNumber(test, 5000);
+	test.Assert(static_cast<short>(client2->GetOrderStream().GetState()),
+		static_cast<short>(MSAPI::Protocol::Object::State::Closed), "Client №2 order stream state is closed");
+
+	client2Ptr.reset();
+	relay2Ptr.reset();
+	relay1Ptr.reset();
 	distributorPtr.reset();
 	clientPtr.reset();
 
@@ -39,18 +39,7 @@ void ObjectClient::HandleBuffer(MSAPI::RecvBufferInfo* recvBufferInfo)
 		void* object;
 		MSAPI::Protocol::Object::Data::UnpackData(&object, *recvBufferInfo->buffer);
 
-		if (data.GetHash() == typeid(MSAPI::Protocol::Object::StreamStateResponse).hash_code()) {
-			CollectStreamState(
-				data.GetStreamId(), reinterpret_cast<MSAPI::Protocol::Object::StreamStateResponse*>(object));
-			return;
-		}
-
-		if (data.GetHash() == typeid(InstrumentStructure).hash_code()) {
-			IHandler<InstrumentStructure>::Collect(data, object);
-			return;
-		}
-		if (data.GetHash() == typeid(OrderStructure).hash_code()) {
-			IHandler<OrderStructure>::Collect(data, object);
+		if (MSAPI::Protocol::Object::Collect<InstrumentStructure, OrderStructure>(this, data, object)) {
 			return;
 		}
 
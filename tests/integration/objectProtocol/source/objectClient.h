@@ -30,8 +30,8 @@
  */
 class ObjectClient : public MSAPI::Server,
 					 public MSAPI::ActionsCounter,
-					 MSAPI::Protocol::Object::IHandler<InstrumentStructure>,
-					 MSAPI::Protocol::Object::IHandler<OrderStructure> {
+					 public MSAPI::Protocol::Object::IHandler<InstrumentStructure>,
+					 public MSAPI::Protocol::Object::IHandler<OrderStructure> {
 private:
 	MSAPI::Protocol::Object::Stream<InstrumentStructure, FilterStructure> m_instrumentStream{ this };
 	MSAPI::Protocol::Object::Stream<OrderStructure, FilterStructure> m_orderStream{ this };
@@ -39,16 +39,7 @@ void ObjectDistributor::HandleBuffer(MSAPI::RecvBufferInfo* recvBufferInfo)
 		void* object;
 		MSAPI::Protocol::Object::Data::UnpackData(&object, *recvBufferInfo->buffer);
 
-		if (data.GetHash() == typeid(MSAPI::Protocol::Object::StreamStateResponse).hash_code()) {
-			Distributor::StreamExternalAction({ data.GetStreamId(), recvBufferInfo->connection },
-				reinterpret_cast<MSAPI::Protocol::Object::StreamStateResponse*>(object));
-			return;
-		}
-
-		if (data.GetHash() == typeid(MSAPI::Protocol::Object::Filter<FilterStructure>).hash_code()
-			|| data.GetHash() == typeid(FilterStructure).hash_code()) {
-
-			Distributor::Collect<FilterStructure>(recvBufferInfo->connection, data, object);
+		if (Distributor::Collect(recvBufferInfo->connection, data, object)) {
 			return;
 		}
 
@@ -70,15 +61,30 @@ void ObjectDistributor::SetOrder(const OrderStructure& order)
 	m_orders.emplace(order);
 }
 
+bool ObjectDistributor::EnableOrderReplay(const size_t capacity)
+{
+	return Distributor::EnableReplay(capacity, m_predicateForOrder);
+}
+
+uint64_t ObjectDistributor::GetDistributorEpoch() const noexcept { return Distributor::GetEpoch(); }
+
+void ObjectDistributor::HandleIncomeDisconnect(const int32_t id, const int32_t connection)
+{
+	Distributor::RemoveConnection(connection);
+	Server::HandleIncomeDisconnect(id, connection);
+}
+
+void ObjectDistributor::StopStreams() { Distributor::Stop(); }
+
 void ObjectDistributor::HandleNewStreamOpened(const int streamId, const MSAPI::Protocol::Object::StreamData& streamData)
 {
-	if (typeid(InstrumentStructure).hash_code() == streamData.objectHash) {
+	if (MSAPI::Protocol::Object::typeId_v<InstrumentStructure> == streamData.objectHash) {
 		LOG_DEBUG("Stream id: " + _S(streamId) + ", connection: " + _S(streamData.connection)
 			+ ", hash: " + _S(streamData.objectHash) + " is open");
 		Distributor::SendOldObjects(streamId, streamData, m_instruments, m_predicateForInstrument);
 		return;
 	}
-	if (typeid(OrderStructure).hash_code() == streamData.objectHash) {
+	if (MSAPI::Protocol::Object::typeId_v<OrderStructure> == streamData.objectHash) {
 		LOG_DEBUG("Stream id: " + _S(streamId) + ", connection: " + _S(streamData.connection)
 			+ ", hash: " + _S(streamData.objectHash) + " is open");
 		Distributor::SendOldObjects(streamId, streamData, m_orders, m_predicateForOrder);
@@ -39,18 +39,23 @@ public:
 
 	//* MSAPI::Server
 	void HandleBuffer(MSAPI::RecvBufferInfo* recvBufferInfo) final;
+	//* MSAPI::Application
+	void HandleIncomeDisconnect(int32_t id, int32_t connection) final;
 	//* MSAPI::Protocol::Object::Distributor
 	void HandleNewStreamOpened(int streamId, const MSAPI::Protocol::Object::StreamData& streamData) final;
 
 	void SetInstrument(const InstrumentStructure& instrument);
 	void SetOrder(const OrderStructure& order);
+	bool EnableOrderReplay(size_t capacity);
+	uint64_t GetDistributorEpoch() const noexcept;
+	void StopStreams();
 	void Clear();
 
 private:
 	std::function<bool(const MSAPI::Protocol::Object::FilterBase* filter, const InstrumentStructure& instrument)>
 		m_predicateForInstrument
 		= [](const MSAPI::Protocol::Object::FilterBase* filter, const InstrumentStructure& instrument) {
-			  if (filter->GetFilterObjectHash() == typeid(FilterStructure).hash_code()) {
+			  if (filter->GetFilterObjectHash() == MSAPI::Protocol::Object::typeId_v<FilterStructure>) {
 				  for (const auto& filter :
 					  reinterpret_cast<const MSAPI::Protocol::Object::Filter<FilterStructure>*>(filter)->GetObjects()) {
 
@@ -69,7 +74,7 @@ private:
 
 	std::function<bool(const MSAPI::Protocol::Object::FilterBase* filter, const OrderStructure& order)>
 		m_predicateForOrder = [](const MSAPI::Protocol::Object::FilterBase* filter, const OrderStructure& order) {
-			if (filter->GetFilterObjectHash() == typeid(FilterStructure).hash_code()) {
+			if (filter->GetFilterObjectHash() == MSAPI::Protocol::Object::typeId_v<FilterStructure>) {
 				for (const auto& filter :
 					reinterpret_cast<const MSAPI::Protocol::Object::Filter<FilterStructure>*>(filter)->GetObjects()) {
 
@@ -0,0 +1,64 @@
+/**************************
+ * @file        objectRelay.cpp
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#include "objectRelay.h"
+#include <sys/socket.h>
+#include <thread>
+
+template <typename T> bool MatchFigi(const MSAPI::Protocol::Object::FilterBase* filter, const T& object)
+{
+	if (filter->GetFilterObjectHash() != MSAPI::Protocol::Object::typeId_v<FilterStructure>) {
+		LOG_ERROR("Unknown filter's object hash: " + _S(filter->GetFilterObjectHash()));
+		return false;
+	}
+
+	for (const auto& filterObject :
+		reinterpret_cast<const MSAPI::Protocol::Object::Filter<FilterStructure>*>(filter)->GetObjects()) {
+
+		if (object.figi == filterObject.figi) {
+			return true;
+		}
+	}
+	return false;
+}
+
+ObjectRelay::ObjectRelay()
+	: MSAPI::Protocol::Object::ApplicationStateChecker(this)
+	, Relay(MatchFigi<InstrumentStructure>, MatchFigi<OrderStructure>)
+{
+	MSAPI::Application::SetState(MSAPI::Application::State::Running);
+}
+
+bool ObjectRelay::WaitReady(const size_t delay)
+{
+	for (size_t waited{ 0 }; waited < delay; ++waited) {
+		if (Relay::IsReady()) {
+			return true;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	return Relay::IsReady();
+}
+
+bool ObjectRelay::DropUpstream(const int id)
+{
+	const auto connection{ GetConnect(id) };
+	return connection.has_value() && shutdown(*connection, SHUT_RDWR) == 0;
+}
@@ -0,0 +1,54 @@
+/**************************
+ * @file        objectRelay.h
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef OBJECT_RELAY_H
+#define OBJECT_RELAY_H
+
+#include "../../../../library/source/protocol/objectRelay.inl"
+#include "commonStructures.h"
+
+/**************************
+ * @brief Object relay for MSAPI tests of object protocol.
+ *
+ * @brief Relays objects of type: InstrumentStructure, OrderStructure.
+ */
+class ObjectRelay : public MSAPI::Protocol::Object::Relay<FilterStructure, InstrumentStructure, OrderStructure> {
+public:
+	ObjectRelay();
+
+	/**************************
+	 * @brief Wait until relay gets upstream snapshots.
+	 *
+	 * @param delay Maximum waiting time in milliseconds.
+	 *
+	 * @return True if relay is ready, false otherwise.
+	 */
+	bool WaitReady(size_t delay);
+
+	/**************************
+	 * @brief Shut down upstream connection as if it is lost.
+	 *
+	 * @param id Upstream connection id.
+	 *
+	 * @return True if connection is shut down, false otherwise.
+	 */
+	bool DropUpstream(int id);
+};
+
+#endif //* OBJECT_RELAY_H
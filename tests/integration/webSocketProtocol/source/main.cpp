@@ -32,7 +32,9 @@
  * 1.13. Try to create close message with payload greater than 123 bytes
  * 1.14. Try to create close message with different buffer type
  * 1.15. Test expected header size function
- * 2. Parallel execution part. Two non-parallel threads: one without masking, another with
+ * 1.16. Apply mask by every supported masking path
+ * 2. Parallel execution part. Two non-parallel threads: one without masking, another with. Server parses frames in
+ * place of recv buffer, clients copy them
  * 2.1. Try to establish WebSocket handshake with unsupported protocol version
  * 2.2. Establish WebSocket handshake
  * 2.3. Send empty text message
@@ -56,7 +58,7 @@
  * 2.21. Send large fragmented message with different steps size
  * 2.22. Overwrite fragmented message with new initial message
  * 3. Common single checking part
- * 3.1. Final state of WebSocket Handler on server
+ * 3.1. Final state of WebSocket Handler on server and borrowed frames
  * 3.2. Check fragmented data storage purging due to limits with one connection scenarios
  * 3.2.1. Send fragmented message with initial payload size greater than fragmented data limit
  * 3.2.2. Send continuation message without initial message
@@ -133,7 +135,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 
 	// Server
 	const int32_t serverId{ 1 };
-	auto serverPtr{ MSAPI::Daemon<Test::Node>::Create("Server") };
+	auto serverPtr{ MSAPI::Daemon<Test::Node>::Create("Server", true) };
 	if (serverPtr == nullptr) {
 		return 1;
 	}
@@ -350,8 +352,8 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 	// 1.2. Initial state of WebSocket Handler on server
 	RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataConnections(), 0,
 		"Initial size of fragmented data connections on server"));
-	RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 0,
-		"Initial size of fragmented data timer to connection on server"));
+	RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 0,
+		"Initial size of fragmented data queue on server"));
 	RETURN_IF_FALSE(
 		test.Assert(serverObserver.GetStoredFragmentedDataSize(), 0., "Initial stored fragmented data size on server"));
 	RETURN_IF_FALSE(test.Assert(server->GetFragmentedDataLimit(), 10., "Default fragmented data limit is correct"));
@@ -623,6 +625,85 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 	RETURN_IF_FALSE(test.Assert(MSAPI::Protocol::WebSocket::Data::GetExpectedHeaderSize(3000000, true), 14,
 		"Expected header size for masked 3000000 payload"));
 
+	// 1.16. Apply mask by every supported masking path
+	{
+		using MaskingPath = MSAPI::Protocol::WebSocket::Data::MaskingPath;
+
+		RETURN_IF_FALSE(test.Assert(MSAPI::Protocol::WebSocket::Data::EnumToString(MaskingPath::Undefined),
+			"Undefined", "Masking path Undefined"));
+		RETURN_IF_FALSE(test.Assert(
+			MSAPI::Protocol::WebSocket::Data::EnumToString(MaskingPath::Scalar), "Scalar", "Masking path Scalar"));
+		RETURN_IF_FALSE(test.Assert(
+			MSAPI::Protocol::WebSocket::Data::EnumToString(MaskingPath::Sse2), "SSE2", "Masking path SSE2"));
+		RETURN_IF_FALSE(test.Assert(
+			MSAPI::Protocol::WebSocket::Data::EnumToString(MaskingPath::Avx2), "AVX2", "Masking path AVX2"));
+		RETURN_IF_FALSE(test.Assert(
+			MSAPI::Protocol::WebSocket::Data::EnumToString(MaskingPath::Avx512), "AVX-512", "Masking path AVX-512"));
+		RETURN_IF_FALSE(
+			test.Assert(MSAPI::Protocol::WebSocket::Data::EnumToString(MaskingPath::Max), "Max", "Masking path Max"));
+
+		RETURN_IF_FALSE(test.Assert(MSAPI::Protocol::WebSocket::Data::IsMaskingPathSupported(MaskingPath::Scalar),
+			true, "Scalar masking path is always supported"));
+		RETURN_IF_FALSE(test.Assert(MSAPI::Protocol::WebSocket::Data::IsMaskingPathSupported(MaskingPath::Undefined),
+			false, "Undefined masking path is not supported"));
+		RETURN_IF_FALSE(test.Assert(MSAPI::Protocol::WebSocket::Data::IsMaskingPathSupported(
+										MSAPI::Protocol::WebSocket::Data::GetMaskingPath()),
+			true, "Selected masking path is supported"));
+		LOG_INFO_NEW("Selected masking path: {}",
+			MSAPI::Protocol::WebSocket::Data::EnumToString(MSAPI::Protocol::WebSocket::Data::GetMaskingPath()));
+
+		static constexpr uint32_t mask{ 0xA1B2C3D4 };
+		std::vector<uint8_t> reference(4096 + 64);
+		for (size_t index{}; index < reference.size(); ++index) {
+			reference[index] = static_cast<uint8_t>(index * 31 + 7);
+		}
+
+		//* Sizes cover every tail of 64 bytes vector and offsets cover unaligned payloads
+		std::vector<size_t> sizes;
+		for (size_t size{}; size <= 300; ++size) {
+			sizes.emplace_back(size);
+		}
+		for (const size_t size : { 1023, 1024, 1025, 4093, 4096 }) {
+			sizes.emplace_back(size);
+		}
+
+		for (const auto path : { MaskingPath::Scalar, MaskingPath::Sse2, MaskingPath::Avx2, MaskingPath::Avx512,
+				 MaskingPath::Undefined }) {
+			LOG_INFO_NEW("Testing masking path {}, supported: {}", MSAPI::Protocol::WebSocket::Data::EnumToString(path),
+				MSAPI::Protocol::WebSocket::Data::IsMaskingPathSupported(path));
+
+			bool equal{ true };
+			for (const size_t offset : { 0, 1, 3, 7, 13 }) {
+				for (const size_t size : sizes) {
+					auto expected{ reference };
+					for (size_t index{}; index < size; ++index) {
+						expected[offset + index] ^= static_cast<uint8_t>(mask >> (8 * (index & 3)));
+					}
+
+					auto actual{ reference };
+					MSAPI::Protocol::WebSocket::Data::ApplyMask(actual.data() + offset, size, mask, path);
+					if (actual != expected) {
+						LOG_ERROR_NEW("Masking path {} is wrong for payload size {} with offset {}",
+							MSAPI::Protocol::WebSocket::Data::EnumToString(path), size, offset);
+						equal = false;
+						break;
+					}
+
+					MSAPI::Protocol::WebSocket::Data::ApplyMask(actual.data() + offset, size, mask, path);
+					if (actual != reference) {
+						LOG_ERROR_NEW("Masking path {} does not restore payload size {} with offset {}",
+							MSAPI::Protocol::WebSocket::Data::EnumToString(path), size, offset);
+						equal = false;
+						break;
+					}
+				}
+			}
+			RETURN_IF_FALSE(test.Assert(equal, true,
+				std::format(
+					"Masking path {} matches reference", MSAPI::Protocol::WebSocket::Data::EnumToString(path))));
+		}
+	}
+
 	struct ClientDeamon {
 		std::unique_ptr<MSAPI::DaemonBase> ptr;
 		std::string portStr;
@@ -806,7 +887,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 			std::format("Size of fragmented data connections on client {} after handshake", clientPortStr)));
 		RETURN_IF_FALSE(test.Assert(serverObserver.HasConnectionFragmentedData(clientConnect), false,
 			std::format("Server does not have fragmented data with client {} after handshake", clientPortStr)));
-		RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect), MSAPI::Timer{ 0 },
+		RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect), int64_t{ 0 },
 			std::format("Server does not have timestamp of last fragmented data with client {} after handshake",
 				clientPortStr)));
 		RETURN_IF_FALSE(test.Assert(clientObserver.HasConnectionFragmentedData(serverConnect), false,
@@ -1076,11 +1157,11 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 		}
 
 		const auto waitForFragmentedData{ [&test, &serverObserver, clientConnect, &clientPortStr](
-											  MSAPI::Timer& lastFragmentTime) {
+											  int64_t& lastFragmentTime) {
 			RETURN_IF_FALSE(test.Wait(
 				50000,
 				[&serverObserver, clientConnect, &clientPortStr, &lastFragmentTime]() {
-					const auto currentLastFragmentTime{ serverObserver.GetLastFragmentedDataTimer(clientConnect) };
+					const auto currentLastFragmentTime{ serverObserver.GetLastFragmentedDataTicks(clientConnect) };
 					if (currentLastFragmentTime <= lastFragmentTime) {
 						return false;
 					}
@@ -1103,7 +1184,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 		RETURN_IF_FALSE(test.Assert(serverObserver.HasConnectionFragmentedData(clientConnect), false,
 			std::format(
 				"Server does not have fragmented data with client {} before fragmented messages", clientPortStr)));
-		RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect), MSAPI::Timer{ 0 },
+		RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect), int64_t{ 0 },
 			std::format(
 				"Server does not have timestamp of last fragmented data with client {} before fragmented messages",
 				clientPortStr)));
@@ -1116,7 +1197,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 			size_t expectedFragments{};
 			size_t sendedFragments{};
 			size_t expectedLastFragmentPayloadSize{};
-			MSAPI::Timer lastFragmentTime{ 0 };
+			int64_t lastFragmentTime{ 0 };
 			uint32_t previousMaskingKey{};
 			auto originalOpcode{ data.GetOpcode() };
 
@@ -1128,7 +1209,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 				}
 
 				sendedPayload = 0;
-				lastFragmentTime = MSAPI::Timer{ 0 };
+				lastFragmentTime = 0;
 				expectedFragments = payloadSize / step;
 				sendedFragments = 0;
 				if (payloadSize % step != 0) {
@@ -1250,7 +1331,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 					std::format(
 						"Server does not have fragmented data messages for client {} after final fragmented message",
 						clientPortStr)));
-				RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect), MSAPI::Timer{ 0 },
+				RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect), int64_t{ 0 },
 					std::format("Server does not have timestamp of last fragmented data with client {} after final "
 								"fragmented message",
 						clientPortStr)));
@@ -1291,7 +1372,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 			MSAPI::Protocol::WebSocket::Data initialMessage{ payloadSpan.subspan(0, 100),
 				MSAPI::Protocol::WebSocket::Data::Opcode::Text, getMaskingKeyIfNeeded(), false };
 			MSAPI::Protocol::WebSocket::Send(serverConnect, initialMessage);
-			MSAPI::Timer lastFragmentTime{ 0 };
+			int64_t lastFragmentTime{ 0 };
 			RETURN_IF_FALSE(waitForFragmentedData(lastFragmentTime));
 
 			MSAPI::Protocol::WebSocket::Data continuationMessage{ payloadSpan.subspan(100, 100),
@@ -1358,7 +1439,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 				std::format(
 					"Server does not have fragmented data messages for client {} after final fragmented message",
 					clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect), MSAPI::Timer{ 0 },
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect), int64_t{ 0 },
 				std::format("Server does not have timestamp of last fragmented data with client {} after final "
 							"fragmented message",
 					clientPortStr)));
@@ -1382,10 +1463,17 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 	// 3.1. Final state of WebSocket Handler on server
 	RETURN_IF_FALSE(test.Assert(
 		serverObserver.GetSizeOfFragmentedDataConnections(), 0, "Final size of fragmented data connections on server"));
-	RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 0,
-		"Final size of fragmented data timer to connection on server"));
+	RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 0,
+		"Final size of fragmented data queue on server"));
 	RETURN_IF_FALSE(
 		test.Assert(serverObserver.GetStoredFragmentedDataSize(), 0., "Final stored fragmented data size on server"));
+	RETURN_IF_FALSE(test.Assert(
+		server->GetBorrowedWebSocketDataNumber() > 0, true, "Server handles frames borrowed from recv buffer"));
+	for (const auto& clientDaemon : clientDaemons) {
+		RETURN_IF_FALSE(test.Assert(
+			static_cast<Test::Node*>(clientDaemon.ptr->GetApp())->GetBorrowedWebSocketDataNumber(), size_t{ 0 },
+			std::format("Client {} handles owning frames", clientDaemon.portStr)));
+	}
 
 	// 3.2. Check fragmented data storage purging due to limits with one connection scenarios
 	{
@@ -1475,7 +1563,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 				std::format(
 					"Server has fragmented data messages for client {} after fragmented message", clientPortStr)));
 			RETURN_IF_FALSE(
-				test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect) != MSAPI::Timer{ 0 }, true,
+				test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect) != 0, true,
 					std::format("Server has timestamp of last fragmented data with client {} after fragmented message",
 						clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(),
@@ -1499,7 +1587,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 							"message with payload size greater than fragmented data limit",
 					clientPortStr)));
 
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect), MSAPI::Timer{ 0 },
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect), int64_t{ 0 },
 				std::format("Server does not have timestamp of last fragmented data with client {} after sending "
 							"fragmented message with payload size greater than fragmented data limit",
 					clientPortStr)));
@@ -1518,8 +1606,8 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 				std::format("Size of fragmented data connections on server after "
 							"purging fragment data for client {}",
 					clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 0,
-				std::format("Size of fragmented data timer to connection on server after purging fragment data for "
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 0,
+				std::format("Size of fragmented data queue on server after purging fragment data for "
 							"client {}",
 					clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(), 0.,
@@ -1545,7 +1633,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 				std::format(
 					"Server has fragmented data messages for client {} after fragmented message", clientPortStr)));
 			RETURN_IF_FALSE(
-				test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect) != MSAPI::Timer{ 0 }, true,
+				test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect) != 0, true,
 					std::format("Server has timestamp of last fragmented data with client {} after fragmented message",
 						clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(),
@@ -1567,7 +1655,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 				std::format("Server does not have fragmented data messages for client {} after sending fragmented "
 							"message with payload size greater than fragmented data limit",
 					clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect), MSAPI::Timer{ 0 },
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect), int64_t{ 0 },
 				std::format("Server does not have timestamp of last fragmented data with client {} after sending "
 							"fragmented message with payload size greater than fragmented data limit",
 					clientPortStr)));
@@ -1586,8 +1674,8 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 				std::format("Size of fragmented data connections on server after "
 							"purging fragment data for client {}",
 					clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 0,
-				std::format("Size of fragmented data timer to connection on server after purging fragment data for "
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 0,
+				std::format("Size of fragmented data queue on server after purging fragment data for "
 							"client {}",
 					clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(), 0.,
@@ -1627,7 +1715,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 
 			RETURN_IF_FALSE(test.Assert(serverObserver.HasConnectionFragmentedData(clientConnect), false,
 				std::format("Server does not have fragmented data messages for client {}", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect), MSAPI::Timer{ 0 },
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect), int64_t{ 0 },
 				std::format("Server does not have timestamp of last fragmented data with client {} after sending "
 							"fragmented messages with zero fragmented data limit",
 					clientPortStr)));
@@ -1639,8 +1727,8 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataConnections(), 0,
 				std::format(
 					"Size of fragmented data connections on server fragment data for client {}", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 0,
-				std::format("Size of fragmented data timer to connection on server client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 0,
+				std::format("Size of fragmented data queue on server client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(), 0.,
 				std::format("Stored fragmented data size on server for client {}", clientPortStr)));
 		}
@@ -1672,7 +1760,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 
 			RETURN_IF_FALSE(test.Assert(serverObserver.HasConnectionFragmentedData(clientConnect), false,
 				std::format("Server does not have fragmented data messages for client {}", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect), MSAPI::Timer{ 0 },
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect), int64_t{ 0 },
 				std::format("Server does not have timestamp of last fragmented data with client {} after sending "
 							"fragmented messages with zero fragmented data limit",
 					clientPortStr)));
@@ -1684,8 +1772,8 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataConnections(), 0,
 				std::format(
 					"Size of fragmented data connections on server fragment data for client {}", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 0,
-				std::format("Size of fragmented data timer to connection on server client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 0,
+				std::format("Size of fragmented data queue on server client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(), 0.,
 				std::format("Stored fragmented data size on server for client {}", clientPortStr)));
 		}
@@ -1709,8 +1797,8 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 					return serverObserver.HasConnectionFragmentedData(clientConnect);
 				},
 				std::format("Server has fragmented data messages for client {}", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect) != MSAPI::Timer{ 0 },
-				true, std::format("Server has timestamp of last fragmented data with client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect) != 0, true,
+				std::format("Server has timestamp of last fragmented data with client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(clientWebSocketDataSize, client->GetWebSocketData(serverConnect)->size(),
 				std::format("Size of WebSocket data on client {} should not change", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverWebSocketDataSize, server->GetWebSocketData(clientConnect)->size(),
@@ -1718,8 +1806,8 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataConnections(), 1,
 				std::format("Size of fragmented data connections on server", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 1,
-				std::format("Size of fragmented data timer to connection on server for client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 1,
+				std::format("Size of fragmented data queue on server for client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(),
 				0.5 + MSAPI::Protocol::WebSocket::Data::MAXIMUM_HEADER_MB,
 				std::format("Stored fragmented data size on for client {}", clientPortStr)));
@@ -1748,15 +1836,15 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 
 			RETURN_IF_FALSE(test.Assert(serverObserver.HasConnectionFragmentedData(clientConnect), true,
 				std::format("Server has fragmented data messages for client {}", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect) != MSAPI::Timer{ 0 },
-				true, std::format("Server has timestamp of last fragmented data with client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect) != 0, true,
+				std::format("Server has timestamp of last fragmented data with client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(clientWebSocketDataSize, client->GetWebSocketData(serverConnect)->size(),
 				std::format("Size of WebSocket data on client {} should not change", clientPortStr)));
 
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataConnections(), 1,
 				std::format("Size of fragmented data connections on server", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 1,
-				std::format("Size of fragmented data timer to connection on server for client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 1,
+				std::format("Size of fragmented data queue on server for client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(),
 				1 + MSAPI::Protocol::WebSocket::Data::MAXIMUM_HEADER_MB,
 				std::format("Stored fragmented data size on for client {}", clientPortStr)));
@@ -1778,15 +1866,15 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 
 			RETURN_IF_FALSE(test.Assert(serverObserver.HasConnectionFragmentedData(clientConnect), true,
 				std::format("Server has fragmented data messages for client {}", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect) != MSAPI::Timer{ 0 },
-				true, std::format("Server has timestamp of last fragmented data with client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect) != 0, true,
+				std::format("Server has timestamp of last fragmented data with client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(clientWebSocketDataSize, client->GetWebSocketData(serverConnect)->size(),
 				std::format("Size of WebSocket data on client {} should not change", clientPortStr)));
 
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataConnections(), 1,
 				std::format("Size of fragmented data connections on server", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 1,
-				std::format("Size of fragmented data timer to connection on server for client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 1,
+				std::format("Size of fragmented data queue on server for client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(),
 				1 + MSAPI::Protocol::WebSocket::Data::MAXIMUM_HEADER_MB,
 				std::format("Stored fragmented data size on for client {}", clientPortStr)));
@@ -1808,15 +1896,15 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 
 			RETURN_IF_FALSE(test.Assert(serverObserver.HasConnectionFragmentedData(clientConnect), false,
 				std::format("Server does not have fragmented data messages for client {}", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect), MSAPI::Timer{ 0 },
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect), int64_t{ 0 },
 				std::format("Server does not have timestamp of last fragmented data with client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(clientWebSocketDataSize, client->GetWebSocketData(serverConnect)->size(),
 				std::format("Size of WebSocket data on client {} should not change", clientPortStr)));
 
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataConnections(), 0,
 				std::format("Size of fragmented data connections on server", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 0,
-				std::format("Size of fragmented data timer to connection on server for client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 0,
+				std::format("Size of fragmented data queue on server for client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(), 0.,
 				std::format("Stored fragmented data size on for client {}", clientPortStr)));
 
@@ -1828,8 +1916,8 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 					return serverObserver.HasConnectionFragmentedData(clientConnect);
 				},
 				std::format("Server has fragmented data messages for client {}", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect) != MSAPI::Timer{ 0 },
-				true, std::format("Server has timestamp of last fragmented data with client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect) != 0, true,
+				std::format("Server has timestamp of last fragmented data with client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(clientWebSocketDataSize, client->GetWebSocketData(serverConnect)->size(),
 				std::format("Size of WebSocket data on client {} should not change", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverWebSocketDataSize, server->GetWebSocketData(clientConnect)->size(),
@@ -1837,8 +1925,8 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataConnections(), 1,
 				std::format("Size of fragmented data connections on server", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 1,
-				std::format("Size of fragmented data timer to connection on server for client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 1,
+				std::format("Size of fragmented data queue on server for client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(),
 				0.5 + MSAPI::Protocol::WebSocket::Data::MAXIMUM_HEADER_MB,
 				std::format("Stored fragmented data size on for client {}", clientPortStr)));
@@ -1846,15 +1934,15 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 			server->Clear();
 			RETURN_IF_FALSE(test.Assert(serverObserver.HasConnectionFragmentedData(clientConnect), false,
 				std::format("Server does not have fragmented data messages for client {}", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect), MSAPI::Timer{ 0 },
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect), int64_t{ 0 },
 				std::format("Server does not have timestamp of last fragmented data with client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(clientWebSocketDataSize, client->GetWebSocketData(serverConnect)->size(),
 				std::format("Size of WebSocket data on client {} should not change", clientPortStr)));
 
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataConnections(), 0,
 				std::format("Size of fragmented data connections on server", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 0,
-				std::format("Size of fragmented data timer to connection on server for client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 0,
+				std::format("Size of fragmented data queue on server for client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(), 0.,
 				std::format("Stored fragmented data size on for client {}", clientPortStr)));
 
@@ -1866,8 +1954,8 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 					return serverObserver.HasConnectionFragmentedData(clientConnect);
 				},
 				std::format("Server has fragmented data messages for client {}", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect) != MSAPI::Timer{ 0 },
-				true, std::format("Server has timestamp of last fragmented data with client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect) != 0, true,
+				std::format("Server has timestamp of last fragmented data with client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(clientWebSocketDataSize, client->GetWebSocketData(serverConnect)->size(),
 				std::format("Size of WebSocket data on client {} should not change", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverWebSocketDataSize, server->GetWebSocketData(clientConnect)->size(),
@@ -1875,8 +1963,8 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataConnections(), 1,
 				std::format("Size of fragmented data connections on server", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 1,
-				std::format("Size of fragmented data timer to connection on server for client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 1,
+				std::format("Size of fragmented data queue on server for client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(),
 				0.5 + MSAPI::Protocol::WebSocket::Data::MAXIMUM_HEADER_MB,
 				std::format("Stored fragmented data size on for client {}", clientPortStr)));
@@ -1884,15 +1972,15 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
 			server->ClearConnection(clientConnect);
 			RETURN_IF_FALSE(test.Assert(serverObserver.HasConnectionFragmentedData(clientConnect), false,
 				std::format("Server does not have fragmented data messages for client {}", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTimer(clientConnect), MSAPI::Timer{ 0 },
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetLastFragmentedDataTicks(clientConnect), int64_t{ 0 },
 				std::format("Server does not have timestamp of last fragmented data with client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(clientWebSocketDataSize, client->GetWebSocketData(serverConnect)->size(),
 				std::format("Size of WebSocket data on client {} should not change", clientPortStr)));
 
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataConnections(), 0,
 				std::format("Size of fragmented data connections on server", clientPortStr)));
-			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataTimerToConnection(), 0,
-				std::format("Size of fragmented data timer to connection on server for client {}", clientPortStr)));
+			RETURN_IF_FALSE(test.Assert(serverObserver.GetSizeOfFragmentedDataQueue(), 0,
+				std::format("Size of fragmented data queue on server for client {}", clientPortStr)));
 			RETURN_IF_FALSE(test.Assert(serverObserver.GetStoredFragmentedDataSize(), 0.,
 				std::format("Stored fragmented data size on for client {}", clientPortStr)));
 		}
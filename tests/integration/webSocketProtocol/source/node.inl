@@ -33,18 +33,26 @@ private:
 	MSAPI::Pthread::AtomicLock m_webSocketDataLock;
 	std::unordered_map<int, std::vector<MSAPI::Protocol::HTTP::Data>> m_httpDataToConnection;
 	MSAPI::Pthread::AtomicLock m_httpDataLock;
+	const bool m_borrowFrames;
+	std::atomic<size_t> m_borrowedWebSocketData{};
 
 public:
-	FORCE_INLINE Node() noexcept
+	FORCE_INLINE Node(const bool borrowFrames = false) noexcept
 		: MSAPI::Protocol::HTTP::IHandler{ this }
 		, MSAPI::Protocol::WebSocket::IHandler{ this }
+		, m_borrowFrames{ borrowFrames }
 	{
 	}
 
 	// MSAPI::Server
 	void HandleBuffer(MSAPI::RecvBufferInfo* const recvBufferInfo) final
 	{
-		MSAPI_HANDLER_WEBSOCKET_PRESET;
+		if (m_borrowFrames) {
+			MSAPI_HANDLER_WEBSOCKET_BORROWED_PRESET;
+		}
+		else {
+			MSAPI_HANDLER_WEBSOCKET_PRESET;
+		}
 
 		MSAPI::DataHeader header{ *recvBufferInfo->buffer };
 
@@ -76,6 +84,7 @@ public:
 		case MSAPI::Protocol::WebSocket::Data::Opcode::Binary:
 		case MSAPI::Protocol::WebSocket::Data::Opcode::Close:
 		case MSAPI::Protocol::WebSocket::Data::Opcode::Continuation: {
+			KeepWebSocketData(data);
 			MSAPI::Pthread::AtomicLock::ExitGuard lock{ m_webSocketDataLock };
 			m_webSocketDataToConnection[connection].emplace_back(std::move(data));
 		} break;
@@ -87,10 +96,16 @@ public:
 
 	void HandleWebSocketPong(const int connection, MSAPI::Protocol::WebSocket::Data&& data) final
 	{
+		KeepWebSocketData(data);
 		MSAPI::Pthread::AtomicLock::ExitGuard lock{ m_webSocketDataLock };
 		m_webSocketDataToConnection[connection].emplace_back(std::move(data));
 	}
 
+	FORCE_INLINE [[nodiscard]] size_t GetBorrowedWebSocketDataNumber() const noexcept
+	{
+		return m_borrowedWebSocketData.load(std::memory_order_acquire);
+	}
+
 	// Non const output as test have to modify websocket data in some case
 	FORCE_INLINE [[nodiscard]] std::vector<MSAPI::Protocol::WebSocket::Data>* GetWebSocketData(const int connection)
 	{
@@ -150,6 +165,16 @@ public:
 	{
 		return MSAPI::Server::GetConnect(id);
 	}
+
+private:
+	// Borrowed data points to recv buffer, which is overwritten by the next message
+	FORCE_INLINE void KeepWebSocketData(MSAPI::Protocol::WebSocket::Data& data)
+	{
+		if (data.IsBorrowed()) {
+			m_borrowedWebSocketData.fetch_add(1, std::memory_order_release);
+			data.Detach();
+		}
+	}
 };
 
 } // namespace Test
@@ -42,36 +42,46 @@ public:
 
 	FORCE_INLINE [[nodiscard]] bool HasConnectionFragmentedData(const int connection) noexcept
 	{
-		Pthread::AtomicLock::ExitGuard guard{ m_handler.m_fragmentedDataLock };
-		return m_handler.m_fragmentedDataToConnection.contains(connection);
+		auto* const fragmentedDataPtr{ m_handler.GetFragmentedData(connection, false) };
+		if (fragmentedDataPtr == nullptr) {
+			return false;
+		}
+
+		Pthread::AtomicLock::ExitGuard guard{ fragmentedDataPtr->lock };
+		return fragmentedDataPtr->stored;
 	}
 
 	FORCE_INLINE [[nodiscard]] size_t GetSizeOfFragmentedDataConnections() noexcept
 	{
-		Pthread::AtomicLock::ExitGuard guard{ m_handler.m_fragmentedDataLock };
-		return m_handler.m_fragmentedDataToConnection.size();
+		Pthread::AtomicLock::ExitGuard guard{ m_handler.m_fragmentedDataQueueLock };
+		size_t size{ 0 };
+		for (const auto* it{ m_handler.m_fragmentedDataHead }; it != nullptr; it = it->next) {
+			++size;
+		}
+		return size;
 	}
 
 	FORCE_INLINE [[nodiscard]] double GetStoredFragmentedDataSize() const noexcept
 	{
-		return m_handler.m_storedFragmentedDataSizeMb;
+		return static_cast<double>(m_handler.m_storedFragmentedDataSize.load(std::memory_order_acquire))
+			/ MSAPI::Protocol::WebSocket::Data::MB;
 	}
 
-	FORCE_INLINE [[nodiscard]] size_t GetSizeOfFragmentedDataTimerToConnection() noexcept
+	FORCE_INLINE [[nodiscard]] size_t GetSizeOfFragmentedDataQueue() noexcept
 	{
-		Pthread::AtomicLock::ExitGuard guard{ m_handler.m_fragmentedDataLock };
-		return m_handler.m_fragmentedDataTimerToConnection.size();
+		Pthread::AtomicLock::ExitGuard guard{ m_handler.m_fragmentedDataQueueLock };
+		return m_handler.m_fragmentedDataQueueSize;
 	}
 
-	FORCE_INLINE [[nodiscard]] MSAPI::Timer GetLastFragmentedDataTimer(const int connection) noexcept
+	FORCE_INLINE [[nodiscard]] int64_t GetLastFragmentedDataTicks(const int connection) noexcept
 	{
-		Pthread::AtomicLock::ExitGuard guard{ m_handler.m_fragmentedDataLock };
-		if (const auto it{ m_handler.m_fragmentedDataToConnection.find(connection) };
-			it != m_handler.m_fragmentedDataToConnection.end()) {
-			return it->second.timestamp;
+		auto* const fragmentedDataPtr{ m_handler.GetFragmentedData(connection, false) };
+		if (fragmentedDataPtr == nullptr) {
+			return 0;
 		}
 
-		return { 0 };
+		Pthread::AtomicLock::ExitGuard guard{ fragmentedDataPtr->lock };
+		return fragmentedDataPtr->timestamp;
 	}
 
 	FORCE_INLINE static uint8_t& GetFirstByte(MSAPI::Protocol::WebSocket::Data& data) noexcept
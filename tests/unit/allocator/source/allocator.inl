@@ -0,0 +1,387 @@
+/**************************
+ * @file        allocator.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef MSAPI_UNIT_TEST_ALLOCATOR_INL
+#define MSAPI_UNIT_TEST_ALLOCATOR_INL
+
+#include "../../../../library/source/help/continuousAllocator.hpp"
+#include "../../../../library/source/help/time.h"
+#include "../../../../library/source/test/test.h"
+#include <atomic>
+#include <list>
+#include <map>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace MSAPI {
+
+namespace Tests {
+
+namespace Unit {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Unit test for continuous allocator, pools and arena. Containers with continuous allocator are compared with
+ * std::allocator, results are logged and are not asserted.
+ *
+ * @return True if all tests passed and false if something went wrong.
+ */
+[[nodiscard]] bool Allocator();
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+bool Allocator()
+{
+	LOG_INFO_UNITTEST("MSAPI Allocator");
+	MSAPI::Test t;
+
+	const auto isAligned{ [](const void* const memory, const size_t alignment) {
+		return reinterpret_cast<uintptr_t>(memory) % alignment == 0;
+	} };
+
+	{
+		// Size classes
+		RETURN_IF_FALSE(t.Assert(MSAPI::Allocator::Pool::GetClass(0), size_t{ 0 }, "Class of 0 bytes"));
+		RETURN_IF_FALSE(t.Assert(MSAPI::Allocator::Pool::GetClass(1), size_t{ 0 }, "Class of 1 byte"));
+		RETURN_IF_FALSE(t.Assert(MSAPI::Allocator::Pool::GetClass(16), size_t{ 0 }, "Class of 16 bytes"));
+		RETURN_IF_FALSE(t.Assert(MSAPI::Allocator::Pool::GetClass(17), size_t{ 1 }, "Class of 17 bytes"));
+		RETURN_IF_FALSE(t.Assert(MSAPI::Allocator::Pool::GetClass(MSAPI::Allocator::MAX_POOLED_SIZE),
+			MSAPI::Allocator::CLASSES - 1, "Class of maximum pooled size"));
+	}
+
+	{
+		// Slabs
+		auto& slabs{ MSAPI::Allocator::Slabs::Get() };
+		void* chunk{ slabs.AllocateChunk() };
+		RETURN_IF_FALSE(t.Assert(chunk != nullptr, true, "Chunk is allocated"));
+		RETURN_IF_FALSE(t.Assert(isAligned(chunk, MSAPI::Allocator::PAGE_SIZE), true, "Chunk is aligned to page"));
+		RETURN_IF_FALSE(t.Assert(slabs.GetMapped() >= MSAPI::Allocator::SLAB_SIZE, true, "Slab is mapped"));
+		std::memset(chunk, 0xAB, MSAPI::Allocator::CHUNK_SIZE);
+		slabs.DeallocateChunk(chunk);
+		RETURN_IF_FALSE(t.Assert(slabs.AllocateChunk() == chunk, true, "Released chunk is reused"));
+		slabs.DeallocateChunk(chunk);
+
+		const auto mapped{ slabs.GetMapped() };
+		void* huge{ slabs.Map(MSAPI::Allocator::HUGE_PAGE_SIZE + 1, true) };
+		RETURN_IF_FALSE(t.Assert(huge != nullptr, true, "Huge memory is mapped"));
+		RETURN_IF_FALSE(
+			t.Assert(isAligned(huge, MSAPI::Allocator::HUGE_PAGE_SIZE), true, "Huge memory is aligned to huge page"));
+		RETURN_IF_FALSE(t.Assert(slabs.GetMapped(), mapped + MSAPI::Allocator::HUGE_PAGE_SIZE * 2,
+			"Size of huge memory is rounded up to huge page"));
+		std::memset(huge, 0xCD, MSAPI::Allocator::HUGE_PAGE_SIZE * 2);
+		slabs.Unmap(huge, MSAPI::Allocator::HUGE_PAGE_SIZE + 1, true);
+		RETURN_IF_FALSE(t.Assert(slabs.GetMapped(), mapped, "Huge memory is unmapped"));
+
+		void* memory{ slabs.Map(1, false) };
+		RETURN_IF_FALSE(t.Assert(memory != nullptr, true, "Memory is mapped"));
+		RETURN_IF_FALSE(t.Assert(slabs.GetMapped(), mapped + MSAPI::Allocator::PAGE_SIZE,
+			"Size of memory is rounded up to page"));
+		slabs.Unmap(memory, 1, false);
+		RETURN_IF_FALSE(t.Assert(slabs.GetMapped(), mapped, "Memory is unmapped"));
+	}
+
+	{
+		// Pool
+		for (size_t size{ 1 }; size <= MSAPI::Allocator::MAX_POOLED_SIZE; size += 7) {
+			void* first{ MSAPI::Allocator::Pool::Allocate(size) };
+			void* second{ MSAPI::Allocator::Pool::Allocate(size) };
+			RETURN_IF_FALSE(t.Assert(first != nullptr && second != nullptr, true, "Objects are allocated"));
+			RETURN_IF_FALSE(t.Assert(first != second, true, "Objects are different"));
+			RETURN_IF_FALSE(t.Assert(isAligned(first, MSAPI::Allocator::CLASS_STEP)
+					&& isAligned(second, MSAPI::Allocator::CLASS_STEP),
+				true, "Objects are aligned to class step"));
+			std::memset(first, 0x11, size);
+			std::memset(second, 0x22, size);
+			RETURN_IF_FALSE(t.Assert(static_cast<uint8_t*>(first)[size - 1] == 0x11, true, "Objects do not overlap"));
+
+			MSAPI::Allocator::Pool::Deallocate(second, size);
+			RETURN_IF_FALSE(
+				t.Assert(MSAPI::Allocator::Pool::Allocate(size) == second, true, "Last free object is reused"));
+			MSAPI::Allocator::Pool::Deallocate(second, size);
+			MSAPI::Allocator::Pool::Deallocate(first, size);
+		}
+
+		// Batches are exchanged with depot many times
+		std::vector<void*> objects;
+		std::set<void*> unique;
+		for (size_t index{ 0 }; index < 100000; ++index) {
+			objects.emplace_back(MSAPI::Allocator::Pool::Allocate(48));
+			unique.insert(objects.back());
+			*static_cast<size_t*>(objects.back()) = index;
+		}
+		RETURN_IF_FALSE(t.Assert(unique.size(), objects.size(), "Live objects are unique"));
+		bool isIntact{ true };
+		for (size_t index{ 0 }; index < objects.size(); ++index) {
+			isIntact &= *static_cast<size_t*>(objects[index]) == index;
+		}
+		RETURN_IF_FALSE(t.Assert(isIntact, true, "Live objects are intact"));
+		for (auto* object : objects) {
+			MSAPI::Allocator::Pool::Deallocate(object, 48);
+		}
+	}
+
+	{
+		// Continuous allocator in containers
+		RETURN_IF_FALSE(t.Assert(MSAPI::ContinuousAllocator<int>{} == MSAPI::ContinuousAllocator<double>{}, true,
+			"Continuous allocators are equal"));
+		RETURN_IF_FALSE(t.Assert(std::allocator_traits<MSAPI::ContinuousAllocator<int>>::is_always_equal::value, true,
+			"Continuous allocators are always equal"));
+
+		std::map<int, std::string, std::less<int>, MSAPI::ContinuousAllocator<std::pair<const int, std::string>>> map;
+		for (int index{ 0 }; index < 1000; ++index) {
+			map.emplace(index, std::to_string(index));
+		}
+		for (int index{ 0 }; index < 1000; index += 2) {
+			map.erase(index);
+		}
+		RETURN_IF_FALSE(t.Assert(map.size(), size_t{ 500 }, "Map size"));
+		RETURN_IF_FALSE(t.Assert(map.at(999), std::string{ "999" }, "Map value"));
+		auto copy{ map };
+		RETURN_IF_FALSE(t.Assert(copy == map, true, "Map copy is equal"));
+
+		std::vector<uint64_t, MSAPI::ContinuousAllocator<uint64_t>> vector;
+		for (uint64_t index{ 0 }; index < 10000; ++index) {
+			vector.push_back(index);
+		}
+		uint64_t sum{};
+		for (const auto value : vector) {
+			sum += value;
+		}
+		RETURN_IF_FALSE(t.Assert(sum, uint64_t{ 49995000 }, "Vector which outgrows pools is intact"));
+
+		struct alignas(64) Aligned {
+			uint8_t value;
+		};
+
+		std::vector<Aligned, MSAPI::ContinuousAllocator<Aligned>> aligned(3);
+		RETURN_IF_FALSE(t.Assert(isAligned(aligned.data(), 64), true, "Overaligned objects are aligned"));
+	}
+
+	{
+		// Objects are allocated and deallocated on different threads
+		constexpr size_t threads{ 8 };
+		constexpr size_t objects{ 20000 };
+		using list_t = std::list<size_t, MSAPI::ContinuousAllocator<size_t>>;
+		std::vector<list_t> lists(threads);
+		std::vector<std::thread> workers;
+		for (size_t thread{ 0 }; thread < threads; ++thread) {
+			workers.emplace_back([&list = lists[thread], thread]() {
+				for (size_t index{ 0 }; index < objects; ++index) {
+					list.push_back(thread * objects + index);
+				}
+			});
+		}
+		for (auto& worker : workers) {
+			worker.join();
+		}
+		workers.clear();
+
+		std::atomic<size_t> errors{};
+		for (size_t thread{ 0 }; thread < threads; ++thread) {
+			workers.emplace_back([&lists, &errors, thread]() {
+				//* Lists are destroyed by other threads than ones which filled them
+				auto& list{ lists[(thread + 1) % threads] };
+				size_t expected{ (thread + 1) % threads * objects };
+				for (const auto value : list) {
+					errors.fetch_add(static_cast<size_t>(value != expected++), std::memory_order_relaxed);
+				}
+				list.clear();
+				list_t own;
+				for (size_t index{ 0 }; index < objects; ++index) {
+					own.push_back(index);
+				}
+			});
+		}
+		for (auto& worker : workers) {
+			worker.join();
+		}
+		RETURN_IF_FALSE(t.Assert(errors.load(), size_t{ 0 }, "Objects of other threads are intact"));
+	}
+
+	{
+		// Arena
+		MSAPI::Allocator::Arena arena;
+		RETURN_IF_FALSE(t.Assert(arena.GetAllocated(), size_t{ 0 }, "Empty arena"));
+		auto* first{ static_cast<char*>(arena.Allocate(10, 1)) };
+		auto* second{ static_cast<char*>(arena.Allocate(10, 1)) };
+		RETURN_IF_FALSE(t.Assert(second == first + 10, true, "Arena allocations are continuous"));
+		auto* third{ arena.Allocate(8, 64) };
+		RETURN_IF_FALSE(t.Assert(isAligned(third, 64), true, "Arena allocation is aligned"));
+		RETURN_IF_FALSE(t.Assert(arena.GetAllocated(), size_t{ 28 }, "Arena allocated size"));
+
+		arena.Reset();
+		RETURN_IF_FALSE(t.Assert(arena.GetAllocated(), size_t{ 0 }, "Arena is reset"));
+		RETURN_IF_FALSE(t.Assert(static_cast<char*>(arena.Allocate(10, 1)) == first, true, "Arena chunk is reused"));
+
+		for (size_t index{ 0 }; index < 100; ++index) {
+			std::memset(arena.Allocate(4000), 0x44, 4000);
+		}
+		const auto mapped{ MSAPI::Allocator::Slabs::Get().GetMapped() };
+		auto* large{ static_cast<char*>(arena.Allocate(MSAPI::Allocator::CHUNK_SIZE * 3)) };
+		RETURN_IF_FALSE(t.Assert(large != nullptr, true, "Large arena allocation"));
+		std::memset(large, 0x33, MSAPI::Allocator::CHUNK_SIZE * 3);
+		RETURN_IF_FALSE(t.Assert(MSAPI::Allocator::Slabs::Get().GetMapped() > mapped, true,
+			"Large arena allocation is mapped separately"));
+		auto* next{ static_cast<char*>(arena.Allocate(10, 1)) };
+		RETURN_IF_FALSE(t.Assert(next < large || next > large + MSAPI::Allocator::CHUNK_SIZE * 3, true,
+			"Current chunk stays after large arena allocation"));
+		arena.Reset();
+		RETURN_IF_FALSE(
+			t.Assert(MSAPI::Allocator::Slabs::Get().GetMapped(), mapped, "Large arena allocation is unmapped"));
+
+		std::vector<int, MSAPI::ArenaAllocator<int>> vector{ MSAPI::ArenaAllocator<int>{ arena } };
+		for (int index{ 0 }; index < 1000; ++index) {
+			vector.push_back(index);
+		}
+		RETURN_IF_FALSE(t.Assert(vector[999], 999, "Arena vector value"));
+
+		std::map<int, int, std::less<int>, MSAPI::ArenaAllocator<std::pair<const int, int>>> map{
+			MSAPI::ArenaAllocator<std::pair<const int, int>>{ arena }
+		};
+		for (int index{ 0 }; index < 100; ++index) {
+			map.emplace(index, index * 2);
+		}
+		RETURN_IF_FALSE(t.Assert(map.at(50), 100, "Arena map value"));
+		RETURN_IF_FALSE(t.Assert(&map.get_allocator().GetArena() == &arena, true, "Arena of rebound allocator"));
+
+		MSAPI::Allocator::Arena other;
+		RETURN_IF_FALSE(t.Assert(MSAPI::ArenaAllocator<int>{ arena } == MSAPI::ArenaAllocator<double>{ arena }, true,
+			"Arena allocators of the same arena are equal"));
+		RETURN_IF_FALSE(t.Assert(MSAPI::ArenaAllocator<int>{ arena } == MSAPI::ArenaAllocator<int>{ other }, false,
+			"Arena allocators of different arenas are not equal"));
+	}
+
+	{
+		// Benchmarks against std::allocator
+		constexpr size_t iterations{ 200000 };
+		const auto measure{ [](const auto& function) {
+			const auto begin{ MSAPI::FastClock::GetTicks() };
+			function();
+			return static_cast<double>(MSAPI::FastClock::GetElapsed(begin)) / iterations;
+		} };
+
+		const auto mapBenchmark{ []<typename AllocatorType>() {
+			std::map<size_t, size_t, std::less<size_t>, AllocatorType> map;
+			for (size_t index{ 0 }; index < iterations; ++index) {
+				map.emplace(index * 7919 % iterations, index);
+			}
+			for (size_t index{ 0 }; index < iterations; ++index) {
+				map.erase(index);
+			}
+		} };
+		const auto mapStd{ measure([&mapBenchmark]() {
+			mapBenchmark.template operator()<std::allocator<std::pair<const size_t, size_t>>>();
+		}) };
+		const auto mapContinuous{ measure([&mapBenchmark]() {
+			mapBenchmark.template operator()<MSAPI::ContinuousAllocator<std::pair<const size_t, size_t>>>();
+		}) };
+		LOG_INFO_NEW("Map insert and erase, std::allocator: {:.1f} ns, continuous allocator: {:.1f} ns, ratio: {:.2f}",
+			mapStd, mapContinuous, mapStd / mapContinuous);
+
+		const auto listBenchmark{ []<typename AllocatorType>() {
+			std::list<size_t, AllocatorType> list;
+			for (size_t index{ 0 }; index < iterations; ++index) {
+				list.push_back(index);
+				if (index % 3 == 0) {
+					list.pop_front();
+				}
+			}
+		} };
+		const auto listStd{ measure(
+			[&listBenchmark]() { listBenchmark.template operator()<std::allocator<size_t>>(); }) };
+		const auto listContinuous{ measure(
+			[&listBenchmark]() { listBenchmark.template operator()<MSAPI::ContinuousAllocator<size_t>>(); }) };
+		LOG_INFO_NEW("List push and pop, std::allocator: {:.1f} ns, continuous allocator: {:.1f} ns, ratio: {:.2f}",
+			listStd, listContinuous, listStd / listContinuous);
+
+		const auto threadsBenchmark{ []<typename AllocatorType>() {
+			std::vector<std::thread> workers;
+			for (size_t thread{ 0 }; thread < 4; ++thread) {
+				workers.emplace_back([]() {
+					AllocatorType allocator;
+					std::vector<typename AllocatorType::value_type*> objects(64);
+					for (size_t index{ 0 }; index < iterations; ++index) {
+						auto*& object{ objects[index % objects.size()] };
+						if (object != nullptr) {
+							allocator.deallocate(object, 1);
+						}
+						object = allocator.allocate(1);
+					}
+					for (auto* object : objects) {
+						allocator.deallocate(object, 1);
+					}
+				});
+			}
+			for (auto& worker : workers) {
+				worker.join();
+			}
+		} };
+		using object_t = std::array<uint64_t, 8>;
+		const auto threadsStd{ measure(
+			[&threadsBenchmark]() { threadsBenchmark.template operator()<std::allocator<object_t>>(); }) };
+		const auto threadsContinuous{ measure([&threadsBenchmark]() {
+			threadsBenchmark.template operator()<MSAPI::ContinuousAllocator<object_t>>();
+		}) };
+		LOG_INFO_NEW("Allocate and deallocate on 4 threads, std::allocator: {:.1f} ns, continuous allocator: {:.1f} ns, "
+					 "ratio: {:.2f}",
+			threadsStd, threadsContinuous, threadsStd / threadsContinuous);
+
+		const auto arenaStd{ measure([]() {
+			for (size_t request{ 0 }; request < iterations / 100; ++request) {
+				std::vector<std::vector<uint32_t>> vectors(100);
+				for (size_t index{ 0 }; index < 100; ++index) {
+					vectors[index].resize(index + 1);
+				}
+			}
+		}) };
+		MSAPI::Allocator::Arena arena;
+		const auto arenaContinuous{ measure([&arena]() {
+			using vector_t = std::vector<uint32_t, MSAPI::ArenaAllocator<uint32_t>>;
+			for (size_t request{ 0 }; request < iterations / 100; ++request) {
+				{
+					std::vector<vector_t, MSAPI::ArenaAllocator<vector_t>> vectors{ MSAPI::ArenaAllocator<vector_t>{
+						arena } };
+					vectors.reserve(100);
+					for (size_t index{ 0 }; index < 100; ++index) {
+						vectors.emplace_back(index + 1, uint32_t{}, MSAPI::ArenaAllocator<uint32_t>{ arena });
+					}
+				}
+				arena.Reset();
+			}
+		}) };
+		LOG_INFO_NEW("Request scoped vectors, std::allocator: {:.1f} ns, arena: {:.1f} ns, ratio: {:.2f}", arenaStd,
+			arenaContinuous, arenaStd / arenaContinuous);
+	}
+
+	return true;
+}
+
+} // namespace Unit
+
+} // namespace Tests
+
+} // namespace MSAPI
+
+#endif // MSAPI_UNIT_TEST_ALLOCATOR_INL
@@ -0,0 +1,445 @@
+/**************************
+ * @file        deflate.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef MSAPI_UNIT_TEST_DEFLATE_INL
+#define MSAPI_UNIT_TEST_DEFLATE_INL
+
+#include "../../../../library/source/help/deflate.inl"
+#include "../../../../library/source/protocol/webSocket.inl"
+#include "../../../../library/source/protocol/webSocketDeflate.inl"
+#include "../../../../library/source/test/test.h"
+#include <set>
+#include <sys/socket.h>
+#include <thread>
+
+namespace MSAPI {
+
+namespace Tests {
+
+namespace Unit {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Unit test for Deflater, Inflater, PerMessageDeflate and compressed WebSocket sending.
+ *
+ * @return True if all tests passed and false if something went wrong.
+ */
+[[nodiscard]] bool Deflate();
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+bool Deflate()
+{
+	LOG_INFO_UNITTEST("MSAPI Deflate");
+	MSAPI::Test t;
+
+	const auto toBytes{ [](const std::string_view text) {
+		return std::vector<uint8_t>{ reinterpret_cast<const uint8_t*>(text.data()),
+			reinterpret_cast<const uint8_t*>(text.data()) + text.size() };
+	} };
+
+	std::string text;
+	for (size_t index{ 0 }; index < 2000; ++index) {
+		text += std::format("{{\"event\":\"update\",\"id\":{},\"price\":{}.{}}}", index % 37, 100 + index % 13,
+			index % 7);
+	}
+	const auto textBytes{ toBytes(text) };
+
+	{
+		// RFC 7692 section 7.2.3.1, 7.2.3.2 and 7.2.3.3
+		const auto hello{ toBytes("Hello") };
+		const std::vector<uint8_t> first{ 0xf2, 0x48, 0xcd, 0xc9, 0xc9, 0x07, 0x00 };
+		const std::vector<uint8_t> second{ 0xf2, 0x00, 0x11, 0x00, 0x00 };
+		const std::vector<uint8_t> stored{ 0x00, 0x05, 0x00, 0xfa, 0xff, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x00 };
+
+		Deflater deflater;
+		std::vector<uint8_t> output;
+		deflater.Compress(hello, output);
+		RETURN_IF_FALSE(t.Assert(output, first, "First 'Hello' is compressed as in RFC 7692"));
+		output.clear();
+		deflater.Compress(hello, output);
+		// RFC example is produced by zlib with literal 'H' and match of 4 bytes, the whole message is one match here
+		RETURN_IF_FALSE(t.Assert(output, std::vector<uint8_t>{ 0x02, 0x13, 0x00, 0x00 },
+			"Second 'Hello' is a single back reference to history"));
+
+		Inflater inflater;
+		output.clear();
+		RETURN_IF_FALSE(t.Assert(inflater.Inflate(first, output, 1024), true, "First 'Hello' is inflated"));
+		RETURN_IF_FALSE(t.Assert(output, hello, "Inflated first 'Hello' is correct"));
+		output.clear();
+		RETURN_IF_FALSE(t.Assert(inflater.Inflate(second, output, 1024), true, "Second 'Hello' is inflated"));
+		RETURN_IF_FALSE(t.Assert(output, hello, "Inflated second 'Hello' is correct"));
+		output.clear();
+		RETURN_IF_FALSE(t.Assert(inflater.Inflate(stored, output, 1024), true, "Stored 'Hello' is inflated"));
+		RETURN_IF_FALSE(t.Assert(output, hello, "Inflated stored 'Hello' is correct"));
+
+		Inflater noContextTakeover{ Deflater::MAX_WINDOW_BITS, false };
+		output.clear();
+		RETURN_IF_FALSE(t.Assert(noContextTakeover.Inflate(first, output, 1024), true, "First 'Hello' is inflated"));
+		output.clear();
+		RETURN_IF_FALSE(t.Assert(noContextTakeover.Inflate(second, output, 1024), false,
+			"Back reference to previous message is rejected without context takeover"));
+	}
+
+	{
+		// Dynamic Huffman block produced by zlib with level 9 and raw window of 15 bits
+		const std::vector<uint8_t> compressed{ 204, 140, 65, 14, 130, 48, 20, 5, 175, 242, 46, 32, 23, 112, 229, 146,
+			5, 137, 9, 38, 174, 75, 121, 84, 109, 241, 215, 254, 15, 40, 167, 151, 173, 39, 192, 229, 100, 38, 211, 180,
+			167, 115, 141, 43, 187, 86, 124, 164, 33, 179, 140, 84, 117, 129, 135, 158, 67, 114, 70, 24, 213, 48, 211,
+			155, 148, 10, 205, 159, 245, 151, 27, 241, 154, 238, 62, 162, 43, 178, 60, 49, 200, 27, 143, 105, 204, 10,
+			153, 89, 96, 155, 78, 110, 253, 160, 151, 112, 252, 33, 104, 34, 179, 86, 251, 15, 190, 0 };
+		std::string expected;
+		for (size_t index{ 0 }; index < 4; ++index) {
+			expected += "MSAPI WebSocket permessage-deflate test vector. ";
+		}
+		for (size_t index{ 0 }; index < 3; ++index) {
+			expected += "The quick brown fox jumps over the lazy dog; the lazy dog sleeps.";
+		}
+
+		Inflater inflater;
+		std::vector<uint8_t> output;
+		RETURN_IF_FALSE(t.Assert(inflater.Inflate(compressed, output, 1024), true, "Dynamic block is inflated"));
+		RETURN_IF_FALSE(t.Assert(output, toBytes(expected), "Inflated dynamic block is correct"));
+
+		output.clear();
+		Inflater limited;
+		RETURN_IF_FALSE(t.Assert(limited.Inflate(compressed, output, expected.size() - 1), false,
+			"Message exceeding limit is rejected"));
+
+		auto corrupted{ compressed };
+		corrupted[0] |= 0b110;
+		output.clear();
+		Inflater broken;
+		RETURN_IF_FALSE(t.Assert(broken.Inflate(corrupted, output, 1024), false, "Reserved block type is rejected"));
+	}
+
+	{
+		// Round trips
+		for (const int8_t windowBits : { Deflater::MIN_WINDOW_BITS, int8_t{ 10 }, Deflater::MAX_WINDOW_BITS }) {
+			for (const bool contextTakeover : { true, false }) {
+				Deflater deflater{ windowBits, contextTakeover };
+				Inflater inflater{ windowBits, contextTakeover };
+				RETURN_IF_FALSE(t.Assert(deflater.GetWindowSize(), size_t{ 1 } << windowBits,
+					std::format("Window size for {} bits", static_cast<int32_t>(windowBits))));
+
+				for (size_t message{ 0 }; message < 4; ++message) {
+					const std::span<const uint8_t> input{ textBytes.data() + message * 1000,
+						textBytes.size() - message * 1000 };
+					std::vector<uint8_t> compressed;
+					deflater.Compress(input, compressed);
+					RETURN_IF_FALSE(t.Assert(compressed.size() < input.size(), true,
+						std::format("Message {} is compressed with {} window bits, context takeover: {}", message,
+							static_cast<int32_t>(windowBits), contextTakeover)));
+
+					std::vector<uint8_t> output;
+					RETURN_IF_FALSE(t.Assert(inflater.Inflate(compressed, output, input.size()), true,
+						std::format("Message {} is inflated with {} window bits, context takeover: {}", message,
+							static_cast<int32_t>(windowBits), contextTakeover)));
+					RETURN_IF_FALSE(t.Assert(output == std::vector<uint8_t>{ input.begin(), input.end() }, true,
+						std::format("Message {} round trip with {} window bits, context takeover: {}", message,
+							static_cast<int32_t>(windowBits), contextTakeover)));
+				}
+			}
+		}
+
+		Deflater deflater;
+		Inflater inflater;
+		std::vector<uint8_t> compressed;
+		deflater.Compress({}, compressed);
+		RETURN_IF_FALSE(t.Assert(compressed, std::vector<uint8_t>{ 0x00 }, "Empty message is compressed"));
+		std::vector<uint8_t> output;
+		RETURN_IF_FALSE(t.Assert(inflater.Inflate(compressed, output, 0), true, "Empty message is inflated"));
+		RETURN_IF_FALSE(t.Assert(output.empty(), true, "Inflated empty message is empty"));
+
+		const std::vector<uint8_t> zeros(100000, 0);
+		compressed.clear();
+		deflater.Compress(zeros, compressed);
+		RETURN_IF_FALSE(t.Assert(compressed.size() < 1000, true, "Zeros are compressed with long matches"));
+		RETURN_IF_FALSE(t.Assert(inflater.Inflate(compressed, output, zeros.size()), true, "Zeros are inflated"));
+		RETURN_IF_FALSE(t.Assert(output, zeros, "Inflated zeros are correct"));
+	}
+
+	{
+		// Negotiation
+		using PMD = MSAPI::Protocol::WebSocket::PerMessageDeflate;
+		PMD::Options options;
+		options.enabled = true;
+
+		const auto negotiate{ [&options](const std::string_view offers, const PMD::Options* custom = nullptr) {
+			const auto parameters{ PMD::Negotiate(offers, custom == nullptr ? options : *custom) };
+			return parameters.has_value() ? PMD::GetResponse(*parameters) : std::string{ "<none>" };
+		} };
+
+		RETURN_IF_FALSE(t.Assert(negotiate("permessage-deflate"), "permessage-deflate", "Plain offer"));
+		RETURN_IF_FALSE(t.Assert(negotiate("permessage-deflate; client_max_window_bits"), "permessage-deflate",
+			"Offer with client_max_window_bits without value"));
+		RETURN_IF_FALSE(t.Assert(negotiate("permessage-deflate; server_max_window_bits=10"),
+			"permessage-deflate; server_max_window_bits=10", "Offer with server_max_window_bits"));
+		RETURN_IF_FALSE(t.Assert(negotiate("permessage-deflate; client_max_window_bits=\"9\"; "
+										   "server_no_context_takeover"),
+			"permessage-deflate; server_no_context_takeover; client_max_window_bits=9",
+			"Offer with quoted client_max_window_bits and server_no_context_takeover"));
+		RETURN_IF_FALSE(t.Assert(negotiate("x-webkit-deflate-frame, permessage-deflate; server_max_window_bits=16, "
+										   "permessage-deflate; client_no_context_takeover"),
+			"permessage-deflate; client_no_context_takeover", "First acceptable offer is chosen"));
+		RETURN_IF_FALSE(t.Assert(negotiate("permessage-deflate; server_max_window_bits=7"), "<none>",
+			"Offer with too small window is rejected"));
+		RETURN_IF_FALSE(t.Assert(
+			negotiate("permessage-deflate; unknown"), "<none>", "Offer with unknown parameter is rejected"));
+		RETURN_IF_FALSE(
+			t.Assert(negotiate("permessage-deflate; server_no_context_takeover; server_no_context_takeover"), "<none>",
+				"Offer with duplicated parameter is rejected"));
+		RETURN_IF_FALSE(t.Assert(negotiate("x-webkit-deflate-frame"), "<none>", "Unknown extension is ignored"));
+
+		PMD::Options custom;
+		custom.enabled = true;
+		custom.serverMaxWindowBits = 12;
+		custom.clientNoContextTakeover = true;
+		RETURN_IF_FALSE(t.Assert(negotiate("permessage-deflate; client_max_window_bits", &custom),
+			"permessage-deflate; client_no_context_takeover; server_max_window_bits=12",
+			"Server settings are applied to response"));
+		custom.enabled = false;
+		RETURN_IF_FALSE(t.Assert(negotiate("permessage-deflate", &custom), "<none>", "Disabled extension"));
+
+		constexpr int connection{ 1000001 };
+		const std::string offers{ "permessage-deflate; client_max_window_bits" };
+		RETURN_IF_FALSE(t.Assert(PMD::GetOptions().enabled, false, "Extension is disabled by default"));
+		RETURN_IF_FALSE(t.Assert(PMD::Accept(connection, &offers), "", "Offer is not accepted by default"));
+		RETURN_IF_FALSE(t.Assert(PMD::IsOpened(connection), false, "Context is not opened by default"));
+
+		PMD::SetOptions(options);
+		RETURN_IF_FALSE(t.Assert(PMD::Accept(connection, &offers), "permessage-deflate", "Offer is accepted"));
+		RETURN_IF_FALSE(t.Assert(PMD::IsOpened(connection), true, "Context is opened on accept"));
+		RETURN_IF_FALSE(t.Assert(PMD::Accept(connection, nullptr), "", "Missing header is not accepted"));
+		RETURN_IF_FALSE(t.Assert(PMD::IsOpened(connection), false, "Previous context is closed on accept"));
+
+		PMD::SetOptions(custom);
+		RETURN_IF_FALSE(t.Assert(PMD::GetOptions().serverMaxWindowBits, 12, "Options are set"));
+		RETURN_IF_FALSE(t.Assert(PMD::Accept(connection, &offers), "", "Offer is not accepted when disabled"));
+		RETURN_IF_FALSE(t.Assert(PMD::IsOpened(connection), false, "Context is not opened when disabled"));
+		PMD::SetOptions(PMD::Options{});
+	}
+
+	{
+		// Per connection contexts
+		using PMD = MSAPI::Protocol::WebSocket::PerMessageDeflate;
+		constexpr int connection{ 1000000 };
+		PMD::Options options;
+		options.enabled = true;
+		options.threshold = 64;
+		options.maxMessageSize = textBytes.size();
+		size_t sent{};
+		const auto sender{ [&sent](const std::vector<uint8_t>&) { ++sent; } };
+
+		const auto parameters{ PMD::Negotiate("permessage-deflate", options) };
+		RETURN_IF_FALSE(t.Assert(parameters.has_value(), true, "Offer is accepted"));
+
+		std::vector<uint8_t> compressed;
+		RETURN_IF_FALSE(t.Assert(PMD::IsOpened(connection), false, "Context is not opened"));
+		RETURN_IF_FALSE(t.Assert(
+			PMD::Compress(connection, textBytes, compressed, sender), false, "No compression without context"));
+
+		const auto metricsBefore{ PMD::GetMetrics() };
+		RETURN_IF_FALSE(t.Assert(PMD::Open(connection, *parameters, options), true, "Context is opened"));
+		RETURN_IF_FALSE(t.Assert(PMD::IsOpened(connection), true, "Context of connection is opened"));
+		RETURN_IF_FALSE(t.Assert(PMD::IsOpened(connection + 1), false, "Context of neighbour is not opened"));
+		RETURN_IF_FALSE(
+			t.Assert(PMD::Open(-1, *parameters, options), false, "Context is not opened for negative connection"));
+		constexpr auto outOfRange{ static_cast<int>(PMD::CONNECTION_PAGE_SIZE * PMD::CONNECTION_PAGES) };
+		RETURN_IF_FALSE(t.Assert(PMD::Open(outOfRange, *parameters, options), false,
+			"Context is not opened for connection out of range"));
+		RETURN_IF_FALSE(
+			t.Assert(PMD::Compress(connection, std::span<const uint8_t>{ textBytes.data(), 63 }, compressed, sender),
+				false, "Payload below threshold is not compressed"));
+		RETURN_IF_FALSE(t.Assert(sent, size_t{ 0 }, "Nothing is sent by sender"));
+		RETURN_IF_FALSE(
+			t.Assert(PMD::Compress(connection, textBytes, compressed, sender), true, "Payload is compressed"));
+		RETURN_IF_FALSE(t.Assert(sent, size_t{ 1 }, "Compressed payload is sent by sender"));
+
+		// The same connection id is used for both directions, as server context inflates what client context
+		// compressed
+		std::vector<uint8_t> output;
+		RETURN_IF_FALSE(t.Assert(PMD::Inflate(connection, compressed, output), true, "Payload is inflated"));
+		RETURN_IF_FALSE(t.Assert(output, textBytes, "Inflated payload is correct"));
+
+		const auto metrics{ PMD::GetMetrics() };
+		RETURN_IF_FALSE(t.Assert(metrics.compressedMessages - metricsBefore.compressedMessages, 1, "Compressed"));
+		RETURN_IF_FALSE(t.Assert(metrics.skippedMessages - metricsBefore.skippedMessages, 1, "Skipped"));
+		RETURN_IF_FALSE(t.Assert(metrics.compressInputBytes - metricsBefore.compressInputBytes, textBytes.size(),
+			"Compress input bytes"));
+		RETURN_IF_FALSE(t.Assert(metrics.compressOutputBytes - metricsBefore.compressOutputBytes, compressed.size(),
+			"Compress output bytes"));
+		RETURN_IF_FALSE(t.Assert(metrics.inflatedMessages - metricsBefore.inflatedMessages, 1, "Inflated"));
+		RETURN_IF_FALSE(t.Assert(metrics.inflateOutputBytes - metricsBefore.inflateOutputBytes, textBytes.size(),
+			"Inflate output bytes"));
+		RETURN_IF_FALSE(t.Assert(metrics.GetRatio() < 1, true, "Compression ratio"));
+
+		RETURN_IF_FALSE(t.Assert(PMD::Open(connection, *parameters, options), true, "Context is reopened"));
+		auto tooBig{ textBytes };
+		tooBig.push_back('!');
+		compressed.clear();
+		RETURN_IF_FALSE(
+			t.Assert(PMD::Compress(connection, tooBig, compressed, sender), true, "Big payload is compressed"));
+		output.clear();
+		RETURN_IF_FALSE(
+			t.Assert(PMD::Inflate(connection, compressed, output), false, "Payload exceeding limit is rejected"));
+		RETURN_IF_FALSE(t.Assert(PMD::GetMetrics().failedMessages - metricsBefore.failedMessages, 1, "Failed"));
+
+		PMD::Close(connection);
+		RETURN_IF_FALSE(t.Assert(PMD::IsOpened(connection), false, "Context is closed"));
+		RETURN_IF_FALSE(t.Assert(PMD::Inflate(connection, compressed, output), false, "No inflation without context"));
+	}
+
+	{
+		// Concurrent senders on one connection, peer inflates messages with context takeover only if they are sent in
+		// order of compression
+		using PMD = MSAPI::Protocol::WebSocket::PerMessageDeflate;
+		using Data = MSAPI::Protocol::WebSocket::Data;
+		int sockets[2];
+		RETURN_IF_FALSE(t.Assert(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0, "Socket pair is created"));
+
+		PMD::Options options;
+		options.enabled = true;
+		options.threshold = 0;
+		const auto parameters{ PMD::Negotiate("permessage-deflate", options) };
+		RETURN_IF_FALSE(t.Assert(PMD::Open(sockets[0], *parameters, options), true, "Context of socket is opened"));
+
+		constexpr size_t sendersNumber{ 4 };
+		constexpr size_t messagesNumber{ 250 };
+		std::vector<std::vector<std::vector<uint8_t>>> messages(sendersNumber);
+		std::set<std::vector<uint8_t>> expected;
+		for (size_t sender{ 0 }; sender < sendersNumber; ++sender) {
+			for (size_t message{ 0 }; message < messagesNumber; ++message) {
+				auto bytes{ toBytes(std::format("sender {} message {} ", sender, message)) };
+				const auto offset{ (sender * messagesNumber + message) * 7 % (textBytes.size() - 512) };
+				bytes.insert(bytes.end(), textBytes.begin() + static_cast<std::ptrdiff_t>(offset),
+					textBytes.begin() + static_cast<std::ptrdiff_t>(offset + 512));
+				expected.insert(bytes);
+				messages[sender].emplace_back(std::move(bytes));
+			}
+		}
+
+		std::vector<std::thread> senders;
+		for (size_t sender{ 0 }; sender < sendersNumber; ++sender) {
+			senders.emplace_back([&messages, sender, connection = sockets[0]] {
+				for (const auto& message : messages[sender]) {
+					MSAPI::Protocol::WebSocket::Send(connection, Data{ message, Data::Opcode::Binary });
+				}
+			});
+		}
+
+		const auto readExactly{ [socket = sockets[1]](uint8_t* buffer, size_t size) {
+			while (size > 0) {
+				const auto result{ read(socket, buffer, size) };
+				if (result <= 0) {
+					return false;
+				}
+				buffer += result;
+				size -= static_cast<size_t>(result);
+			}
+			return true;
+		} };
+
+		Inflater inflater;
+		size_t inflated{};
+		size_t matched{};
+		std::vector<uint8_t> frame;
+		std::vector<uint8_t> output;
+		for (size_t index{ 0 }; index < sendersNumber * messagesNumber; ++index) {
+			std::array<uint8_t, 2> header;
+			if (!readExactly(header.data(), header.size())) {
+				break;
+			}
+			uint64_t size{ header[1] & 0x7Fu };
+			if (size == 126) {
+				uint16_t extended;
+				if (!readExactly(reinterpret_cast<uint8_t*>(&extended), sizeof(extended))) {
+					break;
+				}
+				size = be16toh(extended);
+			}
+			else if (size == 127) {
+				uint64_t extended;
+				if (!readExactly(reinterpret_cast<uint8_t*>(&extended), sizeof(extended))) {
+					break;
+				}
+				size = be64toh(extended);
+			}
+			frame.resize(size);
+			if (!readExactly(frame.data(), frame.size()) || (header[0] & 0x40) == 0) {
+				break;
+			}
+
+			output.clear();
+			if (!inflater.Inflate(frame, output, textBytes.size())) {
+				break;
+			}
+			++inflated;
+			matched += expected.contains(output);
+		}
+
+		// Senders blocked on full socket are released if reading is stopped earlier
+		close(sockets[1]);
+		for (auto& sender : senders) {
+			sender.join();
+		}
+		PMD::Close(sockets[0]);
+		close(sockets[0]);
+
+		RETURN_IF_FALSE(
+			t.Assert(inflated, sendersNumber * messagesNumber, "All concurrently sent messages are inflated"));
+		RETURN_IF_FALSE(t.Assert(matched, sendersNumber * messagesNumber, "All inflated messages are correct"));
+	}
+
+	{
+		// Close message with status code
+		using Data = MSAPI::Protocol::WebSocket::Data;
+		int sockets[2];
+		RETURN_IF_FALSE(t.Assert(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0, "Socket pair is created"));
+		MSAPI::Protocol::WebSocket::SendClose(
+			sockets[0], Data::CloseStatusCode::InvalidFramePayloadData, "Cannot inflate message");
+
+		std::array<uint8_t, 64> buffer{};
+		const auto size{ read(sockets[1], buffer.data(), buffer.size()) };
+		close(sockets[0]);
+		close(sockets[1]);
+		RETURN_IF_FALSE(t.Assert(size, ssize_t{ 26 }, "Close message size"));
+		RETURN_IF_FALSE(t.Assert(buffer[0], uint8_t{ 0x88 }, "Close message is final"));
+		RETURN_IF_FALSE(t.Assert(buffer[1], uint8_t{ 24 }, "Close message payload size"));
+		RETURN_IF_FALSE(t.Assert(be16toh(*reinterpret_cast<const uint16_t*>(buffer.data() + 2)), uint16_t{ 1007 },
+			"Close message status code"));
+		RETURN_IF_FALSE(t.Assert(std::string_view{ reinterpret_cast<const char*>(buffer.data() + 4), 22 },
+			std::string_view{ "Cannot inflate message" }, "Close message reason"));
+	}
+
+	return true;
+}
+
+} // namespace Unit
+
+} // namespace Tests
+
+} // namespace MSAPI
+
+#endif // MSAPI_UNIT_TEST_DEFLATE_INL
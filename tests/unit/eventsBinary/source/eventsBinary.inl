@@ -0,0 +1,340 @@
+/**************************
+ * @file        eventsBinary.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef MSAPI_UNIT_TEST_EVENTS_BINARY_INL
+#define MSAPI_UNIT_TEST_EVENTS_BINARY_INL
+
+#include "../../../../library/source/help/time.h"
+#include "../../../../library/source/protocol/webSocketEventsBinary.inl"
+#include "../../../../library/source/test/test.h"
+#include <limits>
+
+namespace MSAPI {
+
+namespace Tests {
+
+namespace Unit {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Unit test for binary encoding of events protocol.
+ *
+ * @return True if all tests passed and false if something went wrong.
+ */
+[[nodiscard]] bool EventsBinary();
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+bool EventsBinary()
+{
+	LOG_INFO_UNITTEST("MSAPI Events binary");
+	MSAPI::Test t;
+
+	using namespace Protocol::WebSocket::Events;
+	using namespace Protocol::WebSocket::Events::Binary;
+
+	const auto toSpan{ [](const std::string& buffer) {
+		return std::span<const uint8_t>{ reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size() };
+	} };
+
+	RETURN_IF_FALSE(t.Assert(EnumToString(Encoding::Undefined), "Undefined", "Encoding Undefined"));
+	RETURN_IF_FALSE(t.Assert(EnumToString(Encoding::Json), "Json", "Encoding Json"));
+	RETURN_IF_FALSE(t.Assert(EnumToString(Encoding::Binary), "Binary", "Encoding Binary"));
+	RETURN_IF_FALSE(t.Assert(EnumToString(Encoding::Max), "Max", "Encoding Max"));
+
+	{
+		// Typed values and containers
+		std::string buffer;
+		Encoder encoder{ buffer };
+		encoder.BeginObject();
+		encoder.Key("int8");
+		encoder.Add(int8_t{ -5 });
+		encoder.Key("uint8");
+		encoder.Add(uint8_t{ 200 });
+		encoder.Key("int64");
+		encoder.Add(int64_t{ -1099511627776 });
+		encoder.Key("uint64");
+		encoder.Add(uint64_t{ 18446744073709551615ULL });
+		encoder.Key("float");
+		encoder.Add(0.25f);
+		encoder.Key("double");
+		encoder.Add(1.5);
+		encoder.Key("nan");
+		encoder.Add(std::numeric_limits<double>::quiet_NaN());
+		encoder.Key("string");
+		encoder.Add(std::string_view{ "q\"\\\n\x01" });
+		encoder.Key("array");
+		encoder.BeginArray();
+		encoder.Add(true);
+		encoder.Add(false);
+		encoder.AddNull();
+		encoder.Add(std::string_view{});
+		encoder.BeginArray();
+		encoder.EndArray();
+		encoder.BeginObject();
+		encoder.EndObject();
+		encoder.EndArray();
+		encoder.EndObject();
+		encoder.Add(int32_t{ 7 });
+
+		RETURN_IF_FALSE(t.Assert(static_cast<uint8_t>(buffer[0]), OBJECT_TAG, "Object tag is written"));
+		RETURN_IF_FALSE(t.Assert(static_cast<uint8_t>(buffer[5]), uint8_t{ 4 }, "First key size is written"));
+
+		Decoder decoder{ toSpan(buffer) };
+		std::string json;
+		RETURN_IF_FALSE(t.Assert(decoder.ReadJson(json), true, "Object is decoded"));
+		RETURN_IF_FALSE(t.Assert(json,
+			"{\"int8\":-5,\"uint8\":200,\"int64\":-1099511627776,\"uint64\":18446744073709551615,\"float\":0.25,"
+			"\"double\":1.5,\"nan\":null,\"string\":\"q\\\"\\\\\\n\\u0001\",\"array\":[true,false,null,\"\",[],{}]}",
+			"Decoded object"));
+		RETURN_IF_FALSE(t.Assert(decoder.IsEnd(), false, "Second value is not read yet"));
+		json.clear();
+		RETURN_IF_FALSE(t.Assert(decoder.ReadJson(json), true, "Second value is decoded"));
+		RETURN_IF_FALSE(t.Assert(json, "7", "Decoded second value"));
+		RETURN_IF_FALSE(t.Assert(decoder.IsEnd(), true, "Buffer is read"));
+
+		for (size_t size{ 0 }; size < buffer.size() - 5; ++size) {
+			Decoder truncated{ toSpan(buffer).first(size) };
+			json.clear();
+			RETURN_IF_FALSE(t.Assert(truncated.ReadJson(json), false, std::format("Truncated to {} bytes", size)));
+		}
+
+		buffer[0] = 100;
+		Decoder unknown{ toSpan(buffer) };
+		json.clear();
+		RETURN_IF_FALSE(t.Assert(unknown.ReadJson(json), false, "Unknown tag is rejected"));
+	}
+
+	{
+		// Json round trip, keys of parsed json are ordered
+		std::string buffer;
+		Encoder encoder{ buffer };
+		RETURN_IF_FALSE(t.Assert(encoder.AddJson("{\"b\":[1,-300,70000,\"text\",true,null],\"a\":{\"c\":\"\"}}"), true,
+			"Json is encoded"));
+
+		Decoder decoder{ toSpan(buffer) };
+		std::string json;
+		RETURN_IF_FALSE(t.Assert(decoder.ReadJson(json), true, "Encoded json is decoded"));
+		RETURN_IF_FALSE(
+			t.Assert(json, "{\"a\":{\"c\":\"\"},\"b\":[1,-300,70000,\"text\",true,null]}", "Json round trip"));
+		RETURN_IF_FALSE(t.Assert(decoder.IsEnd(), true, "Encoded json is read"));
+
+		std::string small;
+		Encoder smallEncoder{ small };
+		RETURN_IF_FALSE(t.Assert(smallEncoder.AddJson("[1,-300,70000]"), true, "Integers are encoded"));
+		RETURN_IF_FALSE(t.Assert(small.size(), size_t{ 5 + 2 + 3 + 5 }, "Integers are written with smallest types"));
+
+		std::string escaped;
+		Encoder escapedEncoder{ escaped };
+		RETURN_IF_FALSE(t.Assert(escapedEncoder.AddJson("{\"k\\\"\":\"q\\\"\\\\\\n\\u0041\\u00e9\\/\"}"), true,
+			"Json with escaped strings is encoded"));
+		Decoder escapedDecoder{ toSpan(escaped) };
+		json.clear();
+		RETURN_IF_FALSE(t.Assert(escapedDecoder.ReadJson(json), true, "Json with escaped strings is decoded"));
+		RETURN_IF_FALSE(t.Assert(json, "{\"k\\\"\":\"q\\\"\\\\\\nA\u00e9/\"}", "Escape sequences are decoded once"));
+
+		std::string empty;
+		Encoder emptyEncoder{ empty };
+		RETURN_IF_FALSE(t.Assert(emptyEncoder.AddJson("\"\""), true, "Empty string is encoded"));
+		RETURN_IF_FALSE(t.Assert(empty, std::string(1, static_cast<char>(StandardType::Type::StringEmpty)),
+			"Empty string is written with tag only"));
+
+		std::string invalid;
+		Encoder invalidEncoder{ invalid };
+		RETURN_IF_FALSE(t.Assert(invalidEncoder.AddJson("{\"a\":"), false, "Invalid json is rejected"));
+	}
+
+	{
+		// Frame headers
+		const uint64_t uids[]{ 7, 18446744073709551615ULL, 0 };
+		std::string buffer(FRAME_HEADER_SIZE + sizeof(uids), '\0');
+		RETURN_IF_FALSE(t.Assert(WriteHeader(buffer.data(), Frame::Data, uids), buffer.size(), "Header is written"));
+		Encoder encoder{ buffer };
+		encoder.Add(std::string_view{ "data" });
+
+		Decoder decoder{ toSpan(buffer) };
+		Frame frame{ Frame::Undefined };
+		std::vector<uint64_t> readUids;
+		RETURN_IF_FALSE(t.Assert(decoder.ReadHeader(frame, readUids), true, "Header is read"));
+		RETURN_IF_FALSE(t.Assert(U(frame), U(Frame::Data), "Frame kind is data"));
+		RETURN_IF_FALSE(t.Assert(readUids, std::vector<uint64_t>{ uids[0], uids[1], uids[2] }, "Frame uids"));
+		std::string json;
+		RETURN_IF_FALSE(t.Assert(decoder.ReadJson(json), true, "Frame value is read"));
+		RETURN_IF_FALSE(t.Assert(json, "\"data\"", "Frame value"));
+
+		std::string batch(FRAME_HEADER_SIZE, '\0');
+		(void)WriteHeader(batch.data(), Frame::Batch, {});
+		const uint32_t count{ 2 };
+		std::memcpy(batch.data() + 1, &count, sizeof(count));
+		batch += buffer;
+		batch += buffer;
+
+		Decoder batchDecoder{ toSpan(batch) };
+		readUids.clear();
+		RETURN_IF_FALSE(t.Assert(batchDecoder.ReadHeader(frame, readUids), true, "Batch header is read"));
+		RETURN_IF_FALSE(t.Assert(U(frame), U(Frame::Batch), "Frame kind is batch"));
+		RETURN_IF_FALSE(t.Assert(readUids, std::vector<uint64_t>{ 2 }, "Batch count"));
+		for (uint32_t index{ 0 }; index < count; ++index) {
+			readUids.clear();
+			json.clear();
+			RETURN_IF_FALSE(t.Assert(batchDecoder.ReadHeader(frame, readUids) && batchDecoder.ReadJson(json), true,
+				std::format("Batch frame {} is read", index)));
+			RETURN_IF_FALSE(t.Assert(json, "\"data\"", std::format("Batch frame {} value", index)));
+		}
+		RETURN_IF_FALSE(t.Assert(batchDecoder.IsEnd(), true, "Batch is read"));
+
+		Decoder truncated{ toSpan(buffer).first(FRAME_HEADER_SIZE + sizeof(uint64_t)) };
+		readUids.clear();
+		RETURN_IF_FALSE(t.Assert(truncated.ReadHeader(frame, readUids), false, "Truncated header is rejected"));
+	}
+
+	{
+		// Producer writes the same value in both encodings
+		const auto produce{ [](auto& encoder) {
+			encoder.BeginObject();
+			encoder.Key("int8");
+			encoder.Add(int8_t{ -5 });
+			encoder.Key("uint64");
+			encoder.Add(uint64_t{ 18446744073709551615ULL });
+			encoder.Key("double");
+			encoder.Add(1.5);
+			encoder.Key("nan");
+			encoder.Add(std::numeric_limits<float>::infinity());
+			encoder.Key("k\"");
+			encoder.Add(std::string_view{ "q\"\\\n\x01" });
+			encoder.Key("array");
+			encoder.BeginArray();
+			encoder.Add(true);
+			encoder.AddNull();
+			encoder.Add(std::string_view{});
+			encoder.BeginArray();
+			encoder.EndArray();
+			encoder.BeginObject();
+			encoder.EndObject();
+			encoder.Add(int32_t{ 7 });
+			encoder.EndArray();
+			encoder.EndObject();
+		} };
+		static_assert(Producer<decltype(produce)>, "Generic lambda is producer");
+		static_assert(!Producer<std::string_view>, "String view is not producer");
+
+		std::string json;
+		JsonEncoder jsonEncoder{ json };
+		produce(jsonEncoder);
+		RETURN_IF_FALSE(t.Assert(json,
+			"{\"int8\":-5,\"uint64\":18446744073709551615,\"double\":1.5,\"nan\":null,"
+			"\"k\\\"\":\"q\\\"\\\\\\n\\u0001\","
+			"\"array\":[true,null,\"\",[],{},7]}",
+			"Json encoder text"));
+		RETURN_IF_FALSE(t.Assert(Json{ json }.Valid(), true, "Json encoder text is valid json"));
+
+		std::string buffer;
+		Encoder encoder{ buffer };
+		produce(encoder);
+		Decoder decoder{ toSpan(buffer) };
+		std::string decoded;
+		RETURN_IF_FALSE(t.Assert(decoder.ReadJson(decoded), true, "Produced value is decoded"));
+		RETURN_IF_FALSE(t.Assert(decoded, json, "Decoded value is equal to json encoder text"));
+
+		std::string scalars;
+		JsonEncoder scalarsEncoder{ scalars };
+		scalarsEncoder.Add(uint8_t{ 200 });
+		scalarsEncoder.Add(0.25f);
+		scalarsEncoder.Add(false);
+		RETURN_IF_FALSE(t.Assert(scalars, "200,0.25,false", "Sequential values are separated"));
+	}
+
+	{
+		// Benchmark of producer against parsing of json text
+		constexpr size_t iterations{ 20000 };
+		const auto measure{ [](const auto& function) {
+			const auto begin{ MSAPI::FastClock::GetTicks() };
+			function();
+			return static_cast<double>(MSAPI::FastClock::GetElapsed(begin)) / iterations;
+		} };
+
+		// Keys are ordered as parsed json stores them, so both ways are decoded equally
+		const auto produce{ [](auto& encoder) {
+			encoder.BeginObject();
+			encoder.Key("created");
+			encoder.BeginArray();
+			for (int32_t index{}; index < 8; ++index) {
+				encoder.BeginObject();
+				encoder.Key("creation time");
+				encoder.Add(std::string_view{ "2026-10-18 12:00:00.000000000" });
+				encoder.Key("pid");
+				encoder.Add(100000 + index);
+				encoder.Key("port");
+				encoder.Add(3000 + index);
+				encoder.Key("type");
+				encoder.Add(std::string_view{ "Manager" });
+				encoder.EndObject();
+			}
+			encoder.EndArray();
+			encoder.EndObject();
+		} };
+
+		std::string json;
+		JsonEncoder jsonEncoder{ json };
+		produce(jsonEncoder);
+
+		std::string parsed;
+		std::string produced;
+		const auto parsing{ measure([&json, &parsed]() {
+			for (size_t index{ 0 }; index < iterations; ++index) {
+				parsed.clear();
+				Encoder encoder{ parsed };
+				(void)encoder.AddJson(json);
+			}
+		}) };
+		const auto producing{ measure([&produce, &produced]() {
+			for (size_t index{ 0 }; index < iterations; ++index) {
+				produced.clear();
+				Encoder encoder{ produced };
+				produce(encoder);
+			}
+		}) };
+		LOG_INFO_NEW("Binary encoding of {} bytes json, parsing: {:.1f} ns, producer: {:.1f} ns, ratio: {:.2f}",
+			json.size(), parsing, producing, parsing / producing);
+
+		std::string parsedJson;
+		std::string producedJson;
+		Decoder parsedDecoder{ toSpan(parsed) };
+		Decoder producedDecoder{ toSpan(produced) };
+		RETURN_IF_FALSE(t.Assert(parsedDecoder.ReadJson(parsedJson) && producedDecoder.ReadJson(producedJson), true,
+			"Benchmark values are decoded"));
+		RETURN_IF_FALSE(t.Assert(producedJson, parsedJson, "Producer and parsed json are decoded equally"));
+		RETURN_IF_FALSE(t.Assert(producedJson, json, "Producer json text is decoded back"));
+	}
+
+	return true;
+}
+
+} // namespace Unit
+
+} // namespace Tests
+
+} // namespace MSAPI
+
+#endif // MSAPI_UNIT_TEST_EVENTS_BINARY_INL
@@ -0,0 +1,582 @@
+/**************************
+ * @file        eventsDistributor.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef MSAPI_UNIT_TEST_EVENTS_DISTRIBUTOR_INL
+#define MSAPI_UNIT_TEST_EVENTS_DISTRIBUTOR_INL
+
+#include "../../../../library/source/protocol/webSocketEvents.inl"
+#include "../../../../library/source/test/test.h"
+#include <atomic>
+#include <optional>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+
+namespace MSAPI {
+
+namespace Tests {
+
+namespace Unit {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Unit test for events distributor of WebSocket events protocol.
+ *
+ * @return True if all tests passed and false if something went wrong.
+ */
+[[nodiscard]] bool EventsDistributor();
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+bool EventsDistributor()
+{
+	LOG_INFO_UNITTEST("MSAPI Events distributor");
+	MSAPI::Test t;
+
+	using namespace MSAPI::Protocol::WebSocket::Events;
+
+	/**************************
+	 * @brief Authorization module which grants any access.
+	 */
+	struct Authorization {
+		enum class grade_t : int16_t { Any };
+
+		[[nodiscard]] bool IsAccessGranted(
+			[[maybe_unused]] const int32_t connection, [[maybe_unused]] const grade_t grade) const noexcept
+		{
+			return true;
+		}
+	};
+
+	using distributor_t = SinglesDistributor<Authorization>;
+	using filter_t = distributor_t::filter_t;
+	constexpr uint64_t hash{ 1 };
+
+	// Server frames are not masked, payload size is limited by 64 KiB in tests
+	const auto readFrame{ [](const int socket, const int timeoutMs = 0) -> std::optional<std::string> {
+		const auto readExactly{ [socket](char* buffer, size_t size) {
+			while (size > 0) {
+				const auto result{ read(socket, buffer, size) };
+				if (result <= 0) {
+					return false;
+				}
+				buffer += result;
+				size -= static_cast<size_t>(result);
+			}
+			return true;
+		} };
+
+		pollfd descriptor{ socket, POLLIN, 0 };
+		if (poll(&descriptor, 1, timeoutMs) != 1) {
+			return std::nullopt;
+		}
+
+		std::array<char, 2> header;
+		if (!readExactly(header.data(), header.size())) {
+			return std::nullopt;
+		}
+		size_t size{ static_cast<uint8_t>(header[1]) & 0x7Fu };
+		if (size == 126) {
+			uint16_t extended;
+			if (!readExactly(reinterpret_cast<char*>(&extended), sizeof(extended))) {
+				return std::nullopt;
+			}
+			size = be16toh(extended);
+		}
+
+		std::string payload(size, '\0');
+		if (!readExactly(payload.data(), payload.size())) {
+			return std::nullopt;
+		}
+		return payload;
+	} };
+
+	Authorization authorization;
+
+	{
+		// Batching
+		int sockets[2];
+		RETURN_IF_FALSE(t.Assert(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0, "Socket pair is created"));
+
+		distributor_t distributor{ authorization };
+		distributor.SetHandlerWithoutPermissions(
+			hash, [](std::string&, const Single&) { return HandleResult::Delay; });
+		distributor.Collect(1, hash, sockets[0], Json{ "{\"filter\":7}" });
+		const filter_t filter{ hash, IdentityFilter{ 7 } };
+
+		RETURN_IF_FALSE(t.Assert(distributor.IsBatching(), false, "Batching is disabled by default"));
+		RETURN_IF_FALSE(t.Assert(distributor.StartBatching(0, 1024), false, "Batching window cannot be 0"));
+		RETURN_IF_FALSE(t.Assert(distributor.StartBatching(1000, 1023), false, "Batch size limit cannot be small"));
+		RETURN_IF_FALSE(t.Assert(distributor.StartBatching(10000000, 1024), true, "Batching is started"));
+		RETURN_IF_FALSE(t.Assert(distributor.StartBatching(1000, 1024), false, "Batching cannot be started twice"));
+		RETURN_IF_FALSE(t.Assert(distributor.IsBatching(), true, "Batching is enabled"));
+
+		RETURN_IF_FALSE(t.Assert(distributor.SendData(filter, std::string_view{ "1" }), SendResult::Success,
+			"First data is sent to batch"));
+		RETURN_IF_FALSE(t.Assert(distributor.SendData(filter, std::string_view{ "[2]" }), SendResult::Success,
+			"Second data is sent to batch"));
+		RETURN_IF_FALSE(t.Assert(readFrame(sockets[1]).has_value(), false, "Batch is pending within window"));
+		distributor.FlushBatches();
+		RETURN_IF_FALSE(t.Assert(readFrame(sockets[1]).value_or("<none>"),
+			"{\"batch\":[{\"uids\":[1],\"data\":1},{\"uids\":[1],\"data\":[2]}]}", "Batch frame"));
+
+		RETURN_IF_FALSE(t.Assert(distributor.SendData(filter, std::string_view{ "3" }), SendResult::Success,
+			"Single data is sent to batch"));
+		distributor.FlushBatches();
+		RETURN_IF_FALSE(t.Assert(
+			readFrame(sockets[1]).value_or("<none>"), "{\"uids\":[1],\"data\":3}", "Single entry is sent as plain"));
+		distributor.FlushBatches();
+		RETURN_IF_FALSE(t.Assert(readFrame(sockets[1]).has_value(), false, "Empty batch is not sent"));
+
+		const std::string large{ std::format("\"{}\"", std::string(600, 'x')) };
+		RETURN_IF_FALSE(t.Assert(distributor.SendData(filter, std::string_view{ large }), SendResult::Success,
+			"First large data is sent to batch"));
+		RETURN_IF_FALSE(t.Assert(readFrame(sockets[1]).has_value(), false, "Batch below size limit is pending"));
+		RETURN_IF_FALSE(t.Assert(distributor.SendData(filter, std::string_view{ large }), SendResult::Success,
+			"Second large data is sent to batch"));
+		RETURN_IF_FALSE(t.Assert(readFrame(sockets[1]).value_or("<none>"),
+			std::format("{{\"batch\":[{{\"uids\":[1],\"data\":{0}}},{{\"uids\":[1],\"data\":{0}}}]}}", large),
+			"Batch is sent on size limit"));
+
+		const std::string document{ std::format("{{\"a\":1,\"b\":\"{}\"}}", std::string(64, 'y')) };
+		const std::string changed{ std::format("{{\"a\":2,\"b\":\"{}\"}}", std::string(64, 'y')) };
+		RETURN_IF_FALSE(t.Assert(distributor.SendPatch(filter, std::string_view{ document }), SendResult::Success,
+			"Document is sent to batch"));
+		RETURN_IF_FALSE(t.Assert(distributor.SendPatch(filter, std::string_view{ changed }), SendResult::Success,
+			"Patch is sent to batch"));
+		RETURN_IF_FALSE(t.Assert(readFrame(sockets[1]).has_value(), false, "Patches are pending within window"));
+		distributor.FlushBatches();
+		RETURN_IF_FALSE(t.Assert(readFrame(sockets[1]).value_or("<none>"),
+			std::format("{{\"batch\":[{{\"uids\":[1],\"data\":{}}},{{\"uids\":[1],\"patch\":[{{\"op\":\"replace\","
+						"\"path\":\"/a\",\"value\":2}}]}}]}}",
+				document),
+			"Patches are batched"));
+
+		RETURN_IF_FALSE(t.Assert(distributor.SendData(filter, std::string_view{ "4" }), SendResult::Success,
+			"Data is sent to batch before stop"));
+		Timer start;
+		distributor.StopBatching();
+		RETURN_IF_FALSE(t.Assert(
+			(Timer{} - start).GetMilliseconds() < 1000, true, "Stop wakes up flusher waiting for the window"));
+		RETURN_IF_FALSE(t.Assert(distributor.IsBatching(), false, "Batching is stopped"));
+		RETURN_IF_FALSE(
+			t.Assert(readFrame(sockets[1]).value_or("<none>"), "{\"uids\":[1],\"data\":4}", "Batch is sent at stop"));
+
+		RETURN_IF_FALSE(t.Assert(distributor.SendData(filter, std::string_view{ "5" }), SendResult::Success,
+			"Data is sent without batching"));
+		RETURN_IF_FALSE(t.Assert(
+			readFrame(sockets[1]).value_or("<none>"), "{\"uids\":[1],\"data\":5}", "Data is sent immediately"));
+
+		RETURN_IF_FALSE(t.Assert(distributor.StartBatching(10000, 1024), true, "Batching is started again"));
+		RETURN_IF_FALSE(t.Assert(distributor.SendData(filter, std::string_view{ "6" }), SendResult::Success,
+			"Data is sent to batch of short window"));
+		RETURN_IF_FALSE(t.Assert(readFrame(sockets[1], 1000).value_or("<none>"), "{\"uids\":[1],\"data\":6}",
+			"Batch is sent by flusher"));
+		RETURN_IF_FALSE(t.Assert(distributor.SendData(filter, std::string_view{ "7" }), SendResult::Success,
+			"Data is sent to batch after flusher is parked"));
+		RETURN_IF_FALSE(t.Assert(readFrame(sockets[1], 1000).value_or("<none>"), "{\"uids\":[1],\"data\":7}",
+			"Batch is sent by woken up flusher"));
+
+		RETURN_IF_FALSE(t.Assert(distributor.GetEventsData(sockets[0])->GetEncoding(), Encoding::Json,
+			"Json encoding is used by default"));
+		distributor.GetEventsData(sockets[0])->SetEncoding(Encoding::Binary);
+		RETURN_IF_FALSE(t.Assert(
+			distributor.GetEventsData(sockets[0])->GetEncoding(), Encoding::Binary, "Binary encoding is set"));
+		RETURN_IF_FALSE(t.Assert(distributor.SendData(filter, std::string_view{ "8" }), SendResult::Success,
+			"Binary data is sent to batch"));
+		RETURN_IF_FALSE(t.Assert(distributor.SendData(filter, std::string_view{ "9" }), SendResult::Success,
+			"Second binary data is sent to batch"));
+		distributor.StopBatching();
+		const auto binary{ readFrame(sockets[1]).value_or("") };
+		RETURN_IF_FALSE(t.Assert(binary.size() > Binary::FRAME_HEADER_SIZE, true, "Binary batch is sent"));
+		RETURN_IF_FALSE(
+			t.Assert(static_cast<uint8_t>(binary[0]), static_cast<uint8_t>(Binary::Frame::Batch), "Binary batch kind"));
+		uint32_t count{};
+		std::memcpy(&count, binary.data() + 1, sizeof(count));
+		RETURN_IF_FALSE(t.Assert(count, uint32_t{ 2 }, "Binary batch entries"));
+
+		// Producer writes data directly into encoder of each encoding
+		const auto produce{ [](auto& encoder) {
+			encoder.BeginObject();
+			encoder.Key("value");
+			encoder.Add(10);
+			encoder.EndObject();
+		} };
+		RETURN_IF_FALSE(t.Assert(
+			distributor.SendData(filter, produce), SendResult::Success, "Producer data is sent to binary connection"));
+		const auto produced{ readFrame(sockets[1]).value_or("") };
+		Binary::Decoder decoder{ std::span<const uint8_t>{
+			reinterpret_cast<const uint8_t*>(produced.data()), produced.size() } };
+		Binary::Frame frame{ Binary::Frame::Undefined };
+		std::vector<uint64_t> uids;
+		std::string json;
+		RETURN_IF_FALSE(t.Assert(decoder.ReadHeader(frame, uids) && decoder.ReadJson(json), true,
+			"Binary producer data is decoded"));
+		RETURN_IF_FALSE(t.Assert(uids, std::vector<uint64_t>{ 1 }, "Binary producer data uids"));
+		RETURN_IF_FALSE(t.Assert(json, "{\"value\":10}", "Binary producer data"));
+
+		distributor.GetEventsData(sockets[0])->SetEncoding(Encoding::Json);
+		RETURN_IF_FALSE(
+			t.Assert(distributor.GetEventsData(sockets[0])->GetEncoding(), Encoding::Json, "Json encoding is set"));
+		RETURN_IF_FALSE(t.Assert(
+			distributor.SendData(filter, produce), SendResult::Success, "Producer data is sent to json connection"));
+		RETURN_IF_FALSE(t.Assert(readFrame(sockets[1]).value_or("<none>"), "{\"uids\":[1],\"data\":{\"value\":10}}",
+			"Json producer data"));
+
+		close(sockets[0]);
+		close(sockets[1]);
+	}
+
+	{
+		// Destruction sends pending batch
+		int sockets[2];
+		RETURN_IF_FALSE(t.Assert(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0, "Socket pair is created"));
+		const filter_t filter{ hash, IdentityFilter{ 7 } };
+		{
+			distributor_t distributor{ authorization };
+			distributor.SetHandlerWithoutPermissions(
+				hash, [](std::string&, const Single&) { return HandleResult::Delay; });
+			distributor.Collect(1, hash, sockets[0], Json{ "{\"filter\":7}" });
+			{
+				const auto data{ distributor.GetEventsData(sockets[0]) };
+				const auto events{ data->GetEvents<distributor_t::EventsData::lookup>(filter) };
+				RETURN_IF_FALSE(t.Assert(
+					events != nullptr && &events->GetData() == data.get(), true, "Events refer to their events data"));
+			}
+
+			RETURN_IF_FALSE(t.Assert(distributor.StartBatching(10000000, 1024), true, "Batching is started"));
+			RETURN_IF_FALSE(t.Assert(distributor.SendData(filter, std::string_view{ "1" }), SendResult::Success,
+				"Data is sent to batch before destruction"));
+			RETURN_IF_FALSE(t.Assert(readFrame(sockets[1]).has_value(), false, "Batch is pending within window"));
+		}
+		RETURN_IF_FALSE(t.Assert(
+			readFrame(sockets[1]).value_or("<none>"), "{\"uids\":[1],\"data\":1}", "Batch is sent at destruction"));
+
+		close(sockets[0]);
+		close(sockets[1]);
+	}
+
+	{
+		// Concurrent start of batching creates one flusher
+		distributor_t distributor{ authorization };
+		std::atomic<size_t> started{};
+		std::vector<std::thread> threads;
+		for (size_t index{ 0 }; index < 8; ++index) {
+			threads.emplace_back([&distributor, &started]() {
+				const bool isStarted{ distributor.StartBatching(1000, 1024) };
+				started.fetch_add(static_cast<size_t>(isStarted), std::memory_order_relaxed);
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		RETURN_IF_FALSE(t.Assert(started.load(), size_t{ 1 }, "Batching is started by one of concurrent calls"));
+		distributor.StopBatching();
+		RETURN_IF_FALSE(t.Assert(distributor.IsBatching(), false, "Batching is stopped"));
+	}
+
+	{
+		// Filter index
+		int first[2];
+		int second[2];
+		RETURN_IF_FALSE(t.Assert(socketpair(AF_UNIX, SOCK_STREAM, 0, first), 0, "First socket pair is created"));
+		RETURN_IF_FALSE(t.Assert(socketpair(AF_UNIX, SOCK_STREAM, 0, second), 0, "Second socket pair is created"));
+
+		distributor_t distributor{ authorization };
+		distributor.SetHandlerWithoutPermissions(
+			hash, [](std::string&, const Single&) { return HandleResult::Delay; });
+		const filter_t filter{ hash, IdentityFilter{ 7 } };
+		const filter_t other{ hash, IdentityFilter{ 8 } };
+		const auto connections{ [&distributor](const filter_t& filter) {
+			std::vector<int32_t> result;
+			if (const auto holders{ distributor.GetEventsArray(filter) }; holders != nullptr) {
+				for (const auto& holder : *holders) {
+					result.emplace_back(holder.data->GetConnection());
+				}
+			}
+			return result;
+		} };
+
+		RETURN_IF_FALSE(t.Assert(distributor.GetEventsArray(filter) == nullptr, true, "Index is empty"));
+		distributor.Collect(1, hash, first[0], Json{ "{\"filter\":7}" });
+		RETURN_IF_FALSE(
+			t.Assert(connections(filter), std::vector<int32_t>{ first[0] }, "Events are indexed on first event"));
+		{
+			const auto data{ distributor.GetEventsData(first[0]) };
+			const auto events{ data->GetEvents<distributor_t::EventsData::lookup>(filter) };
+			RETURN_IF_FALSE(t.Assert(events != nullptr && events->GetFilter() == filter, true, "Events keep filter"));
+			RETURN_IF_FALSE(
+				t.Assert(&data->GetDistributor() == &distributor, true, "Events data refers to its distributor"));
+		}
+		distributor.Collect(2, hash, first[0], Json{ "{\"filter\":7}" });
+		RETURN_IF_FALSE(t.Assert(connections(filter), std::vector<int32_t>{ first[0] }, "Events are indexed once"));
+		distributor.Collect(3, hash, second[0], Json{ "{\"filter\":7}" });
+		RETURN_IF_FALSE(t.Assert(connections(filter), std::vector<int32_t>{ first[0], second[0] },
+			"Events of other connection are indexed"));
+		distributor.Collect(4, hash, first[0], Json{ "{\"filter\":8}" });
+		RETURN_IF_FALSE(
+			t.Assert(connections(other), std::vector<int32_t>{ first[0] }, "Events of other filter are indexed"));
+
+		distributor.Collect(1, hash, first[0], Json{ "{\"interrupt\":true}" });
+		RETURN_IF_FALSE(t.Assert(connections(filter), std::vector<int32_t>{ first[0], second[0] },
+			"Events with remaining event stay indexed"));
+		distributor.Collect(2, hash, first[0], Json{ "{\"interrupt\":true}" });
+		RETURN_IF_FALSE(
+			t.Assert(connections(filter), std::vector<int32_t>{ second[0] }, "Empty events are unindexed"));
+		RETURN_IF_FALSE(
+			t.Assert(connections(other), std::vector<int32_t>{ first[0] }, "Events of other filter stay indexed"));
+		distributor.Collect(5, hash, first[0], Json{ "{\"filter\":7}" });
+		RETURN_IF_FALSE(t.Assert(connections(filter), std::vector<int32_t>{ second[0], first[0] },
+			"Events are indexed again"));
+
+		distributor.ClearActiveEventsForConnection(first[0]);
+		RETURN_IF_FALSE(t.Assert(
+			connections(filter), std::vector<int32_t>{ second[0] }, "Events data is unindexed from filter"));
+		RETURN_IF_FALSE(
+			t.Assert(distributor.GetEventsArray(other) == nullptr, true, "Events data is unindexed from other filter"));
+
+		const auto data{ distributor.GetEventsData(second[0]) };
+		distributor.ClearActiveEventsForConnection(second[0]);
+		RETURN_IF_FALSE(t.Assert(distributor.GetEventsArray(filter) == nullptr, true, "Index is empty after clear"));
+		{
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::read> _{ data->GetLock() };
+			RETURN_IF_FALSE(t.Assert(data->IsClosed(), true, "Removed events data is closed"));
+		}
+		const auto size{ data->GetEventsSize() };
+		data->GetEvents<distributor_t::EventsData::create>(filter)->AddEvent(
+			Single{ 6, std::shared_ptr<Single::HandlerData>{}, Json{ "{}" }, second[0] });
+		RETURN_IF_FALSE(
+			t.Assert(distributor.GetEventsArray(filter) == nullptr, true, "Closed events data is not indexed again"));
+		RETURN_IF_FALSE(t.Assert(data->GetEventsSize(), size, "Event is not added to closed events data"));
+
+		distributor.Collect(7, hash, second[0], Json{ "{\"filter\":7}" });
+		RETURN_IF_FALSE(t.Assert(
+			connections(filter), std::vector<int32_t>{ second[0] }, "New events data of the connection is indexed"));
+		const auto renewed{ distributor.GetEventsData(second[0]) };
+		RETURN_IF_FALSE(t.Assert(renewed != data, true, "Events data of the connection is renewed"));
+
+		distributor.FailActiveEvents("Stopped");
+		RETURN_IF_FALSE(t.Assert(distributor.GetEventsArray(filter) == nullptr, true, "Failed events are unindexed"));
+		{
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::read> _{ renewed->GetLock() };
+			RETURN_IF_FALSE(t.Assert(renewed->IsClosed(), true, "Failed events data is closed"));
+		}
+		RETURN_IF_FALSE(t.Assert(readFrame(second[1]).value_or("<none>"),
+			"{\"uids\":[7],\"state\":4,\"error\":\"Stopped\"}", "Event is failed"));
+
+		for (const int socket : { first[0], first[1], second[0], second[1] }) {
+			close(socket);
+		}
+	}
+
+	{
+		// Patch
+		int first[2];
+		int second[2];
+		RETURN_IF_FALSE(t.Assert(socketpair(AF_UNIX, SOCK_STREAM, 0, first), 0, "First socket pair is created"));
+		RETURN_IF_FALSE(t.Assert(socketpair(AF_UNIX, SOCK_STREAM, 0, second), 0, "Second socket pair is created"));
+
+		distributor_t distributor{ authorization };
+		distributor.SetHandlerWithoutPermissions(
+			hash, [](std::string&, const Single&) { return HandleResult::Delay; });
+		const filter_t filter{ hash, IdentityFilter{ 7 } };
+		const std::string_view document{ "{\"value\":1,\"description\":\"document which is longer than patch\"}" };
+		const std::string_view changed{ "{\"value\":2,\"description\":\"document which is longer than patch\"}" };
+		const std::string_view again{ "{\"value\":3,\"description\":\"document which is longer than patch\"}" };
+
+		distributor.Collect(1, hash, first[0], Json{ "{\"filter\":7}" });
+		RETURN_IF_FALSE(
+			t.Assert(distributor.SendPatch(filter, document), SendResult::Success, "Document is sent to first"));
+		RETURN_IF_FALSE(t.Assert(readFrame(first[1]).value_or("<none>"),
+			std::format("{{\"uids\":[1],\"data\":{}}}", document), "First receives whole document"));
+
+		// Uid of second connection is equal to synchronized uid of first, but second has not received document yet
+		distributor.Collect(1, hash, second[0], Json{ "{\"filter\":7}" });
+		RETURN_IF_FALSE(
+			t.Assert(distributor.SendPatch(filter, changed), SendResult::Success, "Changed document is sent"));
+		RETURN_IF_FALSE(t.Assert(readFrame(first[1]).value_or("<none>"),
+			"{\"uids\":[1],\"patch\":[{\"op\":\"replace\",\"path\":\"/value\",\"value\":2}]}",
+			"First receives patch"));
+		RETURN_IF_FALSE(t.Assert(readFrame(second[1]).value_or("<none>"),
+			std::format("{{\"uids\":[1],\"data\":{}}}", changed), "Second with equal uid receives whole document"));
+
+		RETURN_IF_FALSE(t.Assert(distributor.SendPatch(filter, again), SendResult::Success, "Next document is sent"));
+		const std::string_view patch{
+			"{\"uids\":[1],\"patch\":[{\"op\":\"replace\",\"path\":\"/value\",\"value\":3}]}" };
+		RETURN_IF_FALSE(t.Assert(readFrame(first[1]).value_or("<none>"), patch, "First receives next patch"));
+		RETURN_IF_FALSE(
+			t.Assert(readFrame(second[1]).value_or("<none>"), patch, "Second receives patch once synchronized"));
+
+		// Concurrent patches are sent outside of lock, each of them is delivered once
+		constexpr size_t threadsSize{ 4 };
+		constexpr size_t sendsSize{ 25 };
+		std::atomic<size_t> sent{};
+		std::vector<std::thread> threads;
+		for (size_t index{ 0 }; index < threadsSize; ++index) {
+			threads.emplace_back([&distributor, &filter, &sent, index]() {
+				for (size_t send{ 0 }; send < sendsSize; ++send) {
+					const auto value{ std::format(
+						"{{\"value\":{},\"description\":\"document which is longer than patch\"}}",
+						index * 100 + send) };
+					if (distributor.SendPatch(filter, std::string_view{ value }) == SendResult::Success) {
+						sent.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		RETURN_IF_FALSE(t.Assert(sent.load(), threadsSize * sendsSize, "Concurrent patches are sent"));
+		size_t received{ 0 };
+		while (readFrame(first[1]).has_value()) {
+			++received;
+		}
+		RETURN_IF_FALSE(t.Assert(received, threadsSize * sendsSize, "Each concurrent patch is delivered once"));
+
+		// State of document is forgotten without events, so resubscribed uid of the same connection is not patched
+		distributor.ClearActiveEventsForConnection(first[0]);
+		distributor.ClearActiveEventsForConnection(second[0]);
+		RETURN_IF_FALSE(
+			t.Assert(distributor.SendPatch(filter, document), SendResult::Nothing, "Document without events"));
+		distributor.Collect(1, hash, first[0], Json{ "{\"filter\":7}" });
+		RETURN_IF_FALSE(t.Assert(distributor.SendPatch(filter, changed), SendResult::Success,
+			"Document is sent to resubscribed event"));
+		RETURN_IF_FALSE(t.Assert(readFrame(first[1]).value_or("<none>"),
+			std::format("{{\"uids\":[1],\"data\":{}}}", changed), "Resubscribed event receives whole document"));
+
+		distributor.ClearActiveEventsForConnection(first[0]);
+		for (const int socket : { first[0], first[1], second[0], second[1] }) {
+			close(socket);
+		}
+	}
+
+	{
+		// Limit and purging
+		distributor_t distributor{ authorization };
+		constexpr int32_t connection{ 1000001 };
+		const filter_t filter{ hash, IdentityFilter{ 7 } };
+		const filter_t other{ hash, IdentityFilter{ 8 } };
+		const auto data{ distributor.GetEventsData(connection) };
+		const auto add{ [&data](const filter_t& filter, const uint64_t uid) {
+			data->GetEvents<distributor_t::EventsData::create>(filter)->AddEvent(
+				Single{ uid, std::shared_ptr<Single::HandlerData>{}, Json{ "{}" }, connection });
+		} };
+		const auto uids{ [&data](const filter_t& filter) {
+			std::vector<uint64_t> result;
+			const auto events{ data->GetEvents<distributor_t::EventsData::lookup>(filter) };
+			if (events == nullptr) {
+				return result;
+			}
+
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::read> _{ events->GetLock() };
+			for (const auto* node{ events->GetHead() }; node != nullptr; node = node->ownerNext) {
+				result.emplace_back(node->event->GetUid());
+			}
+			return result;
+		} };
+		const auto range{ [](const uint64_t from, const uint64_t to, const uint64_t step = 1) {
+			std::vector<uint64_t> result;
+			for (uint64_t uid{ from }; uid <= to; uid += step) {
+				result.emplace_back(uid);
+			}
+			return result;
+		} };
+
+		RETURN_IF_FALSE(t.Assert(data->GetLimit(), 1024, "Default limit"));
+		RETURN_IF_FALSE(t.Assert(data->GetPurgingCoefficient(), 0.3f, "Default purging coefficient"));
+		RETURN_IF_FALSE(t.Assert(data->SetLimit(63), false, "Limit cannot be less than 64"));
+		RETURN_IF_FALSE(t.Assert(data->SetLimit(1024), false, "Same limit is not set"));
+		RETURN_IF_FALSE(t.Assert(data->SetPurgingCoefficient(0.01f), false, "Coefficient cannot be less than 5%"));
+		RETURN_IF_FALSE(
+			t.Assert(data->SetPurgingCoefficient(1.0f), false, "Coefficient cannot be greater than 99%"));
+		RETURN_IF_FALSE(t.Assert(data->SetPurgingCoefficient(0.3f), false, "Same coefficient is not set"));
+		RETURN_IF_FALSE(t.Assert(data->SetPurgingCoefficient(0.1f), true, "Coefficient is set"));
+		RETURN_IF_FALSE(t.Assert(data->GetPurgingCoefficient(), 0.1f, "Coefficient is changed"));
+		RETURN_IF_FALSE(t.Assert(data->SetLimit(64), true, "Limit is set"));
+		RETURN_IF_FALSE(t.Assert(data->GetLimit(), 64, "Limit is changed"));
+
+		for (uint64_t uid{ 1 }; uid <= 64; ++uid) {
+			add(uid % 2 == 0 ? other : filter, uid);
+		}
+		RETURN_IF_FALSE(t.Assert(data->GetEventsSize(), 64, "Events up to limit are stored"));
+		RETURN_IF_FALSE(t.Assert(uids(filter), range(1, 63, 2), "Events of filter are in adding order"));
+		RETURN_IF_FALSE(t.Assert(uids(other), range(2, 64, 2), "Events of other filter are in adding order"));
+
+		// Exceeding by 1 purges 1 + 64 * 0.1 oldest events regardless of their filter
+		add(filter, 65);
+		RETURN_IF_FALSE(t.Assert(data->GetEventsSize(), 58, "Oldest events are purged on exceeding"));
+		RETURN_IF_FALSE(t.Assert(uids(filter), range(9, 65, 2), "Oldest events of filter are purged"));
+		RETURN_IF_FALSE(t.Assert(uids(other), range(8, 64, 2), "Oldest events of other filter are purged"));
+
+		RETURN_IF_FALSE(t.Assert(data->EraseEvent(30), true, "Event is erased by uid"));
+		RETURN_IF_FALSE(t.Assert(data->EraseEvent(30), false, "Erased event is not found"));
+		auto expected{ range(8, 28, 2) };
+		std::ranges::copy(range(32, 64, 2), std::back_inserter(expected));
+		RETURN_IF_FALSE(t.Assert(uids(other), expected, "Event is unlinked from the middle of filter events"));
+
+		data->EraseEventsByFilter(filter);
+		RETURN_IF_FALSE(t.Assert(data->GetEventsSize(), 28, "Events are erased by filter"));
+		RETURN_IF_FALSE(t.Assert(uids(filter).empty(), true, "Filter events are empty"));
+		RETURN_IF_FALSE(t.Assert(uids(other), expected, "Events of other filter are not affected"));
+		RETURN_IF_FALSE(t.Assert(distributor.GetEventsArray(filter) == nullptr, true, "Erased events are unindexed"));
+
+		// Queue stays in adding order after erasing, so next purge continues from the oldest remaining event
+		for (uint64_t uid{ 66 }; uid <= 101; ++uid) {
+			add(filter, uid);
+		}
+		RETURN_IF_FALSE(t.Assert(data->GetEventsSize(), 64, "Events are stored up to limit again"));
+		add(filter, 102);
+		RETURN_IF_FALSE(t.Assert(data->GetEventsSize(), 58, "Events are purged again"));
+		expected = range(22, 28, 2);
+		std::ranges::copy(range(32, 64, 2), std::back_inserter(expected));
+		RETURN_IF_FALSE(t.Assert(uids(other), expected, "Purging follows adding order across filters"));
+		RETURN_IF_FALSE(t.Assert(uids(filter), range(66, 102), "Newer events of filter are kept"));
+
+		RETURN_IF_FALSE(t.Assert(data->SetPurgingCoefficient(0.5f), true, "Coefficient is increased"));
+		RETURN_IF_FALSE(t.Assert(data->SetLimit(128), true, "Limit is increased"));
+		RETURN_IF_FALSE(t.Assert(data->GetEventsSize(), 58, "Increasing limit does not purge"));
+		RETURN_IF_FALSE(t.Assert(data->SetLimit(100), true, "Limit is decreased above size"));
+		RETURN_IF_FALSE(t.Assert(data->GetEventsSize(), 58, "Decreasing limit above size does not purge"));
+		for (uint64_t uid{ 103 }; uid <= 110; ++uid) {
+			add(other, uid);
+		}
+		RETURN_IF_FALSE(t.Assert(data->GetEventsSize(), 66, "Events are added over limit"));
+		RETURN_IF_FALSE(t.Assert(data->SetLimit(65), true, "Limit is decreased below size"));
+		// 66 - 65 + 65 * 0.5 = 33 oldest events are purged
+		RETURN_IF_FALSE(t.Assert(data->GetEventsSize(), 33, "Decreasing limit below size purges with coefficient"));
+		RETURN_IF_FALSE(t.Assert(uids(other), range(103, 110), "Oldest events of other filter are purged"));
+		RETURN_IF_FALSE(t.Assert(uids(filter), range(78, 102), "Oldest events of filter are purged"));
+	}
+
+	return true;
+}
+
+} // namespace Unit
+
+} // namespace Tests
+
+} // namespace MSAPI
+
+#endif // MSAPI_UNIT_TEST_EVENTS_DISTRIBUTOR_INL
@@ -0,0 +1,125 @@
+/**************************
+ * @file        eventsPatch.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef MSAPI_UNIT_TEST_EVENTS_PATCH_INL
+#define MSAPI_UNIT_TEST_EVENTS_PATCH_INL
+
+#include "../../../../library/source/protocol/webSocketEventsPatch.inl"
+#include "../../../../library/source/test/test.h"
+
+namespace MSAPI {
+
+namespace Tests {
+
+namespace Unit {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Unit test for structural patch of events protocol documents.
+ *
+ * @return True if all tests passed and false if something went wrong.
+ */
+[[nodiscard]] bool EventsPatch();
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+bool EventsPatch()
+{
+	LOG_INFO_UNITTEST("MSAPI Events patch");
+	MSAPI::Test t;
+
+	using namespace Protocol::WebSocket::Events;
+
+	const auto make{ [](const std::string_view from, const std::string_view to) {
+		std::string patch;
+		const auto operations{ Patch::Make(patch, Json{ from }, Json{ to }) };
+		return std::format("{}:{}", operations, patch);
+	} };
+
+	{
+		// Json text
+		const Json json{ "{\"b\":[1,-2,\"x\",true,null,[],{}],\"a\":{\"c\":1.5},\"d\":\"q\\\"\"}" };
+		std::string text;
+		Patch::AppendJson(text, json);
+		RETURN_IF_FALSE(
+			t.Assert(text, "{\"a\":{\"c\":1.5},\"b\":[1,-2,\"x\",true,null,[],{}],\"d\":\"q\\\"\"}", "Json text"));
+
+		text.clear();
+		Patch::AppendJson(text, Json{ "{}" });
+		RETURN_IF_FALSE(t.Assert(text, "{}", "Empty json text"));
+	}
+
+	{
+		// Equality
+		const Json first{ "{\"a\":[1,{\"b\":2.5}],\"c\":\"d\"}" };
+		RETURN_IF_FALSE(t.Assert(Patch::Equal(first, Json{ "{\"c\":\"d\",\"a\":[1,{\"b\":2.5}]}" }), true,
+			"Objects with same keys and values are equal"));
+		RETURN_IF_FALSE(t.Assert(Patch::Equal(first, Json{ "{\"a\":[1,{\"b\":2.25}],\"c\":\"d\"}" }), false,
+			"Objects with different nested values are not equal"));
+		RETURN_IF_FALSE(t.Assert(Patch::Equal(first, Json{ "{\"a\":[1],\"c\":\"d\"}" }), false,
+			"Objects with different arrays are not equal"));
+		RETURN_IF_FALSE(t.Assert(Patch::Equal(first, Json{ "{\"a\":[1,{\"b\":2.5}]}" }), false,
+			"Objects with different keys are not equal"));
+		RETURN_IF_FALSE(t.Assert(Patch::Equal(JsonNode{ int64_t{ -1 } }, JsonNode{ std::string{ "-1" } }), false,
+			"Nodes of different types are not equal"));
+	}
+
+	{
+		// Patches
+		RETURN_IF_FALSE(t.Assert(make("{\"a\":1,\"b\":[1,2]}", "{\"b\":[1,2],\"a\":1}"), "0:", "Equal documents"));
+		RETURN_IF_FALSE(t.Assert(make("{\"a\":1,\"b\":2}", "{\"a\":3,\"b\":2}"),
+			"1:[{\"op\":\"replace\",\"path\":\"/a\",\"value\":3}]", "Replaced value"));
+		RETURN_IF_FALSE(t.Assert(make("{\"a\":1,\"b\":2}", "{\"b\":2,\"c\":\"text\"}"),
+			"2:[{\"op\":\"remove\",\"path\":\"/a\"},{\"op\":\"add\",\"path\":\"/c\",\"value\":\"text\"}]",
+			"Removed and added keys"));
+		RETURN_IF_FALSE(t.Assert(make("{\"a\":{\"b\":{\"c\":1,\"d\":2}}}", "{\"a\":{\"b\":{\"c\":1,\"d\":3}}}"),
+			"1:[{\"op\":\"replace\",\"path\":\"/a/b/d\",\"value\":3}]", "Nested value"));
+		RETURN_IF_FALSE(t.Assert(make("{\"a\":[1,2,3,4]}", "{\"a\":[1,5]}"),
+			"3:[{\"op\":\"replace\",\"path\":\"/a/1\",\"value\":5},{\"op\":\"remove\",\"path\":\"/a/3\"},"
+			"{\"op\":\"remove\",\"path\":\"/a/2\"}]",
+			"Shortened array is removed from the end"));
+		RETURN_IF_FALSE(t.Assert(make("{\"a\":[1]}", "{\"a\":[1,[2],{\"b\":null}]}"),
+			"2:[{\"op\":\"add\",\"path\":\"/a/1\",\"value\":[2]},{\"op\":\"add\",\"path\":\"/a/2\",\"value\":{\"b\":"
+			"null}}]",
+			"Extended array"));
+		RETURN_IF_FALSE(t.Assert(make("{\"a\":{\"b\":1}}", "{\"a\":[1]}"),
+			"1:[{\"op\":\"replace\",\"path\":\"/a\",\"value\":[1]}]", "Changed type of value"));
+		RETURN_IF_FALSE(t.Assert(make("{\"a/b\":1,\"c~d\":1}", "{\"a/b\":2,\"c~d\":2}"),
+			"2:[{\"op\":\"replace\",\"path\":\"/a~1b\",\"value\":2},"
+			"{\"op\":\"replace\",\"path\":\"/c~0d\",\"value\":2}]",
+			"Escaped keys in path"));
+		RETURN_IF_FALSE(t.Assert(make("{}", "{\"a\":{}}"), "1:[{\"op\":\"add\",\"path\":\"/a\",\"value\":{}}]",
+			"Added empty object"));
+	}
+
+	return true;
+}
+
+} // namespace Unit
+
+} // namespace Tests
+
+} // namespace MSAPI
+
+#endif // MSAPI_UNIT_TEST_EVENTS_PATCH_INL
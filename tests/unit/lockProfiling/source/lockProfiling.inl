@@ -0,0 +1,201 @@
+/**************************
+ * @file        lockProfiling.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef MSAPI_UNIT_TEST_LOCK_PROFILING_INL
+#define MSAPI_UNIT_TEST_LOCK_PROFILING_INL
+
+#include "../../../../library/source/help/pthread.hpp"
+#include "../../../../library/source/test/test.h"
+#include <chrono>
+#include <vector>
+
+namespace MSAPI {
+
+namespace Tests {
+
+namespace Unit {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Unit test for lock contention profiling.
+ *
+ * @return True if all tests passed and false if something went wrong.
+ */
+[[nodiscard]] bool LockProfiling();
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+bool LockProfiling()
+{
+	LOG_INFO_UNITTEST("MSAPI Lock profiling");
+	MSAPI::Test t;
+
+	const auto find{ [](const std::string_view name) {
+		for (auto& site : Pthread::Profiling::Registry::Get().Collect()) {
+			if (site.name == name) {
+				return site;
+			}
+		}
+		return Pthread::Profiling::Statistics{};
+	} };
+	const auto sum{ [](const std::array<uint64_t, Pthread::Profiling::HISTOGRAM_SIZE>& histogram) {
+		uint64_t total{};
+		for (const auto count : histogram) {
+			total += count;
+		}
+		return total;
+	} };
+
+	{
+		// Histogram buckets
+		RETURN_IF_FALSE(t.Assert(Pthread::Profiling::GetBucket(0), size_t{ 0 }, "Zero duration bucket"));
+		RETURN_IF_FALSE(t.Assert(Pthread::Profiling::GetBucket(1), size_t{ 1 }, "One nanosecond bucket"));
+		RETURN_IF_FALSE(t.Assert(Pthread::Profiling::GetBucket(1000), size_t{ 10 }, "Microsecond bucket"));
+		RETURN_IF_FALSE(t.Assert(Pthread::Profiling::GetBucket(INT64_MAX), Pthread::Profiling::HISTOGRAM_SIZE - 1,
+			"Greater durations are in last bucket"));
+
+		std::array<uint64_t, Pthread::Profiling::HISTOGRAM_SIZE> histogram{};
+		RETURN_IF_FALSE(
+			t.Assert(Pthread::Profiling::Statistics::GetPercentile(histogram, 0.5), uint64_t{ 0 }, "Empty p50"));
+		histogram[3] = 98;
+		histogram[10] = 2;
+		RETURN_IF_FALSE(t.Assert(Pthread::Profiling::Statistics::GetPercentile(histogram, 0.5), uint64_t{ 8 }, "p50"));
+		RETURN_IF_FALSE(
+			t.Assert(Pthread::Profiling::Statistics::GetPercentile(histogram, 0.99), uint64_t{ 1024 }, "p99"));
+	}
+
+	{
+		// Uncontended acquisitions of locks with the same name
+		Pthread::AtomicLock first{ "UT::lock" };
+		Pthread::AtomicLock second{ "UT::lock" };
+		for (size_t index{ 0 }; index < 100; ++index) {
+			const Pthread::AtomicLock::ExitGuard _{ first };
+		}
+		for (size_t index{ 0 }; index < 50; ++index) {
+			const Pthread::AtomicLock::ExitGuard _{ second };
+		}
+
+		const auto site{ find("UT::lock") };
+		RETURN_IF_FALSE(t.Assert(site.acquisitions, uint64_t{ 150 }, "Locks with the same name are aggregated"));
+		RETURN_IF_FALSE(t.Assert(site.contended, uint64_t{ 0 }, "Free lock is not contended"));
+		RETURN_IF_FALSE(t.Assert(sum(site.wait), uint64_t{ 150 }, "Wait histogram"));
+		RETURN_IF_FALSE(t.Assert(sum(site.hold), uint64_t{ 150 }, "Hold histogram"));
+
+		RETURN_IF_FALSE(t.Assert(first.TryLock(), true, "Try lock of free lock"));
+		RETURN_IF_FALSE(t.Assert(first.TryLock(), false, "Try lock of taken lock"));
+		first.Unlock();
+		const auto afterTry{ find("UT::lock") };
+		RETURN_IF_FALSE(t.Assert(afterTry.acquisitions, uint64_t{ 151 }, "Successful try lock is acquisition"));
+		RETURN_IF_FALSE(t.Assert(afterTry.contended, uint64_t{ 1 }, "Failed try lock is contended"));
+	}
+
+	{
+		// Contended acquisition from other threads
+		Pthread::AtomicLock lock{ "UT::contended" };
+		std::atomic<bool> isWaiting{ false };
+		lock.Lock();
+		std::thread waiter{ [&lock, &isWaiting]() {
+			isWaiting.store(true);
+			const Pthread::AtomicLock::ExitGuard _{ lock };
+		} };
+		while (!isWaiting.load()) {
+			std::this_thread::yield();
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		lock.Unlock();
+		waiter.join();
+
+		const auto site{ find("UT::contended") };
+		RETURN_IF_FALSE(t.Assert(site.acquisitions, uint64_t{ 2 }, "Counters of finished thread are collected"));
+		RETURN_IF_FALSE(t.Assert(site.contended, uint64_t{ 1 }, "Waiting acquisition is contended"));
+		RETURN_IF_FALSE(t.Assert(site.waitNs >= 1'000'000, true, "Wait time covers holding of other thread"));
+		RETURN_IF_FALSE(t.Assert(site.holdNs >= 10'000'000, true, "Hold time covers holding"));
+	}
+
+	{
+		// Shared and exclusive acquisitions
+		Pthread::AtomicRWLock atomicRWLock{ "UT::atomicRWLock" };
+		Pthread::ScalableRWLock scalableRWLock{ "UT::scalableRWLock" };
+		for (size_t index{ 0 }; index < 10; ++index) {
+			const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ atomicRWLock };
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::read> __{ scalableRWLock };
+		}
+		{
+			const Pthread::AtomicRWLock::ExitGuard<Pthread::write> _{ atomicRWLock };
+		}
+		{
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ scalableRWLock };
+		}
+
+		for (const auto* const name : { "UT::atomicRWLock", "UT::scalableRWLock" }) {
+			const auto site{ find(name) };
+			RETURN_IF_FALSE(t.Assert(site.acquisitions, uint64_t{ 11 }, std::format("{} acquisitions", name)));
+			RETURN_IF_FALSE(t.Assert(sum(site.hold), uint64_t{ 1 }, std::format("{} hold is exclusive only", name)));
+		}
+	}
+
+	{
+		// Named mutex
+		Pthread::NamedMutex<pthread_mutex_t> mutex{ "UT::namedMutex" };
+		RETURN_IF_FALSE(t.Assert(Pthread::PthreadMutexInit(mutex, nullptr), true, "Named mutex is initialized"));
+		{
+			const Pthread::ExitGuard _{ mutex };
+		}
+		RETURN_IF_FALSE(t.Assert(Pthread::PthreadMutexDestroy(mutex), true, "Named mutex is destroyed"));
+
+		const auto site{ find("UT::namedMutex") };
+		RETURN_IF_FALSE(t.Assert(site.acquisitions, uint64_t{ 1 }, "Named mutex acquisitions"));
+		RETURN_IF_FALSE(t.Assert(sum(site.hold), uint64_t{ 1 }, "Named mutex hold"));
+	}
+
+	{
+		// Disabled site and export
+		Pthread::AtomicLock lock{ nullptr };
+		const auto sitesSize{ Pthread::Profiling::Registry::Get().Collect().size() };
+		{
+			const Pthread::AtomicLock::ExitGuard _{ lock };
+		}
+		RETURN_IF_FALSE(t.Assert(Pthread::Profiling::Registry::Get().Collect().size(), sitesSize,
+			"Lock without name is not registered"));
+
+		Pthread::Profiling::table_t table{ 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Pthread::Profiling::Registry::Get().FillTable(table);
+		RETURN_IF_FALSE(t.Assert(table.GetRowsSize(), sitesSize, "Table has row per site"));
+
+		const auto dump{ Pthread::Profiling::Registry::Get().Dump() };
+		RETURN_IF_FALSE(t.Assert(dump.find("UT::contended: acquisitions 2, contended 1") != std::string::npos, true,
+			"Dump contains site statistics"));
+		LOG_INFO("Lock profiling:\n" + dump);
+	}
+
+	return true;
+}
+
+} // namespace Unit
+
+} // namespace Tests
+
+} // namespace MSAPI
+
+#endif // MSAPI_UNIT_TEST_LOCK_PROFILING_INL
@@ -0,0 +1,396 @@
+/**************************
+ * @file        log.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef MSAPI_UNIT_TEST_LOG_INL
+#define MSAPI_UNIT_TEST_LOG_INL
+
+#include "../../../../library/source/help/binaryLog.h"
+#include "../../../../library/source/help/circleContainer.hpp"
+#include "../../../../library/source/help/io.inl"
+#include "../../../../library/source/help/log.h"
+#include "../../../../library/source/help/logFile.h"
+#include "../../../../library/source/test/test.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace MSAPI {
+
+namespace Tests {
+
+namespace Unit {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Unit test for logger.
+ *
+ * @return True if all tests passed and false if something went wrong.
+ */
+[[nodiscard]] bool Logger();
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+bool Logger()
+{
+	LOG_INFO_UNITTEST("MSAPI Logger");
+	MSAPI::Test t;
+
+	{
+		// Level check
+		RETURN_IF_FALSE(t.Assert(logger.GetLevelSave(), MSAPI::Log::Level::INFO, "Level to save"));
+		RETURN_IF_FALSE(t.Assert(logger.IsEnabled(MSAPI::Log::Level::ERROR), true, "Error is enabled"));
+		RETURN_IF_FALSE(t.Assert(logger.IsEnabled(MSAPI::Log::Level::WARNING), true, "Warning is enabled"));
+		RETURN_IF_FALSE(
+			t.Assert(logger.IsEnabled(MSAPI::Log::Level::INFO), MSAPI_LOG_COMPILE_LEVEL >= 3, "Info is enabled"));
+		RETURN_IF_FALSE(t.Assert(logger.IsEnabled(MSAPI::Log::Level::DEBUG), false, "Debug is disabled"));
+		RETURN_IF_FALSE(t.Assert(logger.IsEnabled(MSAPI::Log::Level::PROTOCOL), false, "Protocol is disabled"));
+	}
+
+	{
+		// Message is built only for enabled level
+		size_t built{};
+		const auto build{ [&built]() {
+			++built;
+			return std::string{ "message" };
+		} };
+
+		LOG_DEBUG("Debug " + build());
+		LOG_PROTOCOL_NEW("Protocol {}", build());
+		RETURN_IF_FALSE(t.Assert(built, size_t{ 0 }, "Message of disabled level is not built"));
+
+		LOG_WARNING("Warning " + build());
+		LOG_WARNING_NEW("Warning {}", build());
+		RETURN_IF_FALSE(t.Assert(built, size_t{ 2 }, "Message of enabled level is built"));
+
+		logger.SetLevelSave(MSAPI::Log::Level::PROTOCOL);
+		LOG_DEBUG("Debug " + build());
+		LOG_PROTOCOL_NEW("Protocol {}", build());
+		const size_t compiled{ static_cast<size_t>(MSAPI_LOG_COMPILE_LEVEL >= 4)
+			+ static_cast<size_t>(MSAPI_LOG_COMPILE_LEVEL >= 5) };
+		RETURN_IF_FALSE(
+			t.Assert(built, size_t{ 2 } + compiled, "Message of enabled level is built if level is compiled"));
+		logger.SetLevelSave(MSAPI::Log::Level::INFO);
+	}
+
+	{
+		// Rate limited and sampled messages
+		MSAPI::LogLimit limit;
+		uint64_t suppressed{ UINT64_MAX };
+		size_t allowed{ 0 };
+		for (size_t index{ 0 }; index < 10; ++index) {
+			allowed += static_cast<size_t>(limit.Allow(3, 3600000, suppressed));
+		}
+		RETURN_IF_FALSE(t.Assert(allowed, size_t{ 3 }, "Messages above limit are suppressed"));
+		RETURN_IF_FALSE(t.Assert(suppressed, uint64_t{ 0 }, "Suppressed messages are reported in next interval"));
+		RETURN_IF_FALSE(t.Assert(limit.Allow(3, 0, suppressed), true, "First message of next interval is allowed"));
+		RETURN_IF_FALSE(t.Assert(suppressed, uint64_t{ 7 }, "Number of suppressed messages"));
+		RETURN_IF_FALSE(t.Assert(limit.Allow(3, 3600000, suppressed), true, "Counter is reset in next interval"));
+		RETURN_IF_FALSE(t.Assert(suppressed, uint64_t{ 0 }, "Suppressed messages are reported once"));
+
+		size_t built{ 0 };
+		const auto build{ [&built]() {
+			++built;
+			return std::string{ "message" };
+		} };
+		for (size_t index{ 0 }; index < MSAPI_LOG_LIMIT_MESSAGES * 2; ++index) {
+			LOG_WARNING_LIMITED(build());
+		}
+		RETURN_IF_FALSE(
+			t.Assert(built, size_t{ MSAPI_LOG_LIMIT_MESSAGES }, "Suppressed messages of call site are not built"));
+
+		built = 0;
+		for (size_t index{ 0 }; index < 10; ++index) {
+			LOG_SAMPLED_IF_ENABLED(MSAPI::Log::Level::WARNING, 4, LOG_WARNING(build()));
+		}
+		RETURN_IF_FALSE(t.Assert(built, size_t{ 3 }, "Every 4th message is sampled"));
+	}
+
+	{
+		// Circle container
+		CircleContainer container{ 100 };
+		RETURN_IF_FALSE(t.Assert(container.GetMaxRecordSize(), size_t{ 56 }, "Max record size"));
+		size_t size{};
+		RETURN_IF_FALSE(t.Assert(container.Front(size) == nullptr, true, "Empty container has no front"));
+
+		const auto push{ [&container](const std::string_view record) {
+			void* const place{ container.Reserve(record.size()) };
+			if (place == nullptr) {
+				return false;
+			}
+			std::memcpy(place, record.data(), record.size());
+			container.Publish();
+			return true;
+		} };
+		const auto front{ [&container, &size]() {
+			const void* const record{ container.Front(size) };
+			return record == nullptr ? std::string{} : std::string{ static_cast<const char*>(record), size };
+		} };
+
+		RETURN_IF_FALSE(t.Assert(push("first record"), true, "Push first record"));
+		RETURN_IF_FALSE(t.Assert(push(std::string(40, 's')), true, "Push second record"));
+		RETURN_IF_FALSE(t.Assert(push(std::string(40, 't')), true, "Push third record"));
+		RETURN_IF_FALSE(t.Assert(push(std::string(56, 'f')), false, "Push into full container"));
+		RETURN_IF_FALSE(t.Assert(front(), std::string{ "first record" }, "Front is the oldest record"));
+		RETURN_IF_FALSE(t.Assert(front(), std::string{ "first record" }, "Front does not release record"));
+		container.Pop();
+		RETURN_IF_FALSE(t.Assert(front(), std::string(40, 's'), "Second record"));
+		container.Pop();
+
+		RETURN_IF_FALSE(t.Assert(push(std::string(30, 'w')), true, "Push record wrapped around end"));
+		RETURN_IF_FALSE(t.Assert(front(), std::string(40, 't'), "Third record"));
+		container.Pop();
+		RETURN_IF_FALSE(t.Assert(front(), std::string(30, 'w'), "Padding is skipped"));
+		container.Pop();
+		RETURN_IF_FALSE(t.Assert(container.Front(size) == nullptr, true, "All records are released"));
+		RETURN_IF_FALSE(t.Assert(push(std::string(56, 'm')), true, "Record of max size fits into empty container"));
+	}
+
+	{
+		// Asynchronous mode
+		constexpr size_t threadsSize{ 4 };
+		constexpr size_t messagesSize{ 1000 };
+		logger.SetRingSize(4096);
+		logger.SetOverflow(MSAPI::Log::Overflow::Block);
+		logger.SetAsync(true);
+		RETURN_IF_FALSE(t.Assert(logger.GetAsync(), true, "Asynchronous mode is enabled"));
+
+		std::vector<std::thread> threads;
+		for (size_t index{ 0 }; index < threadsSize; ++index) {
+			threads.emplace_back([index]() {
+				for (size_t message{ 0 }; message < messagesSize; ++message) {
+					LOG_INFO_NEW("Thread {} message {}", index, message);
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		LOG_INFO(std::string(4096, 'l'));
+
+		logger.SetAsync(false);
+		RETURN_IF_FALSE(t.Assert(logger.GetAsync(), false, "Asynchronous mode is disabled"));
+		RETURN_IF_FALSE(t.Assert(logger.IsActive(), true, "Logging is active after switch of mode"));
+		RETURN_IF_FALSE(t.Assert(logger.GetDropped(), uint64_t{ 0 }, "Nothing is dropped in block mode"));
+		logger.SetOverflow(MSAPI::Log::Overflow::Drop);
+		logger.SetRingSize(1 << 20);
+	}
+
+	{
+		// Asynchronous messages of all threads are written in order of each thread
+		constexpr size_t threadsSize{ 4 };
+		constexpr size_t messagesSize{ 500 };
+		const std::string directory{ logger.GetPath() + "logs/" };
+		const auto list{ [&directory]() {
+			std::vector<std::string> names;
+			(void)MSAPI::IO::List<MSAPI::IO::FileType::Regular>(names, directory.c_str());
+			std::erase_if(names, [](const std::string& name) { return !name.starts_with("UTASYNC_"); });
+			std::sort(names.begin(), names.end());
+			return names;
+		} };
+		const auto previous{ list() };
+
+		MSAPI::Log log{ false, true, MSAPI::Log::Level::INFO };
+		log.SetName("UTASYNC");
+		log.SetParentPath(logger.GetPath());
+		log.SetRingSize(4096);
+		log.SetOverflow(MSAPI::Log::Overflow::Block);
+		log.SetAsync(true);
+		log.Start();
+		std::vector<std::thread> threads;
+		for (size_t index{ 0 }; index < threadsSize; ++index) {
+			threads.emplace_back([&log, index]() {
+				for (size_t message{ 0 }; message < messagesSize; ++message) {
+					log.Print(std::format("<{} {}>", index, message), MSAPI::Log::Level::INFO);
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		log.Stop();
+
+		std::string content;
+		for (const auto& name : list()) {
+			if (std::find(previous.begin(), previous.end(), name) == previous.end()) {
+				std::string segment;
+				RETURN_IF_FALSE(
+					t.Assert(MSAPI::IO::ReadStr(segment, (directory + name).c_str()), true, "Read asynchronous log"));
+				content += segment;
+			}
+		}
+
+		size_t ordered{ 0 };
+		for (size_t index{ 0 }; index < threadsSize; ++index) {
+			size_t position{ 0 };
+			for (size_t message{ 0 }; message < messagesSize; ++message) {
+				position = content.find(std::format("<{} {}>", index, message), position);
+				if (position == std::string::npos) {
+					break;
+				}
+				++ordered;
+			}
+		}
+		RETURN_IF_FALSE(t.Assert(ordered, threadsSize * messagesSize, "All messages are written in thread order"));
+		RETURN_IF_FALSE(t.Assert(log.GetDropped(), uint64_t{ 0 }, "Nothing is dropped by asynchronous log"));
+	}
+
+	{
+		// Binary messages
+		const auto& site{ BinaryLog::Register<int, std::string, double>(
+			MSAPI::Log::Level::INFO, "int {} string {:>6} double {:.2f}", "Function", 7, false) };
+		RETURN_IF_FALSE(t.Assert(BinaryLog::GetSite(site.id) == &site, true, "Site is registered"));
+		RETURN_IF_FALSE(t.Assert(BinaryLog::GetSitesSize() >= site.id, true, "Sites size"));
+
+		std::string arguments(sizeof(int32_t) + sizeof(uint32_t) + 4 + sizeof(double), '\0');
+		char* place{ arguments.data() };
+		place = BinaryLog::Put(place, BinaryLog::Normalize(-5));
+		place = BinaryLog::Put(place, BinaryLog::Normalize(std::string{ "text" }));
+		(void)BinaryLog::Put(place, BinaryLog::Normalize(1.256));
+
+		std::string text;
+		RETURN_IF_FALSE(t.Assert(BinaryLog::Format(text, site, arguments), true, "Format arguments"));
+		RETURN_IF_FALSE(
+			t.Assert(text, std::string{ "Function(7): int -5 string   text double 1.26" }, "Formatted text"));
+		text.clear();
+		RETURN_IF_FALSE(t.Assert(BinaryLog::Format(text, site, std::string_view{ arguments }.substr(1)), false,
+			"Arguments do not match types of site"));
+
+		constexpr int64_t timestamp{ 1700000000123456789 };
+		std::string data;
+		BinaryLog::AppendEntry(data, BinaryLog::Kind::Begin, timestamp, 0, MSAPI::Log::Level::INFO, "UTLOG");
+		(void)BinaryLog::AppendSites(data, site.id - 1);
+		BinaryLog::AppendEntry(data, BinaryLog::Kind::Record, timestamp, site.id, MSAPI::Log::Level::INFO, arguments);
+		BinaryLog::AppendEntry(data, BinaryLog::Kind::Text, timestamp, 0, MSAPI::Log::Level::WARNING, "plain text");
+
+		std::string expected;
+		MSAPI::Log::AppendLine(expected, timestamp, MSAPI::Log::Level::INFO, "UTLOG",
+			"Function(7): int -5 string   text double 1.26");
+		MSAPI::Log::AppendLine(expected, timestamp, MSAPI::Log::Level::WARNING, "UTLOG", "plain text");
+
+		BinaryLog::Decoder decoder;
+		size_t offset{ 0 };
+		std::string lines;
+		RETURN_IF_FALSE(t.Assert(decoder.Decode(std::string_view{ data }.substr(0, data.size() - 1), offset, lines),
+			true, "Decode data with incomplete entry"));
+		RETURN_IF_FALSE(t.Assert(offset, data.size() - BinaryLog::ENTRY_HEADER_SIZE - 10, "Incomplete entry is left"));
+		RETURN_IF_FALSE(t.Assert(decoder.Decode(data, offset, lines), true, "Decode the rest of data"));
+		RETURN_IF_FALSE(t.Assert(offset, data.size(), "All data is decoded"));
+		RETURN_IF_FALSE(t.Assert(lines, expected, "Decoded lines"));
+
+		BinaryLog::Decoder tailDecoder;
+		const std::string withTail{ data + std::string(BinaryLog::ENTRY_HEADER_SIZE * 2, '\0') };
+		size_t tailOffset{ 0 };
+		lines.clear();
+		RETURN_IF_FALSE(t.Assert(tailDecoder.Decode(withTail, tailOffset, lines), true,
+			"Decode data with preallocated tail of segment"));
+		RETURN_IF_FALSE(t.Assert(tailOffset, withTail.size(), "Preallocated tail ends data"));
+		RETURN_IF_FALSE(t.Assert(lines, expected, "Decoded lines before preallocated tail"));
+
+		BinaryLog::AppendEntry(data, BinaryLog::Kind::Record, timestamp, site.id + 1000, MSAPI::Log::Level::INFO, "");
+		RETURN_IF_FALSE(t.Assert(decoder.Decode(data, offset, lines), false, "Record of unknown site is corrupted"));
+
+		size_t built{};
+		const auto build{ [&built]() {
+			++built;
+			return std::string{ "message" };
+		} };
+		LOG_BINARY_IF_ENABLED(MSAPI::Log::Level::DEBUG, "Debug {}", build());
+		RETURN_IF_FALSE(t.Assert(built, size_t{ 0 }, "Binary message of disabled level is not built"));
+		for (size_t index{ 0 }; index < 3; ++index) {
+			LOG_BINARY_IF_ENABLED(MSAPI::Log::Level::WARNING, "Warning {} {}", build(), index);
+		}
+		RETURN_IF_FALSE(t.Assert(built, size_t{ 3 }, "Arguments of binary message are evaluated once"));
+	}
+
+	{
+		// Log file segments
+		const auto pageSize{ static_cast<size_t>(sysconf(_SC_PAGESIZE)) };
+		const std::string directory{ logger.GetPath() + "logs/" };
+		MSAPI::LogFile::Settings settings;
+		settings.segmentSize = pageSize;
+		settings.retentionSegments = 3;
+		settings.sync = true;
+
+		//* Names which do not match pattern of segments exactly are not touched by retention
+		const std::vector<std::string> foreign{ "UTSEGMENT_1_00001.log", "UTSEGMENT_01_000001.log",
+			"UTSEGMENT_1_000001.log.old", "UTSEGMENT_1_0000001.log", "UTSEGMENT_other_1_000001.log" };
+		for (const auto& name : foreign) {
+			RETURN_IF_FALSE(t.Assert(MSAPI::IO::SaveStr("foreign", (directory + name).c_str()), true,
+				std::format("Foreign file {} is created", name)));
+		}
+
+		MSAPI::LogFile file;
+		RETURN_IF_FALSE(t.Assert(file.Open(directory, "UTSEGMENT", ".log", settings), true, "Log file is opened"));
+		RETURN_IF_FALSE(t.Assert(file.GetFree(), pageSize, "Segment is allocated"));
+
+		std::string written;
+		size_t rotations{ 0 };
+		for (size_t index{ 0 }; index < 30; ++index) {
+			std::string record(pageSize / 4, static_cast<char>('a' + index % 26));
+			record.back() = '\n';
+			rotations += static_cast<size_t>(file.Prepare(record.size()));
+			file.Write(record);
+			written += record;
+		}
+		RETURN_IF_FALSE(t.Assert(rotations, size_t{ 7 }, "Segment is rotated when record does not fit"));
+		RETURN_IF_FALSE(t.Assert(file.GetFree(), pageSize / 2, "Free size of the last segment"));
+
+		file.Stop();
+		file.Close();
+		RETURN_IF_FALSE(t.Assert(file.IsOpen(), false, "Log file is closed"));
+
+		std::vector<std::string> names;
+		RETURN_IF_FALSE(t.Assert(MSAPI::IO::List<MSAPI::IO::FileType::Regular>(names, directory.c_str()), true,
+			"List directory of segments"));
+		std::erase_if(names, [](const std::string& name) { return !name.starts_with("UTSEGMENT_"); });
+		for (const auto& name : foreign) {
+			const auto it{ std::find(names.begin(), names.end(), name) };
+			RETURN_IF_FALSE(t.Assert(it != names.end(), true, std::format("Foreign file {} is kept", name)));
+			names.erase(it);
+			RETURN_IF_FALSE(t.Assert(MSAPI::IO::Remove(directory + name), true,
+				std::format("Foreign file {} is removed", name)));
+		}
+		std::sort(names.begin(), names.end());
+		RETURN_IF_FALSE(t.Assert(names.size(), size_t{ 3 }, "Old segments are removed by retention"));
+
+		std::string content;
+		for (const auto& name : names) {
+			std::string segment;
+			RETURN_IF_FALSE(t.Assert(MSAPI::IO::ReadStr(segment, (directory + name).c_str()), true, "Read segment"));
+			content += segment;
+		}
+		RETURN_IF_FALSE(t.Assert(content, written.substr(pageSize / 4 * 20), "Retained segments are truncated"));
+	}
+
+	return true;
+}
+
+} // namespace Unit
+
+} // namespace Tests
+
+} // namespace MSAPI
+
+#endif // MSAPI_UNIT_TEST_LOG_INL
@@ -76,7 +76,7 @@ bool ObjectData()
 
 	CustomObject first{ 1, 2, 3.369, 9009008001 };
 
-	const auto hashCode{ typeid(CustomObject).hash_code() };
+	const auto hashCode{ MSAPI::Protocol::Object::typeId_v<CustomObject> };
 	const auto objectSize{ sizeof(first) };
 
 	MSAPI::Protocol::Object::Data data{ 1, hashCode, objectSize };
@@ -85,6 +85,9 @@ bool ObjectData()
 	RETURN_IF_FALSE(t.Assert(data.GetHash(), hashCode, "CustomObject hash code"));
 	RETURN_IF_FALSE(t.Assert(data.IsValid(), true, "CustomObject data is valid"));
 	RETURN_IF_FALSE(t.Assert(data.GetStreamId(), 1, "CustomObject data stream id"));
+	RETURN_IF_FALSE(t.Assert(data.GetSequence(), uint64_t{ 0 }, "CustomObject data is not sequenced by default"));
+	RETURN_IF_FALSE(t.Assert(data.GetBufferSize(), MSAPI::Protocol::Object::Data::HEADER_SIZE + objectSize,
+		"CustomObject data buffer size"));
 
 	RETURN_IF_FALSE(t.Assert(data == MSAPI::Protocol::Object::Data{ 2, hashCode, objectSize }, false,
 		"Data is not equal to another one, different stream id, operator=="));
@@ -96,6 +99,11 @@ bool ObjectData()
 	RETURN_IF_FALSE(t.Assert(data != MSAPI::Protocol::Object::Data{ 1, hashCode + 1, objectSize }, true,
 		"Data is not equal to another one, different hash code, operator!="));
 
+	RETURN_IF_FALSE(t.Assert(data == MSAPI::Protocol::Object::Data{ 1, hashCode, objectSize, 1 }, false,
+		"Data is not equal to another one, different sequence, operator=="));
+	RETURN_IF_FALSE(t.Assert(data != MSAPI::Protocol::Object::Data{ 1, hashCode, objectSize, 1 }, true,
+		"Data is not equal to another one, different sequence, operator!="));
+
 	RETURN_IF_FALSE(t.Assert(data == MSAPI::Protocol::Object::Data{ 1, hashCode, objectSize + 1 }, false,
 		"Data is not equal to another one, different object size, operator=="));
 	RETURN_IF_FALSE(t.Assert(data != MSAPI::Protocol::Object::Data{ 1, hashCode, objectSize + 1 }, true,
@@ -105,8 +113,9 @@ bool ObjectData()
 		"Object protocol:\n{"
 		"\n\tcipher      : 2666999999"
 		"\n\tbuffer size : "
-			+ _S(28 + objectSize) + "\n\thash        : " + _S(hashCode)
+			+ _S(36 + objectSize) + "\n\thash        : " + _S(hashCode)
 			+ "\n\tstream id   : 1"
+			  "\n\tsequence    : 0"
 			  "\n}",
 		"Data to string is correct"));
 
@@ -121,6 +130,74 @@ bool ObjectData()
 
 	RETURN_IF_FALSE(CustomObject::AreEqual(*reinterpret_cast<const CustomObject*>(unpackObject), first, t));
 
+	MSAPI::Protocol::Object::Data sequencedData{ 3, hashCode, objectSize, 18446744073709551615ull };
+	AutoClearPtr<void> packSequencedData{ sequencedData.PackData(&first) };
+	MSAPI::Protocol::Object::Data sequencedDataUnpacked{ MSAPI::DataHeader{ packSequencedData.ptr },
+		packSequencedData.ptr };
+
+	RETURN_IF_FALSE(t.Assert(sequencedDataUnpacked, sequencedData, "Unpacked sequenced data is equal to packed one"));
+	RETURN_IF_FALSE(t.Assert(
+		sequencedDataUnpacked.GetSequence(), uint64_t{ 18446744073709551615ull }, "Unpacked sequence is correct"));
+
+	MSAPI::Protocol::Object::Data::UnpackData(&unpackObject, packSequencedData.ptr);
+	RETURN_IF_FALSE(CustomObject::AreEqual(*reinterpret_cast<const CustomObject*>(unpackObject), first, t));
+
+	//* Type identifiers must be stable between binaries and compilers for types with declared name
+	static_assert(MSAPI::Protocol::Object::Fnv1a("") == 14695981039346656037ull, "FNV-1a offset basis");
+	static_assert(MSAPI::Protocol::Object::Fnv1a("a") == 0xaf63dc4c8601ec8cull, "FNV-1a hash of 'a'");
+	static_assert(MSAPI::Protocol::Object::TypeName<MSAPI::Protocol::Object::StreamStateResponse>()
+			== "MSAPI::Protocol::Object::StreamStateResponse",
+		"Declared type name");
+	static_assert(
+		MSAPI::Protocol::Object::typeId_v<const CustomObject&> == MSAPI::Protocol::Object::typeId_v<CustomObject>,
+		"Type id ignores cv and reference qualifiers");
+
+	struct OtherObject {
+		int m_param1;
+	};
+
+	constexpr auto stateHash{ MSAPI::Protocol::Object::typeId_v<MSAPI::Protocol::Object::StreamStateResponse> };
+	constexpr auto otherHash{ MSAPI::Protocol::Object::typeId_v<OtherObject> };
+	constexpr auto filterHash{ MSAPI::Protocol::Object::typeId_v<MSAPI::Protocol::Object::Filter<CustomObject>> };
+
+	RETURN_IF_FALSE(t.Assert(stateHash, size_t{ 1997367582545047550ull }, "Stream state response type id is stable"));
+	RETURN_IF_FALSE(t.Assert(filterHash != hashCode, true, "Filter type id differs from filter object type id"));
+	RETURN_IF_FALSE(t.Assert(otherHash != hashCode, true, "Different types have different type ids"));
+
+	using DispatchTable = MSAPI::Protocol::Object::DispatchTable<int (*)(), 3>;
+	static constexpr DispatchTable table{ std::array<DispatchTable::Entry, 3>{
+		DispatchTable::Entry{ MSAPI::Protocol::Object::typeId_v<CustomObject>, []() { return 1; } },
+		DispatchTable::Entry{ otherHash, []() { return 2; } }, DispatchTable::Entry{ stateHash, []() { return 3; } } } };
+	static_assert(table.IsUnique(), "Dispatch table hashes are unique");
+
+	RETURN_IF_FALSE(t.Assert(table.Find(hashCode)(), 1, "Dispatch table finds handler for custom object"));
+	RETURN_IF_FALSE(t.Assert(table.Find(otherHash)(), 2, "Dispatch table finds handler for other object"));
+	RETURN_IF_FALSE(t.Assert(table.Find(stateHash)(), 3, "Dispatch table finds handler for stream state response"));
+	RETURN_IF_FALSE(
+		t.Assert(table.Find(hashCode + 1) == nullptr, true, "Dispatch table returns nullptr for unknown hash"));
+
+	using WideDispatchTable = MSAPI::Protocol::Object::DispatchTable<size_t, 24>;
+	static constexpr auto wideTable{ []() {
+		std::array<WideDispatchTable::Entry, 24> entries{};
+		for (size_t index{}; index < entries.size(); ++index) {
+			entries[index] = { MSAPI::Protocol::Object::Fnv1a(index, stateHash), index + 1 };
+		}
+		return WideDispatchTable{ entries };
+	}() };
+	static_assert(wideTable.IsUnique(), "Wide dispatch table hashes are unique");
+
+	for (size_t index{}; index < 24; ++index) {
+		RETURN_IF_FALSE(t.Assert(wideTable.Find(MSAPI::Protocol::Object::Fnv1a(index, stateHash)), index + 1,
+			std::format("Wide dispatch table finds handler {}", index)));
+	}
+	RETURN_IF_FALSE(t.Assert(wideTable.Find(MSAPI::Protocol::Object::Fnv1a(size_t{ 24 }, stateHash)), size_t{ 0 },
+		"Wide dispatch table returns empty handler for unknown hash"));
+
+	const DispatchTable duplicateTable{ std::array<DispatchTable::Entry, 3>{
+		DispatchTable::Entry{ otherHash, []() { return 1; } }, DispatchTable::Entry{ otherHash, []() { return 2; } },
+		DispatchTable::Entry{ stateHash, []() { return 3; } } } };
+	RETURN_IF_FALSE(t.Assert(duplicateTable.IsUnique(), false, "Dispatch table with duplicate hashes is not unique"));
+
 	return true;
 }
 
@@ -0,0 +1,200 @@
+/**************************
+ * @file        objectJournal.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef MSAPI_UNIT_TEST_OBJECT_JOURNAL_INL
+#define MSAPI_UNIT_TEST_OBJECT_JOURNAL_INL
+
+#include "../../../../library/source/protocol/objectJournal.inl"
+#include "../../../../library/source/test/test.h"
+
+namespace MSAPI {
+
+namespace Tests {
+
+namespace Unit {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Object for journal records.
+ */
+struct JournalObject {
+	static constexpr std::string_view objectTypeName{ "MSAPI::Tests::Unit::JournalObject" };
+
+	uint64_t id;
+	double price;
+};
+
+/**************************
+ * @brief Unit test for object protocol Journal and JournalReader.
+ *
+ * @param dir Directory for journal files, will be cleared.
+ *
+ * @return True if all tests passed and false if something went wrong.
+ */
+[[nodiscard]] bool ObjectJournal(const std::string& dir);
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+bool ObjectJournal(const std::string& dir)
+{
+	LOG_INFO_UNITTEST("MSAPI Object protocol Journal");
+	MSAPI::Test t;
+
+	using Journal = Protocol::Object::Journal;
+	using JournalReader = Protocol::Object::JournalReader;
+
+	//* Clear old files
+	{
+		std::vector<std::string> files;
+		if (IO::List<IO::FileType::Regular>(files, dir.c_str())) {
+			for (const auto& file : files) {
+				(void)IO::Remove(dir + file);
+			}
+		}
+	}
+
+	RETURN_IF_FALSE(t.Assert(Journal::GetRecordSize(0), size_t{ 16 }, "Record size of empty frame"));
+	RETURN_IF_FALSE(t.Assert(Journal::GetRecordSize(1), size_t{ 24 }, "Record size is padded"));
+	RETURN_IF_FALSE(t.Assert(Journal::GetRecordSize(52), size_t{ 72 }, "Record size of object frame"));
+	RETURN_IF_FALSE(t.Assert(Journal::GetSegmentPath("/tmp/", "orders", 42, false),
+		std::string{ "/tmp/orders_0000000042.journal" }, "Segment path"));
+	RETURN_IF_FALSE(t.Assert(Journal::GetSegmentPath("/tmp/", "orders", 42, true),
+		std::string{ "/tmp/orders_0000000042.index" }, "Segment index path"));
+	RETURN_IF_FALSE(t.Assert(Journal::ParseSegmentNumber("orders", "orders_0000000042.journal"),
+		std::optional<uint64_t>{ 42 }, "Parse segment number"));
+	RETURN_IF_FALSE(t.Assert(Journal::ParseSegmentNumber("orders", "orders_0000000042.index"),
+		std::optional<uint64_t>{}, "Index file is not a segment"));
+	RETURN_IF_FALSE(t.Assert(Journal::ParseSegmentNumber("orders", "trades_0000000042.journal"),
+		std::optional<uint64_t>{}, "Segment of another journal"));
+	RETURN_IF_FALSE(t.Assert(Journal::ParseSegmentNumber("orders", "orders_00000000x2.journal"),
+		std::optional<uint64_t>{}, "Segment with invalid number"));
+
+	RETURN_IF_FALSE(t.Assert(JournalReader::EnumToString(JournalReader::Pace::Undefined), "Undefined", "Pace"));
+	RETURN_IF_FALSE(t.Assert(JournalReader::EnumToString(JournalReader::Pace::MaxSpeed), "Max speed", "Pace"));
+	RETURN_IF_FALSE(t.Assert(JournalReader::EnumToString(JournalReader::Pace::RealTime), "Real time", "Pace"));
+	RETURN_IF_FALSE(t.Assert(JournalReader::EnumToString(JournalReader::Pace::Max), "Max", "Pace"));
+
+	//* 56 records of 72 bytes fit in one segment
+	static constexpr size_t segmentSize{ 4096 };
+	static constexpr uint64_t objects{ 150 };
+	{
+		Journal journal{ dir, "orders", segmentSize, 512, 1 };
+		RETURN_IF_FALSE(t.Assert(journal.IsRunning(), false, "Journal is not running before start"));
+		RETURN_IF_FALSE(t.Assert(journal.Append(Protocol::Object::Data{ 0, 0, 0 }, nullptr), false,
+			"Append is rejected before start"));
+		RETURN_IF_FALSE(t.Assert(journal.GetDroppedFrames(), uint64_t{ 1 }, "Dropped frames before start"));
+
+		RETURN_IF_FALSE(t.Assert(journal.Start(), true, "Journal is started"));
+		RETURN_IF_FALSE(t.Assert(journal.IsRunning(), true, "Journal is running"));
+		RETURN_IF_FALSE(t.Assert(journal.Start(), false, "Journal is not started twice"));
+
+		for (uint64_t index{ 1 }; index <= objects; ++index) {
+			const JournalObject object{ index, static_cast<double>(index) / 4 };
+			const Protocol::Object::Data data{ 0, Protocol::Object::typeId_v<JournalObject>, sizeof(JournalObject),
+				index };
+			//* Appender waits for flusher when the next segment is not prepared yet
+			RETURN_IF_FALSE(t.Assert(journal.Append(data, &object), true, "Object is appended"));
+		}
+
+		journal.Stop();
+		RETURN_IF_FALSE(t.Assert(journal.IsRunning(), false, "Journal is stopped"));
+		RETURN_IF_FALSE(t.Assert(journal.GetDroppedFrames(), uint64_t{ 1 }, "No frames are dropped while running"));
+	}
+
+	JournalReader reader{ dir, "orders" };
+	RETURN_IF_FALSE(t.Assert(reader.Open(), true, "Reader is opened"));
+	RETURN_IF_FALSE(t.Assert(reader.GetSegments().size(), size_t{ 3 }, "Number of segments"));
+	RETURN_IF_FALSE(t.Assert(reader.GetSegments()[0], Journal::GetSegmentPath(dir, "orders", 1, false), "Segment 1"));
+	RETURN_IF_FALSE(t.Assert(reader.GetSegments()[2], Journal::GetSegmentPath(dir, "orders", 3, false), "Segment 3"));
+
+	const auto index{ JournalReader::ReadIndex(reader.GetSegments()[0]) };
+	RETURN_IF_FALSE(t.Assert(index.size(), size_t{ 7 }, "Sparse index entries of full segment"));
+	RETURN_IF_FALSE(t.Assert(index[0].offset, UINT64(Journal::FILE_HEADER_SIZE), "First index entry offset"));
+	RETURN_IF_FALSE(t.Assert(index[0].sequence, uint64_t{ 1 }, "First index entry sequence"));
+	RETURN_IF_FALSE(t.Assert(index[1].offset, UINT64(Journal::FILE_HEADER_SIZE + 72 * 8), "Second index entry offset"));
+	RETURN_IF_FALSE(t.Assert(index[1].sequence, uint64_t{ 9 }, "Second index entry sequence"));
+
+	std::vector<int64_t> timestamps;
+	uint64_t expected{ 1 };
+	bool valid{ true };
+	const auto replayed{ reader.Replay(0, std::numeric_limits<int64_t>::max(), JournalReader::Pace::MaxSpeed,
+		[&](const int64_t timestamp, const Protocol::Object::Data& data, const void* object) {
+			const auto* journalObject{ static_cast<const JournalObject*>(object) };
+			valid = valid && data.IsValid() && data.GetHash() == Protocol::Object::typeId_v<JournalObject>
+				&& data.GetSequence() == expected && journalObject->id == expected
+				&& Helper::FloatEqual(journalObject->price, static_cast<double>(expected) / 4)
+				&& (timestamps.empty() || timestamps.back() <= timestamp);
+			timestamps.emplace_back(timestamp);
+			++expected;
+		}) };
+	RETURN_IF_FALSE(t.Assert(replayed, size_t{ objects }, "All objects are replayed"));
+	RETURN_IF_FALSE(t.Assert(valid, true, "Replayed objects are valid and ordered"));
+
+	//* Range starts in the second segment, the first one is skipped by index
+	const int64_t from{ timestamps[70] };
+	const int64_t to{ timestamps[119] };
+	const auto expectedInRange{ static_cast<size_t>(std::count_if(timestamps.begin(), timestamps.end(),
+		[from, to](const int64_t timestamp) { return timestamp >= from && timestamp <= to; })) };
+	uint64_t firstSequence{ 0 };
+	const auto replayedInRange{ reader.Replay(from, to, JournalReader::Pace::MaxSpeed,
+		[&firstSequence](int64_t, const Protocol::Object::Data& data, const void*) {
+			if (firstSequence == 0) {
+				firstSequence = data.GetSequence();
+			}
+		}) };
+	RETURN_IF_FALSE(t.Assert(replayedInRange, expectedInRange, "Objects in time range are replayed"));
+	RETURN_IF_FALSE(t.Assert(firstSequence <= 71, true, "First replayed object in time range"));
+
+	RETURN_IF_FALSE(t.Assert(reader.Replay(to + 1, to, JournalReader::Pace::MaxSpeed,
+								 [](int64_t, const Protocol::Object::Data&, const void*) {}),
+		size_t{ 0 }, "Empty time range"));
+
+	//* New journal continues numbering after existing segments
+	{
+		Journal journal{ dir, "orders", segmentSize, 512, 1 };
+		RETURN_IF_FALSE(t.Assert(journal.Start(), true, "Journal is restarted"));
+		const JournalObject object{ objects + 1, 0 };
+		RETURN_IF_FALSE(t.Assert(journal.Append({ 0, Protocol::Object::typeId_v<JournalObject>, sizeof(JournalObject),
+										 objects + 1 },
+									 &object),
+			true, "Object is appended after restart"));
+	}
+
+	RETURN_IF_FALSE(t.Assert(reader.Open(), true, "Reader is reopened"));
+	RETURN_IF_FALSE(t.Assert(reader.GetSegments().size(), size_t{ 4 }, "Number of segments after restart"));
+	RETURN_IF_FALSE(t.Assert(reader.GetSegments()[3], Journal::GetSegmentPath(dir, "orders", 4, false), "Segment 4"));
+	RETURN_IF_FALSE(t.Assert(reader.Replay(0, std::numeric_limits<int64_t>::max(), JournalReader::Pace::MaxSpeed,
+								 [](int64_t, const Protocol::Object::Data&, const void*) {}),
+		size_t{ objects + 1 }, "All objects are replayed after restart"));
+
+	return true;
+}
+
+} // namespace Unit
+
+} // namespace Tests
+
+} // namespace MSAPI
+
+#endif // MSAPI_UNIT_TEST_OBJECT_JOURNAL_INL
@@ -0,0 +1,260 @@
+/**************************
+ * @file        rcu.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef MSAPI_UNIT_TEST_RCU_INL
+#define MSAPI_UNIT_TEST_RCU_INL
+
+#include "../../../../library/source/help/rcu.hpp"
+#include "../../../../library/source/test/test.h"
+#include <chrono>
+#include <map>
+#include <vector>
+
+namespace MSAPI {
+
+namespace Tests {
+
+namespace Unit {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Unit test for read-copy-update cells. Reader scalability is compared with read-write lock from 1 to 64
+ * threads, results are logged and are not asserted.
+ *
+ * @return True if all tests passed and false if something went wrong.
+ */
+[[nodiscard]] bool Rcu();
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+bool Rcu()
+{
+	LOG_INFO_UNITTEST("MSAPI Rcu");
+	MSAPI::Test t;
+
+	{
+		// Snapshots
+		Rcu::Cell<std::vector<int>> cell{ std::vector<int>{ 1, 2, 3 } };
+		const int* first;
+		{
+			const decltype(cell)::ReadGuard guard{ cell };
+			RETURN_IF_FALSE(t.Assert(*guard, std::vector<int>{ 1, 2, 3 }, "Initial value"));
+			first = guard->data();
+		}
+
+		RETURN_IF_FALSE(t.Assert(cell.Update([](std::vector<int>& value) { value.emplace_back(4); }), true,
+			"Changed value is published"));
+		{
+			const decltype(cell)::ReadGuard guard{ cell };
+			RETURN_IF_FALSE(t.Assert(*guard, std::vector<int>{ 1, 2, 3, 4 }, "Updated value"));
+			first = guard->data();
+		}
+
+		RETURN_IF_FALSE(t.Assert(cell.Update([](std::vector<int>& value) {
+			value.clear();
+			return false;
+		}),
+			false, "Dropped copy is not published"));
+		{
+			const decltype(cell)::ReadGuard guard{ cell };
+			RETURN_IF_FALSE(t.Assert(*guard, std::vector<int>{ 1, 2, 3, 4 }, "Value is kept after dropped copy"));
+			RETURN_IF_FALSE(t.Assert(guard->data() == first, true, "Snapshot is kept after dropped copy"));
+		}
+
+		RETURN_IF_FALSE(
+			t.Assert(cell.Replace({ 5 }), std::vector<int>{ 1, 2, 3, 4 }, "Replace returns previous value"));
+		const decltype(cell)::ReadGuard guard{ cell };
+		RETURN_IF_FALSE(t.Assert(*guard, std::vector<int>{ 5 }, "Replaced value"));
+	}
+
+	{
+		// Nested read sections
+		RETURN_IF_FALSE(t.Assert(Rcu::Domain::IsReading(), false, "Thread is not reading"));
+		Rcu::Cell<int> first{ 1 };
+		Rcu::Cell<int> second{ 2 };
+		{
+			const decltype(first)::ReadGuard outer{ first };
+			{
+				const decltype(second)::ReadGuard inner{ second };
+				RETURN_IF_FALSE(t.Assert(*outer + *inner, 3, "Nested snapshots"));
+			}
+			RETURN_IF_FALSE(t.Assert(Rcu::Domain::IsReading(), true, "Thread is reading after inner section"));
+		}
+		RETURN_IF_FALSE(t.Assert(Rcu::Domain::IsReading(), false, "Thread is not reading after outer section"));
+	}
+
+	{
+		// Writer waits for grace period
+		Rcu::Cell<std::vector<int>> cell{ std::vector<int>{ 1, 2, 3 } };
+		std::atomic<bool> entered{ false };
+		std::atomic<bool> left{ false };
+		std::atomic<bool> isSnapshotStable{ false };
+		std::thread reader{ [&cell, &entered, &left, &isSnapshotStable]() {
+			const decltype(cell)::ReadGuard guard{ cell };
+			entered.store(true, std::memory_order_release);
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			isSnapshotStable.store(*guard == std::vector<int>{ 1, 2, 3 }, std::memory_order_relaxed);
+			left.store(true, std::memory_order_release);
+		} };
+
+		while (!entered.load(std::memory_order_acquire)) {
+			std::this_thread::yield();
+		}
+		(void)cell.Update([](std::vector<int>& value) { value.assign(1000, 0); });
+		RETURN_IF_FALSE(t.Assert(left.load(std::memory_order_acquire), true, "Update waits for reader"));
+		reader.join();
+		RETURN_IF_FALSE(
+			t.Assert(isSnapshotStable.load(std::memory_order_relaxed), true, "Reader snapshot is not changed"));
+	}
+
+	{
+		// Writers are not serialized by grace period
+		Rcu::Cell<int> cell{ 1 };
+		std::atomic<bool> entered{ false };
+		std::atomic<bool> left{ false };
+		std::thread reader{ [&cell, &entered, &left]() {
+			const decltype(cell)::ReadGuard guard{ cell };
+			entered.store(true, std::memory_order_release);
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+			left.store(true, std::memory_order_release);
+		} };
+
+		while (!entered.load(std::memory_order_acquire)) {
+			std::this_thread::yield();
+		}
+		const auto waitFor{ [&cell](const int expected) {
+			for (;;) {
+				const decltype(cell)::ReadGuard guard{ cell };
+				if (*guard == expected) {
+					return;
+				}
+				std::this_thread::yield();
+			}
+		} };
+		std::thread first{ [&cell]() { (void)cell.Update([](int& value) { value = 2; }); } };
+		waitFor(2);
+		std::thread second{ [&cell]() { (void)cell.Replace(3); } };
+		waitFor(3);
+		const bool isLeft{ left.load(std::memory_order_acquire) };
+		first.join();
+		second.join();
+		reader.join();
+		RETURN_IF_FALSE(t.Assert(isLeft, false, "Second writer publishes while first one waits for grace period"));
+	}
+
+	{
+		// Consistency under concurrent writer
+		struct Pair {
+			uint64_t first;
+			uint64_t second;
+		};
+
+		Rcu::Cell<Pair> cell{ Pair{ 0, 0 } };
+		std::atomic<bool> isRunning{ true };
+		std::atomic<uint64_t> mismatches{};
+		std::vector<std::thread> readers;
+		for (size_t index{ 0 }; index < 4; ++index) {
+			readers.emplace_back([&cell, &isRunning, &mismatches]() {
+				while (isRunning.load(std::memory_order_relaxed)) {
+					const decltype(cell)::ReadGuard guard{ cell };
+					if (guard->first != guard->second) {
+						mismatches.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+			});
+		}
+
+		for (uint64_t index{ 1 }; index <= 1000; ++index) {
+			(void)cell.Update([index](Pair& value) {
+				value.first = index;
+				value.second = index;
+			});
+		}
+		isRunning.store(false, std::memory_order_relaxed);
+		for (auto& reader : readers) {
+			reader.join();
+		}
+
+		RETURN_IF_FALSE(t.Assert(mismatches.load(), uint64_t{ 0 }, "Readers see only whole snapshots"));
+		const decltype(cell)::ReadGuard guard{ cell };
+		RETURN_IF_FALSE(t.Assert(guard->first, uint64_t{ 1000 }, "Last snapshot is published"));
+	}
+
+	{
+		// Reader scalability
+		constexpr size_t iterations{ 100000 };
+		std::map<uint64_t, uint64_t> registry;
+		for (uint64_t index{ 0 }; index < 64; ++index) {
+			registry.emplace(index, index);
+		}
+
+		Rcu::Cell<std::map<uint64_t, uint64_t>> cell{ registry };
+		Pthread::AtomicRWLock lock;
+
+		const auto measure{ [](const size_t threads, const auto& read) {
+			std::atomic<uint64_t> sum{};
+			std::vector<std::thread> readers;
+			readers.reserve(threads);
+			const auto begin{ std::chrono::steady_clock::now() };
+			for (size_t thread{ 0 }; thread < threads; ++thread) {
+				readers.emplace_back([&read, &sum, thread]() {
+					uint64_t local{};
+					for (size_t index{ 0 }; index < iterations; ++index) {
+						local += read((index + thread) & 63);
+					}
+					sum.fetch_add(local, std::memory_order_relaxed);
+				});
+			}
+			for (auto& reader : readers) {
+				reader.join();
+			}
+			const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - begin };
+			return static_cast<double>(threads * iterations) / elapsed.count();
+		} };
+
+		for (size_t threads{ 1 }; threads <= 64; threads *= 2) {
+			const auto rcu{ measure(threads, [&cell](const uint64_t key) {
+				const decltype(cell)::ReadGuard guard{ cell };
+				return guard->find(key)->second;
+			}) };
+			const auto rwLock{ measure(threads, [&registry, &lock](const uint64_t key) {
+				const Pthread::AtomicRWLock::ExitGuard<Pthread::read> _{ lock };
+				return registry.find(key)->second;
+			}) };
+
+			LOG_INFO_NEW("Readers: {}, rcu: {:.0f} reads/s, read-write lock: {:.0f} reads/s, ratio: {:.2f}", threads,
+				rcu, rwLock, rcu / rwLock);
+		}
+	}
+
+	return true;
+}
+
+} // namespace Unit
+
+} // namespace Tests
+
+} // namespace MSAPI
+
+#endif // MSAPI_UNIT_TEST_RCU_INL
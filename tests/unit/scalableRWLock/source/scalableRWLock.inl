@@ -0,0 +1,155 @@
+/**************************
+ * @file        scalableRWLock.inl
+ * @version     6.0
+ * @date        2026-10-18
+ * @author      maks.angels@mail.ru
+ * @copyright   © 2021–2026 Maksim Andreevich Leonov
+ *
+ * This file is part of MSAPI.
+ * License: see LICENSE.md
+ * Contributor terms: see CONTRIBUTING.md
+ *
+ * This software is licensed under the Polyform Noncommercial License 1.0.0.
+ * You may use, copy, modify, and distribute it for noncommercial purposes only.
+ *
+ * For commercial use, please contact: maks.angels@mail.ru
+ *
+ * Required Notice: MSAPI, copyright © 2021–2026 Maksim Andreevich Leonov, maks.angels@mail.ru
+ */
+
+#ifndef MSAPI_UNIT_TEST_SCALABLE_RW_LOCK_INL
+#define MSAPI_UNIT_TEST_SCALABLE_RW_LOCK_INL
+
+#include "../../../../library/source/help/pthread.hpp"
+#include "../../../../library/source/test/test.h"
+#include <chrono>
+#include <vector>
+
+namespace MSAPI {
+
+namespace Tests {
+
+namespace Unit {
+
+/*---------------------------------------------------------------------------------
+Declarations
+---------------------------------------------------------------------------------*/
+
+/**************************
+ * @brief Unit test for scalable read/write lock.
+ *
+ * @return True if all tests passed and false if something went wrong.
+ */
+[[nodiscard]] bool ScalableRWLock();
+
+/*---------------------------------------------------------------------------------
+Definitions
+---------------------------------------------------------------------------------*/
+
+bool ScalableRWLock()
+{
+	LOG_INFO_UNITTEST("MSAPI Scalable read/write lock");
+	MSAPI::Test t;
+
+	{
+		// Mutual exclusion
+		Pthread::ScalableRWLock lock;
+		uint64_t first{};
+		uint64_t second{};
+		std::atomic<int32_t> activeReaders{};
+		std::atomic<int32_t> activeWriters{};
+		std::atomic<uint64_t> violations{};
+		std::atomic<bool> isRunning{ true };
+
+		std::vector<std::thread> readers;
+		for (size_t index{ 0 }; index < Pthread::ScalableRWLock::SLOTS_COUNT + 4; ++index) {
+			readers.emplace_back([&]() {
+				while (isRunning.load(std::memory_order_relaxed)) {
+					const Pthread::ScalableRWLock::ExitGuard<Pthread::read> _{ lock };
+					activeReaders.fetch_add(1);
+					if (activeWriters.load() != 0 || first != second) {
+						violations.fetch_add(1);
+					}
+					activeReaders.fetch_sub(1);
+				}
+			});
+		}
+
+		std::vector<std::thread> writers;
+		for (size_t index{ 0 }; index < 2; ++index) {
+			writers.emplace_back([&]() {
+				for (size_t iteration{ 0 }; iteration < 10000; ++iteration) {
+					const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ lock };
+					if (activeWriters.fetch_add(1) != 0 || activeReaders.load() != 0) {
+						violations.fetch_add(1);
+					}
+					++first;
+					++second;
+					activeWriters.fetch_sub(1);
+				}
+			});
+		}
+
+		for (auto& writer : writers) {
+			writer.join();
+		}
+		isRunning.store(false, std::memory_order_relaxed);
+		for (auto& reader : readers) {
+			reader.join();
+		}
+
+		RETURN_IF_FALSE(t.Assert(violations.load(), uint64_t{ 0 }, "Writers exclude readers and each other"));
+		RETURN_IF_FALSE(t.Assert(first, uint64_t{ 20000 }, "All writes are applied"));
+	}
+
+	{
+		// Writer preference
+		Pthread::ScalableRWLock lock;
+		std::atomic<int32_t> order{};
+		std::atomic<int32_t> writerOrder{};
+		std::atomic<int32_t> readerOrder{};
+		std::atomic<bool> isHeld{ false };
+		std::atomic<bool> isReleased{ false };
+
+		std::thread holder{ [&]() {
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::read> _{ lock };
+			isHeld.store(true);
+			while (!isReleased.load()) {
+				std::this_thread::yield();
+			}
+		} };
+		while (!isHeld.load()) {
+			std::this_thread::yield();
+		}
+
+		std::thread writer{ [&]() {
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::write> _{ lock };
+			writerOrder.store(order.fetch_add(1) + 1);
+		} };
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+		std::thread reader{ [&]() {
+			const Pthread::ScalableRWLock::ExitGuard<Pthread::read> _{ lock };
+			readerOrder.store(order.fetch_add(1) + 1);
+		} };
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+		RETURN_IF_FALSE(t.Assert(order.load(), 0, "Waiting writer blocks new reader"));
+		isReleased.store(true);
+		holder.join();
+		writer.join();
+		reader.join();
+		RETURN_IF_FALSE(t.Assert(writerOrder.load(), 1, "Waiting writer goes first"));
+		RETURN_IF_FALSE(t.Assert(readerOrder.load(), 2, "New reader goes after writer"));
+	}
+
+	return true;
+}
+
+} // namespace Unit
+
+} // namespace Tests
+
+} // namespace MSAPI
+
+#endif // MSAPI_UNIT_TEST_SCALABLE_RW_LOCK_INL
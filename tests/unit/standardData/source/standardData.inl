@@ -268,7 +268,7 @@ bool StandardData()
 		"Data to string is correct for huge object"));
 
 	RETURN_IF_FALSE(t.Assert(data.GetDataTypes()
-			== std::map<size_t, MSAPI::StandardType::Type>{ { 1, MSAPI::StandardType::Type::Int8 },
+			== MSAPI::Protocol::Standard::types_t{ { 1, MSAPI::StandardType::Type::Int8 },
 				{ 2, MSAPI::StandardType::Type::Int16 }, { 3, MSAPI::StandardType::Type::Int32 },
 				{ 4, MSAPI::StandardType::Type::Int64 }, { 5, MSAPI::StandardType::Type::Uint8 },
 				{ 6, MSAPI::StandardType::Type::Uint16 }, { 7, MSAPI::StandardType::Type::Uint32 },
@@ -298,7 +298,7 @@ bool StandardData()
 		true, "Data types are expected for huge object"));
 
 	RETURN_IF_FALSE(t.Assert(data.GetData()
-			== std::map<size_t, std::variant<standardTypes>>{ { 1, dataItem1 }, { 2, dataItem2 }, { 3, dataItem3 },
+			== MSAPI::Protocol::Standard::data_t{ { 1, dataItem1 }, { 2, dataItem2 }, { 3, dataItem3 },
 				{ 4, dataItem4 }, { 5, dataItem5 }, { 6, dataItem6 }, { 7, dataItem7 }, { 8, dataItem8 },
 				{ 9, dataItem9 }, { 10, dataItem10 }, { 11, dataItem11 }, { 12, dataItem12 }, { 13, dataItem13 },
 				{ 14, dataItem14 }, { 15, dataItem15 }, { 16, dataItem16 }, { 17, dataItem17 }, { 18, dataItem18 },
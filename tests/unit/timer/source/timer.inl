@@ -22,7 +22,10 @@
 
 #include "../../../../library/source/help/time.h"
 #include "../../../../library/source/test/test.h"
+#include <atomic>
+#include <memory>
 #include <thread>
+#include <vector>
 
 namespace MSAPI {
 
@@ -420,6 +423,25 @@ bool Timer()
 			"Timer{9223372035,999999999} to string"));
 	}
 
+	{
+		std::string str{ "prefix " };
+		MSAPI::Timer::AppendString(str, 1700000000123456789);
+		RETURN_IF_FALSE(t.Assert(str, "prefix 2023-11-14 22:13:20.123456789", "Timer::AppendString() appends"));
+		str.clear();
+		MSAPI::Timer::AppendString(str, 1700000000000000001);
+		RETURN_IF_FALSE(t.Assert(str, "2023-11-14 22:13:20.000000001", "Timer::AppendString() within cached second"));
+		str.clear();
+		MSAPI::Timer::AppendString(str, 1699999999999999999);
+		RETURN_IF_FALSE(t.Assert(str, "2023-11-14 22:13:19.999999999", "Timer::AppendString() of previous second"));
+
+		std::string other;
+		std::thread{ [&other]() { MSAPI::Timer::AppendString(other, 1700000000000000000); } }.join();
+		RETURN_IF_FALSE(t.Assert(other, "2023-11-14 22:13:20.000000000", "Timer::AppendString() in other thread"));
+		str.clear();
+		MSAPI::Timer::AppendString(str, 0);
+		RETURN_IF_FALSE(t.Assert(str, "1970-01-01 00:00:00.000000000", "Timer::AppendString() of epoch"));
+	}
+
 	{
 		const MSAPI::Timer::Date first{ 2024, 9, 21 }, second{ 2024, 9, 22 };
 		RETURN_IF_FALSE(t.Assert(first < second, true, "Date < operator: 2024-09-21 < 2024-09-22"));
@@ -699,6 +721,110 @@ bool Timer()
 		RETURN_IF_FALSE(t.Assert(!eventFour.IsRunning(), true, "(2) event four is stopped"));
 	}
 
+	{
+		size_t one{ 0 };
+		size_t two{ 0 };
+
+		MSAPI::Timer::Event eventOne([](int* parameter) { ++*parameter; }, reinterpret_cast<int*>(&one));
+		MSAPI::Timer::Event eventTwo([](int* parameter) { ++*parameter; }, reinterpret_cast<int*>(&two));
+
+		eventOne.Start(MSAPI::Timer::Duration::CreateMilliseconds(50));
+		eventTwo.Start(
+			MSAPI::Timer::Duration::CreateMilliseconds(10), MSAPI::Timer::Duration::CreateMilliseconds(20), false);
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(25));
+
+		RETURN_IF_FALSE(t.Assert(one, 0, "(3) event one is not called before time"));
+		RETURN_IF_FALSE(t.Assert(eventOne.IsRunning(), true, "(3) event one is running"));
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(175));
+
+		RETURN_IF_FALSE(t.Assert(one, 1, "(3) event one == 1"));
+		RETURN_IF_FALSE(t.Assert(!eventOne.IsRunning(), true, "(3) event one is stopped"));
+		RETURN_IF_FALSE(t.Assert(two >= 7 && two <= 10, true, "(3) event two is called each 20 milliseconds"));
+
+		eventTwo.Stop();
+		const auto stopped{ two };
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+		RETURN_IF_FALSE(t.Assert(two, stopped, "(3) event two is not called after stop"));
+	}
+
+	{
+		constexpr size_t size{ 100000 };
+		std::atomic<size_t> called{};
+		std::atomic<bool> isEarly{};
+		std::vector<int64_t> deadlines(size);
+		std::vector<std::unique_ptr<MSAPI::TimerWheel::Entry>> entries;
+		entries.reserve(size);
+		size_t periodic{ 0 };
+		MSAPI::TimerWheel::Entry entry{ [&periodic]() { ++periodic; } };
+		//* Wheel is destroyed first, so entries are not called after their destruction
+		MSAPI::TimerWheel wheel;
+
+		for (size_t index{ 0 }; index < size; ++index) {
+			entries.emplace_back(std::make_unique<MSAPI::TimerWheel::Entry>([&, index]() {
+				if (MSAPI::TimerWheel::Now() < deadlines[index]) {
+					isEarly = true;
+				}
+				++called;
+			}));
+
+			//* From 500 to 800 milliseconds, entries are moved down through levels before call
+			const auto delay{ static_cast<int64_t>(500000 + index * 7919 % 300000) * 1000 };
+			deadlines[index] = MSAPI::TimerWheel::Now() + delay;
+			wheel.Schedule(*entries[index], delay);
+		}
+
+		RETURN_IF_FALSE(t.Assert(wheel.GetSize(), size, "(4) wheel size after schedule"));
+
+		size_t canceled{ 0 };
+		for (size_t index{ 1 }; index < size; index += 2) {
+			canceled += static_cast<size_t>(wheel.Cancel(*entries[index]));
+		}
+
+		RETURN_IF_FALSE(t.Assert(canceled, size / 2, "(4) half of entries are canceled"));
+		RETURN_IF_FALSE(t.Assert(wheel.IsScheduled(*entries[1]), false, "(4) canceled entry is not scheduled"));
+		RETURN_IF_FALSE(t.Assert(wheel.GetSize(), size / 2, "(4) wheel size after cancel"));
+
+		wheel.Schedule(entry, 0, 3000000);
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+
+		RETURN_IF_FALSE(t.Assert(called.load(), size / 2, "(4) not canceled entries are called"));
+		RETURN_IF_FALSE(t.Assert(isEarly.load(), false, "(4) entries are not called before deadline"));
+		RETURN_IF_FALSE(t.Assert(wheel.GetSize(), size_t{ 1 }, "(4) only periodic entry is scheduled"));
+		RETURN_IF_FALSE(t.Assert(wheel.Cancel(entry), true, "(4) periodic entry is canceled"));
+		RETURN_IF_FALSE(
+			t.Assert(periodic >= 250 && periodic <= 335, true, "(4) periodic entry is called each 3 milliseconds"));
+	}
+
+	{
+		const auto begin{ MSAPI::FastClock::GetTicks() };
+		const auto timer{ MSAPI::FastClock::ToTimer(begin) };
+		const auto difference{ MSAPI::Timer::Duration{ MSAPI::Timer{} - timer }.GetNanoseconds() };
+
+		RETURN_IF_FALSE(
+			t.Assert(difference > -5000000 && difference < 5000000, true, "Fast clock timer is close to wall clock"));
+
+		const auto next{ MSAPI::FastClock::GetTicksOrdered() };
+		RETURN_IF_FALSE(t.Assert(next >= begin, true, "Fast clock ticks are not decreased"));
+		RETURN_IF_FALSE(t.Assert(MSAPI::FastClock::ToNanoseconds(next - begin) >= 0, true,
+			"Fast clock interval between two reads is not negative"));
+
+		const auto sleepBegin{ MSAPI::FastClock::GetTicks() };
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		const auto ticks{ MSAPI::FastClock::GetTicksOrdered() - sleepBegin };
+		const auto nanoseconds{ MSAPI::FastClock::ToNanoseconds(ticks) };
+
+		RETURN_IF_FALSE(t.Assert(nanoseconds >= 49000000 && nanoseconds < 80000000, true,
+			"Fast clock measures 50 milliseconds of sleep"));
+		RETURN_IF_FALSE(t.Assert(MSAPI::FastClock::ToDuration(ticks), MSAPI::Timer::Duration{ nanoseconds },
+			"Fast clock duration is the same as nanoseconds"));
+		RETURN_IF_FALSE(t.Assert(MSAPI::FastClock::GetElapsed(sleepBegin) >= nanoseconds, true,
+			"Fast clock elapsed time is not less than measured before"));
+	}
+
 	return true;
 }
 